@@ -14,7 +14,32 @@
 #include "drivers/communication/stm32_comm.h"
 #include "drivers/time/ntp_time.h"
 #include "handlers/web_api_handler.h"
+#include "handlers/meter_batcher.h"
+#include "handlers/meter_deadband.h"
+#include "handlers/connector_state.h"
+#include "handlers/auth_cache.h"
+#include "handlers/charging_profiles.h"
+#include "handlers/power_policy.h"
 #include "utils/logger.h"
+#include "utils/loop_profiler.h"
+#include "utils/memory_pool.h"
+#include "utils/task_scheduler.h"
+
+// Task periods (UART, MQTT and NTP sockets are polled on every pass)
+#define TASK_WIFI_PERIOD_MS         100
+#define TASK_NTP_PERIOD_MS          0       // Polls its UDP socket; the reply is timestamped when read
+#define TASK_HEARTBEAT_PERIOD_MS    1000    // Checks config.system.heartbeatInterval
+#define TASK_METER_PERIOD_MS        50
+#define TASK_CONFIG_PERIOD_MS       500     // Debounced config and auth cache writes
+#define TASK_LIVE_PERIOD_MS         100     // Web UI telemetry push
+#define TASK_OTA_PERIOD_MS          20      // One bounded download pass while an update runs
+#define TASK_STM32_OTA_PERIOD_MS    0       // Bulk transfer refills the TX ring every loop
+#define TASK_MEMORY_PERIOD_MS       1000    // Heap watermarks
+#define TASK_CHARGING_PERIOD_MS     1000    // Schedule periods start on whole seconds
+#define TASK_POWER_PERIOD_MS        0       // Wakes the radio in the pass a UART frame arrives
+
+// Longest idle sleep in loop(), also bounded by the STM32 RX headroom
+#define LOOP_IDLE_MAX_MS            5
 
 /**
  * @brief Main device manager (Facade pattern)
@@ -26,7 +51,11 @@ private:
     // Config manager
     UnifiedConfigManager configManager;
 
-    // Network components (heap allocated)
+    // Network components: constructed in place at boot (null until then)
+    StaticSlot<CustomWiFiManager> wifiSlot;
+    StaticSlot<MQTTClient> mqttSlot;
+    StaticSlot<WebServerDriver> webServerSlot;
+    StaticSlot<WebAPIHandler> webAPISlot;
     CustomWiFiManager* wifiManager;
     MQTTClient* mqttClient;
     WebServerDriver* webServer;
@@ -38,13 +67,42 @@ private:
     // Time synchronization
     NTPTimeDriver ntpTime;
 
+    // Meter value batching (opt-in via config.meter.batchEnabled)
+    MeterBatcher meterBatcher;
+
+    // Meter deadband state (opt-in via config.meter.deadbandEnabled)
+    MeterDeadband meterDeadband;
+
+    // Last status per connector (change-driven notifications, snapshot)
+    ConnectorStateTable connectorStates;
+
+    // Local authorization list / cache (CMD_AUTH_QUERY)
+    AuthCache authCache;
+
+    // Charging profiles -> per-connector limits (RSP_CHARGING_LIMIT)
+    ChargingProfileEngine chargingProfiles;
+
+    // Per-stage run() timing (heartbeat, /api/diag/perf)
+    LoopProfiler profiler;
+
+    // Modem sleep depth (opt-in via config.wifi.powerSave)
+    PowerPolicy powerPolicy;
+
+    // Periodic work, run from run() when due
+    TaskScheduler scheduler;
+
     // Status
     struct {
         bool initialized;
         uint32_t bootTime;
-        uint32_t lastHeartbeat;
+        uint32_t lastHeartbeat;         // Sent or coalesced
+        uint32_t lastHeartbeatFields;   // Health fields reported (heartbeat or meter batch)
+        uint32_t heartbeatsCoalesced;
         bool bootNotificationSent;
         bool provisioningMode;
+        uint32_t lastLinkStats;
+        uint32_t snapshotConnectTime;   // MQTT session the snapshot went out on
+        bool stm32Linked;               // STM32 link up at the last charging pass
     } systemStatus;
 
     // Private methods
@@ -56,10 +114,31 @@ private:
     void handleHeartbeat();
     void handleMeterValues();
     void handleBootNotification();
+    void handleStatusSnapshot();
+    void publishLinkStats();
+    void registerTasks();
+
+    // Scheduled tasks
+    static void taskWiFi();
+    static void taskMqtt();
+    static void taskNtp();
+    static void taskHeartbeat();
+    static void taskMeter();
+    static void taskConfig();
+    static void taskLive();
+    static void taskOta();
+    static void taskStm32Ota();
+    static void taskMemory();
+    static void taskCharging();
+    static void taskPower();
 
     // Callbacks
     static void mqttMessageCallback(const char* topic, const char* payload, uint16_t length);
-    static void stm32PacketCallback(const uart_packet_t* packet);
+    static void mqttDeliveryCallback(uint32_t token, bool delivered);
+    static void mqttHandshakeCallback(bool active);
+    static void mqttIdleCallback();
+    static uint32_t unixTimeSource();
+    static void stm32PacketCallback(const UartFrameView& frame);
 
     // Static instance for callbacks
     static DeviceManager* instance;
@@ -75,9 +154,35 @@ public:
 
     /**
      * @brief Main loop - must be called frequently
+     *
+     * Services the STM32 link, then runs the tasks that are due.
      */
     void run();
 
+    /**
+     * @brief How long loop() may sleep before run() has work again
+     * @return 0 if work is pending (call run() right away)
+     */
+    uint32_t idleTime();
+
+    /**
+     * @brief Sleep in loop() (delay(), profiled as ProfileStage::SLEEP)
+     */
+    void sleep(uint32_t ms);
+
+    /**
+     * @brief Register extra periodic work (e.g. diagnostics in main.cpp)
+     * @return Task ID, -1 if the table is full
+     */
+    int8_t addTask(const char* name, TaskFunction run, uint32_t periodMs) {
+        return scheduler.add(name, run, periodMs);
+    }
+
+    /**
+     * @brief Loop timing statistics
+     */
+    const LoopProfiler& getProfiler() const { return profiler; }
+
     /**
      * @brief Get config reference
      */
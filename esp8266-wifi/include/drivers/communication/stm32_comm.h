@@ -9,6 +9,18 @@
  * - Merged duplicate process/handle functions
  * - Better packet parsing with timeout
  * - Error codes instead of bool
+ * - Zero-copy RX: callbacks get a UartFrameView into the ring buffer
+ * - Resumable streaming parser: each RX byte is examined once
+ * - Protocol v2 (CRC-16 frames), enabled by STM32 CMD_HELLO handshake
+ * - Baud rate negotiation (CMD_SET_BAUD/CMD_BAUD_TEST) with auto fallback
+ * - Non-blocking TX ring; v2 peers get a sliding ACK window with retries
+ * - Fragmentation/reassembly of messages over UART_MAX_PAYLOAD (v2)
+ * - Optional alternate UART0 pins (STM32_UART_SWAP), nothing but protocol
+ *   frames on the link
+ * - getTxFree() for the bulk transfer sender (STM32 firmware pass-through)
+ * - RX backpressure: RSP_FLOW_CONTROL pause/resume around a high-water
+ *   mark of the UART driver buffer; a full ring releases complete frames
+ *   first and otherwise drops the frame in progress as a whole
  */
 
 #ifndef STM32_COMM_H
@@ -18,6 +30,30 @@
 #include "utils/ring_buffer.h"
 #include "../../shared/uart_protocol.h"
 
+// 1 = link on GPIO15 (TX) / GPIO13 (RX) via Serial.swap(), away from the
+// boot ROM output and the USB-serial adapter on GPIO1/GPIO3
+#ifndef STM32_UART_SWAP
+#define STM32_UART_SWAP         0
+#endif
+
+// HardwareSerial RX buffer (core default 256); absorbs the time handle()
+// is not called (TLS record, flash write): 512 bytes = 44 ms at 115200
+#ifndef STM32_RX_DRIVER_BUFFER
+#define STM32_RX_DRIVER_BUFFER  512
+#endif
+
+// Frame ring on top of the driver buffer (one max-size frame, 520 bytes,
+// plus the start of the next; complete frames are handed out when full)
+#ifndef STM32_RX_BUFFER_SIZE
+#define STM32_RX_BUFFER_SIZE    1024
+#endif
+
+// RX backpressure (driver buffer fill at handle(), percent)
+#define STM32_RX_HIGH_WATER_PCT 50      // Ask the STM32 to pause
+#define STM32_RX_LOW_WATER_PCT  12      // Resume once this low...
+#define STM32_FLOW_HOLD_MS      100     // ...and no high water for this long
+#define STM32_FLOW_REFRESH_MS   (UART_FLOW_PAUSE_MAX_MS / 2)
+
 /**
  * @brief UART Communication error codes
  */
@@ -42,12 +78,140 @@ struct STM32Status {
     uint32_t errorCount;
     uint32_t checksumErrors;
     uint32_t timeoutErrors;
+    uint8_t protocolVersion;    // TX frame format agreed via CMD_HELLO
+    uint32_t baudRate;          // Current UART rate (negotiated via CMD_SET_BAUD)
+    uint32_t baudFallbacks;     // Times the link dropped back to UART_BAUD_BOOT
+
+    // TX pipeline
+    uint32_t txQueueFull;       // Frames rejected, TX ring or window full
+    uint32_t retransmits;
+    uint32_t txDropped;         // Commands given up after UART_MAX_RETRIES
+
+    // Fragmentation
+    uint32_t messagesReassembled;
+    uint32_t reassemblyErrors;  // Bad, oversized or abandoned CMD_FRAGMENT
+
+    // RX ingest cost (per-byte cost = rxIngestUs / rxBytes)
+    uint32_t rxBytes;
+    uint32_t rxBatches;
+    uint32_t rxIngestUs;
+
+    // RX backpressure
+    uint16_t rxDriverPeak;      // Highest UART driver fill seen by handle()
+    uint32_t rxOverruns;        // UART driver buffer overflowed (bytes lost)
+    uint32_t rxFramesDropped;   // Frames dropped whole, RX ring full
+    uint32_t flowPauses;        // RSP_FLOW_CONTROL pauses sent
+};
+
+/**
+ * @brief Zero-copy view of a received frame
+ *
+ * The payload is referenced in place inside the RX ring buffer: one
+ * span, or two when the frame wraps around the end of storage. The view
+ * is only valid during the packet callback; the frame is discarded from
+ * the ring right after, so handlers may also parse it in place.
+ *
+ * Usage:
+ *   frame.withLinearPayload([&](uint8_t* data, uint16_t len) { ... });
+ *   frame.copyTo(&meter, 0, sizeof(meter));
+ */
+struct UartFrameView {
+    uint8_t version;            // UART_PROTOCOL_V1/V2 (wire format it came in)
+    uint8_t cmd_type;
+    uint16_t length;
+    uint8_t sequence;
+    uint8_t* span[2];
+    uint16_t spanLength[2];
+
+    /**
+     * @brief True if the payload is a single span
+     */
+    bool isContiguous() const { return spanLength[1] == 0; }
+
+    /**
+     * @brief Payload byte at index (index < length)
+     */
+    uint8_t at(uint16_t index) const {
+        return index < spanLength[0] ? span[0][index] : span[1][index - spanLength[0]];
+    }
+
+    /**
+     * @brief Copy part of the payload out
+     * @param dst Destination buffer
+     * @param offset Payload offset to start from
+     * @param maxLength Maximum bytes to copy
+     * @return Number of bytes copied
+     */
+    uint16_t copyTo(void* dst, uint16_t offset, uint16_t maxLength) const {
+        if (offset >= length) return 0;
+        uint16_t n = (length - offset < maxLength) ? (length - offset) : maxLength;
+        uint8_t* out = (uint8_t*)dst;
+        uint16_t copied = 0;
+
+        if (offset < spanLength[0]) {
+            uint16_t first = spanLength[0] - offset;
+            if (first > n) first = n;
+            memcpy(out, span[0] + offset, first);
+            copied = first;
+            offset = 0;
+        } else {
+            offset -= spanLength[0];
+        }
+
+        if (copied < n) {
+            memcpy(out + copied, span[1] + offset, n - copied);
+        }
+        return n;
+    }
+
+    /**
+     * @brief Materialize a full uart_packet_t copy (only when really needed)
+     */
+    void materialize(uart_packet_t& packet) const {
+        uart_init_packet(&packet, cmd_type, sequence);
+        packet.length = copyTo(packet.payload, 0, UART_MAX_PAYLOAD);
+    }
+
+    /**
+     * @brief Run fn(data, length) over the payload as one linear buffer
+     *
+     * Contiguous frames are passed in place; only frames that wrap the
+     * ring are copied, in a separate stack frame so the common case
+     * never reserves the copy buffer.
+     */
+    template<typename Fn>
+    void withLinearPayload(Fn fn) const {
+        if (isContiguous()) {
+            fn(span[0], length);
+        } else {
+            withLinearCopy(fn);
+        }
+    }
+
+private:
+    template<typename Fn>
+    void __attribute__((noinline)) withLinearCopy(Fn fn) const {
+        uint8_t copy[UART_MAX_PAYLOAD];
+        copyTo(copy, 0, sizeof(copy));
+        fn(copy, length);
+    }
+};
+
+/**
+ * @brief Command awaiting CMD_ACK from the STM32
+ */
+struct TxInFlight {
+    uint8_t sequence;
+    uint8_t retries;
+    bool acked;                 // ACKed (or given up), released once oldest
+    uint16_t frameLength;       // Encoded bytes held in retryStore
+    uint32_t sentAt;
 };
 
 /**
  * @brief Packet received callback
  */
-typedef void (*PacketCallback)(const uart_packet_t* packet);
+typedef void (*PacketCallback)(const UartFrameView& frame);
 
 /**
  * @brief OOP STM32 Communicator
@@ -59,8 +223,22 @@ typedef void (*PacketCallback)(const uart_packet_t* packet);
  */
 class STM32Communicator {
 private:
-    // RX buffer (512 bytes - optimized for ESP8266)
-    RingBuffer<512> rxBuffer;
+    // Byte stream to the STM32 (Serial unless replaced by setLink())
+    Stream* link;
+
+    // RX ring (frames are handed out in place from here)
+    RingBuffer<STM32_RX_BUFFER_SIZE> rxBuffer;
+
+    // TX ring, drained into the UART FIFO as space allows (never blocks)
+    RingBuffer<1024> txBuffer;
+
+    // Sliding window of unACKed commands; their encoded frames are kept
+    // in retryStore in send order for retransmission
+    static constexpr uint8_t TX_WINDOW_SIZE = 4;
+    TxInFlight txWindow[TX_WINDOW_SIZE];
+    uint8_t txWindowHead;
+    uint8_t txWindowCount;
+    RingBuffer<2048> retryStore;
 
     // TX sequence counter
     uint8_t txSequence;
@@ -77,13 +255,75 @@ private:
     // Packet parsing timeout (ms)
     static constexpr uint32_t PARSE_TIMEOUT = 1000;
 
+    // Partial inbound message given up after every retry window (ms)
+    static constexpr uint32_t REASSEMBLY_TIMEOUT = UART_TIMEOUT_MS * (UART_MAX_RETRIES + 1);
+
     // Last RX timestamp for timeout detection
     uint32_t lastRxTime;
 
+    // Streaming parser (payload stays in rxBuffer, parser only checksums it)
+    uart_parser_t parser;
+
+    // Bytes from the ring tail already fed to the parser
+    size_t rxScanOffset;
+
+    // Baud negotiation: new rate is on trial until CMD_BAUD_TEST passes
+    bool baudTrial;
+    uint32_t baudTrialStart;
+    uint32_t previousBaud;
+    uint32_t baudChangedAt;
+
+    // Checksum error rate tracking (fallback to UART_BAUD_BOOT on spikes)
+    uint32_t errorWindowStart;
+    uint32_t errorWindowBase;
+
+    // One message buffer for both directions: inbound CMD_FRAGMENT
+    // reassembly owns it while reassembly.active, an outbound
+    // RSP_FRAGMENT message while fragTxLength > 0 (never both)
+    uint8_t fragBuffer[UART_REASSEMBLY_SIZE];
+
+    // Inbound CMD_FRAGMENT reassembly
+    uart_reassembly_t reassembly;
+    uint32_t fragRxAt;          // Last fragment stored
+
+    // Outbound message being sent as RSP_FRAGMENT (one at a time)
+    uint16_t fragTxLength;      // 0 = idle
+    uint8_t fragTxCmd;
+    uint8_t fragTxMessageId;
+    uint8_t fragTxNext;         // Next fragment index to queue
+    uint8_t fragTxCount;
+
+    // RX backpressure state (RSP_FLOW_CONTROL)
+    bool flowPaused;
+    bool flowHold;              // Paused on request (holdRx), not by water mark
+    uint32_t flowSentAt;        // Last pause/resume sent
+    uint32_t flowHighAt;        // Last time the driver buffer was above high water
+
     // Private methods
-    bool parsePacket(uart_packet_t& packet);
-    bool validatePacket(const uart_packet_t& packet) const;
-    void handleParsedPacket(const uart_packet_t& packet);
+    bool parsePacket(UartFrameView& frame);
+    void dispatchFrames();
+    void checkFlowControl(size_t pending);
+    bool sendFlowControl(bool paused, size_t pending);
+    bool handleParsedPacket(const UartFrameView& frame);
+    void handleHello(const UartFrameView& frame);
+    void handleSetBaud(const UartFrameView& frame);
+    void handleBaudTest(const UartFrameView& frame);
+    void checkBaudHealth();
+    void switchBaud(uint32_t baudRate);
+    UARTError enqueueFrame(uint8_t cmdType, uint8_t sequence,
+                           const uint8_t* prefix, uint16_t prefixLength,
+                           const uint8_t* payload, uint16_t length, bool track);
+    void drainTx();
+    void flushTx();
+    void handleCommandAck(const UartFrameView& frame);
+    void checkTxTimeouts();
+    UARTError sendFragmented(uint8_t cmdType, const uint8_t* prefix, uint16_t prefixLength,
+                             const uint8_t* payload, uint16_t length);
+    void pumpFragments();
+    void handleFragment(const UartFrameView& frame);
+    void checkReassemblyTimeout();
+    void releaseAcked();
+    void resetTxWindow();
     void updateStatus();
 
 public:
@@ -94,27 +334,67 @@ public:
 
     /**
      * @brief Initialize UART communication
-     * @param baudRate Baud rate (default 115200)
+     * @param baudRate Boot baud rate (default UART_BAUD_BOOT)
      * @return UARTError code
      */
-    UARTError init(uint32_t baudRate = 115200);
+    UARTError init(uint32_t baudRate = UART_BAUD_BOOT);
+
+    /**
+     * @brief Exchange frames over another stream instead of Serial
+     * @param stream Byte source/sink (e.g. a recorded capture in benchmarks)
+     * @note Baud rate negotiation still reconfigures Serial
+     */
+    void setLink(Stream& stream) { link = &stream; }
 
     /**
-     * @brief Send packet to STM32
+     * @brief Send packet to STM32 (queued, not tracked for ACK)
      * @param packet Packet to send
-     * @return UARTError code
+     * @return UARTError code (BUFFER_OVERFLOW if the TX ring is full)
+     * @note Prefer sendResponse(): a uart_packet_t is ~520 bytes of stack
      */
     UARTError sendPacket(const uart_packet_t& packet);
 
+    /**
+     * @brief Send reply frame (queued, not tracked for ACK)
+     *
+     * Header and checksum are built on the fly around the caller's
+     * payload, so small replies need no uart_packet_t.
+     *
+     * @param cmdType Response type
+     * @param sequence Sequence of the request being answered
+     * @param payload Payload data (can be nullptr)
+     * @param length Payload length (max UART_MAX_PAYLOAD)
+     * @return UARTError code (BUFFER_OVERFLOW if the TX ring is full)
+     */
+    UARTError sendResponse(uint8_t cmdType, uint8_t sequence, const void* payload, uint16_t length);
+
     /**
      * @brief Send command with payload
+     *
+     * Gets a fresh sequence number. With a v2 peer the command stays in
+     * the in-flight window until CMD_ACK, and is retransmitted every
+     * UART_TIMEOUT_MS up to UART_MAX_RETRIES times.
+     *
+     * Payloads over UART_MAX_PAYLOAD (up to UART_REASSEMBLY_SIZE) are
+     * sent as RSP_FRAGMENT frames to a v2 peer, one message at a time.
+     *
      * @param cmdType Command type
      * @param payload Payload data (can be nullptr)
      * @param length Payload length
-     * @return UARTError code
+     * @return UARTError code (BUFFER_OVERFLOW if TX ring or window is full,
+     *         or a fragmented message is still being queued or received)
      */
     UARTError sendCommand(uint8_t cmdType, const void* payload, uint16_t length);
 
+    /**
+     * @brief Send command whose payload is two parts (gathered, no copy)
+     *
+     * Same as sendCommand() with prefix followed by payload, e.g. a
+     * topic and an MQTT payload still in the client's receive buffer.
+     */
+    UARTError sendCommand(uint8_t cmdType, const void* prefix, uint16_t prefixLength,
+                          const void* payload, uint16_t length);
+
     /**
      * @brief Send ACK response
      * @param sequence Sequence number to ACK
@@ -145,16 +425,64 @@ public:
      */
     const STM32Status& getStatus() const { return status; }
 
+    /**
+     * @brief Get negotiated TX protocol version
+     */
+    uint8_t getProtocolVersion() const { return status.protocolVersion; }
+
+    /**
+     * @brief Free TX ring space, for senders that pace themselves
+     *        (compare with uart_frame_size())
+     */
+    size_t getTxFree() const { return txBuffer.free(); }
+
+    /**
+     * @brief Commands sent but not yet ACKed
+     */
+    uint8_t getInFlightCount() const { return txWindowCount; }
+
+    /**
+     * @brief How long the caller may sleep without losing RX bytes
+     * @return 0 if bytes are waiting or TX work is queued, else the time
+     *         to fill half the UART driver buffer at the current baud rate
+     */
+    uint32_t idleBudgetMs();
+
     /**
      * @brief Get RX buffer usage
      */
     size_t getBufferUsage() const { return rxBuffer.available(); }
 
+    /**
+     * @brief Highest RX buffer fill level seen, in bytes
+     */
+    size_t getBufferPeak() const { return rxBuffer.getPeakUsage(); }
+
+    /**
+     * @brief True while the STM32 was asked to hold its frames
+     */
+    bool isRxPaused() const { return flowPaused; }
+
+    /**
+     * @brief Keep the STM32 paused regardless of the water marks (v2 only)
+     *
+     * For stretches where handle() runs only now and then, e.g. the MQTT
+     * TLS handshake. The pause is refreshed from handle() while held;
+     * the STM32 resumes on its own UART_FLOW_PAUSE_MAX_MS after the last
+     * one, so a long gap between handle() calls still lets frames through.
+     */
+    void holdRx(bool hold);
+
+    /**
+     * @brief millis() when bytes last arrived from the STM32
+     */
+    uint32_t getLastRxTime() const { return lastRxTime; }
+
     /**
      * @brief Print buffer statistics (debug)
      */
-    void printBufferStats() const {
-        rxBuffer.printStats("STM32 RX Buffer");
+    void printBufferStats(Print& out) const {
+        rxBuffer.printStats(out, "STM32 RX Buffer");
     }
 
     /**
@@ -162,6 +490,8 @@ public:
      */
     void clearBuffer() {
         rxBuffer.clear();
+        rxScanOffset = 0;
+        uart_parser_reset(&parser);
     }
 };
 
@@ -0,0 +1,39 @@
+/**
+ * @file config_migration.h
+ * @brief Config file schema migrations
+ * @version 1.0.0
+ *
+ * A config file written by older firmware is upgraded at load, one
+ * version at a time, instead of being rejected (which meant factory
+ * defaults, lost credentials and a trip through AP provisioning).
+ *
+ * Adding a schema version:
+ * 1. Bump CONFIG_SCHEMA_VERSION
+ * 2. Add a step migrating CONFIG_SCHEMA_VERSION - 1 to the new version in
+ *    config_migration.cpp; it edits the parsed JSON in place
+ * Steps only have to rename/move/convert keys: anything still missing
+ * afterwards takes its default in UnifiedConfigManager::loadJson().
+ */
+
+#ifndef CONFIG_MIGRATION_H
+#define CONFIG_MIGRATION_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#define CONFIG_SCHEMA_VERSION       1
+
+namespace ConfigMigration {
+    /**
+     * @brief Upgrade a parsed config file to CONFIG_SCHEMA_VERSION
+     * @param doc Parsed config file, edited in place ("version" updated)
+     * @param fromVersion Version found in the file (0 = no version key)
+     * @return false if a step is missing or failed (doc must not be used)
+     *
+     * Files from newer firmware (after a rollback) are left as they are:
+     * unknown keys are ignored and the known ones still load.
+     */
+    bool upgrade(JsonDocument& doc, uint8_t fromVersion);
+}
+
+#endif // CONFIG_MIGRATION_H
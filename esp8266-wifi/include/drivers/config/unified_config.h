@@ -1,9 +1,19 @@
 /**
  * @file unified_config.h
  * @brief Unified lightweight configuration system for ESP8266
- * @version 1.0.0
+ * @version 1.1.0
  *
  * Design: Single struct with all configs, no dynamic allocation
+ *
+ * Persistence: a binary snapshot of DeviceConfig (header + raw struct,
+ * CRC-16) is what boot reads; the JSON file is written alongside it as
+ * the readable copy and is only parsed when the snapshot is missing,
+ * corrupt or from another firmware layout.
+ *
+ * Updates: updateFromJson() patches only the fields present, marks the
+ * changed sections dirty and leaves the write to handle(), which saves
+ * once updates have been quiet for CONFIG_SAVE_DEBOUNCE_MS (or the first
+ * pending change is CONFIG_SAVE_MAX_DELAY_MS old).
  */
 
 #ifndef UNIFIED_CONFIG_H
@@ -11,6 +21,21 @@
 
 #include <Arduino.h>
 
+#define CONFIG_SNAPSHOT_MAGIC       0x47464353  // "SCFG"
+#define CONFIG_SNAPSHOT_LAYOUT      4           // Bump whenever DeviceConfig changes
+
+#define CONFIG_SAVE_DEBOUNCE_MS     2000        // Quiet time before a coalesced write
+#define CONFIG_SAVE_MAX_DELAY_MS    10000       // Upper bound under a steady stream
+
+/* Dirty section flags */
+#define CONFIG_SECTION_DEVICE       0x01
+#define CONFIG_SECTION_WIFI         0x02
+#define CONFIG_SECTION_MQTT         0x04
+#define CONFIG_SECTION_PROVISIONING 0x08
+#define CONFIG_SECTION_SYSTEM       0x10
+#define CONFIG_SECTION_WEB          0x20
+#define CONFIG_SECTION_METER        0x40
+
 /**
  * @brief Complete device configuration (stack allocated)
  * Total size: ~600 bytes
@@ -28,6 +53,13 @@ struct DeviceConfig {
         bool autoConnect;
         char apNamePrefix[16];      // "EVSE-" + MAC suffix
         uint32_t configPortalTimeout;
+        bool fastConnect;           // Rejoin via cached BSSID/channel/lease
+        char staticIp[16];          // Empty = DHCP
+        char gateway[16];
+        char subnet[16];
+        char dns[16];               // Empty = gateway
+        bool powerSave;             // Deeper modem sleep while idle (PowerPolicy)
+        uint8_t listenInterval;     // Beacons between wakeups when idle (1..10)
     } wifi;
 
     /* MQTT Configuration */
@@ -39,6 +71,7 @@ struct DeviceConfig {
         char clientIdPrefix[16];    // Will append device ID
         bool tlsEnabled;
         uint16_t keepAlive;
+        bool binaryPayload;         // MessagePack on {topic}/b instead of JSON
     } mqtt;
 
     /* Provisioning Configuration */
@@ -55,6 +88,8 @@ struct DeviceConfig {
         bool otaEnabled;
         char otaPassword[32];
         uint32_t heartbeatInterval;
+        bool heartbeatCoalesce;     // Skip heartbeats while other publishes prove liveness
+        bool heartbeatPiggyback;    // Heartbeat fields ride on the next meter batch
         bool debugEnabled;
         uint8_t logLevel;           // 0=ERROR, 1=WARN, 2=INFO, 3=DEBUG
     } system;
@@ -68,11 +103,45 @@ struct DeviceConfig {
         bool authRequired;
     } web;
 
+    /* Meter Values Configuration */
+    struct {
+        bool batchEnabled;          // Coalesce samples into one meter/batch publish
+        uint16_t batchWindowMs;     // Max age of the oldest sample before flush
+        uint8_t batchMaxSamples;    // Flush when this many samples are pending
+
+        bool deadbandEnabled;       // Suppress samples that did not change enough
+        uint32_t keyframeIntervalMs; // Always report at least this often per connector
+        struct {                    // Minimum change to report (0 = any change)
+            uint32_t energyWh;
+            uint16_t powerW;
+            uint16_t voltageV;
+            uint16_t currentA;
+            uint16_t frequencyHz;
+            uint16_t temperatureC;
+            uint8_t powerFactorPct;
+        } deadband;
+    } meter;
+
     /* Validation flags */
     bool isValid;
     uint8_t version;                // Config schema version
+
+    /* Runtime only (not persisted) */
+    uint16_t identityRevision;      // Bumped when stationId/deviceId may have changed
 };
 
+/**
+ * @brief Binary snapshot file header (followed by the DeviceConfig image)
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint8_t layout;             // CONFIG_SNAPSHOT_LAYOUT of the writer
+    uint8_t schemaVersion;      // DeviceConfig::version
+    uint16_t size;              // sizeof(DeviceConfig) of the writer
+    uint16_t crc;               // CRC-16/CCITT-FALSE over the image
+    uint16_t reserved;
+} config_snapshot_header_t;
+
 /**
  * @brief Lightweight config manager (stack allocated)
  * No STL, no dynamic allocation, ESP8266 optimized
@@ -81,11 +150,22 @@ class UnifiedConfigManager {
 private:
     DeviceConfig config;
     bool initialized;
+    uint8_t loadedVersion;      // Schema version of the last JSON file loaded
+
+    uint8_t dirtySections;      // CONFIG_SECTION_* changed since the last save
+    uint32_t firstDirtyAt;
+    uint32_t lastDirtyAt;
+    uint16_t pendingUpdates;    // Updates coalesced into the pending write
 
     // Helper methods
     void loadFactoryDefaults();
     bool validateConfig() const;
     void sanitizeConfig();
+    bool loadSnapshot();
+    bool saveSnapshot();
+    bool loadJson(const char* path);
+    bool saveJson();
+    void markDirty(uint8_t sections);
 
 public:
     UnifiedConfigManager();
@@ -98,17 +178,28 @@ public:
 
     /**
      * @brief Load configuration from LittleFS
-     * Priority: Runtime config -> Bootstrap config -> Factory defaults
+     * Priority: Binary snapshot -> JSON file (re-snapshotted) -> Factory defaults
      * @return true if loaded successfully
      */
     bool load();
 
     /**
-     * @brief Save current config to LittleFS
+     * @brief Save current config to LittleFS now (snapshot, then JSON copy)
+     * Clears pending changes; use before a restart.
      * @return true if saved successfully
      */
     bool save();
 
+    /**
+     * @brief Write pending changes once they are due (call periodically)
+     */
+    void handle();
+
+    /**
+     * @brief Sections changed but not yet written (CONFIG_SECTION_* mask)
+     */
+    uint8_t getDirtySections() const { return dirtySections; }
+
     /**
      * @brief Reset to factory defaults
      * @return true if reset successfully
@@ -126,12 +217,18 @@ public:
     DeviceConfig& getMutable() { return config; }
 
     /**
-     * @brief Update config from JSON string
+     * @brief Patch config from a JSON string (only the keys present)
      * @param jsonStr JSON configuration string
-     * @return true if updated successfully
+     * @return true if the patch was valid (also when nothing changed);
+     *         the write is deferred to handle()
      */
     bool updateFromJson(const char* jsonStr);
 
+    /**
+     * @brief Patch config from a JSON buffer (need not be NUL-terminated)
+     */
+    bool updateFromJson(const char* json, size_t length);
+
     /**
      * @brief Export config to JSON string
      * @param buffer Output buffer
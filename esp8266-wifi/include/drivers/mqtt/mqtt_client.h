@@ -18,6 +18,55 @@
 #include <WiFiClient.h>
 #include <WiFiClientSecure.h>
 #include "../config/unified_config.h"
+#include "offline_journal.h"
+#include "mqtt_tap_client.h"
+#include "../../utils/ring_buffer.h"
+#include "../../utils/retry_policy.h"
+
+// PubSubClient packet buffer (larger payloads are streamed)
+#define MQTT_BUFFER_SIZE      512
+
+// Priority lanes, drained strictly in order (lane 0 first)
+#define MQTT_PRIORITY_COUNT       3
+
+// Per-lane RAM queue (used when the offline journal is unavailable)
+#define MQTT_LANE_QUEUE_BYTES     768
+
+// Per-lane journal caps in segments (JOURNAL_SEGMENT_SIZE each, 16 total)
+#define MQTT_JOURNAL_SEGMENTS_TRANSACTION   4
+#define MQTT_JOURNAL_SEGMENTS_STATUS        2
+#define MQTT_JOURNAL_SEGMENTS_TELEMETRY     10
+
+// QoS1 inflight window (PUBLISH packets kept until PUBACK)
+#define MQTT_INFLIGHT_WINDOW      4
+#define MQTT_INFLIGHT_BYTES       2048    // Encoded packets awaiting PUBACK
+#define MQTT_PUBACK_TIMEOUT_MS    5000    // Retransmit (DUP) after this
+#define MQTT_PUBACK_MAX_RETRIES   3       // Then give up and report failure
+
+// No delivery report wanted for this publish
+#define MQTT_NO_DELIVERY_TOKEN    0xFFFFFFFFUL
+
+// Connect stages are bounded so the main loop is never held for long
+#define MQTT_TCP_TIMEOUT_MS       3000    // TCP connect per attempt
+#define MQTT_TLS_TIMEOUT_MS       8000    // TCP connect + full TLS handshake
+#define MQTT_CONNACK_TIMEOUT_S    5       // CONNACK wait (UART serviced meanwhile)
+#define MQTT_HANDSHAKE_IDLE_US    10000   // Idle hook interval during the TCP/TLS connect
+
+// TLS trust (LittleFS; CA wins over fingerprint, neither = insecure)
+#define MQTT_TLS_CA_PATH            "/mqtt_ca.pem"     // PEM or DER, one or more certs
+#define MQTT_TLS_FINGERPRINT_PATH   "/mqtt_fp.txt"     // SHA-1 of the broker cert, hex
+#define MQTT_TLS_CA_MAX_BYTES       4096
+#define MQTT_TLS_MFLN_SIZE          512     // Record size asked of MFLN-capable brokers
+#define MQTT_TLS_MIN_EPOCH          1672531200UL  // 2023-01-01, below = clock unset
+
+// Broker reconnect: decorrelated jitter, seeded per chip
+#define MQTT_RECONNECT_BASE_MS    2000
+#define MQTT_RECONNECT_MAX_MS     120000
+
+// Backlog drain pacing (journal + RAM queue), keeps handle() short
+#define MQTT_DRAIN_BURST          4       // Max messages per handle() call
+#define MQTT_DRAIN_BUDGET_MS      10      // Max time per handle() call
+#define MQTT_DRAIN_INTERVAL_MS    100     // Min gap between bursts
 
 /**
  * @brief Error codes for MQTT operations
@@ -29,7 +78,20 @@ enum class MQTTError : int8_t {
     SUBSCRIBE_FAILED = -3,
     QUEUE_FULL = -4,
     INVALID_PARAM = -5,
-    CONNECTION_FAILED = -6
+    CONNECTION_FAILED = -6,
+    DELIVERY_PENDING = 1        // QoS1 sent, delivery callback follows
+};
+
+/**
+ * @brief Outbound traffic class (lane index, highest priority first)
+ *
+ * Each lane has its own journal and RAM queue, so a telemetry backlog can
+ * never evict or delay transaction events.
+ */
+enum class MQTTPriority : uint8_t {
+    TRANSACTION = 0,    // Transaction start/stop: never dropped
+    STATUS = 1,         // Status/boot notifications
+    TELEMETRY = 2       // Meter values, heartbeat
 };
 
 /**
@@ -42,60 +104,168 @@ struct MQTTStatus {
     uint32_t messageTxCount;
     uint32_t messageRxCount;
     uint32_t lastMessageTime;
+    uint32_t lastPublishTime;       // Last PUBLISH sent (0 = none this boot)
     int8_t lastError;
+    uint32_t messageJournaled;      // Stored on flash while offline
+    uint32_t messageReplayed;       // Replayed from flash after reconnect
+    uint32_t messageAcked;          // QoS1 PUBACKs received
+    uint32_t retransmits;           // QoS1 resends (timeout or reconnect)
+    uint32_t deliveryFailed;        // QoS1 given up after MQTT_PUBACK_MAX_RETRIES
 };
 
 /**
- * @brief MQTT message (fixed size for queue)
+ * @brief Reconnect progress, one stage per handle() call
  */
-struct MQTTMessage {
-    char topic[128];
-    char payload[256];
-    uint8_t qos;
-    uint32_t timestamp;
+enum class MQTTConnectStage : uint8_t {
+    IDLE = 0,           // Waiting for the next attempt
+    SESSION             // Transport open, MQTT CONNECT next
+};
+
+/**
+ * @brief How the broker certificate is checked
+ */
+enum class MQTTTrustMode : uint8_t {
+    INSECURE = 0,       // No anchors on LittleFS: encrypted, not authenticated
+    FINGERPRINT,        // Leaf certificate pinned by SHA-1
+    CA                  // Chain validated against MQTT_TLS_CA_PATH (needs time)
 };
 
+/**
+ * @brief Unix time source for certificate validity checks (0 = unknown)
+ */
+typedef uint32_t (*MQTTTimeSource)();
+
 /**
  * @brief Message callback function type
+ *
+ * payload is not null-terminated and is only valid during the call.
  */
 typedef void (*MQTTMessageCallback)(const char* topic, const char* payload, uint16_t length);
 
 /**
- * @brief Fixed-size message queue (no STL)
+ * @brief QoS1 delivery report (PUBACK received, or given up)
+ */
+typedef void (*MQTTDeliveryCallback)(uint32_t token, bool delivered);
+
+/**
+ * @brief QoS1 PUBLISH awaiting PUBACK (packet bytes held in inflightStore)
+ */
+struct MQTTInFlight {
+    uint16_t packetId;
+    uint8_t retries;
+    bool acked;                 // PUBACKed (or given up), released once oldest
+    uint16_t packetLength;
+    uint32_t sentAt;
+    uint32_t token;             // Delivery callback token
+};
+/**
+ * @brief Queued message record header (followed by topic, then payload)
+ */
+struct __attribute__((packed)) MQTTQueueRecord {
+    uint8_t topicLength;
+    uint8_t qos;
+    uint16_t payloadLength;
+    uint32_t timestamp;
+};
+
+/**
+ * @brief Message queue of length-prefixed records in one byte ring (no STL)
+ *
+ * Records are packed back to back, so short messages cost only their own
+ * bytes and long payloads are never truncated. Payloads may wrap; read
+ * them with span().
  */
 template<size_t N>
-class FixedMessageQueue {
+class MessageRing {
 private:
-    MQTTMessage messages[N];
-    size_t head;
-    size_t tail;
+    RingBuffer<N> ring;
     size_t count;
 
 public:
-    FixedMessageQueue() : head(0), tail(0), count(0) {}
+    MessageRing() : count(0) {}
 
-    bool push(const MQTTMessage& msg) {
-        if (count >= N) return false;
-        messages[head] = msg;
-        head = (head + 1) % N;
+    /**
+     * @brief True if a record of this size can ever fit
+     */
+    static bool fits(size_t topicLength, size_t payloadLength) {
+        return topicLength <= 0xFF && payloadLength <= 0xFFFF &&
+               sizeof(MQTTQueueRecord) + topicLength + payloadLength <= N;
+    }
+
+    /**
+     * @brief True if a record of this size fits right now
+     */
+    bool hasRoom(size_t topicLength, size_t payloadLength) const {
+        return sizeof(MQTTQueueRecord) + topicLength + payloadLength <= ring.free();
+    }
+
+    bool push(const char* topic, const uint8_t* payload, size_t length, uint8_t qos, uint32_t timestamp) {
+        size_t topicLength = strlen(topic);
+        if (!fits(topicLength, length) || !hasRoom(topicLength, length)) return false;
+
+        MQTTQueueRecord record;
+        record.topicLength = (uint8_t)topicLength;
+        record.qos = qos;
+        record.payloadLength = (uint16_t)length;
+        record.timestamp = timestamp;
+
+        ring.pushMultiple((const uint8_t*)&record, sizeof(record));
+        ring.pushMultiple((const uint8_t*)topic, topicLength);
+        ring.pushMultiple(payload, length);
         count++;
         return true;
     }
 
-    bool pop(MQTTMessage& msg) {
+    /**
+     * @brief Read oldest record header and topic (NUL-terminated)
+     */
+    bool peek(MQTTQueueRecord& record, char* topic, size_t topicSize) const {
         if (count == 0) return false;
-        msg = messages[tail];
-        tail = (tail + 1) % N;
-        count--;
+
+        uint8_t* bytes = (uint8_t*)&record;
+        for (size_t i = 0; i < sizeof(record); i++) {
+            ring.peekAt(i, bytes[i]);
+        }
+
+        size_t n = record.topicLength < topicSize ? record.topicLength : topicSize - 1;
+        for (size_t i = 0; i < n; i++) {
+            uint8_t c;
+            ring.peekAt(sizeof(record) + i, c);
+            topic[i] = (char)c;
+        }
+        topic[n] = '\0';
         return true;
     }
 
+    /**
+     * @brief Contiguous payload bytes of the oldest record from offset
+     */
+    const uint8_t* span(const MQTTQueueRecord& record, size_t offset, size_t& length) {
+        size_t start = sizeof(record) + record.topicLength + offset;
+        const uint8_t* data = ring.readSpan(start, length);
+        size_t remaining = record.payloadLength - offset;
+        if (length > remaining) length = remaining;
+        return data;
+    }
+
+    /**
+     * @brief Drop oldest record
+     */
+    void pop() {
+        MQTTQueueRecord record;
+        char topic[1];
+        if (!peek(record, topic, sizeof(topic))) return;
+        ring.discard(sizeof(record) + record.topicLength + record.payloadLength);
+        count--;
+    }
+
     size_t size() const { return count; }
+    size_t bytesUsed() const { return ring.available(); }
     bool isEmpty() const { return count == 0; }
-    bool isFull() const { return count >= N; }
 
     void clear() {
-        head = tail = count = 0;
+        ring.clear();
+        count = 0;
     }
 };
 
@@ -116,6 +286,14 @@ private:
     // WiFi clients (stack allocated)
     WiFiClient wifiClient;
     WiFiClientSecure wifiSecureClient;
+    BearSSL::Session tlsSession;    // Resumed on reconnect (short handshake)
+    BearSSL::X509List trustAnchors; // Parsed once from MQTT_TLS_CA_PATH
+    MQTTTrustMode trustMode;
+    int8_t mflnSupported;           // -1 = not probed yet
+    MQTTTimeSource timeSource;
+
+    // PUBACK tap between PubSubClient and the socket
+    MQTTTapClient tap;
 
     // MQTT client (stack allocated)
     PubSubClient client;
@@ -126,15 +304,66 @@ private:
     // Status
     MQTTStatus status;
 
-    // Message queue (max 10 messages)
-    FixedMessageQueue<10> messageQueue;
-
-    // User callback
+    // Per-priority backlog: offline journal on LittleFS, RAM queue fallback
+    struct Lane {
+        OfflineJournal journal;
+        MessageRing<MQTT_LANE_QUEUE_BYTES> queue;
+        uint16_t replayPacketId;    // Journaled QoS1 record awaiting PUBACK (0 = none)
+
+        Lane(const char* dir, uint8_t segments) : journal(dir, segments), replayPacketId(0) {}
+    };
+    Lane lanes[MQTT_PRIORITY_COUNT];
+    uint32_t lastDrain;
+
+    // Reconnect scheduling
+    DecorrelatedJitter reconnectPolicy;
+    uint8_t reconnectAttempts;
+    uint32_t lastReconnectAttempt;
+    uint32_t reconnectDelay;
+    MQTTConnectStage connectStage;
+
+    // QoS1 window: in send order, encoded packets kept for retransmission
+    MQTTInFlight inflight[MQTT_INFLIGHT_WINDOW];
+    uint8_t inflightHead;
+    uint8_t inflightCount;
+    uint16_t nextPacketId;
+    RingBuffer<MQTT_INFLIGHT_BYTES> inflightStore;
+
+    // User callbacks
     MQTTMessageCallback userCallback;
+    MQTTDeliveryCallback deliveryCallback;
+    void (*idleCallback)();
+    void (*handshakeCallback)(bool active);
+
+    // True while openTransport() blocks in the TCP/TLS connect
+    bool handshaking;
 
     // Private methods
     bool connectInternal();
     void updateStatus();
+    void scheduleReconnect(uint32_t now);
+    void loadTrust();
+    bool prepareTls();
+    bool openTransport();
+    void beginHandshake();
+    void endHandshake();
+    MQTTError openSession();
+    void connectFailed(int rc);
+    void connectStep();
+    MQTTError publishNow(const char* topic, const uint8_t* payload, size_t length, uint8_t qos,
+                         uint32_t token);
+    static size_t qos1PacketSize(size_t topicLength, size_t length);
+    bool hasInflightRoom(size_t topicLength, size_t length) const;
+    uint8_t stageInflight(const char* topic, size_t length, uint32_t token);
+    void settleReplay(uint16_t packetId, bool delivered);
+    bool sendInflight(uint8_t index, bool duplicate);
+    void processPubAcks();
+    void checkInflightTimeouts();
+    void resendInflight();
+    void releaseAcked();
+    void drainBacklog();
+    bool replayJournaled(Lane& lane);
+    bool publishQueued(Lane& lane);
     static void staticCallback(char* topic, byte* payload, unsigned int length);
 
     // Static instance pointer for callback
@@ -157,11 +386,43 @@ public:
     MQTTClient& operator=(const MQTTClient&) = delete;
 
     /**
-     * @brief Connect to MQTT broker
+     * @brief Connect to MQTT broker (transport, then MQTT session)
      * @return MQTTError::SUCCESS if connected
+     *
+     * Runs both stages back to back; handle() instead reconnects one stage
+     * per call. Either way the idle hook runs during the CONNACK wait, and
+     * during the TCP/TLS connect from the yields inside it (see
+     * setHandshakeCallback).
      */
     MQTTError connect();
 
+    /**
+     * @brief Hook run while waiting for the broker (e.g. service the STM32)
+     */
+    void setIdleCallback(void (*callback)()) {
+        idleCallback = callback;
+        tap.setIdleCallback(callback);
+    }
+
+    /**
+     * @brief Hook called with true before and false after the TCP/TLS connect
+     *
+     * The connect itself still blocks (up to MQTT_TLS_TIMEOUT_MS). The idle
+     * hook only runs when it yields, which can be a second apart during the
+     * key exchange, so the caller should also hold back the STM32.
+     */
+    void setHandshakeCallback(void (*callback)(bool active)) { handshakeCallback = callback; }
+
+    /**
+     * @brief Clock for CA validation; connects wait for it in CA mode
+     */
+    void setTimeSource(MQTTTimeSource source) { timeSource = source; }
+
+    /**
+     * @brief Broker certificate check in use (TLS only)
+     */
+    MQTTTrustMode getTrustMode() const { return trustMode; }
+
     /**
      * @brief Disconnect from broker
      */
@@ -177,9 +438,35 @@ public:
      * @param topic Topic string (will be copied)
      * @param payload Payload string (will be copied)
      * @param qos QoS level (0 or 1)
+     * @param priority Traffic class (lane)
+     * @param deliveryToken Passed to the delivery callback (QoS1 only)
      * @return MQTTError code
      */
-    MQTTError publish(const char* topic, const char* payload, uint8_t qos = 0);
+    MQTTError publish(const char* topic, const char* payload, uint8_t qos = 0,
+                      MQTTPriority priority = MQTTPriority::TELEMETRY,
+                      uint32_t deliveryToken = MQTT_NO_DELIVERY_TOKEN);
+
+    /**
+     * @brief Publish raw payload bytes (binary-safe, no NUL terminator needed)
+     * @param topic Topic string (will be copied)
+     * @param payload Payload bytes (will be copied)
+     * @param length Payload length
+     * @param qos QoS level (0 or 1)
+     * @param priority Traffic class (lane)
+     * @param deliveryToken Passed to the delivery callback (QoS1 only)
+     * @return MQTTError code, DELIVERY_PENDING if sent as QoS1 with a token
+     *
+     * While offline (or while older records of the same lane are still
+     * pending) the message is appended to that lane's journal, so ordering
+     * is preserved per lane. A full lane only refuses its own traffic.
+     *
+     * QoS1 messages sent live enter the inflight window and are resent
+     * until PUBACKed. Only those report through the delivery callback;
+     * queued/journaled messages return SUCCESS straight away.
+     */
+    MQTTError publish(const char* topic, const uint8_t* payload, size_t length,
+                      uint8_t qos = 0, MQTTPriority priority = MQTTPriority::TELEMETRY,
+                      uint32_t deliveryToken = MQTT_NO_DELIVERY_TOKEN);
 
     /**
      * @brief Subscribe to topic
@@ -199,6 +486,16 @@ public:
      */
     void setCallback(MQTTMessageCallback callback);
 
+    /**
+     * @brief Set QoS1 delivery report callback
+     */
+    void setDeliveryCallback(MQTTDeliveryCallback callback) { deliveryCallback = callback; }
+
+    /**
+     * @brief True while a QoS1 message with this token awaits PUBACK
+     */
+    bool isDeliveryPending(uint32_t token) const;
+
     /**
      * @brief Handle MQTT loop and reconnection
      * Must be called frequently in main loop()
@@ -211,14 +508,26 @@ public:
     const MQTTStatus& getStatus() const { return status; }
 
     /**
-     * @brief Get queue size
+     * @brief Get queue size (RAM queue, all lanes)
+     */
+    size_t getQueueSize() const;
+
+    /**
+     * @brief QoS1 messages awaiting PUBACK
      */
-    size_t getQueueSize() const { return messageQueue.size(); }
+    uint8_t getInFlightCount() const { return inflightCount; }
 
     /**
-     * @brief Clear message queue
+     * @brief Clear message queues and offline journals (all lanes)
      */
-    void clearQueue() { messageQueue.clear(); }
+    void clearQueue();
+
+    /**
+     * @brief Offline journal statistics of one lane
+     */
+    const JournalStats& getJournalStats(MQTTPriority priority) const {
+        return lanes[(uint8_t)priority].journal.getStats();
+    }
 };
 
 /**
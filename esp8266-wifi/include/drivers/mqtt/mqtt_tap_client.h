@@ -0,0 +1,106 @@
+/**
+ * @file mqtt_tap_client.h
+ * @brief Pass-through Client that watches the inbound MQTT stream for PUBACKs
+ * @version 1.0.0
+ *
+ * PubSubClient 2.8 only publishes QoS0 and silently drops PUBACK packets.
+ * MQTTClient sends QoS1 PUBLISH packets itself on this client and reads
+ * the PUBACKs that the tap collects while PubSubClient consumes the stream.
+ *
+ * While idling is enabled, available() calls an idle hook whenever no data
+ * is pending, so PubSubClient's blocking CONNACK wait keeps the caller's
+ * other work (STM32 UART) serviced.
+ */
+
+#ifndef MQTT_TAP_CLIENT_H
+#define MQTT_TAP_CLIENT_H
+
+#include <Arduino.h>
+#include <Client.h>
+#include "../../utils/ring_buffer.h"
+
+// Packet IDs held for MQTTClient between two handle() calls
+#define MQTT_TAP_PUBACK_SLOTS   8
+
+/**
+ * @brief Client wrapper with an inbound MQTT packet parser
+ *
+ * Usage:
+ *   MQTTTapClient tap(wifiClient);
+ *   PubSubClient client(tap);
+ *   client.loop();
+ *   uint16_t id;
+ *   while (tap.popPubAck(id)) { ... }
+ */
+class MQTTTapClient : public Client {
+private:
+    enum class ParseState : uint8_t {
+        FIXED_HEADER,
+        REMAINING_LENGTH,
+        BODY
+    };
+
+    Client& inner;
+
+    // Inbound packet framing
+    ParseState state;
+    uint8_t packetType;
+    uint8_t lengthShift;
+    uint32_t remaining;
+    uint32_t bodyOffset;
+    uint16_t packetId;
+
+    // Called from available() while waiting (not re-entered)
+    void (*idleCallback)();
+    bool idleEnabled;
+    bool inIdle;
+
+    // Received PUBACK packet IDs (big-endian pairs)
+    RingBuffer<MQTT_TAP_PUBACK_SLOTS * 2> pubAcks;
+    uint32_t pubAcksDropped;
+
+    void feed(uint8_t byte);
+    void packetComplete();
+    void resetParser();
+
+public:
+    explicit MQTTTapClient(Client& client);
+
+    int connect(IPAddress ip, uint16_t port) override;
+    int connect(const char* host, uint16_t port) override;
+    size_t write(uint8_t byte) override;
+    size_t write(const uint8_t* buf, size_t size) override;
+    int available() override;
+    int read() override;
+    int read(uint8_t* buf, size_t size) override;
+    int peek() override;
+    bool flush(unsigned int maxWaitMs = 0) override;
+    bool stop(unsigned int maxWaitMs = 0) override;
+    uint8_t connected() override;
+    operator bool() override;
+
+    using Print::write;
+
+    /**
+     * @brief Set the hook run while a read is waiting for data
+     */
+    void setIdleCallback(void (*callback)()) { idleCallback = callback; }
+
+    /**
+     * @brief Enable/disable the idle hook (only around blocking waits)
+     */
+    void setIdleEnabled(bool enabled) { idleEnabled = enabled; }
+
+    /**
+     * @brief Take the oldest PUBACK packet ID seen on the stream
+     * @return false if none pending
+     */
+    bool popPubAck(uint16_t& id);
+
+    /**
+     * @brief PUBACKs lost because MQTTClient did not collect them in time
+     */
+    uint32_t getDroppedPubAcks() const { return pubAcksDropped; }
+};
+
+#endif // MQTT_TAP_CLIENT_H
@@ -12,15 +12,48 @@
 
 #include <Arduino.h>
 #include "../config/unified_config.h"
+#include "../../shared/mqtt_topics.h"
 
 /**
- * @brief MQTT Topic Builder (stateless utility)
+ * @brief Precomputed "ocpp/{stationId}/{deviceId}/" prefix
+ *
+ * Rebuilt only when a different config is passed or its
+ * identityRevision changes (load, factory reset, updateFromJson).
+ */
+class TopicCache {
+private:
+    char prefix[5 + sizeof(DeviceConfig::stationId) + sizeof(DeviceConfig::deviceId) + 1];
+    uint8_t length;
+    const DeviceConfig* source;
+    uint16_t revision;
+
+    void rebuild(const DeviceConfig& config);
+
+public:
+    TopicCache() : length(0), source(nullptr), revision(0) { prefix[0] = '\0'; }
+
+    /**
+     * @brief Get prefix for config (rebuilds if stale)
+     * @param length Out: prefix length
+     */
+    const char* get(const DeviceConfig& config, size_t& length);
+};
+
+/**
+ * @brief MQTT Topic Builder
  *
  * Provides centralized topic construction to avoid duplication
- * Used by both MQTTClient and OCPPMessageHandler
+ * Used by both MQTTClient and OCPPMessageHandler. Builders copy the
+ * cached prefix and append a short suffix (no snprintf per message).
  */
 namespace MQTTTopicBuilder {
 
+/**
+ * @brief Get cached "ocpp/{station}/{device}/" prefix
+ * @param length Out: prefix length
+ */
+const char* prefix(const DeviceConfig& config, size_t& length);
+
 /**
  * @brief Build heartbeat topic
  * Format: ocpp/{station}/{device}/heartbeat
@@ -33,12 +66,24 @@ void buildHeartbeat(char* buffer, size_t size, const DeviceConfig& config);
  */
 void buildStatus(char* buffer, size_t size, const DeviceConfig& config, uint8_t connectorId);
 
+/**
+ * @brief Build connector status snapshot topic (published after reconnect)
+ * Format: ocpp/{station}/{device}/status/snapshot
+ */
+void buildStatusSnapshot(char* buffer, size_t size, const DeviceConfig& config);
+
 /**
  * @brief Build meter values topic
  * Format: ocpp/{station}/{device}/meter/{connector}/meter_values
  */
 void buildMeter(char* buffer, size_t size, const DeviceConfig& config, uint8_t connectorId);
 
+/**
+ * @brief Build batched meter values topic
+ * Format: ocpp/{station}/{device}/meter/batch
+ */
+void buildMeterBatch(char* buffer, size_t size, const DeviceConfig& config);
+
 /**
  * @brief Build transaction topic
  * Format: ocpp/{station}/{device}/transaction/{type}
@@ -52,6 +97,21 @@ void buildTransaction(char* buffer, size_t size, const DeviceConfig& config, con
  */
 void buildBoot(char* buffer, size_t size, const DeviceConfig& config);
 
+/**
+ * @brief Build topic from a shared topic ID (see shared/mqtt_topics.h)
+ * @param topicId TOPIC_ID_*
+ * @param connectorId Connector for per-connector topics (ignored otherwise)
+ * @return false if topicId is unknown
+ */
+bool buildFromId(char* buffer, size_t size, const DeviceConfig& config,
+                 uint8_t topicId, uint8_t connectorId);
+
+/**
+ * @brief Append the binary payload suffix to a built topic
+ * Format: {topic}/b (MessagePack counterpart of a JSON topic)
+ */
+void appendBinarySuffix(char* buffer, size_t size);
+
 /**
  * @brief Build command subscription topic (wildcard)
  * Format: ocpp/{station}/{device}/cmd/+
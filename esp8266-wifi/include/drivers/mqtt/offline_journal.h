@@ -0,0 +1,148 @@
+/**
+ * @file offline_journal.h
+ * @brief Persistent offline MQTT message store (LittleFS, append-only)
+ * @version 1.0.0
+ *
+ * Layout (one directory per journal, e.g. one per priority lane):
+ * - {dir}/<id>.seg   Segment files, records appended until JOURNAL_SEGMENT_SIZE
+ * - {dir}/index      Head (segment + offset) and tail segment
+ *
+ * Record: journal_record_header_t | topic | payload
+ *
+ * Each record carries a CRC-16 over header, topic and payload. A write
+ * that fails is cut off again, and init() truncates the tail segment
+ * after its last whole record (crash mid-append). Replay skips a record
+ * that still fails its CRC and resumes at the next whole one, so one bad
+ * record never takes the records behind it along.
+ *
+ * Replay is at-least-once: the head offset is persisted every few records
+ * and on segment changes, so a reboot may resend a handful of records.
+ * Each journal is capped at its own segment count, so one journal filling
+ * up never takes space from another.
+ */
+
+#ifndef OFFLINE_JOURNAL_H
+#define OFFLINE_JOURNAL_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "../../shared/uart_protocol.h"
+
+#define JOURNAL_ROOT_DIR            "/mq"
+#define JOURNAL_SEGMENT_SIZE        8192
+#define JOURNAL_MAX_SEGMENTS        16      // Upper bound for any journal
+#define JOURNAL_INDEX_INTERVAL      8       // Persist head every N pops
+
+#define JOURNAL_RECORD_MAGIC        0xA6    // 0xA5: old records without CRC
+#define JOURNAL_FLAG_QOS1           0x01
+
+/**
+ * @brief On-flash record header
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t magic;
+    uint8_t flags;
+    uint8_t topic_length;
+    uint8_t reserved;
+    uint16_t payload_length;
+    uint16_t crc;               // CRC-16 over the fields above, topic and payload
+} journal_record_header_t;
+
+/**
+ * @brief Journal statistics
+ */
+struct JournalStats {
+    uint32_t appended;
+    uint32_t replayed;
+    uint32_t refused;           // Journal full or write error
+    uint32_t corrupt;           // Bad records skipped on replay or cut at init
+};
+
+/**
+ * @brief Append-only offline journal
+ *
+ * Usage:
+ *   OfflineJournal journal("/mq/0", 4);   // Directory, max segments
+ *   journal.init();                       // After LittleFS.begin()
+ *   journal.append(topic, data, len, 1);
+ *
+ *   char topic[128]; uint16_t len; uint8_t qos;
+ *   if (journal.peek(topic, sizeof(topic), len, qos)) {
+ *       // stream len bytes from journal.payload()
+ *       journal.pop();                    // Only after a successful publish
+ *   }
+ */
+class OfflineJournal {
+private:
+    char dir[16];
+    uint8_t maxSegments;
+    uint32_t headSegment;
+    uint32_t headOffset;
+    uint32_t headSize;          // Size of head segment file (when head != tail)
+    uint32_t tailSegment;
+    uint32_t tailSize;
+    uint32_t pendingRecordSize; // Size of the record returned by peek()
+    uint8_t popsSinceSave;
+    bool ready;
+
+    File reader;
+    JournalStats stats;
+
+    void segmentPath(char* buffer, size_t size, uint32_t segment) const;
+    void indexPath(char* buffer, size_t size) const;
+    bool saveIndex();
+    bool loadIndex();
+    void finishHeadSegment();
+    bool truncateSegment(uint32_t segment, uint32_t size);
+    void repairTail();
+    uint32_t segmentsInUse() const { return tailSegment - headSegment + 1; }
+
+public:
+    /**
+     * @param directory Journal directory (under JOURNAL_ROOT_DIR)
+     * @param segments Segment cap (1..JOURNAL_MAX_SEGMENTS)
+     */
+    OfflineJournal(const char* directory, uint8_t segments);
+
+    /**
+     * @brief Load index from flash (LittleFS must be mounted)
+     * @return true if the journal is usable
+     */
+    bool init();
+
+    /**
+     * @brief Append a record
+     * @return false if full, too large or the write failed
+     */
+    bool append(const char* topic, const uint8_t* payload, size_t length, uint8_t qos);
+
+    /**
+     * @brief Open the oldest record
+     * @param topic Out: NUL-terminated topic
+     * @param length Out: payload length, read it from payload()
+     * @param qos Out: QoS requested at append time
+     * @return false if the journal is empty
+     */
+    bool peek(char* topic, size_t topicSize, uint16_t& length, uint8_t& qos);
+
+    /**
+     * @brief Payload stream of the record opened by peek()
+     */
+    File& payload() { return reader; }
+
+    /**
+     * @brief Drop the record opened by peek()
+     */
+    void pop();
+
+    /**
+     * @brief Discard all records
+     */
+    void clear();
+
+    bool isReady() const { return ready; }
+    bool isEmpty() const;
+    const JournalStats& getStats() const { return stats; }
+};
+
+#endif // OFFLINE_JOURNAL_H
@@ -0,0 +1,36 @@
+/**
+ * @file embedded_assets.h
+ * @brief Web UI handler serving the gzipped assets compiled into flash
+ * @version 1.0.0
+ *
+ * web_assets.h (tools/generate_web_header.py) holds every UI file gzipped
+ * in PROGMEM with a content-hash ETag. Responses stream straight from
+ * flash with Content-Encoding: gzip, so the request path never touches
+ * LittleFS, and revisits with a matching If-None-Match get a bodyless 304.
+ *
+ * Cache policy:
+ * - Content-hashed names (app.C441XP1K.js): one year, immutable
+ * - index.html and the rest: no-cache (always revalidated, usually a 304)
+ */
+
+#ifndef EMBEDDED_ASSETS_H
+#define EMBEDDED_ASSETS_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+#define ASSET_CACHE_IMMUTABLE   "public, max-age=31536000, immutable"
+#define ASSET_CACHE_REVALIDATE  "no-cache"
+
+class EmbeddedAssetHandler : public AsyncWebHandler {
+public:
+    bool canHandle(AsyncWebServerRequest* request) override;
+    void handleRequest(AsyncWebServerRequest* request) override;
+
+    /**
+     * @brief Number of embedded files (including the "/" alias)
+     */
+    static size_t getAssetCount();
+};
+
+#endif // EMBEDDED_ASSETS_H
@@ -0,0 +1,97 @@
+/**
+ * @file live_telemetry.h
+ * @brief Live telemetry push to the local web UI (WebSocket /api/live)
+ * @version 1.0.0
+ *
+ * Features:
+ * - Latest value per (topic, connector) kept in a fixed slot table
+ * - Per-client pending mask: a client only gets what changed since it
+ *   was last served, new clients get a snapshot of every slot
+ * - Backpressure: nothing is queued to a client whose WebSocket queue is
+ *   full; a newer value replaces the unsent one (drop-oldest), so a slow
+ *   client sees fewer, fresher frames instead of a growing backlog
+ *
+ * Frames: {"type":"meter","connector":1,"data":{...}}
+ */
+
+#ifndef LIVE_TELEMETRY_H
+#define LIVE_TELEMETRY_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+#define LIVE_PATH               "/api/live"
+#define LIVE_MAX_CLIENTS        2
+#define LIVE_SLOT_COUNT         6
+#define LIVE_SLOT_SIZE          256     // Envelope + payload
+#define LIVE_LINK_PERIOD_MS     2000
+
+/**
+ * @brief Frame types
+ */
+enum class LiveTopic : uint8_t {
+    METER = 0,
+    STATUS,
+    LINK,
+    COUNT
+};
+
+class LiveTelemetry {
+private:
+    struct Slot {
+        LiveTopic topic;
+        uint8_t connector;
+        bool used;
+        uint16_t length;
+        uint32_t sequence;          // Update order, oldest pending goes first
+        char data[LIVE_SLOT_SIZE];
+    };
+
+    struct Client {
+        uint32_t id;
+        bool active;
+        uint8_t pending;            // Bit per slot
+        uint32_t coalesced;         // Values replaced before they were sent
+    };
+
+    AsyncWebSocket ws;
+    Slot slots[LIVE_SLOT_COUNT];
+    Client clients[LIVE_MAX_CLIENTS];
+    uint32_t sequence;
+    uint32_t oversized;
+
+    void onEvent(AsyncWebSocketClient* client, AwsEventType type);
+    int8_t findSlot(LiveTopic topic, uint8_t connector);
+    void flushClient(Client& client);
+
+    static const char* topicName(LiveTopic topic);
+
+public:
+    LiveTelemetry();
+
+    /**
+     * @brief Register the WebSocket endpoint (before server.begin())
+     */
+    void attach(AsyncWebServer& server);
+
+    /**
+     * @brief Store the latest value for a topic and mark it for all clients
+     * @param json Payload object, wrapped as "data" in the frame
+     * @return false if it does not fit a slot (dropped)
+     */
+    bool publish(LiveTopic topic, uint8_t connector, const char* json, size_t length);
+
+    /**
+     * @brief Send pending frames to clients with room (call from the main loop)
+     */
+    void handle();
+
+    /**
+     * @brief True if anyone is listening (skip building frames otherwise)
+     */
+    bool hasClients() const;
+
+    uint32_t getOversizedCount() const { return oversized; }
+};
+
+#endif // LIVE_TELEMETRY_H
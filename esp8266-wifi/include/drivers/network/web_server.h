@@ -9,16 +9,20 @@
 
 #include <Arduino.h>
 #include <ESPAsyncWebServer.h>
+#include "drivers/network/live_telemetry.h"
 #include "utils/logger.h"
 
 /**
  * @brief WebServer driver (thin wrapper)
  *
- * Serves static files from LittleFS and provides API route registration
+ * Serves the embedded web UI (EmbeddedAssetHandler), pushes live
+ * telemetry over WebSocket (LiveTelemetry) and provides API route
+ * registration
  */
 class WebServerDriver {
 private:
     AsyncWebServer server;
+    LiveTelemetry live;
     bool initialized;
     uint16_t port;
 
@@ -71,6 +75,11 @@ public:
      */
     AsyncWebServer& getServer() { return server; }
 
+    /**
+     * @brief Live telemetry feed (WebSocket /api/live)
+     */
+    LiveTelemetry& getLive() { return live; }
+
     // Prevent copying
     WebServerDriver(const WebServerDriver&) = delete;
     WebServerDriver& operator=(const WebServerDriver&) = delete;
@@ -1,7 +1,24 @@
 /**
  * @file wifi_manager.h
  * @brief WiFi Manager (ESP8266 optimized - without WiFiManager library)
- * @version 3.0.0
+ * @version 3.1.0
+ *
+ * Fast reconnect: after each successful join the BSSID, channel and DHCP
+ * lease are cached in RTC user memory (survives resets and deep sleep)
+ * and in a small LittleFS file (survives power loss; rewritten only when
+ * the entry changes). The next join skips the scan and, with a cached
+ * lease or wifi.staticIp, DHCP as well; if the AP does not answer within
+ * WIFI_FAST_CONNECT_TIMEOUT_MS the cache is dropped and a full
+ * scan + DHCP join follows.
+ *
+ * A cached lease is reused only while less than half of it (DHCP T1) has
+ * passed by the wall clock, or, before the clock is set, when the entry
+ * is the RTC copy (warm reset, no power loss). The DHCP client is
+ * restarted right after such a join, so the lease is renewed as usual
+ * and handle() keeps the cached start and length in step with it.
+ *
+ * Modem sleep is always on; setListenInterval() makes it deeper while
+ * the charger is idle (chosen by PowerPolicy, applied by DeviceManager).
  */
 
 #ifndef WIFI_MANAGER_H
@@ -10,6 +27,35 @@
 #include <Arduino.h>
 #include <ESP8266WiFi.h>
 #include "../config/unified_config.h"
+#include "../../utils/retry_policy.h"
+
+#define WIFI_CACHE_MAGIC                0x57464332  // "WFC2"
+#define WIFI_CACHE_PATH                 "/wifi_cache.bin"
+#define WIFI_CACHE_RTC_OFFSET           0           // RTC user memory block (4 bytes each)
+#define WIFI_FAST_CONNECT_TIMEOUT_MS    1500
+#define WIFI_FULL_CONNECT_TIMEOUT_MS    10000
+#define WIFI_LEASE_MAX_REUSE            8           // Joins on a cached lease before DHCP again
+#define WIFI_LEASE_CHECK_MS             60000       // Lease bookkeeping interval while connected
+#define WIFI_MIN_EPOCH                  1672531200UL  // 2023-01-01, below = clock unset
+#define WIFI_LISTEN_INTERVAL_MAX        10          // SDK limit (beacon intervals)
+
+/**
+ * @brief Last successful join (RTC memory / LittleFS, 40 bytes)
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint16_t crc;               // CRC-16 over the bytes after this field
+    uint16_t network;           // CRC-16 of SSID + password the entry belongs to
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t leaseUses;          // Joins made on the cached lease
+    uint32_t ip;                // 0 = no lease cached
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+    uint32_t leaseStart;        // Unix time of the last DHCP ACK, 0 = unknown
+    uint32_t leaseTime;         // Lease length in seconds, 0 = unknown
+} wifi_cache_t;
 
 /**
  * @brief WiFi error codes
@@ -33,6 +79,7 @@ struct WiFiStatus {
     IPAddress gateway;
     uint32_t connectTime;
     uint32_t disconnectCount;
+    uint8_t listenInterval;     // Modem sleep beacons per wakeup, 0 = every DTIM
     char ssid[32];
 };
 
@@ -44,10 +91,29 @@ private:
     const DeviceConfig& config;
     WiFiStatus status;
     uint32_t lastReconnectAttempt;
+    uint32_t reconnectDelay;
+    uint8_t reconnectAttempts;
 
-    static constexpr uint32_t RECONNECT_INTERVAL = 30000;
+    // Jittered backoff so chargers behind one AP do not rejoin in lock-step
+    static constexpr uint32_t RECONNECT_BASE_MS = 10000;
+    static constexpr uint32_t RECONNECT_MAX_MS = 300000;
+    DecorrelatedJitter reconnectPolicy;
+
+    wifi_cache_t cache;
+    bool cacheValid;
+    bool cacheFromRtc;          // Entry survived a warm reset (no power loss)
+    uint32_t lastLeaseCheck;
+    uint32_t (*timeSource)();   // Unix time, 0 until set
+
+    bool leaseReusable() const;
+    void trackLease();
 
     void updateStatus();
+    bool waitForConnection(uint32_t timeoutMs);
+    bool applyIpConfig(bool useLease);
+    void loadCache(const char* ssid, const char* password);
+    void saveCache(const char* ssid, const char* password, bool onLease);
+    void clearCache();
 
 public:
     explicit CustomWiFiManager(const DeviceConfig& cfg);
@@ -59,6 +125,17 @@ public:
     WiFiError startAPMode();
     void handle();
 
+    /**
+     * @brief Modem sleep depth; the station stays associated
+     * @param listenInterval Wake every N beacons (1..10), 0 = every DTIM (default)
+     */
+    bool setListenInterval(uint8_t listenInterval);
+
+    /**
+     * @brief Wall clock for lease expiry (Unix time, 0 while unset)
+     */
+    void setTimeSource(uint32_t (*source)()) { timeSource = source; }
+
     bool isConnected() const;
     bool isAPMode() const { return status.apMode; }
     const WiFiStatus& getStatus() const { return status; }
@@ -1,15 +1,43 @@
 /**
  * @file ntp_time.h
  * @brief NTP Time Synchronization Driver
- * @version 1.0.0
+ * @version 2.0.0
+ *
+ * Non-blocking SNTP client:
+ * - update() never waits: DNS is resolved asynchronously, the request is
+ *   sent and the reply is picked up on a later pass
+ * - Up to NTP_MAX_SERVERS servers, tried in turn when one fails
+ * - Offset is RTT-compensated (RFC 4330 four-timestamp formula)
+ * - Between syncs the time is extrapolated from micros64(), corrected for
+ *   the measured crystal drift, and never runs backwards for small steps
  */
 
 #ifndef NTP_TIME_H
 #define NTP_TIME_H
 
 #include <Arduino.h>
-#include <NTPClient.h>
 #include <WiFiUdp.h>
+#include <lwip/ip_addr.h>
+
+#define NTP_MAX_SERVERS             3
+#define NTP_PORT                    123
+#define NTP_LOCAL_PORT              2390
+#define NTP_PACKET_SIZE             48
+#define NTP_DNS_TIMEOUT_MS          2000
+#define NTP_REPLY_TIMEOUT_MS        1000
+#define NTP_RETRY_INTERVAL_MS       30000       // After every server failed
+#define NTP_DRIFT_MIN_INTERVAL_MS   600000      // Shortest sync interval used for drift
+#define NTP_DRIFT_MAX_PPB           500000      // Clamp: 500 ppm
+#define NTP_SLEW_LIMIT_US           1000000     // Backward steps below this are absorbed
+
+/**
+ * @brief Sync state machine
+ */
+enum class NtpState : uint8_t {
+    IDLE,           // Waiting for the next sync
+    RESOLVING,      // DNS lookup in flight
+    WAITING         // Request sent, waiting for the reply
+};
 
 /**
  * @brief NTP Time Driver
@@ -19,52 +47,105 @@
 class NTPTimeDriver {
 private:
     WiFiUDP udp;
-    NTPClient* ntpClient;
+    const char* servers[NTP_MAX_SERVERS];
+    uint8_t serverCount;
+    uint8_t serverIndex;        // Server of the current attempt
+    uint8_t attempts;           // Servers tried in this round
+
+    NtpState state;
+    uint32_t stateStart;        // millis() when the state was entered
+    uint32_t nextSync;          // millis() of the next round
+    IPAddress serverIP;
+    volatile bool dnsDone;
+    volatile bool dnsOk;
+
+    uint64_t requestLocalUs;    // T1 on the local clock
+    uint32_t requestTag[2];     // Our transmit timestamp, echoed as originate
+
     bool synced;
     uint32_t lastSync;
-    int16_t timezoneOffset;  // Offset in minutes
+    int16_t timezoneOffset;     // Offset in minutes
+
+    int64_t offsetUs;           // Unix us = local us + offset (at syncLocalUs)
+    uint64_t syncLocalUs;       // Local clock at the last sync
+    int32_t driftPpb;           // Local clock rate error
+    uint64_t lastUnixUs;        // Last value handed out (monotonic clamp)
+    uint32_t lastRttUs;
+    uint8_t lastStratum;
 
     static constexpr uint32_t SYNC_INTERVAL = 3600000;  // 1 hour
 
+    bool startAttempt();
+    void nextServer();
+    void sendRequest();
+    bool readReply();           // true once the reply was handled
+    void applySample(int64_t sampleOffsetUs, uint64_t localUs);
+    void setState(NtpState newState);
+
+    static void onDnsFound(const char* name, const ip_addr_t* addr, void* arg);
+
 public:
     NTPTimeDriver();
     ~NTPTimeDriver();
 
     /**
-     * @brief Initialize NTP client
+     * @brief Initialize NTP client (does not wait for a sync)
      * @param server NTP server (default: pool.ntp.org)
      * @param tzOffset Timezone offset in minutes (default: 0 UTC)
      */
     void init(const char* server = "pool.ntp.org", int16_t tzOffset = 0);
 
     /**
-     * @brief Update NTP time (call in loop)
+     * @brief Add a fallback server (tried when the previous one fails)
+     * @return false if the server table is full
+     */
+    bool addServer(const char* server);
+
+    /**
+     * @brief Advance the sync state machine (call on every loop pass)
+     *
+     * Polls the UDP socket; the reply is timestamped when it is read, so
+     * calling this less often adds up to half the polling gap to the offset.
      */
     void update();
 
     /**
-     * @brief Force sync now
-     * @return true if sync successful
+     * @brief Start a sync round now
+     * @return false if no server is set or a round is already running
      */
     bool forceSync();
 
     /**
-     * @brief Get current unix timestamp
+     * @brief Get current unix timestamp (UTC, uptime seconds if never synced)
      */
     uint32_t getUnixTime();
 
+    /**
+     * @brief Get current unix time in microseconds (UTC)
+     */
+    uint64_t getUnixTimeUs();
+
     /**
      * @brief Check if time is synced
      */
     bool isSynced() const { return synced; }
 
+    /**
+     * @brief Check if a sync round is in progress
+     */
+    bool isBusy() const { return state != NtpState::IDLE; }
+
     /**
      * @brief Get timezone offset in minutes
      */
     int16_t getTimezoneOffset() const { return timezoneOffset; }
 
+    uint32_t getLastRttUs() const { return lastRttUs; }
+    int32_t getDriftPpb() const { return driftPpb; }
+    uint8_t getStratum() const { return lastStratum; }
+
     /**
-     * @brief Get formatted time string
+     * @brief Get formatted local time string (HH:MM:SS)
      */
     String getFormattedTime();
 };
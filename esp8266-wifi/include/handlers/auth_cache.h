@@ -0,0 +1,156 @@
+/**
+ * @file auth_cache.h
+ * @brief Local authorization list and cache for id tags
+ * @version 1.0.0
+ *
+ * Answers CMD_AUTH_QUERY from the STM32 without a backend round trip, so
+ * the relay can close on a known tag right away and chargers stay usable
+ * while the backend is unreachable. Two kinds of entries share one table:
+ * - LIST:  OCPP local authorization list, set by cmd/send_local_list
+ * - CACHE: earlier backend answers reported by the STM32 (CMD_AUTH_UPDATE)
+ * List entries win over cache entries; when the table is full the cache
+ * entry closest to expiry is evicted.
+ *
+ * Entries are sorted by a 32-bit FNV-1a hash of the tag for binary search
+ * and keep the tag itself (30 bytes each), so a different tag with the
+ * same hash never matches. Tags are OCPP CiString20: compared on their
+ * first AUTH_ID_TAG_MAX bytes. Persisted to LittleFS as one file, written
+ * debounced from handle().
+ */
+
+#ifndef AUTH_CACHE_H
+#define AUTH_CACHE_H
+
+#include "../../shared/ocpp_messages.h"
+#include "../../shared/uart_protocol.h"
+#include <Arduino.h>
+
+#define AUTH_CACHE_MAX_ENTRIES      128
+#define AUTH_CACHE_PATH             "/auth_cache.bin"
+#define AUTH_CACHE_TMP_PATH         "/auth_cache.tmp"
+#define AUTH_CACHE_MAGIC            0x41555432      // "AUT2" (entries with tags)
+#define AUTH_CACHE_SAVE_DELAY_MS    5000            // Quiet time after the last change
+#define AUTH_CACHE_SAVE_MAX_DELAY_MS 30000          // Write a steady stream of changes anyway
+#define AUTH_ID_TAG_MAX             20
+
+/**
+ * @brief One id tag (packed, stored as-is in the file)
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t hash;              // FNV-1a of the id tag
+    uint32_t expiry;            // Unix time, 0 = never
+    uint8_t status;             // id_tag_status_t
+    uint8_t source;             // AUTH_SOURCE_LIST / AUTH_SOURCE_CACHE
+    char tag[AUTH_ID_TAG_MAX];  // NUL-padded, not terminated at 20 chars
+} auth_entry_t;
+
+/**
+ * @brief File header, followed by count auth_entry_t (sorted by hash)
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t magic;             // AUTH_CACHE_MAGIC
+    uint32_t listVersion;       // OCPP local list version
+    uint16_t count;
+    uint16_t crc;               // CRC-16 over the entries
+} auth_file_header_t;
+
+/**
+ * @brief Lookup result
+ */
+struct AuthResult {
+    id_tag_status_t status;     // AUTH_UNKNOWN if not found
+    uint8_t source;             // AUTH_SOURCE_*
+    uint32_t expiry;
+};
+
+/**
+ * @brief Local authorization table (owned by DeviceManager)
+ *
+ * Usage:
+ *   authCache.load();
+ *   AuthResult r = authCache.lookup(tag, len, ntpTime.getUnixTime());
+ *   authCache.remember(tag, len, AUTH_ACCEPTED, expiry, millis());
+ *   authCache.handle(millis());   // periodic: writes pending changes
+ */
+class AuthCache {
+private:
+    auth_entry_t entries[AUTH_CACHE_MAX_ENTRIES];
+    uint16_t count;
+    uint32_t listVersion;
+    bool dirty;
+    uint32_t dirtySince;        // First unsaved change
+    uint32_t lastChange;
+    uint32_t hits;
+    uint32_t misses;
+
+    static void copyTag(char* tag, const char* idTag, size_t maxLength);
+    int16_t find(uint32_t hash, const char* tag) const;
+    uint16_t lowerBound(uint32_t hash) const;
+    bool insert(uint32_t hash, const char* tag, id_tag_status_t status, uint32_t expiry, uint8_t source);
+    void removeAt(uint16_t index);
+    int16_t evictionCandidate() const;
+    void markDirty(uint32_t now);
+
+public:
+    AuthCache();
+
+    /**
+     * @brief Hash of an id tag (stops at NUL or maxLength)
+     */
+    static uint32_t hashTag(const char* idTag, size_t maxLength);
+
+    /**
+     * @brief Read the table from LittleFS (empty if missing or corrupt)
+     */
+    bool load();
+
+    /**
+     * @brief Write the table now (temp file + rename)
+     */
+    bool save();
+
+    /**
+     * @brief Write pending changes AUTH_CACHE_SAVE_DELAY_MS after the last
+     *        one, or AUTH_CACHE_SAVE_MAX_DELAY_MS after the first
+     * @param now millis()
+     */
+    void handle(uint32_t now);
+
+    /**
+     * @brief Look up an id tag
+     * @param unixTime Current time (0 = clock not set: expiry not checked)
+     * @return AUTH_EXPIRED for entries past their expiry
+     */
+    AuthResult lookup(const char* idTag, size_t maxLength, uint32_t unixTime);
+
+    /**
+     * @brief Cache a backend answer (ignored for tags on the local list)
+     * @param now millis()
+     * @return false if the table is full of list entries
+     */
+    bool remember(const char* idTag, size_t maxLength, id_tag_status_t status, uint32_t expiry, uint32_t now);
+
+    /**
+     * @brief Local list update (cmd/send_local_list)
+     *
+     * Full: beginListUpdate(true, ...), then setListEntry() per tag.
+     * Differential: beginListUpdate(false, ...), setListEntry() or
+     * removeListEntry() per tag.
+     */
+    void beginListUpdate(bool full, uint32_t version, uint32_t now);
+    bool setListEntry(const char* idTag, size_t maxLength, id_tag_status_t status, uint32_t expiry, uint32_t now);
+    void removeListEntry(const char* idTag, size_t maxLength, uint32_t now);
+
+    /**
+     * @brief Drop all entries (list and cache)
+     */
+    void clear(uint32_t now);
+
+    uint16_t size() const { return count; }
+    uint32_t getListVersion() const { return listVersion; }
+    uint32_t getHits() const { return hits; }
+    uint32_t getMisses() const { return misses; }
+    bool isDirty() const { return dirty; }
+};
+
+#endif // AUTH_CACHE_H
@@ -0,0 +1,194 @@
+/**
+ * @file charging_profiles.h
+ * @brief OCPP charging profile store and limit evaluator
+ * @version 1.0.0
+ *
+ * Profiles arrive as cmd/set_charging_profile and are kept as packed
+ * structs (LittleFS, survives reboot). The STM32 never sees them: it is
+ * sent one RSP_CHARGING_LIMIT per connector whenever that connector's
+ * limit changes, and nothing otherwise.
+ *
+ * Composite limit per connector (OCPP 1.6 rules):
+ * - TxProfile for the connector, else TxDefaultProfile for the connector,
+ *   else TxDefaultProfile for connector 0; highest stackLevel wins
+ * - ChargePointMaxProfile (connector 0) caps the whole site: shared out
+ *   between the charging connectors, none gets more than its own limit
+ *   (unused headroom goes to the others)
+ *
+ * The limits for the next CHARGING_TIMELINE_SLOTS schedule changes are
+ * precomputed in one pass; tick() walks that timeline and only evaluates
+ * again when it runs out, a profile changes or a connector starts/stops.
+ */
+
+#ifndef CHARGING_PROFILES_H
+#define CHARGING_PROFILES_H
+
+#include "handlers/connector_state.h"
+#include <Arduino.h>
+
+#define CHARGING_PROFILE_MAX        8
+#define CHARGING_PERIODS_MAX        8       // chargingSchedulePeriod entries per profile
+#define CHARGING_TIMELINE_SLOTS     4       // Precomputed future limit changes
+#define CHARGING_HORIZON_S          86400   // Timeline never looks further ahead
+#define CHARGING_NO_LIMIT           0xFFFF  // Limit value: no profile applies
+#define CHARGING_NOMINAL_VOLTAGE    230     // W schedules are converted to A with this
+#define CHARGING_PROFILE_PATH       "/charging_profiles.bin"
+#define CHARGING_PROFILE_TMP_PATH   "/charging_profiles.tmp"
+#define CHARGING_PROFILE_MAGIC      0x43484750      // "CHGP"
+
+// chargingProfilePurpose
+#define CHARGING_PURPOSE_CP_MAX     0       // ChargePointMaxProfile
+#define CHARGING_PURPOSE_TX_DEFAULT 1       // TxDefaultProfile
+#define CHARGING_PURPOSE_TX         2       // TxProfile
+
+// chargingProfileKind
+#define CHARGING_KIND_ABSOLUTE      0
+#define CHARGING_KIND_RECURRING     1
+#define CHARGING_KIND_RELATIVE      2       // Starts at its first evaluation (no transaction clock here)
+
+// recurrencyKind
+#define CHARGING_RECUR_DAILY        0
+#define CHARGING_RECUR_WEEKLY       1
+
+/**
+ * @brief One chargingSchedulePeriod
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t startPeriod;       // Seconds from the schedule start
+    uint16_t limit;             // 0.1 A (W schedules converted on install)
+} charging_period_t;
+
+/**
+ * @brief One stored charging profile (packed, stored as-is in the file)
+ */
+typedef struct __attribute__((packed)) {
+    int32_t id;                 // chargingProfileId
+    uint8_t connectorId;        // 0 = whole charge point
+    uint8_t stackLevel;
+    uint8_t purpose;            // CHARGING_PURPOSE_*
+    uint8_t kind;               // CHARGING_KIND_*
+    uint8_t recurrency;         // CHARGING_RECUR_* (recurring only)
+    uint32_t validFrom;         // Unix time, 0 = always
+    uint32_t validTo;           // Unix time, 0 = never
+    uint32_t startSchedule;     // Unix time (relative: set on first evaluation)
+    uint32_t duration;          // Seconds, 0 = open-ended
+    uint8_t periodCount;
+    charging_period_t periods[CHARGING_PERIODS_MAX];
+} charging_profile_t;
+
+/**
+ * @brief File header, followed by count charging_profile_t
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t magic;             // CHARGING_PROFILE_MAGIC
+    uint16_t count;
+    uint16_t crc;               // CRC-16 over the profiles
+} charging_file_header_t;
+
+/**
+ * @brief Limits of all connectors from one point in time
+ */
+struct ChargingTimelineSlot {
+    uint32_t start;             // Unix time
+    uint16_t limit[CONNECTOR_STATE_SLOTS];
+};
+
+/**
+ * @brief Limit change for one connector (see ChargingProfileEngine::nextChange)
+ */
+struct ChargingLimitChange {
+    uint8_t connectorId;
+    uint16_t limit;             // 0.1 A, CHARGING_NO_LIMIT = none
+    uint32_t validFor;          // Seconds until the next precomputed change (0 = open)
+};
+
+/**
+ * @brief Charging profile engine (owned by DeviceManager)
+ *
+ * Usage (charging task, once per second):
+ *   engine.tick(unixTime, connectorStates);
+ *   ChargingLimitChange change;
+ *   while (engine.nextChange(change)) {
+ *       if (!send(change)) break;
+ *       engine.markSent(change);
+ *   }
+ */
+class ChargingProfileEngine {
+private:
+    charging_profile_t profiles[CHARGING_PROFILE_MAX];
+    uint8_t count;
+    bool dirty;                 // Profiles changed: save and evaluate again
+
+    ChargingTimelineSlot timeline[CHARGING_TIMELINE_SLOTS];
+    uint8_t timelineLength;
+    uint8_t timelinePos;
+    uint32_t horizonEnd;        // Timeline covers up to here, then rebuilt
+    uint16_t activeMask;        // Connectors charging at the last evaluation
+    uint16_t knownMask;         // Connectors reported by the STM32
+    bool stale;                 // Timeline must be rebuilt
+
+    uint16_t sent[CONNECTOR_STATE_SLOTS];   // Last limit queued to the STM32
+    uint32_t evaluations;
+
+    static uint16_t maskOf(const ConnectorStateTable& states, bool activeOnly);
+    bool profileLimit(const charging_profile_t& profile, uint32_t now, uint16_t& limit, uint32_t& boundary) const;
+    uint16_t bestLimit(uint8_t purpose, uint8_t connectorId, uint32_t now, uint32_t& boundary) const;
+    uint32_t evaluateAt(uint32_t now, uint16_t* limits) const;
+    void rebuild(uint32_t now);
+
+public:
+    ChargingProfileEngine();
+
+    /**
+     * @brief Install or replace (same id, or same connector/purpose/stack level)
+     * @return false if the store is full or the profile is invalid
+     */
+    bool install(const charging_profile_t& profile);
+
+    /**
+     * @brief Clear matching profiles (-1 = any)
+     * @return Number of profiles removed
+     */
+    uint8_t clear(int32_t id, int16_t connectorId, int16_t purpose, int16_t stackLevel);
+
+    /**
+     * @brief Advance the timeline; evaluate again only when needed
+     * @param now Unix time (0 = clock not set: nothing changes)
+     */
+    void tick(uint32_t now, const ConnectorStateTable& states);
+
+    /**
+     * @brief Next connector whose current limit differs from what was sent
+     * @return false if all connectors are up to date
+     */
+    bool nextChange(ChargingLimitChange& change) const;
+
+    /**
+     * @brief This limit was queued to the STM32
+     */
+    void markSent(const ChargingLimitChange& change);
+
+    /**
+     * @brief Resend every limit (STM32 restarted)
+     */
+    void resendAll();
+
+    /**
+     * @brief Current limit of a connector (0.1 A, CHARGING_NO_LIMIT = none)
+     */
+    uint16_t currentLimit(uint8_t connectorId) const;
+
+    bool load();
+    bool save();
+
+    /**
+     * @brief Write pending profile changes (call from a periodic task)
+     */
+    void handle();
+
+    uint8_t size() const { return count; }
+    const charging_profile_t* get(uint8_t index) const { return index < count ? &profiles[index] : nullptr; }
+    uint32_t getEvaluations() const { return evaluations; }
+};
+
+#endif // CHARGING_PROFILES_H
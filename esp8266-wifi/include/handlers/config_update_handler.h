@@ -3,7 +3,8 @@
  * @brief Config Update Handler
  * @version 1.0.0
  *
- * Handle configuration updates from STM32 or MQTT
+ * Handle configuration updates from STM32 or MQTT. Updates are partial
+ * JSON patches; the config manager coalesces the flash writes.
  */
 
 #ifndef CONFIG_UPDATE_HANDLER_H
@@ -20,13 +21,13 @@ class ConfigUpdateHandler {
 public:
     /**
      * @brief Handle config update from STM32
-     * @param packet UART packet with JSON config
+     * @param frame UART frame with JSON config
      * @param stm32 STM32 communicator (for ACK)
      * @param configManager Config manager to update
      * @return true if update successful
      */
     static bool handleFromSTM32(
-        const uart_packet_t& packet,
+        const UartFrameView& frame,
         STM32Communicator& stm32,
         UnifiedConfigManager& configManager
     );
@@ -43,8 +44,7 @@ public:
     );
 
 private:
-    static bool validateConfig(const char* jsonConfig);
-    static bool saveConfig(const char* jsonConfig, UnifiedConfigManager& configManager);
+    static bool applyConfig(const char* jsonConfig, size_t length, UnifiedConfigManager& configManager);
 };
 
 #endif // CONFIG_UPDATE_HANDLER_H
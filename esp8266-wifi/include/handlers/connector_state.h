@@ -0,0 +1,109 @@
+/**
+ * @file connector_state.h
+ * @brief Per-connector status cache (change-driven status notifications)
+ * @version 1.0.0
+ *
+ * Holds the last connector_status_t / error_code_t reported by the STM32
+ * for each connector. A status notification is published only when one
+ * of them changed; repeats are ACKed to the STM32 and dropped. The table
+ * also answers local queries (heartbeat, /api/connectors) and is sent as
+ * one status/snapshot message after every MQTT reconnect, so the backend
+ * is back in sync without the STM32 resending anything.
+ */
+
+#ifndef CONNECTOR_STATE_H
+#define CONNECTOR_STATE_H
+
+#include "../../shared/ocpp_messages.h"
+#include <Arduino.h>
+
+// Connector IDs 0..MAX_CONNECTORS (0 = the charge point itself)
+#define CONNECTOR_STATE_SLOTS   11
+
+/**
+ * @brief Cached state of one connector
+ */
+struct ConnectorState {
+    connector_status_t status;
+    error_code_t errorCode;
+    uint32_t changedAt;         // millis() of the last change
+    bool known;                 // Reported at least once since boot
+    bool published;             // Last change reached the MQTT client
+};
+
+/**
+ * @brief Connector state table (owned by DeviceManager)
+ *
+ * Usage:
+ *   if (states.update(id, status, error, millis())) {
+ *       if (!publish(...)) states.markUnpublished(id);
+ *   }
+ */
+class ConnectorStateTable {
+private:
+    ConnectorState slots[CONNECTOR_STATE_SLOTS];
+    uint32_t suppressedCount;
+
+public:
+    ConnectorStateTable();
+
+    /**
+     * @brief Record a reported state
+     * @param now millis()
+     * @return true if it differs from the cached one (or the last change
+     *         was never published): publish it. Out-of-range IDs are
+     *         not cached and always return true.
+     */
+    bool update(uint8_t connectorId, connector_status_t status, error_code_t errorCode, uint32_t now);
+
+    /**
+     * @brief The publish after update() failed: the next report goes out
+     */
+    void markUnpublished(uint8_t connectorId);
+
+    /**
+     * @brief Cached state (nullptr if unknown or out of range)
+     */
+    const ConnectorState* get(uint8_t connectorId) const;
+
+    /**
+     * @brief Highest connector ID with a known state (-1 = none)
+     */
+    int16_t highestKnown() const;
+
+    /**
+     * @brief A connector is preparing, charging, suspended or finishing
+     */
+    bool sessionActive() const;
+
+    /**
+     * @brief Forget all connectors
+     */
+    void reset();
+
+    uint32_t getSuppressedCount() const { return suppressedCount; }
+
+    /**
+     * @brief Known connectors as an array member of an open object
+     * @param key Array name
+     *
+     * Elements are {"id","status","errorCode"}; works with JsonWriter and
+     * MsgPackWriter.
+     */
+    template<typename Writer>
+    void writeArray(Writer& w, const char* key) const {
+        w.beginArray(key);
+        for (uint8_t id = 0; id < CONNECTOR_STATE_SLOTS; id++) {
+            const ConnectorState& state = slots[id];
+            if (!state.known) continue;
+            w.beginObject();
+            w.field("id", id);
+            w.field("status", (int32_t)state.status);
+            w.field("errorCode", (int32_t)state.errorCode);
+            w.endObject();
+        }
+        w.endArray();
+    }
+};
+
+#endif // CONNECTOR_STATE_H
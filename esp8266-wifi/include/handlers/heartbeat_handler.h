@@ -4,6 +4,12 @@
  * @version 1.0.0
  *
  * Business logic: Send heartbeat to MQTT broker
+ *
+ * With system.heartbeatCoalesce a heartbeat is skipped while other
+ * publishes went out within the interval (the broker traffic already
+ * proves liveness). The heartbeat fields are then reported on their own
+ * only every HEARTBEAT_COALESCE_MAX intervals, or ride along on the next
+ * meter batch ("device" object) with system.heartbeatPiggyback.
  */
 
 #ifndef HEARTBEAT_HANDLER_H
@@ -12,29 +18,94 @@
 #include "drivers/mqtt/mqtt_client.h"
 #include "drivers/network/wifi_manager.h"
 #include "drivers/config/unified_config.h"
+#include "utils/loop_profiler.h"
+#include "handlers/connector_state.h"
 #include <Arduino.h>
 
+// Longest time (in intervals) the heartbeat fields go unreported while coalescing
+#define HEARTBEAT_COALESCE_MAX      10
+
+/**
+ * @brief What the heartbeat task does on this pass
+ */
+enum class HeartbeatAction : uint8_t {
+    WAIT = 0,           // Interval not over yet
+    SEND,               // Publish a heartbeat
+    COALESCE            // Other traffic proved liveness, skip this one
+};
+
+/**
+ * @brief Device health fields (heartbeat message or meter batch "device")
+ */
+struct HeartbeatFields {
+    uint32_t uptime;            // Seconds
+    int32_t rssi;
+    uint32_t freeHeap;
+    uint32_t heapFrag;
+    bool hasLoop;               // loopMaxUs/stalls valid
+    uint32_t loopMaxUs;
+    uint32_t stalls;
+};
+
 /**
  * @brief Heartbeat handler (stateless)
  *
  * Usage:
- *   HeartbeatHandler::execute(mqtt, wifi, config, bootTime);
+ *   switch (HeartbeatHandler::decide(config, millis(), lastHeartbeat, lastPublish, lastFields)) {
+ *     case HeartbeatAction::SEND: HeartbeatHandler::execute(mqtt, wifi, config, bootTime); break;
+ *     ...
+ *   }
  */
 class HeartbeatHandler {
 public:
+    /**
+     * @brief Decide whether a heartbeat is due
+     * @param now millis()
+     * @param lastHeartbeat Last heartbeat (or coalesced heartbeat)
+     * @param lastPublish MQTTStatus::lastPublishTime (0 = nothing sent yet)
+     * @param lastFields Last time the heartbeat fields were reported
+     */
+    static HeartbeatAction decide(const DeviceConfig& config, uint32_t now, uint32_t lastHeartbeat,
+                                  uint32_t lastPublish, uint32_t lastFields);
+
+    /**
+     * @brief Read the current health fields
+     */
+    static void collect(HeartbeatFields& fields, CustomWiFiManager& wifi, uint32_t bootTime,
+                        const LoopProfiler* profiler = nullptr);
+
+    /**
+     * @brief Write the health fields into the current object
+     */
+    template<typename Writer>
+    static void writeFields(Writer& w, const HeartbeatFields& fields) {
+        w.field("uptime", fields.uptime);
+        w.field("rssi", fields.rssi);
+        w.field("freeHeap", fields.freeHeap);
+        w.field("heapFrag", fields.heapFrag);
+        if (fields.hasLoop) {
+            w.field("loopMaxUs", fields.loopMaxUs);
+            w.field("stalls", fields.stalls);
+        }
+    }
+
     /**
      * @brief Execute heartbeat
      * @param mqtt MQTT client reference
      * @param wifi WiFi manager reference
      * @param config Device config reference
      * @param bootTime Boot timestamp (for uptime calculation)
+     * @param profiler Loop timing; adds loopMaxUs/stalls when given
+     * @param connectors Connector state cache; adds "connectors" when given
      * @return true if heartbeat sent successfully
      */
     static bool execute(
         MQTTClient& mqtt,
         CustomWiFiManager& wifi,
         const DeviceConfig& config,
-        uint32_t bootTime
+        uint32_t bootTime,
+        const LoopProfiler* profiler = nullptr,
+        const ConnectorStateTable* connectors = nullptr
     );
 };
 
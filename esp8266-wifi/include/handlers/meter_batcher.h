@@ -0,0 +1,105 @@
+/**
+ * @file meter_batcher.h
+ * @brief Meter value batching (one MQTT publish for many samples)
+ * @version 1.0.0
+ *
+ * Opt-in via DeviceConfig::meter.batchEnabled. Samples are held for up
+ * to batchWindowMs or until batchMaxSamples are pending, then published
+ * as a single meter/batch message:
+ *
+ *   {"msgId":..., "timestamp":..., "samples":[
+ *     {"connectorId":1, "transactionId":..., "offsetMs":0, "energy_wh":..., ...}, ...]}
+ *
+ * "timestamp" is the first sample's timestamp, offsetMs is each sample's
+ * arrival time relative to it. With system.heartbeatPiggyback the
+ * heartbeat fields are appended as "device":{...} when they are due.
+ */
+
+#ifndef METER_BATCHER_H
+#define METER_BATCHER_H
+
+#include "drivers/mqtt/mqtt_client.h"
+#include "drivers/config/unified_config.h"
+#include "handlers/heartbeat_handler.h"
+#include "../../shared/ocpp_messages.h"
+#include <Arduino.h>
+
+// One sample per connector per window (MAX_CONNECTORS)
+#define METER_BATCH_MAX_SAMPLES     10
+
+// Worst case ~210 bytes per sample plus envelope and "device" (~110)
+#define METER_BATCH_PAYLOAD_SIZE    2304
+
+/**
+ * @brief Meter value batcher (owned by DeviceManager)
+ *
+ * Usage:
+ *   if (!batcher.add(meter, millis())) { batcher.flush(mqtt, config); batcher.add(...); }
+ *   batcher.handle(mqtt, config); // Call in loop()
+ */
+class MeterBatcher {
+public:
+    struct Stats {
+        uint32_t batchesPublished;
+        uint32_t samplesPublished;
+        uint32_t batchesFailed;
+    };
+
+private:
+    struct Entry {
+        uint32_t offsetMs;
+        uint32_t transactionId;
+        meter_sample_t sample;
+        uint8_t connectorId;
+    };
+
+    Entry entries[METER_BATCH_MAX_SAMPLES];
+    uint8_t count;
+    uint32_t startedAt;
+    char msgId[sizeof(meter_values_t::msg_id)];
+    char timestamp[sizeof(meter_values_t::timestamp)];
+
+    // Serialization buffer (kept off the stack)
+    char payload[METER_BATCH_PAYLOAD_SIZE];
+
+    Stats stats;
+
+public:
+    MeterBatcher();
+
+    /**
+     * @brief Queue a sample
+     * @param now millis() at arrival
+     * @return false if the batch is full (flush first)
+     */
+    bool add(const meter_values_t& meter, uint32_t now);
+
+    /**
+     * @brief True if the batch should be published now
+     */
+    bool isDue(const DeviceConfig& config, uint32_t now) const;
+
+    /**
+     * @brief Publish pending samples as one message (batch is cleared either way)
+     * @param device Heartbeat fields to append (nullptr = none)
+     * @return true if published (or nothing pending)
+     */
+    bool flush(MQTTClient& mqtt, const DeviceConfig& config, const HeartbeatFields* device = nullptr);
+
+    /**
+     * @brief Flush when due, call in loop()
+     * @return true if a batch was published
+     */
+    bool handle(MQTTClient& mqtt, const DeviceConfig& config, const HeartbeatFields* device = nullptr);
+
+    /**
+     * @brief Serialize pending samples
+     * @return Payload length, 0 if empty or it did not fit
+     */
+    size_t serialize(char* buffer, size_t size, const HeartbeatFields* device = nullptr) const;
+
+    size_t pending() const { return count; }
+    const Stats& getStats() const { return stats; }
+};
+
+#endif // METER_BATCHER_H
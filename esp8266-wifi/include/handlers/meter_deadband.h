@@ -0,0 +1,69 @@
+/**
+ * @file meter_deadband.h
+ * @brief Per-connector deadband filter for meter values
+ * @version 1.0.0
+ *
+ * Opt-in via DeviceConfig::meter.deadbandEnabled. A sample is reported
+ * when any field moved by at least its configured deadband since the last
+ * reported sample, the transaction changed, or keyframeIntervalMs elapsed
+ * (full keyframe). Everything else is suppressed on the ESP side.
+ */
+
+#ifndef METER_DEADBAND_H
+#define METER_DEADBAND_H
+
+#include "drivers/config/unified_config.h"
+#include "../../shared/ocpp_messages.h"
+#include <Arduino.h>
+
+// Connector IDs 0..MAX_CONNECTORS
+#define METER_DEADBAND_SLOTS    11
+
+/**
+ * @brief Deadband filter (owned by DeviceManager)
+ *
+ * Usage:
+ *   if (deadband.shouldReport(meter, config, millis())) {
+ *       if (!publish(meter)) deadband.invalidate(meter.connector_id);
+ *   }
+ */
+class MeterDeadband {
+private:
+    struct LastSent {
+        meter_sample_t sample;
+        uint32_t transactionId;
+        uint32_t sentAt;
+        bool valid;
+    };
+
+    LastSent last[METER_DEADBAND_SLOTS];
+    uint32_t suppressedCount;
+
+    bool exceeds(const LastSent& prev, const meter_values_t& meter,
+                 const DeviceConfig& config) const;
+
+public:
+    MeterDeadband();
+
+    /**
+     * @brief Decide whether to report a sample (records it as sent if so)
+     * @param now millis()
+     * @return true if the sample should be published
+     */
+    bool shouldReport(const meter_values_t& meter, const DeviceConfig& config, uint32_t now);
+
+    /**
+     * @brief Forget last-sent state (next sample is a keyframe)
+     * Call when a reported sample failed to publish.
+     */
+    void invalidate(uint8_t connectorId);
+
+    /**
+     * @brief Forget all connectors
+     */
+    void reset();
+
+    uint32_t getSuppressedCount() const { return suppressedCount; }
+};
+
+#endif // METER_DEADBAND_H
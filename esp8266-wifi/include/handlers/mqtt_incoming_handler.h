@@ -11,15 +11,24 @@
 
 #include "drivers/communication/stm32_comm.h"
 #include "drivers/config/unified_config.h"
+#include "handlers/auth_cache.h"
+#include "handlers/charging_profiles.h"
 #include <Arduino.h>
 
 /**
  * @brief MQTT Incoming handler (stateless)
  *
  * Routes incoming MQTT commands to STM32:
- * - remote_start → CMD to STM32
- * - remote_stop → CMD to STM32
+ * - remote_start → RSP_REMOTE_COMMAND (packed remote_start_cmd_t)
+ * - remote_stop → RSP_REMOTE_COMMAND (packed remote_stop_cmd_t)
  * - reset → CMD to STM32
+ * - send_local_list → local authorization list (kept on the ESP8266)
+ * - set_charging_profile / clear_charging_profile → charging profile
+ *   engine (the STM32 only gets the resulting limits)
+ * - anything else under cmd/ → forwarded unchanged (RSP_MQTT_RECEIVED)
+ *
+ * Payload is used in place (PubSubClient buffer) and gathered into the
+ * UART frame together with the topic, without an intermediate copy.
  */
 class MQTTIncomingHandler {
 public:
@@ -30,18 +39,91 @@ public:
      * @param length Payload length
      * @param stm32 STM32 communicator reference (to forward message)
      * @param config Device config reference
+     * @param authCache Local authorization list (nullptr = forward the
+     *        list commands to the STM32)
+     * @param charging Charging profile engine (nullptr = forward the
+     *        profile commands to the STM32)
      */
     static void execute(
         const char* topic,
         const char* payload,
         uint16_t length,
         STM32Communicator& stm32,
-        const DeviceConfig& config
+        const DeviceConfig& config,
+        AuthCache* authCache = nullptr,
+        ChargingProfileEngine* charging = nullptr
     );
 
+    /**
+     * @brief What a route action may use
+     */
+    struct CommandContext {
+        STM32Communicator& stm32;
+        AuthCache* authCache;
+        ChargingProfileEngine* charging;
+    };
+
+    typedef void (*CommandAction)(const char* topic, size_t topicLen, const char* payload,
+                                  uint16_t length, CommandContext& context);
+
+    /**
+     * @brief cmd/<name> route (table lives in flash, no per-message setup)
+     */
+    struct CommandRoute {
+        const char* name;
+        uint8_t nameLength;
+        CommandAction action;
+    };
+
 private:
-    static bool isCommandTopic(const char* topic, const DeviceConfig& config);
-    static void forwardToSTM32(const char* topic, const char* payload, uint16_t length, STM32Communicator& stm32);
+    static const CommandRoute routes[];
+
+    /**
+     * @brief Get <name> of an "{prefix}cmd/<name>" topic
+     * @return Pointer into topic, or nullptr if not a command for this device
+     */
+    static const char* commandName(const char* topic, const DeviceConfig& config);
+    static const CommandRoute* findRoute(const char* name, size_t length);
+    static void forwardToSTM32(const char* topic, size_t topicLen, const char* payload,
+                               uint16_t length, STM32Communicator& stm32);
+    static void forwardRaw(const char* topic, size_t topicLen, const char* payload,
+                           uint16_t length, CommandContext& context);
+
+    /**
+     * @brief Decode JSON command into its ocpp_messages.h struct
+     *
+     * Falls back to forwardToSTM32() if the JSON cannot be decoded.
+     */
+    static void forwardRemoteStart(const char* topic, size_t topicLen, const char* payload,
+                                   uint16_t length, CommandContext& context);
+    static void forwardRemoteStop(const char* topic, size_t topicLen, const char* payload,
+                                  uint16_t length, CommandContext& context);
+
+    /**
+     * @brief Apply an OCPP SendLocalList ("Full" or "Differential")
+     *
+     * {"listVersion":N, "updateType":"Full",
+     *  "localAuthorizationList":[{"idTag":"...","idTagInfo":{"status":"Accepted","expiryDate":unix}}]}
+     * Differential entries without idTagInfo are removed.
+     */
+    static void updateLocalList(const char* topic, size_t topicLen, const char* payload,
+                                uint16_t length, CommandContext& context);
+
+    /**
+     * @brief OCPP SetChargingProfile / ClearChargingProfile
+     *
+     * {"connectorId":1, "csChargingProfiles":{"chargingProfileId":7, "stackLevel":0,
+     *  "chargingProfilePurpose":"TxDefaultProfile", "chargingProfileKind":"Absolute",
+     *  "validFrom":unix, "validTo":unix, "chargingSchedule":{"startSchedule":unix,
+     *  "duration":s, "chargingRateUnit":"A", "chargingSchedulePeriod":[{"startPeriod":0,"limit":16.0}]}}}
+     * Clear takes any of "id", "connectorId", "chargingProfilePurpose", "stackLevel".
+     */
+    static void setChargingProfile(const char* topic, size_t topicLen, const char* payload,
+                                   uint16_t length, CommandContext& context);
+    static void clearChargingProfile(const char* topic, size_t topicLen, const char* payload,
+                                     uint16_t length, CommandContext& context);
+    static void sendRemoteCommand(uint8_t commandId, const void* command, uint16_t size,
+                                  STM32Communicator& stm32);
 };
 
 #endif // MQTT_INCOMING_HANDLER_H
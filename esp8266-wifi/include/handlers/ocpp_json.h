@@ -0,0 +1,108 @@
+/**
+ * @file ocpp_json.h
+ * @brief OCPP message serializers (streaming, no JsonDocument)
+ * @version 1.1.0
+ *
+ * One field list per message, encoded by any writer with the JsonWriter
+ * interface (JsonWriter, MsgPackWriter). JSON field names and order match
+ * the former ArduinoJson output so the backend sees byte-identical payloads.
+ */
+
+#ifndef OCPP_JSON_H
+#define OCPP_JSON_H
+
+#include "utils/json_writer.h"
+#include "utils/msgpack_writer.h"
+#include "../../shared/ocpp_messages.h"
+
+/**
+ * @brief Serialize OCPP messages into a caller buffer
+ *
+ * Usage:
+ *   size_t len = OcppJson::write<JsonWriter>(buf, sizeof(buf), meter);
+ *   size_t len = OcppJson::write<MsgPackWriter>(buf, sizeof(buf), meter);
+ */
+namespace OcppJson {
+
+template<typename Writer>
+inline void encode(Writer& w, const status_notification_t& status) {
+    w.beginObject();
+    w.field("msgId", status.msg_id);
+    w.field("timestamp", status.timestamp);
+    w.field("connectorId", status.connector_id);
+    w.field("status", (int32_t)status.status);
+    w.field("errorCode", (int32_t)status.error_code);
+    w.field("info", status.info);
+    w.field("vendorId", status.vendor_id);
+    w.endObject();
+}
+
+template<typename Writer>
+inline void encode(Writer& w, const meter_values_t& meter) {
+    w.beginObject();
+    w.field("msgId", meter.msg_id);
+    w.field("timestamp", meter.timestamp);
+    w.field("connectorId", meter.connector_id);
+    w.field("transactionId", meter.transaction_id);
+    w.beginObject("sample");
+    w.field("energy_wh", meter.sample.energy_wh);
+    w.field("power_w", meter.sample.power_w);
+    w.field("voltage_v", meter.sample.voltage_v);
+    w.field("current_a", meter.sample.current_a);
+    w.field("frequency_hz", meter.sample.frequency_hz);
+    w.field("temperature_c", meter.sample.temperature_c);
+    w.field("power_factor_pct", meter.sample.power_factor_pct);
+    w.endObject();
+    w.endObject();
+}
+
+template<typename Writer>
+inline void encode(Writer& w, const start_transaction_t& txStart) {
+    w.beginObject();
+    w.field("msgId", txStart.msg_id);
+    w.field("timestamp", txStart.timestamp);
+    w.field("connectorId", txStart.connector_id);
+    w.field("idTag", txStart.id_tag);
+    w.field("meterStart", txStart.meter_start);
+    w.field("reservationId", txStart.reservation_id);
+    w.endObject();
+}
+
+template<typename Writer>
+inline void encode(Writer& w, const stop_transaction_t& txStop) {
+    w.beginObject();
+    w.field("msgId", txStop.msg_id);
+    w.field("timestamp", txStop.timestamp);
+    w.field("transactionId", txStop.transaction_id);
+    w.field("idTag", txStop.id_tag);
+    w.field("meterStop", txStop.meter_stop);
+    w.field("reason", txStop.reason);
+    w.endObject();
+}
+
+template<typename Writer>
+inline void encode(Writer& w, const boot_notification_t& boot) {
+    w.beginObject();
+    w.field("msgId", boot.msg_id);
+    w.field("timestamp", boot.timestamp);
+    w.field("chargePointModel", boot.charge_point_model);
+    w.field("chargePointVendor", boot.charge_point_vendor);
+    w.field("firmwareVersion", boot.firmware_version);
+    w.field("chargePointSerialNumber", boot.charge_point_serial_number);
+    w.endObject();
+}
+
+/**
+ * @brief Encode a message with the given writer
+ * @return Payload length, or 0 if it did not fit
+ */
+template<typename Writer, typename Message>
+inline size_t write(char* buffer, size_t size, const Message& msg) {
+    Writer w(buffer, size);
+    encode(w, msg);
+    return w.length();
+}
+
+} // namespace OcppJson
+
+#endif // OCPP_JSON_H
@@ -11,6 +11,7 @@
 
 #include "drivers/mqtt/mqtt_client.h"
 #include "drivers/config/unified_config.h"
+#include "handlers/connector_state.h"
 #include "../../shared/ocpp_messages.h"
 #include <Arduino.h>
 
@@ -18,7 +19,7 @@
  * @brief OCPP Message handler (stateless)
  *
  * Handles:
- * - Status Notification
+ * - Status Notification (and the connector snapshot after reconnect)
  * - Meter Values
  * - Start/Stop Transaction
  * - Boot Notification
@@ -34,6 +35,19 @@ public:
         const status_notification_t& status
     );
 
+    /**
+     * @brief Publish all known connector states in one message
+     * @param timestamp Unix time (0 = not synced)
+     *
+     * {"msgId":..., "timestamp":..., "connectors":[{"id","status","errorCode"},...]}
+     */
+    static bool publishStatusSnapshot(
+        MQTTClient& mqtt,
+        const DeviceConfig& config,
+        const ConnectorStateTable& states,
+        uint32_t timestamp
+    );
+
     /**
      * @brief Publish Meter Values
      */
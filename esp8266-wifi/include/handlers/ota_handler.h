@@ -1,9 +1,27 @@
 /**
  * @file ota_handler.h
  * @brief OTA Update Handler
- * @version 2.0.0
+ * @version 3.1.0
  *
- * Handle OTA firmware updates via HTTP
+ * Handle OTA firmware updates via HTTP, driven from the main loop:
+ * 1. CMD_OTA_REQUEST carries a manifest URL; the manifest gives image
+ *    URL, size, SHA-256 and a signature over those fields, checked
+ *    before any download (no signing key built in: refused)
+ * 2. The image is downloaded in chunks by handle() (scheduler task),
+ *    hashed and written to flash as it arrives; UART keeps being serviced
+ * 3. A dropped connection resumes with HTTP Range after a jittered delay
+ * 4. The image SHA-256 is verified before the last bytes are written
+ *    and Update.end() marks the image bootable
+ * Progress goes to the STM32 as RSP_OTA_STATUS (ota_status_payload_t).
+ *
+ * If the manifest offers a delta patch against the running image (same
+ * ESP.getSketchMD5()), the patch is downloaded instead and the new image
+ * is rebuilt on the fly from the running one (utils/delta_patch.h). Any
+ * delta failure falls back to the full image.
+ *
+ * A manifest with "target":"stm32" is an STM32 image: it is verified the
+ * same way but staged in LittleFS (resumed if a partial copy is there)
+ * and handed to STM32OTASender for the UART bulk transfer.
  */
 
 #ifndef OTA_HANDLER_H
@@ -12,53 +30,63 @@
 #include "drivers/communication/stm32_comm.h"
 #include <Arduino.h>
 
+#define OTA_URL_MAX             256
+#define OTA_MANIFEST_MAX        1536    // Image + delta entries, RSA-4096 signature
+#define OTA_SIGNATURE_MAX       512     // RSA-4096
+#define OTA_CHUNK_SIZE          512     // Bytes per read
+#define OTA_PASS_BUDGET         4096    // Bytes per handle() call
+#define OTA_HOLDBACK_BYTES      32      // Written only after verification
+#define OTA_IO_TIMEOUT_MS       10000   // No data for this long: reconnect
+#define OTA_MAX_STALLS          5       // Reconnects in a row without progress
+#define OTA_PROGRESS_STEP_PCT   10
+#define OTA_RESTART_DELAY_MS    1000    // Let the final status reach the STM32
+
 /**
- * @brief OTA Update Result
+ * @brief OTA Update Result (values are the OTA_STATUS_* codes)
  */
-enum class OTAResult {
-    SUCCESS = 0,
-    FAILED_HTTP,
-    FAILED_NO_SPACE,
-    FAILED_FLASH,
-    FAILED_VERIFY,
-    FAILED_INVALID_URL
+enum class OTAResult : uint8_t {
+    SUCCESS = OTA_STATUS_SUCCESS,
+    FAILED_HTTP = OTA_STATUS_FAILED_HTTP,
+    FAILED_NO_SPACE = OTA_STATUS_FAILED_NO_SPACE,
+    FAILED_FLASH = OTA_STATUS_FAILED_FLASH,
+    FAILED_VERIFY = OTA_STATUS_FAILED_VERIFY,
+    FAILED_INVALID_URL = OTA_STATUS_FAILED_URL,
+    FAILED_MANIFEST = OTA_STATUS_FAILED_MANIFEST,
+    BUSY = OTA_STATUS_BUSY,
+    UP_TO_DATE = OTA_STATUS_UP_TO_DATE,
+    STAGED = OTA_STATUS_STAGED
 };
 
+struct OTASession;
+
 /**
- * @brief OTA handler (stateless)
+ * @brief OTA handler (one update at a time, session on the heap while active)
  */
 class OTAHandler {
 public:
     /**
-     * @brief Check if OTA update is available
-     * @param url Firmware version check URL
-     * @param currentVersion Current version
-     * @param newVersion Output: New version if available
-     * @return true if update available
+     * @brief Handle OTA request from STM32 (starts the job, never blocks)
+     * @param frame UART frame with the manifest URL
+     * @param stm32 STM32 communicator (for status responses)
      */
-    static bool checkUpdate(
-        const char* url,
-        const char* currentVersion,
-        char* newVersion,
-        size_t newVersionSize
+    static void handleFromSTM32(
+        const UartFrameView& frame,
+        STM32Communicator& stm32
     );
 
     /**
-     * @brief Perform OTA update from HTTP
-     * @param url Firmware binary URL
-     * @return OTAResult code
+     * @brief Start an update from a manifest URL
+     * @param sequence Request sequence used for RSP_OTA_STATUS
+     * @return false (status already sent) if busy or the URL is invalid
      */
-    static OTAResult performUpdate(const char* url);
+    static bool begin(const char* manifestUrl, uint8_t sequence, STM32Communicator& stm32);
 
     /**
-     * @brief Handle OTA request from STM32
-     * @param packet UART packet with OTA URL
-     * @param stm32 STM32 communicator (for status response)
+     * @brief Advance the active update (call from the main loop)
      */
-    static void handleFromSTM32(
-        const uart_packet_t& packet,
-        STM32Communicator& stm32
-    );
+    static void handle(STM32Communicator& stm32);
+
+    static bool isActive();
 
     /**
      * @brief Get current firmware version
@@ -66,8 +94,27 @@ public:
     static const char* getCurrentVersion();
 
 private:
-    static bool verifyUpdate();
-    static void sendOTAStatus(STM32Communicator& stm32, uint8_t sequence, OTAResult result);
+    static void openConnection(OTASession& s);
+    static bool readHeaders(OTASession& s);
+    static void readBody(OTASession& s, STM32Communicator& stm32);
+    static bool consumeImage(OTASession& s, const uint8_t* data, size_t length);
+    static bool consumeDelta(OTASession& s, uint32_t& budget);
+    static bool writeImage(OTASession& s, const uint8_t* data, size_t length);
+    static bool readRunningImage(uint32_t offset, uint8_t* data, size_t length, void* context);
+    static bool writeDeltaOutput(const uint8_t* data, size_t length, void* context);
+    static void fallbackToFull(OTASession& s, STM32Communicator& stm32, const char* reason);
+    static void connectionLost(OTASession& s, const char* reason);
+    static bool loadManifest(OTASession& s, STM32Communicator& stm32);
+    static bool startFirmware(OTASession& s, STM32Communicator& stm32);
+    static void finishFirmware(OTASession& s, STM32Communicator& stm32);
+    static bool startStaging(OTASession& s, STM32Communicator& stm32);
+    static void finishStaging(OTASession& s, STM32Communicator& stm32);
+    static bool verifyUpdate(OTASession& s);
+    static bool verifyManifest(OTASession& s, const char* target, const char* version,
+                               uint32_t size, const char* deltaBase);
+    static void fail(OTASession& s, STM32Communicator& stm32, OTAResult result, const char* message);
+    static void sendOTAStatus(STM32Communicator& stm32, uint8_t sequence, uint8_t status,
+                              const OTASession* s, const char* message);
 };
 
 #endif // OTA_HANDLER_H
@@ -0,0 +1,103 @@
+/**
+ * @file power_policy.h
+ * @brief Traffic-aware WiFi modem sleep policy
+ * @version 1.0.0
+ *
+ * The radio always runs in modem sleep (CustomWiFiManager::init()) and
+ * wakes for every DTIM beacon. With wifi.powerSave an idle charger sleeps
+ * deeper: it only listens every wifi.listenInterval beacons, so the AP
+ * holds downlink frames a few hundred ms longer. Uplink is unaffected
+ * (a transmit wakes the radio at once).
+ *
+ * IDLE needs all of:
+ * - station joined, no connector in a session, meter batching on
+ *   (samples leave in bursts, not one publish per frame)
+ * - no OTA download and no live web UI client
+ * - no STM32 frame within POWER_UART_HOLD_MS
+ * - not within POWER_KEEPALIVE_LEAD_MS before / POWER_KEEPALIVE_HOLD_MS
+ *   after an expected MQTT keepalive (the PINGRESP is not held back)
+ *
+ * decide() is evaluated on every loop pass, so a UART frame switches back
+ * to ACTIVE in the same pass it arrives.
+ */
+
+#ifndef POWER_POLICY_H
+#define POWER_POLICY_H
+
+#include <Arduino.h>
+
+#define POWER_UART_HOLD_MS          3000    // Stay ACTIVE this long after an STM32 frame
+#define POWER_KEEPALIVE_LEAD_MS     1000    // Wake before an MQTT keepalive is due
+#define POWER_KEEPALIVE_HOLD_MS     2000    // ... and stay awake for the PINGRESP
+
+/**
+ * @brief Radio power mode
+ */
+enum class RadioPowerMode : uint8_t {
+    ACTIVE = 0,         // Modem sleep, wake every DTIM beacon
+    IDLE                // Modem sleep, wake every wifi.listenInterval beacons
+};
+
+/**
+ * @brief Inputs for one decision (gathered by DeviceManager)
+ */
+struct PowerInputs {
+    bool enabled;               // config.wifi.powerSave
+    bool connected;             // Station joined (not AP mode)
+    bool sessionActive;         // ConnectorStateTable::sessionActive()
+    bool batching;              // config.meter.batchEnabled
+    bool busy;                  // OTA download or live web UI client
+    uint32_t lastUartRx;        // millis() of the last STM32 bytes
+    uint32_t keepAliveBase;     // millis() the MQTT keepalive counts from (0 = no session)
+    uint32_t keepAliveMs;       // config.mqtt.keepAlive in ms (0 = off)
+};
+
+/**
+ * @brief Modem sleep policy (owned by DeviceManager)
+ *
+ * Usage (every loop pass):
+ *   RadioPowerMode mode = PowerPolicy::decide(inputs, millis());
+ *   if (policy.update(mode, millis())) {
+ *       wifi.setListenInterval(mode == RadioPowerMode::IDLE ? interval : 0);
+ *   }
+ */
+class PowerPolicy {
+private:
+    RadioPowerMode mode;
+    uint32_t modeSince;         // millis() of the last change
+    uint32_t idleMs;            // Completed IDLE stretches
+    uint32_t activeMs;          // Completed ACTIVE stretches
+    uint32_t wakeups;           // IDLE -> ACTIVE
+
+    static bool nearKeepAlive(const PowerInputs& inputs, uint32_t now);
+
+public:
+    PowerPolicy();
+
+    /**
+     * @brief Mode the radio should be in now
+     * @param now millis()
+     */
+    static RadioPowerMode decide(const PowerInputs& inputs, uint32_t now);
+
+    /**
+     * @brief Record the decided mode
+     * @return true if it changed (apply it to the radio)
+     */
+    bool update(RadioPowerMode target, uint32_t now);
+
+    RadioPowerMode getMode() const { return mode; }
+    uint32_t getWakeups() const { return wakeups; }
+
+    /**
+     * @brief Time spent in a mode since boot, current stretch included
+     */
+    uint32_t getTimeIn(RadioPowerMode which, uint32_t now) const;
+
+    /**
+     * @brief Mode name for logs and JSON ("active", "idle")
+     */
+    static const char* modeName(RadioPowerMode which);
+};
+
+#endif // POWER_POLICY_H
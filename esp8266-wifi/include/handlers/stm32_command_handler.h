@@ -13,42 +13,77 @@
 #include "drivers/mqtt/mqtt_client.h"
 #include "drivers/config/unified_config.h"
 #include "drivers/time/ntp_time.h"
+#include "handlers/meter_batcher.h"
+#include "handlers/meter_deadband.h"
+#include "handlers/connector_state.h"
+#include "handlers/auth_cache.h"
+#include "drivers/network/live_telemetry.h"
 #include "../../shared/uart_protocol.h"
 
 /**
  * @brief STM32 Command handler (stateless)
  *
  * Routes incoming STM32 commands to appropriate actions:
- * - CMD_MQTT_PUBLISH -> Publish to MQTT
+ * - CMD_MQTT_PUBLISH -> Publish to MQTT (JSON or binary mqtt_publish_payload_t)
+ * - CMD_MQTT_PUBLISH_ID -> Publish to MQTT, topic expanded from topic ID
  * - CMD_GET_TIME -> Send time response
  * - CMD_WIFI_STATUS -> Send WiFi status
+ * - CMD_PUBLISH_METER_VALUES -> Publish (or batch) meter values, deadband filtered
+ * - CMD_CONNECTOR_STATUS -> Publish status notification if the state changed
+ * - CMD_AUTH_QUERY -> RSP_AUTH_RESULT from the local list / cache
+ * - CMD_AUTH_UPDATE -> Cache the backend answer for an id tag
+ *
+ * Status reports (CMD_CONNECTOR_STATUS and JSON TOPIC_ID_STATUS) update
+ * the connector state cache; unchanged ones are ACKed, not published.
+ *
+ * Meter samples (all, before the deadband) and JSON status notifications
+ * are also pushed to the local web UI when a LiveTelemetry is given.
  */
 class STM32CommandHandler {
 public:
     /**
      * @brief Execute command handler
-     * @param packet Received UART packet from STM32
+     * @param frame Received UART frame from STM32 (zero-copy view)
      * @param stm32 STM32 communicator reference (for ACK)
      * @param mqtt MQTT client reference
      * @param ntpTime NTP time driver reference
      * @param configManager Config manager reference
+     * @param meterBatcher Meter batcher (used when meter.batchEnabled)
+     * @param meterDeadband Meter deadband filter (used when meter.deadbandEnabled)
+     * @param connectorStates Connector state cache (status deduplication)
+     * @param authCache Local authorization list and cache
+     * @param live Local web UI feed (nullptr = none)
      */
     static void execute(
-        const uart_packet_t& packet,
+        const UartFrameView& frame,
         STM32Communicator& stm32,
         MQTTClient& mqtt,
         NTPTimeDriver& ntpTime,
-        UnifiedConfigManager& configManager
+        UnifiedConfigManager& configManager,
+        MeterBatcher& meterBatcher,
+        MeterDeadband& meterDeadband,
+        ConnectorStateTable& connectorStates,
+        AuthCache& authCache,
+        LiveTelemetry* live = nullptr
     );
 
 private:
     // Internal handlers
-    static void handleMqttPublish(const uart_packet_t& packet, STM32Communicator& stm32, MQTTClient& mqtt);
-    static void handleGetTime(const uart_packet_t& packet, STM32Communicator& stm32, NTPTimeDriver& ntpTime);
-    static void handleWiFiStatus(const uart_packet_t& packet, STM32Communicator& stm32, MQTTClient& mqtt);
-    static void handleConfigUpdate(const uart_packet_t& packet, STM32Communicator& stm32, UnifiedConfigManager& configManager);
-    static void handleOTARequest(const uart_packet_t& packet, STM32Communicator& stm32);
-    static void handlePublishMeterValues(const uart_packet_t& packet, STM32Communicator& stm32, MQTTClient& mqtt, const DeviceConfig& config);
+    static bool ackDuplicatePublish(const UartFrameView& frame, STM32Communicator& stm32, MQTTClient& mqtt);
+    static void ackPublishResult(const UartFrameView& frame, STM32Communicator& stm32, MQTTError result, const char* topic);
+    static bool isJsonPublish(const UartFrameView& frame);
+    static void handleMqttPublish(const UartFrameView& frame, STM32Communicator& stm32, MQTTClient& mqtt);
+    static void handleMqttPublishBinary(const UartFrameView& frame, STM32Communicator& stm32, MQTTClient& mqtt);
+    static void handleMqttPublishId(const UartFrameView& frame, STM32Communicator& stm32, MQTTClient& mqtt, const DeviceConfig& config, ConnectorStateTable& connectorStates, LiveTelemetry* live);
+    static void handleConnectorStatus(const UartFrameView& frame, STM32Communicator& stm32, MQTTClient& mqtt, NTPTimeDriver& ntpTime, const DeviceConfig& config, ConnectorStateTable& connectorStates, LiveTelemetry* live);
+    static void handleAuthQuery(const UartFrameView& frame, STM32Communicator& stm32, NTPTimeDriver& ntpTime, AuthCache& authCache);
+    static void handleAuthUpdate(const UartFrameView& frame, STM32Communicator& stm32, AuthCache& authCache);
+    static void handleGetTime(const UartFrameView& frame, STM32Communicator& stm32, NTPTimeDriver& ntpTime);
+    static void handleWiFiStatus(const UartFrameView& frame, STM32Communicator& stm32, MQTTClient& mqtt);
+    static void handleConfigUpdate(const UartFrameView& frame, STM32Communicator& stm32, UnifiedConfigManager& configManager);
+    static void handleOTARequest(const UartFrameView& frame, STM32Communicator& stm32);
+    static void handlePublishMeterValues(const UartFrameView& frame, STM32Communicator& stm32, MQTTClient& mqtt, const DeviceConfig& config, MeterBatcher& meterBatcher, MeterDeadband& meterDeadband, LiveTelemetry* live);
+    static void publishLiveMeter(LiveTelemetry& live, const meter_values_t& meter);
 };
 
 #endif // STM32_COMMAND_HANDLER_H
@@ -0,0 +1,62 @@
+/**
+ * @file stm32_ota_sender.h
+ * @brief STM32 firmware pass-through (UART bulk transfer)
+ * @version 1.0.0
+ *
+ * OTAHandler downloads and verifies an image whose manifest says
+ * "target":"stm32" into STM32_OTA_STAGE_PATH; this sender then pushes it
+ * to the STM32 in the bulk transfer mode of uart_protocol.h:
+ *   RSP_BULK_BEGIN -> CMD_BULK_ACK (resume offset)
+ *   RSP_BULK_DATA x n, RSP_BULK_BLOCK (CRC-32) -> CMD_BULK_ACK, windowed
+ *   RSP_BULK_END -> CMD_BULK_ACK (COMPLETE = verified, STM32 installs it)
+ * Data frames are untracked and paced by TX ring space, so the link runs
+ * at line rate instead of one ACK round-trip per frame.
+ */
+
+#ifndef STM32_OTA_SENDER_H
+#define STM32_OTA_SENDER_H
+
+#include "drivers/communication/stm32_comm.h"
+#include <Arduino.h>
+
+#define STM32_OTA_STAGE_PATH    "/stm32_fw.bin"
+#define STM32_OTA_FRAMES_PER_PASS   4   // Data frames queued per handle()
+
+struct STM32OTASession;
+
+/**
+ * @brief Sends one staged image at a time (session on the heap while active)
+ */
+class STM32OTASender {
+public:
+    /**
+     * @brief Start pushing the staged image
+     * @param size Image size (the staged file must hold exactly this)
+     * @param sha256 Image hash, passed on for the STM32's final check
+     * @return false if a transfer is running, the link is not v2 or the
+     *         staged file is missing
+     */
+    static bool begin(uint32_t size, const uint8_t sha256[32], const char* version,
+                      STM32Communicator& stm32);
+
+    /**
+     * @brief Queue frames and handle timeouts (call from the main loop)
+     */
+    static void handle(STM32Communicator& stm32);
+
+    /**
+     * @brief CMD_BULK_ACK from the STM32
+     */
+    static void handleAck(const UartFrameView& frame, STM32Communicator& stm32);
+
+    static bool isActive();
+
+private:
+    static void sendBegin(STM32OTASession& s, STM32Communicator& stm32);
+    static bool queueData(STM32OTASession& s, STM32Communicator& stm32);
+    static bool queueBlockEnd(STM32OTASession& s, STM32Communicator& stm32);
+    static void rewind(STM32OTASession& s, uint32_t offset);
+    static void finish(bool success, const char* message);
+};
+
+#endif // STM32_OTA_SENDER_H
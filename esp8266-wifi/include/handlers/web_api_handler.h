@@ -13,6 +13,54 @@
 #include "drivers/network/wifi_manager.h"
 #include "drivers/mqtt/mqtt_client.h"
 #include "utils/logger.h"
+#include "utils/loop_profiler.h"
+#include "handlers/connector_state.h"
+#include "handlers/power_policy.h"
+
+#define WIFI_SCAN_MAX_RESULTS       20
+#define WIFI_SCAN_CACHE_MS          30000   // Results served without rescanning
+#define WIFI_CONNECT_TIMEOUT_MS     15000
+
+/**
+ * @brief One cached scan result
+ */
+struct WiFiScanEntry {
+    char ssid[33];
+    uint8_t bssid[6];
+    int8_t rssi;
+    uint8_t encryption;
+    uint8_t channel;
+};
+
+/**
+ * @brief Scan results, strongest first
+ */
+struct WiFiScanCache {
+    WiFiScanEntry entries[WIFI_SCAN_MAX_RESULTS];
+    uint8_t count;
+    bool valid;                 // At least one scan completed
+    bool requested;             // Start on the next handle()
+    bool running;
+    uint32_t completedAt;
+};
+
+/**
+ * @brief Connect job progress (reported by GET /api/wifi/status)
+ */
+enum class WiFiJobState : uint8_t {
+    IDLE = 0,
+    PENDING,                    // Accepted, WiFi.begin() on the next handle()
+    CONNECTING,
+    CONNECTED,
+    FAILED
+};
+
+struct WiFiConnectJob {
+    WiFiJobState state;
+    char ssid[33];
+    char password[65];
+    uint32_t startTime;
+};
 
 /**
  * @brief Provisioning state
@@ -30,31 +78,68 @@ struct ProvisioningState {
  * @brief Web API Handler (stateless)
  *
  * Handles all web API requests for WiFi and provisioning
+ *
+ * Request callbacks run in the async TCP context and must not block:
+ * scans and connects only set a job here, handle() (main loop) drives
+ * them and the UI polls for the result.
  */
 class WebAPIHandler {
 private:
     CustomWiFiManager* wifiManager;
     MQTTClient* mqttClient;
     UnifiedConfigManager* configManager;
+    LoopProfiler* profiler;
+    const ConnectorStateTable* connectorStates;
+    const PowerPolicy* powerPolicy;
     ProvisioningState provisionState;
+    WiFiScanCache scanCache;
+    WiFiConnectJob connectJob;
     char deviceId[32];
 
     // Helper methods
     void sendJsonResponse(AsyncWebServerRequest* request, int code, JsonDocument& doc);
+    void sendJsonBuffer(AsyncWebServerRequest* request, int code, const char* json, size_t len);
+    static void formatIP(const IPAddress& ip, char* out, size_t size);
     void sendErrorResponse(AsyncWebServerRequest* request, int code, const char* message);
     void saveProvisioningConfig();
+    void handleScan();
+    void handleConnectJob();
+    void storeScanResults(int count);
+    static const char* jobStateName(WiFiJobState state);
 
 public:
     WebAPIHandler(CustomWiFiManager* wifi, MQTTClient* mqtt, UnifiedConfigManager* config, const char* devId);
 
+    /**
+     * @brief Enable GET /api/diag/perf (before registerRoutes())
+     */
+    void setProfiler(LoopProfiler* perf) { profiler = perf; }
+
+    /**
+     * @brief Enable GET /api/connectors (before registerRoutes())
+     */
+    void setConnectorStates(const ConnectorStateTable* states) { connectorStates = states; }
+
+    /**
+     * @brief Add radio power residency to /api/diag/perf
+     */
+    void setPowerPolicy(const PowerPolicy* policy) { powerPolicy = policy; }
+
     /**
      * @brief Register all API routes
      */
     void registerRoutes(AsyncWebServer& server);
 
+    /**
+     * @brief Drive the WiFi scan and connect jobs (call from the main loop)
+     */
+    void handle();
+
     /**
      * @brief Handle WiFi scan request
-     * GET /api/wifi/scan
+     * GET /api/wifi/scan[?refresh=1]
+     * 200 {"status":"done",...} with the cached list, or 202
+     * {"status":"scanning",...} (with the previous list) while a scan runs
      */
     void handleWiFiScan(AsyncWebServerRequest* request);
 
@@ -62,6 +147,7 @@ public:
      * @brief Handle WiFi connect request
      * POST /api/wifi/connect
      * Body: {"ssid": "...", "password": "..."}
+     * 202 once accepted, progress in GET /api/wifi/status ("connect")
      */
     void handleWiFiConnect(AsyncWebServerRequest* request, uint8_t* data, size_t len);
 
@@ -83,6 +169,24 @@ public:
      */
     void handleProvisionStatus(AsyncWebServerRequest* request);
 
+    /**
+     * @brief Handle loop timing request
+     * GET /api/diag/perf[?reset=1]
+     */
+    void handleDiagPerf(AsyncWebServerRequest* request);
+
+    /**
+     * @brief Handle heap/pool statistics request
+     * GET /api/diag/mem
+     */
+    void handleDiagMem(AsyncWebServerRequest* request);
+
+    /**
+     * @brief Handle cached connector state request (no STM32 round trip)
+     * GET /api/connectors
+     */
+    void handleConnectors(AsyncWebServerRequest* request);
+
     /**
      * @brief MQTT callback for provisioning messages
      */
@@ -0,0 +1,19 @@
+/**
+ * @file ota_signing_key.h
+ * @brief Public key OTA manifests are verified against
+ *
+ * PEM public key (RSA or EC) of the release signing key; the manifest's
+ * "signature" covers target, version, size, SHA-256 and delta base (see
+ * tools/sign_manifest.py). Left empty, every update is refused; a
+ * development build may add -DOTA_ALLOW_UNSIGNED to accept manifests
+ * checked by SHA-256 only.
+ */
+
+#ifndef OTA_SIGNING_KEY_H
+#define OTA_SIGNING_KEY_H
+
+#ifndef OTA_SIGNING_KEY_PEM
+#define OTA_SIGNING_KEY_PEM     ""
+#endif
+
+#endif // OTA_SIGNING_KEY_H
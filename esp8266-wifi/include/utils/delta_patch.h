@@ -0,0 +1,108 @@
+/**
+ * @file delta_patch.h
+ * @brief Streaming decoder for binary delta patches (OTA)
+ * @version 1.0.0
+ *
+ * Rebuilds a target image from the running image (source) and a patch
+ * produced by tools/make_delta.py, one chunk of patch at a time, without
+ * buffering either image.
+ *
+ * Patch format (little-endian, lengths as LEB128 varints):
+ *   "SDP1"  u32 sourceSize  u32 targetSize
+ *   then records until targetSize bytes are produced:
+ *   DELTA_OP_COPY   len          target += source[pos..], pos += len
+ *   DELTA_OP_ADD    len, bytes   target += source[pos + i] + bytes[i] (bsdiff)
+ *   DELTA_OP_INSERT len, bytes   target += bytes
+ *   DELTA_OP_SEEK   offset       pos += offset (zigzag, signed)
+ *
+ * ADD makes code whose addresses moved cheap: the difference bytes are
+ * mostly zero, and the tool turns the zero runs into COPY records.
+ */
+
+#ifndef DELTA_PATCH_H
+#define DELTA_PATCH_H
+
+#include <Arduino.h>
+
+#define DELTA_MAGIC             "SDP1"
+#define DELTA_HEADER_SIZE       12
+#define DELTA_WORK_SIZE         128     // Source bytes read per step
+
+#define DELTA_OP_COPY           0x01
+#define DELTA_OP_ADD            0x02
+#define DELTA_OP_INSERT         0x03
+#define DELTA_OP_SEEK           0x04
+
+enum class DeltaError : uint8_t {
+    NONE,
+    BAD_HEADER,             // Magic or source size mismatch
+    BAD_RECORD,             // Unknown op or malformed varint
+    OUT_OF_RANGE,           // Reads outside the source image
+    TOO_LONG,               // Produces more than targetSize
+    READ_FAILED,
+    WRITE_FAILED
+};
+
+/**
+ * @brief Streaming patch decoder
+ *
+ * feed() stops after a COPY record (which needs no patch bytes but may
+ * produce a lot of output); drain it with pump() under the caller's
+ * time budget, then feed() the rest.
+ */
+class DeltaPatch {
+public:
+    typedef bool (*ReadSource)(uint32_t offset, uint8_t* data, size_t length, void* context);
+    typedef bool (*WriteTarget)(const uint8_t* data, size_t length, void* context);
+
+    DeltaPatch();
+
+    void begin(uint32_t sourceSize, ReadSource read, WriteTarget write, void* context);
+
+    /**
+     * @brief Decode patch bytes
+     * @return Bytes consumed (less than length if a COPY is pending or on error)
+     */
+    size_t feed(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Produce up to budget bytes of a pending COPY
+     * @return Bytes produced
+     */
+    size_t pump(size_t budget);
+
+    bool hasPendingCopy() const { return copyRemaining > 0; }
+    bool isComplete() const;
+    bool hasError() const { return error != DeltaError::NONE; }
+    DeltaError getError() const { return error; }
+    uint32_t getTargetSize() const { return targetSize; }
+    uint32_t getProduced() const { return produced; }
+
+private:
+    enum class State : uint8_t { HEADER, OP, ARG, DATA };
+
+    bool startRecord();
+    bool emit(const uint8_t* data, size_t length);
+    bool fail(DeltaError reason);
+
+    ReadSource readSource;
+    WriteTarget writeTarget;
+    void* context;
+
+    State state;
+    DeltaError error;
+    uint8_t header[DELTA_HEADER_SIZE];
+    uint8_t headerLength;
+    uint8_t op;
+    uint32_t arg;
+    uint8_t argShift;
+
+    uint32_t sourceSize;
+    uint32_t targetSize;
+    uint32_t position;          // Source cursor
+    uint32_t produced;
+    uint32_t dataRemaining;     // ADD/INSERT bytes still to come
+    uint32_t copyRemaining;
+};
+
+#endif // DELTA_PATCH_H
@@ -0,0 +1,203 @@
+/**
+ * @file json_writer.h
+ * @brief Streaming JSON writer (no DOM, fixed buffer)
+ * @version 1.0.0
+ *
+ * Features:
+ * - Writes straight into a caller buffer in one pass
+ * - No heap, no intermediate JsonDocument
+ * - Output matches ArduinoJson serializeJson() (compact, same escaping)
+ * - Overflow is sticky: check ok() / length() once at the end
+ */
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <Arduino.h>
+#include <string.h>
+
+/**
+ * @brief Streaming JSON writer
+ *
+ * Usage:
+ *   char buf[256];
+ *   JsonWriter w(buf, sizeof(buf));
+ *   w.beginObject();
+ *   w.field("msgId", "abc");
+ *   w.field("energy_wh", 1234u);
+ *   w.endObject();
+ *   if (w.ok()) publish(buf, w.length());
+ */
+class JsonWriter {
+private:
+    char* buffer;
+    size_t capacity;
+    size_t pos;
+    bool overflow;
+    bool needComma;
+
+    void put(char c) {
+        if (pos + 1 < capacity) {
+            buffer[pos++] = c;
+        } else {
+            overflow = true;
+        }
+    }
+
+    void put(const char* str, size_t len) {
+        if (pos + len < capacity) {
+            memcpy(buffer + pos, str, len);
+            pos += len;
+        } else {
+            overflow = true;
+        }
+    }
+
+    void separator() {
+        if (needComma) put(',');
+        needComma = true;
+    }
+
+    void writeString(const char* str, size_t len) {
+        static const char hex[] = "0123456789abcdef";
+
+        put('"');
+        for (size_t i = 0; i < len; i++) {
+            char c = str[i];
+            switch (c) {
+                case '"':  put("\\\"", 2); break;
+                case '\\': put("\\\\", 2); break;
+                case '\b': put("\\b", 2); break;
+                case '\f': put("\\f", 2); break;
+                case '\n': put("\\n", 2); break;
+                case '\r': put("\\r", 2); break;
+                case '\t': put("\\t", 2); break;
+                default:
+                    if ((uint8_t)c < 0x20) {
+                        char esc[6] = {'\\', 'u', '0', '0', hex[(c >> 4) & 0x0F], hex[c & 0x0F]};
+                        put(esc, sizeof(esc));
+                    } else {
+                        put(c);
+                    }
+                    break;
+            }
+        }
+        put('"');
+    }
+
+    void writeKey(const char* key) {
+        separator();
+        writeString(key, strlen(key));
+        put(':');
+    }
+
+    void writeUnsigned(uint32_t value) {
+        char digits[10];
+        uint8_t n = 0;
+        do {
+            digits[sizeof(digits) - 1 - n++] = '0' + value % 10;
+            value /= 10;
+        } while (value > 0);
+        put(digits + sizeof(digits) - n, n);
+    }
+
+    void writeSigned(int32_t value) {
+        if (value < 0) {
+            put('-');
+            writeUnsigned((uint32_t)(-(int64_t)value));
+        } else {
+            writeUnsigned((uint32_t)value);
+        }
+    }
+
+public:
+    JsonWriter(char* buf, size_t size)
+        : buffer(buf), capacity(size), pos(0), overflow(size == 0), needComma(false) {
+        if (size > 0) buffer[0] = '\0';
+    }
+
+    void beginObject() {
+        if (needComma) put(',');
+        put('{');
+        needComma = false;
+    }
+
+    void beginObject(const char* key) {
+        writeKey(key);
+        put('{');
+        needComma = false;
+    }
+
+    void endObject() {
+        put('}');
+        needComma = true;
+    }
+
+    void beginArray(const char* key) {
+        writeKey(key);
+        put('[');
+        needComma = false;
+    }
+
+    void endArray() {
+        put(']');
+        needComma = true;
+    }
+
+    void field(const char* key, const char* value) {
+        writeKey(key);
+        writeString(value, strlen(value));
+    }
+
+    /**
+     * @brief String from a fixed char array (bounded, NUL not required)
+     */
+    template<size_t N>
+    void field(const char* key, const char (&value)[N]) {
+        writeKey(key);
+        writeString(value, strnlen(value, N));
+    }
+
+    void field(const char* key, uint32_t value) {
+        writeKey(key);
+        writeUnsigned(value);
+    }
+
+    void field(const char* key, int32_t value) {
+        writeKey(key);
+        writeSigned(value);
+    }
+
+    void field(const char* key, uint16_t value) { field(key, (uint32_t)value); }
+    void field(const char* key, uint8_t value) { field(key, (uint32_t)value); }
+    void field(const char* key, int16_t value) { field(key, (int32_t)value); }
+
+    void field(const char* key, bool value) {
+        writeKey(key);
+        if (value) put("true", 4); else put("false", 5);
+    }
+
+    /**
+     * @brief Unsigned array element
+     */
+    void element(uint32_t value) {
+        separator();
+        writeUnsigned(value);
+    }
+
+    /**
+     * @brief True if everything fit
+     */
+    bool ok() const { return !overflow; }
+
+    /**
+     * @brief Output length, NUL-terminated (0 on overflow)
+     */
+    size_t length() {
+        if (overflow) return 0;
+        buffer[pos] = '\0';
+        return pos;
+    }
+};
+
+#endif // JSON_WRITER_H
@@ -1,13 +1,33 @@
 /**
  * @file logger.h
  * @brief Lightweight logging system for ESP8266
- * @version 1.0.0
+ * @version 2.0.0
+ *
+ * Changes from v1:
+ * - Levels above LOG_LEVEL_MAX are compiled out
+ * - Deferred formatting: a call only stores (format pointer + args) in a
+ *   binary ring; flush() formats and writes in idle time
+ * - Output goes to Serial1 (TX-only, GPIO2) by default, never to the
+ *   STM32 UART link on Serial; any Print (e.g. a network client) works
+ * - LOG_TRACE for per-frame/per-message logs, off unless enabled at runtime
  */
 
 #ifndef LOGGER_H
 #define LOGGER_H
 
 #include <Arduino.h>
+#include <type_traits>
+#include "utils/ring_buffer.h"
+
+// Highest level compiled in (0=ERROR .. 3=DEBUG), e.g. -DLOG_LEVEL_MAX=2
+#ifndef LOG_LEVEL_MAX
+#define LOG_LEVEL_MAX           3
+#endif
+
+#define LOG_RING_SIZE           2048    // Pending records (bytes)
+#define LOG_RECORD_MAX          128     // Encoded record incl. copied strings
+#define LOG_STRING_MAX          48      // %s arguments are copied up to this
+#define LOG_LINE_MAX            192     // Formatted line
 
 enum class LogLevel : uint8_t {
     ERROR = 0,
@@ -16,6 +36,59 @@ enum class LogLevel : uint8_t {
     DEBUG = 3
 };
 
+/**
+ * @brief One log call encoded into a stack buffer (no formatting yet)
+ *
+ * Layout: length, level, timestamp, tag pointer, format pointer, then
+ * per argument a type byte and its value. Strings are copied, since the
+ * caller's buffer is gone by the time the record is flushed.
+ */
+class LogRecord {
+private:
+    uint8_t data[LOG_RECORD_MAX];
+    uint8_t length;
+
+    // Arguments that do not fit are left out (printed as '?')
+    void put(const void* value, uint8_t size) {
+        if (length + size > sizeof(data)) return;
+        memcpy(data + length, value, size);
+        length += size;
+    }
+
+    void putWord(uint8_t type, uint32_t word) {
+        if (length + 1 + sizeof(word) > sizeof(data)) return;
+        data[length++] = type;
+        put(&word, sizeof(word));
+    }
+
+public:
+    LogRecord(LogLevel level, const char* tag, const char* format);
+
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+    add(T value) { putWord('i', (uint32_t)(int32_t)value); }
+
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+    add(T value) { putWord('u', (uint32_t)value); }
+
+    template<typename T>
+    typename std::enable_if<std::is_enum<T>::value>::type
+    add(T value) { putWord('i', (uint32_t)(int32_t)value); }
+
+    void add(double value) {
+        float f = (float)value;
+        uint32_t word;
+        memcpy(&word, &f, sizeof(word));
+        putWord('f', word);
+    }
+
+    void add(const char* value);
+
+    const uint8_t* bytes() const { return data; }
+    uint8_t size() const { return length; }
+};
+
 /**
  * @brief Lightweight logger (Singleton)
  */
@@ -24,31 +97,89 @@ private:
     static Logger instance;
     LogLevel minLevel;
     bool enabled;
+    bool traceEnabled;
 
-    Logger() : minLevel(LogLevel::INFO), enabled(true) {}
+    // Encoded records waiting for flush()
+    RingBuffer<LOG_RING_SIZE> ring;
+    uint32_t dropped;
+    uint32_t droppedReported;
 
-    void printLevel(LogLevel level);
-    void printTimestamp();
+    // Output, and the line being written to it
+    Print* output;
+    bool paced;
+    char line[LOG_LINE_MAX];
+    uint16_t lineLength;
+    uint16_t linePos;
+
+    Logger();
+
+    void push(const LogRecord& record);
+    bool formatNext();
 
 public:
     static Logger& getInstance() { return instance; }
 
+    /**
+     * @brief Select output
+     * @param out Destination (Serial1 by default)
+     * @param pace Only write what out->availableForWrite() accepts (UART)
+     */
+    void setOutput(Print& out, bool pace = true);
+    Print& getOutput() { return *output; }
+
     void setLevel(LogLevel level) { minLevel = level; }
     void enable() { enabled = true; }
     void disable() { enabled = false; }
 
-    void log(LogLevel level, const char* tag, const char* format, ...);
+    /**
+     * @brief Enable LOG_TRACE (per-frame / per-message detail)
+     */
+    void setTrace(bool enable) { traceEnabled = enable; }
+    bool isTraceEnabled() const { return enabled && traceEnabled; }
 
-    void error(const char* tag, const char* format, ...);
-    void warn(const char* tag, const char* format, ...);
-    void info(const char* tag, const char* format, ...);
-    void debug(const char* tag, const char* format, ...);
+    bool isEnabled(LogLevel level) const { return enabled && level <= minLevel; }
+
+    /**
+     * @brief Record a log call (format and tag must be string literals)
+     *
+     * Supported conversions: %d %i %u %x %X %c %s %f %% with flags,
+     * width and precision; %s arguments are truncated to LOG_STRING_MAX.
+     */
+    template<typename... Args>
+    void log(LogLevel level, const char* tag, const char* format, Args... args) {
+        if (!isEnabled(level)) return;
+
+        LogRecord record(level, tag, format);
+        int expand[] = { 0, (record.add(args), 0)... };
+        (void)expand;
+        push(record);
+    }
+
+    /**
+     * @brief Format and write pending records (call from loop idle time)
+     * @param maxLines Upper bound on lines written per call
+     * @return true if records are still pending
+     */
+    bool flush(uint8_t maxLines = 8);
+
+    /**
+     * @brief Records lost because the ring was full
+     */
+    uint32_t getDropped() const { return dropped; }
 };
 
-// Macros for easier logging
-#define LOG_ERROR(tag, ...) Logger::getInstance().error(tag, __VA_ARGS__)
-#define LOG_WARN(tag, ...)  Logger::getInstance().warn(tag, __VA_ARGS__)
-#define LOG_INFO(tag, ...)  Logger::getInstance().info(tag, __VA_ARGS__)
-#define LOG_DEBUG(tag, ...) Logger::getInstance().debug(tag, __VA_ARGS__)
+// Macros for easier logging (levels above LOG_LEVEL_MAX compile to nothing)
+#define LOG_AT(level, tag, ...) \
+    do { if ((int)(level) <= LOG_LEVEL_MAX) Logger::getInstance().log(level, tag, __VA_ARGS__); } while (0)
+
+#define LOG_ERROR(tag, ...) LOG_AT(LogLevel::ERROR, tag, __VA_ARGS__)
+#define LOG_WARN(tag, ...)  LOG_AT(LogLevel::WARN, tag, __VA_ARGS__)
+#define LOG_INFO(tag, ...)  LOG_AT(LogLevel::INFO, tag, __VA_ARGS__)
+#define LOG_DEBUG(tag, ...) LOG_AT(LogLevel::DEBUG, tag, __VA_ARGS__)
+
+// Hot-path detail: DEBUG level, and only while tracing is enabled
+#define LOG_TRACE(tag, ...) \
+    do { if (LOG_LEVEL_MAX >= 3 && Logger::getInstance().isTraceEnabled()) \
+        Logger::getInstance().log(LogLevel::DEBUG, tag, __VA_ARGS__); } while (0)
 
 #endif // LOGGER_H
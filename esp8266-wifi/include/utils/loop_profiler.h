@@ -0,0 +1,101 @@
+/**
+ * @file loop_profiler.h
+ * @brief Per-stage main loop timing (cycle counter, no heap)
+ * @version 1.0.0
+ *
+ * Features:
+ * - ESP.getCycleCount() around each DeviceManager::run() stage
+ * - min / avg / max and a log2 histogram (microseconds) per stage
+ * - Stalls over LOOP_STALL_US are counted and logged with the stage name
+ */
+
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+
+#include <Arduino.h>
+
+#define LOOP_PROFILE_BUCKETS    17          // [0,2) [2,4) .. [32768,65536) >=65536 us
+#define LOOP_STALL_US           50000       // Stage or loop slower than this is a stall
+
+/**
+ * @brief Profiled stages of DeviceManager::run()
+ */
+enum class ProfileStage : uint8_t {
+    LOOP = 0,       // Whole run()
+    STM32,
+    WIFI,
+    MQTT,
+    NTP,
+    HEARTBEAT,
+    METER,
+    SLEEP,          // delay() in loop() (radio may doze), not part of LOOP
+    COUNT
+};
+
+/**
+ * @brief Timing of one stage
+ */
+struct StageStats {
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint64_t totalUs;
+    uint32_t stalls;
+    uint16_t histogram[LOOP_PROFILE_BUCKETS];   // Saturates at 65535
+
+    uint32_t avgUs() const { return count ? (uint32_t)(totalUs / count) : 0; }
+};
+
+/**
+ * @brief Loop latency profiler
+ *
+ * Usage:
+ *   uint32_t start = LoopProfiler::now();
+ *   stm32.handle();
+ *   profiler.record(ProfileStage::STM32, start);
+ */
+class LoopProfiler {
+private:
+    StageStats stages[(uint8_t)ProfileStage::COUNT];
+    uint32_t cyclesPerUs;
+
+public:
+    LoopProfiler();
+
+    /**
+     * @brief Current cycle counter (start stamp for record())
+     */
+    static uint32_t now() { return ESP.getCycleCount(); }
+
+    /**
+     * @brief Account the cycles since start to a stage
+     */
+    void record(ProfileStage stage, uint32_t start) {
+        // Unsigned difference survives the ~53 s counter wrap at 80 MHz
+        addSample(stage, (ESP.getCycleCount() - start) / cyclesPerUs);
+    }
+
+    /**
+     * @brief Account a duration in microseconds to a stage
+     */
+    void addSample(ProfileStage stage, uint32_t us);
+
+    /**
+     * @brief Clear all statistics (e.g. after reading them out)
+     */
+    void reset();
+
+    const StageStats& get(ProfileStage stage) const { return stages[(uint8_t)stage]; }
+
+    /**
+     * @brief Stage name for logs and JSON ("loop", "stm32", ...)
+     */
+    static const char* stageName(ProfileStage stage);
+
+    /**
+     * @brief Lower bound of a histogram bucket in microseconds
+     */
+    static uint32_t bucketFloor(uint8_t bucket) { return bucket ? (1u << bucket) : 0; }
+};
+
+#endif // LOOP_PROFILER_H
@@ -0,0 +1,202 @@
+/**
+ * @file memory_pool.h
+ * @brief Static object slots, fixed block pools and heap watermarks
+ * @version 1.0.0
+ *
+ * Long-lived objects (drivers created once at boot) live in a StaticSlot:
+ * storage in .bss, constructed in place, never on the heap. Buffers that
+ * come and go (OTA sessions) are taken from a BlockPool sized at compile
+ * time, so they still succeed after weeks of uptime when the heap is too
+ * fragmented for a multi-KB malloc().
+ *
+ * Every pool registers itself for diagnostics (use, high-water mark,
+ * refusals); MemoryStats adds heap watermarks and the drift of free heap
+ * since boot finished, which should stay flat in steady state.
+ */
+
+#ifndef MEMORY_POOL_H
+#define MEMORY_POOL_H
+
+#include <Arduino.h>
+#include <new>
+#include <utility>
+
+class JsonWriter;
+
+/**
+ * @brief In-place storage for one long-lived object
+ *
+ * Usage:
+ *   StaticSlot<MQTTClient> mqttSlot;
+ *   MQTTClient* mqtt = mqttSlot.emplace(config);
+ */
+template<typename T>
+class StaticSlot {
+private:
+    alignas(T) uint8_t storage[sizeof(T)];
+    bool constructed;
+
+public:
+    StaticSlot() : constructed(false) {}
+    ~StaticSlot() { reset(); }
+
+    /**
+     * @brief Construct the object (destroys a previous one first)
+     */
+    template<typename... Args>
+    T* emplace(Args&&... args) {
+        reset();
+        T* object = new (storage) T(std::forward<Args>(args)...);
+        constructed = true;
+        return object;
+    }
+
+    void reset() {
+        if (constructed) {
+            get()->~T();
+            constructed = false;
+        }
+    }
+
+    T* get() { return constructed ? reinterpret_cast<T*>(storage) : nullptr; }
+    bool isConstructed() const { return constructed; }
+
+    StaticSlot(const StaticSlot&) = delete;
+    StaticSlot& operator=(const StaticSlot&) = delete;
+};
+
+/**
+ * @brief Fixed-size block allocator (untyped part of BlockPool)
+ */
+class MemoryPool {
+private:
+    const char* name;
+    uint8_t* blocks;
+    uint16_t blockSize;
+    uint8_t blockCount;
+    uint8_t used;
+    uint8_t highWater;
+    uint16_t failures;          // acquire() refused: pool exhausted
+    uint32_t freeMask;          // Bit i set = block i free
+
+    MemoryPool* next;
+    static MemoryPool* head;
+
+protected:
+    MemoryPool(const char* poolName, uint8_t* storage, uint16_t size, uint8_t count);
+    ~MemoryPool();
+
+public:
+    /**
+     * @brief Take a free block (nullptr when exhausted)
+     */
+    void* acquire();
+
+    /**
+     * @brief Return a block from acquire() (nullptr ignored)
+     */
+    void release(void* block);
+
+    const char* getName() const { return name; }
+    uint16_t getBlockSize() const { return blockSize; }
+    uint8_t getBlockCount() const { return blockCount; }
+    uint8_t getUsed() const { return used; }
+    uint8_t getHighWater() const { return highWater; }
+    uint16_t getFailures() const { return failures; }
+
+    /**
+     * @brief Registered pools, for diagnostics: for (p = first(); p; p = p->getNext())
+     */
+    static MemoryPool* first() { return head; }
+    MemoryPool* getNext() const { return next; }
+
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+};
+
+/**
+ * @brief COUNT blocks of BLOCK bytes in static storage
+ *
+ * Usage (file scope):
+ *   static BlockPool<sizeof(OTASession), 1> sessionPool("ota");
+ *   OTASession* s = sessionPool.create<OTASession>();
+ *   sessionPool.destroy(s);
+ */
+template<size_t BLOCK, uint8_t COUNT>
+class BlockPool : public MemoryPool {
+    static_assert(COUNT > 0 && COUNT <= 32, "BlockPool holds 1..32 blocks");
+
+private:
+    static constexpr size_t STRIDE = (BLOCK + 7) & ~(size_t)7;
+    static_assert(STRIDE <= 0xFFFF, "BlockPool block too large");
+
+    alignas(8) uint8_t storage[STRIDE * COUNT];
+
+public:
+    explicit BlockPool(const char* poolName)
+        : MemoryPool(poolName, storage, (uint16_t)STRIDE, COUNT) {}
+
+    /**
+     * @brief Construct a T in a free block (nullptr when exhausted)
+     */
+    template<typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(sizeof(T) <= BLOCK && alignof(T) <= 8, "Type does not fit the pool block");
+        void* block = acquire();
+        return block ? new (block) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    /**
+     * @brief Destroy an object from create() and free its block
+     */
+    template<typename T>
+    void destroy(T* object) {
+        if (!object) return;
+        object->~T();
+        release(object);
+    }
+};
+
+/**
+ * @brief Heap watermarks since boot
+ */
+struct HeapStats {
+    uint32_t freeNow;
+    uint32_t freeMin;
+    uint32_t blockNow;          // Largest free block
+    uint32_t blockMin;
+    uint8_t fragNow;            // Percent
+    uint8_t fragMax;
+    uint32_t steadyFree;        // Free heap when boot finished (0 = not yet)
+};
+
+namespace MemoryStats {
+    /**
+     * @brief Update the heap watermarks (cheap, call from a periodic task)
+     */
+    void sample();
+
+    /**
+     * @brief Boot finished: later free-heap changes count as drift
+     */
+    void markSteadyState();
+
+    /**
+     * @brief Free heap now minus at markSteadyState() (negative = leak/growth)
+     */
+    int32_t drift();
+
+    const HeapStats& heap();
+
+    /**
+     * @brief "heap" and "pools" members into an open JSON object
+     */
+    void writeJson(JsonWriter& w);
+
+    /**
+     * @brief One line for the heap, one per pool
+     */
+    void log();
+}
+
+#endif // MEMORY_POOL_H
@@ -0,0 +1,237 @@
+/**
+ * @file msgpack_writer.h
+ * @brief Streaming MessagePack writer (no DOM, fixed buffer)
+ * @version 1.0.0
+ *
+ * Features:
+ * - Same call sequence as JsonWriter (beginObject/field/endObject)
+ * - Container sizes are patched on close, so callers never count fields
+ * - Smallest encoding per value (fixint/fixstr/fixmap where possible)
+ * - Overflow is sticky: check ok() / length() once at the end
+ */
+
+#ifndef MSGPACK_WRITER_H
+#define MSGPACK_WRITER_H
+
+#include <Arduino.h>
+#include <string.h>
+
+// Max nesting of maps/arrays
+#define MSGPACK_MAX_DEPTH   4
+
+/**
+ * @brief Streaming MessagePack writer
+ *
+ * Usage:
+ *   uint8_t buf[256];
+ *   MsgPackWriter w((char*)buf, sizeof(buf));
+ *   w.beginObject();
+ *   w.field("msgId", "abc");
+ *   w.endObject();
+ *   if (w.ok()) publish(buf, w.length());
+ */
+class MsgPackWriter {
+private:
+    struct Container {
+        size_t headerPos;
+        uint16_t count;
+        bool isMap;
+    };
+
+    uint8_t* buffer;
+    size_t capacity;
+    size_t pos;
+    bool overflow;
+    Container stack[MSGPACK_MAX_DEPTH];
+    uint8_t depth;
+
+    void put(uint8_t b) {
+        if (pos < capacity) {
+            buffer[pos++] = b;
+        } else {
+            overflow = true;
+        }
+    }
+
+    void put(const void* data, size_t len) {
+        if (len <= capacity - pos) {
+            memcpy(buffer + pos, data, len);
+            pos += len;
+        } else {
+            overflow = true;
+        }
+    }
+
+    void put16(uint16_t v) {
+        put((uint8_t)(v >> 8));
+        put((uint8_t)v);
+    }
+
+    void put32(uint32_t v) {
+        put16((uint16_t)(v >> 16));
+        put16((uint16_t)v);
+    }
+
+    void countItem() {
+        if (depth > 0) stack[depth - 1].count++;
+    }
+
+    void writeString(const char* str, size_t len) {
+        if (len < 32) {
+            put((uint8_t)(0xA0 | len));
+        } else if (len <= 0xFF) {
+            put(0xD9);
+            put((uint8_t)len);
+        } else {
+            put(0xDA);
+            put16((uint16_t)len);
+        }
+        put(str, len);
+    }
+
+    void writeKey(const char* key) {
+        countItem();
+        writeString(key, strlen(key));
+    }
+
+    void writeUnsigned(uint32_t v) {
+        if (v < 0x80) {
+            put((uint8_t)v);
+        } else if (v <= 0xFF) {
+            put(0xCC);
+            put((uint8_t)v);
+        } else if (v <= 0xFFFF) {
+            put(0xCD);
+            put16((uint16_t)v);
+        } else {
+            put(0xCE);
+            put32(v);
+        }
+    }
+
+    void writeSigned(int32_t v) {
+        if (v >= 0) {
+            writeUnsigned((uint32_t)v);
+        } else if (v >= -32) {
+            put((uint8_t)(0xE0 | (v + 32)));
+        } else if (v >= -128) {
+            put(0xD0);
+            put((uint8_t)v);
+        } else if (v >= -32768) {
+            put(0xD1);
+            put16((uint16_t)v);
+        } else {
+            put(0xD2);
+            put32((uint32_t)v);
+        }
+    }
+
+    void open(bool isMap) {
+        if (depth >= MSGPACK_MAX_DEPTH) {
+            overflow = true;
+            return;
+        }
+        stack[depth].headerPos = pos;
+        stack[depth].count = 0;
+        stack[depth].isMap = isMap;
+        depth++;
+
+        // Reserve map16/array16 header, shrunk on close if it fits a fix type
+        put(isMap ? 0xDE : 0xDC);
+        put16(0);
+    }
+
+    void close(bool isMap) {
+        if (depth == 0 || stack[depth - 1].isMap != isMap) {
+            overflow = true;
+            return;
+        }
+        const Container& c = stack[--depth];
+        if (overflow) return;
+
+        if (c.count < 16) {
+            buffer[c.headerPos] = (uint8_t)((isMap ? 0x80 : 0x90) | c.count);
+            memmove(buffer + c.headerPos + 1, buffer + c.headerPos + 3, pos - c.headerPos - 3);
+            pos -= 2;
+        } else {
+            buffer[c.headerPos + 1] = (uint8_t)(c.count >> 8);
+            buffer[c.headerPos + 2] = (uint8_t)c.count;
+        }
+    }
+
+public:
+    MsgPackWriter(char* buf, size_t size)
+        : buffer((uint8_t*)buf), capacity(size), pos(0), overflow(false), depth(0) {}
+
+    void beginObject() {
+        countItem();
+        open(true);
+    }
+
+    void beginObject(const char* key) {
+        writeKey(key);
+        open(true);
+    }
+
+    void endObject() { close(true); }
+
+    void beginArray(const char* key) {
+        writeKey(key);
+        open(false);
+    }
+
+    void endArray() { close(false); }
+
+    void field(const char* key, const char* value) {
+        writeKey(key);
+        writeString(value, strlen(value));
+    }
+
+    /**
+     * @brief String from a fixed char array (bounded, NUL not required)
+     */
+    template<size_t N>
+    void field(const char* key, const char (&value)[N]) {
+        writeKey(key);
+        writeString(value, strnlen(value, N));
+    }
+
+    void field(const char* key, uint32_t value) {
+        writeKey(key);
+        writeUnsigned(value);
+    }
+
+    void field(const char* key, int32_t value) {
+        writeKey(key);
+        writeSigned(value);
+    }
+
+    void field(const char* key, uint16_t value) { field(key, (uint32_t)value); }
+    void field(const char* key, uint8_t value) { field(key, (uint32_t)value); }
+    void field(const char* key, int16_t value) { field(key, (int32_t)value); }
+
+    void field(const char* key, bool value) {
+        writeKey(key);
+        put(value ? 0xC3 : 0xC2);
+    }
+
+    /**
+     * @brief Unsigned array element
+     */
+    void element(uint32_t value) {
+        countItem();
+        writeUnsigned(value);
+    }
+
+    /**
+     * @brief True if everything fit and all containers are closed
+     */
+    bool ok() const { return !overflow && depth == 0; }
+
+    /**
+     * @brief Output length (0 on overflow or unbalanced containers)
+     */
+    size_t length() const { return ok() ? pos : 0; }
+};
+
+#endif // MSGPACK_WRITER_H
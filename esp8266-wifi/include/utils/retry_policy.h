@@ -68,4 +68,52 @@ public:
     void reset() override {}
 };
 
+/**
+ * @brief Decorrelated jitter backoff ("sleep = rand(base, previous * 3)")
+ *
+ * Spreads retries of many devices that failed at the same moment (broker
+ * restart, AP reboot) instead of reconnecting in lock-step. Seed it per
+ * device, e.g. from ESP.getChipId(). maxAttempts = 0 retries forever.
+ */
+class DecorrelatedJitter : public IRetryPolicy {
+private:
+    uint32_t baseDelay;
+    uint32_t maxDelay;
+    uint8_t maxAttempts;
+    uint32_t previousDelay;
+    uint32_t state;
+
+    uint32_t nextRandom() {
+        // xorshift32
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+public:
+    DecorrelatedJitter(uint32_t base = 1000, uint32_t max = 60000, uint32_t seed = 1, uint8_t attempts = 0)
+        : baseDelay(base), maxDelay(max), maxAttempts(attempts),
+          previousDelay(base), state(seed ? seed : 0x9E3779B9) {}
+
+    uint32_t getNextDelay(uint8_t attemptCount) override {
+        uint32_t upper = previousDelay > maxDelay / 3 ? maxDelay : previousDelay * 3;
+        if (upper < baseDelay) {
+            upper = baseDelay;
+        }
+
+        uint32_t delay = baseDelay + nextRandom() % (upper - baseDelay + 1);
+        previousDelay = min(delay, maxDelay);
+        return previousDelay;
+    }
+
+    bool shouldRetry(uint8_t attemptCount) override {
+        return maxAttempts == 0 || attemptCount < maxAttempts;
+    }
+
+    void reset() override {
+        previousDelay = baseDelay;
+    }
+};
+
 #endif // RETRY_POLICY_H
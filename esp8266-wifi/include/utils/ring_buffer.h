@@ -8,6 +8,7 @@
  * - Optimized for UART data buffering
  * - Overflow detection
  * - Statistics tracking
+ * - Zero-copy bulk access (writeSpan/commit, readSpan)
  */
 
 #ifndef RING_BUFFER_H
@@ -118,6 +119,81 @@ public:
         return true;
     }
 
+    /**
+     * @brief Get contiguous free space at head for bulk writes
+     * @param length Output: number of bytes writable without wrapping
+     * @return Write pointer (valid until the next push/commit/discard)
+     *
+     * A full buffer reports length 0 and counts as an overflow, same
+     * as a rejected push(). At most two spans are needed to fill the
+     * whole free space (before and after the wrap point).
+     *
+     * Usage:
+     *   size_t len;
+     *   uint8_t* dst = buffer.writeSpan(len);
+     *   buffer.commit(Serial.readBytes(dst, len));
+     */
+    uint8_t* writeSpan(size_t& length) {
+        if (count >= CAPACITY) {
+            overflowCount++;
+            length = 0;
+        } else if (head >= tail) {
+            length = CAPACITY - head;
+        } else {
+            length = tail - head;
+        }
+        return &buffer[head];
+    }
+
+    /**
+     * @brief Commit bytes written into the span from writeSpan()
+     * @param length Number of bytes actually written
+     * @return Number of bytes committed (clamped to free space)
+     */
+    size_t commit(size_t length) {
+        if (length > CAPACITY - count) {
+            length = CAPACITY - count;
+        }
+
+        head += length;
+        if (head >= CAPACITY) {
+            head -= CAPACITY;
+        }
+        count += length;
+        totalPushed += length;
+
+        if (count > peakUsage) {
+            peakUsage = count;
+        }
+
+        return length;
+    }
+
+    /**
+     * @brief Get contiguous readable bytes at offset from tail
+     * @param offset Offset from tail (0 = next byte)
+     * @param length Output: bytes readable without wrapping
+     * @return Read pointer (valid until the next pop/discard)
+     *
+     * Data that wraps needs a second call at offset + length.
+     */
+    uint8_t* readSpan(size_t offset, size_t& length) {
+        if (offset >= count) {
+            length = 0;
+            return &buffer[tail];
+        }
+
+        size_t index = tail + offset;
+        if (index >= CAPACITY) {
+            index -= CAPACITY;
+        }
+
+        size_t remaining = count - offset;
+        size_t toEnd = CAPACITY - index;
+        length = (remaining < toEnd) ? remaining : toEnd;
+        return &buffer[index];
+    }
+
     /**
      * @brief Push multiple bytes
      * @param data Data pointer
@@ -126,11 +202,17 @@ public:
      */
     size_t pushMultiple(const uint8_t* data, size_t length) {
         size_t pushed = 0;
-        for (size_t i = 0; i < length; i++) {
-            if (!push(data[i])) {
+        while (pushed < length) {
+            size_t span;
+            uint8_t* dst = writeSpan(span);
+            if (span == 0) {
                 break;
             }
-            pushed++;
+            if (span > length - pushed) {
+                span = length - pushed;
+            }
+            memcpy(dst, data + pushed, span);
+            pushed += commit(span);
         }
         return pushed;
     }
@@ -233,15 +315,17 @@ public:
 
     /**
      * @brief Print statistics (debug)
+     * @param out Destination (never the STM32 link on Serial)
      */
-    void printStats(const char* name = "RingBuffer") const {
-        Serial.printf("[%s] Stats:\n", name);
-        Serial.printf("  Capacity: %u bytes\n", CAPACITY);
-        Serial.printf("  Available: %u bytes (%u%%)\n", count, getUsagePercent());
-        Serial.printf("  Peak usage: %u bytes (%u%%)\n", peakUsage, (peakUsage * 100) / CAPACITY);
-        Serial.printf("  Total pushed: %u\n", totalPushed);
-        Serial.printf("  Total popped: %u\n", totalPopped);
-        Serial.printf("  Overflows: %u\n", overflowCount);
+    void printStats(Print& out, const char* name = "RingBuffer") const {
+        out.printf("[%s] Stats:\n", name);
+        out.printf("  Capacity: %u bytes\n", (unsigned)CAPACITY);
+        out.printf("  Available: %u bytes (%u%%)\n", (unsigned)count, getUsagePercent());
+        out.printf("  Peak usage: %u bytes (%u%%)\n", (unsigned)peakUsage,
+                   (unsigned)((peakUsage * 100) / CAPACITY));
+        out.printf("  Total pushed: %u\n", totalPushed);
+        out.printf("  Total popped: %u\n", totalPopped);
+        out.printf("  Overflows: %u\n", overflowCount);
     }
 
     /**
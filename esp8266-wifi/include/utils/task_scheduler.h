@@ -0,0 +1,85 @@
+/**
+ * @file task_scheduler.h
+ * @brief Cooperative periodic task scheduler (fixed table, no heap)
+ * @version 1.0.0
+ *
+ * Features:
+ * - Tasks run from loop() when their period has elapsed
+ * - Period 0 = run on every pass (polling, never keeps the loop awake)
+ * - idleTime() tells loop() how long it may sleep until the next task
+ * - Missed deadlines (task ran a full period late) are counted per task
+ */
+
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <Arduino.h>
+
+#define SCHEDULER_MAX_TASKS     16
+
+typedef void (*TaskFunction)();
+
+/**
+ * @brief One scheduled task
+ */
+struct ScheduledTask {
+    const char* name;
+    TaskFunction run;
+    uint32_t periodMs;
+    uint32_t nextRun;       // millis() when due
+    uint32_t runs;
+    uint32_t missed;        // Started more than one period after nextRun
+    bool enabled;
+};
+
+/**
+ * @brief Cooperative scheduler
+ *
+ * Usage:
+ *   int8_t id = scheduler.add("ntp", taskNtp, 1000);
+ *   loop: scheduler.run(millis());
+ *         delay(scheduler.idleTime(millis(), 5));
+ */
+class TaskScheduler {
+private:
+    ScheduledTask tasks[SCHEDULER_MAX_TASKS];
+    uint8_t count;
+
+public:
+    TaskScheduler() : count(0) {}
+
+    /**
+     * @brief Register a task (first run after one period, or right away if 0)
+     * @return Task ID, -1 if the table is full
+     */
+    int8_t add(const char* name, TaskFunction run, uint32_t periodMs);
+
+    /**
+     * @brief Change a task's period (next run one new period from now)
+     */
+    void setPeriod(int8_t id, uint32_t periodMs);
+
+    void setEnabled(int8_t id, bool enabled);
+
+    /**
+     * @brief Make a task due on the next run()
+     */
+    void trigger(int8_t id);
+
+    /**
+     * @brief Run every enabled task that is due
+     */
+    void run(uint32_t now);
+
+    /**
+     * @brief Time until the next periodic task is due
+     * @param maxMs Upper bound on the result
+     * @return 0 if a task is already due
+     */
+    uint32_t idleTime(uint32_t now, uint32_t maxMs) const;
+
+    uint8_t size() const { return count; }
+    const ScheduledTask& get(uint8_t id) const { return tasks[id]; }
+};
+
+#endif // TASK_SCHEDULER_H
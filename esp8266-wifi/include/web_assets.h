@@ -10,253 +10,9 @@
 
 #include <Arduino.h>
 
-// app.C441XP1K.css (gzipped)
-const uint8_t web_app_C441XP1K_css_gz[] PROGMEM = {
-    0x1f, 0x8b, 0x08, 0x00, 0x42, 0xb2, 0xde, 0x68, 0x02, 0xff, 0xd5, 0x5b, 0xeb, 0x8f, 0xe3, 0xb6,
-    0x11, 0xff, 0xde, 0xbf, 0x42, 0xbd, 0xe0, 0x00, 0xfb, 0x2a, 0xe9, 0x24, 0xf9, 0xb9, 0x72, 0x13,
-    0xa4, 0x08, 0x5a, 0x20, 0x40, 0x92, 0x0f, 0x4d, 0xfb, 0xe9, 0x72, 0x1f, 0x64, 0x8b, 0xb6, 0x98,
-    0x95, 0x44, 0x41, 0xa4, 0xd6, 0xf6, 0xaa, 0xfe, 0xdf, 0x3b, 0x7c, 0x49, 0x94, 0x6c, 0xf9, 0xb1,
-    0xb9, 0x14, 0x69, 0x80, 0xdc, 0xae, 0x86, 0xbf, 0x19, 0x0e, 0x87, 0xc3, 0x99, 0xe1, 0x63, 0x3f,
-    0x7e, 0xf8, 0xb3, 0xc5, 0x22, 0x9c, 0xee, 0x71, 0x1e, 0x6f, 0x28, 0xb5, 0x5e, 0xa6, 0xae, 0xef,
-    0xfa, 0x53, 0xeb, 0x3f, 0xd6, 0x8f, 0xdf, 0xff, 0xcb, 0xfa, 0x01, 0x6f, 0x50, 0x4e, 0x11, 0x7c,
-    0x25, 0x8c, 0x15, 0x34, 0xfc, 0xf8, 0xd1, 0xc0, 0xba, 0x1b, 0x92, 0x59, 0x1f, 0x3e, 0x7e, 0x9b,
-    0x46, 0x47, 0x54, 0x5a, 0x45, 0x49, 0x0a, 0x54, 0x32, 0x8c, 0x68, 0xfd, 0x2d, 0xad, 0x8a, 0x82,
-    0x94, 0x8c, 0x5a, 0xa3, 0xd1, 0xc8, 0xd9, 0xa3, 0xf5, 0x33, 0x66, 0x4e, 0x72, 0x2c, 0x12, 0x90,
-    0x15, 0xe6, 0x24, 0x47, 0xe3, 0xb1, 0x15, 0xe5, 0xb1, 0x35, 0xca, 0x09, 0xb3, 0x46, 0x59, 0x54,
-    0xee, 0x70, 0xee, 0xb0, 0x12, 0x67, 0x21, 0xce, 0x53, 0xcc, 0x9b, 0xc7, 0x16, 0x29, 0x81, 0xd9,
-    0xc9, 0xc8, 0xab, 0x43, 0x4a, 0x8c, 0x72, 0xa6, 0x9b, 0x0c, 0xc6, 0x0d, 0x49, 0x49, 0x19, 0x96,
-    0xbb, 0xf5, 0x68, 0x5b, 0x82, 0x26, 0x25, 0x8a, 0xad, 0xd2, 0xda, 0x59, 0x6b, 0x60, 0x1f, 0xd7,
-    0x1f, 0xec, 0x70, 0x8d, 0xb6, 0xa4, 0x44, 0x76, 0x18, 0x6d, 0x19, 0x2a, 0xed, 0x30, 0x5c, 0x47,
-    0x9b, 0xe7, 0x18, 0xb4, 0xac, 0x1d, 0x87, 0xed, 0xa1, 0xbf, 0x28, 0xa7, 0x69, 0xc4, 0x90, 0x73,
-    0x08, 0xbd, 0x55, 0x8f, 0x74, 0x3c, 0x27, 0xbd, 0x6a, 0x52, 0x49, 0x98, 0xe4, 0xc2, 0x39, 0x66,
-    0x38, 0x4a, 0x3b, 0xd4, 0xe3, 0x45, 0xea, 0x6b, 0x97, 0x4a, 0x9f, 0xd1, 0xbe, 0xcf, 0x2f, 0x68,
-    0x3d, 0x6e, 0x5a, 0x44, 0x1b, 0x10, 0xe9, 0x94, 0xe8, 0x05, 0x95, 0x14, 0x69, 0x05, 0xd6, 0xa4,
-    0x8c, 0x51, 0xe9, 0x50, 0x76, 0x4c, 0x51, 0x48, 0x49, 0x8a, 0x63, 0x49, 0xdf, 0x92, 0x9c, 0x81,
-    0xb5, 0xf1, 0x2e, 0x61, 0x5d, 0x39, 0xeb, 0xb4, 0x2a, 0x7b, 0x94, 0x92, 0xa3, 0x72, 0x44, 0x69,
-    0x97, 0xbe, 0x01, 0x11, 0x65, 0x44, 0x7b, 0xfc, 0xbb, 0x32, 0x3a, 0xd2, 0x4d, 0x04, 0xbd, 0x75,
-    0xc8, 0x49, 0x85, 0xd4, 0x00, 0xbb, 0x74, 0x9c, 0x83, 0xba, 0x3d, 0x11, 0x04, 0x86, 0x82, 0x59,
-    0x7f, 0x7c, 0x11, 0xab, 0xca, 0x33, 0x76, 0x8a, 0x0a, 0x1c, 0x75, 0x49, 0x7c, 0xd6, 0x1c, 0x9a,
-    0x44, 0x31, 0xd9, 0x0f, 0x36, 0x38, 0xd2, 0x1d, 0x06, 0x9b, 0xa3, 0xb4, 0x48, 0xa2, 0xd0, 0xf7,
-    0xbc, 0xf7, 0xe7, 0x6d, 0x14, 0xbf, 0xf6, 0x95, 0x90, 0x9d, 0x79, 0x96, 0x67, 0x7d, 0xe5, 0xc1,
-    0x7f, 0x26, 0xf5, 0x52, 0x4f, 0x03, 0x9d, 0x60, 0x58, 0x3c, 0x6c, 0x40, 0x98, 0xd9, 0x76, 0x49,
-    0x64, 0xa7, 0xbd, 0x2f, 0xb8, 0xc4, 0xf9, 0xee, 0x12, 0x93, 0xa0, 0x5f, 0xeb, 0x6f, 0x88, 0xd1,
-    0x68, 0xbd, 0xcc, 0x2e, 0x9a, 0x04, 0xea, 0x42, 0x8f, 0x64, 0xbb, 0xe5, 0xec, 0x7b, 0x1c, 0xb3,
-    0x24, 0xf4, 0x8a, 0xc3, 0x79, 0x93, 0xec, 0xf2, 0xab, 0xed, 0x76, 0x7b, 0xde, 0xd6, 0xef, 0xf0,
-    0x74, 0x3a, 0xa9, 0xa0, 0xc2, 0x12, 0x94, 0xa1, 0x3a, 0x2c, 0x09, 0x61, 0x76, 0x98, 0x10, 0xca,
-    0x60, 0xed, 0x0a, 0x37, 0xa7, 0xb0, 0x2c, 0xc3, 0x0a, 0x8b, 0x9f, 0xe0, 0x31, 0x25, 0xde, 0xda,
-    0xf4, 0x48, 0x19, 0xca, 0x9c, 0x0a, 0xdb, 0x06, 0xf1, 0xdd, 0xdf, 0x8a, 0x22, 0x45, 0xd6, 0x77,
-    0xbc, 0x77, 0xeb, 0xef, 0x19, 0xf9, 0x15, 0xbf, 0xb3, 0xdf, 0xfd, 0x8c, 0x76, 0x04, 0x59, 0xff,
-    0xfe, 0xfe, 0x9c, 0xf0, 0xf3, 0x31, 0x5b, 0x93, 0x14, 0x28, 0x3f, 0x11, 0x46, 0x3a, 0x5c, 0x2b,
-    0xd5, 0x71, 0x46, 0x72, 0xc2, 0x3b, 0xe6, 0x3f, 0xc5, 0xfa, 0xb4, 0x7f, 0xfe, 0xc7, 0x8f, 0xf0,
-    0xbb, 0xf3, 0x4f, 0xb4, 0xab, 0xd2, 0xa8, 0xb4, 0x7f, 0x44, 0x79, 0x4a, 0x6c, 0x20, 0x45, 0x1b,
-    0x62, 0x7f, 0x47, 0x72, 0x58, 0xa0, 0x11, 0xb5, 0xdf, 0xfd, 0x80, 0xd7, 0x08, 0x7c, 0x1d, 0x93,
-    0xdc, 0xe2, 0x70, 0xe8, 0xe2, 0x3b, 0x52, 0x41, 0x64, 0x2b, 0xad, 0x9f, 0xd0, 0xfe, 0x9d, 0xdd,
-    0x88, 0x83, 0x7e, 0x84, 0xa9, 0x60, 0xd1, 0xc7, 0xce, 0xcc, 0x0b, 0xc9, 0x73, 0xba, 0x49, 0x46,
-    0x4f, 0x0b, 0xd7, 0x7f, 0x6f, 0xb9, 0x9e, 0x3f, 0xb1, 0xfc, 0x85, 0x3b, 0x59, 0x8e, 0x3b, 0xb0,
-    0xc0, 0xd3, 0xb8, 0xe5, 0xd2, 0x9d, 0x71, 0xdc, 0x3c, 0xb0, 0xfc, 0xa5, 0x3b, 0x99, 0x4c, 0xbb,
-    0xc0, 0x79, 0x03, 0x9c, 0x2d, 0xdc, 0x05, 0x00, 0x83, 0xe9, 0xcc, 0x0a, 0x40, 0x60, 0x30, 0xeb,
-    0x02, 0x17, 0x2d, 0xd0, 0x13, 0x12, 0x03, 0xe8, 0x19, 0x80, 0x33, 0xdf, 0xe8, 0x7a, 0x57, 0x22,
-    0x94, 0x1b, 0x3a, 0x2e, 0xdd, 0x40, 0xe8, 0xb8, 0xb4, 0xfc, 0xd9, 0xcc, 0x5d, 0x06, 0xf3, 0x3e,
-    0xb4, 0xd5, 0xf3, 0x29, 0x90, 0x7a, 0x2e, 0xa7, 0x02, 0xfb, 0xf4, 0x34, 0xeb, 0x63, 0x5b, 0x55,
-    0xe7, 0x81, 0x50, 0xd5, 0x7f, 0x02, 0xec, 0xf4, 0x09, 0x34, 0x99, 0xf6, 0xb1, 0x86, 0xb6, 0x0a,
-    0x3b, 0xe3, 0x72, 0x3d, 0xb0, 0xc3, 0x53, 0x8b, 0x85, 0x28, 0x88, 0x40, 0x5b, 0x43, 0xec, 0x44,
-    0x0c, 0x6c, 0x6a, 0x05, 0xb3, 0x27, 0x77, 0xe9, 0xcf, 0x7a, 0x50, 0xc3, 0x58, 0x53, 0x77, 0xae,
-    0x8d, 0x05, 0x6c, 0xcb, 0xa5, 0xdf, 0x83, 0xb6, 0x0a, 0x4c, 0x97, 0xee, 0x52, 0x40, 0xc1, 0x5c,
-    0xf3, 0xa9, 0x3b, 0x59, 0x74, 0x8c, 0x10, 0x1d, 0x3b, 0xe6, 0x12, 0x26, 0xf0, 0x02, 0x2b, 0x98,
-    0x2e, 0xdc, 0xe5, 0xe4, 0xa9, 0x87, 0xec, 0x58, 0x6b, 0x29, 0xa0, 0x73, 0x21, 0x74, 0x36, 0xf1,
-    0x7b, 0xd0, 0x49, 0xeb, 0x00, 0x0b, 0x35, 0x09, 0x30, 0x28, 0xee, 0x00, 0xcb, 0xb3, 0xee, 0x9b,
-    0x41, 0xcd, 0xa4, 0x4b, 0x05, 0x0b, 0xa9, 0xe9, 0x7c, 0xda, 0x83, 0xb6, 0xe3, 0x9f, 0xca, 0xf1,
-    0x7b, 0x30, 0xa6, 0xd9, 0xdc, 0x5d, 0x7a, 0x41, 0x0f, 0xd9, 0x0e, 0x7f, 0xb2, 0x10, 0x46, 0xf5,
-    0x26, 0xd2, 0xa8, 0x8b, 0xc9, 0xa4, 0x07, 0x7d, 0x6a, 0xa0, 0x81, 0xaf, 0x81, 0xd0, 0xfb, 0x7c,
-    0x6e, 0x58, 0x7f, 0x9f, 0x60, 0xc8, 0x09, 0x2a, 0x54, 0xf0, 0x45, 0x01, 0xa1, 0x22, 0x74, 0x83,
-    0x59, 0x89, 0x32, 0x81, 0xc9, 0xa1, 0x06, 0xc9, 0x21, 0x01, 0x66, 0x71, 0x18, 0x2c, 0xfb, 0xc4,
-    0xe9, 0x21, 0x0d, 0x67, 0x73, 0x49, 0x65, 0xe8, 0xc0, 0x9c, 0x03, 0x0d, 0xdd, 0xc5, 0xac, 0x43,
-    0x70, 0x1c, 0x5e, 0x4a, 0x38, 0x89, 0x4c, 0x95, 0x90, 0xd8, 0x36, 0x23, 0xff, 0x23, 0x80, 0xc6,
-    0x1a, 0x42, 0xb3, 0xd0, 0x5d, 0x76, 0x98, 0x68, 0x76, 0x89, 0x09, 0x94, 0xfa, 0xc8, 0x81, 0x0d,
-    0x63, 0xba, 0x0b, 0xa1, 0x7a, 0x0a, 0x4c, 0xce, 0x74, 0x77, 0x91, 0x73, 0x31, 0xfb, 0x28, 0x90,
-    0x0d, 0x2b, 0xe8, 0xed, 0xbb, 0x1d, 0xce, 0x43, 0x3a, 0xcc, 0x69, 0x30, 0x4e, 0x04, 0x67, 0x57,
-    0xdd, 0x49, 0x9f, 0xd7, 0x02, 0x16, 0x4b, 0xc7, 0x30, 0x59, 0x23, 0x38, 0x19, 0x8a, 0x71, 0x95,
-    0x85, 0x33, 0x11, 0xe1, 0xcd, 0x06, 0x8a, 0x32, 0x0c, 0x61, 0x30, 0x0e, 0xe7, 0x67, 0x4d, 0x82,
-    0xbc, 0x10, 0xe4, 0x32, 0x02, 0x76, 0xca, 0x87, 0xec, 0xaa, 0xae, 0xa3, 0x1c, 0x67, 0xbc, 0xdc,
-    0xa1, 0x05, 0xce, 0x43, 0xfe, 0x8f, 0xe5, 0x53, 0x8b, 0x6b, 0x11, 0x95, 0x16, 0xce, 0xb7, 0x3c,
-    0x6d, 0xf0, 0xf8, 0x16, 0xa3, 0x6d, 0x54, 0xa5, 0x4c, 0xd6, 0x56, 0x98, 0x87, 0x44, 0x27, 0xae,
-    0x64, 0x6c, 0x0c, 0x61, 0xe9, 0xd2, 0xcb, 0x10, 0x86, 0x33, 0x9e, 0x32, 0xb6, 0x55, 0xbe, 0x11,
-    0xc8, 0x4d, 0xb5, 0xc6, 0x1b, 0x67, 0x8d, 0x5e, 0x21, 0x86, 0x8e, 0xdc, 0xa9, 0xed, 0xd9, 0x6e,
-    0x60, 0x8b, 0x85, 0xa1, 0x99, 0x85, 0xde, 0xdb, 0x28, 0xc3, 0xe9, 0x31, 0x7c, 0x89, 0xca, 0x91,
-    0x91, 0x3a, 0xce, 0x61, 0x88, 0xd7, 0x22, 0xa0, 0x3a, 0x62, 0x0c, 0xba, 0xa1, 0x7d, 0x06, 0xe7,
-    0x32, 0xec, 0x4c, 0x0e, 0xb0, 0x61, 0x31, 0x92, 0x5b, 0x92, 0xce, 0x81, 0xa6, 0x2c, 0x9e, 0x0e,
-    0x86, 0xf4, 0xe7, 0x6d, 0x03, 0xd8, 0x2b, 0x83, 0x10, 0xa8, 0xdb, 0x83, 0x68, 0x85, 0x5d, 0x1f,
-    0x89, 0x21, 0xee, 0xc2, 0x48, 0x9a, 0xfc, 0xbd, 0x8e, 0x28, 0xe2, 0xa5, 0xb8, 0x2a, 0xc1, 0x75,
-    0x45, 0xde, 0x96, 0xe2, 0x6b, 0x72, 0xe0, 0xd5, 0x17, 0x5f, 0xe1, 0xaa, 0xac, 0x05, 0xca, 0x4a,
-    0xfe, 0x0a, 0x05, 0x81, 0xac, 0x6e, 0xe5, 0x0e, 0x01, 0xca, 0xdf, 0x22, 0x8a, 0x63, 0x0e, 0xf5,
-    0x4e, 0x61, 0xb8, 0xc5, 0x29, 0x1f, 0x42, 0x8a, 0x36, 0x8c, 0x87, 0xe1, 0x8a, 0x31, 0x92, 0xbf,
-    0x59, 0x5c, 0xc2, 0xb2, 0x54, 0x17, 0x18, 0x6a, 0xbf, 0x22, 0x97, 0x3d, 0x14, 0x86, 0x4e, 0x14,
-    0xff, 0x5a, 0x41, 0x49, 0x2c, 0x8a, 0x2f, 0x16, 0xad, 0x65, 0xb5, 0x38, 0x5d, 0x99, 0xcb, 0xcb,
-    0x77, 0x67, 0xab, 0xf3, 0xe9, 0xba, 0xe0, 0x88, 0xf6, 0xff, 0xb2, 0x66, 0x19, 0xaf, 0xae, 0xb9,
-    0xc5, 0x55, 0xff, 0xb7, 0x73, 0x52, 0x66, 0x51, 0xaa, 0x24, 0x0c, 0xfa, 0xc2, 0x0d, 0xdf, 0x6f,
-    0xa4, 0x34, 0x46, 0x8d, 0x0a, 0x27, 0x01, 0x8b, 0xa5, 0x22, 0x98, 0xc8, 0x9a, 0x50, 0xac, 0xf1,
-    0x22, 0x2a, 0x61, 0x93, 0x77, 0x5a, 0x93, 0xf8, 0x58, 0x9b, 0x86, 0xc5, 0x79, 0x02, 0x36, 0x61,
-    0xa7, 0xa4, 0xac, 0x15, 0xc5, 0x5b, 0xe9, 0xea, 0x55, 0xb4, 0xa8, 0xc9, 0x75, 0x18, 0x54, 0xf3,
-    0xb2, 0xfc, 0xf4, 0x8b, 0xc3, 0x29, 0x5a, 0xaf, 0xcb, 0x70, 0x0f, 0x00, 0x34, 0xfa, 0xc4, 0x30,
-    0x4b, 0xd1, 0xe7, 0x71, 0x77, 0x62, 0x63, 0xb4, 0x21, 0x2a, 0xe4, 0x54, 0x39, 0xf0, 0xf3, 0x3e,
-    0xad, 0x98, 0x30, 0x86, 0xe2, 0xd5, 0x2d, 0xc0, 0x29, 0xf1, 0xed, 0x24, 0xb0, 0x93, 0x89, 0x9d,
-    0x4c, 0xed, 0x64, 0x66, 0x27, 0xf3, 0x5a, 0xae, 0x6e, 0xb9, 0x8b, 0x90, 0x6a, 0x75, 0x37, 0x63,
-    0x72, 0x10, 0x51, 0xdd, 0x55, 0x7d, 0x48, 0x23, 0xdd, 0x3e, 0x40, 0x3f, 0xad, 0x6d, 0xca, 0x4a,
-    0x92, 0xef, 0x6a, 0xb3, 0x13, 0x1e, 0x99, 0x51, 0x79, 0xda, 0x90, 0x18, 0xd9, 0xcf, 0xeb, 0x18,
-    0x1c, 0x2a, 0x2b, 0xec, 0xa2, 0x44, 0xf5, 0xb0, 0x5f, 0xf6, 0xa3, 0x8c, 0xfd, 0x3b, 0xd6, 0xb5,
-    0xf7, 0xf9, 0xe2, 0x70, 0x2c, 0x7b, 0xd0, 0x21, 0xaf, 0xc5, 0xb1, 0xae, 0x28, 0x31, 0x6b, 0x3e,
-    0xca, 0x4e, 0x14, 0x68, 0xa9, 0x31, 0x93, 0x4b, 0xef, 0xfd, 0x89, 0x56, 0x60, 0xeb, 0xaa, 0xa8,
-    0xf9, 0x86, 0x16, 0x43, 0xfe, 0x85, 0x7d, 0x18, 0xde, 0xe5, 0x21, 0x0f, 0x6b, 0xdc, 0x21, 0x0c,
-    0x09, 0x8b, 0xd9, 0xfb, 0x4e, 0x44, 0x80, 0xe8, 0x42, 0x64, 0xe6, 0x0a, 0x4b, 0x94, 0x82, 0x02,
-    0x2f, 0x88, 0x4b, 0x83, 0x08, 0x05, 0x81, 0x2a, 0x0b, 0x1d, 0xc8, 0xe0, 0xbc, 0x4f, 0x90, 0x0d,
-    0x9e, 0x0b, 0x9f, 0xfc, 0x0b, 0x82, 0x4b, 0x8a, 0x6a, 0x31, 0xeb, 0x18, 0x7c, 0x2e, 0xe7, 0x52,
-    0x94, 0x7b, 0x5f, 0xf4, 0x79, 0x20, 0xa6, 0x51, 0x41, 0x51, 0xa8, 0x7f, 0x39, 0x85, 0xe2, 0xc4,
-    0x64, 0x4b, 0x36, 0x15, 0xe5, 0x1b, 0xac, 0x9a, 0x54, 0x8c, 0x2b, 0x15, 0x46, 0x15, 0x23, 0xa7,
-    0xa2, 0x24, 0x50, 0x2f, 0x53, 0x3a, 0x34, 0x1a, 0xd0, 0x26, 0x83, 0xd8, 0x78, 0xac, 0x63, 0x4c,
-    0x0b, 0x88, 0xdf, 0x61, 0x8a, 0x29, 0x68, 0x02, 0x01, 0xea, 0x44, 0x52, 0xbb, 0x4a, 0xed, 0x0c,
-    0xe5, 0x55, 0x2d, 0x88, 0xf2, 0xec, 0x81, 0x1f, 0xe5, 0x9c, 0x70, 0xb6, 0xb3, 0xe9, 0xcb, 0xce,
-    0x7e, 0xc1, 0x31, 0x22, 0xf6, 0x26, 0xca, 0x5f, 0xc0, 0x2d, 0xa2, 0x2a, 0xc6, 0xc4, 0xc6, 0xdb,
-    0x32, 0xca, 0x90, 0x8d, 0xb2, 0x35, 0x8a, 0x6d, 0xb2, 0xfe, 0x15, 0x42, 0x75, 0xbf, 0xef, 0x0c,
-    0xc7, 0x71, 0x8a, 0x56, 0xba, 0xc7, 0x75, 0x4a, 0x36, 0xcf, 0x42, 0xa4, 0x10, 0x57, 0x67, 0xd1,
-    0x41, 0xaf, 0x6a, 0x1e, 0x7d, 0x95, 0x6d, 0xc5, 0x68, 0x64, 0xc4, 0xb7, 0x71, 0x5e, 0x54, 0xcc,
-    0x96, 0x79, 0xc0, 0x26, 0x05, 0xdb, 0x95, 0xa4, 0x2a, 0x6c, 0x6e, 0x43, 0x88, 0x28, 0x91, 0x98,
-    0xce, 0xee, 0x9a, 0x3c, 0xf3, 0xc0, 0x4e, 0xeb, 0x05, 0xc7, 0xd2, 0xed, 0x29, 0x10, 0xf8, 0xb1,
-    0x8b, 0x2a, 0x48, 0x35, 0xb9, 0x3b, 0x33, 0xfa, 0x9c, 0xc3, 0x5f, 0xf1, 0x14, 0xc7, 0x95, 0xc9,
-    0x63, 0xbd, 0xf7, 0x15, 0x7b, 0x69, 0x35, 0x75, 0xb2, 0x78, 0x1a, 0x4e, 0x64, 0x7f, 0x7c, 0xbd,
-    0x65, 0x74, 0x95, 0x7a, 0x87, 0x98, 0x8e, 0x3e, 0x65, 0xb0, 0xee, 0x30, 0x24, 0xae, 0xcf, 0xf6,
-    0x27, 0xbe, 0x22, 0x3e, 0xf3, 0x43, 0x3c, 0x35, 0x1f, 0x97, 0x02, 0xd5, 0x43, 0x02, 0xf8, 0x2f,
-    0x30, 0xb8, 0x5a, 0x65, 0x6c, 0x47, 0x1e, 0x06, 0x82, 0x1b, 0x46, 0x25, 0x0b, 0x03, 0x0f, 0x22,
-    0xfe, 0x80, 0x1d, 0xd5, 0xe1, 0xa2, 0xc2, 0xa3, 0x3c, 0x0e, 0xa7, 0x02, 0x0c, 0xde, 0xb6, 0x41,
-    0x89, 0xd0, 0xa4, 0x6e, 0xc7, 0x2e, 0x07, 0xbc, 0xa9, 0x4a, 0x9e, 0x8c, 0x44, 0x26, 0x3d, 0x19,
-    0x67, 0x99, 0xaa, 0x55, 0xec, 0x51, 0x32, 0x7c, 0x18, 0x41, 0x7d, 0x9b, 0x46, 0x6b, 0x1b, 0xf6,
-    0xcb, 0xfc, 0xff, 0xf1, 0xb8, 0xee, 0x8a, 0xbd, 0x00, 0x87, 0x9d, 0x0f, 0x30, 0x98, 0xf2, 0xad,
-    0x99, 0xf7, 0xde, 0x36, 0x32, 0x20, 0x94, 0x4e, 0x8d, 0xef, 0xc2, 0x5a, 0xe5, 0x91, 0x45, 0xaf,
-    0x18, 0xd0, 0x5a, 0x27, 0x0c, 0x0a, 0x15, 0xf5, 0x26, 0x31, 0x52, 0x43, 0x93, 0xdc, 0xa2, 0xa2,
-    0x80, 0xb6, 0x28, 0xdf, 0xa8, 0xd5, 0xd9, 0xf2, 0xc4, 0xbc, 0x32, 0x8f, 0x60, 0x56, 0xa1, 0x90,
-    0x46, 0xe0, 0x2f, 0xb0, 0x6f, 0xad, 0xa1, 0xa2, 0x6e, 0x2a, 0x98, 0x34, 0x91, 0xf9, 0x46, 0xae,
-    0x4b, 0x9d, 0x6a, 0xba, 0xfc, 0x82, 0x15, 0x76, 0x0d, 0xac, 0x09, 0x11, 0xca, 0xb0, 0xdb, 0x14,
-    0x1d, 0x86, 0xb0, 0xce, 0x16, 0xa3, 0x34, 0xa6, 0xce, 0xbe, 0xe4, 0xca, 0x95, 0xb5, 0x59, 0xc4,
-    0x5d, 0x16, 0xae, 0x67, 0x59, 0x44, 0x83, 0x61, 0x9c, 0x73, 0x84, 0xa1, 0x4a, 0xe9, 0x77, 0xb3,
-    0x40, 0x5e, 0x60, 0xc9, 0x83, 0x3c, 0x31, 0xec, 0x5b, 0x1f, 0xe3, 0x48, 0x20, 0x05, 0x3e, 0xaa,
-    0x18, 0xce, 0x2b, 0x98, 0xa0, 0xc7, 0x98, 0x28, 0x38, 0x00, 0xcc, 0xe8, 0xa3, 0x3d, 0xa5, 0x10,
-    0xc3, 0xdf, 0xc4, 0x09, 0x2e, 0x11, 0x63, 0xa8, 0x57, 0x07, 0xd8, 0x44, 0xf2, 0x81, 0x1a, 0x02,
-    0x43, 0x0e, 0x80, 0x42, 0x5b, 0x56, 0xe3, 0xf2, 0x6c, 0x4f, 0x38, 0xa3, 0x19, 0xb2, 0x9b, 0xea,
-    0xec, 0x58, 0xa0, 0xaf, 0x65, 0x03, 0xac, 0x7b, 0xf1, 0x05, 0x7e, 0x8f, 0x98, 0xfe, 0x80, 0x9c,
-    0x99, 0x61, 0x06, 0xe5, 0x9b, 0xe1, 0xd9, 0x12, 0x3e, 0xb4, 0xe4, 0x2f, 0x01, 0xf5, 0x78, 0x70,
-    0x9e, 0x8b, 0x50, 0x08, 0x7e, 0xaf, 0xd0, 0x66, 0x4a, 0x69, 0x71, 0x90, 0x37, 0xaf, 0xe0, 0x3e,
-    0x25, 0x90, 0xb5, 0x50, 0xfe, 0x59, 0x8d, 0x01, 0x06, 0xc7, 0x46, 0x8a, 0xf6, 0x75, 0x95, 0x33,
-    0x9c, 0x42, 0x06, 0x86, 0xf8, 0x09, 0x01, 0xac, 0x59, 0x27, 0x7c, 0xfc, 0x7f, 0xc6, 0x19, 0x8f,
-    0x24, 0x11, 0xd4, 0xb9, 0x7a, 0x7f, 0xb4, 0x21, 0x40, 0xca, 0x61, 0xdd, 0xd3, 0x95, 0xa2, 0x54,
-    0xc0, 0x8e, 0xc5, 0x2d, 0x8a, 0xab, 0xb3, 0x7a, 0xfd, 0x82, 0x29, 0x5e, 0x73, 0xf2, 0xb1, 0xcd,
-    0xf4, 0xae, 0x20, 0xa6, 0x9d, 0x46, 0x45, 0x3a, 0xb9, 0xd1, 0x1a, 0xaa, 0x33, 0x18, 0x42, 0xdd,
-    0xd4, 0x20, 0x9a, 0x72, 0x72, 0xb7, 0xf8, 0x80, 0xe2, 0xb6, 0x41, 0x7c, 0x9e, 0x5c, 0x5d, 0xa3,
-    0xd4, 0xe7, 0x55, 0x8b, 0xcb, 0x4b, 0x6b, 0xff, 0x97, 0x8f, 0x81, 0xa8, 0x54, 0x20, 0x5e, 0x01,
-    0x5a, 0x94, 0xef, 0x41, 0x5d, 0xb6, 0xe7, 0x12, 0xb2, 0xfc, 0x52, 0x49, 0x66, 0xfc, 0x21, 0x18,
-    0x9f, 0xdc, 0xec, 0xe0, 0x70, 0x73, 0x75, 0x63, 0xb0, 0xb4, 0xa0, 0x9b, 0x31, 0xc7, 0xd7, 0x0d,
-    0x5c, 0xec, 0x25, 0x19, 0xfe, 0x58, 0xe0, 0x82, 0x5b, 0xb8, 0x40, 0xe2, 0xa6, 0xb7, 0x70, 0x53,
-    0x89, 0xf3, 0x6f, 0x0a, 0xf4, 0x85, 0xc4, 0x75, 0xab, 0xa1, 0x2a, 0xda, 0x06, 0x95, 0x5c, 0xb7,
-    0x4a, 0x5e, 0x81, 0x2a, 0xa9, 0xd3, 0x3b, 0xa0, 0x53, 0x09, 0x9d, 0xdf, 0x01, 0x9d, 0x4b, 0xe8,
-    0xf2, 0x0e, 0xe8, 0x12, 0xa0, 0x62, 0xb1, 0xd6, 0xdd, 0x7a, 0xcb, 0xe5, 0xe1, 0xbb, 0xa1, 0x89,
-    0x58, 0xee, 0xaa, 0xc0, 0xde, 0x85, 0x9b, 0xc4, 0x93, 0x9b, 0x38, 0xb3, 0xda, 0x3c, 0x9a, 0xea,
-    0xf5, 0x36, 0x1b, 0x73, 0x08, 0x58, 0xfb, 0x0a, 0x46, 0x58, 0x1a, 0x40, 0xf3, 0xab, 0x20, 0x31,
-    0x44, 0x9e, 0xaa, 0x1c, 0xba, 0xe1, 0x07, 0xbe, 0x9d, 0xbc, 0xe5, 0x79, 0x2f, 0xc9, 0xc9, 0xdd,
-    0x83, 0x2e, 0xb2, 0x50, 0x1c, 0x52, 0x65, 0xcf, 0x55, 0x19, 0x86, 0x08, 0x4d, 0xf6, 0x5c, 0x93,
-    0x2b, 0x98, 0xb9, 0xc0, 0x6c, 0x2b, 0xd8, 0x27, 0xb4, 0x55, 0x29, 0xe8, 0xc6, 0xab, 0x54, 0x7e,
-    0xf2, 0x68, 0xd4, 0xab, 0x92, 0xb5, 0x73, 0x2e, 0x39, 0xd6, 0xc8, 0x2c, 0xbe, 0x02, 0xcc, 0xe2,
-    0xb1, 0x9c, 0x10, 0x70, 0x3f, 0xfe, 0x23, 0xf4, 0xd5, 0x27, 0x14, 0x42, 0xfb, 0xba, 0xf9, 0x8d,
-    0x93, 0xcd, 0x0b, 0x4b, 0xb9, 0x42, 0xcf, 0xae, 0x31, 0x2d, 0x07, 0x16, 0xac, 0xb5, 0x6a, 0x48,
-    0xaa, 0xbb, 0xee, 0xfd, 0xe7, 0xf8, 0x02, 0xf1, 0x08, 0x5a, 0x88, 0xaf, 0x2d, 0x6c, 0x96, 0xea,
-    0xe6, 0xb7, 0x96, 0x5f, 0x5f, 0x83, 0xda, 0xe3, 0x3e, 0xe9, 0x78, 0x4e, 0x7a, 0x35, 0x48, 0xf2,
-    0xf6, 0xb3, 0x4f, 0x00, 0x26, 0x88, 0x5b, 0xc6, 0x01, 0x62, 0x2d, 0x3f, 0x78, 0x28, 0x92, 0x48,
-    0xb3, 0x71, 0xcc, 0x23, 0x16, 0xaf, 0x8e, 0x74, 0x91, 0x04, 0x5e, 0x9f, 0x28, 0x3b, 0x41, 0x88,
-    0x94, 0x66, 0x8a, 0x71, 0x89, 0xd4, 0x59, 0x21, 0xc4, 0xbe, 0x2c, 0x07, 0xa7, 0x86, 0xbd, 0x0c,
-    0x75, 0x36, 0x10, 0x6f, 0xa1, 0x0e, 0x11, 0x85, 0x8e, 0xd8, 0xde, 0xd0, 0x50, 0x92, 0x34, 0x40,
-    0x94, 0x95, 0x9d, 0x76, 0x21, 0x4f, 0x90, 0x4f, 0x2e, 0x3f, 0x0c, 0xc2, 0xdb, 0xa3, 0xb3, 0x46,
-    0x6c, 0xcf, 0x9d, 0x51, 0x7f, 0xf3, 0x29, 0xe4, 0x7b, 0x36, 0x79, 0x6b, 0xab, 0x5a, 0x5b, 0xb8,
-    0xea, 0xb5, 0x8f, 0xd6, 0x3d, 0xef, 0xa2, 0x02, 0x82, 0x08, 0xfc, 0x3b, 0x18, 0x3a, 0x38, 0x62,
-    0x32, 0x88, 0x98, 0x28, 0xc4, 0x7c, 0x10, 0x01, 0xce, 0xab, 0x12, 0x96, 0xab, 0x2f, 0x96, 0x83,
-    0x6f, 0x44, 0xee, 0x0a, 0x61, 0x27, 0xcf, 0x9c, 0x4d, 0x82, 0x53, 0x5e, 0xc5, 0x0e, 0x5c, 0x3d,
-    0xeb, 0xf0, 0xc2, 0xd7, 0xbe, 0x2a, 0xbc, 0x45, 0x2f, 0x97, 0xd5, 0xfd, 0xd0, 0xce, 0x6e, 0x57,
-    0xd2, 0x78, 0xdc, 0x95, 0xc4, 0x4b, 0xf2, 0x6b, 0x72, 0xe4, 0xa1, 0xb7, 0xe5, 0x58, 0xc3, 0x02,
-    0xcf, 0xc7, 0x35, 0xf9, 0x9d, 0xc6, 0x35, 0xf9, 0x42, 0xe3, 0x9a, 0xdc, 0x39, 0x2e, 0x57, 0xec,
-    0xc3, 0x10, 0xaf, 0xa4, 0xcc, 0xdd, 0x97, 0xbc, 0x26, 0x68, 0x5a, 0x65, 0x40, 0xea, 0x42, 0x26,
-    0xee, 0xd4, 0x0b, 0x96, 0x01, 0x9a, 0x2c, 0x61, 0xbb, 0xd3, 0x00, 0xd3, 0x5d, 0x0f, 0x26, 0x3b,
-    0x6f, 0x4e, 0xf2, 0x79, 0x7e, 0x10, 0xed, 0x75, 0xe7, 0x8d, 0x41, 0xa3, 0xa2, 0x49, 0x1d, 0xeb,
-    0x2d, 0x61, 0x7b, 0xea, 0xe6, 0xea, 0x33, 0x57, 0xf0, 0xe4, 0xe6, 0xf8, 0x95, 0x67, 0xa3, 0xbb,
-    0xe4, 0x28, 0xa8, 0x14, 0x17, 0x98, 0xe2, 0xd4, 0x6d, 0x5c, 0xdd, 0x39, 0x0b, 0xd1, 0x71, 0xd3,
-    0xbc, 0xaf, 0x6b, 0xf4, 0x6f, 0x6e, 0xd0, 0x86, 0x79, 0x34, 0xa2, 0xc7, 0x33, 0xb9, 0xc9, 0x33,
-    0xe9, 0xf2, 0xa8, 0x8b, 0xcd, 0x6b, 0x4c, 0x0a, 0xd2, 0x72, 0xa9, 0x4b, 0xdb, 0x61, 0x1e, 0x05,
-    0xe0, 0x1c, 0x3b, 0x63, 0xfc, 0xfd, 0xad, 0xf9, 0x90, 0x0d, 0x76, 0xfa, 0xb2, 0xef, 0x3a, 0x8b,
-    0x02, 0x69, 0x0e, 0x79, 0x9b, 0x7b, 0x8b, 0x45, 0xa2, 0x4c, 0x9e, 0x9b, 0xaa, 0x35, 0x30, 0xc9,
-    0x25, 0x6f, 0xb6, 0xaf, 0xb3, 0x48, 0x8c, 0xc4, 0x8b, 0xfb, 0xc0, 0xeb, 0x70, 0x01, 0x01, 0x34,
-    0x8f, 0x90, 0x7a, 0x7f, 0x39, 0x14, 0x25, 0x0b, 0xa8, 0xc0, 0xae, 0x61, 0xa6, 0x02, 0x33, 0xbf,
-    0x8a, 0xe1, 0x85, 0x40, 0x71, 0x68, 0x3b, 0xd3, 0xc5, 0xed, 0x60, 0x9f, 0x87, 0xb6, 0xd3, 0x6b,
-    0xd8, 0xa9, 0xc4, 0xce, 0xef, 0xc1, 0x0a, 0x1d, 0xc0, 0x85, 0x7b, 0xfb, 0xb0, 0xa1, 0xf4, 0x01,
-    0xd0, 0xe5, 0x1d, 0x50, 0x5e, 0x23, 0x16, 0xa5, 0xe3, 0x7b, 0x0d, 0x76, 0xb8, 0xc8, 0xf7, 0xf9,
-    0x04, 0x89, 0x43, 0x03, 0x95, 0xdc, 0x8c, 0x03, 0x04, 0x9d, 0xd7, 0xe4, 0x1d, 0x28, 0xda, 0x32,
-    0xb3, 0x91, 0x7f, 0xab, 0x26, 0x21, 0xdd, 0x6c, 0x13, 0x04, 0x48, 0xe5, 0xfa, 0x96, 0xa9, 0xbe,
-    0x76, 0x0d, 0xa6, 0x84, 0x4c, 0x0e, 0xe6, 0xc1, 0xad, 0x0a, 0x33, 0xaa, 0x61, 0xdc, 0x39, 0x96,
-    0x6d, 0x42, 0x50, 0x8a, 0x22, 0x3e, 0x3a, 0xbb, 0x0b, 0xee, 0x5c, 0x9a, 0x8e, 0xb5, 0xf8, 0x74,
-    0x77, 0x59, 0x3a, 0x04, 0xcc, 0xbb, 0x85, 0xf7, 0xae, 0x81, 0x1b, 0xd9, 0x34, 0xbb, 0x2c, 0x9b,
-    0x66, 0xf7, 0xcb, 0xee, 0x5d, 0x4e, 0x37, 0xb2, 0x87, 0xac, 0xf2, 0x88, 0x51, 0x86, 0x6c, 0x72,
-    0xa0, 0x03, 0xb2, 0xe9, 0x03, 0xb2, 0xe9, 0x99, 0x6c, 0x21, 0x93, 0x9f, 0x10, 0xd6, 0x67, 0x4f,
-    0xda, 0x8c, 0xb9, 0x37, 0x2e, 0xa3, 0xc7, 0xab, 0x3b, 0x30, 0xda, 0x9d, 0xc4, 0x85, 0xf7, 0x3d,
-    0x92, 0x25, 0xf2, 0x96, 0x6c, 0x85, 0x52, 0xd2, 0xf5, 0xad, 0xf9, 0x3d, 0xf2, 0x35, 0xf6, 0x56,
-    0x0f, 0x0d, 0x4e, 0x59, 0x5d, 0xbf, 0xe1, 0xa8, 0x07, 0x83, 0xb9, 0xd7, 0x81, 0xce, 0x87, 0xa1,
-    0xf3, 0x1e, 0x74, 0x31, 0x0c, 0x5d, 0xf4, 0xa0, 0x4f, 0xc3, 0xd0, 0x27, 0x13, 0xaa, 0x93, 0xc3,
-    0xf5, 0x8c, 0x60, 0x80, 0x17, 0x57, 0xc0, 0x86, 0x12, 0xea, 0x29, 0x53, 0x7d, 0x39, 0x6d, 0xcc,
-    0xbb, 0xc0, 0xc5, 0x20, 0xd0, 0x90, 0x28, 0x53, 0xcc, 0x70, 0x5e, 0x91, 0x4f, 0x1a, 0xeb, 0xee,
-    0xf3, 0x46, 0xfe, 0x63, 0xc4, 0x77, 0x80, 0x30, 0x8b, 0x38, 0x85, 0x68, 0x67, 0x14, 0x38, 0x69,
-    0x55, 0x1a, 0x3b, 0x9c, 0xf6, 0xb9, 0xa5, 0x41, 0xd4, 0x6f, 0x2d, 0x0d, 0x52, 0xf3, 0xd0, 0xd2,
-    0xa0, 0xb5, 0xaf, 0x2c, 0x0d, 0xa2, 0xec, 0xdc, 0xdc, 0x43, 0xa9, 0xa7, 0x94, 0x26, 0x89, 0xbf,
-    0xa3, 0x34, 0xbe, 0x8d, 0x07, 0x8f, 0x7c, 0xaf, 0x25, 0x55, 0xae, 0xff, 0x0f, 0x35, 0x6f, 0x1f,
-    0x85, 0xd4, 0xc6, 0xfb, 0x10, 0xf5, 0xfe, 0xf8, 0x28, 0x4f, 0xdc, 0xed, 0x7e, 0xb9, 0x60, 0x9b,
-    0xb5, 0x96, 0xad, 0xee, 0xc5, 0xd4, 0x57, 0xef, 0x9e, 0x55, 0x51, 0xc1, 0x32, 0xa9, 0xb8, 0x68,
-    0x7d, 0x46, 0xb6, 0x1e, 0x63, 0xcc, 0x9f, 0x22, 0x3b, 0xfc, 0xb9, 0x71, 0x8f, 0xf4, 0x02, 0x0a,
-    0x77, 0x29, 0x8c, 0xd8, 0xea, 0x62, 0xc1, 0x6e, 0xcf, 0x41, 0xed, 0x66, 0x23, 0x6d, 0x37, 0x5b,
-    0x6d, 0x5b, 0xda, 0x4d, 0x59, 0x4a, 0xce, 0x87, 0xad, 0x0f, 0x22, 0xf5, 0x43, 0x09, 0x47, 0xd1,
-    0xfb, 0xdf, 0xea, 0x64, 0xc6, 0x56, 0xdb, 0x49, 0xa7, 0x3d, 0x0d, 0xb4, 0x09, 0x18, 0x9a, 0x37,
-    0x15, 0x04, 0xf3, 0x54, 0xec, 0xc0, 0xb6, 0x82, 0x9f, 0x33, 0x5e, 0x79, 0x52, 0xd3, 0x18, 0x1c,
-    0x45, 0x14, 0xd9, 0xdd, 0x0b, 0xd5, 0x61, 0x36, 0xd8, 0xf9, 0x5c, 0x7a, 0xc9, 0xd3, 0xce, 0x9e,
-    0xa2, 0x0c, 0x0b, 0xd4, 0x08, 0x48, 0x00, 0xdf, 0xf2, 0x98, 0x1a, 0x59, 0xa3, 0x84, 0x6b, 0x1f,
-    0x8a, 0x7f, 0xc7, 0xb5, 0x2b, 0x7e, 0xfe, 0x12, 0x9a, 0xfb, 0x01, 0xfe, 0x90, 0x4d, 0x90, 0x6f,
-    0xec, 0x0a, 0x64, 0x44, 0xd4, 0x02, 0x76, 0xed, 0x7b, 0x3d, 0xc5, 0x7c, 0xb3, 0xa4, 0x5e, 0xf4,
-    0x04, 0xe8, 0x57, 0x7c, 0x77, 0xf0, 0xb7, 0xf5, 0xb5, 0xc9, 0xae, 0x5f, 0x2c, 0xde, 0x25, 0xa0,
-    0x8d, 0x7c, 0x4a, 0x44, 0x27, 0x60, 0x2b, 0x19, 0x57, 0xc3, 0xb6, 0xe2, 0x53, 0xe7, 0xf0, 0x92,
-    0xa1, 0xfb, 0xc4, 0x19, 0xb6, 0x6e, 0xd6, 0x04, 0xfe, 0xf7, 0x8c, 0xbd, 0xa8, 0xf1, 0x2a, 0xd9,
-    0x16, 0x17, 0x80, 0x9e, 0xe7, 0x47, 0x63, 0x5b, 0x82, 0x61, 0x73, 0x66, 0x39, 0xfc, 0x97, 0x5b,
-    0xf8, 0x95, 0x71, 0x03, 0x60, 0x44, 0x80, 0xf6, 0xcd, 0xef, 0xd8, 0xee, 0x91, 0x8d, 0x07, 0xc8,
-    0x46, 0xdb, 0xf9, 0x63, 0xe1, 0x7e, 0xe3, 0x19, 0x55, 0x11, 0x4e, 0x3c, 0x39, 0x6f, 0x2a, 0x7a,
-    0xee, 0x3c, 0x82, 0x7c, 0x97, 0xf3, 0x28, 0x01, 0xa2, 0x9f, 0x40, 0xf1, 0x9d, 0x3d, 0xb6, 0xee,
-    0xaa, 0x23, 0x06, 0x63, 0x8f, 0xf9, 0x8b, 0x66, 0xcf, 0x12, 0xa5, 0x33, 0xb7, 0xd9, 0x5f, 0xac,
-    0x8b, 0x23, 0x12, 0x3b, 0xde, 0xf1, 0xb8, 0xdb, 0x26, 0x4d, 0xa9, 0xae, 0x0a, 0xc5, 0xc7, 0x1f,
-    0xc1, 0x9a, 0x1d, 0x5b, 0xf4, 0x4c, 0xd9, 0x7f, 0x97, 0x3e, 0x60, 0x4d, 0x88, 0x58, 0xfc, 0x99,
-    0x43, 0xfc, 0x0b, 0xbf, 0x67, 0xa5, 0xd0, 0x96, 0x13, 0x5e, 0xfa, 0xa7, 0x64, 0x8f, 0xe2, 0x50,
-    0x37, 0xd6, 0xb2, 0x2d, 0x34, 0xda, 0x4c, 0x4e, 0x15, 0x58, 0xf9, 0x32, 0x6c, 0x38, 0xf4, 0x2d,
-    0xae, 0x3b, 0x3b, 0x9d, 0xbe, 0xd5, 0xc9, 0xc0, 0xea, 0x1f, 0x75, 0xd6, 0xf4, 0x98, 0xb3, 0xe8,
-    0x10, 0xbe, 0xfb, 0xf0, 0x6e, 0xa5, 0xee, 0x38, 0x69, 0xb8, 0x8d, 0x52, 0x8a, 0x56, 0xea, 0x55,
-    0xbb, 0xbc, 0x1a, 0x0d, 0xbd, 0x61, 0x21, 0xc7, 0x2f, 0x21, 0xe4, 0xf5, 0xed, 0x42, 0xf4, 0xc9,
-    0xeb, 0xb0, 0x84, 0x01, 0x8e, 0xe3, 0xc3, 0x1c, 0xaf, 0xf7, 0x73, 0xc8, 0x63, 0xdd, 0x07, 0xf1,
-    0x0f, 0x68, 0xd4, 0x3b, 0x1e, 0x7b, 0xbb, 0xf9, 0xcc, 0xc3, 0xa7, 0xbb, 0xa5, 0x88, 0x97, 0x83,
-    0x7d, 0x49, 0x46, 0xa5, 0x7e, 0xff, 0x38, 0x78, 0x81, 0xf5, 0x00, 0xba, 0xa9, 0xbf, 0xee, 0xe7,
-    0xd1, 0xe5, 0xd9, 0xfd, 0x1c, 0x4d, 0xf5, 0x76, 0x3f, 0x4b, 0x5b, 0xdc, 0xdd, 0xcf, 0xa3, 0xaa,
-    0xe8, 0xbb, 0xf1, 0x6a, 0x49, 0x3f, 0xe0, 0x23, 0xaa, 0x96, 0x7c, 0x80, 0x83, 0x97, 0x9a, 0xf7,
-    0xc3, 0x8d, 0x4a, 0xf4, 0x4d, 0x4c, 0x32, 0x1c, 0xbe, 0x8d, 0x55, 0xfc, 0x09, 0x50, 0xc3, 0xfa,
-    0x57, 0x40, 0xf1, 0x33, 0x96, 0x68, 0x87, 0xbe, 0xb9, 0xe1, 0xbb, 0xe2, 0x92, 0xea, 0x8a, 0x60,
-    0x71, 0x8f, 0x72, 0xbf, 0xc5, 0x6e, 0x8c, 0xbe, 0xbf, 0xfc, 0x9a, 0x3f, 0xea, 0xb9, 0x28, 0xe7,
-    0x51, 0x83, 0xfc, 0x1e, 0xb6, 0x30, 0x53, 0xe8, 0x6f, 0x1f, 0xd7, 0xf9, 0x9f, 0x75, 0x3d, 0xb2,
-    0x40, 0xfa, 0x7f, 0xf2, 0xf5, 0xa5, 0xc6, 0xd8, 0xe6, 0xe5, 0x07, 0x72, 0x40, 0x5b, 0x0a, 0x7c,
-    0x29, 0xb3, 0xbc, 0x45, 0x8d, 0xb3, 0x52, 0xe6, 0xb7, 0x2b, 0xd3, 0xd6, 0x68, 0x0f, 0x5a, 0xc3,
-    0xac, 0xd8, 0xda, 0xa9, 0x49, 0x51, 0xbe, 0x63, 0xc9, 0x37, 0x0f, 0xe7, 0xf1, 0xfe, 0x9f, 0xc7,
-    0xdd, 0x3d, 0x30, 0xfe, 0xb7, 0x31, 0xd7, 0xa4, 0xbd, 0xdd, 0x4e, 0xcf, 0xe8, 0x28, 0x1e, 0x6d,
-    0x52, 0x4b, 0xdc, 0xc1, 0x32, 0x62, 0x5c, 0xfd, 0xca, 0x70, 0x3f, 0x9a, 0xcc, 0xbd, 0x18, 0xed,
-    0xa0, 0xb2, 0xfe, 0xd3, 0x7f, 0x01, 0x4e, 0x03, 0x0d, 0x0a, 0x3c, 0x3c, 0x00, 0x00,
-};
-const size_t web_app_C441XP1K_css_gz_len = 3822;
-
 // app.C1mNkYXX.js (gzipped)
 const uint8_t web_app_C1mNkYXX_js_gz[] PROGMEM = {
-    0x1f, 0x8b, 0x08, 0x00, 0x42, 0xb2, 0xde, 0x68, 0x02, 0xff, 0xcd, 0x7c, 0xdb, 0x72, 0xe3, 0xc8,
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xcd, 0x7c, 0xdb, 0x72, 0xe3, 0xc8,
     0x72, 0xe0, 0xbb, 0xbf, 0x82, 0x44, 0x74, 0xd0, 0x80, 0x55, 0xa4, 0x48, 0xa9, 0x6f, 0x03, 0x4e,
     0x35, 0xa3, 0x5b, 0xa3, 0x9e, 0xd6, 0x39, 0xdd, 0x92, 0x4e, 0xab, 0x7b, 0xfa, 0x1c, 0x33, 0x64,
     0x1e, 0x10, 0x2c, 0x92, 0x10, 0x41, 0x80, 0x83, 0x0b, 0x29, 0x8e, 0xc8, 0x08, 0xef, 0xdb, 0xbe,
@@ -802,20 +558,288 @@ const uint8_t web_app_C1mNkYXX_js_gz[] PROGMEM = {
 };
 const size_t web_app_C1mNkYXX_js_gz_len = 8685;
 
-// vite.svg (gzipped)
-const uint8_t web_vite_svg_gz[] PROGMEM = {
-    0x1f, 0x8b, 0x08, 0x00, 0x42, 0xb2, 0xde, 0x68, 0x02, 0xff, 0x95, 0x54, 0x4d, 0x8f, 0xdb, 0x36,
-    0x10, 0xfd, 0x2b, 0x04, 0x83, 0x00, 0xed, 0x81, 0x34, 0x87, 0x43, 0x72, 0xc8, 0x60, 0xb5, 0xc0,
-    0x06, 0x1b, 0x17, 0x01, 0x36, 0x97, 0xde, 0xda, 0x9b, 0x2a, 0xcb, 0x6b, 0xa1, 0x5a, 0xcb, 0x90,
-    0x95, 0xf5, 0xe6, 0xdf, 0xf7, 0xd1, 0xce, 0x22, 0x4d, 0xb6, 0x4d, 0x1b, 0x18, 0xa2, 0x29, 0xce,
-    0x9b, 0x8f, 0xf7, 0x66, 0xc4, 0xab, 0xe3, 0xe3, 0xbd, 0x7a, 0x7a, 0x18, 0xf7, 0xc7, 0x46, 0xef,
-    0x96, 0xe5, 0xf0, 0x66, 0xb5, 0x3a, 0x9d, 0x4e, 0xf6, 0xc4, 0x76, 0x9a, 0xef, 0x57, 0xde, 0x39,
-    0xb7, 0x02, 0x42, 0x5f, 0x20, 0x6f, 0x9e, 0xc6, 0x61, 0xff, 0xe7, 0x3f, 0x01, 0xa9, 0x94, 0xb2,
-    0x3a, 0x5b, 0xb5, 0x6a, 0xe7, 0xa1, 0x35, 0xbb, 0x61, 0xb3, 0xe9, 0xf7, 0x8d, 0x5e, 0xe6, 0x8f,
-    0xbd, 0x56, 0xf3, 0x34, 0xf6, 0x8d, 0x1e, 0x1e, 0x10, 0xa8, 0x1b, 0xdb, 0x23, 0x72, 0x0d, 0xdd,
-    0xb4, 0x1f, 0xb6, 0x9f, 0xd4, 0xe7, 0x7f, 0x63, 0xc6, 0xe9, 0x7e, 0x3a, 0x6a, 0x75, 0x1a, 0x36,
-    0xcb, 0xae, 0xd1, 0x4c, 0x36, 0x67, 0xad, 0x76, 0xfd, 0x70, 0xbf, 0x5b, 0xf0, 0xea, 0xb5, 0x3a,
-    0xcc, 0xfd, 0xb1, 0x9f, 0x1f, 0xfb, 0x9b, 0xe3, 0xa1, 0xef, 0x96, 0x5f, 0xdb, 0x65, 0x98, 0x1a,
+// app.C441XP1K.css (gzipped)
+const uint8_t web_app_C441XP1K_css_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x5b, 0xeb, 0x8f, 0xe3, 0xb6,
+    0x11, 0xff, 0xde, 0xbf, 0x42, 0xbd, 0xe0, 0x00, 0xfb, 0x2a, 0xe9, 0x24, 0xf9, 0xb9, 0x72, 0x13,
+    0xa4, 0x08, 0x5a, 0x20, 0x40, 0x92, 0x0f, 0x4d, 0xfb, 0xe9, 0x72, 0x1f, 0x64, 0x8b, 0xb6, 0x98,
+    0x95, 0x44, 0x41, 0xa4, 0xd6, 0xf6, 0xaa, 0xfe, 0xdf, 0x3b, 0x7c, 0x49, 0x94, 0x6c, 0xf9, 0xb1,
+    0xb9, 0x14, 0x69, 0x80, 0xdc, 0xae, 0x86, 0xbf, 0x19, 0x0e, 0x87, 0xc3, 0x99, 0xe1, 0x63, 0x3f,
+    0x7e, 0xf8, 0xb3, 0xc5, 0x22, 0x9c, 0xee, 0x71, 0x1e, 0x6f, 0x28, 0xb5, 0x5e, 0xa6, 0xae, 0xef,
+    0xfa, 0x53, 0xeb, 0x3f, 0xd6, 0x8f, 0xdf, 0xff, 0xcb, 0xfa, 0x01, 0x6f, 0x50, 0x4e, 0x11, 0x7c,
+    0x25, 0x8c, 0x15, 0x34, 0xfc, 0xf8, 0xd1, 0xc0, 0xba, 0x1b, 0x92, 0x59, 0x1f, 0x3e, 0x7e, 0x9b,
+    0x46, 0x47, 0x54, 0x5a, 0x45, 0x49, 0x0a, 0x54, 0x32, 0x8c, 0x68, 0xfd, 0x2d, 0xad, 0x8a, 0x82,
+    0x94, 0x8c, 0x5a, 0xa3, 0xd1, 0xc8, 0xd9, 0xa3, 0xf5, 0x33, 0x66, 0x4e, 0x72, 0x2c, 0x12, 0x90,
+    0x15, 0xe6, 0x24, 0x47, 0xe3, 0xb1, 0x15, 0xe5, 0xb1, 0x35, 0xca, 0x09, 0xb3, 0x46, 0x59, 0x54,
+    0xee, 0x70, 0xee, 0xb0, 0x12, 0x67, 0x21, 0xce, 0x53, 0xcc, 0x9b, 0xc7, 0x16, 0x29, 0x81, 0xd9,
+    0xc9, 0xc8, 0xab, 0x43, 0x4a, 0x8c, 0x72, 0xa6, 0x9b, 0x0c, 0xc6, 0x0d, 0x49, 0x49, 0x19, 0x96,
+    0xbb, 0xf5, 0x68, 0x5b, 0x82, 0x26, 0x25, 0x8a, 0xad, 0xd2, 0xda, 0x59, 0x6b, 0x60, 0x1f, 0xd7,
+    0x1f, 0xec, 0x70, 0x8d, 0xb6, 0xa4, 0x44, 0x76, 0x18, 0x6d, 0x19, 0x2a, 0xed, 0x30, 0x5c, 0x47,
+    0x9b, 0xe7, 0x18, 0xb4, 0xac, 0x1d, 0x87, 0xed, 0xa1, 0xbf, 0x28, 0xa7, 0x69, 0xc4, 0x90, 0x73,
+    0x08, 0xbd, 0x55, 0x8f, 0x74, 0x3c, 0x27, 0xbd, 0x6a, 0x52, 0x49, 0x98, 0xe4, 0xc2, 0x39, 0x66,
+    0x38, 0x4a, 0x3b, 0xd4, 0xe3, 0x45, 0xea, 0x6b, 0x97, 0x4a, 0x9f, 0xd1, 0xbe, 0xcf, 0x2f, 0x68,
+    0x3d, 0x6e, 0x5a, 0x44, 0x1b, 0x10, 0xe9, 0x94, 0xe8, 0x05, 0x95, 0x14, 0x69, 0x05, 0xd6, 0xa4,
+    0x8c, 0x51, 0xe9, 0x50, 0x76, 0x4c, 0x51, 0x48, 0x49, 0x8a, 0x63, 0x49, 0xdf, 0x92, 0x9c, 0x81,
+    0xb5, 0xf1, 0x2e, 0x61, 0x5d, 0x39, 0xeb, 0xb4, 0x2a, 0x7b, 0x94, 0x92, 0xa3, 0x72, 0x44, 0x69,
+    0x97, 0xbe, 0x01, 0x11, 0x65, 0x44, 0x7b, 0xfc, 0xbb, 0x32, 0x3a, 0xd2, 0x4d, 0x04, 0xbd, 0x75,
+    0xc8, 0x49, 0x85, 0xd4, 0x00, 0xbb, 0x74, 0x9c, 0x83, 0xba, 0x3d, 0x11, 0x04, 0x86, 0x82, 0x59,
+    0x7f, 0x7c, 0x11, 0xab, 0xca, 0x33, 0x76, 0x8a, 0x0a, 0x1c, 0x75, 0x49, 0x7c, 0xd6, 0x1c, 0x9a,
+    0x44, 0x31, 0xd9, 0x0f, 0x36, 0x38, 0xd2, 0x1d, 0x06, 0x9b, 0xa3, 0xb4, 0x48, 0xa2, 0xd0, 0xf7,
+    0xbc, 0xf7, 0xe7, 0x6d, 0x14, 0xbf, 0xf6, 0x95, 0x90, 0x9d, 0x79, 0x96, 0x67, 0x7d, 0xe5, 0xc1,
+    0x7f, 0x26, 0xf5, 0x52, 0x4f, 0x03, 0x9d, 0x60, 0x58, 0x3c, 0x6c, 0x40, 0x98, 0xd9, 0x76, 0x49,
+    0x64, 0xa7, 0xbd, 0x2f, 0xb8, 0xc4, 0xf9, 0xee, 0x12, 0x93, 0xa0, 0x5f, 0xeb, 0x6f, 0x88, 0xd1,
+    0x68, 0xbd, 0xcc, 0x2e, 0x9a, 0x04, 0xea, 0x42, 0x8f, 0x64, 0xbb, 0xe5, 0xec, 0x7b, 0x1c, 0xb3,
+    0x24, 0xf4, 0x8a, 0xc3, 0x79, 0x93, 0xec, 0xf2, 0xab, 0xed, 0x76, 0x7b, 0xde, 0xd6, 0xef, 0xf0,
+    0x74, 0x3a, 0xa9, 0xa0, 0xc2, 0x12, 0x94, 0xa1, 0x3a, 0x2c, 0x09, 0x61, 0x76, 0x98, 0x10, 0xca,
+    0x60, 0xed, 0x0a, 0x37, 0xa7, 0xb0, 0x2c, 0xc3, 0x0a, 0x8b, 0x9f, 0xe0, 0x31, 0x25, 0xde, 0xda,
+    0xf4, 0x48, 0x19, 0xca, 0x9c, 0x0a, 0xdb, 0x06, 0xf1, 0xdd, 0xdf, 0x8a, 0x22, 0x45, 0xd6, 0x77,
+    0xbc, 0x77, 0xeb, 0xef, 0x19, 0xf9, 0x15, 0xbf, 0xb3, 0xdf, 0xfd, 0x8c, 0x76, 0x04, 0x59, 0xff,
+    0xfe, 0xfe, 0x9c, 0xf0, 0xf3, 0x31, 0x5b, 0x93, 0x14, 0x28, 0x3f, 0x11, 0x46, 0x3a, 0x5c, 0x2b,
+    0xd5, 0x71, 0x46, 0x72, 0xc2, 0x3b, 0xe6, 0x3f, 0xc5, 0xfa, 0xb4, 0x7f, 0xfe, 0xc7, 0x8f, 0xf0,
+    0xbb, 0xf3, 0x4f, 0xb4, 0xab, 0xd2, 0xa8, 0xb4, 0x7f, 0x44, 0x79, 0x4a, 0x6c, 0x20, 0x45, 0x1b,
+    0x62, 0x7f, 0x47, 0x72, 0x58, 0xa0, 0x11, 0xb5, 0xdf, 0xfd, 0x80, 0xd7, 0x08, 0x7c, 0x1d, 0x93,
+    0xdc, 0xe2, 0x70, 0xe8, 0xe2, 0x3b, 0x52, 0x41, 0x64, 0x2b, 0xad, 0x9f, 0xd0, 0xfe, 0x9d, 0xdd,
+    0x88, 0x83, 0x7e, 0x84, 0xa9, 0x60, 0xd1, 0xc7, 0xce, 0xcc, 0x0b, 0xc9, 0x73, 0xba, 0x49, 0x46,
+    0x4f, 0x0b, 0xd7, 0x7f, 0x6f, 0xb9, 0x9e, 0x3f, 0xb1, 0xfc, 0x85, 0x3b, 0x59, 0x8e, 0x3b, 0xb0,
+    0xc0, 0xd3, 0xb8, 0xe5, 0xd2, 0x9d, 0x71, 0xdc, 0x3c, 0xb0, 0xfc, 0xa5, 0x3b, 0x99, 0x4c, 0xbb,
+    0xc0, 0x79, 0x03, 0x9c, 0x2d, 0xdc, 0x05, 0x00, 0x83, 0xe9, 0xcc, 0x0a, 0x40, 0x60, 0x30, 0xeb,
+    0x02, 0x17, 0x2d, 0xd0, 0x13, 0x12, 0x03, 0xe8, 0x19, 0x80, 0x33, 0xdf, 0xe8, 0x7a, 0x57, 0x22,
+    0x94, 0x1b, 0x3a, 0x2e, 0xdd, 0x40, 0xe8, 0xb8, 0xb4, 0xfc, 0xd9, 0xcc, 0x5d, 0x06, 0xf3, 0x3e,
+    0xb4, 0xd5, 0xf3, 0x29, 0x90, 0x7a, 0x2e, 0xa7, 0x02, 0xfb, 0xf4, 0x34, 0xeb, 0x63, 0x5b, 0x55,
+    0xe7, 0x81, 0x50, 0xd5, 0x7f, 0x02, 0xec, 0xf4, 0x09, 0x34, 0x99, 0xf6, 0xb1, 0x86, 0xb6, 0x0a,
+    0x3b, 0xe3, 0x72, 0x3d, 0xb0, 0xc3, 0x53, 0x8b, 0x85, 0x28, 0x88, 0x40, 0x5b, 0x43, 0xec, 0x44,
+    0x0c, 0x6c, 0x6a, 0x05, 0xb3, 0x27, 0x77, 0xe9, 0xcf, 0x7a, 0x50, 0xc3, 0x58, 0x53, 0x77, 0xae,
+    0x8d, 0x05, 0x6c, 0xcb, 0xa5, 0xdf, 0x83, 0xb6, 0x0a, 0x4c, 0x97, 0xee, 0x52, 0x40, 0xc1, 0x5c,
+    0xf3, 0xa9, 0x3b, 0x59, 0x74, 0x8c, 0x10, 0x1d, 0x3b, 0xe6, 0x12, 0x26, 0xf0, 0x02, 0x2b, 0x98,
+    0x2e, 0xdc, 0xe5, 0xe4, 0xa9, 0x87, 0xec, 0x58, 0x6b, 0x29, 0xa0, 0x73, 0x21, 0x74, 0x36, 0xf1,
+    0x7b, 0xd0, 0x49, 0xeb, 0x00, 0x0b, 0x35, 0x09, 0x30, 0x28, 0xee, 0x00, 0xcb, 0xb3, 0xee, 0x9b,
+    0x41, 0xcd, 0xa4, 0x4b, 0x05, 0x0b, 0xa9, 0xe9, 0x7c, 0xda, 0x83, 0xb6, 0xe3, 0x9f, 0xca, 0xf1,
+    0x7b, 0x30, 0xa6, 0xd9, 0xdc, 0x5d, 0x7a, 0x41, 0x0f, 0xd9, 0x0e, 0x7f, 0xb2, 0x10, 0x46, 0xf5,
+    0x26, 0xd2, 0xa8, 0x8b, 0xc9, 0xa4, 0x07, 0x7d, 0x6a, 0xa0, 0x81, 0xaf, 0x81, 0xd0, 0xfb, 0x7c,
+    0x6e, 0x58, 0x7f, 0x9f, 0x60, 0xc8, 0x09, 0x2a, 0x54, 0xf0, 0x45, 0x01, 0xa1, 0x22, 0x74, 0x83,
+    0x59, 0x89, 0x32, 0x81, 0xc9, 0xa1, 0x06, 0xc9, 0x21, 0x01, 0x66, 0x71, 0x18, 0x2c, 0xfb, 0xc4,
+    0xe9, 0x21, 0x0d, 0x67, 0x73, 0x49, 0x65, 0xe8, 0xc0, 0x9c, 0x03, 0x0d, 0xdd, 0xc5, 0xac, 0x43,
+    0x70, 0x1c, 0x5e, 0x4a, 0x38, 0x89, 0x4c, 0x95, 0x90, 0xd8, 0x36, 0x23, 0xff, 0x23, 0x80, 0xc6,
+    0x1a, 0x42, 0xb3, 0xd0, 0x5d, 0x76, 0x98, 0x68, 0x76, 0x89, 0x09, 0x94, 0xfa, 0xc8, 0x81, 0x0d,
+    0x63, 0xba, 0x0b, 0xa1, 0x7a, 0x0a, 0x4c, 0xce, 0x74, 0x77, 0x91, 0x73, 0x31, 0xfb, 0x28, 0x90,
+    0x0d, 0x2b, 0xe8, 0xed, 0xbb, 0x1d, 0xce, 0x43, 0x3a, 0xcc, 0x69, 0x30, 0x4e, 0x04, 0x67, 0x57,
+    0xdd, 0x49, 0x9f, 0xd7, 0x02, 0x16, 0x4b, 0xc7, 0x30, 0x59, 0x23, 0x38, 0x19, 0x8a, 0x71, 0x95,
+    0x85, 0x33, 0x11, 0xe1, 0xcd, 0x06, 0x8a, 0x32, 0x0c, 0x61, 0x30, 0x0e, 0xe7, 0x67, 0x4d, 0x82,
+    0xbc, 0x10, 0xe4, 0x32, 0x02, 0x76, 0xca, 0x87, 0xec, 0xaa, 0xae, 0xa3, 0x1c, 0x67, 0xbc, 0xdc,
+    0xa1, 0x05, 0xce, 0x43, 0xfe, 0x8f, 0xe5, 0x53, 0x8b, 0x6b, 0x11, 0x95, 0x16, 0xce, 0xb7, 0x3c,
+    0x6d, 0xf0, 0xf8, 0x16, 0xa3, 0x6d, 0x54, 0xa5, 0x4c, 0xd6, 0x56, 0x98, 0x87, 0x44, 0x27, 0xae,
+    0x64, 0x6c, 0x0c, 0x61, 0xe9, 0xd2, 0xcb, 0x10, 0x86, 0x33, 0x9e, 0x32, 0xb6, 0x55, 0xbe, 0x11,
+    0xc8, 0x4d, 0xb5, 0xc6, 0x1b, 0x67, 0x8d, 0x5e, 0x21, 0x86, 0x8e, 0xdc, 0xa9, 0xed, 0xd9, 0x6e,
+    0x60, 0x8b, 0x85, 0xa1, 0x99, 0x85, 0xde, 0xdb, 0x28, 0xc3, 0xe9, 0x31, 0x7c, 0x89, 0xca, 0x91,
+    0x91, 0x3a, 0xce, 0x61, 0x88, 0xd7, 0x22, 0xa0, 0x3a, 0x62, 0x0c, 0xba, 0xa1, 0x7d, 0x06, 0xe7,
+    0x32, 0xec, 0x4c, 0x0e, 0xb0, 0x61, 0x31, 0x92, 0x5b, 0x92, 0xce, 0x81, 0xa6, 0x2c, 0x9e, 0x0e,
+    0x86, 0xf4, 0xe7, 0x6d, 0x03, 0xd8, 0x2b, 0x83, 0x10, 0xa8, 0xdb, 0x83, 0x68, 0x85, 0x5d, 0x1f,
+    0x89, 0x21, 0xee, 0xc2, 0x48, 0x9a, 0xfc, 0xbd, 0x8e, 0x28, 0xe2, 0xa5, 0xb8, 0x2a, 0xc1, 0x75,
+    0x45, 0xde, 0x96, 0xe2, 0x6b, 0x72, 0xe0, 0xd5, 0x17, 0x5f, 0xe1, 0xaa, 0xac, 0x05, 0xca, 0x4a,
+    0xfe, 0x0a, 0x05, 0x81, 0xac, 0x6e, 0xe5, 0x0e, 0x01, 0xca, 0xdf, 0x22, 0x8a, 0x63, 0x0e, 0xf5,
+    0x4e, 0x61, 0xb8, 0xc5, 0x29, 0x1f, 0x42, 0x8a, 0x36, 0x8c, 0x87, 0xe1, 0x8a, 0x31, 0x92, 0xbf,
+    0x59, 0x5c, 0xc2, 0xb2, 0x54, 0x17, 0x18, 0x6a, 0xbf, 0x22, 0x97, 0x3d, 0x14, 0x86, 0x4e, 0x14,
+    0xff, 0x5a, 0x41, 0x49, 0x2c, 0x8a, 0x2f, 0x16, 0xad, 0x65, 0xb5, 0x38, 0x5d, 0x99, 0xcb, 0xcb,
+    0x77, 0x67, 0xab, 0xf3, 0xe9, 0xba, 0xe0, 0x88, 0xf6, 0xff, 0xb2, 0x66, 0x19, 0xaf, 0xae, 0xb9,
+    0xc5, 0x55, 0xff, 0xb7, 0x73, 0x52, 0x66, 0x51, 0xaa, 0x24, 0x0c, 0xfa, 0xc2, 0x0d, 0xdf, 0x6f,
+    0xa4, 0x34, 0x46, 0x8d, 0x0a, 0x27, 0x01, 0x8b, 0xa5, 0x22, 0x98, 0xc8, 0x9a, 0x50, 0xac, 0xf1,
+    0x22, 0x2a, 0x61, 0x93, 0x77, 0x5a, 0x93, 0xf8, 0x58, 0x9b, 0x86, 0xc5, 0x79, 0x02, 0x36, 0x61,
+    0xa7, 0xa4, 0xac, 0x15, 0xc5, 0x5b, 0xe9, 0xea, 0x55, 0xb4, 0xa8, 0xc9, 0x75, 0x18, 0x54, 0xf3,
+    0xb2, 0xfc, 0xf4, 0x8b, 0xc3, 0x29, 0x5a, 0xaf, 0xcb, 0x70, 0x0f, 0x00, 0x34, 0xfa, 0xc4, 0x30,
+    0x4b, 0xd1, 0xe7, 0x71, 0x77, 0x62, 0x63, 0xb4, 0x21, 0x2a, 0xe4, 0x54, 0x39, 0xf0, 0xf3, 0x3e,
+    0xad, 0x98, 0x30, 0x86, 0xe2, 0xd5, 0x2d, 0xc0, 0x29, 0xf1, 0xed, 0x24, 0xb0, 0x93, 0x89, 0x9d,
+    0x4c, 0xed, 0x64, 0x66, 0x27, 0xf3, 0x5a, 0xae, 0x6e, 0xb9, 0x8b, 0x90, 0x6a, 0x75, 0x37, 0x63,
+    0x72, 0x10, 0x51, 0xdd, 0x55, 0x7d, 0x48, 0x23, 0xdd, 0x3e, 0x40, 0x3f, 0xad, 0x6d, 0xca, 0x4a,
+    0x92, 0xef, 0x6a, 0xb3, 0x13, 0x1e, 0x99, 0x51, 0x79, 0xda, 0x90, 0x18, 0xd9, 0xcf, 0xeb, 0x18,
+    0x1c, 0x2a, 0x2b, 0xec, 0xa2, 0x44, 0xf5, 0xb0, 0x5f, 0xf6, 0xa3, 0x8c, 0xfd, 0x3b, 0xd6, 0xb5,
+    0xf7, 0xf9, 0xe2, 0x70, 0x2c, 0x7b, 0xd0, 0x21, 0xaf, 0xc5, 0xb1, 0xae, 0x28, 0x31, 0x6b, 0x3e,
+    0xca, 0x4e, 0x14, 0x68, 0xa9, 0x31, 0x93, 0x4b, 0xef, 0xfd, 0x89, 0x56, 0x60, 0xeb, 0xaa, 0xa8,
+    0xf9, 0x86, 0x16, 0x43, 0xfe, 0x85, 0x7d, 0x18, 0xde, 0xe5, 0x21, 0x0f, 0x6b, 0xdc, 0x21, 0x0c,
+    0x09, 0x8b, 0xd9, 0xfb, 0x4e, 0x44, 0x80, 0xe8, 0x42, 0x64, 0xe6, 0x0a, 0x4b, 0x94, 0x82, 0x02,
+    0x2f, 0x88, 0x4b, 0x83, 0x08, 0x05, 0x81, 0x2a, 0x0b, 0x1d, 0xc8, 0xe0, 0xbc, 0x4f, 0x90, 0x0d,
+    0x9e, 0x0b, 0x9f, 0xfc, 0x0b, 0x82, 0x4b, 0x8a, 0x6a, 0x31, 0xeb, 0x18, 0x7c, 0x2e, 0xe7, 0x52,
+    0x94, 0x7b, 0x5f, 0xf4, 0x79, 0x20, 0xa6, 0x51, 0x41, 0x51, 0xa8, 0x7f, 0x39, 0x85, 0xe2, 0xc4,
+    0x64, 0x4b, 0x36, 0x15, 0xe5, 0x1b, 0xac, 0x9a, 0x54, 0x8c, 0x2b, 0x15, 0x46, 0x15, 0x23, 0xa7,
+    0xa2, 0x24, 0x50, 0x2f, 0x53, 0x3a, 0x34, 0x1a, 0xd0, 0x26, 0x83, 0xd8, 0x78, 0xac, 0x63, 0x4c,
+    0x0b, 0x88, 0xdf, 0x61, 0x8a, 0x29, 0x68, 0x02, 0x01, 0xea, 0x44, 0x52, 0xbb, 0x4a, 0xed, 0x0c,
+    0xe5, 0x55, 0x2d, 0x88, 0xf2, 0xec, 0x81, 0x1f, 0xe5, 0x9c, 0x70, 0xb6, 0xb3, 0xe9, 0xcb, 0xce,
+    0x7e, 0xc1, 0x31, 0x22, 0xf6, 0x26, 0xca, 0x5f, 0xc0, 0x2d, 0xa2, 0x2a, 0xc6, 0xc4, 0xc6, 0xdb,
+    0x32, 0xca, 0x90, 0x8d, 0xb2, 0x35, 0x8a, 0x6d, 0xb2, 0xfe, 0x15, 0x42, 0x75, 0xbf, 0xef, 0x0c,
+    0xc7, 0x71, 0x8a, 0x56, 0xba, 0xc7, 0x75, 0x4a, 0x36, 0xcf, 0x42, 0xa4, 0x10, 0x57, 0x67, 0xd1,
+    0x41, 0xaf, 0x6a, 0x1e, 0x7d, 0x95, 0x6d, 0xc5, 0x68, 0x64, 0xc4, 0xb7, 0x71, 0x5e, 0x54, 0xcc,
+    0x96, 0x79, 0xc0, 0x26, 0x05, 0xdb, 0x95, 0xa4, 0x2a, 0x6c, 0x6e, 0x43, 0x88, 0x28, 0x91, 0x98,
+    0xce, 0xee, 0x9a, 0x3c, 0xf3, 0xc0, 0x4e, 0xeb, 0x05, 0xc7, 0xd2, 0xed, 0x29, 0x10, 0xf8, 0xb1,
+    0x8b, 0x2a, 0x48, 0x35, 0xb9, 0x3b, 0x33, 0xfa, 0x9c, 0xc3, 0x5f, 0xf1, 0x14, 0xc7, 0x95, 0xc9,
+    0x63, 0xbd, 0xf7, 0x15, 0x7b, 0x69, 0x35, 0x75, 0xb2, 0x78, 0x1a, 0x4e, 0x64, 0x7f, 0x7c, 0xbd,
+    0x65, 0x74, 0x95, 0x7a, 0x87, 0x98, 0x8e, 0x3e, 0x65, 0xb0, 0xee, 0x30, 0x24, 0xae, 0xcf, 0xf6,
+    0x27, 0xbe, 0x22, 0x3e, 0xf3, 0x43, 0x3c, 0x35, 0x1f, 0x97, 0x02, 0xd5, 0x43, 0x02, 0xf8, 0x2f,
+    0x30, 0xb8, 0x5a, 0x65, 0x6c, 0x47, 0x1e, 0x06, 0x82, 0x1b, 0x46, 0x25, 0x0b, 0x03, 0x0f, 0x22,
+    0xfe, 0x80, 0x1d, 0xd5, 0xe1, 0xa2, 0xc2, 0xa3, 0x3c, 0x0e, 0xa7, 0x02, 0x0c, 0xde, 0xb6, 0x41,
+    0x89, 0xd0, 0xa4, 0x6e, 0xc7, 0x2e, 0x07, 0xbc, 0xa9, 0x4a, 0x9e, 0x8c, 0x44, 0x26, 0x3d, 0x19,
+    0x67, 0x99, 0xaa, 0x55, 0xec, 0x51, 0x32, 0x7c, 0x18, 0x41, 0x7d, 0x9b, 0x46, 0x6b, 0x1b, 0xf6,
+    0xcb, 0xfc, 0xff, 0xf1, 0xb8, 0xee, 0x8a, 0xbd, 0x00, 0x87, 0x9d, 0x0f, 0x30, 0x98, 0xf2, 0xad,
+    0x99, 0xf7, 0xde, 0x36, 0x32, 0x20, 0x94, 0x4e, 0x8d, 0xef, 0xc2, 0x5a, 0xe5, 0x91, 0x45, 0xaf,
+    0x18, 0xd0, 0x5a, 0x27, 0x0c, 0x0a, 0x15, 0xf5, 0x26, 0x31, 0x52, 0x43, 0x93, 0xdc, 0xa2, 0xa2,
+    0x80, 0xb6, 0x28, 0xdf, 0xa8, 0xd5, 0xd9, 0xf2, 0xc4, 0xbc, 0x32, 0x8f, 0x60, 0x56, 0xa1, 0x90,
+    0x46, 0xe0, 0x2f, 0xb0, 0x6f, 0xad, 0xa1, 0xa2, 0x6e, 0x2a, 0x98, 0x34, 0x91, 0xf9, 0x46, 0xae,
+    0x4b, 0x9d, 0x6a, 0xba, 0xfc, 0x82, 0x15, 0x76, 0x0d, 0xac, 0x09, 0x11, 0xca, 0xb0, 0xdb, 0x14,
+    0x1d, 0x86, 0xb0, 0xce, 0x16, 0xa3, 0x34, 0xa6, 0xce, 0xbe, 0xe4, 0xca, 0x95, 0xb5, 0x59, 0xc4,
+    0x5d, 0x16, 0xae, 0x67, 0x59, 0x44, 0x83, 0x61, 0x9c, 0x73, 0x84, 0xa1, 0x4a, 0xe9, 0x77, 0xb3,
+    0x40, 0x5e, 0x60, 0xc9, 0x83, 0x3c, 0x31, 0xec, 0x5b, 0x1f, 0xe3, 0x48, 0x20, 0x05, 0x3e, 0xaa,
+    0x18, 0xce, 0x2b, 0x98, 0xa0, 0xc7, 0x98, 0x28, 0x38, 0x00, 0xcc, 0xe8, 0xa3, 0x3d, 0xa5, 0x10,
+    0xc3, 0xdf, 0xc4, 0x09, 0x2e, 0x11, 0x63, 0xa8, 0x57, 0x07, 0xd8, 0x44, 0xf2, 0x81, 0x1a, 0x02,
+    0x43, 0x0e, 0x80, 0x42, 0x5b, 0x56, 0xe3, 0xf2, 0x6c, 0x4f, 0x38, 0xa3, 0x19, 0xb2, 0x9b, 0xea,
+    0xec, 0x58, 0xa0, 0xaf, 0x65, 0x03, 0xac, 0x7b, 0xf1, 0x05, 0x7e, 0x8f, 0x98, 0xfe, 0x80, 0x9c,
+    0x99, 0x61, 0x06, 0xe5, 0x9b, 0xe1, 0xd9, 0x12, 0x3e, 0xb4, 0xe4, 0x2f, 0x01, 0xf5, 0x78, 0x70,
+    0x9e, 0x8b, 0x50, 0x08, 0x7e, 0xaf, 0xd0, 0x66, 0x4a, 0x69, 0x71, 0x90, 0x37, 0xaf, 0xe0, 0x3e,
+    0x25, 0x90, 0xb5, 0x50, 0xfe, 0x59, 0x8d, 0x01, 0x06, 0xc7, 0x46, 0x8a, 0xf6, 0x75, 0x95, 0x33,
+    0x9c, 0x42, 0x06, 0x86, 0xf8, 0x09, 0x01, 0xac, 0x59, 0x27, 0x7c, 0xfc, 0x7f, 0xc6, 0x19, 0x8f,
+    0x24, 0x11, 0xd4, 0xb9, 0x7a, 0x7f, 0xb4, 0x21, 0x40, 0xca, 0x61, 0xdd, 0xd3, 0x95, 0xa2, 0x54,
+    0xc0, 0x8e, 0xc5, 0x2d, 0x8a, 0xab, 0xb3, 0x7a, 0xfd, 0x82, 0x29, 0x5e, 0x73, 0xf2, 0xb1, 0xcd,
+    0xf4, 0xae, 0x20, 0xa6, 0x9d, 0x46, 0x45, 0x3a, 0xb9, 0xd1, 0x1a, 0xaa, 0x33, 0x18, 0x42, 0xdd,
+    0xd4, 0x20, 0x9a, 0x72, 0x72, 0xb7, 0xf8, 0x80, 0xe2, 0xb6, 0x41, 0x7c, 0x9e, 0x5c, 0x5d, 0xa3,
+    0xd4, 0xe7, 0x55, 0x8b, 0xcb, 0x4b, 0x6b, 0xff, 0x97, 0x8f, 0x81, 0xa8, 0x54, 0x20, 0x5e, 0x01,
+    0x5a, 0x94, 0xef, 0x41, 0x5d, 0xb6, 0xe7, 0x12, 0xb2, 0xfc, 0x52, 0x49, 0x66, 0xfc, 0x21, 0x18,
+    0x9f, 0xdc, 0xec, 0xe0, 0x70, 0x73, 0x75, 0x63, 0xb0, 0xb4, 0xa0, 0x9b, 0x31, 0xc7, 0xd7, 0x0d,
+    0x5c, 0xec, 0x25, 0x19, 0xfe, 0x58, 0xe0, 0x82, 0x5b, 0xb8, 0x40, 0xe2, 0xa6, 0xb7, 0x70, 0x53,
+    0x89, 0xf3, 0x6f, 0x0a, 0xf4, 0x85, 0xc4, 0x75, 0xab, 0xa1, 0x2a, 0xda, 0x06, 0x95, 0x5c, 0xb7,
+    0x4a, 0x5e, 0x81, 0x2a, 0xa9, 0xd3, 0x3b, 0xa0, 0x53, 0x09, 0x9d, 0xdf, 0x01, 0x9d, 0x4b, 0xe8,
+    0xf2, 0x0e, 0xe8, 0x12, 0xa0, 0x62, 0xb1, 0xd6, 0xdd, 0x7a, 0xcb, 0xe5, 0xe1, 0xbb, 0xa1, 0x89,
+    0x58, 0xee, 0xaa, 0xc0, 0xde, 0x85, 0x9b, 0xc4, 0x93, 0x9b, 0x38, 0xb3, 0xda, 0x3c, 0x9a, 0xea,
+    0xf5, 0x36, 0x1b, 0x73, 0x08, 0x58, 0xfb, 0x0a, 0x46, 0x58, 0x1a, 0x40, 0xf3, 0xab, 0x20, 0x31,
+    0x44, 0x9e, 0xaa, 0x1c, 0xba, 0xe1, 0x07, 0xbe, 0x9d, 0xbc, 0xe5, 0x79, 0x2f, 0xc9, 0xc9, 0xdd,
+    0x83, 0x2e, 0xb2, 0x50, 0x1c, 0x52, 0x65, 0xcf, 0x55, 0x19, 0x86, 0x08, 0x4d, 0xf6, 0x5c, 0x93,
+    0x2b, 0x98, 0xb9, 0xc0, 0x6c, 0x2b, 0xd8, 0x27, 0xb4, 0x55, 0x29, 0xe8, 0xc6, 0xab, 0x54, 0x7e,
+    0xf2, 0x68, 0xd4, 0xab, 0x92, 0xb5, 0x73, 0x2e, 0x39, 0xd6, 0xc8, 0x2c, 0xbe, 0x02, 0xcc, 0xe2,
+    0xb1, 0x9c, 0x10, 0x70, 0x3f, 0xfe, 0x23, 0xf4, 0xd5, 0x27, 0x14, 0x42, 0xfb, 0xba, 0xf9, 0x8d,
+    0x93, 0xcd, 0x0b, 0x4b, 0xb9, 0x42, 0xcf, 0xae, 0x31, 0x2d, 0x07, 0x16, 0xac, 0xb5, 0x6a, 0x48,
+    0xaa, 0xbb, 0xee, 0xfd, 0xe7, 0xf8, 0x02, 0xf1, 0x08, 0x5a, 0x88, 0xaf, 0x2d, 0x6c, 0x96, 0xea,
+    0xe6, 0xb7, 0x96, 0x5f, 0x5f, 0x83, 0xda, 0xe3, 0x3e, 0xe9, 0x78, 0x4e, 0x7a, 0x35, 0x48, 0xf2,
+    0xf6, 0xb3, 0x4f, 0x00, 0x26, 0x88, 0x5b, 0xc6, 0x01, 0x62, 0x2d, 0x3f, 0x78, 0x28, 0x92, 0x48,
+    0xb3, 0x71, 0xcc, 0x23, 0x16, 0xaf, 0x8e, 0x74, 0x91, 0x04, 0x5e, 0x9f, 0x28, 0x3b, 0x41, 0x88,
+    0x94, 0x66, 0x8a, 0x71, 0x89, 0xd4, 0x59, 0x21, 0xc4, 0xbe, 0x2c, 0x07, 0xa7, 0x86, 0xbd, 0x0c,
+    0x75, 0x36, 0x10, 0x6f, 0xa1, 0x0e, 0x11, 0x85, 0x8e, 0xd8, 0xde, 0xd0, 0x50, 0x92, 0x34, 0x40,
+    0x94, 0x95, 0x9d, 0x76, 0x21, 0x4f, 0x90, 0x4f, 0x2e, 0x3f, 0x0c, 0xc2, 0xdb, 0xa3, 0xb3, 0x46,
+    0x6c, 0xcf, 0x9d, 0x51, 0x7f, 0xf3, 0x29, 0xe4, 0x7b, 0x36, 0x79, 0x6b, 0xab, 0x5a, 0x5b, 0xb8,
+    0xea, 0xb5, 0x8f, 0xd6, 0x3d, 0xef, 0xa2, 0x02, 0x82, 0x08, 0xfc, 0x3b, 0x18, 0x3a, 0x38, 0x62,
+    0x32, 0x88, 0x98, 0x28, 0xc4, 0x7c, 0x10, 0x01, 0xce, 0xab, 0x12, 0x96, 0xab, 0x2f, 0x96, 0x83,
+    0x6f, 0x44, 0xee, 0x0a, 0x61, 0x27, 0xcf, 0x9c, 0x4d, 0x82, 0x53, 0x5e, 0xc5, 0x0e, 0x5c, 0x3d,
+    0xeb, 0xf0, 0xc2, 0xd7, 0xbe, 0x2a, 0xbc, 0x45, 0x2f, 0x97, 0xd5, 0xfd, 0xd0, 0xce, 0x6e, 0x57,
+    0xd2, 0x78, 0xdc, 0x95, 0xc4, 0x4b, 0xf2, 0x6b, 0x72, 0xe4, 0xa1, 0xb7, 0xe5, 0x58, 0xc3, 0x02,
+    0xcf, 0xc7, 0x35, 0xf9, 0x9d, 0xc6, 0x35, 0xf9, 0x42, 0xe3, 0x9a, 0xdc, 0x39, 0x2e, 0x57, 0xec,
+    0xc3, 0x10, 0xaf, 0xa4, 0xcc, 0xdd, 0x97, 0xbc, 0x26, 0x68, 0x5a, 0x65, 0x40, 0xea, 0x42, 0x26,
+    0xee, 0xd4, 0x0b, 0x96, 0x01, 0x9a, 0x2c, 0x61, 0xbb, 0xd3, 0x00, 0xd3, 0x5d, 0x0f, 0x26, 0x3b,
+    0x6f, 0x4e, 0xf2, 0x79, 0x7e, 0x10, 0xed, 0x75, 0xe7, 0x8d, 0x41, 0xa3, 0xa2, 0x49, 0x1d, 0xeb,
+    0x2d, 0x61, 0x7b, 0xea, 0xe6, 0xea, 0x33, 0x57, 0xf0, 0xe4, 0xe6, 0xf8, 0x95, 0x67, 0xa3, 0xbb,
+    0xe4, 0x28, 0xa8, 0x14, 0x17, 0x98, 0xe2, 0xd4, 0x6d, 0x5c, 0xdd, 0x39, 0x0b, 0xd1, 0x71, 0xd3,
+    0xbc, 0xaf, 0x6b, 0xf4, 0x6f, 0x6e, 0xd0, 0x86, 0x79, 0x34, 0xa2, 0xc7, 0x33, 0xb9, 0xc9, 0x33,
+    0xe9, 0xf2, 0xa8, 0x8b, 0xcd, 0x6b, 0x4c, 0x0a, 0xd2, 0x72, 0xa9, 0x4b, 0xdb, 0x61, 0x1e, 0x05,
+    0xe0, 0x1c, 0x3b, 0x63, 0xfc, 0xfd, 0xad, 0xf9, 0x90, 0x0d, 0x76, 0xfa, 0xb2, 0xef, 0x3a, 0x8b,
+    0x02, 0x69, 0x0e, 0x79, 0x9b, 0x7b, 0x8b, 0x45, 0xa2, 0x4c, 0x9e, 0x9b, 0xaa, 0x35, 0x30, 0xc9,
+    0x25, 0x6f, 0xb6, 0xaf, 0xb3, 0x48, 0x8c, 0xc4, 0x8b, 0xfb, 0xc0, 0xeb, 0x70, 0x01, 0x01, 0x34,
+    0x8f, 0x90, 0x7a, 0x7f, 0x39, 0x14, 0x25, 0x0b, 0xa8, 0xc0, 0xae, 0x61, 0xa6, 0x02, 0x33, 0xbf,
+    0x8a, 0xe1, 0x85, 0x40, 0x71, 0x68, 0x3b, 0xd3, 0xc5, 0xed, 0x60, 0x9f, 0x87, 0xb6, 0xd3, 0x6b,
+    0xd8, 0xa9, 0xc4, 0xce, 0xef, 0xc1, 0x0a, 0x1d, 0xc0, 0x85, 0x7b, 0xfb, 0xb0, 0xa1, 0xf4, 0x01,
+    0xd0, 0xe5, 0x1d, 0x50, 0x5e, 0x23, 0x16, 0xa5, 0xe3, 0x7b, 0x0d, 0x76, 0xb8, 0xc8, 0xf7, 0xf9,
+    0x04, 0x89, 0x43, 0x03, 0x95, 0xdc, 0x8c, 0x03, 0x04, 0x9d, 0xd7, 0xe4, 0x1d, 0x28, 0xda, 0x32,
+    0xb3, 0x91, 0x7f, 0xab, 0x26, 0x21, 0xdd, 0x6c, 0x13, 0x04, 0x48, 0xe5, 0xfa, 0x96, 0xa9, 0xbe,
+    0x76, 0x0d, 0xa6, 0x84, 0x4c, 0x0e, 0xe6, 0xc1, 0xad, 0x0a, 0x33, 0xaa, 0x61, 0xdc, 0x39, 0x96,
+    0x6d, 0x42, 0x50, 0x8a, 0x22, 0x3e, 0x3a, 0xbb, 0x0b, 0xee, 0x5c, 0x9a, 0x8e, 0xb5, 0xf8, 0x74,
+    0x77, 0x59, 0x3a, 0x04, 0xcc, 0xbb, 0x85, 0xf7, 0xae, 0x81, 0x1b, 0xd9, 0x34, 0xbb, 0x2c, 0x9b,
+    0x66, 0xf7, 0xcb, 0xee, 0x5d, 0x4e, 0x37, 0xb2, 0x87, 0xac, 0xf2, 0x88, 0x51, 0x86, 0x6c, 0x72,
+    0xa0, 0x03, 0xb2, 0xe9, 0x03, 0xb2, 0xe9, 0x99, 0x6c, 0x21, 0x93, 0x9f, 0x10, 0xd6, 0x67, 0x4f,
+    0xda, 0x8c, 0xb9, 0x37, 0x2e, 0xa3, 0xc7, 0xab, 0x3b, 0x30, 0xda, 0x9d, 0xc4, 0x85, 0xf7, 0x3d,
+    0x92, 0x25, 0xf2, 0x96, 0x6c, 0x85, 0x52, 0xd2, 0xf5, 0xad, 0xf9, 0x3d, 0xf2, 0x35, 0xf6, 0x56,
+    0x0f, 0x0d, 0x4e, 0x59, 0x5d, 0xbf, 0xe1, 0xa8, 0x07, 0x83, 0xb9, 0xd7, 0x81, 0xce, 0x87, 0xa1,
+    0xf3, 0x1e, 0x74, 0x31, 0x0c, 0x5d, 0xf4, 0xa0, 0x4f, 0xc3, 0xd0, 0x27, 0x13, 0xaa, 0x93, 0xc3,
+    0xf5, 0x8c, 0x60, 0x80, 0x17, 0x57, 0xc0, 0x86, 0x12, 0xea, 0x29, 0x53, 0x7d, 0x39, 0x6d, 0xcc,
+    0xbb, 0xc0, 0xc5, 0x20, 0xd0, 0x90, 0x28, 0x53, 0xcc, 0x70, 0x5e, 0x91, 0x4f, 0x1a, 0xeb, 0xee,
+    0xf3, 0x46, 0xfe, 0x63, 0xc4, 0x77, 0x80, 0x30, 0x8b, 0x38, 0x85, 0x68, 0x67, 0x14, 0x38, 0x69,
+    0x55, 0x1a, 0x3b, 0x9c, 0xf6, 0xb9, 0xa5, 0x41, 0xd4, 0x6f, 0x2d, 0x0d, 0x52, 0xf3, 0xd0, 0xd2,
+    0xa0, 0xb5, 0xaf, 0x2c, 0x0d, 0xa2, 0xec, 0xdc, 0xdc, 0x43, 0xa9, 0xa7, 0x94, 0x26, 0x89, 0xbf,
+    0xa3, 0x34, 0xbe, 0x8d, 0x07, 0x8f, 0x7c, 0xaf, 0x25, 0x55, 0xae, 0xff, 0x0f, 0x35, 0x6f, 0x1f,
+    0x85, 0xd4, 0xc6, 0xfb, 0x10, 0xf5, 0xfe, 0xf8, 0x28, 0x4f, 0xdc, 0xed, 0x7e, 0xb9, 0x60, 0x9b,
+    0xb5, 0x96, 0xad, 0xee, 0xc5, 0xd4, 0x57, 0xef, 0x9e, 0x55, 0x51, 0xc1, 0x32, 0xa9, 0xb8, 0x68,
+    0x7d, 0x46, 0xb6, 0x1e, 0x63, 0xcc, 0x9f, 0x22, 0x3b, 0xfc, 0xb9, 0x71, 0x8f, 0xf4, 0x02, 0x0a,
+    0x77, 0x29, 0x8c, 0xd8, 0xea, 0x62, 0xc1, 0x6e, 0xcf, 0x41, 0xed, 0x66, 0x23, 0x6d, 0x37, 0x5b,
+    0x6d, 0x5b, 0xda, 0x4d, 0x59, 0x4a, 0xce, 0x87, 0xad, 0x0f, 0x22, 0xf5, 0x43, 0x09, 0x47, 0xd1,
+    0xfb, 0xdf, 0xea, 0x64, 0xc6, 0x56, 0xdb, 0x49, 0xa7, 0x3d, 0x0d, 0xb4, 0x09, 0x18, 0x9a, 0x37,
+    0x15, 0x04, 0xf3, 0x54, 0xec, 0xc0, 0xb6, 0x82, 0x9f, 0x33, 0x5e, 0x79, 0x52, 0xd3, 0x18, 0x1c,
+    0x45, 0x14, 0xd9, 0xdd, 0x0b, 0xd5, 0x61, 0x36, 0xd8, 0xf9, 0x5c, 0x7a, 0xc9, 0xd3, 0xce, 0x9e,
+    0xa2, 0x0c, 0x0b, 0xd4, 0x08, 0x48, 0x00, 0xdf, 0xf2, 0x98, 0x1a, 0x59, 0xa3, 0x84, 0x6b, 0x1f,
+    0x8a, 0x7f, 0xc7, 0xb5, 0x2b, 0x7e, 0xfe, 0x12, 0x9a, 0xfb, 0x01, 0xfe, 0x90, 0x4d, 0x90, 0x6f,
+    0xec, 0x0a, 0x64, 0x44, 0xd4, 0x02, 0x76, 0xed, 0x7b, 0x3d, 0xc5, 0x7c, 0xb3, 0xa4, 0x5e, 0xf4,
+    0x04, 0xe8, 0x57, 0x7c, 0x77, 0xf0, 0xb7, 0xf5, 0xb5, 0xc9, 0xae, 0x5f, 0x2c, 0xde, 0x25, 0xa0,
+    0x8d, 0x7c, 0x4a, 0x44, 0x27, 0x60, 0x2b, 0x19, 0x57, 0xc3, 0xb6, 0xe2, 0x53, 0xe7, 0xf0, 0x92,
+    0xa1, 0xfb, 0xc4, 0x19, 0xb6, 0x6e, 0xd6, 0x04, 0xfe, 0xf7, 0x8c, 0xbd, 0xa8, 0xf1, 0x2a, 0xd9,
+    0x16, 0x17, 0x80, 0x9e, 0xe7, 0x47, 0x63, 0x5b, 0x82, 0x61, 0x73, 0x66, 0x39, 0xfc, 0x97, 0x5b,
+    0xf8, 0x95, 0x71, 0x03, 0x60, 0x44, 0x80, 0xf6, 0xcd, 0xef, 0xd8, 0xee, 0x91, 0x8d, 0x07, 0xc8,
+    0x46, 0xdb, 0xf9, 0x63, 0xe1, 0x7e, 0xe3, 0x19, 0x55, 0x11, 0x4e, 0x3c, 0x39, 0x6f, 0x2a, 0x7a,
+    0xee, 0x3c, 0x82, 0x7c, 0x97, 0xf3, 0x28, 0x01, 0xa2, 0x9f, 0x40, 0xf1, 0x9d, 0x3d, 0xb6, 0xee,
+    0xaa, 0x23, 0x06, 0x63, 0x8f, 0xf9, 0x8b, 0x66, 0xcf, 0x12, 0xa5, 0x33, 0xb7, 0xd9, 0x5f, 0xac,
+    0x8b, 0x23, 0x12, 0x3b, 0xde, 0xf1, 0xb8, 0xdb, 0x26, 0x4d, 0xa9, 0xae, 0x0a, 0xc5, 0xc7, 0x1f,
+    0xc1, 0x9a, 0x1d, 0x5b, 0xf4, 0x4c, 0xd9, 0x7f, 0x97, 0x3e, 0x60, 0x4d, 0x88, 0x58, 0xfc, 0x99,
+    0x43, 0xfc, 0x0b, 0xbf, 0x67, 0xa5, 0xd0, 0x96, 0x13, 0x5e, 0xfa, 0xa7, 0x64, 0x8f, 0xe2, 0x50,
+    0x37, 0xd6, 0xb2, 0x2d, 0x34, 0xda, 0x4c, 0x4e, 0x15, 0x58, 0xf9, 0x32, 0x6c, 0x38, 0xf4, 0x2d,
+    0xae, 0x3b, 0x3b, 0x9d, 0xbe, 0xd5, 0xc9, 0xc0, 0xea, 0x1f, 0x75, 0xd6, 0xf4, 0x98, 0xb3, 0xe8,
+    0x10, 0xbe, 0xfb, 0xf0, 0x6e, 0xa5, 0xee, 0x38, 0x69, 0xb8, 0x8d, 0x52, 0x8a, 0x56, 0xea, 0x55,
+    0xbb, 0xbc, 0x1a, 0x0d, 0xbd, 0x61, 0x21, 0xc7, 0x2f, 0x21, 0xe4, 0xf5, 0xed, 0x42, 0xf4, 0xc9,
+    0xeb, 0xb0, 0x84, 0x01, 0x8e, 0xe3, 0xc3, 0x1c, 0xaf, 0xf7, 0x73, 0xc8, 0x63, 0xdd, 0x07, 0xf1,
+    0x0f, 0x68, 0xd4, 0x3b, 0x1e, 0x7b, 0xbb, 0xf9, 0xcc, 0xc3, 0xa7, 0xbb, 0xa5, 0x88, 0x97, 0x83,
+    0x7d, 0x49, 0x46, 0xa5, 0x7e, 0xff, 0x38, 0x78, 0x81, 0xf5, 0x00, 0xba, 0xa9, 0xbf, 0xee, 0xe7,
+    0xd1, 0xe5, 0xd9, 0xfd, 0x1c, 0x4d, 0xf5, 0x76, 0x3f, 0x4b, 0x5b, 0xdc, 0xdd, 0xcf, 0xa3, 0xaa,
+    0xe8, 0xbb, 0xf1, 0x6a, 0x49, 0x3f, 0xe0, 0x23, 0xaa, 0x96, 0x7c, 0x80, 0x83, 0x97, 0x9a, 0xf7,
+    0xc3, 0x8d, 0x4a, 0xf4, 0x4d, 0x4c, 0x32, 0x1c, 0xbe, 0x8d, 0x55, 0xfc, 0x09, 0x50, 0xc3, 0xfa,
+    0x57, 0x40, 0xf1, 0x33, 0x96, 0x68, 0x87, 0xbe, 0xb9, 0xe1, 0xbb, 0xe2, 0x92, 0xea, 0x8a, 0x60,
+    0x71, 0x8f, 0x72, 0xbf, 0xc5, 0x6e, 0x8c, 0xbe, 0xbf, 0xfc, 0x9a, 0x3f, 0xea, 0xb9, 0x28, 0xe7,
+    0x51, 0x83, 0xfc, 0x1e, 0xb6, 0x30, 0x53, 0xe8, 0x6f, 0x1f, 0xd7, 0xf9, 0x9f, 0x75, 0x3d, 0xb2,
+    0x40, 0xfa, 0x7f, 0xf2, 0xf5, 0xa5, 0xc6, 0xd8, 0xe6, 0xe5, 0x07, 0x72, 0x40, 0x5b, 0x0a, 0x7c,
+    0x29, 0xb3, 0xbc, 0x45, 0x8d, 0xb3, 0x52, 0xe6, 0xb7, 0x2b, 0xd3, 0xd6, 0x68, 0x0f, 0x5a, 0xc3,
+    0xac, 0xd8, 0xda, 0xa9, 0x49, 0x51, 0xbe, 0x63, 0xc9, 0x37, 0x0f, 0xe7, 0xf1, 0xfe, 0x9f, 0xc7,
+    0xdd, 0x3d, 0x30, 0xfe, 0xb7, 0x31, 0xd7, 0xa4, 0xbd, 0xdd, 0x4e, 0xcf, 0xe8, 0x28, 0x1e, 0x6d,
+    0x52, 0x4b, 0xdc, 0xc1, 0x32, 0x62, 0x5c, 0xfd, 0xca, 0x70, 0x3f, 0x9a, 0xcc, 0xbd, 0x18, 0xed,
+    0xa0, 0xb2, 0xfe, 0xd3, 0x7f, 0x01, 0x4e, 0x03, 0x0d, 0x0a, 0x3c, 0x3c, 0x00, 0x00,
+};
+const size_t web_app_C441XP1K_css_gz_len = 3822;
+
+// index.html (gzipped)
+const uint8_t web_index_html_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x55, 0x91, 0xc1, 0x4e, 0xc3, 0x30,
+    0x0c, 0x86, 0xef, 0x7b, 0x0a, 0x93, 0x33, 0x6d, 0xa9, 0xb4, 0x03, 0x87, 0xa6, 0x97, 0x0a, 0x2e,
+    0x20, 0x98, 0x34, 0x40, 0xe5, 0x18, 0x12, 0x6f, 0x35, 0x4b, 0x93, 0x2a, 0xf1, 0x3a, 0xf5, 0xed,
+    0x49, 0xd7, 0x4d, 0xc0, 0xc9, 0xb6, 0xfc, 0xff, 0x9f, 0x13, 0xbb, 0xba, 0x31, 0x5e, 0xf3, 0x34,
+    0x20, 0x74, 0xdc, 0xdb, 0x7a, 0x55, 0xcd, 0x01, 0xac, 0x72, 0x7b, 0x29, 0xd0, 0x89, 0x7a, 0x05,
+    0x50, 0x75, 0xa8, 0xcc, 0x9c, 0xa4, 0xb4, 0x47, 0x56, 0xa0, 0x3b, 0x15, 0x22, 0xb2, 0x14, 0xef,
+    0x6f, 0x8f, 0xd9, 0xbd, 0x80, 0xe2, 0x6f, 0xd3, 0xa9, 0x1e, 0xa5, 0x18, 0x09, 0x4f, 0x83, 0x0f,
+    0x2c, 0x40, 0x7b, 0xc7, 0xe8, 0x92, 0xf8, 0x44, 0x86, 0x3b, 0x69, 0x70, 0x24, 0x8d, 0xd9, 0xb9,
+    0xb8, 0x05, 0x72, 0xc4, 0xa4, 0x6c, 0x16, 0xb5, 0xb2, 0x28, 0xcb, 0xfc, 0xee, 0x17, 0xc6, 0xc4,
+    0x16, 0xeb, 0xed, 0xeb, 0xf3, 0xc3, 0x47, 0x03, 0x19, 0x34, 0x69, 0x26, 0xb9, 0x3d, 0x6c, 0x3c,
+    0x39, 0x86, 0x26, 0x41, 0x83, 0xb7, 0x16, 0x03, 0x6c, 0x82, 0x1f, 0x29, 0x7a, 0x37, 0x37, 0xb7,
+    0xc8, 0xc7, 0x21, 0xaf, 0x8a, 0xc5, 0xbb, 0x70, 0xa2, 0x0e, 0x34, 0x30, 0xcc, 0x5f, 0x94, 0xa2,
+    0xf7, 0xe6, 0x68, 0x31, 0x3d, 0x2a, 0xf8, 0x18, 0x7d, 0xa0, 0x3d, 0x39, 0x88, 0x41, 0x4b, 0x51,
+    0xa8, 0x61, 0xc8, 0x9b, 0xb2, 0x7f, 0x39, 0x7c, 0xb6, 0x6d, 0xfe, 0x1d, 0x45, 0x5d, 0x15, 0x8b,
+    0xf3, 0x82, 0xb1, 0xe4, 0x0e, 0x10, 0xd0, 0x4a, 0x11, 0x79, 0xb2, 0x18, 0x3b, 0x44, 0xfe, 0xcf,
+    0xe9, 0x02, 0xee, 0xae, 0xa0, 0xf5, 0xba, 0x6c, 0x37, 0xe5, 0x53, 0xae, 0x63, 0x5c, 0x56, 0x58,
+    0x5c, 0x77, 0x58, 0x7d, 0x79, 0x33, 0x5d, 0x98, 0x86, 0x46, 0x20, 0x23, 0x45, 0xb2, 0xcc, 0xf3,
+    0x52, 0xb9, 0x68, 0x17, 0x49, 0xf2, 0x9c, 0x2f, 0xf2, 0x03, 0x04, 0xb6, 0xc8, 0xdf, 0xa2, 0x01,
+    0x00, 0x00,
+};
+const size_t web_index_html_gz_len = 290;
+
+// vite.svg (gzipped)
+const uint8_t web_vite_svg_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x54, 0x4d, 0x8f, 0xdb, 0x36,
+    0x10, 0xfd, 0x2b, 0x04, 0x83, 0x00, 0xed, 0x81, 0x34, 0x87, 0x43, 0x72, 0xc8, 0x60, 0xb5, 0xc0,
+    0x06, 0x1b, 0x17, 0x01, 0x36, 0x97, 0xde, 0xda, 0x9b, 0x2a, 0xcb, 0x6b, 0xa1, 0x5a, 0xcb, 0x90,
+    0x95, 0xf5, 0xe6, 0xdf, 0xf7, 0xd1, 0xce, 0x22, 0x4d, 0xb6, 0x4d, 0x1b, 0x18, 0xa2, 0x29, 0xce,
+    0x9b, 0x8f, 0xf7, 0x66, 0xc4, 0xab, 0xe3, 0xe3, 0xbd, 0x7a, 0x7a, 0x18, 0xf7, 0xc7, 0x46, 0xef,
+    0x96, 0xe5, 0xf0, 0x66, 0xb5, 0x3a, 0x9d, 0x4e, 0xf6, 0xc4, 0x76, 0x9a, 0xef, 0x57, 0xde, 0x39,
+    0xb7, 0x02, 0x42, 0x5f, 0x20, 0x6f, 0x9e, 0xc6, 0x61, 0xff, 0xe7, 0x3f, 0x01, 0xa9, 0x94, 0xb2,
+    0x3a, 0x5b, 0xb5, 0x6a, 0xe7, 0xa1, 0x35, 0xbb, 0x61, 0xb3, 0xe9, 0xf7, 0x8d, 0x5e, 0xe6, 0x8f,
+    0xbd, 0x56, 0xf3, 0x34, 0xf6, 0x8d, 0x1e, 0x1e, 0x10, 0xa8, 0x1b, 0xdb, 0x23, 0x72, 0x0d, 0xdd,
+    0xb4, 0x1f, 0xb6, 0x9f, 0xd4, 0xe7, 0x7f, 0x63, 0xc6, 0xe9, 0x7e, 0x3a, 0x6a, 0x75, 0x1a, 0x36,
+    0xcb, 0xae, 0xd1, 0x4c, 0x36, 0x67, 0xad, 0x76, 0xfd, 0x70, 0xbf, 0x5b, 0xf0, 0xea, 0xb5, 0x3a,
+    0xcc, 0xfd, 0xb1, 0x9f, 0x1f, 0xfb, 0x9b, 0xe3, 0xa1, 0xef, 0x96, 0x5f, 0xdb, 0x65, 0x98, 0x1a,
     0xfd, 0xf4, 0x61, 0xd8, 0xfc, 0x86, 0x47, 0x3d, 0xf4, 0xfd, 0xa2, 0xd5, 0xe3, 0xd0, 0x9f, 0xde,
     0x4e, 0x4f, 0x8d, 0x76, 0xca, 0x29, 0x1f, 0x13, 0x1e, 0xd1, 0xd7, 0x57, 0x9b, 0x7e, 0x7b, 0xbc,
     0xbe, 0x42, 0x75, 0x7d, 0x3b, 0xff, 0x32, 0xb7, 0x9b, 0xa1, 0xdf, 0x2f, 0x6a, 0xd8, 0x34, 0xfa,
@@ -856,30 +880,6 @@ const uint8_t web_vite_svg_gz[] PROGMEM = {
 };
 const size_t web_vite_svg_gz_len = 771;
 
-// index.html (gzipped)
-const uint8_t web_index_html_gz[] PROGMEM = {
-    0x1f, 0x8b, 0x08, 0x00, 0x42, 0xb2, 0xde, 0x68, 0x02, 0xff, 0x55, 0x91, 0xc1, 0x4e, 0xc3, 0x30,
-    0x0c, 0x86, 0xef, 0x7b, 0x0a, 0x93, 0x33, 0x6d, 0xa9, 0xb4, 0x03, 0x87, 0xa6, 0x97, 0x0a, 0x2e,
-    0x20, 0x98, 0x34, 0x40, 0xe5, 0x18, 0x12, 0x6f, 0x35, 0x4b, 0x93, 0x2a, 0xf1, 0x3a, 0xf5, 0xed,
-    0x49, 0xd7, 0x4d, 0xc0, 0xc9, 0xb6, 0xfc, 0xff, 0x9f, 0x13, 0xbb, 0xba, 0x31, 0x5e, 0xf3, 0x34,
-    0x20, 0x74, 0xdc, 0xdb, 0x7a, 0x55, 0xcd, 0x01, 0xac, 0x72, 0x7b, 0x29, 0xd0, 0x89, 0x7a, 0x05,
-    0x50, 0x75, 0xa8, 0xcc, 0x9c, 0xa4, 0xb4, 0x47, 0x56, 0xa0, 0x3b, 0x15, 0x22, 0xb2, 0x14, 0xef,
-    0x6f, 0x8f, 0xd9, 0xbd, 0x80, 0xe2, 0x6f, 0xd3, 0xa9, 0x1e, 0xa5, 0x18, 0x09, 0x4f, 0x83, 0x0f,
-    0x2c, 0x40, 0x7b, 0xc7, 0xe8, 0x92, 0xf8, 0x44, 0x86, 0x3b, 0x69, 0x70, 0x24, 0x8d, 0xd9, 0xb9,
-    0xb8, 0x05, 0x72, 0xc4, 0xa4, 0x6c, 0x16, 0xb5, 0xb2, 0x28, 0xcb, 0xfc, 0xee, 0x17, 0xc6, 0xc4,
-    0x16, 0xeb, 0xed, 0xeb, 0xf3, 0xc3, 0x47, 0x03, 0x19, 0x34, 0x69, 0x26, 0xb9, 0x3d, 0x6c, 0x3c,
-    0x39, 0x86, 0x26, 0x41, 0x83, 0xb7, 0x16, 0x03, 0x6c, 0x82, 0x1f, 0x29, 0x7a, 0x37, 0x37, 0xb7,
-    0xc8, 0xc7, 0x21, 0xaf, 0x8a, 0xc5, 0xbb, 0x70, 0xa2, 0x0e, 0x34, 0x30, 0xcc, 0x5f, 0x94, 0xa2,
-    0xf7, 0xe6, 0x68, 0x31, 0x3d, 0x2a, 0xf8, 0x18, 0x7d, 0xa0, 0x3d, 0x39, 0x88, 0x41, 0x4b, 0x51,
-    0xa8, 0x61, 0xc8, 0x9b, 0xb2, 0x7f, 0x39, 0x7c, 0xb6, 0x6d, 0xfe, 0x1d, 0x45, 0x5d, 0x15, 0x8b,
-    0xf3, 0x82, 0xb1, 0xe4, 0x0e, 0x10, 0xd0, 0x4a, 0x11, 0x79, 0xb2, 0x18, 0x3b, 0x44, 0xfe, 0xcf,
-    0xe9, 0x02, 0xee, 0xae, 0xa0, 0xf5, 0xba, 0x6c, 0x37, 0xe5, 0x53, 0xae, 0x63, 0x5c, 0x56, 0x58,
-    0x5c, 0x77, 0x58, 0x7d, 0x79, 0x33, 0x5d, 0x98, 0x86, 0x46, 0x20, 0x23, 0x45, 0xb2, 0xcc, 0xf3,
-    0x52, 0xb9, 0x68, 0x17, 0x49, 0xf2, 0x9c, 0x2f, 0xf2, 0x03, 0x04, 0xb6, 0xc8, 0xdf, 0xa2, 0x01,
-    0x00, 0x00,
-};
-const size_t web_index_html_gz_len = 290;
-
 
 // Web file lookup structure
 struct WebFile {
@@ -888,15 +888,17 @@ struct WebFile {
     size_t size;
     const char* contentType;
     bool gzipped;
+    const char* etag;           // Quoted hash of the uncompressed content
+    bool immutable;             // Content-hashed name: cache for a year
 };
 
 // Web files array
 const WebFile WEB_FILES[] PROGMEM = {
-    {"/app.C441XP1K.css", web_app_C441XP1K_css_gz, web_app_C441XP1K_css_gz_len, "text/css", true},
-    {"/app.C1mNkYXX.js", web_app_C1mNkYXX_js_gz, web_app_C1mNkYXX_js_gz_len, "application/javascript", true},
-    {"/vite.svg", web_vite_svg_gz, web_vite_svg_gz_len, "image/svg+xml", true},
-    {"/", web_index_html_gz, web_index_html_gz_len, "text/html", true},
-    {"/index.html", web_index_html_gz, web_index_html_gz_len, "text/html", true},
+    {"/app.C1mNkYXX.js", web_app_C1mNkYXX_js_gz, web_app_C1mNkYXX_js_gz_len, "application/javascript", true, "\"60171e2eafe06db7\"", true},
+    {"/app.C441XP1K.css", web_app_C441XP1K_css_gz, web_app_C441XP1K_css_gz_len, "text/css", true, "\"1766b842e8d2d247\"", true},
+    {"/", web_index_html_gz, web_index_html_gz_len, "text/html", true, "\"1211a9d99ed520f0\"", false},
+    {"/index.html", web_index_html_gz, web_index_html_gz_len, "text/html", true, "\"1211a9d99ed520f0\"", false},
+    {"/vite.svg", web_vite_svg_gz, web_vite_svg_gz_len, "image/svg+xml", true, "\"f7f39d7237b791a9\"", false},
 };
 
 const size_t WEB_FILES_COUNT = sizeof(WEB_FILES) / sizeof(WebFile);
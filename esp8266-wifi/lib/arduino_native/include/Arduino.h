@@ -0,0 +1,240 @@
+/**
+ * @file Arduino.h
+ * @brief Host stand-in for the ESP8266 Arduino core ([env:native] only)
+ * @version 1.0.0
+ *
+ * Covers what the native build compiles: utils, STM32Communicator, the
+ * topic builder, the MQTT tap client and offline journal, the config
+ * manager, the OCPP serializers and the handlers without network I/O. Differences from the target:
+ * - millis()/micros() follow the host clock; delay() advances them
+ *   without sleeping, so timeouts in tests pass at once
+ * - ESP.getCycleCount() counts at ESP.getCpuFreqMHz() from the host clock,
+ *   so LoopProfiler and the benchmarks report real host microseconds
+ * - Serial (STM32 link) is an in-memory loopback: feed() queues RX bytes,
+ *   TX bytes are kept for inspection. Serial1 (log output) goes to stdout
+ * - Heap figures are fixed, there is no ESP8266 allocator to query
+ *
+ * ARDUINO is not defined, so tests still take their native main() path.
+ */
+
+#ifndef ARDUINO_NATIVE_H
+#define ARDUINO_NATIVE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <algorithm>
+#include <string>
+#include "pgmspace.h"
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH    1
+#define LOW     0
+
+uint32_t millis();
+uint32_t micros();
+uint64_t micros64();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+/**
+ * @brief Minimal Arduino String (owning, heap-backed)
+ */
+class String {
+private:
+    std::string value;
+
+public:
+    String() {}
+    String(const char* text) : value(text ? text : "") {}
+    String(const std::string& text) : value(text) {}
+    explicit String(int number) : value(std::to_string(number)) {}
+    explicit String(unsigned long number) : value(std::to_string(number)) {}
+
+    const char* c_str() const { return value.c_str(); }
+    unsigned int length() const { return (unsigned int)value.size(); }
+    bool isEmpty() const { return value.empty(); }
+    char charAt(unsigned int index) const { return index < value.size() ? value[index] : '\0'; }
+
+    String substring(unsigned int from, unsigned int to = ~0u) const {
+        if (from >= value.size() || to <= from) return String();
+        return String(value.substr(from, to - from));
+    }
+
+    void replace(const char* find, const char* with) {
+        size_t findLength = strlen(find);
+        if (findLength == 0) return;
+        for (size_t pos = value.find(find); pos != std::string::npos;
+             pos = value.find(find, pos + strlen(with))) {
+            value.replace(pos, findLength, with);
+        }
+    }
+
+    String& operator+=(const char* text) { value += text; return *this; }
+    String& operator+=(const String& other) { value += other.value; return *this; }
+    bool operator==(const char* text) const { return value == text; }
+    bool operator==(const String& other) const { return value == other.value; }
+    bool operator!=(const char* text) const { return value != text; }
+};
+
+/**
+ * @brief Byte sink with printf (Arduino Print)
+ */
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t byte) = 0;
+
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t written = 0;
+        while (written < size && write(buffer[written])) {
+            written++;
+        }
+        return written;
+    }
+
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t write(const char* text) { return text ? write((const uint8_t*)text, strlen(text)) : 0; }
+    size_t print(const char* text) { return write(text); }
+    size_t print(const String& text) { return write(text.c_str()); }
+    size_t println(const char* text = "") { return write(text) + write("\r\n"); }
+    size_t println(const String& text) { return println(text.c_str()); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        char buffer[256];
+        va_list args;
+        va_start(args, format);
+        int length = vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+        if (length <= 0) return 0;
+        if ((size_t)length >= sizeof(buffer)) length = sizeof(buffer) - 1;
+        return write((const uint8_t*)buffer, (size_t)length);
+    }
+};
+
+/**
+ * @brief Readable byte source (Arduino Stream)
+ */
+class Stream : public Print {
+protected:
+    unsigned long timeout = 1000;
+
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    virtual size_t readBytes(char* buffer, size_t length) {
+        size_t count = 0;
+        while (count < length) {
+            int c = read();
+            if (c < 0) break;
+            buffer[count++] = (char)c;
+        }
+        return count;
+    }
+
+    virtual size_t readBytes(uint8_t* buffer, size_t length) {
+        return readBytes((char*)buffer, length);
+    }
+
+    void setTimeout(unsigned long ms) { timeout = ms; }
+};
+
+/**
+ * @brief UART stand-in
+ *
+ * Port 0 (Serial) buffers both directions in memory; port 1 (Serial1,
+ * TX-only on the ESP8266) writes to stdout.
+ */
+class HardwareSerial : public Stream {
+private:
+    uint8_t port;
+    std::string rx;
+    size_t rxPos;
+    std::string tx;
+    size_t rxBufferSize;
+    uint32_t baud;
+
+public:
+    explicit HardwareSerial(uint8_t uart)
+        : port(uart), rxPos(0), rxBufferSize(256), baud(0) {}
+
+    void begin(uint32_t baudRate) { baud = baudRate; }
+    void end() {}
+    void updateBaudRate(uint32_t baudRate) { baud = baudRate; }
+    uint32_t baudRate() const { return baud; }
+    size_t setRxBufferSize(size_t size) { rxBufferSize = size; return size; }
+    bool hasOverrun() { return false; }
+    void swap() {}
+    void setDebugOutput(bool) {}
+
+    int available() override { return (int)(rx.size() - rxPos); }
+    int read() override { return rxPos < rx.size() ? (uint8_t)rx[rxPos++] : -1; }
+    int peek() override { return rxPos < rx.size() ? (uint8_t)rx[rxPos] : -1; }
+
+    size_t readBytes(char* buffer, size_t length) override {
+        size_t count = std::min(length, rx.size() - rxPos);
+        memcpy(buffer, rx.data() + rxPos, count);
+        rxPos += count;
+        return count;
+    }
+    using Stream::readBytes;
+
+    size_t write(uint8_t byte) override { return write(&byte, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    int availableForWrite() override { return 256; }
+
+    /**
+     * @brief Queue bytes as if the peer had sent them (native only)
+     */
+    void feed(const uint8_t* data, size_t length) {
+        if (rxPos == rx.size()) {
+            rx.clear();
+            rxPos = 0;
+        }
+        rx.append((const char*)data, length);
+    }
+
+    /**
+     * @brief Bytes written so far (native only)
+     */
+    const std::string& sent() const { return tx; }
+    void clearSent() { tx.clear(); }
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+
+/**
+ * @brief ESP8266 system calls used by the firmware
+ */
+class EspClass {
+public:
+    uint32_t getCycleCount();
+    uint8_t getCpuFreqMHz() { return 80; }
+    uint32_t getChipId() { return 0x00C0FFEE; }
+    uint32_t getFreeHeap() { return 40000; }
+    uint8_t getHeapFragmentation() { return 0; }
+    uint32_t getMaxFreeBlockSize() { return 40000; }
+    void wdtFeed() {}
+    bool rtcUserMemoryRead(uint32_t, uint32_t*, size_t) { return false; }
+    bool rtcUserMemoryWrite(uint32_t, uint32_t*, size_t) { return true; }
+    void restart() { exit(0); }
+};
+
+extern EspClass ESP;
+
+#endif // ARDUINO_NATIVE_H
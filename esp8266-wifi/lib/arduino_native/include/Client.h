@@ -0,0 +1,35 @@
+/**
+ * @file Client.h
+ * @brief Arduino network Client interface for host builds
+ *
+ * Same pure virtuals as the ESP8266 core (flush/stop take a wait time
+ * and return bool), so Client wrappers such as MQTTTapClient build and
+ * can be driven by scripted clients in tests. No network behind it.
+ */
+
+#ifndef ARDUINO_NATIVE_CLIENT_H
+#define ARDUINO_NATIVE_CLIENT_H
+
+#include "Arduino.h"
+#include "IPAddress.h"
+
+class Client : public Stream {
+public:
+    virtual int connect(IPAddress ip, uint16_t port) = 0;
+    virtual int connect(const char* host, uint16_t port) = 0;
+    virtual size_t write(uint8_t byte) = 0;
+    virtual size_t write(const uint8_t* buf, size_t size) = 0;
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int read(uint8_t* buf, size_t size) = 0;
+    virtual int peek() = 0;
+    virtual bool flush(unsigned int maxWaitMs = 0) = 0;
+    virtual bool stop(unsigned int maxWaitMs = 0) = 0;
+    virtual uint8_t connected() = 0;
+    virtual operator bool() = 0;
+
+    void flush() override { flush(0); }
+    using Print::write;
+};
+
+#endif // ARDUINO_NATIVE_CLIENT_H
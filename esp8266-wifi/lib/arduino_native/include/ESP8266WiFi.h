@@ -0,0 +1,22 @@
+/**
+ * @file ESP8266WiFi.h
+ * @brief WiFi stand-in for host builds: station MAC only
+ *
+ * Lets config helpers that derive names from the MAC compile and run;
+ * there is no radio, scanning or connection state behind it.
+ */
+
+#ifndef ARDUINO_NATIVE_ESP8266WIFI_H
+#define ARDUINO_NATIVE_ESP8266WIFI_H
+
+#include "Arduino.h"
+#include "IPAddress.h"
+
+class ESP8266WiFiClass {
+public:
+    String macAddress() { return String("5C:CF:7F:C0:FF:EE"); }
+};
+
+extern ESP8266WiFiClass WiFi;
+
+#endif // ARDUINO_NATIVE_ESP8266WIFI_H
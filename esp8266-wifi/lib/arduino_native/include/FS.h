@@ -0,0 +1,143 @@
+/**
+ * @file FS.h
+ * @brief In-memory filesystem for host builds
+ *
+ * Files live in a map for the lifetime of the process; format() clears
+ * it. Open modes "r", "w" and "a" as on LittleFS. Writes go straight to
+ * the file, so a File left open behaves like one that was flushed.
+ */
+
+#ifndef ARDUINO_NATIVE_FS_H
+#define ARDUINO_NATIVE_FS_H
+
+#include "Arduino.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs {
+
+enum SeekMode {
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+typedef std::shared_ptr<std::vector<uint8_t>> FileData;
+
+class File : public Stream {
+private:
+    FileData data;
+    size_t pos;
+    bool writable;
+    std::string path;
+
+public:
+    File() : pos(0), writable(false) {}
+    File(FileData contents, size_t start, bool canWrite, const std::string& name)
+        : data(contents), pos(start), writable(canWrite), path(name) {}
+
+    explicit operator bool() const { return (bool)data; }
+
+    size_t read(uint8_t* buffer, size_t length) {
+        if (!data || pos >= data->size()) return 0;
+        size_t count = std::min(length, data->size() - pos);
+        memcpy(buffer, data->data() + pos, count);
+        pos += count;
+        return count;
+    }
+
+    int read() override {
+        uint8_t byte;
+        return read(&byte, 1) ? byte : -1;
+    }
+
+    int peek() override { return (data && pos < data->size()) ? (*data)[pos] : -1; }
+    int available() override { return data ? (int)(data->size() - std::min(pos, data->size())) : 0; }
+
+    size_t readBytes(char* buffer, size_t length) override { return read((uint8_t*)buffer, length); }
+    using Stream::readBytes;
+
+    size_t write(const uint8_t* buffer, size_t length) override {
+        if (!data || !writable) return 0;
+        if (data->size() < pos + length) data->resize(pos + length);
+        memcpy(data->data() + pos, buffer, length);
+        pos += length;
+        return length;
+    }
+
+    size_t write(uint8_t byte) override { return write(&byte, 1); }
+    using Print::write;
+
+    bool seek(uint32_t offset, SeekMode mode = SeekSet) {
+        if (!data) return false;
+        size_t base = (mode == SeekSet) ? 0 : (mode == SeekCur) ? pos : data->size();
+        pos = base + offset;
+        return pos <= data->size();
+    }
+
+    bool truncate(uint32_t size) {
+        if (!data || !writable) return false;
+        data->resize(size);
+        if (pos > size) pos = size;
+        return true;
+    }
+
+    size_t position() const { return pos; }
+    size_t size() const { return data ? data->size() : 0; }
+    const char* name() const { return path.c_str(); }
+    void flush() override {}
+    void close() { data.reset(); }
+};
+
+class FS {
+private:
+    std::map<std::string, FileData> files;
+
+public:
+    bool begin() { return true; }
+    void end() {}
+    bool format() { files.clear(); return true; }
+
+    bool exists(const char* path) const { return files.count(path) > 0; }
+
+    File open(const char* path, const char* mode) {
+        std::string name(path);
+        if (mode[0] == 'r') {
+            auto it = files.find(name);
+            if (it == files.end()) return File();
+            return File(it->second, 0, mode[1] == '+', name);
+        }
+
+        FileData& contents = files[name];
+        if (!contents || mode[0] == 'w') {
+            contents = std::make_shared<std::vector<uint8_t>>();
+        }
+        return File(contents, mode[0] == 'a' ? contents->size() : 0, true, name);
+    }
+
+    bool remove(const char* path) { return files.erase(path) > 0; }
+
+    bool rename(const char* from, const char* to) {
+        auto it = files.find(from);
+        if (it == files.end()) return false;
+        FileData contents = it->second;
+        files.erase(it);
+        files[to] = contents;
+        return true;
+    }
+
+    bool mkdir(const char*) { return true; }
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
+
+#endif // ARDUINO_NATIVE_FS_H
@@ -0,0 +1,43 @@
+/**
+ * @file IPAddress.h
+ * @brief IPv4 address for host builds (Client.h, config validation)
+ */
+
+#ifndef ARDUINO_NATIVE_IPADDRESS_H
+#define ARDUINO_NATIVE_IPADDRESS_H
+
+#include "Arduino.h"
+
+class IPAddress {
+private:
+    uint8_t bytes[4];
+
+public:
+    IPAddress() : bytes{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : bytes{a, b, c, d} {}
+
+    uint8_t operator[](int index) const { return bytes[index]; }
+    bool isSet() const { return bytes[0] | bytes[1] | bytes[2] | bytes[3]; }
+
+    /**
+     * @brief Parse dotted-quad "a.b.c.d"
+     */
+    bool fromString(const char* text) {
+        uint8_t parsed[4];
+        for (uint8_t part = 0; part < 4; part++) {
+            if (*text < '0' || *text > '9') return false;
+            unsigned value = 0;
+            while (*text >= '0' && *text <= '9') {
+                value = value * 10 + (unsigned)(*text++ - '0');
+                if (value > 255) return false;
+            }
+            parsed[part] = (uint8_t)value;
+            if (part < 3 && *text++ != '.') return false;
+        }
+        if (*text != '\0') return false;
+        memcpy(bytes, parsed, sizeof(bytes));
+        return true;
+    }
+};
+
+#endif // ARDUINO_NATIVE_IPADDRESS_H
@@ -0,0 +1,13 @@
+/**
+ * @file LittleFS.h
+ * @brief LittleFS for host builds (in-memory, see FS.h)
+ */
+
+#ifndef ARDUINO_NATIVE_LITTLEFS_H
+#define ARDUINO_NATIVE_LITTLEFS_H
+
+#include "FS.h"
+
+extern fs::FS LittleFS;
+
+#endif // ARDUINO_NATIVE_LITTLEFS_H
@@ -0,0 +1,25 @@
+/**
+ * @file pgmspace.h
+ * @brief Flash access macros for host builds (plain memory on the host)
+ */
+
+#ifndef ARDUINO_NATIVE_PGMSPACE_H
+#define ARDUINO_NATIVE_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(str) (str)
+#define F(str) (str)
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+
+#define pgm_read_byte(addr)     (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)     (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr)    (*(const uint32_t*)(addr))
+#define memcpy_P                memcpy
+#define strcmp_P                strcmp
+#define strlen_P                strlen
+
+#endif // ARDUINO_NATIVE_PGMSPACE_H
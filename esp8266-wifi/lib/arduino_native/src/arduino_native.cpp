@@ -0,0 +1,57 @@
+/**
+ * @file arduino_native.cpp
+ * @brief Host clock, UART, filesystem and WiFi globals for [env:native]
+ */
+
+#include "Arduino.h"
+#include "LittleFS.h"
+#include "ESP8266WiFi.h"
+#include <chrono>
+
+static const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+
+// Time skipped by delay() instead of sleeping
+static uint64_t skippedUs = 0;
+
+uint64_t micros64() {
+    uint64_t elapsed = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - bootTime).count();
+    return elapsed + skippedUs;
+}
+
+uint32_t micros() {
+    return (uint32_t)micros64();
+}
+
+uint32_t millis() {
+    return (uint32_t)(micros64() / 1000);
+}
+
+void delay(uint32_t ms) {
+    skippedUs += (uint64_t)ms * 1000;
+}
+
+void delayMicroseconds(uint32_t us) {
+    skippedUs += us;
+}
+
+void yield() {}
+
+uint32_t EspClass::getCycleCount() {
+    // Wraps like the CCOUNT register (~53 s at 80 MHz)
+    return (uint32_t)(micros64() * getCpuFreqMHz());
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    if (port == 1) {
+        return fwrite(buffer, 1, size, stdout);
+    }
+    tx.append((const char*)buffer, size);
+    return size;
+}
+
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+EspClass ESP;
+fs::FS LittleFS;
+ESP8266WiFiClass WiFi;
@@ -8,6 +8,9 @@
 #include "handlers/stm32_command_handler.h"
 #include "handlers/mqtt_incoming_handler.h"
 #include "handlers/ocpp_message_handler.h"
+#include "handlers/ota_handler.h"
+#include "handlers/stm32_ota_sender.h"
+#include "utils/json_writer.h"
 #include <ArduinoJson.h>
 
 // Note: All driver headers now in drivers/ subdirectory
@@ -20,17 +23,20 @@ DeviceManager::DeviceManager()
       webServer(nullptr),
       webAPIHandler(nullptr),
       stm32(),
-      ntpTime() {
+      ntpTime(),
+      meterBatcher(),
+      meterDeadband(),
+      connectorStates(),
+      authCache(),
+      chargingProfiles(),
+      powerPolicy() {
 
     memset(&systemStatus, 0, sizeof(systemStatus));
     instance = this;
 }
 
 DeviceManager::~DeviceManager() {
-    if (wifiManager) delete wifiManager;
-    if (mqttClient) delete mqttClient;
-    if (webServer) delete webServer;
-    if (webAPIHandler) delete webAPIHandler;
+    // Slots destroy their objects in reverse order (handler first)
     instance = nullptr;
 }
 
@@ -62,6 +68,8 @@ bool DeviceManager::init() {
         return false;
     }
 
+    registerTasks();
+
     systemStatus.initialized = true;
     LOG_INFO("DeviceManager", "System initialized successfully");
 
@@ -77,11 +85,16 @@ bool DeviceManager::initializeConfig() {
 
     const DeviceConfig& config = configManager.get();
 
-    // Set log level from config
+    // Set log level from config; debug mode also traces UART/MQTT traffic
     Logger::getInstance().setLevel((LogLevel)config.system.logLevel);
+    Logger::getInstance().setTrace(config.system.debugEnabled);
 
     LOG_INFO("Config", "Station: %s, Device: %s", config.stationId, config.deviceId);
 
+    // Same filesystem, mounted by the config manager
+    authCache.load();
+    chargingProfiles.load();
+
     return true;
 }
 
@@ -89,7 +102,8 @@ bool DeviceManager::initializeNetwork() {
     const DeviceConfig& config = configManager.get();
 
     // Initialize WiFi
-    wifiManager = new CustomWiFiManager(config);
+    wifiManager = wifiSlot.emplace(config);
+    wifiManager->setTimeSource(unixTimeSource);
     if (wifiManager->init() != WiFiError::SUCCESS) {
         LOG_ERROR("WiFi", "Initialization failed");
         return false;
@@ -113,8 +127,12 @@ bool DeviceManager::initializeNetwork() {
     }
 
     // Initialize MQTT (only if WiFi connected)
-    mqttClient = new MQTTClient(config);
+    mqttClient = mqttSlot.emplace(config);
     mqttClient->setCallback(mqttMessageCallback);
+    mqttClient->setDeliveryCallback(mqttDeliveryCallback);
+    mqttClient->setIdleCallback(mqttIdleCallback);
+    mqttClient->setHandshakeCallback(mqttHandshakeCallback);
+    mqttClient->setTimeSource(unixTimeSource);
 
     MQTTError mqttErr = mqttClient->connect();
     if (mqttErr != MQTTError::SUCCESS) {
@@ -123,6 +141,8 @@ bool DeviceManager::initializeNetwork() {
 
     // Initialize NTP time
     ntpTime.init("pool.ntp.org", 0);  // UTC, can be configured from config later
+    ntpTime.addServer("time.nist.gov");
+    ntpTime.addServer("time.cloudflare.com");
 
     LOG_INFO("Network", "WiFi connected");
     return true;
@@ -132,7 +152,7 @@ bool DeviceManager::initializeWebServer() {
     LOG_INFO("WebServer", "Initializing web server...");
 
     // Create web server
-    webServer = new WebServerDriver(80);
+    webServer = webServerSlot.emplace(80);
     if (!webServer->init()) {
         LOG_ERROR("WebServer", "Failed to initialize");
         return false;
@@ -146,19 +166,23 @@ bool DeviceManager::initializeWebServer() {
 
     // MQTT may be null in provisioning mode - handler will check
     if (!mqttClient) {
-        mqttClient = new MQTTClient(configManager.get());
+        mqttClient = mqttSlot.emplace(configManager.get());
         mqttClient->setCallback(mqttMessageCallback);
+        mqttClient->setDeliveryCallback(mqttDeliveryCallback);
+        mqttClient->setIdleCallback(mqttIdleCallback);
+        mqttClient->setHandshakeCallback(mqttHandshakeCallback);
+        mqttClient->setTimeSource(unixTimeSource);
     }
 
     const DeviceConfig& config = configManager.get();
-    webAPIHandler = new WebAPIHandler(wifiManager, mqttClient, &configManager, config.deviceId);
+    webAPIHandler = webAPISlot.emplace(wifiManager, mqttClient, &configManager, config.deviceId);
+    webAPIHandler->setProfiler(&profiler);
+    webAPIHandler->setConnectorStates(&connectorStates);
+    webAPIHandler->setPowerPolicy(&powerPolicy);
 
     // Register API routes
     webAPIHandler->registerRoutes(webServer->getServer());
 
-    // Serve static files from LittleFS (compressed files in /www_compressed/)
-    webServer->serveStatic("/", "/www_compressed/");
-
     // Start server
     if (!webServer->start()) {
         LOG_ERROR("WebServer", "Failed to start");
@@ -187,58 +211,316 @@ bool DeviceManager::initializeCommunication() {
     return true;
 }
 
+void DeviceManager::registerTasks() {
+    scheduler.add("wifi", taskWiFi, TASK_WIFI_PERIOD_MS);
+    scheduler.add("mqtt", taskMqtt, 0);
+    scheduler.add("ntp", taskNtp, TASK_NTP_PERIOD_MS);
+    scheduler.add("heartbeat", taskHeartbeat, TASK_HEARTBEAT_PERIOD_MS);
+    scheduler.add("meter", taskMeter, TASK_METER_PERIOD_MS);
+    scheduler.add("config", taskConfig, TASK_CONFIG_PERIOD_MS);
+    scheduler.add("live", taskLive, TASK_LIVE_PERIOD_MS);
+    scheduler.add("ota", taskOta, TASK_OTA_PERIOD_MS);
+    scheduler.add("stm32ota", taskStm32Ota, TASK_STM32_OTA_PERIOD_MS);
+    scheduler.add("memory", taskMemory, TASK_MEMORY_PERIOD_MS);
+    scheduler.add("charging", taskCharging, TASK_CHARGING_PERIOD_MS);
+    scheduler.add("power", taskPower, TASK_POWER_PERIOD_MS);
+}
+
 void DeviceManager::run() {
     if (!systemStatus.initialized) return;
 
+    uint32_t loopStart = LoopProfiler::now();
+
     // Handle STM32 communication (always)
     stm32.handle();
+    profiler.record(ProfileStage::STM32, loopStart);
+
+    // Periodic work that is due
+    scheduler.run(millis());
+
+    profiler.record(ProfileStage::LOOP, loopStart);
+}
+
+uint32_t DeviceManager::idleTime() {
+    if (!systemStatus.initialized) return LOOP_IDLE_MAX_MS;
+
+    uint32_t idle = scheduler.idleTime(millis(), LOOP_IDLE_MAX_MS);
+    uint32_t uartBudget = stm32.idleBudgetMs();
+    return (uartBudget < idle) ? uartBudget : idle;
+}
+
+void DeviceManager::sleep(uint32_t ms) {
+    uint32_t start = LoopProfiler::now();
+    delay(ms);
+    profiler.record(ProfileStage::SLEEP, start);
+}
+
+void DeviceManager::taskWiFi() {
+    if (!instance || !instance->wifiManager) return;
 
-    // Handle WiFi
-    if (wifiManager) {
-        wifiManager->handle();
+    uint32_t start = LoopProfiler::now();
+    instance->wifiManager->handle();
+
+    // Scan / connect jobs queued by the web API
+    if (instance->webAPIHandler) {
+        instance->webAPIHandler->handle();
     }
+    instance->profiler.record(ProfileStage::WIFI, start);
+}
 
+void DeviceManager::taskMqtt() {
     // Handle MQTT (only if WiFi connected)
-    if (mqttClient && wifiManager && wifiManager->isConnected()) {
-        mqttClient->handle();
+    if (!instance || !instance->mqttClient || !instance->wifiManager ||
+        !instance->wifiManager->isConnected()) {
+        return;
+    }
 
-        // Update NTP time
-        ntpTime.update();
+    uint32_t start = LoopProfiler::now();
+    instance->mqttClient->handle();
+    instance->profiler.record(ProfileStage::MQTT, start);
 
-        // Send boot notification (once after network ready)
-        if (!systemStatus.bootNotificationSent) {
-            handleBootNotification();
-            systemStatus.bootNotificationSent = true;
-        }
+    // Send boot notification (once after network ready)
+    if (!instance->systemStatus.bootNotificationSent) {
+        instance->handleBootNotification();
+        instance->systemStatus.bootNotificationSent = true;
+    }
+
+    // Resync the backend with the cached connector states once per session
+    if (instance->mqttClient->isConnected() &&
+        instance->mqttClient->getStatus().connectTime != instance->systemStatus.snapshotConnectTime) {
+        instance->handleStatusSnapshot();
+    }
+}
+
+void DeviceManager::taskNtp() {
+    if (!instance || !instance->wifiManager || !instance->wifiManager->isConnected()) return;
+
+    uint32_t start = LoopProfiler::now();
+    instance->ntpTime.update();
+    instance->profiler.record(ProfileStage::NTP, start);
+}
+
+void DeviceManager::taskHeartbeat() {
+    if (!instance || !instance->wifiManager || !instance->wifiManager->isConnected()) return;
+
+    // Interval may change at runtime (config update), so compare here
+    const DeviceConfig& config = instance->configManager.get();
+    uint32_t now = millis();
+    uint32_t lastPublish = instance->mqttClient ? instance->mqttClient->getStatus().lastPublishTime : 0;
+
+    switch (HeartbeatHandler::decide(config, now, instance->systemStatus.lastHeartbeat,
+                                     lastPublish, instance->systemStatus.lastHeartbeatFields)) {
+        case HeartbeatAction::WAIT:
+            return;
+
+        case HeartbeatAction::COALESCE:
+            // Next one is due an interval after that publish
+            instance->systemStatus.lastHeartbeat = lastPublish;
+            instance->systemStatus.heartbeatsCoalesced++;
+            LOG_DEBUG("Heartbeat", "Coalesced (%u so far)", instance->systemStatus.heartbeatsCoalesced);
+            return;
+
+        case HeartbeatAction::SEND:
+            break;
+    }
+
+    uint32_t start = LoopProfiler::now();
+    instance->handleHeartbeat();
+    instance->profiler.record(ProfileStage::HEARTBEAT, start);
+    instance->systemStatus.lastHeartbeat = millis();
+}
+
+void DeviceManager::taskMeter() {
+    if (!instance) return;
+
+    uint32_t start = LoopProfiler::now();
+    instance->handleMeterValues();
+    instance->profiler.record(ProfileStage::METER, start);
+}
+
+void DeviceManager::taskConfig() {
+    if (!instance) return;
+
+    // Coalesced config writes (no-op unless an update is pending)
+    instance->configManager.handle();
+    instance->authCache.handle(millis());
+}
+
+void DeviceManager::taskLive() {
+    if (!instance || !instance->webServer) return;
+
+    LiveTelemetry& live = instance->webServer->getLive();
+    if (!live.hasClients()) return;
+
+    if (millis() - instance->systemStatus.lastLinkStats >= LIVE_LINK_PERIOD_MS) {
+        instance->publishLinkStats();
+        instance->systemStatus.lastLinkStats = millis();
+    }
+    live.handle();
+}
+
+void DeviceManager::taskOta() {
+    if (!instance || !OTAHandler::isActive()) return;
+
+    // Download, hash and flash in slices; reboots itself once verified
+    OTAHandler::handle(instance->stm32);
+}
+
+void DeviceManager::taskStm32Ota() {
+    if (!instance || !STM32OTASender::isActive()) return;
 
-        // Send heartbeat
-        const DeviceConfig& config = configManager.get();
-        if (millis() - systemStatus.lastHeartbeat > config.system.heartbeatInterval) {
-            handleHeartbeat();
-            systemStatus.lastHeartbeat = millis();
+    // Staged STM32 image -> UART bulk transfer
+    STM32OTASender::handle(instance->stm32);
+}
+
+void DeviceManager::taskMemory() {
+    // Watermarks between the 60 s diagnostics dumps
+    MemoryStats::sample();
+}
+
+void DeviceManager::taskCharging() {
+    if (!instance) return;
+
+    ChargingProfileEngine& engine = instance->chargingProfiles;
+    STM32Communicator& stm32 = instance->stm32;
+
+    // STM32 (re)connected: it may have restarted without its limits
+    bool linked = stm32.getStatus().connected;
+    if (linked && !instance->systemStatus.stm32Linked) {
+        engine.resendAll();
+    }
+    instance->systemStatus.stm32Linked = linked;
+
+    // Schedules need wall-clock time; nothing changes until NTP sync
+    uint32_t now = instance->ntpTime.isSynced() ? instance->ntpTime.getUnixTime() : 0;
+    engine.tick(now, instance->connectorStates);
+
+    ChargingLimitChange change;
+    while (linked && engine.nextChange(change)) {
+        charging_limit_payload_t payload;
+        payload.connector_id = change.connectorId;
+        payload.limit = change.limit;
+        payload.valid_for = change.validFor;
+
+        if (stm32.sendCommand(RSP_CHARGING_LIMIT, &payload, sizeof(payload)) != UARTError::SUCCESS) {
+            break;      // TX queue full, next pass
         }
+        engine.markSent(change);
+    }
+
+    engine.handle();
+}
+
+void DeviceManager::taskPower() {
+    if (!instance || !instance->wifiManager) return;
+
+    const DeviceConfig& config = instance->configManager.get();
+    CustomWiFiManager& wifi = *instance->wifiManager;
+    uint32_t now = millis();
+
+    PowerInputs inputs;
+    inputs.enabled = config.wifi.powerSave;
+    inputs.connected = wifi.isConnected();
+    inputs.sessionActive = instance->connectorStates.sessionActive();
+    inputs.batching = config.meter.batchEnabled;
+    inputs.busy = OTAHandler::isActive() ||
+                  (instance->webServer && instance->webServer->getLive().hasClients());
+    inputs.lastUartRx = instance->stm32.getLastRxTime();
+    inputs.keepAliveBase = 0;
+    inputs.keepAliveMs = (uint32_t)config.mqtt.keepAlive * 1000;
+
+    if (instance->mqttClient && instance->mqttClient->isConnected()) {
+        // Keepalive counts from the last packet of the session
+        const MQTTStatus& mqtt = instance->mqttClient->getStatus();
+        inputs.keepAliveBase = ((int32_t)(mqtt.lastMessageTime - mqtt.connectTime) > 0)
+                               ? mqtt.lastMessageTime : mqtt.connectTime;
     }
 
-    // Request meter values periodically
-    handleMeterValues();
+    RadioPowerMode mode = PowerPolicy::decide(inputs, now);
+    if (!instance->powerPolicy.update(mode, now)) return;
+
+    bool idle = mode == RadioPowerMode::IDLE;
+    wifi.setListenInterval(idle ? config.wifi.listenInterval : 0);
+    LOG_DEBUG("Power", "Radio %s (listen interval %u)", PowerPolicy::modeName(mode),
+              wifi.getStatus().listenInterval);
+}
+
+void DeviceManager::publishLinkStats() {
+    const STM32Status& uart = stm32.getStatus();
+    bool wifiUp = WiFi.status() == WL_CONNECTED;
+
+    char buffer[384];
+    JsonWriter w(buffer, sizeof(buffer));
+
+    w.beginObject();
+    w.beginObject("wifi");
+    w.field("connected", wifiUp);
+    w.field("rssi", (int32_t)(wifiUp ? WiFi.RSSI() : 0));
+    w.field("power", PowerPolicy::modeName(powerPolicy.getMode()));
+    w.endObject();
+    w.beginObject("mqtt");
+    w.field("connected", mqttClient && mqttClient->isConnected());
+    w.field("queued", (uint32_t)(mqttClient ? mqttClient->getQueueSize() : 0));
+    w.endObject();
+    w.beginObject("uart");
+    w.field("connected", uart.connected);
+    w.field("baud", uart.baudRate);
+    w.field("rx", uart.messageRxCount);
+    w.field("tx", uart.messageTxCount);
+    w.field("errors", uart.errorCount);
+    w.field("retransmits", uart.retransmits);
+    w.field("rxPeak", (uint32_t)stm32.getBufferPeak());
+    w.field("rxDriverPeak", (uint32_t)uart.rxDriverPeak);
+    w.field("rxDropped", uart.rxFramesDropped + uart.rxOverruns);
+    w.field("paused", stm32.isRxPaused());
+    w.endObject();
+    w.field("heapFree", (uint32_t)ESP.getFreeHeap());
+    w.field("uptimeS", (uint32_t)(millis() / 1000));
+    w.endObject();
+
+    size_t length = w.length();
+    if (length > 0) {
+        webServer->getLive().publish(LiveTopic::LINK, 0, buffer, length);
+    }
 }
 
 void DeviceManager::handleHeartbeat() {
     if (!mqttClient || !wifiManager) return;
 
     // Use handler (stateless, stack-based)
-    HeartbeatHandler::execute(
-        *mqttClient,
-        *wifiManager,
-        configManager.get(),
-        systemStatus.bootTime
-    );
+    if (HeartbeatHandler::execute(
+            *mqttClient,
+            *wifiManager,
+            configManager.get(),
+            systemStatus.bootTime,
+            &profiler,
+            &connectorStates)) {
+        systemStatus.lastHeartbeatFields = millis();
+    }
 }
 
 void DeviceManager::handleMeterValues() {
     // Note: Meter values are now pushed from STM32 via CMD_PUBLISH_METER_VALUES
     // No need to request periodically
     // STM32 sends meter data when available
+
+    // Publish the pending batch once its window expires
+    if (!mqttClient || meterBatcher.pending() == 0) return;
+
+    const DeviceConfig& config = configManager.get();
+
+    // Health fields ride along once per heartbeat interval
+    HeartbeatFields fields;
+    const HeartbeatFields* device = nullptr;
+    if (config.system.heartbeatPiggyback && wifiManager &&
+        millis() - systemStatus.lastHeartbeatFields > config.system.heartbeatInterval) {
+        HeartbeatHandler::collect(fields, *wifiManager, systemStatus.bootTime, &profiler);
+        device = &fields;
+    }
+
+    if (meterBatcher.handle(*mqttClient, config, device) && device) {
+        systemStatus.lastHeartbeatFields = millis();
+    }
 }
 
 void DeviceManager::handleBootNotification() {
@@ -260,6 +542,19 @@ void DeviceManager::handleBootNotification() {
     LOG_INFO("DeviceManager", "Boot notification sent");
 }
 
+void DeviceManager::handleStatusSnapshot() {
+    uint32_t connectTime = mqttClient->getStatus().connectTime;
+
+    // Nothing reported yet: change-driven notifications cover it
+    if (connectorStates.highestKnown() >= 0 &&
+        !OCPPMessageHandler::publishStatusSnapshot(*mqttClient, configManager.get(),
+                                                   connectorStates, ntpTime.getUnixTime())) {
+        return;     // Retried on the next pass
+    }
+
+    systemStatus.snapshotConnectTime = connectTime;
+}
+
 void DeviceManager::mqttMessageCallback(const char* topic, const char* payload, uint16_t length) {
     if (!instance) return;
 
@@ -269,24 +564,59 @@ void DeviceManager::mqttMessageCallback(const char* topic, const char* payload,
         payload,
         length,
         instance->stm32,
-        instance->configManager.get()
+        instance->configManager.get(),
+        &instance->authCache,
+        &instance->chargingProfiles
     );
 }
 
-void DeviceManager::stm32PacketCallback(const uart_packet_t* packet) {
-    if (!instance || !packet) return;
+void DeviceManager::mqttDeliveryCallback(uint32_t token, bool delivered) {
+    if (!instance) return;
+
+    // Final status after STATUS_PENDING for STM32 publishes (token = UART sequence)
+    instance->stm32.sendAck((uint8_t)token, delivered ? STATUS_SUCCESS : STATUS_ERROR);
+}
+
+void DeviceManager::mqttHandshakeCallback(bool active) {
+    if (!instance) return;
+
+    // Blocking TCP/TLS connect: the STM32 holds its frames until it is done
+    instance->stm32.holdRx(active);
+}
+
+void DeviceManager::mqttIdleCallback() {
+    if (!instance) return;
+
+    // Broker handshake in progress: keep the STM32 link serviced
+    instance->stm32.handle();
+}
+
+uint32_t DeviceManager::unixTimeSource() {
+    if (!instance || !instance->ntpTime.isSynced()) return 0;
+
+    // Certificate validity check (CA-pinned TLS), WiFi lease expiry
+    return instance->ntpTime.getUnixTime();
+}
+
+void DeviceManager::stm32PacketCallback(const UartFrameView& frame) {
+    if (!instance) return;
 
     // Use handler (stateless, all logic in handler)
     if (instance->mqttClient) {
         STM32CommandHandler::execute(
-            *packet,
+            frame,
             instance->stm32,
             *instance->mqttClient,
             instance->ntpTime,
-            instance->configManager
+            instance->configManager,
+            instance->meterBatcher,
+            instance->meterDeadband,
+            instance->connectorStates,
+            instance->authCache,
+            instance->webServer ? &instance->webServer->getLive() : nullptr
         );
     } else {
         LOG_WARN("STM32", "MQTT not available");
-        instance->stm32.sendAck(packet->sequence, STATUS_ERROR);
+        instance->stm32.sendAck(frame.sequence, STATUS_ERROR);
     }
 }
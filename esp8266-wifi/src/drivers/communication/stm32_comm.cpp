@@ -5,30 +5,75 @@
  */
 
 #include "drivers/communication/stm32_comm.h"
+#include "utils/logger.h"
 
 /**
  * @brief Constructor
  */
 STM32Communicator::STM32Communicator()
-    : txSequence(0),
+    : link(&Serial),
+      txWindowHead(0),
+      txWindowCount(0),
+      txSequence(0),
       userCallback(nullptr),
-      lastRxTime(0) {
-
+      lastRxTime(0),
+      rxScanOffset(0),
+      baudTrial(false),
+      baudTrialStart(0),
+      previousBaud(UART_BAUD_BOOT),
+      baudChangedAt(0),
+      errorWindowStart(0),
+      errorWindowBase(0),
+      fragRxAt(0),
+      fragTxLength(0),
+      fragTxCmd(0),
+      fragTxMessageId(0),
+      fragTxNext(0),
+      fragTxCount(0),
+      flowPaused(false),
+      flowHold(false),
+      flowSentAt(0),
+      flowHighAt(0) {
+
+    uart_parser_init(&parser, nullptr);
+    uart_reassembly_init(&reassembly, fragBuffer, sizeof(fragBuffer));
     memset(&status, 0, sizeof(STM32Status));
+    status.protocolVersion = UART_PROTOCOL_V1;
+    status.baudRate = UART_BAUD_BOOT;
 }
 
 /**
  * @brief Initialize UART
  */
 UARTError STM32Communicator::init(uint32_t baudRate) {
+    Serial.setRxBufferSize(STM32_RX_DRIVER_BUFFER);
     Serial.begin(baudRate);
+#if STM32_UART_SWAP
+    Serial.swap();
+#endif
     Serial.setTimeout(100);
+    // SDK/core debug prints must not end up in the protocol stream
+    Serial.setDebugOutput(false);
 
     rxBuffer.clear();
+    rxScanOffset = 0;
+    uart_parser_reset(&parser);
+    txBuffer.clear();
+    resetTxWindow();
     txSequence = 0;
     lastRxTime = millis();
+    flowPaused = false;
+    flowHold = false;
+
+    // Stay on v1 until the STM32 asks for more (old firmware never does)
+    status.protocolVersion = UART_PROTOCOL_V1;
 
-    Serial.println(F("[STM32] UART communication initialized"));
+    status.baudRate = baudRate;
+    baudTrial = false;
+    errorWindowStart = millis();
+    errorWindowBase = status.checksumErrors;
+
+    LOG_INFO("STM32", "UART communication initialized");
     return UARTError::SUCCESS;
 }
 
@@ -36,262 +81,900 @@ UARTError STM32Communicator::init(uint32_t baudRate) {
  * @brief Send packet to STM32
  */
 UARTError STM32Communicator::sendPacket(const uart_packet_t& packet) {
-    // Create mutable copy to set checksum
-    uart_packet_t txPacket = packet;
-    txPacket.checksum = uart_calculate_checksum(&txPacket);
+    if (packet.length > UART_MAX_PAYLOAD) {
+        return UARTError::INVALID_PARAM;
+    }
 
-    // Send packet header
-    Serial.write(txPacket.start_byte);
-    Serial.write(txPacket.cmd_type);
-    Serial.write((uint8_t)(txPacket.length & 0xFF));
-    Serial.write((uint8_t)(txPacket.length >> 8));
-    Serial.write(txPacket.sequence);
+    return enqueueFrame(packet.cmd_type, packet.sequence, nullptr, 0, packet.payload, packet.length, false);
+}
 
-    // Send payload if present
-    if (txPacket.length > 0) {
-        Serial.write(txPacket.payload, txPacket.length);
+/**
+ * @brief Send reply frame from a payload span
+ */
+UARTError STM32Communicator::sendResponse(uint8_t cmdType, uint8_t sequence,
+                                          const void* payload, uint16_t length) {
+    if (length > UART_MAX_PAYLOAD || (length > 0 && payload == nullptr)) {
+        return UARTError::INVALID_PARAM;
     }
 
-    // Send footer
-    Serial.write(txPacket.checksum);
-    Serial.write(txPacket.end_byte);
+    return enqueueFrame(cmdType, sequence, nullptr, 0, (const uint8_t*)payload, length, false);
+}
 
-    status.messageTxCount++;
+/**
+ * @brief Send command with payload
+ */
+UARTError STM32Communicator::sendCommand(uint8_t cmdType, const void* payload, uint16_t length) {
+    return sendCommand(cmdType, nullptr, 0, payload, length);
+}
 
-    Serial.printf("[STM32] TX: CMD=0x%02X LEN=%u SEQ=%u\n",
-                  txPacket.cmd_type, txPacket.length, txPacket.sequence);
+/**
+ * @brief Send command with a two-part payload
+ */
+UARTError STM32Communicator::sendCommand(uint8_t cmdType, const void* prefix, uint16_t prefixLength,
+                                         const void* payload, uint16_t length) {
+    if ((prefixLength > 0 && prefix == nullptr) ||
+        (length > 0 && payload == nullptr)) {
+        return UARTError::INVALID_PARAM;
+    }
 
-    return UARTError::SUCCESS;
+    if ((uint32_t)prefixLength + length > UART_MAX_PAYLOAD) {
+        return sendFragmented(cmdType, (const uint8_t*)prefix, prefixLength,
+                              (const uint8_t*)payload, length);
+    }
+
+    // Only v2 firmware sends CMD_ACK, so only then is there anything to wait for
+    bool track = status.protocolVersion >= UART_PROTOCOL_V2;
+
+    UARTError result = enqueueFrame(cmdType, txSequence, (const uint8_t*)prefix, prefixLength,
+                                    (const uint8_t*)payload, length, track);
+    if (result == UARTError::SUCCESS) {
+        txSequence++;
+    }
+    return result;
 }
 
 /**
- * @brief Send command with payload
+ * @brief Accept a message over UART_MAX_PAYLOAD for fragmented sending
+ *
+ * The caller's buffers are usually transient (MQTT receive buffer), so
+ * the message is copied once into fragBuffer; pumpFragments() then
+ * queues fragments as window slots free up. fragBuffer is shared with
+ * inbound reassembly, so this waits for a message being received.
  */
-UARTError STM32Communicator::sendCommand(uint8_t cmdType, const void* payload, uint16_t length) {
-    if (length > UART_MAX_PAYLOAD) {
+UARTError STM32Communicator::sendFragmented(uint8_t cmdType,
+                                            const uint8_t* prefix, uint16_t prefixLength,
+                                            const uint8_t* payload, uint16_t length) {
+    uint32_t total = (uint32_t)prefixLength + length;
+
+    // Fragments rely on CMD_ACK/retransmit, v1 peers cannot reassemble
+    if (status.protocolVersion < UART_PROTOCOL_V2 || total > sizeof(fragBuffer)) {
         return UARTError::INVALID_PARAM;
     }
 
-    uart_packet_t packet;
-    uart_init_packet(&packet, cmdType, txSequence++);
+    if (fragTxLength > 0 || reassembly.active) {
+        status.txQueueFull++;
+        return UARTError::BUFFER_OVERFLOW;
+    }
+
+    if (prefixLength > 0) {
+        memcpy(fragBuffer, prefix, prefixLength);
+    }
+    memcpy(fragBuffer + prefixLength, payload, length);
+
+    fragTxLength = (uint16_t)total;
+    fragTxCmd = cmdType;
+    fragTxMessageId++;
+    fragTxNext = 0;
+    fragTxCount = uart_fragment_count(fragTxLength);
 
-    if (length > 0 && payload != nullptr) {
-        memcpy(packet.payload, payload, length);
-        packet.length = length;
-    } else {
-        packet.length = 0;
+    pumpFragments();
+    return UARTError::SUCCESS;
+}
+
+/**
+ * @brief Queue pending fragments while the ACK window has room
+ */
+void STM32Communicator::pumpFragments() {
+    while (fragTxLength > 0) {
+        uint16_t offset = (uint16_t)fragTxNext * UART_FRAGMENT_CHUNK;
+        uint16_t chunk = fragTxLength - offset;
+        if (chunk > UART_FRAGMENT_CHUNK) chunk = UART_FRAGMENT_CHUNK;
+
+        uart_fragment_header_t header;
+        header.message_id = fragTxMessageId;
+        header.index = fragTxNext;
+        header.count = fragTxCount;
+        header.cmd_type = fragTxCmd;
+        header.total_length = fragTxLength;
+
+        if (enqueueFrame(RSP_FRAGMENT, txSequence, (const uint8_t*)&header, sizeof(header),
+                         fragBuffer + offset, chunk, true) != UARTError::SUCCESS) {
+            return;  // Window or ring full, retry on next handle()
+        }
+        txSequence++;
+
+        // Queued frames are kept in retryStore, fragBuffer is free again
+        // once the last one is queued
+        if (++fragTxNext >= fragTxCount) {
+            fragTxLength = 0;
+        }
+    }
+}
+
+/**
+ * @brief Store a CMD_FRAGMENT and dispatch the message once complete
+ *
+ * Each fragment is ACKed like a command; the reassembled message is
+ * dispatched with the last fragment's sequence, so its handler's ACK
+ * answers the message as a whole. While an outbound message still owns
+ * fragBuffer, fragments are answered STATUS_BUSY and the STM32 resends
+ * them later.
+ */
+void STM32Communicator::handleFragment(const UartFrameView& frame) {
+    uart_fragment_header_t header;
+    if (frame.copyTo(&header, 0, sizeof(header)) != sizeof(header) ||
+        header.cmd_type == CMD_FRAGMENT) {
+        status.reassemblyErrors++;
+        sendAck(frame.sequence, STATUS_INVALID);
+        return;
+    }
+
+    if (fragTxLength > 0) {
+        sendAck(frame.sequence, STATUS_BUSY);
+        return;
     }
 
-    return sendPacket(packet);
+    uart_reassembly_result_t result = UART_REASSEMBLY_ERR_HEADER;
+    frame.withLinearPayload([&](uint8_t* data, uint16_t length) {
+        result = uart_reassembly_feed(&reassembly, &header,
+                                      data + sizeof(header), length - sizeof(header));
+    });
+
+    switch (result) {
+        case UART_REASSEMBLY_INCOMPLETE:
+        case UART_REASSEMBLY_DUPLICATE:
+            fragRxAt = millis();
+            sendAck(frame.sequence, STATUS_SUCCESS);
+            return;
+
+        case UART_REASSEMBLY_COMPLETE:
+            break;
+
+        default:
+            LOG_WARN("STM32", "Fragment %u/%u of 0x%02X rejected (%u)",
+                          header.index, header.count, header.cmd_type, result);
+            status.reassemblyErrors++;
+            sendAck(frame.sequence, STATUS_INVALID);
+            return;
+    }
+
+    // Whole message as one contiguous frame
+    UartFrameView message;
+    message.version = frame.version;
+    message.cmd_type = reassembly.cmd_type;
+    message.length = reassembly.total_length;
+    message.sequence = frame.sequence;
+    message.span[0] = reassembly.buffer;
+    message.spanLength[0] = reassembly.total_length;
+    message.span[1] = nullptr;
+    message.spanLength[1] = 0;
+
+    status.messagesReassembled++;
+
+    bool internal = handleParsedPacket(message);
+    if (userCallback && !internal) {
+        userCallback(message);
+    }
 }
 
 /**
  * @brief Send ACK response
  */
 UARTError STM32Communicator::sendAck(uint8_t sequence, uint8_t statusCode) {
-    uart_packet_t packet;
-    uart_init_packet(&packet, RSP_MQTT_ACK, sequence);
-    packet.payload[0] = statusCode;
-    packet.length = 1;
+    return sendResponse(RSP_MQTT_ACK, sequence, &statusCode, 1);
+}
+
+/**
+ * @brief Encode frame into the TX ring (header + prefix + payload + footer in one go)
+ *
+ * Nothing is written unless the whole frame fits, so a full queue never
+ * leaves half a frame behind.
+ */
+UARTError STM32Communicator::enqueueFrame(uint8_t cmdType, uint8_t sequence,
+                                          const uint8_t* prefix, uint16_t prefixLength,
+                                          const uint8_t* payload, uint16_t length, bool track) {
+    // Handshake frames always go out as v1 so either side can parse them
+    uint8_t version = (cmdType == RSP_HELLO) ? UART_PROTOCOL_V1 : status.protocolVersion;
+    uint16_t total = prefixLength + length;
+    uint16_t frameSize = uart_frame_size(version, total);
+
+    if (txBuffer.free() < frameSize ||
+        (track && (txWindowCount >= TX_WINDOW_SIZE || retryStore.free() < frameSize))) {
+        status.txQueueFull++;
+        return UARTError::BUFFER_OVERFLOW;
+    }
+
+    uint8_t header[UART_HEADER_SIZE] = {
+        version == UART_PROTOCOL_V2 ? (uint8_t)UART_START_BYTE_V2 : (uint8_t)UART_START_BYTE,
+        cmdType,
+        (uint8_t)(total & 0xFF),
+        (uint8_t)(total >> 8),
+        sequence
+    };
+
+    uint8_t footer[UART_FOOTER_SIZE_V2];
+    uint8_t footerSize;
+    if (version == UART_PROTOCOL_V2) {
+        uint16_t crc = uart_crc16_update(0xFFFF, header + 1, UART_HEADER_SIZE - 1);
+        crc = uart_crc16_update(crc, prefix, prefixLength);
+        crc = uart_crc16_update(crc, payload, length);
+        footer[0] = crc & 0xFF;
+        footer[1] = crc >> 8;
+        footer[2] = UART_END_BYTE;
+        footerSize = UART_FOOTER_SIZE_V2;
+    } else {
+        uint8_t checksum = header[1] ^ header[2] ^ header[3] ^ header[4];
+        for (uint16_t i = 0; i < prefixLength; i++) {
+            checksum ^= prefix[i];
+        }
+        for (uint16_t i = 0; i < length; i++) {
+            checksum ^= payload[i];
+        }
+        footer[0] = checksum;
+        footer[1] = UART_END_BYTE;
+        footerSize = UART_FOOTER_SIZE;
+    }
+
+    txBuffer.pushMultiple(header, sizeof(header));
+    if (prefixLength > 0) {
+        txBuffer.pushMultiple(prefix, prefixLength);
+    }
+    if (length > 0) {
+        txBuffer.pushMultiple(payload, length);
+    }
+    txBuffer.pushMultiple(footer, footerSize);
+
+    if (track) {
+        retryStore.pushMultiple(header, sizeof(header));
+        if (prefixLength > 0) {
+            retryStore.pushMultiple(prefix, prefixLength);
+        }
+        if (length > 0) {
+            retryStore.pushMultiple(payload, length);
+        }
+        retryStore.pushMultiple(footer, footerSize);
+
+        TxInFlight& slot = txWindow[(txWindowHead + txWindowCount) % TX_WINDOW_SIZE];
+        slot.sequence = sequence;
+        slot.retries = 0;
+        slot.acked = false;
+        slot.frameLength = frameSize;
+        slot.sentAt = millis();
+        txWindowCount++;
+    }
+
+    status.messageTxCount++;
 
-    return sendPacket(packet);
+    drainTx();
+    return UARTError::SUCCESS;
 }
 
 /**
- * @brief Handle UART communication
+ * @brief Move queued bytes into the UART FIFO, only as much as it accepts
+ *
+ * The rest stays queued for the next call, so a frame may go out over
+ * several loops. Nothing else writes to this UART (logs go to Serial1).
  */
-void STM32Communicator::handle() {
-    // Read available data into ring buffer
-    while (Serial.available()) {
-        uint8_t byte = Serial.read();
-
-        if (!rxBuffer.push(byte)) {
-            // Buffer overflow
-            status.errorCount++;
-            Serial.println(F("[STM32] RX buffer overflow, clearing old data"));
-            rxBuffer.discard(64); // Discard 64 bytes to make room
-            rxBuffer.push(byte);
+void STM32Communicator::drainTx() {
+    while (txBuffer.available() > 0) {
+        size_t room = link->availableForWrite();
+        if (room == 0) {
+            return;
         }
 
-        lastRxTime = millis();
+        size_t spanLen = 0;
+        const uint8_t* data = txBuffer.readSpan(0, spanLen);
+        size_t chunk = min(room, spanLen);
+
+        size_t written = link->write(data, chunk);
+        txBuffer.discard(written);
+
+        if (written < chunk) {
+            return;
+        }
     }
+}
 
-    // Try to parse packets from buffer
-    uart_packet_t packet;
-    while (parsePacket(packet)) {
-        // Valid packet received
-        status.messageRxCount++;
-        status.lastHeartbeat = millis();
-        status.connected = true;
+/**
+ * @brief Blocking drain (before a baud switch only)
+ */
+void STM32Communicator::flushTx() {
+    while (txBuffer.available() > 0) {
+        size_t spanLen = 0;
+        const uint8_t* data = txBuffer.readSpan(0, spanLen);
+        txBuffer.discard(link->write(data, spanLen));
+    }
+    link->flush();
+}
 
-        Serial.printf("[STM32] RX: CMD=0x%02X LEN=%u SEQ=%u\n",
-                      packet.cmd_type, packet.length, packet.sequence);
+/**
+ * @brief CMD_ACK from STM32: mark command done, slide the window
+ *
+ * STATUS_BUSY keeps the command in flight; it is resent after
+ * UART_TIMEOUT_MS with a fresh retry budget (the peer is alive).
+ */
+void STM32Communicator::handleCommandAck(const UartFrameView& frame) {
+    uint8_t ackStatus = frame.length > 0 ? frame.at(0) : STATUS_SUCCESS;
+    bool found = false;
+
+    for (uint8_t i = 0; i < txWindowCount; i++) {
+        TxInFlight& slot = txWindow[(txWindowHead + i) % TX_WINDOW_SIZE];
+        if (!slot.acked && slot.sequence == frame.sequence) {
+            if (ackStatus == STATUS_BUSY) {
+                slot.retries = 0;
+                slot.sentAt = millis();
+                return;
+            }
+            slot.acked = true;
+            found = true;
+            break;
+        }
+    }
 
-        // Handle packet
-        handleParsedPacket(packet);
+    if (!found) {
+        // Late ACK for a retransmitted or dropped command
+        return;
+    }
 
-        // Call user callback
-        if (userCallback) {
-            userCallback(&packet);
+    if (ackStatus != STATUS_SUCCESS) {
+        LOG_WARN("STM32", "Command SEQ=%u rejected: 0x%02X", frame.sequence, ackStatus);
+    }
+
+    releaseAcked();
+}
+
+/**
+ * @brief Retransmit unACKed commands after UART_TIMEOUT_MS
+ */
+void STM32Communicator::checkTxTimeouts() {
+    uint32_t now = millis();
+    size_t offset = 0;
+
+    for (uint8_t i = 0; i < txWindowCount; i++) {
+        TxInFlight& slot = txWindow[(txWindowHead + i) % TX_WINDOW_SIZE];
+        size_t frameOffset = offset;
+        offset += slot.frameLength;
+
+        if (slot.acked || now - slot.sentAt < UART_TIMEOUT_MS) {
+            continue;
+        }
+
+        if (slot.retries >= UART_MAX_RETRIES) {
+            LOG_WARN("STM32", "Command SEQ=%u not ACKed, dropped", slot.sequence);
+            slot.acked = true;
+            status.txDropped++;
+            status.timeoutErrors++;
+            continue;
+        }
+
+        if (txBuffer.free() < slot.frameLength) {
+            // Retry on a later pass once the TX ring drains
+            continue;
         }
+
+        // Copy the stored frame (up to two spans) back into the TX ring
+        size_t copied = 0;
+        while (copied < slot.frameLength) {
+            size_t spanLen = 0;
+            const uint8_t* data = retryStore.readSpan(frameOffset + copied, spanLen);
+            size_t chunk = min(spanLen, (size_t)(slot.frameLength - copied));
+            txBuffer.pushMultiple(data, chunk);
+            copied += chunk;
+        }
+
+        slot.retries++;
+        slot.sentAt = now;
+        status.retransmits++;
     }
 
+    // Dropped commands release their slots like ACKed ones
+    releaseAcked();
+}
+
+/**
+ * @brief Slide the window past ACKed (or dropped) commands at its front
+ */
+void STM32Communicator::releaseAcked() {
+    while (txWindowCount > 0 && txWindow[txWindowHead].acked) {
+        retryStore.discard(txWindow[txWindowHead].frameLength);
+        txWindowHead = (txWindowHead + 1) % TX_WINDOW_SIZE;
+        txWindowCount--;
+    }
+}
+
+/**
+ * @brief Forget all in-flight commands (peer went back to v1)
+ */
+void STM32Communicator::resetTxWindow() {
+    txWindowHead = 0;
+    txWindowCount = 0;
+    retryStore.clear();
+    fragTxLength = 0;
+}
+
+/**
+ * @brief Handle UART communication
+ */
+void STM32Communicator::handle() {
+    // Bytes that piled up in the driver since the last call
+    size_t pending = link->available();
+    if (link == &Serial && Serial.hasOverrun()) {
+        status.rxOverruns++;
+        LOG_WARN("STM32", "UART driver overrun, RX bytes lost");
+    }
+    checkFlowControl(pending);
+
+    // Bulk ingest: copy everything the UART driver holds straight into
+    // the ring buffer (at most two readBytes() per batch when it wraps)
+    if (pending > 0) {
+        uint32_t startUs = micros();
+        size_t received = 0;
+
+        while (pending > 0) {
+            size_t span;
+            uint8_t* dst = rxBuffer.writeSpan(span);
+
+            if (span == 0) {
+                // Ring full: hand out the complete frames first
+                dispatchFrames();
+                dst = rxBuffer.writeSpan(span);
+            }
+
+            if (span == 0) {
+                // No frame end in a full ring: drop what is there as a
+                // whole, the parser resyncs on the next start byte
+                status.errorCount++;
+                status.rxFramesDropped++;
+                LOG_WARN("STM32", "RX buffer full, dropping %u bytes", rxBuffer.available());
+                clearBuffer();
+                continue;
+            }
+
+            size_t got = link->readBytes(dst, min(span, pending));
+            if (got == 0) {
+                break;
+            }
+
+            rxBuffer.commit(got);
+            received += got;
+            pending -= got;
+        }
+
+        lastRxTime = millis();
+        status.rxBytes += received;
+        status.rxBatches++;
+        status.rxIngestUs += micros() - startUs;
+    }
+
+    dispatchFrames();
+
     // Check for connection timeout
     updateStatus();
 
+    // Revert failed baud trials, fall back on error spikes / silence
+    checkBaudHealth();
+
+    // Retransmit overdue commands, then push queued bytes to the UART
+    checkTxTimeouts();
+    checkReassemblyTimeout();
+    pumpFragments();
+    drainTx();
+
     // Check for parse timeout (stale data in buffer)
     if (rxBuffer.available() > 0) {
         if (millis() - lastRxTime > PARSE_TIMEOUT) {
-            Serial.printf("[STM32] Parse timeout, discarding %u bytes\n", rxBuffer.available());
+            LOG_WARN("STM32", "Parse timeout, discarding %u bytes", rxBuffer.available());
             rxBuffer.clear();
+            rxScanOffset = 0;
+            uart_parser_reset(&parser);
             status.timeoutErrors++;
         }
     }
 }
 
 /**
- * @brief Parse packet from ring buffer
+ * @brief Drop a partial inbound message the STM32 stopped sending
+ *
+ * Its fragments would have been retransmitted by now; giving up frees
+ * fragBuffer for outbound messages.
  */
-bool STM32Communicator::parsePacket(uart_packet_t& packet) {
-    // Need at least 8 bytes for minimum packet (header + footer, no payload)
-    if (rxBuffer.available() < 8) {
-        return false;
+void STM32Communicator::checkReassemblyTimeout() {
+    if (reassembly.active && millis() - fragRxAt > REASSEMBLY_TIMEOUT) {
+        LOG_WARN("STM32", "Fragmented 0x%02X abandoned (%u/%u received)",
+                      reassembly.cmd_type, reassembly.received, reassembly.count);
+        reassembly.active = 0;
+        reassembly.received = 0;
+        status.reassemblyErrors++;
     }
+}
 
-    // Search for start byte
-    uint8_t byte;
-    size_t searchCount = 0;
-    bool foundStart = false;
+/**
+ * @brief Parse and hand out every complete frame in the ring
+ */
+void STM32Communicator::dispatchFrames() {
+    // Zero-copy views into rxBuffer
+    UartFrameView frame;
+    while (parsePacket(frame)) {
+        // Valid packet received
+        status.messageRxCount++;
+        status.lastHeartbeat = millis();
+        status.connected = true;
 
-    while (rxBuffer.available() >= 8 && searchCount < 256) {
-        if (!rxBuffer.peek(byte)) {
-            return false;
+        LOG_TRACE("STM32", "RX: CMD=0x%02X LEN=%u SEQ=%u",
+                      frame.cmd_type, frame.length, frame.sequence);
+
+        // Handle packet; link-level commands are not passed on
+        bool internal = handleParsedPacket(frame);
+
+        // Call user callback
+        if (userCallback && !internal) {
+            userCallback(frame);
         }
 
-        if (byte == UART_START_BYTE) {
-            foundStart = true;
-            break;
+        // Frame consumed, release it from the ring
+        rxBuffer.discard(uart_frame_size(frame.version, frame.length));
+    }
+}
+
+/**
+ * @brief Pause/resume the STM32 around the driver buffer water marks
+ *
+ * A full driver buffer loses bytes mid-frame; pausing the sender early
+ * keeps loss at whole frames (the STM32 retransmits, v2) instead.
+ */
+void STM32Communicator::checkFlowControl(size_t pending) {
+    if (pending > status.rxDriverPeak) {
+        status.rxDriverPeak = (uint16_t)pending;
+    }
+
+    // v1 firmware does not know RSP_FLOW_CONTROL
+    if (status.protocolVersion < UART_PROTOCOL_V2) {
+        flowPaused = false;
+        return;
+    }
+
+    uint32_t now = millis();
+    if (flowHold) {
+        if (!flowPaused || now - flowSentAt >= STM32_FLOW_REFRESH_MS) {
+            flowPaused = sendFlowControl(true, pending) || flowPaused;
         }
+        flowHighAt = now;
+        return;
+    }
 
-        // Not start byte, discard it
-        rxBuffer.pop(byte);
-        searchCount++;
+    if (pending >= STM32_RX_DRIVER_BUFFER * STM32_RX_HIGH_WATER_PCT / 100) {
+        flowHighAt = now;
+        if (!flowPaused) {
+            if (sendFlowControl(true, pending)) {
+                flowPaused = true;
+                status.flowPauses++;
+                LOG_DEBUG("STM32", "RX high water (%u bytes), pausing STM32", pending);
+            }
+            return;
+        }
     }
 
-    if (!foundStart) {
-        return false;
+    if (!flowPaused) return;
+
+    if (pending <= STM32_RX_DRIVER_BUFFER * STM32_RX_LOW_WATER_PCT / 100 &&
+        now - flowHighAt >= STM32_FLOW_HOLD_MS) {
+        if (sendFlowControl(false, pending)) {
+            flowPaused = false;
+        }
+    } else if (now - flowSentAt >= STM32_FLOW_REFRESH_MS) {
+        // The STM32 resumes on its own after UART_FLOW_PAUSE_MAX_MS
+        sendFlowControl(true, pending);
     }
+}
 
-    // Try to parse header
-    uint8_t header[5];
-    for (int i = 0; i < 5; i++) {
-        if (!rxBuffer.peekAt(i, header[i])) {
-            return false; // Not enough data yet
+void STM32Communicator::holdRx(bool hold) {
+    if (hold == flowHold) return;
+    flowHold = hold;
+
+    if (hold) {
+        bool wasPaused = flowPaused;
+        checkFlowControl(link->available());
+        if (flowPaused && !wasPaused) {
+            status.flowPauses++;
+            LOG_DEBUG("STM32", "Holding STM32 frames");
         }
+    } else {
+        // Resume at the next handle() unless the driver buffer is still high
+        flowHighAt = millis() - STM32_FLOW_HOLD_MS;
     }
+}
 
-    // Extract packet info
-    packet.start_byte = header[0];
-    packet.cmd_type = header[1];
-    packet.length = header[2] | (header[3] << 8);
-    packet.sequence = header[4];
+bool STM32Communicator::sendFlowControl(bool paused, size_t pending) {
+    flow_control_payload_t payload;
+    payload.paused = paused ? 1 : 0;
+    payload.rx_free = (uint16_t)(pending < STM32_RX_DRIVER_BUFFER ? STM32_RX_DRIVER_BUFFER - pending : 0);
 
-    // Validate packet length
-    if (packet.length > UART_MAX_PAYLOAD) {
-        Serial.printf("[STM32] Invalid packet length: %u\n", packet.length);
-        rxBuffer.pop(byte); // Discard start byte
-        status.errorCount++;
-        return false;
+    // Link-level like CMD_ACK: untracked, no sequence of its own
+    if (enqueueFrame(RSP_FLOW_CONTROL, 0, nullptr, 0, (const uint8_t*)&payload,
+                     sizeof(payload), false) != UARTError::SUCCESS) {
+        return false;       // TX ring full, next handle()
     }
 
-    // Calculate total packet size
-    size_t packetSize = 5 + packet.length + 2; // Header + payload + checksum + end byte
+    flowSentAt = millis();
+    return true;
+}
 
-    // Check if we have complete packet
-    if (rxBuffer.available() < packetSize) {
-        return false; // Wait for more data
+uint32_t STM32Communicator::idleBudgetMs() {
+    if (link->available() > 0 || txBuffer.available() > 0 || fragTxLength > 0) {
+        return 0;
     }
 
-    // Read payload
-    for (uint16_t i = 0; i < packet.length; i++) {
-        if (!rxBuffer.peekAt(5 + i, packet.payload[i])) {
-            return false;
+    // 10 bits per byte on the wire
+    return (STM32_RX_DRIVER_BUFFER / 2) * 10000u / status.baudRate;
+}
+
+/**
+ * @brief Parse packet from ring buffer
+ *
+ * Feeds only bytes not yet seen into the streaming parser, so a frame
+ * that arrives over several handle() calls is never re-scanned. On
+ * success the frame is left in rxBuffer (starting at the tail) and
+ * frame references its payload in place; handle() discards it after
+ * dispatch.
+ */
+bool STM32Communicator::parsePacket(UartFrameView& frame) {
+    while (rxScanOffset < rxBuffer.available()) {
+        size_t spanLen = 0;
+        const uint8_t* data = rxBuffer.readSpan(rxScanOffset, spanLen);
+
+        uint16_t consumed = 0;
+        uart_parse_result_t result = uart_parser_feed(&parser, data, spanLen, &consumed);
+        rxScanOffset += consumed;
+
+        // Drop bytes skipped while hunting for the start byte
+        size_t junk = rxScanOffset - parser.frame_bytes;
+        if (junk > 0) {
+            rxBuffer.discard(junk);
+            rxScanOffset -= junk;
+        }
+
+        if (result == UART_PARSE_INCOMPLETE) {
+            continue;
         }
-    }
 
-    // Read footer
-    if (!rxBuffer.peekAt(5 + packet.length, packet.checksum)) {
-        return false;
+        if (result == UART_PARSE_FRAME) {
+            // rxScanOffset == frame size, frame starts at the tail
+            frame.version = parser.version;
+            frame.cmd_type = parser.cmd_type;
+            frame.length = parser.length;
+            frame.sequence = parser.sequence;
+
+            // Reference payload in place (second span only if it wraps)
+            frame.span[0] = rxBuffer.readSpan(UART_HEADER_SIZE, spanLen);
+            frame.spanLength[0] = (spanLen < frame.length) ? spanLen : frame.length;
+            frame.span[1] = rxBuffer.readSpan(UART_HEADER_SIZE + frame.spanLength[0], spanLen);
+            frame.spanLength[1] = frame.length - frame.spanLength[0];
+
+            rxScanOffset = 0;
+            parser.frame_bytes = 0;
+            return true;
+        }
+
+        // Bad frame: discard its start byte and rescan what followed it
+        switch (result) {
+            case UART_PARSE_ERR_LENGTH:
+                LOG_WARN("STM32", "Invalid packet length: %u", parser.length);
+                break;
+            case UART_PARSE_ERR_CHECKSUM:
+                if (parser.version == UART_PROTOCOL_V2) {
+                    LOG_ERROR("STM32", "CRC error: calc=0x%04X recv=0x%04X",
+                                  parser.crc, parser.rx_crc);
+                } else {
+                    LOG_ERROR("STM32", "Checksum error: calc=0x%02X", parser.checksum);
+                }
+                status.checksumErrors++;
+                break;
+            default:
+                LOG_WARN("STM32", "Invalid end byte");
+                break;
+        }
+        status.errorCount++;
+
+        rxBuffer.discard(1);
+        rxScanOffset = 0;
+        uart_parser_reset(&parser);
     }
-    if (!rxBuffer.peekAt(5 + packet.length + 1, packet.end_byte)) {
-        return false;
+
+    return false;
+}
+
+/**
+ * @brief Handle parsed packet (internal commands)
+ * @return true if the frame was a link-level command consumed here
+ */
+bool STM32Communicator::handleParsedPacket(const UartFrameView& frame) {
+    // A v1 data frame after v2 was agreed means the STM32 was reset or
+    // reflashed with older firmware: fall back until it says hello again
+    if (frame.version == UART_PROTOCOL_V1 && frame.cmd_type != CMD_HELLO &&
+        status.protocolVersion != UART_PROTOCOL_V1) {
+        LOG_WARN("STM32", "v1 frame received, falling back to protocol v1");
+        status.protocolVersion = UART_PROTOCOL_V1;
+        resetTxWindow();
     }
 
-    // Validate packet
-    if (!validatePacket(packet)) {
-        // Invalid packet, discard start byte and try again
-        rxBuffer.pop(byte);
-        return false;
+    // Link-level commands are handled here
+    switch (frame.cmd_type) {
+        case CMD_HELLO:
+            handleHello(frame);
+            return true;
+
+        case CMD_SET_BAUD:
+            handleSetBaud(frame);
+            return true;
+
+        case CMD_ACK:
+            handleCommandAck(frame);
+            return true;
+
+        case CMD_BAUD_TEST:
+            handleBaudTest(frame);
+            return true;
+
+        case CMD_FRAGMENT:
+            handleFragment(frame);
+            return true;
+
+        default:
+            // Application commands go to the user callback, which also
+            // answers those it does not know
+            break;
     }
 
-    // Valid packet! Remove it from buffer
-    rxBuffer.discard(packetSize);
+    return false;
+}
+
+/**
+ * @brief Answer protocol version handshake
+ *
+ * Agreed version = min(STM32 max, ours). RSP_HELLO itself is sent as
+ * v1; frames after it use the agreed format.
+ */
+void STM32Communicator::handleHello(const UartFrameView& frame) {
+    hello_payload_t hello;
+    memset(&hello, 0, sizeof(hello));
+    frame.copyTo(&hello, 0, sizeof(hello));
 
-    return true;
+    uint8_t agreed = hello.version;
+    if (agreed > UART_PROTOCOL_MAX) agreed = UART_PROTOCOL_MAX;
+    if (agreed < UART_PROTOCOL_V1) agreed = UART_PROTOCOL_V1;
+
+    hello_payload_t response;
+    memset(&response, 0, sizeof(response));
+    response.version = agreed;
+
+    sendResponse(RSP_HELLO, frame.sequence, &response, sizeof(response));
+
+    status.protocolVersion = agreed;
+    LOG_INFO("STM32", "Protocol v%u agreed (STM32 max v%u)", agreed, hello.version);
 }
 
 /**
- * @brief Validate packet
+ * @brief Handle baud rate proposal from STM32
+ *
+ * The ACK goes out at the old rate, then we switch and wait for
+ * CMD_BAUD_TEST at the new one. Without a valid test pattern within
+ * UART_BAUD_TRIAL_TIMEOUT_MS, both sides revert.
  */
-bool STM32Communicator::validatePacket(const uart_packet_t& packet) const {
-    // Check end byte
-    if (packet.end_byte != UART_END_BYTE) {
-        Serial.printf("[STM32] Invalid end byte: 0x%02X\n", packet.end_byte);
-        return false;
+void STM32Communicator::handleSetBaud(const UartFrameView& frame) {
+    baud_payload_t request;
+    memset(&request, 0, sizeof(request));
+    frame.copyTo(&request, 0, sizeof(request));
+
+    bool accept = !baudTrial && uart_baud_supported(request.baud_rate);
+
+    baud_payload_t response;
+    response.baud_rate = accept ? request.baud_rate : status.baudRate;
+    response.status = accept ? STATUS_SUCCESS : STATUS_INVALID;
+
+    sendResponse(RSP_BAUD_ACK, frame.sequence, &response, sizeof(response));
+
+    if (!accept) {
+        LOG_WARN("STM32", "Baud %u rejected", request.baud_rate);
+        return;
     }
 
-    // Validate checksum
-    uint8_t calculatedChecksum = uart_calculate_checksum(&packet);
-    if (calculatedChecksum != packet.checksum) {
-        Serial.printf("[STM32] Checksum error: calc=0x%02X recv=0x%02X\n",
-                      calculatedChecksum, packet.checksum);
-        const_cast<STM32Status&>(status).checksumErrors++;
-        const_cast<STM32Status&>(status).errorCount++;
-        return false;
+    previousBaud = status.baudRate;
+    switchBaud(request.baud_rate);
+    baudTrial = true;
+    baudTrialStart = millis();
+}
+
+/**
+ * @brief Handle test pattern at the new baud rate (echo it back)
+ */
+void STM32Communicator::handleBaudTest(const UartFrameView& frame) {
+    uint8_t pattern[UART_BAUD_TEST_LENGTH];
+    uint16_t length = frame.copyTo(pattern, 0, sizeof(pattern));
+
+    if (frame.length != UART_BAUD_TEST_LENGTH || !uart_check_baud_test(pattern, length)) {
+        LOG_WARN("STM32", "Baud test pattern mismatch");
+        status.errorCount++;
+        return;
     }
 
-    return true;
+    sendResponse(RSP_BAUD_TEST, frame.sequence, pattern, length);
+
+    if (baudTrial) {
+        baudTrial = false;
+        LOG_INFO("STM32", "Baud %u confirmed", status.baudRate);
+    }
 }
 
 /**
- * @brief Handle parsed packet (internal commands)
+ * @brief Baud trial timeout and error-rate / silence fallback
  */
-void STM32Communicator::handleParsedPacket(const uart_packet_t& packet) {
-    // This is where you'd handle specific commands
-    // For now, just log
-    switch (packet.cmd_type) {
-        case CMD_MQTT_PUBLISH:
-            Serial.println(F("[STM32] Received MQTT publish request"));
-            // Will be handled by user callback
-            break;
+void STM32Communicator::checkBaudHealth() {
+    uint32_t now = millis();
+
+    if (baudTrial) {
+        if (now - baudTrialStart > UART_BAUD_TRIAL_TIMEOUT_MS) {
+            LOG_WARN("STM32", "Baud %u test timeout, reverting", status.baudRate);
+            baudTrial = false;
+            status.baudFallbacks++;
+            switchBaud(previousBaud);
+        }
+        return;
+    }
 
-        case CMD_GET_TIME:
-            Serial.println(F("[STM32] Time request received"));
-            // Will be handled by user callback
-            break;
+    if (status.baudRate == UART_BAUD_BOOT) {
+        return;
+    }
 
-        case CMD_WIFI_STATUS:
-            Serial.println(F("[STM32] WiFi status request received"));
-            // Will be handled by user callback
-            break;
+    bool fallback = false;
 
-        default:
-            Serial.printf("[STM32] Unknown command: 0x%02X\n", packet.cmd_type);
-            sendAck(packet.sequence, STATUS_INVALID);
-            break;
+    if (now - errorWindowStart >= UART_BAUD_ERROR_WINDOW_MS) {
+        if (status.checksumErrors - errorWindowBase >= UART_BAUD_ERROR_THRESHOLD) {
+            LOG_ERROR("STM32", "%u checksum errors at %u baud",
+                          status.checksumErrors - errorWindowBase, status.baudRate);
+            fallback = true;
+        }
+        errorWindowStart = now;
+        errorWindowBase = status.checksumErrors;
+    }
+
+    // STM32 falls back on its own when it stops hearing us; follow it
+    if (now - status.lastHeartbeat > UART_BAUD_SILENCE_MS &&
+        now - baudChangedAt > UART_BAUD_SILENCE_MS) {
+        LOG_WARN("STM32", "Link silent at %u baud", status.baudRate);
+        fallback = true;
+    }
+
+    if (fallback) {
+        status.baudFallbacks++;
+        switchBaud(UART_BAUD_BOOT);
     }
 }
 
+/**
+ * @brief Change UART rate once TX has drained
+ */
+void STM32Communicator::switchBaud(uint32_t baudRate) {
+    flushTx();
+    Serial.updateBaudRate(baudRate);
+
+    status.baudRate = baudRate;
+    baudChangedAt = millis();
+    errorWindowStart = millis();
+    errorWindowBase = status.checksumErrors;
+
+    LOG_INFO("STM32", "UART baud rate %u", baudRate);
+}
+
 /**
  * @brief Update status
  */
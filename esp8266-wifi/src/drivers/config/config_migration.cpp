@@ -0,0 +1,81 @@
+/**
+ * @file config_migration.cpp
+ * @brief Config file schema migrations
+ */
+
+#include "drivers/config/config_migration.h"
+#include "utils/logger.h"
+
+typedef bool (*MigrationStep)(JsonDocument& doc);
+
+struct Migration {
+    uint8_t fromVersion;        // Step upgrades fromVersion -> fromVersion + 1
+    MigrationStep apply;
+    const char* description;
+};
+
+/**
+ * @brief Move a top-level key into a section (if the section lacks it)
+ */
+static void moveKey(JsonDocument& doc, const char* key, const char* section) {
+    if (!doc.containsKey(key)) return;
+
+    if (!doc[section].containsKey(key)) {
+        doc[section][key] = doc[key];
+    }
+    doc.remove(key);
+}
+
+/**
+ * @brief v0: files from before the version key, with the identity and
+ *        payload-format keys at the top level (as updates still accept)
+ */
+static bool migrateV0(JsonDocument& doc) {
+    moveKey(doc, "stationId", "device");
+    moveKey(doc, "deviceId", "device");
+    moveKey(doc, "serialNumber", "device");
+    moveKey(doc, "binaryPayload", "mqtt");
+    return true;
+}
+
+static const Migration MIGRATIONS[] = {
+    { 0, migrateV0, "unversioned file" },
+};
+
+namespace ConfigMigration {
+
+bool upgrade(JsonDocument& doc, uint8_t fromVersion) {
+    if (fromVersion > CONFIG_SCHEMA_VERSION) {
+        LOG_WARN("Config", "Config v%u is newer than v%u, loading known keys",
+                 fromVersion, CONFIG_SCHEMA_VERSION);
+        return true;
+    }
+
+    for (uint8_t version = fromVersion; version < CONFIG_SCHEMA_VERSION; version++) {
+        const Migration* step = nullptr;
+        for (const Migration& migration : MIGRATIONS) {
+            if (migration.fromVersion == version) {
+                step = &migration;
+                break;
+            }
+        }
+
+        if (!step) {
+            LOG_ERROR("Config", "No migration from config v%u", version);
+            return false;
+        }
+
+        if (!step->apply(doc) || doc.overflowed()) {
+            LOG_ERROR("Config", "Migration v%u -> v%u failed", version, version + 1);
+            return false;
+        }
+
+        LOG_INFO("Config", "Migrated config v%u -> v%u (%s)",
+                 version, version + 1, step->description);
+    }
+
+    doc["version"] = CONFIG_SCHEMA_VERSION;
+    return true;
+}
+
+} // namespace ConfigMigration
@@ -5,6 +5,9 @@
  */
 
 #include "drivers/config/unified_config.h"
+#include "drivers/config/config_migration.h"
+#include "utils/logger.h"
+#include "uart_protocol.h"
 #include <LittleFS.h>
 #include <ArduinoJson.h>
 #include <ESP8266WiFi.h>
@@ -12,13 +15,15 @@
 /* Configuration file paths */
 static constexpr const char* CONFIG_FILE = "/unified_config.json";
 static constexpr const char* BACKUP_FILE = "/unified_config.bak";
-static constexpr uint8_t CONFIG_VERSION = 1;
+static constexpr const char* SNAPSHOT_FILE = "/unified_config.bin";
+static constexpr const char* TMP_FILE = "/unified_config.tmp";
+static constexpr uint8_t CONFIG_VERSION = CONFIG_SCHEMA_VERSION;
 
 /**
  * @brief Constructor
  */
 UnifiedConfigManager::UnifiedConfigManager()
-    : initialized(false) {
+    : initialized(false), loadedVersion(0), dirtySections(0), firstDirtyAt(0), lastDirtyAt(0), pendingUpdates(0) {
     memset(&config, 0, sizeof(DeviceConfig));
     loadFactoryDefaults();
 }
@@ -29,24 +34,24 @@ UnifiedConfigManager::UnifiedConfigManager()
 bool UnifiedConfigManager::init() {
     if (initialized) return true;
 
-    Serial.println(F("[Config] Initializing unified config system..."));
+    LOG_INFO("Config", "Initializing unified config system...");
 
     // Initialize filesystem
     if (!LittleFS.begin()) {
-        Serial.println(F("[Config] Failed to mount LittleFS"));
+        LOG_ERROR("Config", "Failed to mount LittleFS");
         return false;
     }
 
     // Load configuration
     if (!load()) {
-        Serial.println(F("[Config] No saved config, using factory defaults"));
+        LOG_INFO("Config", "No saved config, using factory defaults");
         loadFactoryDefaults();
         save(); // Save defaults
     }
 
     initialized = true;
-    Serial.println(F("[Config] Config system initialized"));
-    printConfig();
+    LOG_INFO("Config", "Config system initialized: station=%s device=%s broker=%s:%u",
+             config.stationId, config.deviceId, config.mqtt.broker, config.mqtt.port);
 
     return true;
 }
@@ -55,9 +60,11 @@ bool UnifiedConfigManager::init() {
  * @brief Load factory defaults
  */
 void UnifiedConfigManager::loadFactoryDefaults() {
-    Serial.println(F("[Config] Loading factory defaults..."));
+    LOG_INFO("Config", "Loading factory defaults...");
 
+    uint16_t revision = config.identityRevision;
     memset(&config, 0, sizeof(DeviceConfig));
+    config.identityRevision = revision + 1;
 
     // Device identity (will be overwritten by MAC-based values)
     strncpy(config.stationId, "station001", sizeof(config.stationId));
@@ -70,6 +77,13 @@ void UnifiedConfigManager::loadFactoryDefaults() {
     config.wifi.autoConnect = true;
     strncpy(config.wifi.apNamePrefix, "SolEVC-Provision", sizeof(config.wifi.apNamePrefix));
     config.wifi.configPortalTimeout = 300; // 5 minutes
+    config.wifi.fastConnect = true;
+    config.wifi.staticIp[0] = '\0';    // DHCP
+    config.wifi.gateway[0] = '\0';
+    config.wifi.subnet[0] = '\0';
+    config.wifi.dns[0] = '\0';
+    config.wifi.powerSave = false;
+    config.wifi.listenInterval = 3;
 
     // MQTT defaults
     strncpy(config.mqtt.broker, "localhost", sizeof(config.mqtt.broker));
@@ -78,6 +92,7 @@ void UnifiedConfigManager::loadFactoryDefaults() {
     config.mqtt.password[0] = '\0';
     strncpy(config.mqtt.clientIdPrefix, "evse-", sizeof(config.mqtt.clientIdPrefix));
     config.mqtt.tlsEnabled = false;
+    config.mqtt.binaryPayload = false;
     config.mqtt.keepAlive = 60;
 
     // Provisioning defaults
@@ -97,6 +112,8 @@ void UnifiedConfigManager::loadFactoryDefaults() {
     config.system.otaEnabled = true;
     config.system.otaPassword[0] = '\0'; // Must be set by user!
     config.system.heartbeatInterval = 30000; // 30 seconds
+    config.system.heartbeatCoalesce = false;
+    config.system.heartbeatPiggyback = false;
     config.system.debugEnabled = true;
     config.system.logLevel = 2; // INFO
 
@@ -107,22 +124,140 @@ void UnifiedConfigManager::loadFactoryDefaults() {
     config.web.password[0] = '\0'; // Must be set by user!
     config.web.authRequired = true;
 
+    // Meter defaults (batching off: one publish per sample)
+    config.meter.batchEnabled = false;
+    config.meter.batchWindowMs = 1000;
+    config.meter.batchMaxSamples = 10;
+    config.meter.deadbandEnabled = false;
+    config.meter.keyframeIntervalMs = 60000; // 1 minute
+    config.meter.deadband.energyWh = 10;
+    config.meter.deadband.powerW = 50;
+    config.meter.deadband.voltageV = 2;
+    config.meter.deadband.currentA = 1;
+    config.meter.deadband.frequencyHz = 1;
+    config.meter.deadband.temperatureC = 1;
+    config.meter.deadband.powerFactorPct = 2;
+
     config.version = CONFIG_VERSION;
     config.isValid = validateConfig();
 }
 
 /**
- * @brief Load configuration from file
+ * @brief Load configuration (snapshot first, JSON as fallback)
  */
 bool UnifiedConfigManager::load() {
-    if (!LittleFS.exists(CONFIG_FILE)) {
-        Serial.println(F("[Config] Config file not found"));
+    if (loadSnapshot()) {
+        return config.isValid;
+    }
+
+    // Backup holds the previous copy if a save was interrupted
+    if (!loadJson(CONFIG_FILE) && !loadJson(BACKUP_FILE)) {
+        return false;
+    }
+
+    if (loadedVersion < CONFIG_VERSION) {
+        // Persist the migrated form so the steps run only once
+        save();
+    } else {
+        // Next boot skips the JSON parse
+        saveSnapshot();
+    }
+    return true;
+}
+
+/**
+ * @brief Load binary snapshot: one read, CRC check, one memcpy
+ */
+bool UnifiedConfigManager::loadSnapshot() {
+    uint32_t start = micros();
+
+    File file = LittleFS.open(SNAPSHOT_FILE, "r");
+    if (!file) return false;
+
+    struct {
+        config_snapshot_header_t header;
+        DeviceConfig image;
+    } snapshot;     // 12-byte header keeps the image aligned
+
+    size_t bytesRead = 0;
+    if (file.size() == sizeof(snapshot)) {
+        bytesRead = file.read((uint8_t*)&snapshot, sizeof(snapshot));
+    }
+    file.close();
+
+    const config_snapshot_header_t& header = snapshot.header;
+    if (bytesRead != sizeof(snapshot) ||
+        header.magic != CONFIG_SNAPSHOT_MAGIC ||
+        header.layout != CONFIG_SNAPSHOT_LAYOUT ||
+        header.size != sizeof(DeviceConfig) ||
+        header.schemaVersion != CONFIG_VERSION) {
+        LOG_WARN("Config", "Snapshot from another layout, using JSON");
+        return false;
+    }
+
+    if (uart_crc16_update(0xFFFF, (const uint8_t*)&snapshot.image, sizeof(DeviceConfig)) != header.crc) {
+        LOG_ERROR("Config", "Snapshot CRC mismatch, using JSON");
         return false;
     }
 
-    File file = LittleFS.open(CONFIG_FILE, "r");
+    uint16_t revision = config.identityRevision;
+    memcpy(&config, &snapshot.image, sizeof(DeviceConfig));
+    config.identityRevision = revision + 1;
+
+    sanitizeConfig();
+    config.isValid = validateConfig();
+
+    LOG_INFO("Config", "Snapshot loaded (%u bytes, %u us)",
+             (unsigned)sizeof(snapshot), (unsigned)(micros() - start));
+    return true;
+}
+
+/**
+ * @brief Write binary snapshot (temp file + rename, never half-written)
+ */
+bool UnifiedConfigManager::saveSnapshot() {
+    config_snapshot_header_t header;
+    header.magic = CONFIG_SNAPSHOT_MAGIC;
+    header.layout = CONFIG_SNAPSHOT_LAYOUT;
+    header.schemaVersion = CONFIG_VERSION;
+    header.size = sizeof(DeviceConfig);
+    header.crc = uart_crc16_update(0xFFFF, (const uint8_t*)&config, sizeof(DeviceConfig));
+    header.reserved = 0;
+
+    File file = LittleFS.open(TMP_FILE, "w");
+    bool ok = (bool)file;
+    if (ok) {
+        ok = file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+             file.write((const uint8_t*)&config, sizeof(DeviceConfig)) == sizeof(DeviceConfig);
+        file.close();
+    }
+
+    if (ok) {
+        ok = LittleFS.rename(TMP_FILE, SNAPSHOT_FILE);
+    }
+
+    if (!ok) {
+        // A stale snapshot would shadow the JSON copy on the next boot
+        LOG_ERROR("Config", "Failed to write config snapshot");
+        LittleFS.remove(TMP_FILE);
+        LittleFS.remove(SNAPSHOT_FILE);
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Load configuration from a JSON file
+ */
+bool UnifiedConfigManager::loadJson(const char* path) {
+    if (!LittleFS.exists(path)) {
+        LOG_WARN("Config", "Config file not found: %s", path);
+        return false;
+    }
+
+    File file = LittleFS.open(path, "r");
     if (!file) {
-        Serial.println(F("[Config] Failed to open config file"));
+        LOG_ERROR("Config", "Failed to open config file");
         return false;
     }
 
@@ -132,17 +267,16 @@ bool UnifiedConfigManager::load() {
     file.close();
 
     if (error) {
-        Serial.printf("[Config] JSON parse error: %s\n", error.c_str());
+        LOG_ERROR("Config", "JSON parse error: %s", error.c_str());
         return false;
     }
 
-    // Check version
+    // Older schemas are upgraded in place, newer ones load their known keys
     uint8_t fileVersion = doc["version"] | 0;
-    if (fileVersion != CONFIG_VERSION) {
-        Serial.printf("[Config] Config version mismatch: %d vs %d\n", fileVersion, CONFIG_VERSION);
-        // TODO: Implement migration logic here
+    if (!ConfigMigration::upgrade(doc, fileVersion)) {
         return false;
     }
+    loadedVersion = fileVersion;
 
     // Load device identity
     strncpy(config.stationId, doc["device"]["stationId"] | "station001", sizeof(config.stationId));
@@ -155,6 +289,13 @@ bool UnifiedConfigManager::load() {
     config.wifi.autoConnect = doc["wifi"]["autoConnect"] | true;
     strncpy(config.wifi.apNamePrefix, doc["wifi"]["apNamePrefix"] | "SolEVC-Provision", sizeof(config.wifi.apNamePrefix));
     config.wifi.configPortalTimeout = doc["wifi"]["configPortalTimeout"] | 300;
+    config.wifi.fastConnect = doc["wifi"]["fastConnect"] | true;
+    strncpy(config.wifi.staticIp, doc["wifi"]["staticIp"] | "", sizeof(config.wifi.staticIp));
+    strncpy(config.wifi.gateway, doc["wifi"]["gateway"] | "", sizeof(config.wifi.gateway));
+    strncpy(config.wifi.subnet, doc["wifi"]["subnet"] | "", sizeof(config.wifi.subnet));
+    strncpy(config.wifi.dns, doc["wifi"]["dns"] | "", sizeof(config.wifi.dns));
+    config.wifi.powerSave = doc["wifi"]["powerSave"] | false;
+    config.wifi.listenInterval = doc["wifi"]["listenInterval"] | 3;
 
     // Load MQTT config
     strncpy(config.mqtt.broker, doc["mqtt"]["broker"] | "localhost", sizeof(config.mqtt.broker));
@@ -164,6 +305,7 @@ bool UnifiedConfigManager::load() {
     strncpy(config.mqtt.clientIdPrefix, doc["mqtt"]["clientIdPrefix"] | "evse-", sizeof(config.mqtt.clientIdPrefix));
     config.mqtt.tlsEnabled = doc["mqtt"]["tlsEnabled"] | false;
     config.mqtt.keepAlive = doc["mqtt"]["keepAlive"] | 60;
+    config.mqtt.binaryPayload = doc["mqtt"]["binaryPayload"] | false;
 
     // Load provisioning config
     strncpy(config.provisioning.serverUrl, doc["provisioning"]["serverUrl"] | "", sizeof(config.provisioning.serverUrl));
@@ -176,6 +318,8 @@ bool UnifiedConfigManager::load() {
     config.system.otaEnabled = doc["system"]["otaEnabled"] | true;
     strncpy(config.system.otaPassword, doc["system"]["otaPassword"] | "", sizeof(config.system.otaPassword));
     config.system.heartbeatInterval = doc["system"]["heartbeatInterval"] | 30000;
+    config.system.heartbeatCoalesce = doc["system"]["heartbeatCoalesce"] | false;
+    config.system.heartbeatPiggyback = doc["system"]["heartbeatPiggyback"] | false;
     config.system.debugEnabled = doc["system"]["debugEnabled"] | true;
     config.system.logLevel = doc["system"]["logLevel"] | 2;
 
@@ -186,23 +330,91 @@ bool UnifiedConfigManager::load() {
     strncpy(config.web.password, doc["web"]["password"] | "", sizeof(config.web.password));
     config.web.authRequired = doc["web"]["authRequired"] | true;
 
+    // Load meter config
+    config.meter.batchEnabled = doc["meter"]["batchEnabled"] | false;
+    config.meter.batchWindowMs = doc["meter"]["batchWindowMs"] | 1000;
+    config.meter.batchMaxSamples = doc["meter"]["batchMaxSamples"] | 10;
+    config.meter.deadbandEnabled = doc["meter"]["deadbandEnabled"] | false;
+    config.meter.keyframeIntervalMs = doc["meter"]["keyframeIntervalMs"] | 60000;
+    config.meter.deadband.energyWh = doc["meter"]["deadband"]["energyWh"] | 10;
+    config.meter.deadband.powerW = doc["meter"]["deadband"]["powerW"] | 50;
+    config.meter.deadband.voltageV = doc["meter"]["deadband"]["voltageV"] | 2;
+    config.meter.deadband.currentA = doc["meter"]["deadband"]["currentA"] | 1;
+    config.meter.deadband.frequencyHz = doc["meter"]["deadband"]["frequencyHz"] | 1;
+    config.meter.deadband.temperatureC = doc["meter"]["deadband"]["temperatureC"] | 1;
+    config.meter.deadband.powerFactorPct = doc["meter"]["deadband"]["powerFactorPct"] | 2;
+
     config.version = CONFIG_VERSION;
+    config.identityRevision++;
     sanitizeConfig();
     config.isValid = validateConfig();
 
-    Serial.println(F("[Config] Configuration loaded successfully"));
+    LOG_INFO("Config", "Configuration loaded from %s", path);
     return config.isValid;
 }
 
 /**
- * @brief Save configuration to file
+ * @brief Save configuration (snapshot and JSON copy)
  */
 bool UnifiedConfigManager::save() {
     if (!validateConfig()) {
-        Serial.println(F("[Config] Cannot save invalid config"));
+        LOG_ERROR("Config", "Cannot save invalid config");
+        return false;
+    }
+
+    bool snapshotOk = saveSnapshot();
+    bool jsonOk = saveJson();
+
+    // Either copy is enough to boot with this config
+    if (!snapshotOk && !jsonOk) {
         return false;
     }
 
+    if (dirtySections) {
+        LOG_INFO("Config", "Saved sections 0x%02X (%u updates coalesced)",
+                 dirtySections, pendingUpdates);
+    }
+    dirtySections = 0;
+    pendingUpdates = 0;
+    return true;
+}
+
+/**
+ * @brief Write coalesced changes once they settle
+ */
+void UnifiedConfigManager::handle() {
+    if (!dirtySections) return;
+
+    uint32_t now = millis();
+    if (now - lastDirtyAt < CONFIG_SAVE_DEBOUNCE_MS &&
+        now - firstDirtyAt < CONFIG_SAVE_MAX_DELAY_MS) {
+        return;
+    }
+
+    if (!save()) {
+        // Keep the changes pending, retry after another debounce period
+        lastDirtyAt = now;
+        firstDirtyAt = now;
+    }
+}
+
+/**
+ * @brief Record changed sections, the write happens in handle()
+ */
+void UnifiedConfigManager::markDirty(uint8_t sections) {
+    uint32_t now = millis();
+    if (!dirtySections) {
+        firstDirtyAt = now;
+    }
+    dirtySections |= sections;
+    lastDirtyAt = now;
+    pendingUpdates++;
+}
+
+/**
+ * @brief Save configuration to JSON file
+ */
+bool UnifiedConfigManager::saveJson() {
     // Create JSON document (static allocation)
     StaticJsonDocument<2048> doc;
 
@@ -219,6 +431,13 @@ bool UnifiedConfigManager::save() {
     doc["wifi"]["autoConnect"] = config.wifi.autoConnect;
     doc["wifi"]["apNamePrefix"] = config.wifi.apNamePrefix;
     doc["wifi"]["configPortalTimeout"] = config.wifi.configPortalTimeout;
+    doc["wifi"]["fastConnect"] = config.wifi.fastConnect;
+    doc["wifi"]["staticIp"] = config.wifi.staticIp;
+    doc["wifi"]["gateway"] = config.wifi.gateway;
+    doc["wifi"]["subnet"] = config.wifi.subnet;
+    doc["wifi"]["dns"] = config.wifi.dns;
+    doc["wifi"]["powerSave"] = config.wifi.powerSave;
+    doc["wifi"]["listenInterval"] = config.wifi.listenInterval;
 
     // MQTT config
     doc["mqtt"]["broker"] = config.mqtt.broker;
@@ -228,6 +447,7 @@ bool UnifiedConfigManager::save() {
     doc["mqtt"]["clientIdPrefix"] = config.mqtt.clientIdPrefix;
     doc["mqtt"]["tlsEnabled"] = config.mqtt.tlsEnabled;
     doc["mqtt"]["keepAlive"] = config.mqtt.keepAlive;
+    doc["mqtt"]["binaryPayload"] = config.mqtt.binaryPayload;
 
     // Provisioning config
     doc["provisioning"]["serverUrl"] = config.provisioning.serverUrl;
@@ -240,6 +460,8 @@ bool UnifiedConfigManager::save() {
     doc["system"]["otaEnabled"] = config.system.otaEnabled;
     doc["system"]["otaPassword"] = config.system.otaPassword;
     doc["system"]["heartbeatInterval"] = config.system.heartbeatInterval;
+    doc["system"]["heartbeatCoalesce"] = config.system.heartbeatCoalesce;
+    doc["system"]["heartbeatPiggyback"] = config.system.heartbeatPiggyback;
     doc["system"]["debugEnabled"] = config.system.debugEnabled;
     doc["system"]["logLevel"] = config.system.logLevel;
 
@@ -250,18 +472,24 @@ bool UnifiedConfigManager::save() {
     doc["web"]["password"] = config.web.password;
     doc["web"]["authRequired"] = config.web.authRequired;
 
-    // Backup existing config
-    if (LittleFS.exists(CONFIG_FILE)) {
-        if (LittleFS.exists(BACKUP_FILE)) {
-            LittleFS.remove(BACKUP_FILE);
-        }
-        LittleFS.rename(CONFIG_FILE, BACKUP_FILE);
-    }
-
-    // Save to file
-    File file = LittleFS.open(CONFIG_FILE, "w");
+    // Meter config
+    doc["meter"]["batchEnabled"] = config.meter.batchEnabled;
+    doc["meter"]["batchWindowMs"] = config.meter.batchWindowMs;
+    doc["meter"]["batchMaxSamples"] = config.meter.batchMaxSamples;
+    doc["meter"]["deadbandEnabled"] = config.meter.deadbandEnabled;
+    doc["meter"]["keyframeIntervalMs"] = config.meter.keyframeIntervalMs;
+    doc["meter"]["deadband"]["energyWh"] = config.meter.deadband.energyWh;
+    doc["meter"]["deadband"]["powerW"] = config.meter.deadband.powerW;
+    doc["meter"]["deadband"]["voltageV"] = config.meter.deadband.voltageV;
+    doc["meter"]["deadband"]["currentA"] = config.meter.deadband.currentA;
+    doc["meter"]["deadband"]["frequencyHz"] = config.meter.deadband.frequencyHz;
+    doc["meter"]["deadband"]["temperatureC"] = config.meter.deadband.temperatureC;
+    doc["meter"]["deadband"]["powerFactorPct"] = config.meter.deadband.powerFactorPct;
+
+    // Write the new copy completely before touching the current one
+    File file = LittleFS.open(TMP_FILE, "w");
     if (!file) {
-        Serial.println(F("[Config] Failed to open config file for writing"));
+        LOG_ERROR("Config", "Failed to open config file for writing");
         return false;
     }
 
@@ -269,15 +497,24 @@ bool UnifiedConfigManager::save() {
     file.close();
 
     if (bytesWritten == 0) {
-        Serial.println(F("[Config] Failed to write config"));
-        // Restore backup
+        LOG_ERROR("Config", "Failed to write config");
+        LittleFS.remove(TMP_FILE);
+        return false;
+    }
+
+    // Swap: current -> backup, new -> current
+    if (LittleFS.exists(CONFIG_FILE)) {
         if (LittleFS.exists(BACKUP_FILE)) {
-            LittleFS.rename(BACKUP_FILE, CONFIG_FILE);
+            LittleFS.remove(BACKUP_FILE);
         }
+        LittleFS.rename(CONFIG_FILE, BACKUP_FILE);
+    }
+    if (!LittleFS.rename(TMP_FILE, CONFIG_FILE)) {
+        LOG_ERROR("Config", "Failed to replace config file");
         return false;
     }
 
-    Serial.printf("[Config] Configuration saved (%u bytes)\n", bytesWritten);
+    LOG_INFO("Config", "Configuration saved (%u bytes)", bytesWritten);
     return true;
 }
 
@@ -285,7 +522,7 @@ bool UnifiedConfigManager::save() {
  * @brief Reset to factory defaults
  */
 bool UnifiedConfigManager::resetToDefaults() {
-    Serial.println(F("[Config] Resetting to factory defaults..."));
+    LOG_INFO("Config", "Resetting to factory defaults...");
 
     // Delete config files
     if (LittleFS.exists(CONFIG_FILE)) {
@@ -294,9 +531,14 @@ bool UnifiedConfigManager::resetToDefaults() {
     if (LittleFS.exists(BACKUP_FILE)) {
         LittleFS.remove(BACKUP_FILE);
     }
+    if (LittleFS.exists(SNAPSHOT_FILE)) {
+        LittleFS.remove(SNAPSHOT_FILE);
+    }
 
     // Load defaults
     loadFactoryDefaults();
+    dirtySections = 0;
+    pendingUpdates = 0;
 
     // Save defaults
     return save();
@@ -308,30 +550,40 @@ bool UnifiedConfigManager::resetToDefaults() {
 bool UnifiedConfigManager::validateConfig() const {
     // Check required fields
     if (strlen(config.stationId) == 0) {
-        Serial.println(F("[Config] Validation failed: stationId required"));
+        LOG_ERROR("Config", "Validation failed: stationId required");
         return false;
     }
 
     if (strlen(config.deviceId) == 0) {
-        Serial.println(F("[Config] Validation failed: deviceId required"));
+        LOG_ERROR("Config", "Validation failed: deviceId required");
         return false;
     }
 
     if (strlen(config.mqtt.broker) == 0) {
-        Serial.println(F("[Config] Validation failed: MQTT broker required"));
+        LOG_ERROR("Config", "Validation failed: MQTT broker required");
         return false;
     }
 
     if (config.mqtt.port == 0 || config.mqtt.port > 65535) {
-        Serial.println(F("[Config] Validation failed: Invalid MQTT port"));
+        LOG_ERROR("Config", "Validation failed: Invalid MQTT port");
         return false;
     }
 
     if (config.system.heartbeatInterval < 1000 || config.system.heartbeatInterval > 300000) {
-        Serial.println(F("[Config] Validation failed: Invalid heartbeat interval"));
+        LOG_ERROR("Config", "Validation failed: Invalid heartbeat interval");
         return false;
     }
 
+    if (strlen(config.wifi.staticIp) > 0) {
+        IPAddress ip;
+        if (!ip.fromString(config.wifi.staticIp) || !ip.fromString(config.wifi.gateway) ||
+            !ip.fromString(config.wifi.subnet) ||
+            (strlen(config.wifi.dns) > 0 && !ip.fromString(config.wifi.dns))) {
+            LOG_ERROR("Config", "Validation failed: Invalid static IP settings");
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -343,39 +595,95 @@ void UnifiedConfigManager::sanitizeConfig() {
     config.stationId[sizeof(config.stationId) - 1] = '\0';
     config.deviceId[sizeof(config.deviceId) - 1] = '\0';
     config.serialNumber[sizeof(config.serialNumber) - 1] = '\0';
+    config.wifi.staticIp[sizeof(config.wifi.staticIp) - 1] = '\0';
+    config.wifi.gateway[sizeof(config.wifi.gateway) - 1] = '\0';
+    config.wifi.subnet[sizeof(config.wifi.subnet) - 1] = '\0';
+    config.wifi.dns[sizeof(config.wifi.dns) - 1] = '\0';
 
     // Clamp values
     if (config.mqtt.port == 0) config.mqtt.port = 1883;
     if (config.system.heartbeatInterval < 1000) config.system.heartbeatInterval = 30000;
     if (config.system.logLevel > 3) config.system.logLevel = 2;
+    if (config.wifi.listenInterval == 0 || config.wifi.listenInterval > 10) config.wifi.listenInterval = 3;
+    if (config.meter.batchWindowMs < 100) config.meter.batchWindowMs = 1000;
+    if (config.meter.batchMaxSamples == 0) config.meter.batchMaxSamples = 10;
+    if (config.meter.keyframeIntervalMs < 1000) config.meter.keyframeIntervalMs = 60000;
 }
 
 /**
  * @brief Print configuration
  */
 void UnifiedConfigManager::printConfig() const {
-    Serial.println(F("\n=== Device Configuration ==="));
-    Serial.printf("Station ID: %s\n", config.stationId);
-    Serial.printf("Device ID: %s\n", config.deviceId);
-    Serial.printf("Serial: %s\n", config.serialNumber);
-
-    Serial.println(F("\n--- WiFi ---"));
-    Serial.printf("SSID: %s\n", strlen(config.wifi.ssid) > 0 ? config.wifi.ssid : "(not configured)");
-    Serial.printf("Auto-connect: %s\n", config.wifi.autoConnect ? "Yes" : "No");
-    Serial.printf("AP Prefix: %s\n", config.wifi.apNamePrefix);
-
-    Serial.println(F("\n--- MQTT ---"));
-    Serial.printf("Broker: %s:%d\n", config.mqtt.broker, config.mqtt.port);
-    Serial.printf("Username: %s\n", strlen(config.mqtt.username) > 0 ? config.mqtt.username : "(none)");
-    Serial.printf("TLS: %s\n", config.mqtt.tlsEnabled ? "Enabled" : "Disabled");
-
-    Serial.println(F("\n--- System ---"));
-    Serial.printf("OTA: %s\n", config.system.otaEnabled ? "Enabled" : "Disabled");
-    Serial.printf("Heartbeat: %u ms\n", config.system.heartbeatInterval);
-    Serial.printf("Debug: %s\n", config.system.debugEnabled ? "Yes" : "No");
-
-    Serial.printf("\nConfig valid: %s\n", config.isValid ? "Yes" : "No");
-    Serial.println(F("============================\n"));
+    // Multi-line dump, written directly to the log output
+    Print& out = Logger::getInstance().getOutput();
+
+    out.println(F("\n=== Device Configuration ==="));
+    out.printf("Station ID: %s\n", config.stationId);
+    out.printf("Device ID: %s\n", config.deviceId);
+    out.printf("Serial: %s\n", config.serialNumber);
+
+    out.println(F("\n--- WiFi ---"));
+    out.printf("SSID: %s\n", strlen(config.wifi.ssid) > 0 ? config.wifi.ssid : "(not configured)");
+    out.printf("Auto-connect: %s\n", config.wifi.autoConnect ? "Yes" : "No");
+    out.printf("AP Prefix: %s\n", config.wifi.apNamePrefix);
+    out.printf("Fast connect: %s\n", config.wifi.fastConnect ? "Yes" : "No");
+    out.printf("IP: %s\n", strlen(config.wifi.staticIp) > 0 ? config.wifi.staticIp : "DHCP");
+    out.printf("Power save: %s (listen interval %u)\n", config.wifi.powerSave ? "Yes" : "No",
+               config.wifi.listenInterval);
+
+    out.println(F("\n--- MQTT ---"));
+    out.printf("Broker: %s:%d\n", config.mqtt.broker, config.mqtt.port);
+    out.printf("Username: %s\n", strlen(config.mqtt.username) > 0 ? config.mqtt.username : "(none)");
+    out.printf("TLS: %s\n", config.mqtt.tlsEnabled ? "Enabled" : "Disabled");
+    out.printf("Payload: %s\n", config.mqtt.binaryPayload ? "MessagePack" : "JSON");
+
+    out.println(F("\n--- System ---"));
+    out.printf("OTA: %s\n", config.system.otaEnabled ? "Enabled" : "Disabled");
+    out.printf("Heartbeat: %u ms (coalesce: %s, piggyback: %s)\n", config.system.heartbeatInterval,
+                  config.system.heartbeatCoalesce ? "Yes" : "No",
+                  config.system.heartbeatPiggyback ? "Yes" : "No");
+    out.printf("Debug: %s\n", config.system.debugEnabled ? "Yes" : "No");
+
+    out.println(F("\n--- Meter ---"));
+    out.printf("Batching: %s (%u ms, %u samples)\n",
+                  config.meter.batchEnabled ? "Enabled" : "Disabled",
+                  config.meter.batchWindowMs, config.meter.batchMaxSamples);
+    out.printf("Deadband: %s (keyframe %u ms)\n",
+                  config.meter.deadbandEnabled ? "Enabled" : "Disabled",
+                  config.meter.keyframeIntervalMs);
+
+    out.printf("\nConfig valid: %s\n", config.isValid ? "Yes" : "No");
+    out.println(F("============================\n"));
+}
+
+/**
+ * @brief Field-level patch helpers: apply a key only if present and report
+ *        whether the stored value actually changed
+ */
+static bool patchString(char* field, size_t size, JsonVariantConst value) {
+    if (!value.is<const char*>()) return false;
+
+    const char* str = value.as<const char*>();
+    if (strncmp(field, str, size - 1) == 0) return false;
+
+    strncpy(field, str, size - 1);
+    field[size - 1] = '\0';
+    return true;
+}
+
+template <typename T>
+static bool patchValue(T& field, JsonVariantConst value) {
+    if (!value.is<T>()) return false;
+
+    T newValue = value.as<T>();
+    if (newValue == field) return false;
+
+    field = newValue;
+    return true;
+}
+
+static uint8_t patchSection(uint8_t section, bool changed) {
+    return changed ? section : 0;
 }
 
 /**
@@ -383,37 +691,125 @@ void UnifiedConfigManager::printConfig() const {
  */
 bool UnifiedConfigManager::updateFromJson(const char* jsonStr) {
     if (!jsonStr) return false;
+    return updateFromJson(jsonStr, strlen(jsonStr));
+}
 
-    StaticJsonDocument<1024> doc;
-    DeserializationError error = deserializeJson(doc, jsonStr);
+bool UnifiedConfigManager::updateFromJson(const char* json, size_t length) {
+    if (!json) return false;
+
+    StaticJsonDocument<1536> doc;
+    DeserializationError error = deserializeJson(doc, json, length);
 
     if (error) {
-        Serial.printf("[Config] JSON parse error: %s\n", error.c_str());
+        LOG_ERROR("Config", "JSON parse error: %s", error.c_str());
         return false;
     }
 
-    // Update only provided fields (partial update)
-    bool changed = false;
-
-    if (doc.containsKey("stationId")) {
-        strncpy(config.stationId, doc["stationId"], sizeof(config.stationId));
-        changed = true;
+    // Rolled back if the patched config does not validate
+    DeviceConfig previous = config;
+    uint8_t changed = 0;
+
+    // Same layout as the config file; stationId/deviceId/binaryPayload are
+    // also accepted at the top level (older senders). Patches are joined
+    // with | rather than || so every present field is applied.
+    JsonVariantConst device = doc["device"];
+    changed |= patchSection(CONFIG_SECTION_DEVICE,
+        patchString(config.stationId, sizeof(config.stationId), doc["stationId"]) |
+        patchString(config.deviceId, sizeof(config.deviceId), doc["deviceId"]) |
+        patchString(config.stationId, sizeof(config.stationId), device["stationId"]) |
+        patchString(config.deviceId, sizeof(config.deviceId), device["deviceId"]) |
+        patchString(config.serialNumber, sizeof(config.serialNumber), device["serialNumber"]));
+
+    JsonVariantConst wifi = doc["wifi"];
+    changed |= patchSection(CONFIG_SECTION_WIFI,
+        patchString(config.wifi.ssid, sizeof(config.wifi.ssid), wifi["ssid"]) |
+        patchString(config.wifi.password, sizeof(config.wifi.password), wifi["password"]) |
+        patchValue(config.wifi.autoConnect, wifi["autoConnect"]) |
+        patchString(config.wifi.apNamePrefix, sizeof(config.wifi.apNamePrefix), wifi["apNamePrefix"]) |
+        patchValue(config.wifi.configPortalTimeout, wifi["configPortalTimeout"]) |
+        patchValue(config.wifi.fastConnect, wifi["fastConnect"]) |
+        patchString(config.wifi.staticIp, sizeof(config.wifi.staticIp), wifi["staticIp"]) |
+        patchString(config.wifi.gateway, sizeof(config.wifi.gateway), wifi["gateway"]) |
+        patchString(config.wifi.subnet, sizeof(config.wifi.subnet), wifi["subnet"]) |
+        patchString(config.wifi.dns, sizeof(config.wifi.dns), wifi["dns"]) |
+        patchValue(config.wifi.powerSave, wifi["powerSave"]) |
+        patchValue(config.wifi.listenInterval, wifi["listenInterval"]));
+
+    JsonVariantConst mqtt = doc["mqtt"];
+    changed |= patchSection(CONFIG_SECTION_MQTT,
+        patchValue(config.mqtt.binaryPayload, doc["binaryPayload"]) |
+        patchString(config.mqtt.broker, sizeof(config.mqtt.broker), mqtt["broker"]) |
+        patchValue(config.mqtt.port, mqtt["port"]) |
+        patchString(config.mqtt.username, sizeof(config.mqtt.username), mqtt["username"]) |
+        patchString(config.mqtt.password, sizeof(config.mqtt.password), mqtt["password"]) |
+        patchString(config.mqtt.clientIdPrefix, sizeof(config.mqtt.clientIdPrefix), mqtt["clientIdPrefix"]) |
+        patchValue(config.mqtt.tlsEnabled, mqtt["tlsEnabled"]) |
+        patchValue(config.mqtt.keepAlive, mqtt["keepAlive"]) |
+        patchValue(config.mqtt.binaryPayload, mqtt["binaryPayload"]));
+
+    JsonVariantConst provisioning = doc["provisioning"];
+    changed |= patchSection(CONFIG_SECTION_PROVISIONING,
+        patchString(config.provisioning.serverUrl, sizeof(config.provisioning.serverUrl), provisioning["serverUrl"]) |
+        patchValue(config.provisioning.serverPort, provisioning["serverPort"]) |
+        patchValue(config.provisioning.timeoutMs, provisioning["timeoutMs"]) |
+        patchValue(config.provisioning.maxRetries, provisioning["maxRetries"]) |
+        patchValue(config.provisioning.retryIntervalMs, provisioning["retryIntervalMs"]));
+
+    JsonVariantConst system = doc["system"];
+    changed |= patchSection(CONFIG_SECTION_SYSTEM,
+        patchValue(config.system.otaEnabled, system["otaEnabled"]) |
+        patchString(config.system.otaPassword, sizeof(config.system.otaPassword), system["otaPassword"]) |
+        patchValue(config.system.heartbeatInterval, system["heartbeatInterval"]) |
+        patchValue(config.system.heartbeatCoalesce, system["heartbeatCoalesce"]) |
+        patchValue(config.system.heartbeatPiggyback, system["heartbeatPiggyback"]) |
+        patchValue(config.system.debugEnabled, system["debugEnabled"]) |
+        patchValue(config.system.logLevel, system["logLevel"]));
+
+    JsonVariantConst web = doc["web"];
+    changed |= patchSection(CONFIG_SECTION_WEB,
+        patchValue(config.web.enabled, web["enabled"]) |
+        patchValue(config.web.port, web["port"]) |
+        patchString(config.web.username, sizeof(config.web.username), web["username"]) |
+        patchString(config.web.password, sizeof(config.web.password), web["password"]) |
+        patchValue(config.web.authRequired, web["authRequired"]));
+
+    JsonVariantConst meter = doc["meter"];
+    JsonVariantConst deadband = meter["deadband"];
+    changed |= patchSection(CONFIG_SECTION_METER,
+        patchValue(config.meter.batchEnabled, meter["batchEnabled"]) |
+        patchValue(config.meter.batchWindowMs, meter["batchWindowMs"]) |
+        patchValue(config.meter.batchMaxSamples, meter["batchMaxSamples"]) |
+        patchValue(config.meter.deadbandEnabled, meter["deadbandEnabled"]) |
+        patchValue(config.meter.keyframeIntervalMs, meter["keyframeIntervalMs"]) |
+        patchValue(config.meter.deadband.energyWh, deadband["energyWh"]) |
+        patchValue(config.meter.deadband.powerW, deadband["powerW"]) |
+        patchValue(config.meter.deadband.voltageV, deadband["voltageV"]) |
+        patchValue(config.meter.deadband.currentA, deadband["currentA"]) |
+        patchValue(config.meter.deadband.frequencyHz, deadband["frequencyHz"]) |
+        patchValue(config.meter.deadband.temperatureC, deadband["temperatureC"]) |
+        patchValue(config.meter.deadband.powerFactorPct, deadband["powerFactorPct"]));
+
+    if (!changed) {
+        LOG_DEBUG("Config", "Update has no changes");
+        return true;
     }
 
-    if (doc.containsKey("deviceId")) {
-        strncpy(config.deviceId, doc["deviceId"], sizeof(config.deviceId));
-        changed = true;
+    sanitizeConfig();
+    if (!validateConfig()) {
+        LOG_ERROR("Config", "Update rejected, config restored");
+        config = previous;
+        return false;
     }
+    config.isValid = true;
 
-    // Add more fields as needed...
-
-    if (changed) {
-        sanitizeConfig();
-        config.isValid = validateConfig();
-        return save();
+    // Identity may have changed, invalidate cached topic prefixes
+    if (changed & CONFIG_SECTION_DEVICE) {
+        config.identityRevision++;
     }
 
-    return false;
+    markDirty(changed);
+    LOG_INFO("Config", "Updated sections 0x%02X, write pending", changed);
+    return true;
 }
 
 /**
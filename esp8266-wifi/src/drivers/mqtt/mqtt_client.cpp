@@ -6,6 +6,12 @@
 
 #include "drivers/mqtt/mqtt_client.h"
 #include "drivers/mqtt/mqtt_topic_builder.h"
+#include "utils/logger.h"
+#include <Schedule.h>
+#include <LittleFS.h>
+
+// PUBLISH fixed header redelivery flag (PubSubClient has no constant for it)
+#define MQTT_DUP_FLAG   0x08
 
 // Static instance for callback
 MQTTClient* MQTTClient::instance = nullptr;
@@ -15,8 +21,28 @@ MQTTClient* MQTTClient::instance = nullptr;
  */
 MQTTClient::MQTTClient(const DeviceConfig& cfg)
     : config(cfg),
-      client(cfg.mqtt.tlsEnabled ? (Client&)wifiSecureClient : (Client&)wifiClient),
-      userCallback(nullptr) {
+      trustMode(MQTTTrustMode::INSECURE),
+      mflnSupported(-1),
+      timeSource(nullptr),
+      tap(cfg.mqtt.tlsEnabled ? (Client&)wifiSecureClient : (Client&)wifiClient),
+      client(tap),
+      lanes{{JOURNAL_ROOT_DIR "/0", MQTT_JOURNAL_SEGMENTS_TRANSACTION},
+            {JOURNAL_ROOT_DIR "/1", MQTT_JOURNAL_SEGMENTS_STATUS},
+            {JOURNAL_ROOT_DIR "/2", MQTT_JOURNAL_SEGMENTS_TELEMETRY}},
+      lastDrain(0),
+      reconnectPolicy(MQTT_RECONNECT_BASE_MS, MQTT_RECONNECT_MAX_MS, ESP.getChipId() ^ 0x4D515454),
+      reconnectAttempts(0),
+      lastReconnectAttempt(0),
+      reconnectDelay(0),
+      connectStage(MQTTConnectStage::IDLE),
+      inflightHead(0),
+      inflightCount(0),
+      nextPacketId(1),
+      userCallback(nullptr),
+      deliveryCallback(nullptr),
+      idleCallback(nullptr),
+      handshakeCallback(nullptr),
+      handshaking(false) {
 
     // Initialize status
     memset(&status, 0, sizeof(MQTTStatus));
@@ -27,18 +53,31 @@ MQTTClient::MQTTClient(const DeviceConfig& cfg)
     // Configure MQTT client
     client.setServer(config.mqtt.broker, config.mqtt.port);
     client.setCallback(staticCallback);
-    client.setBufferSize(512); // Reduced from 1024 for ESP8266
+    client.setBufferSize(MQTT_BUFFER_SIZE); // Reduced from 1024 for ESP8266
     client.setKeepAlive(config.mqtt.keepAlive);
+    client.setSocketTimeout(MQTT_CONNACK_TIMEOUT_S);
+
+    // Bound the TCP/TLS connect: the one stage the idle hook cannot cover
+    wifiClient.setTimeout(MQTT_TCP_TIMEOUT_MS);
+    wifiSecureClient.setTimeout(MQTT_TLS_TIMEOUT_MS);
 
-    // Set TLS to insecure for now (TODO: proper certificates)
+    // Offline journals and trust anchors (LittleFS already mounted by config manager)
     if (config.mqtt.tlsEnabled) {
-        wifiSecureClient.setInsecure();
+        loadTrust();
+        // Session resumption skips the key exchange on reconnect
+        wifiSecureClient.setSession(&tlsSession);
+    }
+
+    for (uint8_t i = 0; i < MQTT_PRIORITY_COUNT; i++) {
+        if (!lanes[i].journal.init()) {
+            LOG_WARN("MQTT", "Offline journal %u unavailable, using RAM queue", i);
+        }
     }
 
     // Set static instance for callback
     instance = this;
 
-    Serial.printf("[MQTT] Initialized - Broker: %s:%d, ClientID: %s\n",
+    LOG_INFO("MQTT", "Initialized - Broker: %s:%d, ClientID: %s",
                   config.mqtt.broker, config.mqtt.port, clientId);
 }
 
@@ -58,10 +97,158 @@ MQTTError MQTTClient::connect() {
         return MQTTError::SUCCESS;
     }
 
-    Serial.println(F("[MQTT] Attempting connection..."));
+    LOG_INFO("MQTT", "Attempting connection...");
+
+    connectStage = MQTTConnectStage::IDLE;
+    if (!openTransport()) {
+        connectFailed(MQTT_CONNECT_FAILED);
+        return MQTTError::CONNECTION_FAILED;
+    }
+
+    return openSession();
+}
+
+/**
+ * @brief Pin the broker from LittleFS: CA bundle, else fingerprint
+ */
+void MQTTClient::loadTrust() {
+    File file = LittleFS.open(MQTT_TLS_CA_PATH, "r");
+    if (file) {
+        size_t size = file.size();
+        uint8_t* pem = (size > 0 && size <= MQTT_TLS_CA_MAX_BYTES) ? (uint8_t*)malloc(size) : nullptr;
+        if (pem && file.read(pem, size) == size && trustAnchors.append(pem, size)) {
+            wifiSecureClient.setTrustAnchors(&trustAnchors);
+            trustMode = MQTTTrustMode::CA;
+        } else {
+            LOG_ERROR("MQTT", "Unusable CA file %s (%u bytes)", MQTT_TLS_CA_PATH, (unsigned)size);
+        }
+        free(pem);
+        file.close();
+    }
+
+    if (trustMode == MQTTTrustMode::INSECURE) {
+        file = LittleFS.open(MQTT_TLS_FINGERPRINT_PATH, "r");
+        if (file) {
+            char fingerprint[64];
+            size_t n = file.readBytes(fingerprint, sizeof(fingerprint) - 1);
+            file.close();
+            while (n > 0 && isspace((unsigned char)fingerprint[n - 1])) n--;
+            fingerprint[n] = '\0';
+
+            if (wifiSecureClient.setFingerprint(fingerprint)) {
+                trustMode = MQTTTrustMode::FINGERPRINT;
+            } else {
+                LOG_ERROR("MQTT", "Malformed fingerprint in %s", MQTT_TLS_FINGERPRINT_PATH);
+            }
+        }
+    }
+
+    if (trustMode == MQTTTrustMode::INSECURE) {
+        LOG_WARN("MQTT", "No CA or fingerprint on LittleFS, broker not authenticated");
+        wifiSecureClient.setInsecure();
+    } else {
+        LOG_INFO("MQTT", "TLS pinned by %s",
+                 trustMode == MQTTTrustMode::CA ? "CA" : "fingerprint");
+    }
+}
+
+/**
+ * @brief Per-connect TLS setup: clock for the chain check, record sizes
+ * @return false if the connect has to wait (CA mode, no clock yet)
+ */
+bool MQTTClient::prepareTls() {
+    if (trustMode == MQTTTrustMode::CA) {
+        uint32_t now = timeSource ? timeSource() : 0;
+        if (now < MQTT_TLS_MIN_EPOCH) {
+            LOG_WARN("MQTT", "Clock not set, cannot validate broker certificate yet");
+            return false;
+        }
+        wifiSecureClient.setX509Time(now);
+    }
+
+    // Small buffers cut the ~17 KB handshake peak, but only if the broker
+    // agrees to small records; asked once per boot
+    if (mflnSupported < 0) {
+        mflnSupported = wifiSecureClient.probeMaxFragmentLength(
+            config.mqtt.broker, config.mqtt.port, MQTT_TLS_MFLN_SIZE) ? 1 : 0;
+        LOG_INFO("MQTT", "Broker MFLN %u: %s", MQTT_TLS_MFLN_SIZE,
+                 mflnSupported ? "supported" : "not supported");
+        if (mflnSupported) {
+            wifiSecureClient.setBufferSizes(MQTT_TLS_MFLN_SIZE, MQTT_TLS_MFLN_SIZE);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Open TCP (+TLS) to the broker
+ */
+bool MQTTClient::openTransport() {
+    if (tap.connected()) {
+        return true;
+    }
+
+    beginHandshake();
+    bool opened = (!config.mqtt.tlsEnabled || prepareTls()) &&
+                  tap.connect(config.mqtt.broker, config.mqtt.port) == 1;
+    endHandshake();
+
+    if (opened) {
+        return true;
+    }
+
+    if (config.mqtt.tlsEnabled) {
+        char reason[64];
+        int error = wifiSecureClient.getLastSSLError(reason, sizeof(reason));
+        if (error != 0) {
+            LOG_ERROR("MQTT", "TLS error %d: %s", error, reason);
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Start of a blocking TCP/TLS connect
+ *
+ * Recurrent scheduled functions also run from yield() and delay(), which
+ * the TCP connect and BearSSL's handshake loop call between engine steps,
+ * so the idle hook gets a turn there. Publishes made from it are queued
+ * (see publish()), never written into the half-open socket.
+ */
+void MQTTClient::beginHandshake() {
+    handshaking = true;
+    if (handshakeCallback) {
+        handshakeCallback(true);
+    }
 
+    if (idleCallback) {
+        schedule_recurrent_function_us([this]() {
+            if (handshaking) {
+                idleCallback();
+            }
+            return handshaking;     // false unregisters
+        }, MQTT_HANDSHAKE_IDLE_US);
+    }
+}
+
+void MQTTClient::endHandshake() {
+    handshaking = false;
+    if (handshakeCallback) {
+        handshakeCallback(false);
+    }
+}
+
+/**
+ * @brief MQTT CONNECT over the open transport
+ *
+ * PubSubClient reuses the already connected socket and blocks until
+ * CONNACK; the tap's idle hook keeps the UART serviced meanwhile.
+ */
+MQTTError MQTTClient::openSession() {
     bool connected = false;
 
+    tap.setIdleEnabled(true);
+
     // Connect with username/password if provided
     if (strlen(config.mqtt.username) > 0) {
         connected = client.connect(clientId,
@@ -71,25 +258,70 @@ MQTTError MQTTClient::connect() {
         connected = client.connect(clientId);
     }
 
+    tap.setIdleEnabled(false);
+
     if (connected) {
-        Serial.println(F("[MQTT] Connected successfully"));
+        LOG_INFO("MQTT", "Connected successfully");
         status.connected = true;
         status.connectTime = millis();
+        reconnectAttempts = 0;
+        reconnectDelay = 0;
+        reconnectPolicy.reset();
 
         // Subscribe to command topic
         char cmdTopic[128];
         MQTTTopicBuilder::buildCommand(cmdTopic, sizeof(cmdTopic), config);
         subscribe(cmdTopic, 1);
 
+        // Clean session: the broker forgot our unacknowledged QoS1 messages
+        resendInflight();
+
         return MQTTError::SUCCESS;
-    } else {
-        int rc = client.state();
-        Serial.printf("[MQTT] Connection failed, rc=%d\n", rc);
-        status.connected = false;
-        status.reconnectCount++;
-        status.lastError = rc;
+    }
 
-        return MQTTError::CONNECTION_FAILED;
+    connectFailed(client.state());
+    return MQTTError::CONNECTION_FAILED;
+}
+
+/**
+ * @brief Record a failed attempt and schedule the next one
+ */
+void MQTTClient::connectFailed(int rc) {
+    LOG_ERROR("MQTT", "Connection failed, rc=%d", rc);
+    tap.stop();
+    connectStage = MQTTConnectStage::IDLE;
+    status.connected = false;
+    status.reconnectCount++;
+    status.lastError = rc;
+    scheduleReconnect(millis());
+}
+
+/**
+ * @brief Advance a reconnect by one stage
+ *
+ * Transport and MQTT session run in separate handle() calls, so the main
+ * loop (STM32 UART, web server) gets a turn between the TLS handshake and
+ * the CONNECT/CONNACK exchange.
+ */
+void MQTTClient::connectStep() {
+    switch (connectStage) {
+        case MQTTConnectStage::IDLE:
+            LOG_INFO("MQTT", "Attempting connection...");
+            if (openTransport()) {
+                connectStage = MQTTConnectStage::SESSION;
+            } else {
+                connectFailed(MQTT_CONNECT_FAILED);
+            }
+            break;
+
+        case MQTTConnectStage::SESSION:
+            connectStage = MQTTConnectStage::IDLE;
+            if (!tap.connected()) {
+                connectFailed(MQTT_CONNECT_FAILED);
+                break;
+            }
+            openSession();
+            break;
     }
 }
 
@@ -100,7 +332,7 @@ void MQTTClient::disconnect() {
     if (client.connected()) {
         client.disconnect();
         status.connected = false;
-        Serial.println(F("[MQTT] Disconnected"));
+        LOG_INFO("MQTT", "Disconnected");
     }
 }
 
@@ -114,29 +346,61 @@ bool MQTTClient::isConnected() const {
 /**
  * @brief Publish message
  */
-MQTTError MQTTClient::publish(const char* topic, const char* payload, uint8_t qos) {
-    if (!topic || !payload) {
+MQTTError MQTTClient::publish(const char* topic, const char* payload, uint8_t qos,
+                              MQTTPriority priority, uint32_t deliveryToken) {
+    if (!payload) {
         return MQTTError::INVALID_PARAM;
     }
 
-    // If not connected, queue the message
-    if (!client.connected()) {
-        if (messageQueue.isFull()) {
-            Serial.println(F("[MQTT] Queue full, dropping oldest message"));
-            MQTTMessage dummy;
-            messageQueue.pop(dummy); // Remove oldest
-        }
-
-        MQTTMessage msg;
-        strncpy(msg.topic, topic, sizeof(msg.topic) - 1);
-        msg.topic[sizeof(msg.topic) - 1] = '\0';
-        strncpy(msg.payload, payload, sizeof(msg.payload) - 1);
-        msg.payload[sizeof(msg.payload) - 1] = '\0';
-        msg.qos = qos;
-        msg.timestamp = millis();
-
-        if (messageQueue.push(msg)) {
-            Serial.printf("[MQTT] Message queued (%u in queue): %s\n",
+    return publish(topic, (const uint8_t*)payload, strlen(payload), qos, priority, deliveryToken);
+}
+
+/**
+ * @brief Publish raw payload bytes
+ */
+MQTTError MQTTClient::publish(const char* topic, const uint8_t* payload, size_t length,
+                              uint8_t qos, MQTTPriority priority, uint32_t deliveryToken) {
+    if (!topic || (!payload && length > 0) || (uint8_t)priority >= MQTT_PRIORITY_COUNT) {
+        return MQTTError::INVALID_PARAM;
+    }
+
+    Lane& lane = lanes[(uint8_t)priority];
+    OfflineJournal& journal = lane.journal;
+    MessageRing<MQTT_LANE_QUEUE_BYTES>& messageQueue = lane.queue;
+
+    // QoS1 with a full inflight window waits in the lane like an outage
+    size_t topicLength = strlen(topic);
+    bool connected = !handshaking && client.connected();
+    bool deferred = !connected ||
+                    (qos == 1 && qos1PacketSize(topicLength, length) <= MQTT_INFLIGHT_BYTES &&
+                     !hasInflightRoom(topicLength, length));
+
+    // Journal while offline, or behind older records to keep ordering
+    if (journal.isReady() && (deferred || !journal.isEmpty())) {
+        if (journal.append(topic, payload, length, qos)) {
+            status.messageJournaled++;
+            return MQTTError::SUCCESS;
+        }
+        if (!deferred) {
+            LOG_WARN("MQTT", "Journal full, dropping: %s", topic);
+            return MQTTError::QUEUE_FULL;
+        }
+    }
+
+    // If deferred (or older messages are still queued), queue the message
+    if (deferred || !messageQueue.isEmpty()) {
+        if (!messageQueue.fits(topicLength, length)) {
+            LOG_WARN("MQTT", "Too large to queue (%u bytes): %s", (unsigned)length, topic);
+            return MQTTError::QUEUE_FULL;
+        }
+
+        while (!messageQueue.hasRoom(topicLength, length)) {
+            LOG_WARN("MQTT", "Queue full, dropping oldest message");
+            messageQueue.pop(); // Remove oldest
+        }
+
+        if (messageQueue.push(topic, payload, length, qos, millis())) {
+            LOG_TRACE("MQTT", "Message queued (%u in queue): %s",
                          messageQueue.size(), topic);
             return MQTTError::SUCCESS;
         } else {
@@ -144,18 +408,467 @@ MQTTError MQTTClient::publish(const char* topic, const char* payload, uint8_t qo
         }
     }
 
-    // Publish immediately if connected
-    bool result = client.publish(topic, payload, qos == 1);
+    MQTTError result = publishNow(topic, payload, length, qos, deliveryToken);
+    if (result != MQTTError::PUBLISH_FAILED) {
+        return result;
+    }
+
+    // Connection dropped mid-publish: transaction records must not be lost
+    if (priority == MQTTPriority::TRANSACTION && journal.append(topic, payload, length, qos)) {
+        status.messageJournaled++;
+        return MQTTError::SUCCESS;
+    }
+
+    return MQTTError::PUBLISH_FAILED;
+}
+
+/**
+ * @brief Publish on the live connection
+ */
+MQTTError MQTTClient::publishNow(const char* topic, const uint8_t* payload, size_t length,
+                                 uint8_t qos, uint32_t token) {
+    size_t topicLength = strlen(topic);
+
+    if (qos == 1) {
+        if (qos1PacketSize(topicLength, length) <= MQTT_INFLIGHT_BYTES) {
+            // Kept in the window until PUBACK, a failed write is retried from there
+            uint8_t index = stageInflight(topic, length, token);
+            inflightStore.pushMultiple(payload, length);
+            sendInflight(index, false);
+            status.messageTxCount++;
+            status.lastMessageTime = millis();
+            status.lastPublishTime = status.lastMessageTime;
+            return token != MQTT_NO_DELIVERY_TOKEN ? MQTTError::DELIVERY_PENDING
+                                                   : MQTTError::SUCCESS;
+        }
+        LOG_WARN("MQTT", "Too large for QoS1 window, sending QoS0: %s", topic);
+    }
+
+    // Packets larger than the PubSubClient buffer are streamed (header,
+    // then payload) instead of being rejected.
+    bool result;
+    size_t packetSize = MQTT_MAX_HEADER_SIZE + 2 + topicLength + length;
+    if (packetSize > MQTT_BUFFER_SIZE) {
+        result = client.beginPublish(topic, length, false) &&
+                 client.write(payload, length) == length &&
+                 client.endPublish();
+    } else {
+        result = client.publish(topic, payload, length, false);
+    }
 
     if (result) {
         status.messageTxCount++;
         status.lastMessageTime = millis();
-        Serial.printf("[MQTT] Published: %s\n", topic);
+        status.lastPublishTime = status.lastMessageTime;
+        LOG_TRACE("MQTT", "Published: %s", topic);
         return MQTTError::SUCCESS;
-    } else {
-        Serial.printf("[MQTT] Publish failed: %s\n", topic);
-        return MQTTError::PUBLISH_FAILED;
     }
+
+    LOG_ERROR("MQTT", "Publish failed: %s", topic);
+    return MQTTError::PUBLISH_FAILED;
+}
+
+/**
+ * @brief Encoded size of a QoS1 PUBLISH packet
+ */
+size_t MQTTClient::qos1PacketSize(size_t topicLength, size_t length) {
+    size_t remaining = 2 + topicLength + 2 + length;
+    size_t lengthBytes = 1;
+    for (size_t n = remaining; n > 0x7F; n >>= 7) {
+        lengthBytes++;
+    }
+    return 1 + lengthBytes + remaining;
+}
+
+/**
+ * @brief True if a QoS1 packet of this size can enter the window now
+ */
+bool MQTTClient::hasInflightRoom(size_t topicLength, size_t length) const {
+    return inflightCount < MQTT_INFLIGHT_WINDOW &&
+           inflightStore.free() >= qos1PacketSize(topicLength, length);
+}
+
+/**
+ * @brief Open a window slot and store the PUBLISH header (payload follows)
+ * @return Window index of the new slot
+ *
+ * The caller pushes exactly length payload bytes into inflightStore.
+ */
+uint8_t MQTTClient::stageInflight(const char* topic, size_t length, uint32_t token) {
+    size_t topicLength = strlen(topic);
+    size_t remaining = 2 + topicLength + 2 + length;
+    uint16_t packetId = nextPacketId++;
+    if (nextPacketId == 0) nextPacketId = 1;
+
+    uint8_t header[5];
+    uint8_t headerLength = 0;
+    header[headerLength++] = MQTTPUBLISH | MQTTQOS1;
+    do {
+        uint8_t digit = remaining & 0x7F;
+        remaining >>= 7;
+        header[headerLength++] = remaining > 0 ? (digit | 0x80) : digit;
+    } while (remaining > 0);
+
+    uint8_t ids[4] = {
+        (uint8_t)(topicLength >> 8), (uint8_t)topicLength,
+        (uint8_t)(packetId >> 8), (uint8_t)packetId
+    };
+
+    inflightStore.pushMultiple(header, headerLength);
+    inflightStore.pushMultiple(ids, 2);
+    inflightStore.pushMultiple((const uint8_t*)topic, topicLength);
+    inflightStore.pushMultiple(ids + 2, 2);
+
+    uint8_t index = inflightCount++;
+    MQTTInFlight& slot = inflight[(inflightHead + index) % MQTT_INFLIGHT_WINDOW];
+    slot.packetId = packetId;
+    slot.retries = 0;
+    slot.acked = false;
+    slot.packetLength = (uint16_t)qos1PacketSize(topicLength, length);
+    slot.sentAt = millis();
+    slot.token = token;
+    return index;
+}
+
+/**
+ * @brief Write a stored PUBLISH packet to the socket
+ * @param index Window index (0 = oldest)
+ * @param duplicate Set the DUP flag (redelivery)
+ */
+bool MQTTClient::sendInflight(uint8_t index, bool duplicate) {
+    size_t offset = 0;
+    for (uint8_t i = 0; i < index; i++) {
+        offset += inflight[(inflightHead + i) % MQTT_INFLIGHT_WINDOW].packetLength;
+    }
+
+    MQTTInFlight& slot = inflight[(inflightHead + index) % MQTT_INFLIGHT_WINDOW];
+    slot.sentAt = millis();
+
+    size_t written = 0;
+    bool ok = true;
+    while (ok && written < slot.packetLength) {
+        size_t spanLength = 0;
+        const uint8_t* data = inflightStore.readSpan(offset + written, spanLength);
+        size_t chunk = min(spanLength, (size_t)(slot.packetLength - written));
+        if (chunk == 0) {
+            return false;
+        }
+
+        if (written == 0 && duplicate) {
+            // First byte carries the DUP flag
+            ok = tap.write((uint8_t)(data[0] | MQTT_DUP_FLAG)) == 1;
+            data++;
+            chunk--;
+            written++;
+        }
+        if (ok && chunk > 0) {
+            ok = tap.write(data, chunk) == chunk;
+        }
+        written += chunk;
+    }
+    return ok;
+}
+
+/**
+ * @brief Match PUBACKs collected by the tap against the window
+ */
+void MQTTClient::processPubAcks() {
+    uint16_t packetId;
+    while (tap.popPubAck(packetId)) {
+        for (uint8_t i = 0; i < inflightCount; i++) {
+            MQTTInFlight& slot = inflight[(inflightHead + i) % MQTT_INFLIGHT_WINDOW];
+            if (slot.acked || slot.packetId != packetId) {
+                continue;
+            }
+
+            slot.acked = true;
+            status.messageAcked++;
+            settleReplay(slot.packetId, true);
+            if (deliveryCallback && slot.token != MQTT_NO_DELIVERY_TOKEN) {
+                deliveryCallback(slot.token, true);
+            }
+            break;
+        }
+    }
+
+    releaseAcked();
+}
+
+/**
+ * @brief Resolve a journaled record sent from the window
+ * @param delivered PUBACK received: drop it from flash. Otherwise it stays
+ *        the lane's oldest record and is replayed on a later drain
+ */
+void MQTTClient::settleReplay(uint16_t packetId, bool delivered) {
+    for (uint8_t p = 0; p < MQTT_PRIORITY_COUNT; p++) {
+        Lane& lane = lanes[p];
+        if (lane.replayPacketId != packetId) {
+            continue;
+        }
+
+        if (delivered) {
+            lane.journal.pop();
+        } else {
+            LOG_WARN("MQTT", "Journaled packet %u kept for replay", packetId);
+        }
+        lane.replayPacketId = 0;
+        return;
+    }
+}
+
+/**
+ * @brief Look up an unacknowledged window slot by delivery token
+ */
+bool MQTTClient::isDeliveryPending(uint32_t token) const {
+    if (token == MQTT_NO_DELIVERY_TOKEN) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < inflightCount; i++) {
+        const MQTTInFlight& slot = inflight[(inflightHead + i) % MQTT_INFLIGHT_WINDOW];
+        if (!slot.acked && slot.token == token) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Retransmit unacknowledged QoS1 packets after MQTT_PUBACK_TIMEOUT_MS
+ */
+void MQTTClient::checkInflightTimeouts() {
+    uint32_t now = millis();
+
+    for (uint8_t i = 0; i < inflightCount; i++) {
+        MQTTInFlight& slot = inflight[(inflightHead + i) % MQTT_INFLIGHT_WINDOW];
+        if (slot.acked || now - slot.sentAt < MQTT_PUBACK_TIMEOUT_MS) {
+            continue;
+        }
+
+        if (slot.retries >= MQTT_PUBACK_MAX_RETRIES) {
+            LOG_WARN("MQTT", "Packet %u not acknowledged, dropped", slot.packetId);
+            slot.acked = true;
+            status.deliveryFailed++;
+            settleReplay(slot.packetId, false);
+            if (deliveryCallback && slot.token != MQTT_NO_DELIVERY_TOKEN) {
+                deliveryCallback(slot.token, false);
+            }
+            continue;
+        }
+
+        sendInflight(i, true);
+        slot.retries++;
+        status.retransmits++;
+    }
+
+    // Dropped packets release their slots like acknowledged ones
+    releaseAcked();
+}
+
+/**
+ * @brief Resend the whole window after a reconnect (oldest first)
+ */
+void MQTTClient::resendInflight() {
+    for (uint8_t i = 0; i < inflightCount; i++) {
+        if (inflight[(inflightHead + i) % MQTT_INFLIGHT_WINDOW].acked) {
+            continue;
+        }
+        sendInflight(i, true);
+        status.retransmits++;
+    }
+}
+
+/**
+ * @brief Slide the window past acknowledged (or dropped) packets at its front
+ */
+void MQTTClient::releaseAcked() {
+    while (inflightCount > 0 && inflight[inflightHead].acked) {
+        inflightStore.discard(inflight[inflightHead].packetLength);
+        inflightHead = (inflightHead + 1) % MQTT_INFLIGHT_WINDOW;
+        inflightCount--;
+    }
+}
+
+/**
+ * @brief Publish part of the backlog, strict priority across lanes
+ *
+ * The highest-priority lane with anything pending goes first; within a
+ * lane the journal is replayed before the RAM queue, oldest first.
+ * Paced by MQTT_DRAIN_BURST / MQTT_DRAIN_BUDGET_MS per call and
+ * MQTT_DRAIN_INTERVAL_MS between calls, so a reconnect never stalls the
+ * main loop (and STM32 UART servicing) for long.
+ */
+void MQTTClient::drainBacklog() {
+    uint32_t start = millis();
+    if (start - lastDrain < MQTT_DRAIN_INTERVAL_MS) {
+        return;
+    }
+    lastDrain = start;
+
+    for (uint8_t i = 0; i < MQTT_DRAIN_BURST; i++) {
+        if (i > 0 && millis() - start >= MQTT_DRAIN_BUDGET_MS) {
+            return;
+        }
+
+        // A lane whose journal head awaits PUBACK holds its own backlog
+        // (ordering) but not the lanes below it
+        Lane* lane = nullptr;
+        for (uint8_t p = 0; p < MQTT_PRIORITY_COUNT && !lane; p++) {
+            if (lanes[p].replayPacketId != 0) {
+                continue;
+            }
+            if ((lanes[p].journal.isReady() && !lanes[p].journal.isEmpty()) ||
+                !lanes[p].queue.isEmpty()) {
+                lane = &lanes[p];
+            }
+        }
+        if (!lane) {
+            return;
+        }
+
+        bool ok = (lane->journal.isReady() && !lane->journal.isEmpty())
+                      ? replayJournaled(*lane)
+                      : publishQueued(*lane);
+
+        if (!ok) {
+            return; // Keep it, retry on the next burst
+        }
+    }
+}
+
+/**
+ * @brief Replay the oldest journaled record (payload streamed from flash)
+ */
+bool MQTTClient::replayJournaled(Lane& lane) {
+    OfflineJournal& journal = lane.journal;
+    char topic[128];
+    uint8_t chunk[64];
+    uint16_t length;
+    uint8_t qos;
+
+    if (!journal.peek(topic, sizeof(topic), length, qos)) {
+        return false;
+    }
+
+    File& payload = journal.payload();
+    size_t topicLength = strlen(topic);
+
+    if (qos == 1 && qos1PacketSize(topicLength, length) <= MQTT_INFLIGHT_BYTES) {
+        if (!hasInflightRoom(topicLength, length)) {
+            return false; // Window full, wait for PUBACKs
+        }
+
+        // Copy flash -> window, then send from the window
+        uint8_t index = stageInflight(topic, length, MQTT_NO_DELIVERY_TOKEN);
+        uint16_t remaining = length;
+        while (remaining > 0) {
+            size_t n = payload.read(chunk, min((size_t)remaining, sizeof(chunk)));
+            if (n == 0) break;
+            inflightStore.pushMultiple(chunk, n);
+            remaining -= n;
+        }
+
+        if (remaining > 0) {
+            // Short read: keep the record, release the slot unsent
+            memset(chunk, 0, sizeof(chunk));
+            while (remaining > 0) {
+                size_t n = min((size_t)remaining, sizeof(chunk));
+                inflightStore.pushMultiple(chunk, n);
+                remaining -= n;
+            }
+            inflight[(inflightHead + index) % MQTT_INFLIGHT_WINDOW].acked = true;
+            releaseAcked();
+            LOG_ERROR("MQTT", "Replay read failed: %s", topic);
+            return false;
+        }
+
+        // Popped from flash only on PUBACK (settleReplay), so a give-up or
+        // a reboot before then leaves it in the journal
+        sendInflight(index, false);
+        payload.close();
+        lane.replayPacketId = inflight[(inflightHead + index) % MQTT_INFLIGHT_WINDOW].packetId;
+        status.messageTxCount++;
+        status.messageReplayed++;
+        status.lastMessageTime = millis();
+        status.lastPublishTime = status.lastMessageTime;
+        return true;
+    }
+
+    bool ok = client.beginPublish(topic, length, false);
+    uint16_t remaining = length;
+    while (ok && remaining > 0) {
+        size_t n = payload.read(chunk, min((size_t)remaining, sizeof(chunk)));
+        ok = n > 0 && client.write(chunk, n) == n;
+        remaining -= n;
+    }
+    ok = ok && client.endPublish();
+
+    if (!ok) {
+        LOG_ERROR("MQTT", "Replay failed: %s", topic);
+        return false;
+    }
+
+    journal.pop();
+    status.messageTxCount++;
+    status.messageReplayed++;
+    status.lastMessageTime = millis();
+    status.lastPublishTime = status.lastMessageTime;
+    return true;
+}
+
+/**
+ * @brief Publish the oldest RAM-queued record in place (payload may wrap)
+ */
+bool MQTTClient::publishQueued(Lane& lane) {
+    MessageRing<MQTT_LANE_QUEUE_BYTES>& messageQueue = lane.queue;
+    MQTTQueueRecord record;
+    char topic[128];
+    if (!messageQueue.peek(record, topic, sizeof(topic))) {
+        return false;
+    }
+
+    size_t offset = 0;
+    if (record.qos == 1 && qos1PacketSize(record.topicLength, record.payloadLength) <= MQTT_INFLIGHT_BYTES) {
+        if (!hasInflightRoom(record.topicLength, record.payloadLength)) {
+            return false; // Window full, wait for PUBACKs
+        }
+
+        uint8_t index = stageInflight(topic, record.payloadLength, MQTT_NO_DELIVERY_TOKEN);
+        while (offset < record.payloadLength) {
+            size_t n;
+            const uint8_t* data = messageQueue.span(record, offset, n);
+            inflightStore.pushMultiple(data, n);
+            offset += n;
+        }
+        sendInflight(index, false);
+
+        messageQueue.pop();
+        status.messageTxCount++;
+        status.lastMessageTime = millis();
+        status.lastPublishTime = status.lastMessageTime;
+        return true;
+    }
+
+    bool ok = client.beginPublish(topic, record.payloadLength, false);
+    while (ok && offset < record.payloadLength) {
+        size_t n;
+        const uint8_t* data = messageQueue.span(record, offset, n);
+        ok = data && n > 0 && client.write(data, n) == n;
+        offset += n;
+    }
+    ok = ok && client.endPublish();
+
+    if (!ok) {
+        LOG_ERROR("MQTT", "Publish failed: %s", topic);
+        return false;
+    }
+
+    messageQueue.pop();
+    status.messageTxCount++;
+    status.lastMessageTime = millis();
+    status.lastPublishTime = status.lastMessageTime;
+    LOG_TRACE("MQTT", "Published: %s", topic);
+    return true;
 }
 
 /**
@@ -173,10 +886,10 @@ MQTTError MQTTClient::subscribe(const char* topic, uint8_t qos) {
     bool result = client.subscribe(topic, qos);
 
     if (result) {
-        Serial.printf("[MQTT] Subscribed: %s\n", topic);
+        LOG_INFO("MQTT", "Subscribed: %s", topic);
         return MQTTError::SUCCESS;
     } else {
-        Serial.printf("[MQTT] Subscribe failed: %s\n", topic);
+        LOG_ERROR("MQTT", "Subscribe failed: %s", topic);
         return MQTTError::SUBSCRIBE_FAILED;
     }
 }
@@ -196,7 +909,7 @@ MQTTError MQTTClient::unsubscribe(const char* topic) {
     bool result = client.unsubscribe(topic);
 
     if (result) {
-        Serial.printf("[MQTT] Unsubscribed: %s\n", topic);
+        LOG_INFO("MQTT", "Unsubscribed: %s", topic);
         return MQTTError::SUCCESS;
     } else {
         return MQTTError::SUBSCRIBE_FAILED;
@@ -218,36 +931,73 @@ void MQTTClient::handle() {
         // Process incoming messages
         client.loop();
 
-        // Process queued messages
-        MQTTMessage msg;
-        while (!messageQueue.isEmpty()) {
-            if (messageQueue.pop(msg)) {
-                MQTTError err = publish(msg.topic, msg.payload, msg.qos);
-                if (err != MQTTError::SUCCESS) {
-                    // Re-queue if failed
-                    messageQueue.push(msg);
-                    break;
-                }
-                delay(10); // Small delay between messages
-            }
-        }
+        // QoS1 window: PUBACKs seen during loop(), then retransmits
+        processPubAcks();
+        checkInflightTimeouts();
+
+        // Publish a few backlog messages, never the whole backlog at once
+        drainBacklog();
     } else {
-        // Attempt reconnection
-        static uint32_t lastReconnectAttempt = 0;
         uint32_t now = millis();
 
-        if (now - lastReconnectAttempt > 5000) { // Try every 5 seconds
-            if (connect() == MQTTError::SUCCESS) {
-                lastReconnectAttempt = 0;
-            } else {
-                lastReconnectAttempt = now;
-            }
+        if (status.connected) {
+            // Just dropped: even the first attempt waits a jittered delay,
+            // so a broker restart is not hit by every charger at once
+            scheduleReconnect(now);
+        } else if (connectStage != MQTTConnectStage::IDLE ||
+                   now - lastReconnectAttempt >= reconnectDelay) {
+            connectStep();
         }
     }
 
     updateStatus();
 }
 
+/**
+ * @brief RAM-queued messages across all lanes
+ */
+size_t MQTTClient::getQueueSize() const {
+    size_t total = 0;
+    for (uint8_t i = 0; i < MQTT_PRIORITY_COUNT; i++) {
+        total += lanes[i].queue.size();
+    }
+    return total;
+}
+
+/**
+ * @brief Drop every lane's backlog
+ */
+void MQTTClient::clearQueue() {
+    for (uint8_t i = 0; i < MQTT_PRIORITY_COUNT; i++) {
+        lanes[i].queue.clear();
+        lanes[i].journal.clear();
+        lanes[i].replayPacketId = 0;
+    }
+
+    // Pending delivery reports resolve as failed
+    for (uint8_t i = 0; i < inflightCount; i++) {
+        MQTTInFlight& slot = inflight[(inflightHead + i) % MQTT_INFLIGHT_WINDOW];
+        if (!slot.acked && deliveryCallback && slot.token != MQTT_NO_DELIVERY_TOKEN) {
+            deliveryCallback(slot.token, false);
+        }
+    }
+    inflightHead = 0;
+    inflightCount = 0;
+    inflightStore.clear();
+}
+
+/**
+ * @brief Pick the next reconnect time from the retry policy
+ */
+void MQTTClient::scheduleReconnect(uint32_t now) {
+    lastReconnectAttempt = now;
+    reconnectDelay = reconnectPolicy.getNextDelay(reconnectAttempts);
+    if (reconnectAttempts < 0xFF) {
+        reconnectAttempts++;
+    }
+    LOG_INFO("MQTT", "Reconnect in %u ms", (unsigned)reconnectDelay);
+}
+
 /**
  * @brief Update status
  */
@@ -261,19 +1011,13 @@ void MQTTClient::updateStatus() {
 void MQTTClient::staticCallback(char* topic, byte* payload, unsigned int length) {
     if (!instance) return;
 
-    // Null-terminate payload
-    char payloadStr[length + 1];
-    memcpy(payloadStr, payload, length);
-    payloadStr[length] = '\0';
-
-    Serial.printf("[MQTT] Received: %s -> %s\n", topic, payloadStr);
-
     instance->status.messageRxCount++;
     instance->status.lastMessageTime = millis();
 
-    // Call user callback
+    // Payload is not null-terminated; handlers take (payload, length) and
+    // read it in place from PubSubClient's buffer (valid until return)
     if (instance->userCallback) {
-        instance->userCallback(topic, payloadStr, length);
+        instance->userCallback(topic, (const char*)payload, length);
     }
 }
 
@@ -0,0 +1,154 @@
+/**
+ * @file mqtt_tap_client.cpp
+ * @brief Pass-through Client implementation (PUBACK tap)
+ */
+
+#include "drivers/mqtt/mqtt_tap_client.h"
+
+#define MQTT_PACKET_PUBACK  0x40
+
+MQTTTapClient::MQTTTapClient(Client& client)
+    : inner(client),
+      idleCallback(nullptr),
+      idleEnabled(false),
+      inIdle(false),
+      pubAcksDropped(0) {
+    resetParser();
+}
+
+void MQTTTapClient::resetParser() {
+    state = ParseState::FIXED_HEADER;
+    packetType = 0;
+    lengthShift = 0;
+    remaining = 0;
+    bodyOffset = 0;
+    packetId = 0;
+}
+
+/**
+ * @brief Advance the framing state machine by one inbound byte
+ */
+void MQTTTapClient::feed(uint8_t byte) {
+    switch (state) {
+        case ParseState::FIXED_HEADER:
+            packetType = byte & 0xF0;
+            lengthShift = 0;
+            remaining = 0;
+            bodyOffset = 0;
+            state = ParseState::REMAINING_LENGTH;
+            break;
+
+        case ParseState::REMAINING_LENGTH:
+            remaining |= (uint32_t)(byte & 0x7F) << lengthShift;
+            lengthShift += 7;
+            if ((byte & 0x80) == 0) {
+                if (remaining == 0) {
+                    packetComplete();
+                } else {
+                    state = ParseState::BODY;
+                }
+            } else if (lengthShift > 21) {
+                // Malformed length: PubSubClient drops the connection too
+                resetParser();
+            }
+            break;
+
+        case ParseState::BODY:
+            if (packetType == MQTT_PACKET_PUBACK && bodyOffset < 2) {
+                packetId = (uint16_t)((packetId << 8) | byte);
+            }
+            bodyOffset++;
+            if (bodyOffset >= remaining) {
+                packetComplete();
+            }
+            break;
+    }
+}
+
+void MQTTTapClient::packetComplete() {
+    if (packetType == MQTT_PACKET_PUBACK && bodyOffset >= 2) {
+        if (pubAcks.free() >= 2) {
+            pubAcks.push((uint8_t)(packetId >> 8));
+            pubAcks.push((uint8_t)packetId);
+        } else {
+            pubAcksDropped++;
+        }
+    }
+    resetParser();
+}
+
+bool MQTTTapClient::popPubAck(uint16_t& id) {
+    uint8_t high, low;
+    if (pubAcks.available() < 2) return false;
+    pubAcks.pop(high);
+    pubAcks.pop(low);
+    id = (uint16_t)((high << 8) | low);
+    return true;
+}
+
+int MQTTTapClient::connect(IPAddress ip, uint16_t port) {
+    resetParser();
+    pubAcks.clear();
+    return inner.connect(ip, port);
+}
+
+int MQTTTapClient::connect(const char* host, uint16_t port) {
+    resetParser();
+    pubAcks.clear();
+    return inner.connect(host, port);
+}
+
+size_t MQTTTapClient::write(uint8_t byte) {
+    return inner.write(byte);
+}
+
+size_t MQTTTapClient::write(const uint8_t* buf, size_t size) {
+    return inner.write(buf, size);
+}
+
+int MQTTTapClient::available() {
+    int n = inner.available();
+    if (n == 0 && idleEnabled && idleCallback && !inIdle) {
+        inIdle = true;
+        idleCallback();
+        inIdle = false;
+    }
+    return n;
+}
+
+int MQTTTapClient::read() {
+    int byte = inner.read();
+    if (byte >= 0) {
+        feed((uint8_t)byte);
+    }
+    return byte;
+}
+
+int MQTTTapClient::read(uint8_t* buf, size_t size) {
+    int n = inner.read(buf, size);
+    for (int i = 0; i < n; i++) {
+        feed(buf[i]);
+    }
+    return n;
+}
+
+int MQTTTapClient::peek() {
+    return inner.peek();
+}
+
+bool MQTTTapClient::flush(unsigned int maxWaitMs) {
+    return inner.flush(maxWaitMs);
+}
+
+bool MQTTTapClient::stop(unsigned int maxWaitMs) {
+    resetParser();
+    return inner.stop(maxWaitMs);
+}
+
+uint8_t MQTTTapClient::connected() {
+    return inner.connected();
+}
+
+MQTTTapClient::operator bool() {
+    return (bool)inner;
+}
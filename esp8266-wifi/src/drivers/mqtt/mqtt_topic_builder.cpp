@@ -5,36 +5,126 @@
 
 #include "drivers/mqtt/mqtt_topic_builder.h"
 
+void TopicCache::rebuild(const DeviceConfig& config) {
+    int n = snprintf(prefix, sizeof(prefix), "ocpp/%s/%s/",
+                     config.stationId, config.deviceId);
+    length = (n < 0) ? 0 : ((size_t)n >= sizeof(prefix) ? sizeof(prefix) - 1 : n);
+    source = &config;
+    revision = config.identityRevision;
+}
+
+const char* TopicCache::get(const DeviceConfig& config, size_t& outLength) {
+    if (source != &config || revision != config.identityRevision) {
+        rebuild(config);
+    }
+    outLength = length;
+    return prefix;
+}
+
 namespace MQTTTopicBuilder {
 
+static TopicCache cache;
+
+/**
+ * @brief Append string at pos (always NUL-terminates), returns new pos
+ */
+static size_t append(char* buffer, size_t size, size_t pos, const char* str, size_t len) {
+    if (pos + 1 >= size) return pos;
+    if (len > size - 1 - pos) len = size - 1 - pos;
+    memcpy(buffer + pos, str, len);
+    pos += len;
+    buffer[pos] = '\0';
+    return pos;
+}
+
+static size_t append(char* buffer, size_t size, size_t pos, const char* str) {
+    return append(buffer, size, pos, str, strlen(str));
+}
+
+static size_t appendUint(char* buffer, size_t size, size_t pos, uint8_t value) {
+    char digits[4];
+    uint8_t n = 0;
+    do {
+        digits[sizeof(digits) - 1 - n++] = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+    return append(buffer, size, pos, digits + sizeof(digits) - n, n);
+}
+
+static size_t appendPrefix(char* buffer, size_t size, const DeviceConfig& config) {
+    if (size == 0) return 0;
+    buffer[0] = '\0';
+
+    size_t len;
+    const char* p = cache.get(config, len);
+    return append(buffer, size, 0, p, len);
+}
+
+const char* prefix(const DeviceConfig& config, size_t& length) {
+    return cache.get(config, length);
+}
+
 void buildHeartbeat(char* buffer, size_t size, const DeviceConfig& config) {
-    snprintf(buffer, size, "ocpp/%s/%s/heartbeat",
-             config.stationId, config.deviceId);
+    size_t pos = appendPrefix(buffer, size, config);
+    append(buffer, size, pos, "heartbeat");
 }
 
 void buildStatus(char* buffer, size_t size, const DeviceConfig& config, uint8_t connectorId) {
-    snprintf(buffer, size, "ocpp/%s/%s/status/%u/status_notification",
-             config.stationId, config.deviceId, connectorId);
+    size_t pos = appendPrefix(buffer, size, config);
+    pos = append(buffer, size, pos, "status/");
+    pos = appendUint(buffer, size, pos, connectorId);
+    append(buffer, size, pos, "/status_notification");
+}
+
+void buildStatusSnapshot(char* buffer, size_t size, const DeviceConfig& config) {
+    size_t pos = appendPrefix(buffer, size, config);
+    append(buffer, size, pos, "status/snapshot");
 }
 
 void buildMeter(char* buffer, size_t size, const DeviceConfig& config, uint8_t connectorId) {
-    snprintf(buffer, size, "ocpp/%s/%s/meter/%u/meter_values",
-             config.stationId, config.deviceId, connectorId);
+    size_t pos = appendPrefix(buffer, size, config);
+    pos = append(buffer, size, pos, "meter/");
+    pos = appendUint(buffer, size, pos, connectorId);
+    append(buffer, size, pos, "/meter_values");
+}
+
+void buildMeterBatch(char* buffer, size_t size, const DeviceConfig& config) {
+    size_t pos = appendPrefix(buffer, size, config);
+    append(buffer, size, pos, "meter/batch");
 }
 
 void buildTransaction(char* buffer, size_t size, const DeviceConfig& config, const char* type) {
-    snprintf(buffer, size, "ocpp/%s/%s/transaction/%s",
-             config.stationId, config.deviceId, type);
+    size_t pos = appendPrefix(buffer, size, config);
+    pos = append(buffer, size, pos, "transaction/");
+    append(buffer, size, pos, type);
 }
 
 void buildBoot(char* buffer, size_t size, const DeviceConfig& config) {
-    snprintf(buffer, size, "ocpp/%s/%s/event/0/boot_notification",
-             config.stationId, config.deviceId);
+    size_t pos = appendPrefix(buffer, size, config);
+    append(buffer, size, pos, "event/0/boot_notification");
+}
+
+bool buildFromId(char* buffer, size_t size, const DeviceConfig& config,
+                 uint8_t topicId, uint8_t connectorId) {
+    switch (topicId) {
+        case TOPIC_ID_HEARTBEAT:         buildHeartbeat(buffer, size, config); break;
+        case TOPIC_ID_STATUS:            buildStatus(buffer, size, config, connectorId); break;
+        case TOPIC_ID_METER:             buildMeter(buffer, size, config, connectorId); break;
+        case TOPIC_ID_TRANSACTION_START: buildTransaction(buffer, size, config, "start"); break;
+        case TOPIC_ID_TRANSACTION_STOP:  buildTransaction(buffer, size, config, "stop"); break;
+        case TOPIC_ID_BOOT:              buildBoot(buffer, size, config); break;
+        default:                         return false;
+    }
+    return true;
+}
+
+void appendBinarySuffix(char* buffer, size_t size) {
+    append(buffer, size, strnlen(buffer, size), "/b");
 }
 
 void buildCommand(char* buffer, size_t size, const DeviceConfig& config) {
-    snprintf(buffer, size, "ocpp/%s/%s/cmd/+",
-             config.stationId, config.deviceId);
+    size_t pos = appendPrefix(buffer, size, config);
+    append(buffer, size, pos, "cmd/+");
 }
 
 }  // namespace MQTTTopicBuilder
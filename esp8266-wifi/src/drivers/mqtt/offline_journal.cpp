@@ -0,0 +1,402 @@
+/**
+ * @file offline_journal.cpp
+ * @brief Persistent offline MQTT message store implementation
+ */
+
+#include "drivers/mqtt/offline_journal.h"
+#include "utils/logger.h"
+#include <stddef.h>
+
+#define JOURNAL_INDEX_MAGIC     0x4A524E4C  // "JRNL"
+
+/**
+ * @brief On-flash index
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint32_t head_segment;
+    uint32_t head_offset;
+    uint32_t tail_segment;
+} journal_index_t;
+
+OfflineJournal::OfflineJournal(const char* directory, uint8_t segments)
+    : maxSegments(segments == 0 ? 1 : (segments > JOURNAL_MAX_SEGMENTS ? JOURNAL_MAX_SEGMENTS : segments)),
+      headSegment(0),
+      headOffset(0),
+      headSize(0),
+      tailSegment(0),
+      tailSize(0),
+      pendingRecordSize(0),
+      popsSinceSave(0),
+      ready(false) {
+    strncpy(dir, directory, sizeof(dir) - 1);
+    dir[sizeof(dir) - 1] = '\0';
+    memset(&stats, 0, sizeof(stats));
+}
+
+void OfflineJournal::segmentPath(char* buffer, size_t size, uint32_t segment) const {
+    snprintf(buffer, size, "%s/%08x.seg", dir, (unsigned)segment);
+}
+
+void OfflineJournal::indexPath(char* buffer, size_t size) const {
+    snprintf(buffer, size, "%s/index", dir);
+}
+
+static uint32_t fileSize(const char* path) {
+    File f = LittleFS.open(path, "r");
+    if (!f) return 0;
+    uint32_t size = f.size();
+    f.close();
+    return size;
+}
+
+/**
+ * @brief CRC over the header fields before crc (start of every record CRC)
+ */
+static uint16_t headerCrc(const journal_record_header_t& header) {
+    return uart_crc16_update(0xFFFF, (const uint8_t*)&header, offsetof(journal_record_header_t, crc));
+}
+
+static bool crcFromFile(File& f, uint32_t length, uint16_t& crc) {
+    uint8_t chunk[64];
+    while (length > 0) {
+        size_t n = length < sizeof(chunk) ? length : sizeof(chunk);
+        if (f.read(chunk, n) != n) return false;
+        crc = uart_crc16_update(crc, chunk, n);
+        length -= n;
+    }
+    return true;
+}
+
+/**
+ * @brief Validate the record at offset: magic, bounds and CRC
+ * @return Record size, 0 if torn or corrupt
+ */
+static uint32_t checkRecord(File& f, uint32_t offset, uint32_t segmentSize,
+                            journal_record_header_t& header) {
+    if (!f || offset + sizeof(header) > segmentSize) return 0;
+    if (!f.seek(offset, SeekSet) ||
+        f.read((uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+        header.magic != JOURNAL_RECORD_MAGIC) {
+        return 0;
+    }
+
+    uint32_t size = sizeof(header) + header.topic_length + header.payload_length;
+    if (offset + size > segmentSize) return 0;
+
+    uint16_t crc = headerCrc(header);
+    if (!crcFromFile(f, header.topic_length + header.payload_length, crc) || crc != header.crc) {
+        return 0;
+    }
+    return size;
+}
+
+/**
+ * @brief Offset of the first whole record at or after offset
+ * @return segmentSize if there is none
+ */
+static uint32_t findRecord(File& f, uint32_t offset, uint32_t segmentSize) {
+    journal_record_header_t header;
+    for (; offset + sizeof(header) <= segmentSize; offset++) {
+        if (checkRecord(f, offset, segmentSize, header) > 0) return offset;
+    }
+    return segmentSize;
+}
+
+bool OfflineJournal::saveIndex() {
+    journal_index_t index;
+    index.magic = JOURNAL_INDEX_MAGIC;
+    index.head_segment = headSegment;
+    index.head_offset = headOffset;
+    index.tail_segment = tailSegment;
+
+    char path[32];
+    indexPath(path, sizeof(path));
+    File f = LittleFS.open(path, "w");
+    if (!f) return false;
+
+    bool ok = f.write((const uint8_t*)&index, sizeof(index)) == sizeof(index);
+    f.close();
+    popsSinceSave = 0;
+    return ok;
+}
+
+bool OfflineJournal::loadIndex() {
+    char path[32];
+    indexPath(path, sizeof(path));
+    File f = LittleFS.open(path, "r");
+    if (!f) return false;
+
+    journal_index_t index;
+    bool ok = f.read((uint8_t*)&index, sizeof(index)) == sizeof(index);
+    f.close();
+
+    if (!ok || index.magic != JOURNAL_INDEX_MAGIC ||
+        index.tail_segment < index.head_segment ||
+        index.tail_segment - index.head_segment >= maxSegments) {
+        return false;
+    }
+
+    headSegment = index.head_segment;
+    headOffset = index.head_offset;
+    tailSegment = index.tail_segment;
+    return true;
+}
+
+bool OfflineJournal::init() {
+    LittleFS.mkdir(JOURNAL_ROOT_DIR);
+    LittleFS.mkdir(dir);
+
+    if (!loadIndex()) {
+        // Fresh (or unreadable) journal: start over
+        headSegment = tailSegment = 0;
+        headOffset = 0;
+        char path[32];
+        segmentPath(path, sizeof(path), 0);
+        LittleFS.remove(path);
+        if (!saveIndex()) {
+            LOG_ERROR("Journal", "Cannot write index: %s", dir);
+            ready = false;
+            return false;
+        }
+    }
+
+    repairTail();
+
+    char path[32];
+    if (headSegment != tailSegment) {
+        segmentPath(path, sizeof(path), headSegment);
+        headSize = fileSize(path);
+    }
+
+    ready = true;
+
+    if (!isEmpty()) {
+        LOG_INFO("Journal", "%s: %u segment(s) pending replay", dir, (unsigned)segmentsInUse());
+    }
+    return true;
+}
+
+bool OfflineJournal::truncateSegment(uint32_t segment, uint32_t size) {
+    char path[32];
+    segmentPath(path, sizeof(path), segment);
+    File f = LittleFS.open(path, "r+");
+    if (!f) return false;
+
+    bool ok = f.truncate(size);
+    f.close();
+    return ok;
+}
+
+void OfflineJournal::repairTail() {
+    char path[32];
+    segmentPath(path, sizeof(path), tailSegment);
+    File f = LittleFS.open(path, "r");
+    tailSize = f ? f.size() : 0;
+    if (!f) return;
+
+    // Walk the records; bytes after the last whole one are a torn append
+    uint32_t offset = (headSegment == tailSegment && headOffset < tailSize) ? headOffset : 0;
+    uint32_t end = offset;
+    journal_record_header_t header;
+    while (offset < tailSize) {
+        uint32_t size = checkRecord(f, offset, tailSize, header);
+        if (size == 0) {
+            offset = findRecord(f, offset + 1, tailSize);
+            continue;
+        }
+        offset += size;
+        end = offset;
+    }
+    f.close();
+
+    if (end < tailSize) {
+        LOG_WARN("Journal", "%s: cutting %u torn byte(s)", dir, (unsigned)(tailSize - end));
+        stats.corrupt++;
+        if (truncateSegment(tailSegment, end)) {
+            tailSize = end;
+        }
+    }
+}
+
+bool OfflineJournal::isEmpty() const {
+    return headSegment == tailSegment && headOffset >= tailSize;
+}
+
+bool OfflineJournal::append(const char* topic, const uint8_t* payload, size_t length,
+                            uint8_t qos) {
+    if (!ready || !topic) return false;
+
+    size_t topicLength = strlen(topic);
+    size_t recordSize = sizeof(journal_record_header_t) + topicLength + length;
+
+    if (topicLength > 0xFF || length > 0xFFFF || recordSize > JOURNAL_SEGMENT_SIZE) {
+        stats.refused++;
+        return false;
+    }
+
+    // Roll over to a new segment when the tail is full
+    if (tailSize > 0 && tailSize + recordSize > JOURNAL_SEGMENT_SIZE) {
+        if (segmentsInUse() >= maxSegments) {
+            stats.refused++;
+            return false;
+        }
+
+        if (headSegment == tailSegment) {
+            headSize = tailSize;
+        }
+        tailSegment++;
+        tailSize = 0;
+        saveIndex();
+    }
+
+    char path[32];
+    segmentPath(path, sizeof(path), tailSegment);
+    File f = LittleFS.open(path, "a");
+    if (!f) {
+        stats.refused++;
+        return false;
+    }
+
+    journal_record_header_t header;
+    header.magic = JOURNAL_RECORD_MAGIC;
+    header.flags = qos ? JOURNAL_FLAG_QOS1 : 0;
+    header.topic_length = (uint8_t)topicLength;
+    header.reserved = 0;
+    header.payload_length = (uint16_t)length;
+    uint16_t crc = headerCrc(header);
+    crc = uart_crc16_update(crc, (const uint8_t*)topic, topicLength);
+    header.crc = length > 0 ? uart_crc16_update(crc, payload, length) : crc;
+
+    size_t written = f.write((const uint8_t*)&header, sizeof(header));
+    written += f.write((const uint8_t*)topic, topicLength);
+    if (length > 0) {
+        written += f.write(payload, length);
+    }
+    f.close();
+
+    if (written != recordSize) {
+        // Cut the torn bytes so the next record starts on a boundary; if
+        // that fails too, replay finds the next record by its CRC
+        if (!truncateSegment(tailSegment, tailSize)) {
+            tailSize = fileSize(path);
+        }
+        stats.refused++;
+        return false;
+    }
+
+    tailSize += recordSize;
+    stats.appended++;
+    return true;
+}
+
+void OfflineJournal::finishHeadSegment() {
+    if (reader) reader.close();
+
+    char path[32];
+    segmentPath(path, sizeof(path), headSegment);
+    LittleFS.remove(path);
+
+    headSegment++;
+    headOffset = 0;
+    if (headSegment != tailSegment) {
+        segmentPath(path, sizeof(path), headSegment);
+        headSize = fileSize(path);
+    }
+    saveIndex();
+}
+
+bool OfflineJournal::peek(char* topic, size_t topicSize, uint16_t& length, uint8_t& qos) {
+    if (!ready) return false;
+    if (reader) reader.close();
+
+    while (!isEmpty()) {
+        uint32_t segmentSize = (headSegment == tailSegment) ? tailSize : headSize;
+
+        if (headOffset >= segmentSize) {
+            finishHeadSegment();
+            continue;
+        }
+
+        char path[32];
+        segmentPath(path, sizeof(path), headSegment);
+        reader = LittleFS.open(path, "r");
+
+        journal_record_header_t header;
+        uint32_t recordSize = checkRecord(reader, headOffset, segmentSize, header);
+
+        if (recordSize == 0) {
+            // Torn or corrupt record: resume at the next whole one
+            stats.corrupt++;
+            headOffset = findRecord(reader, headOffset + 1, segmentSize);
+            if (reader) reader.close();
+            saveIndex();
+            continue;
+        }
+
+        if (header.topic_length >= topicSize ||
+            !reader.seek(headOffset + sizeof(header), SeekSet) ||
+            reader.read((uint8_t*)topic, header.topic_length) != header.topic_length) {
+            // Whole but unusable here: skip just this record
+            stats.corrupt++;
+            reader.close();
+            headOffset += recordSize;
+            continue;
+        }
+
+        topic[header.topic_length] = '\0';
+        length = header.payload_length;
+        qos = (header.flags & JOURNAL_FLAG_QOS1) ? 1 : 0;
+        pendingRecordSize = recordSize;
+        return true;
+    }
+
+    return false;
+}
+
+void OfflineJournal::pop() {
+    if (reader) reader.close();
+    if (pendingRecordSize == 0) return;
+
+    headOffset += pendingRecordSize;
+    pendingRecordSize = 0;
+    stats.replayed++;
+
+    if (isEmpty()) {
+        // Drained: drop the segment and start the next one empty
+        char path[32];
+        segmentPath(path, sizeof(path), tailSegment);
+        LittleFS.remove(path);
+        headSegment = ++tailSegment;
+        headOffset = 0;
+        tailSize = 0;
+        saveIndex();
+        return;
+    }
+
+    if (headSegment != tailSegment && headOffset >= headSize) {
+        finishHeadSegment();
+        return;
+    }
+
+    if (++popsSinceSave >= JOURNAL_INDEX_INTERVAL) {
+        saveIndex();
+    }
+}
+
+void OfflineJournal::clear() {
+    if (reader) reader.close();
+
+    char path[32];
+    for (uint32_t segment = headSegment; segment <= tailSegment; segment++) {
+        segmentPath(path, sizeof(path), segment);
+        LittleFS.remove(path);
+    }
+
+    headSegment = ++tailSegment;
+    headOffset = 0;
+    headSize = 0;
+    tailSize = 0;
+    pendingRecordSize = 0;
+    saveIndex();
+}
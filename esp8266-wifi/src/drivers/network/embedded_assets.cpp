@@ -0,0 +1,66 @@
+/**
+ * @file embedded_assets.cpp
+ * @brief Web UI handler serving the gzipped assets compiled into flash
+ */
+
+#include "drivers/network/embedded_assets.h"
+#include "utils/logger.h"
+#include "web_assets.h"     // Only include site: the arrays are per-TU
+
+/**
+ * @brief Copy the WEB_FILES entry for a path out of flash
+ */
+static bool findAsset(const String& path, WebFile& out) {
+    for (size_t i = 0; i < WEB_FILES_COUNT; i++) {
+        memcpy_P(&out, &WEB_FILES[i], sizeof(WebFile));
+        if (strcmp(out.path, path.c_str()) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool EmbeddedAssetHandler::canHandle(AsyncWebServerRequest* request) {
+    if (request->method() != HTTP_GET) return false;
+
+    WebFile asset;
+    if (!findAsset(request->url(), asset)) return false;
+
+    request->addInterestingHeader("If-None-Match");
+    return true;
+}
+
+void EmbeddedAssetHandler::handleRequest(AsyncWebServerRequest* request) {
+    WebFile asset;
+    if (!findAsset(request->url(), asset)) {
+        request->send(404, "text/plain", "Not Found");
+        return;
+    }
+
+    const char* cacheControl = asset.immutable ? ASSET_CACHE_IMMUTABLE : ASSET_CACHE_REVALIDATE;
+
+    // Matches a single tag, a list, or the weak form a proxy may send
+    AsyncWebHeader* ifNoneMatch = request->getHeader("If-None-Match");
+    if (ifNoneMatch && strstr(ifNoneMatch->value().c_str(), asset.etag) != nullptr) {
+        AsyncWebServerResponse* response = request->beginResponse(304);
+        response->addHeader("ETag", asset.etag);
+        response->addHeader("Cache-Control", cacheControl);
+        request->send(response);
+        return;
+    }
+
+    // Progmem response copies from flash one TCP window at a time
+    AsyncWebServerResponse* response = request->beginResponse_P(200, asset.contentType, asset.data, asset.size);
+    if (asset.gzipped) {
+        response->addHeader("Content-Encoding", "gzip");
+    }
+    response->addHeader("ETag", asset.etag);
+    response->addHeader("Cache-Control", cacheControl);
+    request->send(response);
+
+    LOG_DEBUG("WebServer", "Asset %s (%u bytes)", asset.path, (unsigned)asset.size);
+}
+
+size_t EmbeddedAssetHandler::getAssetCount() {
+    return WEB_FILES_COUNT;
+}
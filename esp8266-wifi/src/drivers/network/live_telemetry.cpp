@@ -0,0 +1,149 @@
+/**
+ * @file live_telemetry.cpp
+ * @brief Live telemetry push to the local web UI
+ */
+
+#include "drivers/network/live_telemetry.h"
+#include "utils/logger.h"
+
+LiveTelemetry::LiveTelemetry()
+    : ws(LIVE_PATH), sequence(0), oversized(0) {
+    memset(slots, 0, sizeof(slots));
+    memset(clients, 0, sizeof(clients));
+}
+
+void LiveTelemetry::attach(AsyncWebServer& server) {
+    ws.onEvent([this](AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type,
+                      void* arg, uint8_t* data, size_t len) {
+        onEvent(client, type);
+    });
+    server.addHandler(&ws);
+    LOG_INFO("Live", "WebSocket on %s", LIVE_PATH);
+}
+
+void LiveTelemetry::onEvent(AsyncWebSocketClient* client, AwsEventType type) {
+    if (type == WS_EVT_CONNECT) {
+        for (Client& c : clients) {
+            if (c.active) continue;
+
+            // Snapshot of everything known so far
+            c.id = client->id();
+            c.active = true;
+            c.coalesced = 0;
+            c.pending = 0;
+            for (uint8_t i = 0; i < LIVE_SLOT_COUNT; i++) {
+                if (slots[i].used) c.pending |= (1 << i);
+            }
+            LOG_INFO("Live", "Client %u connected", client->id());
+            return;
+        }
+
+        LOG_WARN("Live", "Client %u rejected (max %u)", client->id(), LIVE_MAX_CLIENTS);
+        client->close(1013, "Too many clients");
+    } else if (type == WS_EVT_DISCONNECT) {
+        for (Client& c : clients) {
+            if (c.active && c.id == client->id()) {
+                LOG_INFO("Live", "Client %u gone (%u coalesced)", c.id, c.coalesced);
+                c.active = false;
+            }
+        }
+    }
+}
+
+int8_t LiveTelemetry::findSlot(LiveTopic topic, uint8_t connector) {
+    int8_t freeSlot = -1;
+    int8_t oldest = 0;
+
+    for (uint8_t i = 0; i < LIVE_SLOT_COUNT; i++) {
+        if (!slots[i].used) {
+            if (freeSlot < 0) freeSlot = i;
+            continue;
+        }
+        if (slots[i].topic == topic && slots[i].connector == connector) return i;
+        if (slots[i].sequence < slots[oldest].sequence) oldest = i;
+    }
+
+    // Table full: the least recently updated key gives way
+    return freeSlot >= 0 ? freeSlot : oldest;
+}
+
+bool LiveTelemetry::publish(LiveTopic topic, uint8_t connector, const char* json, size_t length) {
+    char envelope[48];
+    int header = snprintf(envelope, sizeof(envelope), "{\"type\":\"%s\",\"connector\":%u,\"data\":",
+                          topicName(topic), connector);
+    if (header < 0 || header + length + 2 > LIVE_SLOT_SIZE) {
+        oversized++;
+        LOG_WARN("Live", "%s frame too large (%u bytes)", topicName(topic), (unsigned)length);
+        return false;
+    }
+
+    int8_t index = findSlot(topic, connector);
+    Slot& slot = slots[index];
+
+    memcpy(slot.data, envelope, header);
+    memcpy(slot.data + header, json, length);
+    slot.data[header + length] = '}';
+    slot.data[header + length + 1] = '\0';
+    slot.length = header + length + 1;
+    slot.topic = topic;
+    slot.connector = connector;
+    slot.used = true;
+    slot.sequence = ++sequence;
+
+    uint8_t bit = 1 << index;
+    for (Client& c : clients) {
+        if (!c.active) continue;
+        if (c.pending & bit) c.coalesced++;
+        c.pending |= bit;
+    }
+    return true;
+}
+
+void LiveTelemetry::handle() {
+    for (Client& c : clients) {
+        if (c.active && c.pending) flushClient(c);
+    }
+
+    ws.cleanupClients(LIVE_MAX_CLIENTS);
+}
+
+void LiveTelemetry::flushClient(Client& c) {
+    AsyncWebSocketClient* client = ws.client(c.id);
+    if (!client || client->status() != WS_CONNECTED) {
+        c.active = false;
+        return;
+    }
+
+    while (c.pending) {
+        // Hold back while the socket queue is full; pending values keep
+        // being replaced by newer ones meanwhile
+        if (!client->canSend()) return;
+
+        int8_t next = -1;
+        for (uint8_t i = 0; i < LIVE_SLOT_COUNT; i++) {
+            if (!(c.pending & (1 << i))) continue;
+            if (next < 0 || slots[i].sequence < slots[next].sequence) next = i;
+        }
+
+        c.pending &= ~(1 << next);
+        if (slots[next].used) {
+            client->text(slots[next].data, slots[next].length);
+        }
+    }
+}
+
+bool LiveTelemetry::hasClients() const {
+    for (const Client& c : clients) {
+        if (c.active) return true;
+    }
+    return false;
+}
+
+const char* LiveTelemetry::topicName(LiveTopic topic) {
+    switch (topic) {
+        case LiveTopic::METER:  return "meter";
+        case LiveTopic::STATUS: return "status";
+        case LiveTopic::LINK:   return "link";
+        default:                return "unknown";
+    }
+}
@@ -1,12 +1,15 @@
 /**
  * @file web_server.cpp
  * @brief WebServer Driver Implementation
- * @version 1.0.0 - LittleFS filesystem serving
+ * @version 1.1.0 - Web UI served from flash (embedded assets)
  */
 
 #include "drivers/network/web_server.h"
+#include "drivers/network/embedded_assets.h"
 #include <LittleFS.h>
 
+static EmbeddedAssetHandler assetHandler;
+
 WebServerDriver::WebServerDriver(uint16_t serverPort)
     : server(serverPort), initialized(false), port(serverPort) {
 }
@@ -37,8 +40,12 @@ bool WebServerDriver::start() {
         return false;
     }
 
-    // Serve static files from LittleFS /data directory
-    server.serveStatic("/", LittleFS, "/").setDefaultFile("index.html");
+    // Live telemetry WebSocket
+    live.attach(server);
+
+    // Web UI from the gzipped PROGMEM copy (API routes are registered first)
+    server.addHandler(&assetHandler);
+    LOG_INFO("WebServer", "Serving %u embedded assets", (unsigned)EmbeddedAssetHandler::getAssetCount());
 
     // 404 handler
     server.onNotFound([](AsyncWebServerRequest *request) {
@@ -1,15 +1,41 @@
 /**
  * @file wifi_manager.cpp
  * @brief WiFi Manager implementation (native - no WiFiManager library)
- * @version 3.0.0
+ * @version 3.1.0
  */
 
 #include "drivers/network/wifi_manager.h"
 #include "utils/logger.h"
+#include "uart_protocol.h"
+#include <LittleFS.h>
+#include <lwip/dhcp.h>
+
+static uint16_t networkId(const char* ssid, const char* password) {
+    uint16_t crc = uart_crc16_update(0xFFFF, (const uint8_t*)ssid, strlen(ssid));
+    return uart_crc16_update(crc, (const uint8_t*)password, strlen(password));
+}
+
+static uint16_t cacheCrc(const wifi_cache_t& entry) {
+    const uint8_t* body = (const uint8_t*)&entry + offsetof(wifi_cache_t, network);
+    return uart_crc16_update(0xFFFF, body, sizeof(wifi_cache_t) - offsetof(wifi_cache_t, network));
+}
+
+static bool cacheIntact(const wifi_cache_t& entry) {
+    return entry.magic == WIFI_CACHE_MAGIC && entry.crc == cacheCrc(entry);
+}
 
 CustomWiFiManager::CustomWiFiManager(const DeviceConfig& cfg)
-    : config(cfg), lastReconnectAttempt(0) {
+    : config(cfg),
+      lastReconnectAttempt(0),
+      reconnectDelay(RECONNECT_BASE_MS),
+      reconnectAttempts(0),
+      reconnectPolicy(RECONNECT_BASE_MS, RECONNECT_MAX_MS, ESP.getChipId() ^ 0x57494649),
+      cacheValid(false),
+      cacheFromRtc(false),
+      lastLeaseCheck(0),
+      timeSource(nullptr) {
     memset(&status, 0, sizeof(WiFiStatus));
+    memset(&cache, 0, sizeof(wifi_cache_t));
 }
 
 WiFiError CustomWiFiManager::init() {
@@ -18,6 +44,8 @@ WiFiError CustomWiFiManager::init() {
     WiFi.persistent(false);  // Don't save to flash
     WiFi.setAutoConnect(false);
     WiFi.setAutoReconnect(true);
+    // Radio sleeps between beacons while loop() idles in delay()
+    WiFi.setSleepMode(WIFI_MODEM_SLEEP);
 
     LOG_INFO("WiFi", "Initialized in STA mode");
     return WiFiError::SUCCESS;
@@ -39,19 +67,48 @@ WiFiError CustomWiFiManager::connect() {
 WiFiError CustomWiFiManager::connectToNetwork(const char* ssid, const char* password) {
     LOG_INFO("WiFi", "Connecting to: %s", ssid);
 
-    WiFi.begin(ssid, password);
+    if (config.wifi.fastConnect) {
+        loadCache(ssid, password);
+    }
 
-    uint8_t attempts = 0;
-    while (WiFi.status() != WL_CONNECTED && attempts < 20) {
-        delay(500);
-        attempts++;
-        ESP.wdtFeed();
+    bool connected = false;
+    bool onLease = false;
+
+    if (cacheValid) {
+        // Known AP: skip the scan, and DHCP too when a lease is reusable
+        onLease = applyIpConfig(true);
+        uint32_t start = millis();
+        WiFi.begin(ssid, password, cache.channel, cache.bssid);
+        connected = waitForConnection(WIFI_FAST_CONNECT_TIMEOUT_MS);
+
+        if (connected) {
+            LOG_INFO("WiFi", "Fast connect in %lu ms (ch %u)", millis() - start, cache.channel);
+            if (onLease) {
+                // Keep the address, but let DHCP confirm or replace it
+                WiFi.config(IPAddress(), IPAddress(), IPAddress());
+            }
+        } else {
+            // AP moved channel, was replaced or is down: forget it, scan
+            LOG_WARN("WiFi", "Fast connect failed, full scan");
+            WiFi.disconnect();
+            clearCache();
+        }
     }
 
-    if (WiFi.status() == WL_CONNECTED) {
+    if (!connected) {
+        onLease = false;
+        applyIpConfig(false);
+        WiFi.begin(ssid, password);
+        connected = waitForConnection(WIFI_FULL_CONNECT_TIMEOUT_MS);
+    }
+
+    if (connected) {
         LOG_INFO("WiFi", "Connected! IP: %s", WiFi.localIP().toString().c_str());
         status.apMode = false;
         updateStatus();
+        if (config.wifi.fastConnect) {
+            saveCache(ssid, password, onLease);
+        }
         return WiFiError::SUCCESS;
     }
 
@@ -60,6 +117,176 @@ WiFiError CustomWiFiManager::connectToNetwork(const char* ssid, const char* pass
     return WiFiError::CONNECTION_FAILED;
 }
 
+bool CustomWiFiManager::waitForConnection(uint32_t timeoutMs) {
+    uint32_t start = millis();
+    while (WiFi.status() != WL_CONNECTED && millis() - start < timeoutMs) {
+        delay(20);
+        ESP.wdtFeed();
+    }
+    return WiFi.status() == WL_CONNECTED;
+}
+
+/**
+ * @brief Select static IP (config), cached lease or DHCP before a join
+ * @return true if the cached lease was applied
+ */
+bool CustomWiFiManager::applyIpConfig(bool useLease) {
+    if (strlen(config.wifi.staticIp) > 0) {
+        IPAddress ip, gateway, subnet, dns;
+        ip.fromString(config.wifi.staticIp);
+        gateway.fromString(config.wifi.gateway);
+        subnet.fromString(config.wifi.subnet);
+        if (!dns.fromString(config.wifi.dns)) {
+            dns = gateway;
+        }
+        WiFi.config(ip, gateway, subnet, dns);
+        return false;
+    }
+
+    if (useLease && leaseReusable()) {
+        WiFi.config(IPAddress(cache.ip), IPAddress(cache.gateway),
+                    IPAddress(cache.subnet), IPAddress(cache.dns));
+        return true;
+    }
+
+    // All-zero config re-enables the DHCP client
+    WiFi.config(IPAddress(), IPAddress(), IPAddress());
+    return false;
+}
+
+/**
+ * @brief True if the cached lease is still safe to assume without DHCP
+ */
+bool CustomWiFiManager::leaseReusable() const {
+    if (!cacheValid || cache.ip == 0 || cache.leaseUses >= WIFI_LEASE_MAX_REUSE ||
+        cache.leaseStart == 0 || cache.leaseTime == 0) {
+        return false;
+    }
+
+    // Stop at T1 so the address is never used past what the server granted
+    uint32_t now = timeSource ? timeSource() : 0;
+    if (now >= WIFI_MIN_EPOCH) {
+        return now >= cache.leaseStart && now - cache.leaseStart < cache.leaseTime / 2;
+    }
+
+    // No clock yet: a warm reset was short, a power loss may have been long
+    return cacheFromRtc;
+}
+
+/**
+ * @brief Follow DHCP renewals into the cache (start and length of the lease)
+ */
+void CustomWiFiManager::trackLease() {
+    uint32_t now = timeSource ? timeSource() : 0;
+    struct dhcp* client = netif_default ? netif_dhcp_data(netif_default) : nullptr;
+    if (!cacheValid || now < WIFI_MIN_EPOCH || !client || client->state != DHCP_STATE_BOUND) {
+        return;
+    }
+
+    uint32_t start = now - (uint32_t)client->lease_used * DHCP_COARSE_TIMER_SECS;
+    uint32_t ip = (uint32_t)WiFi.localIP();
+
+    // Same ACK as last time: nothing to write
+    if (ip == cache.ip && client->offered_t0_lease == cache.leaseTime &&
+        start + DHCP_COARSE_TIMER_SECS > cache.leaseStart &&
+        start < cache.leaseStart + DHCP_COARSE_TIMER_SECS) {
+        return;
+    }
+
+    cache.ip = ip;
+    cache.gateway = (uint32_t)WiFi.gatewayIP();
+    cache.subnet = (uint32_t)WiFi.subnetMask();
+    cache.dns = (uint32_t)WiFi.dnsIP();
+    cache.leaseStart = start;
+    cache.leaseTime = client->offered_t0_lease;
+    cache.leaseUses = 0;
+    cache.crc = cacheCrc(cache);
+    ESP.rtcUserMemoryWrite(WIFI_CACHE_RTC_OFFSET, (uint32_t*)&cache, sizeof(wifi_cache_t));
+
+    File file = LittleFS.open(WIFI_CACHE_PATH, "w");
+    if (file) {
+        file.write((const uint8_t*)&cache, sizeof(wifi_cache_t));
+        file.close();
+    }
+    LOG_DEBUG("WiFi", "Lease %lu s from %lu cached", (unsigned long)cache.leaseTime,
+              (unsigned long)cache.leaseStart);
+}
+
+void CustomWiFiManager::loadCache(const char* ssid, const char* password) {
+    if (!cacheValid) {
+        // RTC memory first (warm reset), then the file (power loss)
+        cacheFromRtc = ESP.rtcUserMemoryRead(WIFI_CACHE_RTC_OFFSET, (uint32_t*)&cache,
+                                             sizeof(wifi_cache_t)) && cacheIntact(cache);
+        if (!cacheFromRtc) {
+            File file = LittleFS.open(WIFI_CACHE_PATH, "r");
+            if (!file || file.read((uint8_t*)&cache, sizeof(wifi_cache_t)) != sizeof(wifi_cache_t)) {
+                memset(&cache, 0, sizeof(wifi_cache_t));
+            }
+            if (file) file.close();
+        }
+        cacheValid = cacheIntact(cache);
+    }
+
+    // Entry for another network (credentials changed) is useless
+    if (cacheValid && cache.network != networkId(ssid, password)) {
+        cacheValid = false;
+    }
+}
+
+void CustomWiFiManager::saveCache(const char* ssid, const char* password, bool onLease) {
+    wifi_cache_t entry;
+    memset(&entry, 0, sizeof(wifi_cache_t));
+    entry.magic = WIFI_CACHE_MAGIC;
+    entry.network = networkId(ssid, password);
+    memcpy(entry.bssid, WiFi.BSSID(), sizeof(entry.bssid));
+    entry.channel = (uint8_t)WiFi.channel();
+
+    if (onLease) {
+        // Same lease, one more use; DHCP refreshes it after the limit
+        entry.ip = cache.ip;
+        entry.gateway = cache.gateway;
+        entry.subnet = cache.subnet;
+        entry.dns = cache.dns;
+        entry.leaseStart = cache.leaseStart;
+        entry.leaseTime = cache.leaseTime;
+        entry.leaseUses = cache.leaseUses + 1;
+    } else if (strlen(config.wifi.staticIp) == 0) {
+        entry.ip = (uint32_t)WiFi.localIP();
+        entry.gateway = (uint32_t)WiFi.gatewayIP();
+        entry.subnet = (uint32_t)WiFi.subnetMask();
+        entry.dns = (uint32_t)WiFi.dnsIP();
+        // Start and length follow from trackLease() once the clock is set
+    }
+    entry.crc = cacheCrc(entry);
+
+    // Flash only when the AP or the lease changed, not per join
+    bool changed = !cacheValid ||
+                   memcmp(entry.bssid, cache.bssid, sizeof(entry.bssid)) != 0 ||
+                   entry.channel != cache.channel || entry.ip != cache.ip ||
+                   (entry.leaseUses == 0) != (cache.leaseUses == 0);
+
+    cache = entry;
+    cacheValid = true;
+    cacheFromRtc = true;
+    lastLeaseCheck = millis() - WIFI_LEASE_CHECK_MS;
+    ESP.rtcUserMemoryWrite(WIFI_CACHE_RTC_OFFSET, (uint32_t*)&cache, sizeof(wifi_cache_t));
+
+    if (changed) {
+        File file = LittleFS.open(WIFI_CACHE_PATH, "w");
+        if (file) {
+            file.write((const uint8_t*)&cache, sizeof(wifi_cache_t));
+            file.close();
+        }
+    }
+}
+
+void CustomWiFiManager::clearCache() {
+    memset(&cache, 0, sizeof(wifi_cache_t));
+    cacheValid = false;
+    ESP.rtcUserMemoryWrite(WIFI_CACHE_RTC_OFFSET, (uint32_t*)&cache, sizeof(wifi_cache_t));
+    LittleFS.remove(WIFI_CACHE_PATH);
+}
+
 void CustomWiFiManager::disconnect() {
     WiFi.disconnect();
     status.connected = false;
@@ -92,23 +319,55 @@ void CustomWiFiManager::handle() {
     }
 
     if (WiFi.status() != WL_CONNECTED) {
-        status.connected = false;
+        uint32_t now = millis();
+        if (status.connected) {
+            // Just dropped: wait a jittered delay before the first attempt
+            status.connected = false;
+            lastReconnectAttempt = now;
+            reconnectDelay = reconnectPolicy.getNextDelay(reconnectAttempts);
+        }
 
-        if (config.wifi.autoConnect) {
-            uint32_t now = millis();
-            if (now - lastReconnectAttempt > RECONNECT_INTERVAL) {
-                LOG_INFO("WiFi", "Auto-reconnecting...");
-                connect();
-                lastReconnectAttempt = now;
+        if (config.wifi.autoConnect && now - lastReconnectAttempt >= reconnectDelay) {
+            LOG_INFO("WiFi", "Auto-reconnecting (attempt %u)...", reconnectAttempts + 1);
+            connect();
+            lastReconnectAttempt = millis();
+            if (reconnectAttempts < 0xFF) {
+                reconnectAttempts++;
             }
+            reconnectDelay = reconnectPolicy.getNextDelay(reconnectAttempts);
         }
     } else {
         if (!status.connected) {
             updateStatus();
+            reconnectAttempts = 0;
+            reconnectPolicy.reset();
+        }
+
+        uint32_t now = millis();
+        if (config.wifi.fastConnect && strlen(config.wifi.staticIp) == 0 &&
+            now - lastLeaseCheck >= WIFI_LEASE_CHECK_MS) {
+            lastLeaseCheck = now;
+            trackLease();
         }
     }
 }
 
+bool CustomWiFiManager::setListenInterval(uint8_t listenInterval) {
+    if (listenInterval > WIFI_LISTEN_INTERVAL_MAX) {
+        listenInterval = WIFI_LISTEN_INTERVAL_MAX;
+    }
+
+    // Non-zero selects the SDK's maximum sleep level; broadcasts sent at a
+    // DTIM the station sleeps through are missed (unicast is buffered)
+    if (!WiFi.setSleepMode(WIFI_MODEM_SLEEP, listenInterval)) {
+        LOG_WARN("WiFi", "Failed to set listen interval %u", listenInterval);
+        return false;
+    }
+
+    status.listenInterval = listenInterval;
+    return true;
+}
+
 bool CustomWiFiManager::isConnected() const {
     return WiFi.status() == WL_CONNECTED && !status.apMode;
 }
@@ -5,68 +5,291 @@
 
 #include "drivers/time/ntp_time.h"
 #include "utils/logger.h"
+#include <ESP8266WiFi.h>
+#include <lwip/dns.h>
+
+// Seconds from 1900-01-01 (NTP era 0) to 1970-01-01
+static constexpr uint32_t NTP_UNIX_DELTA = 2208988800UL;
+
+static uint32_t readBE32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void writeBE32(uint8_t* p, uint32_t value) {
+    p[0] = (uint8_t)(value >> 24);
+    p[1] = (uint8_t)(value >> 16);
+    p[2] = (uint8_t)(value >> 8);
+    p[3] = (uint8_t)value;
+}
+
+// 64-bit NTP timestamp -> unix microseconds (era 1 from 2036 on)
+static uint64_t ntpToUnixUs(const uint8_t* p) {
+    uint32_t seconds = readBE32(p);
+    uint32_t fraction = readBE32(p + 4);
+
+    uint64_t unixSeconds = seconds >= NTP_UNIX_DELTA
+        ? (uint64_t)(seconds - NTP_UNIX_DELTA)
+        : (uint64_t)seconds + 0x100000000ULL - NTP_UNIX_DELTA;
+
+    return unixSeconds * 1000000ULL + (((uint64_t)fraction * 1000000ULL) >> 32);
+}
 
 NTPTimeDriver::NTPTimeDriver()
-    : ntpClient(nullptr), synced(false), lastSync(0), timezoneOffset(0) {
+    : serverCount(0), serverIndex(0), attempts(0),
+      state(NtpState::IDLE), stateStart(0), nextSync(0),
+      dnsDone(false), dnsOk(false), requestLocalUs(0),
+      synced(false), lastSync(0), timezoneOffset(0),
+      offsetUs(0), syncLocalUs(0), driftPpb(0), lastUnixUs(0),
+      lastRttUs(0), lastStratum(0) {
+    requestTag[0] = 0;
+    requestTag[1] = 0;
 }
 
 NTPTimeDriver::~NTPTimeDriver() {
-    if (ntpClient) {
-        delete ntpClient;
-        ntpClient = nullptr;
-    }
+    udp.stop();
 }
 
 void NTPTimeDriver::init(const char* server, int16_t tzOffset) {
     timezoneOffset = tzOffset;
+    serverCount = 0;
+    serverIndex = 0;
+    addServer(server);
 
-    // Create NTP client (offset in seconds)
-    ntpClient = new NTPClient(udp, server, tzOffset * 60, SYNC_INTERVAL);
-
-    ntpClient->begin();
+    udp.begin(NTP_LOCAL_PORT);
     LOG_INFO("NTP", "Initialized: server=%s, tz=%d min", server, tzOffset);
 
-    // Try initial sync
+    // First round starts on the next update() once WiFi is up
     forceSync();
 }
 
+bool NTPTimeDriver::addServer(const char* server) {
+    if (!server || serverCount >= NTP_MAX_SERVERS) return false;
+    servers[serverCount++] = server;
+    return true;
+}
+
 void NTPTimeDriver::update() {
-    if (!ntpClient) return;
+    if (serverCount == 0) return;
+
+    uint32_t now = millis();
+
+    switch (state) {
+        case NtpState::IDLE:
+            if ((int32_t)(now - nextSync) < 0) return;
+            if (WiFi.status() != WL_CONNECTED) return;
 
-    ntpClient->update();
+            attempts = 0;
+            if (!startAttempt()) nextServer();
+            break;
 
-    // Check if we need to sync
-    if (millis() - lastSync > SYNC_INTERVAL) {
-        forceSync();
+        case NtpState::RESOLVING:
+            if (dnsDone) {
+                if (dnsOk) {
+                    sendRequest();
+                } else {
+                    LOG_WARN("NTP", "DNS lookup failed: %s", servers[serverIndex]);
+                    nextServer();
+                }
+            } else if (now - stateStart > NTP_DNS_TIMEOUT_MS) {
+                LOG_WARN("NTP", "DNS timeout: %s", servers[serverIndex]);
+                nextServer();
+            }
+            break;
+
+        case NtpState::WAITING:
+            if (!readReply() && now - stateStart > NTP_REPLY_TIMEOUT_MS) {
+                LOG_WARN("NTP", "No reply from %s", servers[serverIndex]);
+                nextServer();
+            }
+            break;
     }
 }
 
 bool NTPTimeDriver::forceSync() {
-    if (!ntpClient) return false;
+    if (serverCount == 0 || state != NtpState::IDLE) return false;
+
+    nextSync = millis();
+    return true;
+}
+
+bool NTPTimeDriver::startAttempt() {
+    ip_addr_t addr;
+    dnsDone = false;
+    dnsOk = false;
+
+    // Cached names and IP literals resolve immediately
+    err_t err = dns_gethostbyname(servers[serverIndex], &addr, onDnsFound, this);
+    if (err == ERR_OK) {
+        serverIP = IPAddress(&addr);
+        sendRequest();
+        return true;
+    }
+    if (err == ERR_INPROGRESS) {
+        setState(NtpState::RESOLVING);
+        return true;
+    }
+
+    LOG_WARN("NTP", "DNS error %d: %s", err, servers[serverIndex]);
+    return false;
+}
+
+void NTPTimeDriver::nextServer() {
+    attempts++;
+    serverIndex = (serverIndex + 1) % serverCount;
+
+    if (attempts >= serverCount) {
+        LOG_ERROR("NTP", "Sync failed, retry in %u s", (unsigned)(NTP_RETRY_INTERVAL_MS / 1000));
+        setState(NtpState::IDLE);
+        nextSync = millis() + NTP_RETRY_INTERVAL_MS;
+        return;
+    }
+
+    if (!startAttempt()) nextServer();
+}
+
+void NTPTimeDriver::sendRequest() {
+    // Drop late replies from an earlier attempt
+    while (udp.parsePacket() > 0) {
+        udp.flush();
+    }
+
+    uint8_t packet[NTP_PACKET_SIZE];
+    memset(packet, 0, sizeof(packet));
+    packet[0] = 0x23;   // LI 0, version 4, mode 3 (client)
+
+    requestLocalUs = micros64();
+
+    // Any value works as transmit timestamp; the server echoes it back as
+    // originate, which ties the reply to this request
+    requestTag[0] = (uint32_t)(requestLocalUs >> 20);
+    requestTag[1] = (uint32_t)requestLocalUs ^ ESP.getCycleCount();
+    writeBE32(packet + 40, requestTag[0]);
+    writeBE32(packet + 44, requestTag[1]);
+
+    udp.beginPacket(serverIP, NTP_PORT);
+    udp.write(packet, sizeof(packet));
+    requestLocalUs = micros64();
+    udp.endPacket();
+
+    setState(NtpState::WAITING);
+}
+
+bool NTPTimeDriver::readReply() {
+    while (udp.parsePacket() > 0) {
+        uint64_t receiveLocalUs = micros64();
+
+        uint8_t packet[NTP_PACKET_SIZE];
+        int length = udp.read(packet, sizeof(packet));
+        udp.flush();
+
+        if (length < NTP_PACKET_SIZE || udp.remotePort() != NTP_PORT) continue;
+        if (readBE32(packet + 24) != requestTag[0] || readBE32(packet + 28) != requestTag[1]) continue;
+
+        uint8_t leap = packet[0] >> 6;
+        uint8_t mode = packet[0] & 0x07;
+        uint8_t stratum = packet[1];
+        if (mode != 4 || leap == 3 || stratum == 0 || stratum > 15) {
+            // Unsynchronized server or kiss-o'-death: try the next one
+            LOG_WARN("NTP", "Rejected reply from %s (stratum %u)", servers[serverIndex], stratum);
+            nextServer();
+            return true;
+        }
+
+        // T1/T4 on the local clock, T2/T3 from the server
+        uint64_t t2 = ntpToUnixUs(packet + 32);
+        uint64_t t3 = ntpToUnixUs(packet + 40);
+        int64_t rtt = (int64_t)(receiveLocalUs - requestLocalUs) - (int64_t)(t3 - t2);
+        int64_t sampleOffset = (((int64_t)t2 - (int64_t)requestLocalUs) +
+                                ((int64_t)t3 - (int64_t)receiveLocalUs)) / 2;
+
+        lastRttUs = rtt > 0 ? (uint32_t)rtt : 0;
+        lastStratum = stratum;
+        applySample(sampleOffset, receiveLocalUs);
+        setState(NtpState::IDLE);
+        nextSync = millis() + SYNC_INTERVAL;
+
+        LOG_INFO("NTP", "Sync OK via %s: %s, rtt=%u ms, stratum %u",
+                 servers[serverIndex], getFormattedTime().c_str(),
+                 (unsigned)(lastRttUs / 1000), stratum);
+        return true;
+    }
 
-    LOG_INFO("NTP", "Forcing sync...");
+    return false;
+}
+
+void NTPTimeDriver::applySample(int64_t sampleOffsetUs, uint64_t localUs) {
+    if (synced) {
+        int64_t elapsed = (int64_t)(localUs - syncLocalUs);
+        int64_t predicted = offsetUs + (elapsed / 1000) * driftPpb / 1000000;
+        int64_t error = sampleOffsetUs - predicted;
 
-    bool success = ntpClient->forceUpdate();
+        // Error left after a long enough interval is clock rate error;
+        // a step of a second or more is not drift
+        if (elapsed >= (int64_t)NTP_DRIFT_MIN_INTERVAL_MS * 1000 &&
+            error > -NTP_SLEW_LIMIT_US && error < NTP_SLEW_LIMIT_US) {
+            int64_t drift = driftPpb + error * 1000000000LL / elapsed;
+            if (drift > NTP_DRIFT_MAX_PPB) drift = NTP_DRIFT_MAX_PPB;
+            if (drift < -NTP_DRIFT_MAX_PPB) drift = -NTP_DRIFT_MAX_PPB;
+            driftPpb = (int32_t)drift;
+        }
 
-    if (success) {
-        synced = true;
-        lastSync = millis();
-        LOG_INFO("NTP", "Sync OK: %s", ntpClient->getFormattedTime().c_str());
+        if (error <= -NTP_SLEW_LIMIT_US) {
+            LOG_WARN("NTP", "Clock stepped back %d ms", (int)(-error / 1000));
+            lastUnixUs = 0;
+        }
     } else {
-        LOG_ERROR("NTP", "Sync failed");
+        driftPpb = 0;
+        lastUnixUs = 0;
     }
 
-    return success;
+    offsetUs = sampleOffsetUs;
+    syncLocalUs = localUs;
+    synced = true;
+    lastSync = millis();
 }
 
-uint32_t NTPTimeDriver::getUnixTime() {
-    if (!ntpClient) return millis() / 1000;  // Fallback to uptime
+void NTPTimeDriver::setState(NtpState newState) {
+    state = newState;
+    stateStart = millis();
+}
 
-    return ntpClient->getEpochTime();
+void NTPTimeDriver::onDnsFound(const char* name, const ip_addr_t* addr, void* arg) {
+    NTPTimeDriver* self = static_cast<NTPTimeDriver*>(arg);
+
+    // Late answer for a lookup that already timed out
+    if (self->state != NtpState::RESOLVING || strcmp(name, self->servers[self->serverIndex]) != 0) {
+        return;
+    }
+
+    if (addr) {
+        self->serverIP = IPAddress(addr);
+        self->dnsOk = true;
+    }
+    self->dnsDone = true;
+}
+
+uint64_t NTPTimeDriver::getUnixTimeUs() {
+    uint64_t localUs = micros64();
+    if (!synced) return localUs;  // Fallback to uptime
+
+    int64_t elapsed = (int64_t)(localUs - syncLocalUs);
+    uint64_t unixUs = localUs + offsetUs + (elapsed / 1000) * driftPpb / 1000000;
+
+    // Small backward corrections hold the clock until it catches up
+    if (unixUs < lastUnixUs) unixUs = lastUnixUs;
+    lastUnixUs = unixUs;
+    return unixUs;
+}
+
+uint32_t NTPTimeDriver::getUnixTime() {
+    return (uint32_t)(getUnixTimeUs() / 1000000ULL);
 }
 
 String NTPTimeDriver::getFormattedTime() {
-    if (!ntpClient) return "00:00:00";
+    uint32_t local = getUnixTime() + (int32_t)timezoneOffset * 60;
 
-    return ntpClient->getFormattedTime();
+    char buffer[9];
+    snprintf(buffer, sizeof(buffer), "%02u:%02u:%02u",
+             (unsigned)((local / 3600) % 24), (unsigned)((local / 60) % 60), (unsigned)(local % 60));
+    return String(buffer);
 }
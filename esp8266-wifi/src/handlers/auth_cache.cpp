@@ -0,0 +1,294 @@
+/**
+ * @file auth_cache.cpp
+ * @brief Local authorization list and cache implementation
+ */
+
+#include "handlers/auth_cache.h"
+#include "utils/logger.h"
+#include <LittleFS.h>
+#include <string.h>
+
+AuthCache::AuthCache()
+    : count(0),
+      listVersion(0),
+      dirty(false),
+      dirtySince(0),
+      lastChange(0),
+      hits(0),
+      misses(0) {
+    memset(entries, 0, sizeof(entries));
+}
+
+uint32_t AuthCache::hashTag(const char* idTag, size_t maxLength) {
+    // FNV-1a, 32 bit
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < maxLength && idTag[i] != '\0'; i++) {
+        hash ^= (uint8_t)idTag[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+void AuthCache::copyTag(char* tag, const char* idTag, size_t maxLength) {
+    memset(tag, 0, AUTH_ID_TAG_MAX);
+    for (size_t i = 0; i < maxLength && i < AUTH_ID_TAG_MAX && idTag[i] != '\0'; i++) {
+        tag[i] = idTag[i];
+    }
+}
+
+bool AuthCache::load() {
+    count = 0;
+    listVersion = 0;
+    dirty = false;
+
+    File file = LittleFS.open(AUTH_CACHE_PATH, "r");
+    if (!file) {
+        LOG_INFO("Auth", "No local authorization table");
+        return false;
+    }
+
+    auth_file_header_t header;
+    bool ok = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+              header.magic == AUTH_CACHE_MAGIC &&
+              header.count <= AUTH_CACHE_MAX_ENTRIES;
+
+    if (ok) {
+        size_t bytes = header.count * sizeof(auth_entry_t);
+        ok = file.read((uint8_t*)entries, bytes) == bytes &&
+             uart_crc16_update(0xFFFF, (const uint8_t*)entries, bytes) == header.crc;
+    }
+    file.close();
+
+    if (!ok) {
+        LOG_WARN("Auth", "Local authorization table corrupt, starting empty");
+        return false;
+    }
+
+    count = header.count;
+    listVersion = header.listVersion;
+    LOG_INFO("Auth", "Loaded %u id tags (list version %u)", count, listVersion);
+    return true;
+}
+
+bool AuthCache::save() {
+    size_t bytes = count * sizeof(auth_entry_t);
+
+    auth_file_header_t header;
+    header.magic = AUTH_CACHE_MAGIC;
+    header.listVersion = listVersion;
+    header.count = count;
+    header.crc = uart_crc16_update(0xFFFF, (const uint8_t*)entries, bytes);
+
+    File file = LittleFS.open(AUTH_CACHE_TMP_PATH, "w");
+    bool ok = (bool)file;
+    if (ok) {
+        ok = file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+             file.write((const uint8_t*)entries, bytes) == bytes;
+        file.close();
+    }
+
+    if (ok) {
+        ok = LittleFS.rename(AUTH_CACHE_TMP_PATH, AUTH_CACHE_PATH);
+    }
+
+    if (!ok) {
+        LOG_ERROR("Auth", "Failed to write local authorization table");
+        LittleFS.remove(AUTH_CACHE_TMP_PATH);
+        return false;
+    }
+
+    dirty = false;
+    LOG_DEBUG("Auth", "Saved %u id tags", count);
+    return true;
+}
+
+void AuthCache::handle(uint32_t now) {
+    if (!dirty) return;
+    if (now - lastChange < AUTH_CACHE_SAVE_DELAY_MS &&
+        now - dirtySince < AUTH_CACHE_SAVE_MAX_DELAY_MS) {
+        return;
+    }
+
+    if (!save()) {
+        dirtySince = now;       // Retry after another delay
+        lastChange = now;
+    }
+}
+
+AuthResult AuthCache::lookup(const char* idTag, size_t maxLength, uint32_t unixTime) {
+    AuthResult result = {AUTH_UNKNOWN, AUTH_SOURCE_NONE, 0};
+
+    char tag[AUTH_ID_TAG_MAX];
+    copyTag(tag, idTag, maxLength);
+    int16_t index = find(hashTag(tag, sizeof(tag)), tag);
+    if (index < 0) {
+        misses++;
+        return result;
+    }
+
+    const auth_entry_t& entry = entries[index];
+    hits++;
+    result.status = (id_tag_status_t)entry.status;
+    result.source = entry.source;
+    result.expiry = entry.expiry;
+
+    if (entry.expiry != 0 && unixTime != 0 && unixTime >= entry.expiry) {
+        result.status = AUTH_EXPIRED;
+    }
+    return result;
+}
+
+bool AuthCache::remember(const char* idTag, size_t maxLength, id_tag_status_t status,
+                         uint32_t expiry, uint32_t now) {
+    char tag[AUTH_ID_TAG_MAX];
+    copyTag(tag, idTag, maxLength);
+    uint32_t hash = hashTag(tag, sizeof(tag));
+    int16_t index = find(hash, tag);
+
+    if (index >= 0) {
+        auth_entry_t& entry = entries[index];
+        // The backend manages list entries through the list only
+        if (entry.source == AUTH_SOURCE_LIST) return true;
+        if (entry.status == status && entry.expiry == expiry) return true;
+
+        entry.status = status;
+        entry.expiry = expiry;
+        markDirty(now);
+        return true;
+    }
+
+    if (!insert(hash, tag, status, expiry, AUTH_SOURCE_CACHE)) {
+        return false;
+    }
+    markDirty(now);
+    return true;
+}
+
+void AuthCache::beginListUpdate(bool full, uint32_t version, uint32_t now) {
+    if (full) {
+        // Replace the list, keep cached answers
+        uint16_t kept = 0;
+        for (uint16_t i = 0; i < count; i++) {
+            if (entries[i].source != AUTH_SOURCE_LIST) {
+                entries[kept++] = entries[i];
+            }
+        }
+        count = kept;
+    }
+
+    listVersion = version;
+    markDirty(now);
+}
+
+bool AuthCache::setListEntry(const char* idTag, size_t maxLength, id_tag_status_t status,
+                             uint32_t expiry, uint32_t now) {
+    char tag[AUTH_ID_TAG_MAX];
+    copyTag(tag, idTag, maxLength);
+    uint32_t hash = hashTag(tag, sizeof(tag));
+    int16_t index = find(hash, tag);
+
+    if (index >= 0) {
+        entries[index].status = status;
+        entries[index].expiry = expiry;
+        entries[index].source = AUTH_SOURCE_LIST;
+    } else if (!insert(hash, tag, status, expiry, AUTH_SOURCE_LIST)) {
+        LOG_WARN("Auth", "Local list full (%u entries)", AUTH_CACHE_MAX_ENTRIES);
+        return false;
+    }
+
+    markDirty(now);
+    return true;
+}
+
+void AuthCache::removeListEntry(const char* idTag, size_t maxLength, uint32_t now) {
+    char tag[AUTH_ID_TAG_MAX];
+    copyTag(tag, idTag, maxLength);
+    int16_t index = find(hashTag(tag, sizeof(tag)), tag);
+    if (index < 0) return;
+
+    removeAt(index);
+    markDirty(now);
+}
+
+void AuthCache::clear(uint32_t now) {
+    count = 0;
+    listVersion = 0;
+    markDirty(now);
+}
+
+int16_t AuthCache::find(uint32_t hash, const char* tag) const {
+    // Equal hashes sit next to each other; only the tag decides
+    for (uint16_t index = lowerBound(hash); index < count && entries[index].hash == hash; index++) {
+        if (memcmp(entries[index].tag, tag, AUTH_ID_TAG_MAX) == 0) {
+            return (int16_t)index;
+        }
+    }
+    return -1;
+}
+
+uint16_t AuthCache::lowerBound(uint32_t hash) const {
+    uint16_t low = 0;
+    uint16_t high = count;
+    while (low < high) {
+        uint16_t mid = (low + high) / 2;
+        if (entries[mid].hash < hash) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+bool AuthCache::insert(uint32_t hash, const char* tag, id_tag_status_t status,
+                       uint32_t expiry, uint8_t source) {
+    if (count >= AUTH_CACHE_MAX_ENTRIES) {
+        int16_t victim = evictionCandidate();
+        if (victim < 0) return false;
+        removeAt(victim);
+    }
+
+    uint16_t index = lowerBound(hash);
+    memmove(&entries[index + 1], &entries[index], (count - index) * sizeof(auth_entry_t));
+
+    entries[index].hash = hash;
+    entries[index].expiry = expiry;
+    entries[index].status = (uint8_t)status;
+    entries[index].source = source;
+    memcpy(entries[index].tag, tag, AUTH_ID_TAG_MAX);
+    count++;
+    return true;
+}
+
+void AuthCache::removeAt(uint16_t index) {
+    memmove(&entries[index], &entries[index + 1], (count - index - 1) * sizeof(auth_entry_t));
+    count--;
+}
+
+int16_t AuthCache::evictionCandidate() const {
+    // Cache entry that expires first; entries without expiry go last
+    int16_t victim = -1;
+    for (uint16_t i = 0; i < count; i++) {
+        if (entries[i].source != AUTH_SOURCE_CACHE) continue;
+
+        if (victim < 0) {
+            victim = i;
+            continue;
+        }
+
+        uint32_t current = entries[victim].expiry ? entries[victim].expiry : 0xFFFFFFFFUL;
+        uint32_t candidate = entries[i].expiry ? entries[i].expiry : 0xFFFFFFFFUL;
+        if (candidate < current) {
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+void AuthCache::markDirty(uint32_t now) {
+    if (!dirty) {
+        dirty = true;
+        dirtySince = now;
+    }
+    lastChange = now;
+}
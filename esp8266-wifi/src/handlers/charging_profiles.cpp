@@ -0,0 +1,438 @@
+/**
+ * @file charging_profiles.cpp
+ * @brief OCPP charging profile store and limit evaluator implementation
+ */
+
+#include "handlers/charging_profiles.h"
+#include "utils/logger.h"
+#include "../../shared/uart_protocol.h"
+#include <LittleFS.h>
+#include <string.h>
+
+#define CHARGING_LIMIT_UNSENT   0xFFFE      // sent[]: STM32 state unknown
+#define CHARGING_NEVER          0xFFFFFFFFUL
+#define CHARGING_MAX_STEPS      16          // Evaluations per timeline rebuild
+
+static void earliest(uint32_t& boundary, uint32_t t) {
+    if (t < boundary) boundary = t;
+}
+
+ChargingProfileEngine::ChargingProfileEngine()
+    : count(0),
+      dirty(false),
+      timelineLength(0),
+      timelinePos(0),
+      horizonEnd(0),
+      activeMask(0),
+      knownMask(0),
+      stale(true),
+      evaluations(0) {
+    memset(profiles, 0, sizeof(profiles));
+    memset(timeline, 0, sizeof(timeline));
+    for (uint8_t i = 0; i < CONNECTOR_STATE_SLOTS; i++) {
+        sent[i] = CHARGING_NO_LIMIT;
+    }
+}
+
+bool ChargingProfileEngine::install(const charging_profile_t& profile) {
+    if (profile.periodCount == 0 || profile.periodCount > CHARGING_PERIODS_MAX ||
+        profile.purpose > CHARGING_PURPOSE_TX || profile.kind > CHARGING_KIND_RELATIVE ||
+        profile.connectorId >= CONNECTOR_STATE_SLOTS ||
+        (profile.purpose == CHARGING_PURPOSE_CP_MAX && profile.connectorId != 0) ||
+        (profile.purpose == CHARGING_PURPOSE_TX && profile.connectorId == 0)) {
+        LOG_WARN("Charging", "Profile %d rejected", profile.id);
+        return false;
+    }
+
+    // Same id, or same connector/purpose/stack level, replaces (OCPP 1.6)
+    uint8_t slot = count;
+    for (uint8_t i = 0; i < count; i++) {
+        const charging_profile_t& existing = profiles[i];
+        if (existing.id == profile.id ||
+            (existing.connectorId == profile.connectorId && existing.purpose == profile.purpose &&
+             existing.stackLevel == profile.stackLevel)) {
+            slot = i;
+            break;
+        }
+    }
+
+    if (slot == CHARGING_PROFILE_MAX) {
+        LOG_WARN("Charging", "Profile store full (%u)", CHARGING_PROFILE_MAX);
+        return false;
+    }
+
+    charging_profile_t& stored = profiles[slot];
+    stored = profile;
+    if (stored.startSchedule == 0 && stored.kind != CHARGING_KIND_RELATIVE) {
+        stored.startSchedule = stored.validFrom;
+    }
+
+    // Periods by start time (insertion sort, at most CHARGING_PERIODS_MAX)
+    for (uint8_t i = 1; i < stored.periodCount; i++) {
+        charging_period_t period = stored.periods[i];
+        uint8_t j = i;
+        while (j > 0 && stored.periods[j - 1].startPeriod > period.startPeriod) {
+            stored.periods[j] = stored.periods[j - 1];
+            j--;
+        }
+        stored.periods[j] = period;
+    }
+
+    if (slot == count) count++;
+    dirty = true;
+    stale = true;
+    LOG_INFO("Charging", "Profile %d installed (connector %u, purpose %u, stack %u)",
+             stored.id, stored.connectorId, stored.purpose, stored.stackLevel);
+    return true;
+}
+
+uint8_t ChargingProfileEngine::clear(int32_t id, int16_t connectorId, int16_t purpose, int16_t stackLevel) {
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        const charging_profile_t& profile = profiles[i];
+        bool match = (id < 0 || profile.id == id) &&
+                     (connectorId < 0 || profile.connectorId == connectorId) &&
+                     (purpose < 0 || profile.purpose == purpose) &&
+                     (stackLevel < 0 || profile.stackLevel == stackLevel);
+        if (!match) {
+            profiles[kept++] = profile;
+        }
+    }
+
+    uint8_t removed = count - kept;
+    if (removed > 0) {
+        count = kept;
+        dirty = true;
+        stale = true;
+        LOG_INFO("Charging", "Cleared %u profile(s)", removed);
+    }
+    return removed;
+}
+
+/**
+ * @brief Limit of one profile at now
+ * @param boundary Lowered to the next time this profile's limit may change
+ * @return false if the profile does not apply at now
+ */
+bool ChargingProfileEngine::profileLimit(const charging_profile_t& profile, uint32_t now,
+                                         uint16_t& limit, uint32_t& boundary) const {
+    if (profile.validFrom != 0 && now < profile.validFrom) {
+        earliest(boundary, profile.validFrom);
+        return false;
+    }
+    if (profile.validTo != 0) {
+        if (now >= profile.validTo) return false;
+        earliest(boundary, profile.validTo);
+    }
+
+    uint32_t start = profile.startSchedule;
+    if (now < start) {
+        earliest(boundary, start);
+        return false;
+    }
+
+    uint32_t offset = now - start;
+    if (profile.kind == CHARGING_KIND_RECURRING) {
+        uint32_t cycle = (profile.recurrency == CHARGING_RECUR_WEEKLY) ? 604800UL : 86400UL;
+        offset %= cycle;
+        earliest(boundary, now - offset + cycle);
+    }
+    uint32_t cycleStart = now - offset;
+
+    if (profile.duration != 0) {
+        if (offset >= profile.duration) return false;
+        earliest(boundary, cycleStart + profile.duration);
+    }
+
+    int8_t index = -1;
+    for (uint8_t i = 0; i < profile.periodCount; i++) {
+        if (profile.periods[i].startPeriod > offset) {
+            earliest(boundary, cycleStart + profile.periods[i].startPeriod);
+            break;
+        }
+        index = i;
+    }
+
+    if (index < 0) return false;
+    limit = profile.periods[index].limit;
+    return true;
+}
+
+uint16_t ChargingProfileEngine::bestLimit(uint8_t purpose, uint8_t connectorId, uint32_t now,
+                                          uint32_t& boundary) const {
+    uint16_t best = CHARGING_NO_LIMIT;
+    int16_t bestStack = -1;
+
+    for (uint8_t i = 0; i < count; i++) {
+        const charging_profile_t& profile = profiles[i];
+        if (profile.purpose != purpose || profile.connectorId != connectorId) continue;
+
+        uint16_t limit;
+        if (profileLimit(profile, now, limit, boundary) && profile.stackLevel > bestStack) {
+            best = limit;
+            bestStack = profile.stackLevel;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Limits of all connectors at now
+ * @return Next time any of them may change (CHARGING_NEVER = none)
+ */
+uint32_t ChargingProfileEngine::evaluateAt(uint32_t now, uint16_t* limits) const {
+    uint32_t boundary = CHARGING_NEVER;
+    uint16_t siteLimit = bestLimit(CHARGING_PURPOSE_CP_MAX, 0, now, boundary);
+    uint16_t siteDefault = bestLimit(CHARGING_PURPOSE_TX_DEFAULT, 0, now, boundary);
+    uint16_t active = activeMask & knownMask;
+    uint8_t activeCount = 0;
+
+    limits[0] = siteLimit;
+    for (uint8_t id = 1; id < CONNECTOR_STATE_SLOTS; id++) {
+        if (!(knownMask & (1U << id))) {
+            limits[id] = CHARGING_NO_LIMIT;
+            continue;
+        }
+
+        uint16_t limit = bestLimit(CHARGING_PURPOSE_TX, id, now, boundary);
+        if (limit == CHARGING_NO_LIMIT) {
+            limit = bestLimit(CHARGING_PURPOSE_TX_DEFAULT, id, now, boundary);
+        }
+        if (limit == CHARGING_NO_LIMIT) {
+            limit = siteDefault;
+        }
+        limits[id] = limit;
+
+        if (active & (1U << id)) activeCount++;
+    }
+
+    if (siteLimit == CHARGING_NO_LIMIT) return boundary;
+
+    // Share the site limit: connectors below their share keep their own
+    // limit and leave the rest to the others (water filling)
+    uint16_t capped = 0;
+    uint32_t remaining = siteLimit;
+    uint8_t open = activeCount;
+    bool changed = true;
+
+    while (open > 0 && changed) {
+        changed = false;
+        uint32_t share = remaining / open;
+        for (uint8_t id = 1; id < CONNECTOR_STATE_SLOTS; id++) {
+            uint16_t bit = 1U << id;
+            if (!(active & bit) || (capped & bit) || limits[id] > share) continue;
+            capped |= bit;
+            remaining -= limits[id];
+            open--;
+            changed = true;
+        }
+    }
+
+    uint16_t share = open > 0 ? (uint16_t)(remaining / open) : 0;
+    uint16_t idleShare = (uint16_t)(siteLimit / (activeCount + 1));
+
+    for (uint8_t id = 1; id < CONNECTOR_STATE_SLOTS; id++) {
+        uint16_t bit = 1U << id;
+        if (!(knownMask & bit) || (capped & bit)) continue;
+
+        if (active & bit) {
+            limits[id] = share;
+        } else if (limits[id] > idleShare) {
+            // Not charging: what it would get when it starts
+            limits[id] = idleShare;
+        }
+    }
+    return boundary;
+}
+
+void ChargingProfileEngine::rebuild(uint32_t now) {
+    // Relative profiles run from their first evaluation
+    for (uint8_t i = 0; i < count; i++) {
+        if (profiles[i].startSchedule == 0) {
+            profiles[i].startSchedule = now;
+            dirty = true;
+        }
+    }
+
+    evaluations++;
+    timelineLength = 0;
+    timelinePos = 0;
+    stale = false;
+
+    uint32_t t = now;
+    for (uint8_t step = 0; step < CHARGING_MAX_STEPS; step++) {
+        ChargingTimelineSlot& slot = timeline[timelineLength];
+        uint32_t boundary = evaluateAt(t, slot.limit);
+        slot.start = t;
+
+        // Boundaries that change nothing do not take a slot
+        if (timelineLength == 0 ||
+            memcmp(slot.limit, timeline[timelineLength - 1].limit, sizeof(slot.limit)) != 0) {
+            timelineLength++;
+        }
+
+        horizonEnd = boundary;
+        if (boundary == CHARGING_NEVER || boundary - now > CHARGING_HORIZON_S ||
+            timelineLength == CHARGING_TIMELINE_SLOTS) {
+            break;
+        }
+        t = boundary;
+    }
+}
+
+uint16_t ChargingProfileEngine::maskOf(const ConnectorStateTable& states, bool activeOnly) {
+    uint16_t mask = 0;
+    for (uint8_t id = 1; id < CONNECTOR_STATE_SLOTS; id++) {
+        const ConnectorState* state = states.get(id);
+        if (!state) continue;
+
+        bool charging = state->status == CONNECTOR_CHARGING ||
+                        state->status == CONNECTOR_SUSPENDED_EV ||
+                        state->status == CONNECTOR_SUSPENDED_EVSE;
+        if (!activeOnly || charging) {
+            mask |= 1U << id;
+        }
+    }
+    return mask;
+}
+
+void ChargingProfileEngine::tick(uint32_t now, const ConnectorStateTable& states) {
+    if (now == 0) return;
+
+    uint16_t known = maskOf(states, false);
+    uint16_t active = maskOf(states, true);
+
+    if (active != activeMask) {
+        // A TxProfile ends with its transaction
+        uint16_t ended = activeMask & ~active;
+        for (uint8_t id = 1; id < CONNECTOR_STATE_SLOTS; id++) {
+            if (ended & (1U << id)) {
+                clear(-1, id, CHARGING_PURPOSE_TX, -1);
+            }
+        }
+        activeMask = active;
+        stale = true;
+    }
+
+    if (known != knownMask) {
+        knownMask = known;
+        stale = true;
+    }
+
+    // Clock stepped back (NTP correction) or ran past the precomputed part
+    if (stale || timelineLength == 0 || now < timeline[0].start || now >= horizonEnd) {
+        rebuild(now);
+        return;
+    }
+
+    while (timelinePos + 1 < timelineLength && now >= timeline[timelinePos + 1].start) {
+        timelinePos++;
+    }
+}
+
+uint16_t ChargingProfileEngine::currentLimit(uint8_t connectorId) const {
+    if (connectorId >= CONNECTOR_STATE_SLOTS || timelineLength == 0) {
+        return CHARGING_NO_LIMIT;
+    }
+    return timeline[timelinePos].limit[connectorId];
+}
+
+bool ChargingProfileEngine::nextChange(ChargingLimitChange& change) const {
+    for (uint8_t id = 1; id < CONNECTOR_STATE_SLOTS; id++) {
+        if (!(knownMask & (1U << id))) continue;
+
+        uint16_t limit = currentLimit(id);
+        if (limit == sent[id]) continue;
+
+        change.connectorId = id;
+        change.limit = limit;
+        change.validFor = 0;
+
+        // How long this value holds, from the precomputed timeline
+        for (uint8_t pos = timelinePos + 1; pos < timelineLength; pos++) {
+            if (timeline[pos].limit[id] != limit) {
+                change.validFor = timeline[pos].start - timeline[timelinePos].start;
+                break;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+void ChargingProfileEngine::markSent(const ChargingLimitChange& change) {
+    if (change.connectorId < CONNECTOR_STATE_SLOTS) {
+        sent[change.connectorId] = change.limit;
+    }
+}
+
+void ChargingProfileEngine::resendAll() {
+    for (uint8_t i = 0; i < CONNECTOR_STATE_SLOTS; i++) {
+        sent[i] = CHARGING_LIMIT_UNSENT;
+    }
+}
+
+bool ChargingProfileEngine::load() {
+    count = 0;
+    stale = true;
+
+    File file = LittleFS.open(CHARGING_PROFILE_PATH, "r");
+    if (!file) return false;
+
+    charging_file_header_t header;
+    bool ok = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+              header.magic == CHARGING_PROFILE_MAGIC &&
+              header.count <= CHARGING_PROFILE_MAX;
+
+    if (ok) {
+        size_t bytes = header.count * sizeof(charging_profile_t);
+        ok = file.read((uint8_t*)profiles, bytes) == bytes &&
+             uart_crc16_update(0xFFFF, (const uint8_t*)profiles, bytes) == header.crc;
+    }
+    file.close();
+
+    if (!ok) {
+        LOG_WARN("Charging", "Profile store corrupt, starting empty");
+        return false;
+    }
+
+    count = header.count;
+    LOG_INFO("Charging", "Loaded %u charging profile(s)", count);
+    return true;
+}
+
+bool ChargingProfileEngine::save() {
+    size_t bytes = count * sizeof(charging_profile_t);
+
+    charging_file_header_t header;
+    header.magic = CHARGING_PROFILE_MAGIC;
+    header.count = count;
+    header.crc = uart_crc16_update(0xFFFF, (const uint8_t*)profiles, bytes);
+
+    File file = LittleFS.open(CHARGING_PROFILE_TMP_PATH, "w");
+    bool ok = (bool)file;
+    if (ok) {
+        ok = file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+             file.write((const uint8_t*)profiles, bytes) == bytes;
+        file.close();
+    }
+
+    if (ok) {
+        ok = LittleFS.rename(CHARGING_PROFILE_TMP_PATH, CHARGING_PROFILE_PATH);
+    }
+
+    if (!ok) {
+        LOG_ERROR("Charging", "Failed to write charging profiles");
+        LittleFS.remove(CHARGING_PROFILE_TMP_PATH);
+        return false;
+    }
+
+    dirty = false;
+    return true;
+}
+
+void ChargingProfileEngine::handle() {
+    if (dirty) {
+        save();
+    }
+}
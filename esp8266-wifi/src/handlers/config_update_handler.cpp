@@ -5,35 +5,30 @@
 
 #include "handlers/config_update_handler.h"
 #include "utils/logger.h"
-#include <ArduinoJson.h>
 
 bool ConfigUpdateHandler::handleFromSTM32(
-    const uart_packet_t& packet,
+    const UartFrameView& frame,
     STM32Communicator& stm32,
     UnifiedConfigManager& configManager
 ) {
-    // Parse JSON config from packet
-    const char* jsonConfig = (const char*)packet.payload;
+    bool success = false;
 
-    LOG_INFO("ConfigUpdate", "Received from STM32: %s", jsonConfig);
+    // JSON config is read straight from the frame (not NUL-terminated)
+    frame.withLinearPayload([&](uint8_t* data, uint16_t length) {
+        const char* jsonConfig = (const char*)data;
 
-    // Validate
-    if (!validateConfig(jsonConfig)) {
-        LOG_ERROR("ConfigUpdate", "Invalid config");
-        stm32.sendAck(packet.sequence, STATUS_INVALID);
-        return false;
-    }
+        LOG_INFO("ConfigUpdate", "Received from STM32: %.*s", length, jsonConfig);
 
-    // Save
-    if (saveConfig(jsonConfig, configManager)) {
-        LOG_INFO("ConfigUpdate", "Config updated successfully");
-        stm32.sendAck(packet.sequence, STATUS_SUCCESS);
-        return true;
-    } else {
-        LOG_ERROR("ConfigUpdate", "Failed to save config");
-        stm32.sendAck(packet.sequence, STATUS_ERROR);
-        return false;
-    }
+        // Applied in memory now, written to flash once updates settle
+        if (applyConfig(jsonConfig, length, configManager)) {
+            stm32.sendAck(frame.sequence, STATUS_SUCCESS);
+            success = true;
+        } else {
+            stm32.sendAck(frame.sequence, STATUS_INVALID);
+        }
+    });
+
+    return success;
 }
 
 bool ConfigUpdateHandler::handleFromMQTT(
@@ -42,48 +37,20 @@ bool ConfigUpdateHandler::handleFromMQTT(
 ) {
     LOG_INFO("ConfigUpdate", "Received from MQTT");
 
-    if (!validateConfig(jsonConfig)) {
-        LOG_ERROR("ConfigUpdate", "Invalid config");
-        return false;
-    }
-
-    return saveConfig(jsonConfig, configManager);
+    return applyConfig(jsonConfig, strlen(jsonConfig), configManager);
 }
 
-bool ConfigUpdateHandler::validateConfig(const char* jsonConfig) {
-    // Parse JSON
-    StaticJsonDocument<512> doc;
-    DeserializationError error = deserializeJson(doc, jsonConfig);
-
-    if (error) {
-        LOG_ERROR("ConfigUpdate", "JSON parse error: %s", error.c_str());
-        return false;
-    }
-
-    // Validate required fields (basic validation)
-    if (!doc.containsKey("mqtt") || !doc.containsKey("wifi")) {
-        LOG_ERROR("ConfigUpdate", "Missing required fields");
-        return false;
-    }
-
-    return true;
-}
-
-bool ConfigUpdateHandler::saveConfig(
+bool ConfigUpdateHandler::applyConfig(
     const char* jsonConfig,
+    size_t length,
     UnifiedConfigManager& configManager
 ) {
-    // Parse to DeviceConfig
-    StaticJsonDocument<512> doc;
-    deserializeJson(doc, jsonConfig);
-
-    // Update config manager
-    // Note: This requires UnifiedConfigManager to have an update method
-    // For now, just log
-    LOG_INFO("ConfigUpdate", "Config saved (TODO: implement persistence)");
-
-    // TODO: Implement actual config update in UnifiedConfigManager
-    // configManager.update(doc);
+    if (!configManager.updateFromJson(jsonConfig, length)) {
+        LOG_ERROR("ConfigUpdate", "Invalid config");
+        return false;
+    }
 
+    LOG_INFO("ConfigUpdate", "Config updated (pending sections 0x%02X)",
+             configManager.getDirtySections());
     return true;
 }
@@ -0,0 +1,68 @@
+/**
+ * @file connector_state.cpp
+ * @brief Per-connector status cache implementation
+ */
+
+#include "handlers/connector_state.h"
+#include <string.h>
+
+ConnectorStateTable::ConnectorStateTable() {
+    reset();
+}
+
+void ConnectorStateTable::reset() {
+    memset(slots, 0, sizeof(slots));
+    suppressedCount = 0;
+}
+
+bool ConnectorStateTable::update(uint8_t connectorId, connector_status_t status,
+                                 error_code_t errorCode, uint32_t now) {
+    if (connectorId >= CONNECTOR_STATE_SLOTS) {
+        return true;
+    }
+
+    ConnectorState& state = slots[connectorId];
+    if (state.known && state.published && state.status == status && state.errorCode == errorCode) {
+        suppressedCount++;
+        return false;
+    }
+
+    if (!state.known || state.status != status || state.errorCode != errorCode) {
+        state.changedAt = now;
+    }
+    state.status = status;
+    state.errorCode = errorCode;
+    state.known = true;
+    state.published = true;
+    return true;
+}
+
+void ConnectorStateTable::markUnpublished(uint8_t connectorId) {
+    if (connectorId < CONNECTOR_STATE_SLOTS) {
+        slots[connectorId].published = false;
+    }
+}
+
+const ConnectorState* ConnectorStateTable::get(uint8_t connectorId) const {
+    if (connectorId >= CONNECTOR_STATE_SLOTS || !slots[connectorId].known) {
+        return nullptr;
+    }
+    return &slots[connectorId];
+}
+
+int16_t ConnectorStateTable::highestKnown() const {
+    for (int16_t id = CONNECTOR_STATE_SLOTS - 1; id >= 0; id--) {
+        if (slots[id].known) return id;
+    }
+    return -1;
+}
+
+bool ConnectorStateTable::sessionActive() const {
+    for (uint8_t id = 1; id < CONNECTOR_STATE_SLOTS; id++) {
+        const ConnectorState& state = slots[id];
+        if (state.known && state.status >= CONNECTOR_PREPARING && state.status <= CONNECTOR_FINISHING) {
+            return true;
+        }
+    }
+    return false;
+}
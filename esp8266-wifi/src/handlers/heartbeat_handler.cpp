@@ -4,14 +4,84 @@
  */
 
 #include "handlers/heartbeat_handler.h"
+#include "drivers/mqtt/mqtt_topic_builder.h"
+#include "utils/json_writer.h"
+#include "utils/msgpack_writer.h"
 #include "utils/logger.h"
-#include <ArduinoJson.h>
+
+template<typename Writer>
+static size_t encodeHeartbeat(char* buffer, size_t size, const HeartbeatFields& fields,
+                              const ConnectorStateTable* connectors) {
+    char msgId[12];
+    snprintf(msgId, sizeof(msgId), "%u", (unsigned)millis());
+
+    Writer w(buffer, size);
+    w.beginObject();
+    w.field("msgId", msgId);
+    HeartbeatHandler::writeFields(w, fields);
+    if (connectors && connectors->highestKnown() >= 0) {
+        // Status by connector ID, 255 = not reported yet
+        w.beginArray("connectors");
+        for (int16_t id = 0; id <= connectors->highestKnown(); id++) {
+            const ConnectorState* state = connectors->get((uint8_t)id);
+            w.element(state ? (uint32_t)state->status : 255u);
+        }
+        w.endArray();
+    }
+    w.endObject();
+    return w.length();
+}
+
+HeartbeatAction HeartbeatHandler::decide(
+    const DeviceConfig& config,
+    uint32_t now,
+    uint32_t lastHeartbeat,
+    uint32_t lastPublish,
+    uint32_t lastFields
+) {
+    uint32_t interval = config.system.heartbeatInterval;
+    if (now - lastHeartbeat <= interval) {
+        return HeartbeatAction::WAIT;
+    }
+
+    if (!config.system.heartbeatCoalesce || lastPublish == 0 || now - lastPublish > interval) {
+        return HeartbeatAction::SEND;
+    }
+
+    // Liveness is proven, but the health fields must not go stale forever
+    if (now - lastFields > interval * HEARTBEAT_COALESCE_MAX) {
+        return HeartbeatAction::SEND;
+    }
+    return HeartbeatAction::COALESCE;
+}
+
+void HeartbeatHandler::collect(
+    HeartbeatFields& fields,
+    CustomWiFiManager& wifi,
+    uint32_t bootTime,
+    const LoopProfiler* profiler
+) {
+    fields.uptime = (millis() - bootTime) / 1000;
+    fields.rssi = wifi.getStatus().rssi;
+    fields.freeHeap = ESP.getFreeHeap();
+    fields.heapFrag = ESP.getHeapFragmentation();
+    fields.hasLoop = profiler != nullptr;
+    fields.loopMaxUs = 0;
+    fields.stalls = 0;
+    if (profiler) {
+        const StageStats& loop = profiler->get(ProfileStage::LOOP);
+        fields.loopMaxUs = loop.maxUs;
+        fields.stalls = loop.stalls;
+    }
+}
 
 bool HeartbeatHandler::execute(
     MQTTClient& mqtt,
     CustomWiFiManager& wifi,
     const DeviceConfig& config,
-    uint32_t bootTime
+    uint32_t bootTime,
+    const LoopProfiler* profiler,
+    const ConnectorStateTable* connectors
 ) {
     // Check if MQTT is connected
     if (!mqtt.isConnected()) {
@@ -19,26 +89,30 @@ bool HeartbeatHandler::execute(
         return false;
     }
 
-    // Build heartbeat payload
-    StaticJsonDocument<256> doc;  // Stack allocated
-    doc["msgId"] = String(millis());
-    doc["uptime"] = (millis() - bootTime) / 1000;
-
-    const WiFiStatus& wifiStatus = wifi.getStatus();
-    doc["rssi"] = wifiStatus.rssi;
-    doc["freeHeap"] = ESP.getFreeHeap();
-    doc["heapFrag"] = ESP.getHeapFragmentation();
-
-    // Serialize to string
-    char payload[256];
-    serializeJson(doc, payload, sizeof(payload));
-
     // Build topic
     char topic[128];
     MQTTTopicBuilder::buildHeartbeat(topic, sizeof(topic), config);
 
+    // Build heartbeat payload (JSON, or MessagePack on {topic}/b)
+    HeartbeatFields fields;
+    collect(fields, wifi, bootTime, profiler);
+    char payload[224];
+    size_t length;
+
+    if (config.mqtt.binaryPayload) {
+        MQTTTopicBuilder::appendBinarySuffix(topic, sizeof(topic));
+        length = encodeHeartbeat<MsgPackWriter>(payload, sizeof(payload), fields, connectors);
+    } else {
+        length = encodeHeartbeat<JsonWriter>(payload, sizeof(payload), fields, connectors);
+    }
+
+    if (length == 0) {
+        LOG_ERROR("Heartbeat", "Payload too large");
+        return false;
+    }
+
     // Publish
-    MQTTError result = mqtt.publish(topic, payload, 1);
+    MQTTError result = mqtt.publish(topic, (const uint8_t*)payload, length, 1);
 
     if (result == MQTTError::SUCCESS) {
         LOG_DEBUG("Heartbeat", "Sent (heap: %u bytes)", ESP.getFreeHeap());
@@ -0,0 +1,115 @@
+/**
+ * @file meter_batcher.cpp
+ * @brief Meter value batching implementation
+ */
+
+#include "handlers/meter_batcher.h"
+#include "drivers/mqtt/mqtt_topic_builder.h"
+#include "utils/json_writer.h"
+#include "utils/logger.h"
+#include <string.h>
+
+MeterBatcher::MeterBatcher() : count(0), startedAt(0) {
+    msgId[0] = '\0';
+    timestamp[0] = '\0';
+    memset(&stats, 0, sizeof(stats));
+}
+
+bool MeterBatcher::add(const meter_values_t& meter, uint32_t now) {
+    if (count >= METER_BATCH_MAX_SAMPLES) {
+        return false;
+    }
+
+    if (count == 0) {
+        startedAt = now;
+        memcpy(msgId, meter.msg_id, sizeof(msgId));
+        msgId[sizeof(msgId) - 1] = '\0';
+        memcpy(timestamp, meter.timestamp, sizeof(timestamp));
+        timestamp[sizeof(timestamp) - 1] = '\0';
+    }
+
+    Entry& entry = entries[count++];
+    entry.offsetMs = now - startedAt;
+    entry.transactionId = meter.transaction_id;
+    entry.sample = meter.sample;
+    entry.connectorId = meter.connector_id;
+    return true;
+}
+
+bool MeterBatcher::isDue(const DeviceConfig& config, uint32_t now) const {
+    if (count == 0) return false;
+
+    uint8_t maxSamples = config.meter.batchMaxSamples;
+    if (maxSamples > METER_BATCH_MAX_SAMPLES) maxSamples = METER_BATCH_MAX_SAMPLES;
+
+    return count >= maxSamples || now - startedAt >= config.meter.batchWindowMs;
+}
+
+size_t MeterBatcher::serialize(char* buffer, size_t size, const HeartbeatFields* device) const {
+    if (count == 0) return 0;
+
+    JsonWriter w(buffer, size);
+    w.beginObject();
+    w.field("msgId", msgId);
+    w.field("timestamp", timestamp);
+    w.beginArray("samples");
+
+    for (uint8_t i = 0; i < count; i++) {
+        const Entry& entry = entries[i];
+        w.beginObject();
+        w.field("connectorId", entry.connectorId);
+        w.field("transactionId", entry.transactionId);
+        w.field("offsetMs", entry.offsetMs);
+        w.field("energy_wh", entry.sample.energy_wh);
+        w.field("power_w", entry.sample.power_w);
+        w.field("voltage_v", entry.sample.voltage_v);
+        w.field("current_a", entry.sample.current_a);
+        w.field("frequency_hz", entry.sample.frequency_hz);
+        w.field("temperature_c", entry.sample.temperature_c);
+        w.field("power_factor_pct", entry.sample.power_factor_pct);
+        w.endObject();
+    }
+
+    w.endArray();
+    if (device) {
+        w.beginObject("device");
+        HeartbeatHandler::writeFields(w, *device);
+        w.endObject();
+    }
+    w.endObject();
+    return w.length();
+}
+
+bool MeterBatcher::flush(MQTTClient& mqtt, const DeviceConfig& config, const HeartbeatFields* device) {
+    if (count == 0) return true;
+
+    uint8_t samples = count;
+    size_t length = serialize(payload, sizeof(payload), device);
+    count = 0;
+
+    if (length == 0) {
+        LOG_ERROR("Meter", "Batch payload too large (%u samples)", samples);
+        stats.batchesFailed++;
+        return false;
+    }
+
+    char topic[128];
+    MQTTTopicBuilder::buildMeterBatch(topic, sizeof(topic), config);
+
+    MQTTError result = mqtt.publish(topic, (const uint8_t*)payload, length, 1);
+
+    if (result == MQTTError::SUCCESS) {
+        LOG_DEBUG("Meter", "Batch published: %u samples, %u bytes", samples, length);
+        stats.batchesPublished++;
+        stats.samplesPublished += samples;
+        return true;
+    } else {
+        LOG_ERROR("Meter", "Batch publish failed (%u samples)", samples);
+        stats.batchesFailed++;
+        return false;
+    }
+}
+
+bool MeterBatcher::handle(MQTTClient& mqtt, const DeviceConfig& config, const HeartbeatFields* device) {
+    return isDue(config, millis()) && flush(mqtt, config, device);
+}
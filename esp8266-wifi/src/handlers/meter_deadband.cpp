@@ -0,0 +1,79 @@
+/**
+ * @file meter_deadband.cpp
+ * @brief Meter deadband filter implementation
+ */
+
+#include "handlers/meter_deadband.h"
+#include <string.h>
+
+static inline uint32_t absDiff(int32_t a, int32_t b) {
+    return (a > b) ? (uint32_t)(a - b) : (uint32_t)(b - a);
+}
+
+static inline bool moved(int32_t now, int32_t prev, uint32_t deadband) {
+    // Deadband 0 reports any change
+    uint32_t diff = absDiff(now, prev);
+    return deadband == 0 ? diff > 0 : diff >= deadband;
+}
+
+MeterDeadband::MeterDeadband() {
+    reset();
+}
+
+void MeterDeadband::reset() {
+    memset(last, 0, sizeof(last));
+    suppressedCount = 0;
+}
+
+void MeterDeadband::invalidate(uint8_t connectorId) {
+    if (connectorId < METER_DEADBAND_SLOTS) {
+        last[connectorId].valid = false;
+    }
+}
+
+bool MeterDeadband::exceeds(const LastSent& prev, const meter_values_t& meter,
+                            const DeviceConfig& config) const {
+    const meter_sample_t& a = meter.sample;
+    const meter_sample_t& b = prev.sample;
+
+    // Energy is cumulative and may exceed int32 range, compare unsigned
+    uint32_t energyDiff = a.energy_wh > b.energy_wh ? a.energy_wh - b.energy_wh
+                                                    : b.energy_wh - a.energy_wh;
+    bool energyMoved = config.meter.deadband.energyWh == 0
+                           ? energyDiff > 0
+                           : energyDiff >= config.meter.deadband.energyWh;
+
+    return energyMoved ||
+           moved(a.power_w, b.power_w, config.meter.deadband.powerW) ||
+           moved(a.voltage_v, b.voltage_v, config.meter.deadband.voltageV) ||
+           moved(a.current_a, b.current_a, config.meter.deadband.currentA) ||
+           moved(a.frequency_hz, b.frequency_hz, config.meter.deadband.frequencyHz) ||
+           moved(a.temperature_c, b.temperature_c, config.meter.deadband.temperatureC) ||
+           moved(a.power_factor_pct, b.power_factor_pct, config.meter.deadband.powerFactorPct);
+}
+
+bool MeterDeadband::shouldReport(const meter_values_t& meter, const DeviceConfig& config,
+                                 uint32_t now) {
+    // Unknown connector: no state to compare against
+    if (meter.connector_id >= METER_DEADBAND_SLOTS) {
+        return true;
+    }
+
+    LastSent& prev = last[meter.connector_id];
+
+    bool report = !prev.valid ||
+                  prev.transactionId != meter.transaction_id ||
+                  now - prev.sentAt >= config.meter.keyframeIntervalMs ||
+                  exceeds(prev, meter, config);
+
+    if (!report) {
+        suppressedCount++;
+        return false;
+    }
+
+    prev.sample = meter.sample;
+    prev.transactionId = meter.transaction_id;
+    prev.sentAt = now;
+    prev.valid = true;
+    return true;
+}
@@ -4,73 +4,337 @@
  */
 
 #include "handlers/mqtt_incoming_handler.h"
+#include "drivers/mqtt/mqtt_topic_builder.h"
 #include "utils/logger.h"
+#include "ocpp_messages.h"
+#include <ArduinoJson.h>
 #include <string.h>
 
+#define COMMAND_SEGMENT     "cmd/"
+#define COMMAND_SEGMENT_LEN (sizeof(COMMAND_SEGMENT) - 1)
+
+#define ROUTE(name, action) { name, sizeof(name) - 1, action }
+
+// Large command documents (local list, charging profiles); static, MQTT
+// callbacks run from loop() one at a time
+static StaticJsonDocument<1536> commandDoc;
+
+// Known cmd/<name> suffixes, matched by length first then bytes
+constexpr MQTTIncomingHandler::CommandRoute MQTTIncomingHandler::routes[] = {
+    ROUTE(OCPP_REMOTE_START, MQTTIncomingHandler::forwardRemoteStart),
+    ROUTE(OCPP_REMOTE_STOP,  MQTTIncomingHandler::forwardRemoteStop),
+    ROUTE(OCPP_SEND_LOCAL_LIST, MQTTIncomingHandler::updateLocalList),
+    ROUTE(OCPP_SET_CHARGING_PROFILE, MQTTIncomingHandler::setChargingProfile),
+    ROUTE(OCPP_CLEAR_CHARGING_PROFILE, MQTTIncomingHandler::clearChargingProfile),
+    ROUTE("reset",           MQTTIncomingHandler::forwardRaw),
+};
+
+#undef ROUTE
+
 void MQTTIncomingHandler::execute(
     const char* topic,
     const char* payload,
     uint16_t length,
     STM32Communicator& stm32,
-    const DeviceConfig& config
+    const DeviceConfig& config,
+    AuthCache* authCache,
+    ChargingProfileEngine* charging
 ) {
-    LOG_INFO("MQTTIn", "RX: %s -> %.*s", topic, length, payload);
-
     // Check if this is a command topic for this device
-    if (!isCommandTopic(topic, config)) {
+    const char* name = commandName(topic, config);
+    if (!name) {
         LOG_WARN("MQTTIn", "Topic not for this device, ignoring");
         return;
     }
 
-    // Forward to STM32 via UART
-    forwardToSTM32(topic, payload, length, stm32);
+    size_t nameLen = strlen(name);
+    size_t topicLen = (name - topic) + nameLen;
+    const CommandRoute* route = findRoute(name, nameLen);
+
+    if (route) {
+        CommandContext context = {stm32, authCache, charging};
+        route->action(topic, topicLen, payload, length, context);
+    } else {
+        // STM32 owns the full command set; pass through what we do not know
+        LOG_DEBUG("MQTTIn", "Unrouted command: %s", name);
+        forwardToSTM32(topic, topicLen, payload, length, stm32);
+    }
 }
 
-bool MQTTIncomingHandler::isCommandTopic(const char* topic, const DeviceConfig& config) {
+const char* MQTTIncomingHandler::commandName(const char* topic, const DeviceConfig& config) {
     // Expected format: ocpp/{stationId}/{deviceId}/cmd/...
-    char expectedPrefix[128];
-    snprintf(expectedPrefix, sizeof(expectedPrefix),
-             "ocpp/%s/%s/cmd/",
-             config.stationId,
-             config.deviceId);
+    size_t prefixLen;
+    const char* prefix = MQTTTopicBuilder::prefix(config, prefixLen);
+
+    if (strncmp(topic, prefix, prefixLen) != 0 ||
+        strncmp(topic + prefixLen, COMMAND_SEGMENT, COMMAND_SEGMENT_LEN) != 0) {
+        return nullptr;
+    }
 
-    return strncmp(topic, expectedPrefix, strlen(expectedPrefix)) == 0;
+    return topic + prefixLen + COMMAND_SEGMENT_LEN;
 }
 
-void MQTTIncomingHandler::forwardToSTM32(
+const MQTTIncomingHandler::CommandRoute* MQTTIncomingHandler::findRoute(const char* name, size_t length) {
+    for (const CommandRoute& route : routes) {
+        if (route.nameLength == length && memcmp(route.name, name, length) == 0) {
+            return &route;
+        }
+    }
+    return nullptr;
+}
+
+static void copyField(char* dest, size_t size, const char* value) {
+    if (!value) value = "";
+    size_t n = strnlen(value, size - 1);
+    memcpy(dest, value, n);
+    memset(dest + n, 0, size - n);
+}
+
+void MQTTIncomingHandler::forwardRemoteStart(
     const char* topic,
+    size_t topicLen,
     const char* payload,
     uint16_t length,
-    STM32Communicator& stm32
+    CommandContext& context
 ) {
-    // Create UART packet to forward MQTT message to STM32
-    uart_packet_t packet;
-    uart_init_packet(&packet, RSP_MQTT_RECEIVED, 0);  // Sequence 0 for async messages
+    // const input: strings are copied into doc, payload stays intact for fallback
+    StaticJsonDocument<384> doc;
+    if (deserializeJson(doc, payload, length) || !doc["connectorId"].is<uint8_t>()) {
+        LOG_WARN("MQTTIn", "remote_start not decodable, forwarding raw");
+        forwardToSTM32(topic, topicLen, payload, length, context.stm32);
+        return;
+    }
 
-    // Build combined payload: topic + data
-    // Format: topic\0payload
-    size_t topicLen = strlen(topic);
-    size_t totalLen = topicLen + 1 + length;  // +1 for null terminator
+    remote_start_cmd_t cmd;
+    copyField(cmd.msg_id, sizeof(cmd.msg_id), doc["msgId"]);
+    cmd.connector_id = doc["connectorId"];
+    copyField(cmd.id_tag, sizeof(cmd.id_tag), doc["idTag"]);
+    cmd.charging_profile_id = doc["chargingProfileId"] | 0;
+
+    sendRemoteCommand(REMOTE_CMD_START, &cmd, sizeof(cmd), context.stm32);
+}
+
+void MQTTIncomingHandler::forwardRemoteStop(
+    const char* topic,
+    size_t topicLen,
+    const char* payload,
+    uint16_t length,
+    CommandContext& context
+) {
+    StaticJsonDocument<256> doc;
+    if (deserializeJson(doc, payload, length) || !doc["transactionId"].is<uint32_t>()) {
+        LOG_WARN("MQTTIn", "remote_stop not decodable, forwarding raw");
+        forwardToSTM32(topic, topicLen, payload, length, context.stm32);
+        return;
+    }
+
+    remote_stop_cmd_t cmd;
+    copyField(cmd.msg_id, sizeof(cmd.msg_id), doc["msgId"]);
+    cmd.transaction_id = doc["transactionId"];
+
+    sendRemoteCommand(REMOTE_CMD_STOP, &cmd, sizeof(cmd), context.stm32);
+}
+
+static id_tag_status_t parseAuthStatus(const char* status) {
+    if (!status) return AUTH_INVALID;
+    if (strcmp(status, "Accepted") == 0) return AUTH_ACCEPTED;
+    if (strcmp(status, "Blocked") == 0) return AUTH_BLOCKED;
+    if (strcmp(status, "Expired") == 0) return AUTH_EXPIRED;
+    if (strcmp(status, "ConcurrentTx") == 0) return AUTH_CONCURRENT_TX;
+    return AUTH_INVALID;
+}
 
-    if (totalLen > UART_MAX_PAYLOAD) {
-        LOG_ERROR("MQTTIn", "Message too large: %d bytes (max %d)", totalLen, UART_MAX_PAYLOAD);
+void MQTTIncomingHandler::updateLocalList(
+    const char* topic,
+    size_t topicLen,
+    const char* payload,
+    uint16_t length,
+    CommandContext& context
+) {
+    if (!context.authCache) {
+        forwardToSTM32(topic, topicLen, payload, length, context.stm32);
         return;
     }
 
-    // Copy topic
-    memcpy(packet.payload, topic, topicLen);
-    packet.payload[topicLen] = '\0';
+    StaticJsonDocument<1536>& doc = commandDoc;
+    if (deserializeJson(doc, payload, length) || !doc["listVersion"].is<uint32_t>()) {
+        LOG_WARN("MQTTIn", "send_local_list not decodable, ignored");
+        return;
+    }
 
-    // Copy payload
-    memcpy(packet.payload + topicLen + 1, payload, length);
+    const char* updateType = doc["updateType"] | "Differential";
+    bool full = strcmp(updateType, "Full") == 0;
+    uint32_t now = millis();
+    AuthCache& cache = *context.authCache;
 
-    packet.length = totalLen;
+    cache.beginListUpdate(full, doc["listVersion"], now);
+
+    uint16_t applied = 0;
+    for (JsonObjectConst item : doc["localAuthorizationList"].as<JsonArrayConst>()) {
+        const char* idTag = item["idTag"];
+        if (!idTag) continue;
+
+        JsonObjectConst info = item["idTagInfo"];
+        if (info.isNull()) {
+            cache.removeListEntry(idTag, AUTH_ID_TAG_MAX, now);
+        } else if (!cache.setListEntry(idTag, AUTH_ID_TAG_MAX, parseAuthStatus(info["status"]),
+                                       info["expiryDate"] | 0u, now)) {
+            break;
+        }
+        applied++;
+    }
+
+    LOG_INFO("MQTTIn", "Local list v%u (%s): %u entries, %u total",
+             cache.getListVersion(), full ? "full" : "diff", applied, cache.size());
+}
+
+static int16_t parseChargingPurpose(const char* purpose) {
+    if (!purpose) return -1;
+    if (strcmp(purpose, "ChargePointMaxProfile") == 0) return CHARGING_PURPOSE_CP_MAX;
+    if (strcmp(purpose, "TxDefaultProfile") == 0) return CHARGING_PURPOSE_TX_DEFAULT;
+    if (strcmp(purpose, "TxProfile") == 0) return CHARGING_PURPOSE_TX;
+    return -1;
+}
+
+static uint8_t parseChargingKind(const char* kind) {
+    if (kind && strcmp(kind, "Recurring") == 0) return CHARGING_KIND_RECURRING;
+    if (kind && strcmp(kind, "Relative") == 0) return CHARGING_KIND_RELATIVE;
+    return CHARGING_KIND_ABSOLUTE;
+}
+
+void MQTTIncomingHandler::setChargingProfile(
+    const char* topic,
+    size_t topicLen,
+    const char* payload,
+    uint16_t length,
+    CommandContext& context
+) {
+    if (!context.charging) {
+        forwardToSTM32(topic, topicLen, payload, length, context.stm32);
+        return;
+    }
+
+    StaticJsonDocument<1536>& doc = commandDoc;
+    if (deserializeJson(doc, payload, length) || !doc["connectorId"].is<uint8_t>()) {
+        LOG_WARN("MQTTIn", "set_charging_profile not decodable, ignored");
+        return;
+    }
+
+    JsonObjectConst cs = doc["csChargingProfiles"];
+    JsonObjectConst schedule = cs["chargingSchedule"];
+    int16_t purpose = parseChargingPurpose(cs["chargingProfilePurpose"]);
+    if (purpose < 0 || schedule.isNull()) {
+        LOG_WARN("MQTTIn", "set_charging_profile incomplete, ignored");
+        return;
+    }
+
+    charging_profile_t profile;
+    memset(&profile, 0, sizeof(profile));
+    profile.id = cs["chargingProfileId"] | 0;
+    profile.connectorId = doc["connectorId"];
+    profile.stackLevel = cs["stackLevel"] | 0;
+    profile.purpose = (uint8_t)purpose;
+    profile.kind = parseChargingKind(cs["chargingProfileKind"]);
+    profile.recurrency = strcmp(cs["recurrencyKind"] | "Daily", "Weekly") == 0
+                             ? CHARGING_RECUR_WEEKLY : CHARGING_RECUR_DAILY;
+    profile.validFrom = cs["validFrom"] | 0u;
+    profile.validTo = cs["validTo"] | 0u;
+    profile.startSchedule = schedule["startSchedule"] | 0u;
+    profile.duration = schedule["duration"] | 0u;
+
+    // Limits are stored in 0.1 A; W schedules at the nominal voltage
+    bool watts = strcmp(schedule["chargingRateUnit"] | "A", "W") == 0;
+    for (JsonObjectConst period : schedule["chargingSchedulePeriod"].as<JsonArrayConst>()) {
+        if (profile.periodCount == CHARGING_PERIODS_MAX) break;
+
+        float limit = period["limit"] | 0.0f;
+        if (watts) {
+            uint8_t phases = period["numberPhases"] | 3;
+            limit /= (float)CHARGING_NOMINAL_VOLTAGE * (phases ? phases : 1);
+        }
+        float tenths = limit * 10.0f + 0.5f;
+
+        charging_period_t& slot = profile.periods[profile.periodCount++];
+        slot.startPeriod = period["startPeriod"] | 0u;
+        slot.limit = tenths >= (float)CHARGING_NO_LIMIT ? CHARGING_NO_LIMIT - 1 : (uint16_t)tenths;
+    }
+
+    context.charging->install(profile);
+}
+
+void MQTTIncomingHandler::clearChargingProfile(
+    const char* topic,
+    size_t topicLen,
+    const char* payload,
+    uint16_t length,
+    CommandContext& context
+) {
+    if (!context.charging) {
+        forwardToSTM32(topic, topicLen, payload, length, context.stm32);
+        return;
+    }
+
+    // All fields optional; an empty object clears everything
+    StaticJsonDocument<256> doc;
+    if (length > 0 && deserializeJson(doc, payload, length)) {
+        LOG_WARN("MQTTIn", "clear_charging_profile not decodable, ignored");
+        return;
+    }
+
+    context.charging->clear(
+        doc["id"] | -1,
+        doc["connectorId"] | -1,
+        parseChargingPurpose(doc["chargingProfilePurpose"]),
+        doc["stackLevel"] | -1);
+}
+
+void MQTTIncomingHandler::sendRemoteCommand(
+    uint8_t commandId,
+    const void* command,
+    uint16_t size,
+    STM32Communicator& stm32
+) {
+    // remote_command_payload_t: command ID byte, then the packed struct
+    UARTError result = stm32.sendCommand(RSP_REMOTE_COMMAND, &commandId, 1, command, size);
+
+    if (result == UARTError::SUCCESS) {
+        LOG_DEBUG("MQTTIn", "Remote command %u sent to STM32 (%u bytes)", commandId, size + 1);
+    } else {
+        LOG_ERROR("MQTTIn", "Failed to send remote command %u", commandId);
+    }
+}
+
+void MQTTIncomingHandler::forwardRaw(
+    const char* topic,
+    size_t topicLen,
+    const char* payload,
+    uint16_t length,
+    CommandContext& context
+) {
+    forwardToSTM32(topic, topicLen, payload, length, context.stm32);
+}
+
+void MQTTIncomingHandler::forwardToSTM32(
+    const char* topic,
+    size_t topicLen,
+    const char* payload,
+    uint16_t length,
+    STM32Communicator& stm32
+) {
+    // Format: topic\0payload, gathered straight into the UART frame
+    // (sent as fragments when over UART_MAX_PAYLOAD)
+    size_t totalLen = topicLen + 1 + length;  // +1 for null terminator
+
+    if (totalLen > UART_REASSEMBLY_SIZE) {
+        LOG_ERROR("MQTTIn", "Message too large: %d bytes (max %d)", totalLen, UART_REASSEMBLY_SIZE);
+        return;
+    }
 
-    // Send to STM32
-    UARTError result = stm32.sendPacket(packet);
+    // Send to STM32 as a command (own sequence, retried until ACKed on v2)
+    UARTError result = stm32.sendCommand(RSP_MQTT_RECEIVED, topic, topicLen + 1, payload, length);
 
     if (result == UARTError::SUCCESS) {
-        LOG_DEBUG("MQTTIn", "Forwarded to STM32: %s", topic);
+        LOG_DEBUG("MQTTIn", "Forwarded to STM32: %s (%u bytes)", topic, length);
     } else {
         LOG_ERROR("MQTTIn", "Failed to forward to STM32");
     }
@@ -5,8 +5,39 @@
 
 #include "handlers/ocpp_message_handler.h"
 #include "drivers/mqtt/mqtt_topic_builder.h"
+#include "handlers/ocpp_json.h"
 #include "utils/logger.h"
-#include <ArduinoJson.h>
+
+/**
+ * @brief Encode and publish (JSON, or MessagePack on {topic}/b)
+ * @param priority Outbound lane (transactions > status > telemetry)
+ */
+template<typename Message>
+static MQTTError publishEncoded(
+    MQTTClient& mqtt,
+    const DeviceConfig& config,
+    char* topic,
+    size_t topicSize,
+    const Message& msg,
+    MQTTPriority priority
+) {
+    char payload[512];
+    size_t length;
+
+    if (config.mqtt.binaryPayload) {
+        MQTTTopicBuilder::appendBinarySuffix(topic, topicSize);
+        length = OcppJson::write<MsgPackWriter>(payload, sizeof(payload), msg);
+    } else {
+        length = OcppJson::write<JsonWriter>(payload, sizeof(payload), msg);
+    }
+
+    if (length == 0) {
+        LOG_ERROR("OCPP", "Payload too large: %s", topic);
+        return MQTTError::INVALID_PARAM;
+    }
+
+    return mqtt.publish(topic, (const uint8_t*)payload, length, 1, priority);
+}
 
 // Status Notification
 bool OCPPMessageHandler::publishStatusNotification(
@@ -18,27 +49,64 @@ bool OCPPMessageHandler::publishStatusNotification(
     char topic[128];
     MQTTTopicBuilder::buildStatus(topic, sizeof(topic), config, status.connector_id);
 
-    // Build JSON payload
-    StaticJsonDocument<512> doc;
-    doc["msgId"] = status.msg_id;
-    doc["timestamp"] = status.timestamp;
-    doc["connectorId"] = status.connector_id;
-    doc["status"] = (int)status.status;
-    doc["errorCode"] = (int)status.error_code;
-    doc["info"] = status.info;
-    doc["vendorId"] = status.vendor_id;
+    // Encode and publish
+    MQTTError result = publishEncoded(mqtt, config, topic, sizeof(topic), status, MQTTPriority::STATUS);
+
+    if (result == MQTTError::SUCCESS) {
+        LOG_DEBUG("OCPP", "Status published: connector=%d, status=%d", status.connector_id, status.status);
+        return true;
+    } else {
+        LOG_ERROR("OCPP", "Status publish failed");
+        return false;
+    }
+}
+
+template<typename Writer>
+static size_t encodeSnapshot(char* buffer, size_t size, const ConnectorStateTable& states, uint32_t timestamp) {
+    char msgId[12];
+    snprintf(msgId, sizeof(msgId), "%u", (unsigned)millis());
+
+    Writer w(buffer, size);
+    w.beginObject();
+    w.field("msgId", msgId);
+    w.field("timestamp", timestamp);
+    states.writeArray(w, "connectors");
+    w.endObject();
+    return w.length();
+}
+
+// Connector snapshot
+bool OCPPMessageHandler::publishStatusSnapshot(
+    MQTTClient& mqtt,
+    const DeviceConfig& config,
+    const ConnectorStateTable& states,
+    uint32_t timestamp
+) {
+    char topic[128];
+    MQTTTopicBuilder::buildStatusSnapshot(topic, sizeof(topic), config);
 
     char payload[512];
-    serializeJson(doc, payload, sizeof(payload));
+    size_t length;
 
-    // Publish
-    MQTTError result = mqtt.publish(topic, payload, 1);
+    if (config.mqtt.binaryPayload) {
+        MQTTTopicBuilder::appendBinarySuffix(topic, sizeof(topic));
+        length = encodeSnapshot<MsgPackWriter>(payload, sizeof(payload), states, timestamp);
+    } else {
+        length = encodeSnapshot<JsonWriter>(payload, sizeof(payload), states, timestamp);
+    }
+
+    if (length == 0) {
+        LOG_ERROR("OCPP", "Payload too large: %s", topic);
+        return false;
+    }
+
+    MQTTError result = mqtt.publish(topic, (const uint8_t*)payload, length, 1, MQTTPriority::STATUS);
 
     if (result == MQTTError::SUCCESS) {
-        LOG_DEBUG("OCPP", "Status published: connector=%d, status=%d", status.connector_id, status.status);
+        LOG_INFO("OCPP", "Status snapshot published (%d connectors)", states.highestKnown() + 1);
         return true;
     } else {
-        LOG_ERROR("OCPP", "Status publish failed");
+        LOG_ERROR("OCPP", "Status snapshot publish failed");
         return false;
     }
 }
@@ -53,27 +121,8 @@ bool OCPPMessageHandler::publishMeterValues(
     char topic[128];
     MQTTTopicBuilder::buildMeter(topic, sizeof(topic), config, meter.connector_id);
 
-    // Build JSON payload
-    StaticJsonDocument<512> doc;
-    doc["msgId"] = meter.msg_id;
-    doc["timestamp"] = meter.timestamp;
-    doc["connectorId"] = meter.connector_id;
-    doc["transactionId"] = meter.transaction_id;
-
-    JsonObject sample = doc.createNestedObject("sample");
-    sample["energy_wh"] = meter.sample.energy_wh;
-    sample["power_w"] = meter.sample.power_w;
-    sample["voltage_v"] = meter.sample.voltage_v;
-    sample["current_a"] = meter.sample.current_a;
-    sample["frequency_hz"] = meter.sample.frequency_hz;
-    sample["temperature_c"] = meter.sample.temperature_c;
-    sample["power_factor_pct"] = meter.sample.power_factor_pct;
-
-    char payload[512];
-    serializeJson(doc, payload, sizeof(payload));
-
-    // Publish
-    MQTTError result = mqtt.publish(topic, payload, 1);
+    // Encode and publish
+    MQTTError result = publishEncoded(mqtt, config, topic, sizeof(topic), meter, MQTTPriority::TELEMETRY);
 
     if (result == MQTTError::SUCCESS) {
         LOG_DEBUG("OCPP", "Meter published: connector=%d, energy=%u Wh", meter.connector_id, meter.sample.energy_wh);
@@ -94,20 +143,8 @@ bool OCPPMessageHandler::publishStartTransaction(
     char topic[128];
     MQTTTopicBuilder::buildTransaction(topic, sizeof(topic), config, "start");
 
-    // Build JSON payload
-    StaticJsonDocument<512> doc;
-    doc["msgId"] = txStart.msg_id;
-    doc["timestamp"] = txStart.timestamp;
-    doc["connectorId"] = txStart.connector_id;
-    doc["idTag"] = txStart.id_tag;
-    doc["meterStart"] = txStart.meter_start;
-    doc["reservationId"] = txStart.reservation_id;
-
-    char payload[512];
-    serializeJson(doc, payload, sizeof(payload));
-
-    // Publish
-    MQTTError result = mqtt.publish(topic, payload, 1);
+    // Encode and publish
+    MQTTError result = publishEncoded(mqtt, config, topic, sizeof(topic), txStart, MQTTPriority::TRANSACTION);
 
     if (result == MQTTError::SUCCESS) {
         LOG_INFO("OCPP", "Start TX published: connector=%d, tag=%s", txStart.connector_id, txStart.id_tag);
@@ -128,20 +165,8 @@ bool OCPPMessageHandler::publishStopTransaction(
     char topic[128];
     MQTTTopicBuilder::buildTransaction(topic, sizeof(topic), config, "stop");
 
-    // Build JSON payload
-    StaticJsonDocument<512> doc;
-    doc["msgId"] = txStop.msg_id;
-    doc["timestamp"] = txStop.timestamp;
-    doc["transactionId"] = txStop.transaction_id;
-    doc["idTag"] = txStop.id_tag;
-    doc["meterStop"] = txStop.meter_stop;
-    doc["reason"] = txStop.reason;
-
-    char payload[512];
-    serializeJson(doc, payload, sizeof(payload));
-
-    // Publish
-    MQTTError result = mqtt.publish(topic, payload, 1);
+    // Encode and publish
+    MQTTError result = publishEncoded(mqtt, config, topic, sizeof(topic), txStop, MQTTPriority::TRANSACTION);
 
     if (result == MQTTError::SUCCESS) {
         LOG_INFO("OCPP", "Stop TX published: txId=%u", txStop.transaction_id);
@@ -162,20 +187,8 @@ bool OCPPMessageHandler::publishBootNotification(
     char topic[128];
     MQTTTopicBuilder::buildBoot(topic, sizeof(topic), config);
 
-    // Build JSON payload
-    StaticJsonDocument<512> doc;
-    doc["msgId"] = boot.msg_id;
-    doc["timestamp"] = boot.timestamp;
-    doc["chargePointModel"] = boot.charge_point_model;
-    doc["chargePointVendor"] = boot.charge_point_vendor;
-    doc["firmwareVersion"] = boot.firmware_version;
-    doc["chargePointSerialNumber"] = boot.charge_point_serial_number;
-
-    char payload[512];
-    serializeJson(doc, payload, sizeof(payload));
-
-    // Publish
-    MQTTError result = mqtt.publish(topic, payload, 1);
+    // Encode and publish
+    MQTTError result = publishEncoded(mqtt, config, topic, sizeof(topic), boot, MQTTPriority::STATUS);
 
     if (result == MQTTError::SUCCESS) {
         LOG_INFO("OCPP", "Boot notification published");
@@ -4,162 +4,883 @@
  */
 
 #include "handlers/ota_handler.h"
+#include "handlers/stm32_ota_sender.h"
 #include "utils/logger.h"
-#include <ESP8266HTTPClient.h>
-#include <ESP8266httpUpdate.h>
+#include "utils/retry_policy.h"
+#include "utils/delta_patch.h"
+#include "utils/memory_pool.h"
+#include "ota_signing_key.h"
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+#include <BearSSLHelpers.h>
+#include <Updater.h>
 #include <WiFiClient.h>
 
-bool OTAHandler::checkUpdate(
-    const char* url,
-    const char* currentVersion,
-    char* newVersion,
-    size_t newVersionSize
-) {
-    LOG_INFO("OTA", "Check update: %s (current: %s)", url, currentVersion);
+// Reconnects: jittered so a fleet-wide OTA does not hammer the server
+#define OTA_RETRY_BASE_MS       2000
+#define OTA_RETRY_MAX_MS        20000
+#define OTA_CONNECT_TIMEOUT_MS  3000    // Bounds the (blocking) TCP connect
+#define OTA_MIN_IMAGE_SIZE      1024
+
+enum class OTAPhase : uint8_t {
+    MANIFEST,
+    FIRMWARE,
+    RESTART                     // Verified and committed, reboot pending
+};
+
+enum class HttpPhase : uint8_t {
+    HEADERS,
+    BODY,
+    WAIT_RETRY
+};
 
+struct OTASession {
+    OTAPhase phase;
+    HttpPhase http;
+    uint8_t sequence;           // CMD_OTA_REQUEST sequence, echoed in every status
+    char url[OTA_URL_MAX + 1];  // Manifest, then patch or image
+    char imageUrl[OTA_URL_MAX + 1];
     WiFiClient client;
-    HTTPClient http;
 
-    http.begin(client, url);
-    int httpCode = http.GET();
+    // Current response
+    char line[160];
+    uint8_t lineLength;
+    int statusCode;
+    int32_t contentLength;      // -1 = not sent
+    int32_t rangeStart;         // Content-Range start, -1 = none
+    bool chunked;
+    bool headerLine;            // Past the status line
+    uint32_t skip;              // Server ignored Range: drop what we have
+
+    // Progress over all connections
+    uint32_t received;          // Body bytes kept = resume offset
+    uint32_t written;           // Image bytes produced
+    uint32_t total;             // Image size from the manifest
+    uint32_t receivedAtConnect;
+    uint32_t lastActivity;
+    uint32_t retryAt;
+    uint8_t stalls;
+    uint8_t reportedPercent;
+    DecorrelatedJitter retryPolicy;
+
+    // Manifest
+    char manifest[OTA_MANIFEST_MAX + 1];
+    char version[32];
+    uint8_t sha256[32];
+    uint8_t signature[OTA_SIGNATURE_MAX];
+    uint16_t signatureLength;
+
+    // Delta: patch bytes the decoder has not taken yet (a COPY was pending)
+    bool delta;
+    DeltaPatch patch;
+    uint8_t pending[OTA_CHUNK_SIZE];
+    uint16_t pendingOffset;
+    uint16_t pendingLength;
+
+    // STM32 image: staged in LittleFS, then sent by STM32OTASender
+    bool stm32Target;
+    File stage;
+
+    // Image
+    BearSSL::HashSHA256 hash;
+    uint8_t tail[OTA_HOLDBACK_BYTES];
+    uint32_t restartAt;
+
+    OTASession()
+        : retryPolicy(OTA_RETRY_BASE_MS, OTA_RETRY_MAX_MS, ESP.getChipId() ^ 0x4F544121) {}
+};
 
-    if (httpCode == HTTP_CODE_OK) {
-        String version = http.getString();
-        version.trim();
+// ~4 KB reserved for good: a heap this size may be gone after weeks of uptime
+static BlockPool<sizeof(OTASession), 1> sessionPool("ota");
+static OTASession* session = nullptr;
 
-        // Copy to output
-        strncpy(newVersion, version.c_str(), newVersionSize - 1);
-        newVersion[newVersionSize - 1] = '\0';
+/**
+ * @brief Split http://host[:port]/path
+ */
+static bool parseUrl(const char* url, char* host, size_t hostSize, uint16_t& port, const char*& path) {
+    static const char scheme[] = "http://";
+    if (strncmp(url, scheme, sizeof(scheme) - 1) != 0) return false;
+
+    const char* start = url + sizeof(scheme) - 1;
+    const char* end = start;
+    while (*end && *end != ':' && *end != '/') end++;
+
+    size_t hostLength = end - start;
+    if (hostLength == 0 || hostLength >= hostSize) return false;
+    memcpy(host, start, hostLength);
+    host[hostLength] = '\0';
+
+    port = 80;
+    if (*end == ':') {
+        long value = strtol(end + 1, (char**)&end, 10);
+        if (value <= 0 || value > 65535) return false;
+        port = (uint16_t)value;
+    }
+
+    path = *end == '/' ? end : "/";
+    return *end == '\0' || *end == '/';
+}
 
-        http.end();
+static bool hexToBytes(const char* hex, uint8_t* out, size_t maxLength, uint16_t& length) {
+    size_t digits = strlen(hex);
+    if (digits % 2 != 0 || digits / 2 > maxLength) return false;
+
+    for (size_t i = 0; i < digits; i += 2) {
+        char pair[3] = { hex[i], hex[i + 1], '\0' };
+        char* end;
+        out[i / 2] = (uint8_t)strtoul(pair, &end, 16);
+        if (*end != '\0') return false;
+    }
+    length = digits / 2;
+    return true;
+}
+
+static void addLine(BearSSL::HashSHA256& hash, const char* text) {
+    hash.add(text, strlen(text));
+    hash.add("\n", 1);
+}
+
+static bool headerIs(const char* line, const char* name) {
+    return strncasecmp(line, name, strlen(name)) == 0;
+}
+
+void OTAHandler::handleFromSTM32(
+    const UartFrameView& frame,
+    STM32Communicator& stm32
+) {
+    // Extract URL from frame (NUL-terminated copy, frame data is raw)
+    char url[OTA_URL_MAX + 1];
+    uint16_t urlLen = frame.copyTo(url, 0, sizeof(url) - 1);
+    url[urlLen] = '\0';
+
+    LOG_INFO("OTA", "Request from STM32: %s", url);
+
+    if (frame.length > OTA_URL_MAX) {
+        sendOTAStatus(stm32, frame.sequence, OTA_STATUS_FAILED_URL, nullptr, "URL too long");
+        return;
+    }
+
+    begin(url, frame.sequence, stm32);
+}
+
+bool OTAHandler::begin(const char* manifestUrl, uint8_t sequence, STM32Communicator& stm32) {
+    if (session || STM32OTASender::isActive()) {
+        sendOTAStatus(stm32, sequence, OTA_STATUS_BUSY, session, "Update in progress");
+        return false;
+    }
+
+    char host[64];
+    uint16_t port;
+    const char* path;
+    if (!parseUrl(manifestUrl, host, sizeof(host), port, path)) {
+        sendOTAStatus(stm32, sequence, OTA_STATUS_FAILED_URL, nullptr, "Invalid URL");
+        return false;
+    }
+
+    session = sessionPool.create<OTASession>();
+    if (!session) {
+        sendOTAStatus(stm32, sequence, OTA_STATUS_BUSY, nullptr, "No session memory");
+        return false;
+    }
+    session->phase = OTAPhase::MANIFEST;
+    session->sequence = sequence;
+    strncpy(session->url, manifestUrl, sizeof(session->url) - 1);
+    session->url[sizeof(session->url) - 1] = '\0';
+    session->received = 0;
+    session->written = 0;
+    session->total = 0;
+    session->delta = false;
+    session->stm32Target = false;
+    session->stalls = 0;
+    session->reportedPercent = 0;
+
+    LOG_INFO("OTA", "Fetching manifest: %s", manifestUrl);
+    sendOTAStatus(stm32, sequence, OTA_STATUS_STARTED, session, "Fetching manifest");
+    openConnection(*session);
+    return true;
+}
+
+void OTAHandler::handle(STM32Communicator& stm32) {
+    if (!session) return;
+    OTASession& s = *session;
+
+    if (s.phase == OTAPhase::RESTART) {
+        if ((int32_t)(millis() - s.restartAt) >= 0) {
+            LOG_INFO("OTA", "Rebooting into %s", s.version);
+            ESP.restart();
+        }
+        return;
+    }
+
+    switch (s.http) {
+        case HttpPhase::WAIT_RETRY:
+            if (s.stalls > OTA_MAX_STALLS) {
+                fail(s, stm32, OTAResult::FAILED_HTTP, "Download stalled");
+            } else if ((int32_t)(millis() - s.retryAt) >= 0) {
+                LOG_INFO("OTA", "Reconnecting at %u/%u bytes", s.received, s.total);
+                openConnection(s);
+            }
+            break;
+
+        case HttpPhase::HEADERS:
+            if (!readHeaders(s)) {
+                if (!s.client.connected() && s.client.available() == 0) {
+                    connectionLost(s, "closed before headers");
+                } else if (millis() - s.lastActivity > OTA_IO_TIMEOUT_MS) {
+                    connectionLost(s, "header timeout");
+                }
+                break;
+            }
+
+            if (s.chunked) {
+                fail(s, stm32, OTAResult::FAILED_HTTP, "Chunked transfer not supported");
+            } else if (s.statusCode == 206 && s.rangeStart == (int32_t)s.received) {
+                s.skip = 0;
+                s.http = HttpPhase::BODY;
+            } else if (s.statusCode == 200) {
+                // Full body again (no Range support): skip what we already have
+                if (s.phase == OTAPhase::FIRMWARE && !s.delta && s.contentLength >= 0 &&
+                    (uint32_t)s.contentLength != s.total) {
+                    fail(s, stm32, OTAResult::FAILED_MANIFEST, "Image size differs from manifest");
+                    break;
+                }
+                s.skip = s.received;
+                s.http = HttpPhase::BODY;
+            } else if (s.statusCode >= 500 || s.statusCode == 408 || s.statusCode == 429 ||
+                       s.statusCode == 206) {
+                connectionLost(s, "server busy or bad range");
+            } else if (s.delta) {
+                LOG_WARN("OTA", "HTTP %d: %s", s.statusCode, s.url);
+                fallbackToFull(s, stm32, "patch not available");
+            } else {
+                LOG_ERROR("OTA", "HTTP %d: %s", s.statusCode, s.url);
+                fail(s, stm32, OTAResult::FAILED_HTTP, "HTTP error");
+            }
+            break;
+
+        case HttpPhase::BODY:
+            readBody(s, stm32);
+            break;
+    }
+}
+
+bool OTAHandler::isActive() {
+    return session != nullptr;
+}
 
-        // Compare versions
-        if (strcmp(currentVersion, newVersion) != 0) {
-            LOG_INFO("OTA", "Update available: %s -> %s", currentVersion, newVersion);
+void OTAHandler::openConnection(OTASession& s) {
+    char host[64];
+    uint16_t port;
+    const char* path;
+    parseUrl(s.url, host, sizeof(host), port, path);    // Validated before
+
+    s.http = HttpPhase::HEADERS;
+    s.lineLength = 0;
+    s.statusCode = 0;
+    s.contentLength = -1;
+    s.rangeStart = -1;
+    s.chunked = false;
+    s.headerLine = false;
+    s.skip = 0;
+    s.receivedAtConnect = s.received;
+    s.lastActivity = millis();
+
+    s.client.stop();
+    s.client.setTimeout(OTA_CONNECT_TIMEOUT_MS);
+    if (!s.client.connect(host, port)) {
+        connectionLost(s, "connect failed");
+        return;
+    }
+
+    char request[OTA_URL_MAX + 192];
+    int length = snprintf(request, sizeof(request),
+                          "GET %s HTTP/1.1\r\nHost: %s:%u\r\nUser-Agent: SolEVC-OTA/%s\r\nConnection: close\r\n",
+                          path, host, port, FIRMWARE_VERSION);
+
+    // Manifests are small and fetched whole; images resume where they stopped
+    if (s.phase == OTAPhase::FIRMWARE && s.received > 0) {
+        length += snprintf(request + length, sizeof(request) - length, "Range: bytes=%u-\r\n", s.received);
+    }
+    length += snprintf(request + length, sizeof(request) - length, "\r\n");
+
+    s.client.write((const uint8_t*)request, length);
+}
+
+bool OTAHandler::readHeaders(OTASession& s) {
+    while (s.client.available() > 0) {
+        int c = s.client.read();
+        if (c < 0) break;
+        s.lastActivity = millis();
+
+        if (c == '\r') continue;
+        if (c != '\n') {
+            if (s.lineLength < sizeof(s.line) - 1) s.line[s.lineLength++] = (char)c;
+            continue;
+        }
+
+        s.line[s.lineLength] = '\0';
+        uint8_t length = s.lineLength;
+        s.lineLength = 0;
+
+        if (!s.headerLine) {
+            // "HTTP/1.1 206 Partial Content"
+            const char* code = strchr(s.line, ' ');
+            s.statusCode = code ? atoi(code + 1) : 0;
+            s.headerLine = true;
+        } else if (length == 0) {
             return true;
-        } else {
-            LOG_INFO("OTA", "Already up to date");
-            return false;
+        } else if (headerIs(s.line, "Content-Length:")) {
+            s.contentLength = strtol(s.line + 15, nullptr, 10);
+        } else if (headerIs(s.line, "Content-Range:")) {
+            // "bytes 1200-412367/412368"
+            const char* range = strstr(s.line, "bytes");
+            s.rangeStart = range ? strtol(range + 5, nullptr, 10) : -1;
+        } else if (headerIs(s.line, "Transfer-Encoding:")) {
+            s.chunked = strstr(s.line, "chunked") != nullptr;
+        }
+    }
+    return false;
+}
+
+void OTAHandler::readBody(OTASession& s, STM32Communicator& stm32) {
+    uint8_t buffer[OTA_CHUNK_SIZE];
+    uint32_t budget = OTA_PASS_BUDGET;
+
+    // Bounded per pass so the STM32 link is serviced between chunks
+    while (budget > 0) {
+        if (s.delta) {
+            if (!consumeDelta(s, budget)) {
+                fallbackToFull(s, stm32, "patch does not apply");
+                return;
+            }
+            if (s.patch.hasPendingCopy() || s.pendingLength > 0) break;
+        }
+
+        int available = s.client.available();
+        if (available <= 0) break;
+
+        size_t want = (size_t)available < sizeof(buffer) ? (size_t)available : sizeof(buffer);
+        if (want > budget) want = budget;
+
+        uint8_t* chunk = s.delta ? s.pending : buffer;
+        int got = s.client.read(chunk, want);
+        if (got <= 0) break;
+
+        budget -= got;
+        s.lastActivity = millis();
+
+        if (s.phase == OTAPhase::MANIFEST) {
+            if (s.received + got > OTA_MANIFEST_MAX) {
+                fail(s, stm32, OTAResult::FAILED_MANIFEST, "Manifest too large");
+                return;
+            }
+            memcpy(s.manifest + s.received, chunk, got);
+            s.received += got;
+            continue;
+        }
+
+        size_t offset = 0;
+        if (s.skip > 0) {
+            offset = (size_t)got < s.skip ? (size_t)got : s.skip;
+            s.skip -= offset;
+        }
+
+        if (s.delta) {
+            s.pendingOffset = offset;
+            s.pendingLength = got;
+            s.received += got - offset;
+        } else if (!consumeImage(s, chunk + offset, got - offset)) {
+            LOG_ERROR("OTA", "Flash write failed: %s", Update.getErrorString().c_str());
+            fail(s, stm32, OTAResult::FAILED_FLASH, "Flash write failed");
+            return;
+        }
+    }
+
+    bool closed = !s.client.connected() && s.client.available() == 0;
+
+    if (s.phase == OTAPhase::MANIFEST) {
+        bool complete = s.contentLength >= 0 ? s.received >= (uint32_t)s.contentLength : closed;
+        if (complete) {
+            s.client.stop();
+            s.manifest[s.received] = '\0';
+            if (loadManifest(s, stm32)) {
+                startFirmware(s, stm32);
+            }
+        } else if (closed) {
+            connectionLost(s, "manifest truncated");
+        } else if (millis() - s.lastActivity > OTA_IO_TIMEOUT_MS) {
+            connectionLost(s, "manifest timeout");
+        }
+        return;
+    }
+
+    if (s.written >= s.total) {
+        finishFirmware(s, stm32);
+        return;
+    }
+
+    uint8_t percent = (uint8_t)((uint64_t)s.written * 100 / s.total);
+    if (percent >= s.reportedPercent + OTA_PROGRESS_STEP_PCT) {
+        s.reportedPercent = percent - percent % OTA_PROGRESS_STEP_PCT;
+        sendOTAStatus(stm32, s.sequence, OTA_STATUS_PROGRESS, &s, "Downloading");
+    }
+
+    // Patch bytes still to decode: busy, whatever the socket does
+    if (s.delta && (s.patch.hasPendingCopy() || s.pendingLength > 0)) {
+        s.lastActivity = millis();
+        return;
+    }
+
+    if (closed) {
+        connectionLost(s, "connection closed");
+    } else if (millis() - s.lastActivity > OTA_IO_TIMEOUT_MS) {
+        connectionLost(s, "no data");
+    }
+}
+
+bool OTAHandler::consumeImage(OTASession& s, const uint8_t* data, size_t length) {
+    if (length > s.total - s.received) length = s.total - s.received;
+    if (length == 0) return true;
+
+    if (!writeImage(s, data, length)) return false;
+    s.received += length;
+    return true;
+}
+
+bool OTAHandler::consumeDelta(OTASession& s, uint32_t& budget) {
+    // Budget counts image bytes produced and patch bytes decoded alike
+    while (budget > 0 && !s.patch.hasError() && !s.patch.isComplete()) {
+        if (s.patch.hasPendingCopy()) {
+            size_t produced = s.patch.pump(budget);
+            budget -= produced < budget ? produced : budget;
+            continue;
         }
+        if (s.pendingOffset >= s.pendingLength) break;
+
+        size_t used = s.patch.feed(s.pending + s.pendingOffset, s.pendingLength - s.pendingOffset);
+        s.pendingOffset += used;
+        budget -= used < budget ? used : budget;
+    }
+
+    if (s.pendingOffset >= s.pendingLength || s.patch.isComplete()) {
+        s.pendingOffset = 0;
+        s.pendingLength = 0;
+    }
+
+    if (s.patch.hasError()) {
+        LOG_ERROR("OTA", "Patch error %u at %u bytes", (uint8_t)s.patch.getError(), s.written);
+        return false;
+    }
+    return true;
+}
+
+bool OTAHandler::writeImage(OTASession& s, const uint8_t* data, size_t length) {
+    if (length > s.total - s.written) return false;
+
+    s.hash.add(data, length);
+
+    // Staged STM32 image: nothing bootable, no holdback needed
+    if (s.stm32Target) {
+        if (s.stage.write(data, length) != length) return false;
+        s.written += length;
+        return true;
+    }
+
+    // Everything before the holdback goes to flash now; the tail is kept
+    // in RAM so an image failing verification is never complete in flash
+    uint32_t limit = s.total - OTA_HOLDBACK_BYTES;
+    size_t direct = 0;
+    if (s.written < limit) {
+        direct = length < limit - s.written ? length : limit - s.written;
+        if (Update.write(const_cast<uint8_t*>(data), direct) != direct) return false;
+    }
+    if (length > direct) {
+        memcpy(s.tail + (s.written + direct - limit), data + direct, length - direct);
+    }
+
+    s.written += length;
+    return true;
+}
+
+bool OTAHandler::readRunningImage(uint32_t offset, uint8_t* data, size_t length, void*) {
+    // The running sketch starts at flash offset 0
+    return ESP.flashRead(offset, data, length);
+}
+
+bool OTAHandler::writeDeltaOutput(const uint8_t* data, size_t length, void* context) {
+    return writeImage(*static_cast<OTASession*>(context), data, length);
+}
+
+void OTAHandler::fallbackToFull(OTASession& s, STM32Communicator& stm32, const char* reason) {
+    LOG_WARN("OTA", "Delta update failed (%s), downloading full image", reason);
+    s.client.stop();
+
+    // Discard what the patch produced so far
+    if (Update.isRunning()) {
+        Update.end();
+    }
+
+    s.delta = false;
+    strcpy(s.url, s.imageUrl);
+    startFirmware(s, stm32);
+}
+
+void OTAHandler::connectionLost(OTASession& s, const char* reason) {
+    s.client.stop();
+
+    if (s.phase == OTAPhase::MANIFEST) {
+        s.received = 0;     // Fetched whole again
+    }
+
+    if (s.received > s.receivedAtConnect) {
+        s.stalls = 0;
+        s.retryPolicy.reset();
     } else {
-        LOG_ERROR("OTA", "HTTP error: %d", httpCode);
-        http.end();
+        s.stalls++;
+    }
+
+    uint32_t wait = s.retryPolicy.getNextDelay(s.stalls);
+    LOG_WARN("OTA", "Download interrupted (%s) at %u bytes, retry %u in %u ms",
+             reason, s.received, s.stalls, wait);
+
+    s.http = HttpPhase::WAIT_RETRY;
+    s.retryAt = millis() + wait;
+}
+
+bool OTAHandler::loadManifest(OTASession& s, STM32Communicator& stm32) {
+    // Zero-copy parse: strings point into s.manifest
+    StaticJsonDocument<384> doc;
+    DeserializationError error = deserializeJson(doc, s.manifest);
+    if (error) {
+        fail(s, stm32, OTAResult::FAILED_MANIFEST, "Manifest is not JSON");
+        return false;
+    }
+
+    const char* version = doc["version"] | "";
+    const char* url = doc["url"] | "";
+    const char* sha256 = doc["sha256"] | "";
+    const char* signature = doc["signature"] | "";
+    uint32_t size = doc["size"] | 0;
+    const char* deltaUrl = doc["delta"]["url"] | "";
+    const char* deltaBase = doc["delta"]["base"] | "";
+    const char* target = doc["target"] | "esp8266";
+
+    uint16_t hashLength = 0;
+    char host[64];
+    uint16_t port;
+    const char* path;
+    if (strlen(url) > OTA_URL_MAX || !parseUrl(url, host, sizeof(host), port, path) ||
+        size < OTA_MIN_IMAGE_SIZE ||
+        !hexToBytes(sha256, s.sha256, sizeof(s.sha256), hashLength) || hashLength != sizeof(s.sha256) ||
+        !hexToBytes(signature, s.signature, sizeof(s.signature), s.signatureLength)) {
+        fail(s, stm32, OTAResult::FAILED_MANIFEST, "Manifest incomplete or invalid");
+        return false;
+    }
+
+    // Before any field is acted on: version, target and base are signed too
+    if (!verifyManifest(s, target, version, size, deltaBase)) {
+        fail(s, stm32, OTAResult::FAILED_VERIFY, "Manifest signature invalid");
+        return false;
+    }
+
+    strncpy(s.version, version, sizeof(s.version) - 1);
+    s.version[sizeof(s.version) - 1] = '\0';
+
+    if (strcmp(target, "stm32") == 0) {
+        // The STM32 asked for this image and knows its own version
+        s.stm32Target = true;
+        strcpy(s.imageUrl, url);
+        strcpy(s.url, url);
+        s.total = size;
+        LOG_INFO("OTA", "Manifest: STM32 image %s, %u bytes", s.version, size);
+        return true;
+    }
+    if (strcmp(target, "esp8266") != 0) {
+        fail(s, stm32, OTAResult::FAILED_MANIFEST, "Unknown target");
+        return false;
+    }
+
+    if (strcmp(s.version, getCurrentVersion()) == 0) {
+        LOG_INFO("OTA", "Already up to date (%s)", s.version);
+        fail(s, stm32, OTAResult::UP_TO_DATE, "Already up to date");
         return false;
     }
+
+    strcpy(s.imageUrl, url);
+    strcpy(s.url, url);
+    s.total = size;
+    LOG_INFO("OTA", "Manifest: %s -> %s, %u bytes", getCurrentVersion(), s.version, size);
+
+    // A patch only applies to the exact image it was made from
+    s.delta = false;
+    if (*deltaUrl && strlen(deltaUrl) <= OTA_URL_MAX && parseUrl(deltaUrl, host, sizeof(host), port, path)) {
+        if (strcasecmp(ESP.getSketchMD5().c_str(), deltaBase) == 0) {
+            strcpy(s.url, deltaUrl);
+            s.delta = true;
+            LOG_INFO("OTA", "Using delta patch %s", deltaUrl);
+        } else {
+            LOG_INFO("OTA", "Delta is for another base image, using full image");
+        }
+    }
+    return true;
 }
 
-OTAResult OTAHandler::performUpdate(const char* url) {
-    LOG_INFO("OTA", "Starting update: %s", url);
+bool OTAHandler::startFirmware(OTASession& s, STM32Communicator& stm32) {
+    if (s.stm32Target) {
+        return startStaging(s, stm32);
+    }
 
-    // Check free space
     uint32_t freeSpace = ESP.getFreeSketchSpace();
-    LOG_INFO("OTA", "Free sketch space: %u bytes", freeSpace);
+    if (s.total > freeSpace) {
+        LOG_ERROR("OTA", "Image %u bytes, free sketch space %u", s.total, freeSpace);
+        fail(s, stm32, OTAResult::FAILED_NO_SPACE, "Insufficient space");
+        return false;
+    }
 
-    if (freeSpace < 100000) {  // Need at least 100KB
-        LOG_ERROR("OTA", "Not enough space");
-        return OTAResult::FAILED_NO_SPACE;
+    if (!Update.begin(s.total)) {
+        LOG_ERROR("OTA", "Update.begin failed: %s", Update.getErrorString().c_str());
+        fail(s, stm32, OTAResult::FAILED_FLASH, "Flash init failed");
+        return false;
     }
 
-    // Perform update
-    WiFiClient client;
-    ESPhttpUpdate.setLedPin(LED_BUILTIN, LOW);  // Blink LED during update
+    s.hash.begin();
+    s.phase = OTAPhase::FIRMWARE;
+    s.received = 0;
+    s.written = 0;
+    s.reportedPercent = 0;
+    s.pendingOffset = 0;
+    s.pendingLength = 0;
+    if (s.delta) {
+        s.patch.begin(ESP.getSketchSize(), readRunningImage, writeDeltaOutput, &s);
+    }
+    s.stalls = 0;
+    s.retryPolicy.reset();
+
+    sendOTAStatus(stm32, s.sequence, OTA_STATUS_PROGRESS, &s, "Downloading");
+    openConnection(s);
+    return true;
+}
 
-    t_httpUpdate_return ret = ESPhttpUpdate.update(client, url);
+bool OTAHandler::startStaging(OTASession& s, STM32Communicator& stm32) {
+    if (stm32.getProtocolVersion() < UART_PROTOCOL_V2) {
+        fail(s, stm32, OTAResult::FAILED_MANIFEST, "STM32 image needs UART protocol v2");
+        return false;
+    }
 
-    switch (ret) {
-        case HTTP_UPDATE_FAILED:
-            LOG_ERROR("OTA", "Update failed: %s",
-                     ESPhttpUpdate.getLastErrorString().c_str());
-            return OTAResult::FAILED_HTTP;
+    // Resume a partial staged copy: re-hash what is there, fetch the rest.
+    // A copy of another image fails verification and is removed then.
+    uint32_t existing = 0;
+    s.hash.begin();
+    File previous = LittleFS.open(STM32_OTA_STAGE_PATH, "r");
+    if (previous && previous.size() <= s.total) {
+        uint8_t buffer[OTA_CHUNK_SIZE];
+        int n;
+        while ((n = previous.read(buffer, sizeof(buffer))) > 0) {
+            s.hash.add(buffer, n);
+            existing += n;
+        }
+    }
+    if (previous) previous.close();
+    if (existing == 0) LittleFS.remove(STM32_OTA_STAGE_PATH);
 
-        case HTTP_UPDATE_NO_UPDATES:
-            LOG_INFO("OTA", "No updates available");
-            return OTAResult::SUCCESS;
+    FSInfo info;
+    LittleFS.info(info);
+    uint32_t freeSpace = info.totalBytes - info.usedBytes;
+    if (s.total - existing > freeSpace) {
+        LOG_ERROR("OTA", "STM32 image %u bytes, %u free in LittleFS", s.total, freeSpace);
+        fail(s, stm32, OTAResult::FAILED_NO_SPACE, "Insufficient space");
+        return false;
+    }
 
-        case HTTP_UPDATE_OK:
-            LOG_INFO("OTA", "Update successful! Rebooting...");
-            delay(1000);
-            ESP.restart();
-            return OTAResult::SUCCESS;
+    s.stage = LittleFS.open(STM32_OTA_STAGE_PATH, "a");
+    if (!s.stage) {
+        fail(s, stm32, OTAResult::FAILED_FLASH, "Cannot open staging file");
+        return false;
+    }
+
+    s.phase = OTAPhase::FIRMWARE;
+    s.received = existing;
+    s.written = existing;
+    s.reportedPercent = 0;
+    s.stalls = 0;
+    s.retryPolicy.reset();
 
-        default:
-            return OTAResult::FAILED_FLASH;
+    if (existing == s.total) {
+        LOG_INFO("OTA", "STM32 image already staged");
+        finishFirmware(s, stm32);
+        return true;
     }
+    if (existing > 0) {
+        LOG_INFO("OTA", "Resuming staged STM32 image at %u bytes", existing);
+    }
+
+    sendOTAStatus(stm32, s.sequence, OTA_STATUS_PROGRESS, &s, "Downloading");
+    openConnection(s);
+    return true;
 }
 
-void OTAHandler::handleFromSTM32(
-    const uart_packet_t& packet,
-    STM32Communicator& stm32
-) {
-    // Extract URL from packet
-    const char* url = (const char*)packet.payload;
+void OTAHandler::finishStaging(OTASession& s, STM32Communicator& stm32) {
+    s.stage.close();
 
-    LOG_INFO("OTA", "Request from STM32: %s", url);
+    if (!verifyUpdate(s)) {
+        LittleFS.remove(STM32_OTA_STAGE_PATH);
+        fail(s, stm32, OTAResult::FAILED_VERIFY, "Verification failed");
+        return;
+    }
+
+    if (!STM32OTASender::begin(s.total, s.sha256, s.version, stm32)) {
+        fail(s, stm32, OTAResult::FAILED_FLASH, "STM32 transfer could not start");
+        return;
+    }
+
+    LOG_INFO("OTA", "STM32 image %s verified and staged", s.version);
+    sendOTAStatus(stm32, s.sequence, OTA_STATUS_STAGED, &s, "Staged, sending to STM32");
+
+    sessionPool.destroy(session);
+    session = nullptr;
+}
+
+void OTAHandler::finishFirmware(OTASession& s, STM32Communicator& stm32) {
+    s.client.stop();
+    sendOTAStatus(stm32, s.sequence, OTA_STATUS_VERIFYING, &s, "Verifying");
 
-    // Validate URL
-    if (strlen(url) == 0 || strlen(url) > 256) {
-        sendOTAStatus(stm32, packet.sequence, OTAResult::FAILED_INVALID_URL);
+    if (s.stm32Target) {
+        finishStaging(s, stm32);
         return;
     }
 
-    // Perform update
-    OTAResult result = performUpdate(url);
+    if (!verifyUpdate(s)) {
+        if (s.delta) {
+            fallbackToFull(s, stm32, "rebuilt image does not verify");
+        } else {
+            fail(s, stm32, OTAResult::FAILED_VERIFY, "Verification failed");
+        }
+        return;
+    }
 
-    // Send status (only if update failed, success will reboot)
-    if (result != OTAResult::SUCCESS) {
-        sendOTAStatus(stm32, packet.sequence, result);
+    if (Update.write(s.tail, OTA_HOLDBACK_BYTES) != OTA_HOLDBACK_BYTES || !Update.end()) {
+        LOG_ERROR("OTA", "Update.end failed: %s", Update.getErrorString().c_str());
+        fail(s, stm32, OTAResult::FAILED_FLASH, "Flash write failed");
+        return;
     }
+
+    LOG_INFO("OTA", "Update %s verified and committed", s.version);
+    sendOTAStatus(stm32, s.sequence, OTA_STATUS_SUCCESS, &s, "Update successful");
+
+    s.phase = OTAPhase::RESTART;
+    s.restartAt = millis() + OTA_RESTART_DELAY_MS;
 }
 
 const char* OTAHandler::getCurrentVersion() {
     return FIRMWARE_VERSION;  // From shared/device_config.h
 }
 
-bool OTAHandler::verifyUpdate() {
-    // TODO: Implement checksum verification
+bool OTAHandler::verifyUpdate(OTASession& s) {
+    s.hash.end();
+
+    if (memcmp(s.hash.hash(), s.sha256, sizeof(s.sha256)) != 0) {
+        LOG_ERROR("OTA", "SHA-256 mismatch");
+        return false;
+    }
+
+    // The signature over sha256 was checked with the manifest
     return true;
 }
 
-void OTAHandler::sendOTAStatus(
-    STM32Communicator& stm32,
-    uint8_t sequence,
-    OTAResult result
-) {
-    uart_packet_t response;
-    uart_init_packet(&response, RSP_OTA_STATUS, sequence);
+/**
+ * @brief Check the manifest signature, before anything is downloaded
+ *
+ * Signed message, one "\n"-terminated line per field: target, version,
+ * size (decimal), sha256 and delta.base (lowercase hex, empty line
+ * without a delta), see tools/sign_manifest.py. A signed image therefore
+ * cannot be offered under another version, target or base.
+ */
+bool OTAHandler::verifyManifest(OTASession& s, const char* target, const char* version,
+                                uint32_t size, const char* deltaBase) {
+    if (strlen(OTA_SIGNING_KEY_PEM) == 0) {
+#ifdef OTA_ALLOW_UNSIGNED
+        LOG_WARN("OTA", "OTA_ALLOW_UNSIGNED build, manifest not verified");
+        return true;
+#else
+        LOG_ERROR("OTA", "No signing key built in, refusing update");
+        return false;
+#endif
+    }
 
-    struct {
-        uint8_t status;
-        char message[64];
-    } payload;
+    if (s.signatureLength == 0) {
+        LOG_ERROR("OTA", "Manifest is not signed");
+        return false;
+    }
 
-    payload.status = (uint8_t)result;
+    char field[72];
+    BearSSL::HashSHA256 message;
+    message.begin();
+    addLine(message, target);
+    addLine(message, version);
+    snprintf(field, sizeof(field), "%u", (unsigned)size);
+    addLine(message, field);
+    for (size_t i = 0; i < sizeof(s.sha256); i++) {
+        snprintf(field + i * 2, 3, "%02x", s.sha256[i]);
+    }
+    addLine(message, field);
+    size_t length = 0;
+    for (; deltaBase[length] != '\0' && length < sizeof(field) - 1; length++) {
+        field[length] = (char)tolower((unsigned char)deltaBase[length]);
+    }
+    field[length] = '\0';
+    addLine(message, field);
+    message.end();
 
-    switch (result) {
-        case OTAResult::SUCCESS:
-            strcpy(payload.message, "Update successful");
-            break;
-        case OTAResult::FAILED_HTTP:
-            strcpy(payload.message, "HTTP fetch failed");
-            break;
-        case OTAResult::FAILED_NO_SPACE:
-            strcpy(payload.message, "Insufficient space");
-            break;
-        case OTAResult::FAILED_FLASH:
-            strcpy(payload.message, "Flash write failed");
-            break;
-        case OTAResult::FAILED_VERIFY:
-            strcpy(payload.message, "Verification failed");
-            break;
-        case OTAResult::FAILED_INVALID_URL:
-            strcpy(payload.message, "Invalid URL");
-            break;
+    BearSSL::PublicKey key(OTA_SIGNING_KEY_PEM);
+    BearSSL::SigningVerifier verifier(&key);
+    if (!verifier.verify(&message, s.signature, s.signatureLength)) {
+        LOG_ERROR("OTA", "Signature check failed");
+        return false;
+    }
+    return true;
+}
+
+void OTAHandler::fail(OTASession& s, STM32Communicator& stm32, OTAResult result, const char* message) {
+    s.client.stop();
+
+    // Update.end() on an unfinished image discards it; the running
+    // firmware stays the boot image
+    if (Update.isRunning()) {
+        Update.end();
+    }
+
+    // A partial STM32 image stays staged for the next request to resume
+    if (s.stm32Target && s.stage) {
+        s.stage.close();
     }
 
-    memcpy(response.payload, &payload, sizeof(payload));
-    response.length = sizeof(payload);
+    if (result != OTAResult::UP_TO_DATE) {
+        LOG_ERROR("OTA", "Update failed: %s", message);
+    }
+    sendOTAStatus(stm32, s.sequence, (uint8_t)result, &s, message);
 
-    stm32.sendPacket(response);
-    LOG_INFO("OTA", "Status sent: %s", payload.message);
+    sessionPool.destroy(session);
+    session = nullptr;
 }
 
+void OTAHandler::sendOTAStatus(
+    STM32Communicator& stm32,
+    uint8_t sequence,
+    uint8_t status,
+    const OTASession* s,
+    const char* message
+) {
+    ota_status_payload_t payload;
+    memset(&payload, 0, sizeof(payload));
+
+    payload.status = status;
+    if (s && s->phase != OTAPhase::MANIFEST) {
+        payload.bytes_done = s->written;
+        payload.bytes_total = s->total;
+        payload.percent = s->total ? (uint8_t)((uint64_t)s->written * 100 / s->total) : 0;
+    }
+    strncpy(payload.message, message, sizeof(payload.message) - 1);
+
+    stm32.sendResponse(RSP_OTA_STATUS, sequence, &payload, sizeof(payload));
+    LOG_INFO("OTA", "Status 0x%02X sent: %s (%u%%)", status, message, payload.percent);
+}
@@ -0,0 +1,70 @@
+/**
+ * @file power_policy.cpp
+ * @brief Traffic-aware WiFi modem sleep policy implementation
+ */
+
+#include "handlers/power_policy.h"
+
+PowerPolicy::PowerPolicy()
+    : mode(RadioPowerMode::ACTIVE),
+      modeSince(0),
+      idleMs(0),
+      activeMs(0),
+      wakeups(0) {
+}
+
+bool PowerPolicy::nearKeepAlive(const PowerInputs& inputs, uint32_t now) {
+    if (inputs.keepAliveBase == 0 || inputs.keepAliveMs == 0) return false;
+
+    // Without other traffic the client pings every keepalive period after
+    // the base; shift by the lead so each window starts at phase 0
+    uint32_t shifted = now - inputs.keepAliveBase + POWER_KEEPALIVE_LEAD_MS;
+    if (shifted < inputs.keepAliveMs) return false;
+
+    return shifted % inputs.keepAliveMs < POWER_KEEPALIVE_LEAD_MS + POWER_KEEPALIVE_HOLD_MS;
+}
+
+RadioPowerMode PowerPolicy::decide(const PowerInputs& inputs, uint32_t now) {
+    if (!inputs.enabled || !inputs.connected || !inputs.batching ||
+        inputs.sessionActive || inputs.busy) {
+        return RadioPowerMode::ACTIVE;
+    }
+
+    // STM32 traffic: a command or a session may be about to start
+    if (now - inputs.lastUartRx < POWER_UART_HOLD_MS) {
+        return RadioPowerMode::ACTIVE;
+    }
+
+    if (nearKeepAlive(inputs, now)) {
+        return RadioPowerMode::ACTIVE;
+    }
+    return RadioPowerMode::IDLE;
+}
+
+bool PowerPolicy::update(RadioPowerMode target, uint32_t now) {
+    if (target == mode) return false;
+
+    uint32_t stretch = now - modeSince;
+    if (mode == RadioPowerMode::IDLE) {
+        idleMs += stretch;
+        wakeups++;
+    } else {
+        activeMs += stretch;
+    }
+
+    mode = target;
+    modeSince = now;
+    return true;
+}
+
+uint32_t PowerPolicy::getTimeIn(RadioPowerMode which, uint32_t now) const {
+    uint32_t total = (which == RadioPowerMode::IDLE) ? idleMs : activeMs;
+    if (which == mode) {
+        total += now - modeSince;
+    }
+    return total;
+}
+
+const char* PowerPolicy::modeName(RadioPowerMode which) {
+    return which == RadioPowerMode::IDLE ? "idle" : "active";
+}
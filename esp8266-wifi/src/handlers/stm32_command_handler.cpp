@@ -6,121 +6,416 @@
 #include "handlers/stm32_command_handler.h"
 #include "handlers/config_update_handler.h"
 #include "handlers/ota_handler.h"
+#include "handlers/stm32_ota_sender.h"
 #include "handlers/ocpp_message_handler.h"
+#include "drivers/mqtt/mqtt_topic_builder.h"
 #include "utils/logger.h"
+#include "utils/json_writer.h"
 #include <ArduinoJson.h>
 #include <ESP8266WiFi.h>
+#include <stddef.h>
 
 void STM32CommandHandler::execute(
-    const uart_packet_t& packet,
+    const UartFrameView& frame,
     STM32Communicator& stm32,
     MQTTClient& mqtt,
     NTPTimeDriver& ntpTime,
-    UnifiedConfigManager& configManager
+    UnifiedConfigManager& configManager,
+    MeterBatcher& meterBatcher,
+    MeterDeadband& meterDeadband,
+    ConnectorStateTable& connectorStates,
+    AuthCache& authCache,
+    LiveTelemetry* live
 ) {
-    LOG_DEBUG("STM32Cmd", "RX: CMD=0x%02X, SEQ=%d", packet.cmd_type, packet.sequence);
+    LOG_DEBUG("STM32Cmd", "RX: CMD=0x%02X, SEQ=%d", frame.cmd_type, frame.sequence);
 
-    switch (packet.cmd_type) {
+    switch (frame.cmd_type) {
         case CMD_MQTT_PUBLISH:
-            handleMqttPublish(packet, stm32, mqtt);
+            if (!ackDuplicatePublish(frame, stm32, mqtt)) {
+                handleMqttPublish(frame, stm32, mqtt);
+            }
+            break;
+
+        case CMD_MQTT_PUBLISH_ID:
+            if (!ackDuplicatePublish(frame, stm32, mqtt)) {
+                handleMqttPublishId(frame, stm32, mqtt, configManager.get(), connectorStates, live);
+            }
             break;
 
         case CMD_GET_TIME:
-            handleGetTime(packet, stm32, ntpTime);
+            handleGetTime(frame, stm32, ntpTime);
             break;
 
         case CMD_WIFI_STATUS:
-            handleWiFiStatus(packet, stm32, mqtt);
+            handleWiFiStatus(frame, stm32, mqtt);
             break;
 
         case CMD_CONFIG_UPDATE:
-            handleConfigUpdate(packet, stm32, configManager);
+            handleConfigUpdate(frame, stm32, configManager);
             break;
 
         case CMD_OTA_REQUEST:
-            handleOTARequest(packet, stm32);
+            handleOTARequest(frame, stm32);
+            break;
+
+        case CMD_BULK_ACK:
+            STM32OTASender::handleAck(frame, stm32);
             break;
 
         case CMD_PUBLISH_METER_VALUES:
-            handlePublishMeterValues(packet, stm32, mqtt, configManager.get());
+            handlePublishMeterValues(frame, stm32, mqtt, configManager.get(), meterBatcher, meterDeadband, live);
+            break;
+
+        case CMD_CONNECTOR_STATUS:
+            handleConnectorStatus(frame, stm32, mqtt, ntpTime, configManager.get(), connectorStates, live);
+            break;
+
+        case CMD_AUTH_QUERY:
+            handleAuthQuery(frame, stm32, ntpTime, authCache);
+            break;
+
+        case CMD_AUTH_UPDATE:
+            handleAuthUpdate(frame, stm32, authCache);
             break;
 
         default:
-            LOG_WARN("STM32Cmd", "Unknown command: 0x%02X", packet.cmd_type);
-            stm32.sendAck(packet.sequence, STATUS_INVALID);
+            LOG_WARN("STM32Cmd", "Unknown command: 0x%02X", frame.cmd_type);
+            stm32.sendAck(frame.sequence, STATUS_INVALID);
             break;
     }
 }
 
+bool STM32CommandHandler::ackDuplicatePublish(
+    const UartFrameView& frame,
+    STM32Communicator& stm32,
+    MQTTClient& mqtt
+) {
+    // A resend of a publish still awaiting PUBACK: answer again, publish once
+    if (!mqtt.isDeliveryPending(frame.sequence)) {
+        return false;
+    }
+
+    LOG_DEBUG("STM32Cmd", "Publish seq=%u still awaiting PUBACK", frame.sequence);
+    stm32.sendAck(frame.sequence, STATUS_PENDING);
+    return true;
+}
+
+void STM32CommandHandler::ackPublishResult(
+    const UartFrameView& frame,
+    STM32Communicator& stm32,
+    MQTTError result,
+    const char* topic
+) {
+    if (result == MQTTError::DELIVERY_PENDING) {
+        // Stops the STM32 retry timer; the delivery callback sends the final status
+        LOG_DEBUG("STM32Cmd", "MQTT awaiting PUBACK: %s", topic);
+        stm32.sendAck(frame.sequence, STATUS_PENDING);
+    } else if (result == MQTTError::SUCCESS) {
+        LOG_DEBUG("STM32Cmd", "MQTT published: %s", topic);
+        stm32.sendAck(frame.sequence, STATUS_SUCCESS);
+    } else {
+        LOG_ERROR("STM32Cmd", "MQTT publish failed");
+        stm32.sendAck(frame.sequence, STATUS_ERROR);
+    }
+}
+
+bool STM32CommandHandler::isJsonPublish(const UartFrameView& frame) {
+    // Binary mqtt_publish_payload_t starts with the topic, JSON with '{'
+    // after optional whitespace (a topic never starts with either)
+    for (uint16_t i = 0; i < frame.length; i++) {
+        uint8_t c = frame.at(i);
+        if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+            return c == '{';
+        }
+    }
+    return true;    // Empty: let the JSON parser reject it
+}
+
 void STM32CommandHandler::handleMqttPublish(
-    const uart_packet_t& packet,
+    const UartFrameView& frame,
     STM32Communicator& stm32,
     MQTTClient& mqtt
 ) {
-    // Parse JSON payload from STM32
-    StaticJsonDocument<512> doc;
-    DeserializationError error = deserializeJson(doc, (char*)packet.payload, packet.length);
+    if (!isJsonPublish(frame)) {
+        handleMqttPublishBinary(frame, stm32, mqtt);
+        return;
+    }
+
+    // Parse JSON payload from STM32 in place (zero-copy)
+    frame.withLinearPayload([&](uint8_t* data, uint16_t length) {
+        StaticJsonDocument<512> doc;
+        DeserializationError error = deserializeJson(doc, (char*)data, length);
+
+        if (error) {
+            LOG_ERROR("STM32Cmd", "JSON parse error: %s", error.c_str());
+            stm32.sendAck(frame.sequence, STATUS_INVALID);
+            return;
+        }
+
+        // Extract topic and data
+        const char* topic = doc["topic"];
+        const char* payload = doc["data"];
+
+        if (!topic || !payload) {
+            LOG_ERROR("STM32Cmd", "Missing topic or data");
+            stm32.sendAck(frame.sequence, STATUS_INVALID);
+            return;
+        }
+
+        // Publish to MQTT
+        MQTTError result = mqtt.publish(topic, payload, 1, MQTTPriority::TELEMETRY, frame.sequence);
+        ackPublishResult(frame, stm32, result, topic);
+    });
+}
 
-    if (error) {
-        LOG_ERROR("STM32Cmd", "JSON parse error: %s", error.c_str());
-        stm32.sendAck(packet.sequence, STATUS_INVALID);
+void STM32CommandHandler::handleMqttPublishBinary(
+    const UartFrameView& frame,
+    STM32Communicator& stm32,
+    MQTTClient& mqtt
+) {
+    const uint16_t headerSize = offsetof(mqtt_publish_payload_t, data);
+
+    // Data bytes are forwarded straight from the frame, no parsing
+    frame.withLinearPayload([&](uint8_t* data, uint16_t length) {
+        const mqtt_publish_payload_t* msg = (const mqtt_publish_payload_t*)data;
+
+        if (length < headerSize ||
+            memchr(msg->topic, '\0', sizeof(msg->topic)) == nullptr ||
+            msg->data_length > length - headerSize) {
+            LOG_ERROR("STM32Cmd", "Invalid binary publish (len=%u)", length);
+            stm32.sendAck(frame.sequence, STATUS_INVALID);
+            return;
+        }
+
+        MQTTError result = mqtt.publish(msg->topic, (const uint8_t*)msg->data,
+                                        msg->data_length, msg->qos,
+                                        MQTTPriority::TELEMETRY, frame.sequence);
+        ackPublishResult(frame, stm32, result, msg->topic);
+    });
+}
+
+void STM32CommandHandler::handleMqttPublishId(
+    const UartFrameView& frame,
+    STM32Communicator& stm32,
+    MQTTClient& mqtt,
+    const DeviceConfig& config,
+    ConnectorStateTable& connectorStates,
+    LiveTelemetry* live
+) {
+    const uint16_t headerSize = offsetof(mqtt_publish_id_payload_t, data);
+
+    frame.withLinearPayload([&](uint8_t* data, uint16_t length) {
+        const mqtt_publish_id_payload_t* msg = (const mqtt_publish_id_payload_t*)data;
+
+        if (length < headerSize || msg->data_length > length - headerSize) {
+            LOG_ERROR("STM32Cmd", "Invalid topic-ID publish (len=%u)", length);
+            stm32.sendAck(frame.sequence, STATUS_INVALID);
+            return;
+        }
+
+        char topic[128];
+        if (!MQTTTopicBuilder::buildFromId(topic, sizeof(topic), config,
+                                           msg->topic_id, msg->connector_id)) {
+            LOG_ERROR("STM32Cmd", "Unknown topic ID: %u", msg->topic_id);
+            stm32.sendAck(frame.sequence, STATUS_INVALID);
+            return;
+        }
+
+        // JSON status notifications update the state cache and go to the web UI
+        // (binary ones stay MQTT-only and are never suppressed)
+        bool trackedStatus = false;
+        if (msg->topic_id == TOPIC_ID_STATUS && msg->data_length > 0 && msg->data[0] == '{') {
+            StaticJsonDocument<32> filter;
+            filter["status"] = true;
+            filter["errorCode"] = true;
+
+            StaticJsonDocument<64> doc;
+            DeserializationError error = deserializeJson(doc, (const char*)msg->data, msg->data_length,
+                                                         DeserializationOption::Filter(filter));
+
+            if (!error && doc["status"].is<int>()) {
+                trackedStatus = true;
+                if (!connectorStates.update(msg->connector_id,
+                                            (connector_status_t)doc["status"].as<int>(),
+                                            (error_code_t)(doc["errorCode"] | 0), millis())) {
+                    LOG_DEBUG("STM32Cmd", "Status unchanged (connector=%d)", msg->connector_id);
+                    stm32.sendAck(frame.sequence, STATUS_SUCCESS);
+                    return;
+                }
+            }
+
+            if (live) {
+                live->publish(LiveTopic::STATUS, msg->connector_id, msg->data, msg->data_length);
+            }
+        }
+
+        MQTTPriority priority = MQTTPriority::TELEMETRY;
+        if (msg->topic_id == TOPIC_ID_TRANSACTION_START || msg->topic_id == TOPIC_ID_TRANSACTION_STOP) {
+            priority = MQTTPriority::TRANSACTION;
+        } else if (msg->topic_id == TOPIC_ID_STATUS || msg->topic_id == TOPIC_ID_BOOT) {
+            priority = MQTTPriority::STATUS;
+        }
+
+        MQTTError result = mqtt.publish(topic, (const uint8_t*)msg->data,
+                                        msg->data_length, msg->qos, priority, frame.sequence);
+
+        if (trackedStatus && result != MQTTError::SUCCESS &&
+            result != MQTTError::DELIVERY_PENDING) {
+            connectorStates.markUnpublished(msg->connector_id);
+        }
+        ackPublishResult(frame, stm32, result, topic);
+    });
+}
+
+void STM32CommandHandler::handleConnectorStatus(
+    const UartFrameView& frame,
+    STM32Communicator& stm32,
+    MQTTClient& mqtt,
+    NTPTimeDriver& ntpTime,
+    const DeviceConfig& config,
+    ConnectorStateTable& connectorStates,
+    LiveTelemetry* live
+) {
+    const uint16_t headerSize = offsetof(connector_status_payload_t, info);
+
+    if (frame.length < headerSize) {
+        LOG_ERROR("STM32Cmd", "Invalid connector status (len=%u)", frame.length);
+        stm32.sendAck(frame.sequence, STATUS_INVALID);
         return;
     }
 
-    // Extract topic and data
-    const char* topic = doc["topic"];
-    const char* data = doc["data"];
+    connector_status_payload_t report;
+    frame.copyTo(&report, 0, headerSize);
 
-    if (!topic || !data) {
-        LOG_ERROR("STM32Cmd", "Missing topic or data");
-        stm32.sendAck(packet.sequence, STATUS_INVALID);
+    if (report.status > CONNECTOR_FAULTED || report.error_code > ERROR_WEAK_SIGNAL) {
+        LOG_ERROR("STM32Cmd", "Invalid connector status %u/%u", report.status, report.error_code);
+        stm32.sendAck(frame.sequence, STATUS_INVALID);
         return;
     }
 
-    // Publish to MQTT
-    MQTTError result = mqtt.publish(topic, data, 1);
+    connector_status_t status = (connector_status_t)report.status;
+    error_code_t errorCode = (error_code_t)report.error_code;
 
-    if (result == MQTTError::SUCCESS) {
-        LOG_DEBUG("STM32Cmd", "MQTT published: %s", topic);
-        stm32.sendAck(packet.sequence, STATUS_SUCCESS);
+    // Repeats are accepted but not published
+    if (!connectorStates.update(report.connector_id, status, errorCode, millis())) {
+        LOG_DEBUG("STM32Cmd", "Status unchanged (connector=%d)", report.connector_id);
+        stm32.sendAck(frame.sequence, STATUS_SUCCESS);
+        return;
+    }
+
+    status_notification_t notification;
+    memset(&notification, 0, sizeof(notification));
+    snprintf(notification.msg_id, sizeof(notification.msg_id), "%u", (unsigned)millis());
+    snprintf(notification.timestamp, sizeof(notification.timestamp), "%u", (unsigned)ntpTime.getUnixTime());
+    notification.connector_id = report.connector_id;
+    notification.status = status;
+    notification.error_code = errorCode;
+
+    uint16_t infoLength = frame.length - headerSize;
+    if (infoLength >= sizeof(notification.info)) {
+        infoLength = sizeof(notification.info) - 1;
+    }
+    frame.copyTo(notification.info, headerSize, infoLength);
+
+    if (live) {
+        char buffer[64];
+        JsonWriter w(buffer, sizeof(buffer));
+        w.beginObject();
+        w.field("status", (int32_t)status);
+        w.field("errorCode", (int32_t)errorCode);
+        w.endObject();
+
+        size_t length = w.length();
+        if (length > 0) {
+            live->publish(LiveTopic::STATUS, report.connector_id, buffer, length);
+        }
+    }
+
+    if (OCPPMessageHandler::publishStatusNotification(mqtt, config, notification)) {
+        stm32.sendAck(frame.sequence, STATUS_SUCCESS);
     } else {
-        LOG_ERROR("STM32Cmd", "MQTT publish failed");
-        stm32.sendAck(packet.sequence, STATUS_ERROR);
+        LOG_ERROR("STM32Cmd", "Failed to publish connector status");
+        connectorStates.markUnpublished(report.connector_id);
+        stm32.sendAck(frame.sequence, STATUS_ERROR);
+    }
+}
+
+void STM32CommandHandler::handleAuthQuery(
+    const UartFrameView& frame,
+    STM32Communicator& stm32,
+    NTPTimeDriver& ntpTime,
+    AuthCache& authCache
+) {
+    if (frame.length == 0) {
+        LOG_ERROR("STM32Cmd", "Empty auth query");
+        stm32.sendAck(frame.sequence, STATUS_INVALID);
+        return;
+    }
+
+    // Shorter payloads are tags under 20 chars without padding
+    auth_query_payload_t query;
+    memset(&query, 0, sizeof(query));
+    frame.copyTo(&query, 0, sizeof(query));
+
+    uint32_t unixTime = ntpTime.isSynced() ? ntpTime.getUnixTime() : 0;
+    AuthResult result = authCache.lookup(query.id_tag, sizeof(query.id_tag), unixTime);
+
+    auth_result_payload_t response;
+    response.status = (uint8_t)result.status;
+    response.source = result.source;
+    response.expiry = result.expiry;
+
+    stm32.sendResponse(RSP_AUTH_RESULT, frame.sequence, &response, sizeof(response));
+    LOG_DEBUG("STM32Cmd", "Auth query: status=%u, source=%u", response.status, response.source);
+}
+
+void STM32CommandHandler::handleAuthUpdate(
+    const UartFrameView& frame,
+    STM32Communicator& stm32,
+    AuthCache& authCache
+) {
+    if (frame.length < sizeof(auth_update_payload_t)) {
+        LOG_ERROR("STM32Cmd", "Invalid auth update (len=%u)", frame.length);
+        stm32.sendAck(frame.sequence, STATUS_INVALID);
+        return;
+    }
+
+    auth_update_payload_t update;
+    frame.copyTo(&update, 0, sizeof(update));
+
+    if (update.status > AUTH_CONCURRENT_TX) {
+        stm32.sendAck(frame.sequence, STATUS_INVALID);
+        return;
     }
+
+    bool stored = authCache.remember(update.id_tag, sizeof(update.id_tag),
+                                     (id_tag_status_t)update.status, update.expiry, millis());
+    stm32.sendAck(frame.sequence, stored ? STATUS_SUCCESS : STATUS_ERROR);
 }
 
 void STM32CommandHandler::handleGetTime(
-    const uart_packet_t& packet,
+    const UartFrameView& frame,
     STM32Communicator& stm32,
     NTPTimeDriver& ntpTime
 ) {
-    // Create time response packet
-    uart_packet_t response;
-    uart_init_packet(&response, RSP_TIME_DATA, packet.sequence);
-
-    // Build time payload with NTP time
+    // Build time payload from the local clock (no network round trip)
+    uint64_t unixUs = ntpTime.getUnixTimeUs();
     time_data_payload_t timeData;
-    timeData.unix_timestamp = ntpTime.getUnixTime();
+    timeData.unix_timestamp = (uint32_t)(unixUs / 1000000ULL);
+    timeData.microseconds = (uint32_t)(unixUs % 1000000ULL);
     timeData.timezone_offset = ntpTime.getTimezoneOffset();
     timeData.ntp_synced = ntpTime.isSynced() ? 1 : 0;
 
-    memcpy(response.payload, &timeData, sizeof(timeData));
-    response.length = sizeof(timeData);
-
     // Send response
-    stm32.sendPacket(response);
+    stm32.sendResponse(RSP_TIME_DATA, frame.sequence, &timeData, sizeof(timeData));
     LOG_DEBUG("STM32Cmd", "Time sent: %u (synced: %d)", timeData.unix_timestamp, timeData.ntp_synced);
 }
 
 void STM32CommandHandler::handleWiFiStatus(
-    const uart_packet_t& packet,
+    const UartFrameView& frame,
     STM32Communicator& stm32,
     MQTTClient& mqtt
 ) {
-    // Create WiFi status response
-    uart_packet_t response;
-    uart_init_packet(&response, RSP_WIFI_STATUS, packet.sequence);
-
     // Use proper payload structure
     wifi_status_payload_t wifiData;
     wifiData.wifi_connected = (WiFi.status() == WL_CONNECTED) ? 1 : 0;
@@ -138,20 +433,17 @@ void STM32CommandHandler::handleWiFiStatus(
         memset(wifiData.ip_address, 0, 4);
     }
 
-    memcpy(response.payload, &wifiData, sizeof(wifiData));
-    response.length = sizeof(wifiData);
-
     // Send response
-    stm32.sendPacket(response);
+    stm32.sendResponse(RSP_WIFI_STATUS, frame.sequence, &wifiData, sizeof(wifiData));
     LOG_DEBUG("STM32Cmd", "WiFi status: connected=%d, RSSI=%d", wifiData.wifi_connected, wifiData.rssi);
 }
 
 void STM32CommandHandler::handleConfigUpdate(
-    const uart_packet_t& packet,
+    const UartFrameView& frame,
     STM32Communicator& stm32,
     UnifiedConfigManager& configManager
 ) {
-    bool success = ConfigUpdateHandler::handleFromSTM32(packet, stm32, configManager);
+    bool success = ConfigUpdateHandler::handleFromSTM32(frame, stm32, configManager);
 
     if (success) {
         LOG_INFO("STM32Cmd", "Config updated successfully");
@@ -161,27 +453,30 @@ void STM32CommandHandler::handleConfigUpdate(
 }
 
 void STM32CommandHandler::handleOTARequest(
-    const uart_packet_t& packet,
+    const UartFrameView& frame,
     STM32Communicator& stm32
 ) {
-    OTAHandler::handleFromSTM32(packet, stm32);
+    OTAHandler::handleFromSTM32(frame, stm32);
 }
 
 void STM32CommandHandler::handlePublishMeterValues(
-    const uart_packet_t& packet,
+    const UartFrameView& frame,
     STM32Communicator& stm32,
     MQTTClient& mqtt,
-    const DeviceConfig& config
+    const DeviceConfig& config,
+    MeterBatcher& meterBatcher,
+    MeterDeadband& meterDeadband,
+    LiveTelemetry* live
 ) {
     // Parse meter values from packet
-    if (packet.length < sizeof(meter_values_t)) {
+    if (frame.length < sizeof(meter_values_t)) {
         LOG_ERROR("STM32Cmd", "Invalid meter values packet size");
-        stm32.sendAck(packet.sequence, STATUS_INVALID);
+        stm32.sendAck(frame.sequence, STATUS_INVALID);
         return;
     }
 
     meter_values_t meterData;
-    memcpy(&meterData, packet.payload, sizeof(meter_values_t));
+    frame.copyTo(&meterData, 0, sizeof(meter_values_t));
 
     LOG_DEBUG("STM32Cmd", "Meter values: E=%u Wh, V=%u V, I=%u A, P=%u W",
              meterData.sample.energy_wh,
@@ -189,13 +484,60 @@ void STM32CommandHandler::handlePublishMeterValues(
              meterData.sample.current_a,
              meterData.sample.power_w);
 
+    // Web UI shows every sample, the deadband only saves backhaul
+    if (live) {
+        publishLiveMeter(*live, meterData);
+    }
+
+    // Deadband: unchanged samples are accepted but not published
+    if (config.meter.deadbandEnabled &&
+        !meterDeadband.shouldReport(meterData, config, millis())) {
+        LOG_DEBUG("STM32Cmd", "Meter sample suppressed (connector=%d)", meterData.connector_id);
+        stm32.sendAck(frame.sequence, STATUS_SUCCESS);
+        return;
+    }
+
+    // Batching: accept into the pending batch, published from DeviceManager::run()
+    if (config.meter.batchEnabled) {
+        uint32_t now = millis();
+        if (!meterBatcher.add(meterData, now)) {
+            meterBatcher.flush(mqtt, config);
+            meterBatcher.add(meterData, now);
+        }
+        stm32.sendAck(frame.sequence, STATUS_SUCCESS);
+        return;
+    }
+
     // Publish to MQTT via OCPPMessageHandler
     bool success = OCPPMessageHandler::publishMeterValues(mqtt, config, meterData);
 
     if (success) {
-        stm32.sendAck(packet.sequence, STATUS_SUCCESS);
+        stm32.sendAck(frame.sequence, STATUS_SUCCESS);
     } else {
         LOG_ERROR("STM32Cmd", "Failed to publish meter values");
-        stm32.sendAck(packet.sequence, STATUS_ERROR);
+        meterDeadband.invalidate(meterData.connector_id);
+        stm32.sendAck(frame.sequence, STATUS_ERROR);
+    }
+}
+
+void STM32CommandHandler::publishLiveMeter(LiveTelemetry& live, const meter_values_t& meter) {
+    // Sample only: msgId/timestamp are for the backend and would not fit a slot
+    char buffer[192];
+    JsonWriter w(buffer, sizeof(buffer));
+
+    w.beginObject();
+    w.field("transactionId", meter.transaction_id);
+    w.field("energy_wh", meter.sample.energy_wh);
+    w.field("power_w", meter.sample.power_w);
+    w.field("voltage_v", meter.sample.voltage_v);
+    w.field("current_a", meter.sample.current_a);
+    w.field("frequency_hz", meter.sample.frequency_hz);
+    w.field("temperature_c", meter.sample.temperature_c);
+    w.field("power_factor_pct", meter.sample.power_factor_pct);
+    w.endObject();
+
+    size_t length = w.length();
+    if (length > 0) {
+        live.publish(LiveTopic::METER, meter.connector_id, buffer, length);
     }
 }
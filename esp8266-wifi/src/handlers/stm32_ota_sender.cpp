@@ -0,0 +1,265 @@
+/**
+ * @file stm32_ota_sender.cpp
+ * @brief STM32 firmware pass-through (UART bulk transfer)
+ */
+
+#include "handlers/stm32_ota_sender.h"
+#include "utils/logger.h"
+#include "utils/memory_pool.h"
+#include <LittleFS.h>
+
+enum class BulkPhase : uint8_t {
+    BEGIN,                      // RSP_BULK_BEGIN sent, waiting for the resume offset
+    SENDING,
+    ENDING                      // RSP_BULK_END sent, STM32 verifying
+};
+
+struct STM32OTASession {
+    BulkPhase phase;
+    File file;
+    uint32_t size;
+    uint8_t sha256[32];
+    char version[16];
+    uint8_t sequence;           // Own counter, bulk frames are untracked
+
+    uint32_t sendOffset;        // Next byte to queue
+    uint32_t ackedOffset;       // STM32's next_offset
+    uint32_t blockCrc;          // Running CRC-32 of the block being sent
+    bool blockEndPending;       // Block data queued, RSP_BULK_BLOCK not yet
+    uint32_t lastProgress;      // Last ACK that moved ackedOffset (or last send)
+    uint8_t retries;
+    uint8_t reportedPercent;
+};
+
+static BlockPool<sizeof(STM32OTASession), 1> sessionPool("stm32ota");
+static STM32OTASession* session = nullptr;
+
+static uint32_t blockStart(uint32_t offset) {
+    return offset - offset % UART_BULK_BLOCK_SIZE;
+}
+
+bool STM32OTASender::begin(uint32_t size, const uint8_t sha256[32], const char* version,
+                           STM32Communicator& stm32) {
+    if (session) {
+        LOG_WARN("STM32OTA", "Transfer already running");
+        return false;
+    }
+    if (stm32.getProtocolVersion() < UART_PROTOCOL_V2) {
+        LOG_ERROR("STM32OTA", "Bulk transfer needs protocol v2");
+        return false;
+    }
+
+    File file = LittleFS.open(STM32_OTA_STAGE_PATH, "r");
+    if (!file || file.size() != size) {
+        LOG_ERROR("STM32OTA", "Staged image missing or wrong size");
+        return false;
+    }
+
+    session = sessionPool.create<STM32OTASession>();
+    if (!session) {
+        LOG_ERROR("STM32OTA", "No session memory");
+        return false;
+    }
+    STM32OTASession& s = *session;
+    s.file = file;
+    s.size = size;
+    memcpy(s.sha256, sha256, sizeof(s.sha256));
+    strncpy(s.version, version, sizeof(s.version) - 1);
+    s.version[sizeof(s.version) - 1] = '\0';
+    s.sequence = 0;
+    s.retries = 0;
+    s.reportedPercent = 0;
+
+    LOG_INFO("STM32OTA", "Sending %s to STM32, %u bytes", s.version, size);
+    sendBegin(s, stm32);
+    return true;
+}
+
+bool STM32OTASender::isActive() {
+    return session != nullptr;
+}
+
+void STM32OTASender::handle(STM32Communicator& stm32) {
+    if (!session) return;
+    STM32OTASession& s = *session;
+
+    if (millis() - s.lastProgress > UART_BULK_ACK_TIMEOUT_MS) {
+        if (++s.retries > UART_BULK_MAX_RETRIES) {
+            finish(false, "STM32 not responding");
+            return;
+        }
+        LOG_WARN("STM32OTA", "No ACK, retry %u from %u", s.retries, s.ackedOffset);
+
+        if (s.phase == BulkPhase::SENDING) {
+            rewind(s, s.ackedOffset);
+        } else {
+            // BEGIN / END carry no data: just send them again
+            s.lastProgress = millis();
+            if (s.phase == BulkPhase::BEGIN) {
+                sendBegin(s, stm32);
+            } else {
+                stm32.sendResponse(RSP_BULK_END, s.sequence++, nullptr, 0);
+            }
+        }
+    }
+
+    if (s.phase != BulkPhase::SENDING) return;
+
+    for (uint8_t i = 0; i < STM32_OTA_FRAMES_PER_PASS; i++) {
+        if (s.blockEndPending) {
+            if (!queueBlockEnd(s, stm32)) break;
+            continue;
+        }
+
+        // Window full or everything queued: wait for ACKs
+        if (s.sendOffset >= s.size ||
+            s.sendOffset - s.ackedOffset >= (uint32_t)UART_BULK_WINDOW * UART_BULK_BLOCK_SIZE) {
+            break;
+        }
+        if (!queueData(s, stm32)) break;
+    }
+}
+
+void STM32OTASender::sendBegin(STM32OTASession& s, STM32Communicator& stm32) {
+    bulk_begin_payload_t begin;
+    memset(&begin, 0, sizeof(begin));
+    begin.image_size = s.size;
+    memcpy(begin.sha256, s.sha256, sizeof(begin.sha256));
+    strncpy(begin.version, s.version, sizeof(begin.version) - 1);
+    begin.block_size = UART_BULK_BLOCK_SIZE;
+
+    s.phase = BulkPhase::BEGIN;
+    s.lastProgress = millis();
+    stm32.sendResponse(RSP_BULK_BEGIN, s.sequence++, &begin, sizeof(begin));
+}
+
+bool STM32OTASender::queueData(STM32OTASession& s, STM32Communicator& stm32) {
+    uint32_t blockEnd = blockStart(s.sendOffset) + UART_BULK_BLOCK_SIZE;
+    if (blockEnd > s.size) blockEnd = s.size;
+
+    uint16_t length = blockEnd - s.sendOffset < UART_BULK_CHUNK ? blockEnd - s.sendOffset : UART_BULK_CHUNK;
+    if (stm32.getTxFree() < uart_frame_size(UART_PROTOCOL_V2, UART_BULK_DATA_HEADER_SIZE + length)) {
+        return false;   // TX ring still draining the previous frame
+    }
+
+    uint8_t frame[UART_MAX_PAYLOAD];
+    bulk_data_header_t header = { s.sendOffset };
+    memcpy(frame, &header, sizeof(header));
+
+    if (!s.file.seek(s.sendOffset) ||
+        s.file.read(frame + sizeof(header), length) != length) {
+        finish(false, "Staged image read failed");
+        return false;
+    }
+
+    if (stm32.sendResponse(RSP_BULK_DATA, s.sequence++, frame, sizeof(header) + length) != UARTError::SUCCESS) {
+        return false;
+    }
+
+    if (s.sendOffset == blockStart(s.sendOffset)) s.blockCrc = 0;
+    s.blockCrc = uart_crc32_update(s.blockCrc, frame + sizeof(header), length);
+    s.sendOffset += length;
+    s.blockEndPending = s.sendOffset == blockEnd;
+    return true;
+}
+
+bool STM32OTASender::queueBlockEnd(STM32OTASession& s, STM32Communicator& stm32) {
+    bulk_block_payload_t block;
+    block.offset = blockStart(s.sendOffset - 1);
+    block.length = s.sendOffset - block.offset;
+    block.crc32 = s.blockCrc;
+
+    if (stm32.sendResponse(RSP_BULK_BLOCK, s.sequence++, &block, sizeof(block)) != UARTError::SUCCESS) {
+        return false;
+    }
+    s.blockEndPending = false;
+    return true;
+}
+
+void STM32OTASender::rewind(STM32OTASession& s, uint32_t offset) {
+    // Go-back-N to a block boundary the STM32 asked for
+    offset = blockStart(offset);
+    if (offset > s.size) offset = blockStart(s.size);
+
+    s.phase = BulkPhase::SENDING;
+    s.sendOffset = offset;
+    s.ackedOffset = offset;
+    s.blockEndPending = false;
+    s.lastProgress = millis();
+}
+
+void STM32OTASender::handleAck(const UartFrameView& frame, STM32Communicator& stm32) {
+    if (!session) return;
+    STM32OTASession& s = *session;
+
+    bulk_ack_payload_t ack;
+    if (frame.copyTo(&ack, 0, sizeof(ack)) != sizeof(ack)) return;
+
+    switch (ack.status) {
+        case BULK_STATUS_OK:
+            if (s.phase == BulkPhase::BEGIN) {
+                if (ack.next_offset > 0) {
+                    LOG_INFO("STM32OTA", "STM32 resumes at %u", ack.next_offset);
+                }
+                rewind(s, ack.next_offset);
+                s.retries = 0;
+            } else if (s.phase == BulkPhase::SENDING && ack.next_offset > s.ackedOffset &&
+                       ack.next_offset <= s.sendOffset) {
+                s.ackedOffset = ack.next_offset;
+                s.lastProgress = millis();
+                s.retries = 0;
+            }
+
+            if (s.phase == BulkPhase::SENDING && s.ackedOffset >= s.size) {
+                s.phase = BulkPhase::ENDING;
+                s.lastProgress = millis();
+                stm32.sendResponse(RSP_BULK_END, s.sequence++, nullptr, 0);
+            } else if (s.phase == BulkPhase::SENDING) {
+                uint8_t percent = (uint8_t)((uint64_t)s.ackedOffset * 100 / s.size);
+                if (percent >= s.reportedPercent + 10) {
+                    s.reportedPercent = percent - percent % 10;
+                    LOG_INFO("STM32OTA", "%u%% (%u/%u)", percent, s.ackedOffset, s.size);
+                }
+            }
+            break;
+
+        case BULK_STATUS_RESEND:
+            if (++s.retries > UART_BULK_MAX_RETRIES) {
+                finish(false, "Too many resends");
+                return;
+            }
+            LOG_WARN("STM32OTA", "Resend from %u", ack.next_offset);
+            rewind(s, ack.next_offset);
+            break;
+
+        case BULK_STATUS_COMPLETE:
+            if (s.phase == BulkPhase::ENDING) {
+                finish(true, "STM32 verified the image");
+            }
+            break;
+
+        default:
+            finish(false, ack.status == BULK_STATUS_BUSY ? "STM32 busy" : "STM32 rejected the image");
+            break;
+    }
+}
+
+void STM32OTASender::finish(bool success, const char* message) {
+    if (!session) return;
+
+    if (success) {
+        LOG_INFO("STM32OTA", "Transfer complete: %s", message);
+    } else {
+        LOG_ERROR("STM32OTA", "Transfer failed: %s", message);
+    }
+
+    // A delivered image is not needed again; a failed one stays staged so
+    // the next request resumes without downloading it again
+    session->file.close();
+    if (success) {
+        LittleFS.remove(STM32_OTA_STAGE_PATH);
+    }
+
+    sessionPool.destroy(session);
+    session = nullptr;
+}
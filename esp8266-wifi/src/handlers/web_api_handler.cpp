@@ -5,9 +5,12 @@
  */
 
 #include "handlers/web_api_handler.h"
+#include "utils/json_writer.h"
+#include "utils/memory_pool.h"
 
 WebAPIHandler::WebAPIHandler(CustomWiFiManager* wifi, MQTTClient* mqtt, UnifiedConfigManager* config, const char* devId)
-    : wifiManager(wifi), mqttClient(mqtt), configManager(config) {
+    : wifiManager(wifi), mqttClient(mqtt), configManager(config), profiler(nullptr),
+      connectorStates(nullptr), powerPolicy(nullptr) {
     provisionState.subscribed = false;
     provisionState.provisioned = false;
     provisionState.mqttUsername[0] = '\0';
@@ -15,14 +18,33 @@ WebAPIHandler::WebAPIHandler(CustomWiFiManager* wifi, MQTTClient* mqtt, UnifiedC
     provisionState.mqttBroker[0] = '\0';
     provisionState.subscribeTime = 0;
 
+    memset(&scanCache, 0, sizeof(scanCache));
+    memset(&connectJob, 0, sizeof(connectJob));
+
     strncpy(deviceId, devId, sizeof(deviceId) - 1);
     deviceId[sizeof(deviceId) - 1] = '\0';
 }
 
 void WebAPIHandler::sendJsonResponse(AsyncWebServerRequest* request, int code, JsonDocument& doc) {
-    String response;
-    serializeJson(doc, response);
-    request->send(code, "application/json", response);
+    // Serialized straight into one exact-size body buffer (a String grows
+    // by repeated realloc and leaves holes behind)
+    AsyncResponseStream* response = request->beginResponseStream("application/json", measureJson(doc) + 1);
+    response->setCode(code);
+    serializeJson(doc, *response);
+    request->send(response);
+}
+
+void WebAPIHandler::sendJsonBuffer(AsyncWebServerRequest* request, int code, const char* json, size_t len) {
+    // The body outlives this call, so the (shared, static) source buffer
+    // is copied once; request->send(code, type, char*) would go via String
+    AsyncResponseStream* response = request->beginResponseStream("application/json", len + 1);
+    response->setCode(code);
+    response->write((const uint8_t*)json, len);
+    request->send(response);
+}
+
+void WebAPIHandler::formatIP(const IPAddress& ip, char* out, size_t size) {
+    snprintf(out, size, "%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
 }
 
 void WebAPIHandler::sendErrorResponse(AsyncWebServerRequest* request, int code, const char* message) {
@@ -64,29 +86,139 @@ void WebAPIHandler::registerRoutes(AsyncWebServer& server) {
         handleProvisionStatus(request);
     });
 
+    // Diagnostics routes
+    server.on("/api/diag/mem", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        handleDiagMem(request);
+    });
+
+    if (profiler) {
+        server.on("/api/diag/perf", HTTP_GET, [this](AsyncWebServerRequest* request) {
+            handleDiagPerf(request);
+        });
+    }
+
+    if (connectorStates) {
+        server.on("/api/connectors", HTTP_GET, [this](AsyncWebServerRequest* request) {
+            handleConnectors(request);
+        });
+    }
+
     LOG_INFO("WebAPI", "API routes registered");
 }
 
-void WebAPIHandler::handleWiFiScan(AsyncWebServerRequest* request) {
-    LOG_INFO("WebAPI", "Scanning WiFi networks...");
+void WebAPIHandler::handle() {
+    handleScan();
+    handleConnectJob();
+}
+
+void WebAPIHandler::handleScan() {
+    if (scanCache.requested && WiFi.scanComplete() != WIFI_SCAN_RUNNING) {
+        scanCache.requested = false;
+        scanCache.running = true;
+        WiFi.scanNetworks(true);    // Async: poll scanComplete()
+        LOG_INFO("WebAPI", "WiFi scan started");
+        return;
+    }
 
-    int n = WiFi.scanNetworks();
+    if (!scanCache.running) return;
 
-    DynamicJsonDocument doc(2048);
-    JsonArray networks = doc.to<JsonArray>();
+    int n = WiFi.scanComplete();
+    if (n == WIFI_SCAN_RUNNING) return;
 
-    for (int i = 0; i < n && i < 20; i++) {  // Limit to 20 networks
-        JsonObject network = networks.createNestedObject();
-        network["ssid"] = WiFi.SSID(i);
-        network["rssi"] = WiFi.RSSI(i);
-        network["encryption"] = WiFi.encryptionType(i);
-        network["bssid"] = WiFi.BSSIDstr(i);
+    scanCache.running = false;
+    if (n < 0) {
+        // Keep the previous list, the next request retries
+        LOG_WARN("WebAPI", "WiFi scan failed");
+        return;
     }
 
+    storeScanResults(n);
+    WiFi.scanDelete();
     LOG_INFO("WebAPI", "Found %d networks", n);
-    sendJsonResponse(request, 200, doc);
+}
 
-    WiFi.scanDelete();
+void WebAPIHandler::storeScanResults(int count) {
+    scanCache.count = 0;
+
+    for (int i = 0; i < count; i++) {
+        int8_t rssi = (int8_t)WiFi.RSSI(i);
+
+        // Insert sorted by RSSI; once full, weaker networks are dropped
+        uint8_t pos = scanCache.count;
+        while (pos > 0 && scanCache.entries[pos - 1].rssi < rssi) {
+            pos--;
+        }
+        if (pos >= WIFI_SCAN_MAX_RESULTS) continue;
+
+        uint8_t last = scanCache.count < WIFI_SCAN_MAX_RESULTS ? scanCache.count : WIFI_SCAN_MAX_RESULTS - 1;
+        memmove(&scanCache.entries[pos + 1], &scanCache.entries[pos], (last - pos) * sizeof(WiFiScanEntry));
+
+        WiFiScanEntry& entry = scanCache.entries[pos];
+        strncpy(entry.ssid, WiFi.SSID(i).c_str(), sizeof(entry.ssid) - 1);
+        entry.ssid[sizeof(entry.ssid) - 1] = '\0';
+        uint8_t* bssid = WiFi.BSSID(i);
+        if (bssid) {
+            memcpy(entry.bssid, bssid, sizeof(entry.bssid));
+        } else {
+            memset(entry.bssid, 0, sizeof(entry.bssid));
+        }
+        entry.rssi = rssi;
+        entry.encryption = WiFi.encryptionType(i);
+        entry.channel = (uint8_t)WiFi.channel(i);
+
+        if (scanCache.count < WIFI_SCAN_MAX_RESULTS) {
+            scanCache.count++;
+        }
+    }
+
+    scanCache.valid = true;
+    scanCache.completedAt = millis();
+}
+
+void WebAPIHandler::handleWiFiScan(AsyncWebServerRequest* request) {
+    bool busy = scanCache.requested || scanCache.running;
+    bool stale = !scanCache.valid || millis() - scanCache.completedAt >= WIFI_SCAN_CACHE_MS;
+
+    if (!busy && (stale || request->hasParam("refresh"))) {
+        scanCache.requested = true;
+        busy = true;
+    }
+
+    // 20 networks ~1.8 KB: too big for the stack, requests are serialized
+    static char buffer[2048];
+    JsonWriter w(buffer, sizeof(buffer));
+
+    w.beginObject();
+    w.field("status", busy ? "scanning" : "done");
+    if (scanCache.valid) {
+        w.field("ageMs", (uint32_t)(millis() - scanCache.completedAt));
+    }
+    w.beginArray("networks");
+    for (uint8_t i = 0; i < scanCache.count; i++) {
+        const WiFiScanEntry& entry = scanCache.entries[i];
+        char bssid[18];
+        snprintf(bssid, sizeof(bssid), "%02X:%02X:%02X:%02X:%02X:%02X",
+                 entry.bssid[0], entry.bssid[1], entry.bssid[2],
+                 entry.bssid[3], entry.bssid[4], entry.bssid[5]);
+
+        w.beginObject();
+        w.field("ssid", entry.ssid);
+        w.field("rssi", (int32_t)entry.rssi);
+        w.field("encryption", entry.encryption);
+        w.field("channel", entry.channel);
+        w.field("bssid", bssid);
+        w.endObject();
+    }
+    w.endArray();
+    w.endObject();
+
+    size_t length = w.length();
+    if (length == 0) {
+        sendErrorResponse(request, 500, "Response too large");
+        return;
+    }
+
+    sendJsonBuffer(request, busy ? 202 : 200, buffer, length);
 }
 
 void WebAPIHandler::handleWiFiConnect(AsyncWebServerRequest* request, uint8_t* data, size_t len) {
@@ -102,52 +234,177 @@ void WebAPIHandler::handleWiFiConnect(AsyncWebServerRequest* request, uint8_t* d
     const char* ssid = doc["ssid"];
     const char* password = doc["password"];
 
-    if (!ssid) {
-        sendErrorResponse(request, 400, "Missing ssid");
+    if (!ssid || ssid[0] == '\0' || strlen(ssid) >= sizeof(connectJob.ssid)) {
+        sendErrorResponse(request, 400, "Missing or invalid ssid");
         return;
     }
 
-    LOG_INFO("WebAPI", "Connecting to WiFi: %s", ssid);
-
-    // Attempt connection
-    WiFi.begin(ssid, password ? password : "");
+    if (password && strlen(password) >= sizeof(connectJob.password)) {
+        sendErrorResponse(request, 400, "Password too long");
+        return;
+    }
 
-    // Wait for connection (max 10 seconds)
-    int attempts = 0;
-    while (WiFi.status() != WL_CONNECTED && attempts < 20) {
-        delay(500);
-        attempts++;
-        ESP.wdtFeed();
+    if (connectJob.state == WiFiJobState::PENDING || connectJob.state == WiFiJobState::CONNECTING) {
+        sendErrorResponse(request, 409, "Connect in progress");
+        return;
     }
 
+    // WiFi.begin() runs from handle(); the UI polls /api/wifi/status
+    strcpy(connectJob.ssid, ssid);
+    strcpy(connectJob.password, password ? password : "");
+    connectJob.state = WiFiJobState::PENDING;
+    connectJob.startTime = millis();
+
+    LOG_INFO("WebAPI", "Connect to %s queued", ssid);
+
     StaticJsonDocument<128> response;
-    if (WiFi.status() == WL_CONNECTED) {
-        response["success"] = true;
-        response["ip"] = WiFi.localIP().toString();
-        LOG_INFO("WebAPI", "Connected! IP: %s", WiFi.localIP().toString().c_str());
-        sendJsonResponse(request, 200, response);
-    } else {
-        response["success"] = false;
-        response["error"] = "Connection failed";
-        LOG_ERROR("WebAPI", "Connection failed");
-        sendJsonResponse(request, 500, response);
+    response["status"] = jobStateName(connectJob.state);
+    response["ssid"] = connectJob.ssid;
+    sendJsonResponse(request, 202, response);
+}
+
+void WebAPIHandler::handleConnectJob() {
+    switch (connectJob.state) {
+        case WiFiJobState::PENDING:
+            LOG_INFO("WebAPI", "Connecting to WiFi: %s", connectJob.ssid);
+            WiFi.begin(connectJob.ssid, connectJob.password);
+            memset(connectJob.password, 0, sizeof(connectJob.password));
+            connectJob.state = WiFiJobState::CONNECTING;
+            connectJob.startTime = millis();
+            break;
+
+        case WiFiJobState::CONNECTING: {
+            wl_status_t status = WiFi.status();
+            if (status == WL_CONNECTED) {
+                connectJob.state = WiFiJobState::CONNECTED;
+                LOG_INFO("WebAPI", "Connected! IP: %s", WiFi.localIP().toString().c_str());
+            } else if (status == WL_CONNECT_FAILED || status == WL_WRONG_PASSWORD ||
+                       status == WL_NO_SSID_AVAIL ||
+                       millis() - connectJob.startTime > WIFI_CONNECT_TIMEOUT_MS) {
+                // Stop the station retrying so the provisioning AP stays usable
+                WiFi.disconnect();
+                connectJob.state = WiFiJobState::FAILED;
+                LOG_ERROR("WebAPI", "Connection to %s failed (status %d)", connectJob.ssid, (int)status);
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+const char* WebAPIHandler::jobStateName(WiFiJobState state) {
+    switch (state) {
+        case WiFiJobState::PENDING:     return "pending";
+        case WiFiJobState::CONNECTING:  return "connecting";
+        case WiFiJobState::CONNECTED:   return "connected";
+        case WiFiJobState::FAILED:      return "failed";
+        default:                        return "idle";
     }
 }
 
 void WebAPIHandler::handleWiFiStatus(AsyncWebServerRequest* request) {
-    StaticJsonDocument<256> doc;
+    StaticJsonDocument<384> doc;
 
     doc["connected"] = WiFi.status() == WL_CONNECTED;
 
+    char ip[16];
     if (WiFi.status() == WL_CONNECTED) {
-        doc["ssid"] = WiFi.SSID();
-        doc["ip"] = WiFi.localIP().toString();
+        // Network joined through the web UI, else the manager's copy
+        const char* ssid = connectJob.state == WiFiJobState::CONNECTED ? connectJob.ssid
+                         : wifiManager ? wifiManager->getStatus().ssid : "";
+        formatIP(WiFi.localIP(), ip, sizeof(ip));
+        doc["ssid"] = ssid;
+        doc["ip"] = (const char*)ip;
         doc["rssi"] = WiFi.RSSI();
     }
 
+    if (connectJob.state != WiFiJobState::IDLE) {
+        JsonObject job = doc.createNestedObject("connect");
+        job["state"] = jobStateName(connectJob.state);
+        job["ssid"] = (const char*)connectJob.ssid;
+    }
+
     sendJsonResponse(request, 200, doc);
 }
 
+void WebAPIHandler::handleDiagPerf(AsyncWebServerRequest* request) {
+    // ~1.5 KB for all stages: too big for the stack, requests are serialized
+    static char buffer[2048];
+    JsonWriter w(buffer, sizeof(buffer));
+
+    w.beginObject();
+    w.field("stallUs", (uint32_t)LOOP_STALL_US);
+    w.beginArray("bucketsUs");
+    for (uint8_t b = 0; b < LOOP_PROFILE_BUCKETS; b++) {
+        w.element(LoopProfiler::bucketFloor(b));
+    }
+    w.endArray();
+
+    w.beginObject("stages");
+    for (uint8_t i = 0; i < (uint8_t)ProfileStage::COUNT; i++) {
+        const StageStats& stats = profiler->get((ProfileStage)i);
+        w.beginObject(LoopProfiler::stageName((ProfileStage)i));
+        w.field("count", stats.count);
+        w.field("minUs", stats.count ? stats.minUs : 0u);
+        w.field("avgUs", stats.avgUs());
+        w.field("maxUs", stats.maxUs);
+        w.field("stalls", stats.stalls);
+        w.beginArray("hist");
+        for (uint8_t b = 0; b < LOOP_PROFILE_BUCKETS; b++) {
+            w.element(stats.histogram[b]);
+        }
+        w.endArray();
+        w.endObject();
+    }
+    w.endObject();
+
+    if (powerPolicy) {
+        // Modem sleep residency since boot (PowerPolicy)
+        uint32_t now = millis();
+        w.beginObject("power");
+        w.field("mode", PowerPolicy::modeName(powerPolicy->getMode()));
+        w.field("idleMs", powerPolicy->getTimeIn(RadioPowerMode::IDLE, now));
+        w.field("activeMs", powerPolicy->getTimeIn(RadioPowerMode::ACTIVE, now));
+        w.field("wakeups", powerPolicy->getWakeups());
+        w.field("listenInterval", (uint32_t)wifiManager->getStatus().listenInterval);
+        w.endObject();
+    }
+    w.endObject();
+
+    size_t length = w.length();
+    if (length == 0) {
+        sendErrorResponse(request, 500, "Response too large");
+        return;
+    }
+
+    if (request->hasParam("reset")) {
+        profiler->reset();
+    }
+
+    sendJsonBuffer(request, 200, buffer, length);
+}
+
+void WebAPIHandler::handleDiagMem(AsyncWebServerRequest* request) {
+    // Async callbacks run on the small system stack, requests are serialized
+    static char buffer[512];
+    JsonWriter w(buffer, sizeof(buffer));
+
+    MemoryStats::sample();
+    w.beginObject();
+    MemoryStats::writeJson(w);
+    w.endObject();
+
+    size_t length = w.length();
+    if (length == 0) {
+        sendErrorResponse(request, 500, "Response too large");
+        return;
+    }
+
+    sendJsonBuffer(request, 200, buffer, length);
+}
+
 void WebAPIHandler::handleProvisionSubscribe(AsyncWebServerRequest* request) {
     LOG_INFO("WebAPI", "Provisioning subscribe request");
 
@@ -251,3 +508,21 @@ void WebAPIHandler::saveProvisioningConfig() {
         LOG_ERROR("WebAPI", "Failed to save provisioning config");
     }
 }
+
+void WebAPIHandler::handleConnectors(AsyncWebServerRequest* request) {
+    static char buffer[512];
+    JsonWriter w(buffer, sizeof(buffer));
+
+    w.beginObject();
+    connectorStates->writeArray(w, "connectors");
+    w.field("suppressed", connectorStates->getSuppressedCount());
+    w.endObject();
+
+    size_t length = w.length();
+    if (length == 0) {
+        sendErrorResponse(request, 500, "Response too large");
+        return;
+    }
+
+    sendJsonBuffer(request, 200, buffer, length);
+}
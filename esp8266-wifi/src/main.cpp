@@ -36,48 +36,38 @@
 #include <Arduino.h>
 #include "core/device_manager.h"
 #include "utils/logger.h"
+#include "utils/memory_pool.h"
 
 // Single global instance (stack allocated)
 DeviceManager deviceManager;
 
-// System diagnostics
+// System diagnostics (heap watermarks: MemoryStats)
 struct SystemDiagnostics {
     uint32_t loopCount;
-    uint32_t minFreeHeap;
-    uint32_t maxHeapFrag;
     uint32_t lastWatchdog;
-} diagnostics = {0, 0xFFFFFFFF, 0, 0};
+} diagnostics = {0, 0};
 
 /**
  * @brief Print system diagnostics
  */
 void printDiagnostics() {
-    uint32_t freeHeap = ESP.getFreeHeap();
-    uint32_t heapFrag = ESP.getHeapFragmentation();
+    MemoryStats::sample();
+    const HeapStats& heap = MemoryStats::heap();
     uint32_t uptime = millis() / 1000;
 
-    // Track min/max
-    if (freeHeap < diagnostics.minFreeHeap) {
-        diagnostics.minFreeHeap = freeHeap;
-    }
-    if (heapFrag > diagnostics.maxHeapFrag) {
-        diagnostics.maxHeapFrag = heapFrag;
-    }
-
     LOG_INFO("Diagnostics", "===== System Status =====");
     LOG_INFO("Diagnostics", "Uptime: %u sec (%u days)", uptime, uptime / 86400);
     LOG_INFO("Diagnostics", "Loop count: %u", diagnostics.loopCount);
-    LOG_INFO("Diagnostics", "Free heap: %u bytes (min: %u)", freeHeap, diagnostics.minFreeHeap);
-    LOG_INFO("Diagnostics", "Heap frag: %u%% (max: %u%%)", heapFrag, diagnostics.maxHeapFrag);
+    MemoryStats::log();
     LOG_INFO("Diagnostics", "Firmware: %s", FIRMWARE_VERSION);
     LOG_INFO("Diagnostics", "=========================");
 
     // Memory warnings
-    if (freeHeap < 10000) {
-        LOG_WARN("Memory", "LOW MEMORY: %u bytes free!", freeHeap);
+    if (heap.freeNow < 10000) {
+        LOG_WARN("Memory", "LOW MEMORY: %u bytes free!", heap.freeNow);
     }
-    if (heapFrag > 50) {
-        LOG_WARN("Memory", "HIGH FRAGMENTATION: %u%%!", heapFrag);
+    if (heap.fragNow > 50) {
+        LOG_WARN("Memory", "HIGH FRAGMENTATION: %u%%!", heap.fragNow);
     }
 }
 
@@ -89,31 +79,40 @@ void feedWatchdog() {
     ESP.wdtFeed();
 }
 
+/**
+ * @brief Write out all pending log records (setup only, blocks)
+ */
+static void drainLog() {
+    while (Logger::getInstance().flush()) {
+        yield();
+    }
+}
+
 /**
  * @brief Setup function
  */
 void setup() {
-    Serial.begin(115200);
+    // Logs go to Serial1 (TX-only, GPIO2); Serial is the STM32 link
+    Serial1.begin(115200);
+    Logger::getInstance().setOutput(Serial1);
+    Logger::getInstance().setLevel(LogLevel::INFO);
     delay(100);
 
     // Print banner
-    Serial.println(F("\n\n"));
-    Serial.println(F("╔════════════════════════════════════════════════════╗"));
-    Serial.println(F("║  SolEVC Charging Point Controller v3.0           ║"));
-    Serial.println(F("║  WiFi Module - ESP8266                            ║"));
-    Serial.println(F("║  All Use Cases Implemented ✓                      ║"));
-    Serial.println(F("╚════════════════════════════════════════════════════╝"));
-    Serial.println();
+    Print& console = Logger::getInstance().getOutput();
+    console.println(F("\n\n"));
+    console.println(F("╔════════════════════════════════════════════════════╗"));
+    console.println(F("║  SolEVC Charging Point Controller v3.0           ║"));
+    console.println(F("║  WiFi Module - ESP8266                            ║"));
+    console.println(F("║  All Use Cases Implemented ✓                      ║"));
+    console.println(F("╚════════════════════════════════════════════════════╝"));
+    console.println();
 
     // Print chip info
     LOG_INFO("Main", "Chip ID: 0x%08X", ESP.getChipId());
     LOG_INFO("Main", "Flash size: %u bytes", ESP.getFlashChipSize());
     LOG_INFO("Main", "CPU freq: %u MHz", ESP.getCpuFreqMHz());
     LOG_INFO("Main", "SDK version: %s", ESP.getSdkVersion());
-    Serial.println();
-
-    // Initialize logger
-    Logger::getInstance().setLevel(LogLevel::INFO);
 
     // Initialize device manager (orchestrates all components)
     LOG_INFO("Main", "Initializing device manager...");
@@ -127,6 +126,7 @@ void setup() {
     LOG_INFO("Main", "  4. Connect to MQTT broker");
     LOG_INFO("Main", "  5. Synchronize time via NTP");
     LOG_INFO("Main", "");
+    drainLog();
 
     if (!deviceManager.init()) {
         LOG_ERROR("Main", "❌ Device initialization FAILED!");
@@ -136,6 +136,7 @@ void setup() {
         LOG_ERROR("Main", "  • MQTT broker unreachable");
         LOG_ERROR("Main", "System halted - check configuration");
         while (1) {
+            Logger::getInstance().flush();
             delay(1000);
             feedWatchdog();
         }
@@ -152,8 +153,14 @@ void setup() {
     LOG_INFO("Main", "  • Heartbeat");
     LOG_INFO("Main", "");
     LOG_INFO("Main", "=== Setup Complete ===");
+
+    // Everything long-lived exists now: free heap should stay flat from here
+    MemoryStats::markSteadyState();
+
+    // Print diagnostics every 60 seconds
+    deviceManager.addTask("diagnostics", printDiagnostics, 60000);
     printDiagnostics();
-    Serial.println();
+    drainLog();
 }
 
 /**
@@ -169,14 +176,14 @@ void loop() {
     // Increment loop counter
     diagnostics.loopCount++;
 
-    // Print diagnostics every 60 seconds
-    static uint32_t lastDiagnostics = 0;
-    if (millis() - lastDiagnostics > 60000) {
-        printDiagnostics();
-        lastDiagnostics = millis();
-    }
+    // Write out deferred log records (bounded per iteration)
+    bool logPending = Logger::getInstance().flush();
 
-    // Cooperative multitasking
-    yield();
-    delay(10);
+    // Sleep until the next task is due; delay() lets the WiFi modem sleep
+    uint32_t idle = logPending ? 0 : deviceManager.idleTime();
+    if (idle > 0) {
+        deviceManager.sleep(idle);
+    } else {
+        yield();
+    }
 }
@@ -0,0 +1,157 @@
+/**
+ * @file delta_patch.cpp
+ * @brief Streaming decoder for binary delta patches (OTA)
+ */
+
+#include "utils/delta_patch.h"
+
+static uint32_t readLE32(const uint8_t* data) {
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+           ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+DeltaPatch::DeltaPatch()
+    : readSource(nullptr), writeTarget(nullptr), context(nullptr),
+      state(State::HEADER), error(DeltaError::NONE), headerLength(0),
+      op(0), arg(0), argShift(0), sourceSize(0), targetSize(0),
+      position(0), produced(0), dataRemaining(0), copyRemaining(0) {}
+
+void DeltaPatch::begin(uint32_t source, ReadSource read, WriteTarget write, void* ctx) {
+    *this = DeltaPatch();
+    sourceSize = source;
+    readSource = read;
+    writeTarget = write;
+    context = ctx;
+}
+
+bool DeltaPatch::isComplete() const {
+    return state != State::HEADER && error == DeltaError::NONE &&
+           copyRemaining == 0 && produced == targetSize;
+}
+
+size_t DeltaPatch::feed(const uint8_t* data, size_t length) {
+    size_t used = 0;
+
+    while (used < length && !hasError() && !hasPendingCopy() && !isComplete()) {
+        switch (state) {
+            case State::HEADER:
+                header[headerLength++] = data[used++];
+                if (headerLength == DELTA_HEADER_SIZE) {
+                    if (memcmp(header, DELTA_MAGIC, 4) != 0 || readLE32(header + 4) != sourceSize) {
+                        fail(DeltaError::BAD_HEADER);
+                        break;
+                    }
+                    targetSize = readLE32(header + 8);
+                    state = State::OP;
+                }
+                break;
+
+            case State::OP:
+                op = data[used++];
+                if (op < DELTA_OP_COPY || op > DELTA_OP_SEEK) {
+                    fail(DeltaError::BAD_RECORD);
+                    break;
+                }
+                arg = 0;
+                argShift = 0;
+                state = State::ARG;
+                break;
+
+            case State::ARG: {
+                uint8_t byte = data[used++];
+                if (argShift > 28) {
+                    fail(DeltaError::BAD_RECORD);
+                    break;
+                }
+                arg |= (uint32_t)(byte & 0x7F) << argShift;
+                argShift += 7;
+                if (!(byte & 0x80)) {
+                    startRecord();
+                }
+                break;
+            }
+
+            case State::DATA: {
+                uint8_t work[DELTA_WORK_SIZE];
+                size_t n = length - used;
+                if (n > dataRemaining) n = dataRemaining;
+                if (n > sizeof(work)) n = sizeof(work);
+
+                if (op == DELTA_OP_ADD) {
+                    if (!readSource(position, work, n, context)) {
+                        fail(DeltaError::READ_FAILED);
+                        break;
+                    }
+                    for (size_t i = 0; i < n; i++) {
+                        work[i] += data[used + i];
+                    }
+                    position += n;
+                    if (!emit(work, n)) break;
+                } else if (!emit(data + used, n)) {
+                    break;
+                }
+
+                used += n;
+                dataRemaining -= n;
+                if (dataRemaining == 0) state = State::OP;
+                break;
+            }
+        }
+    }
+    return used;
+}
+
+size_t DeltaPatch::pump(size_t budget) {
+    size_t done = 0;
+    uint8_t work[DELTA_WORK_SIZE];
+
+    while (copyRemaining > 0 && done < budget && !hasError()) {
+        size_t n = copyRemaining < sizeof(work) ? copyRemaining : sizeof(work);
+        if (n > budget - done) n = budget - done;
+        if (!readSource(position, work, n, context)) {
+            fail(DeltaError::READ_FAILED);
+            break;
+        }
+        if (!emit(work, n)) break;
+
+        position += n;
+        copyRemaining -= n;
+        done += n;
+    }
+    return done;
+}
+
+bool DeltaPatch::startRecord() {
+    state = State::OP;
+
+    if (op == DELTA_OP_SEEK) {
+        // Zigzag: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+        int32_t offset = (int32_t)(arg >> 1) ^ -(int32_t)(arg & 1);
+        int64_t target = (int64_t)position + offset;
+        if (target < 0 || target > sourceSize) return fail(DeltaError::OUT_OF_RANGE);
+        position = (uint32_t)target;
+        return true;
+    }
+
+    if (arg > targetSize - produced) return fail(DeltaError::TOO_LONG);
+    if (op != DELTA_OP_INSERT && arg > sourceSize - position) return fail(DeltaError::OUT_OF_RANGE);
+
+    if (op == DELTA_OP_COPY) {
+        copyRemaining = arg;
+    } else if (arg > 0) {
+        dataRemaining = arg;
+        state = State::DATA;
+    }
+    return true;
+}
+
+bool DeltaPatch::emit(const uint8_t* data, size_t length) {
+    if (!writeTarget(data, length, context)) return fail(DeltaError::WRITE_FAILED);
+    produced += length;
+    return true;
+}
+
+bool DeltaPatch::fail(DeltaError reason) {
+    error = reason;
+    return false;
+}
@@ -4,99 +4,259 @@
  */
 
 #include "utils/logger.h"
-#include <stdarg.h>
 
 Logger Logger::instance;
 
-void Logger::printLevel(LogLevel level) {
-    switch (level) {
-        case LogLevel::ERROR: Serial.print(F("[ERROR] ")); break;
-        case LogLevel::WARN:  Serial.print(F("[WARN]  ")); break;
-        case LogLevel::INFO:  Serial.print(F("[INFO]  ")); break;
-        case LogLevel::DEBUG: Serial.print(F("[DEBUG] ")); break;
-    }
+// Record header: length, level, timestamp, tag pointer, format pointer
+static constexpr uint8_t RECORD_HEADER = 2 + sizeof(uint32_t) + 2 * sizeof(const char*);
+
+LogRecord::LogRecord(LogLevel level, const char* tag, const char* format) : length(2) {
+    data[1] = (uint8_t)level;
+    uint32_t timestamp = millis();
+    put(&timestamp, sizeof(timestamp));
+    put(&tag, sizeof(tag));
+    put(&format, sizeof(format));
 }
 
-void Logger::printTimestamp() {
-    Serial.printf("[%lu] ", millis() / 1000);
+void LogRecord::add(const char* value) {
+    if (!value) value = "(null)";
+    if (length + 2u > sizeof(data)) return;
+
+    size_t n = strnlen(value, LOG_STRING_MAX);
+    if (n > sizeof(data) - length - 2) n = sizeof(data) - length - 2;
+
+    data[length++] = 's';
+    data[length++] = (uint8_t)n;
+    put(value, (uint8_t)n);
 }
 
-void Logger::log(LogLevel level, const char* tag, const char* format, ...) {
-    if (!enabled || level > minLevel) return;
+Logger::Logger()
+    : minLevel(LogLevel::INFO),
+      enabled(true),
+      traceEnabled(false),
+      dropped(0),
+      droppedReported(0),
+      output(&Serial1),
+      paced(true),
+      lineLength(0),
+      linePos(0) {}
 
-    printTimestamp();
-    printLevel(level);
-    Serial.printf("[%s] ", tag);
+void Logger::setOutput(Print& out, bool pace) {
+    output = &out;
+    paced = pace;
+}
 
-    va_list args;
-    va_start(args, format);
-    char buffer[256];
-    vsnprintf(buffer, sizeof(buffer), format, args);
-    va_end(args);
+void Logger::push(const LogRecord& record) {
+    if (ring.free() < record.size()) {
+        dropped++;
+        return;
+    }
 
-    Serial.println(buffer);
+    // Length byte first, so flush() knows how much to take
+    ring.push(record.size());
+    ring.pushMultiple(record.bytes() + 1, record.size() - 1);
 }
 
-void Logger::error(const char* tag, const char* format, ...) {
-    if (!enabled || LogLevel::ERROR > minLevel) return;
+/**
+ * @brief Reads back the arguments of one record, in order
+ */
+class LogArgs {
+private:
+    const uint8_t* data;
+    uint8_t length;
+    uint8_t pos;
+
+public:
+    LogArgs(const uint8_t* record, uint8_t size) : data(record), length(size), pos(RECORD_HEADER) {}
 
-    printTimestamp();
-    printLevel(LogLevel::ERROR);
-    Serial.printf("[%s] ", tag);
+    bool next(char& type, uint32_t& word, const char*& str, uint8_t& strLength) {
+        if (pos >= length) return false;
 
-    va_list args;
-    va_start(args, format);
-    char buffer[256];
-    vsnprintf(buffer, sizeof(buffer), format, args);
-    va_end(args);
+        type = (char)data[pos++];
+        if (type == 's') {
+            if (pos >= length) return false;
+            strLength = data[pos++];
+            if (pos + strLength > length) strLength = length - pos;
+            str = (const char*)data + pos;
+            pos += strLength;
+        } else {
+            if (pos + sizeof(word) > length) return false;
+            memcpy(&word, data + pos, sizeof(word));
+            pos += sizeof(word);
+        }
+        return true;
+    }
+};
 
-    Serial.println(buffer);
+static const char* levelName(uint8_t level) {
+    switch ((LogLevel)level) {
+        case LogLevel::ERROR: return "[ERROR] ";
+        case LogLevel::WARN:  return "[WARN]  ";
+        case LogLevel::INFO:  return "[INFO]  ";
+        default:              return "[DEBUG] ";
+    }
 }
 
-void Logger::warn(const char* tag, const char* format, ...) {
-    if (!enabled || LogLevel::WARN > minLevel) return;
+/**
+ * @brief Format one argument with a single printf conversion
+ */
+static int formatArg(char* out, size_t size, const char* spec, char conversion,
+                     char type, uint32_t word, const char* str, uint8_t strLength) {
+    if (conversion == 's') {
+        if (type != 's') return snprintf(out, size, "?");
+        // Copied strings are not null-terminated; clamp via precision
+        char text[LOG_STRING_MAX + 1];
+        memcpy(text, str, strLength);
+        text[strLength] = '\0';
+        return snprintf(out, size, spec, text);
+    }
 
-    printTimestamp();
-    printLevel(LogLevel::WARN);
-    Serial.printf("[%s] ", tag);
+    if (type == 's') return snprintf(out, size, "?");
 
-    va_list args;
-    va_start(args, format);
-    char buffer[256];
-    vsnprintf(buffer, sizeof(buffer), format, args);
-    va_end(args);
+    if (conversion == 'f' || conversion == 'e' || conversion == 'g') {
+        double value;
+        if (type == 'f') {
+            float f;
+            memcpy(&f, &word, sizeof(f));
+            value = f;
+        } else {
+            value = (type == 'i') ? (double)(int32_t)word : (double)word;
+        }
+        return snprintf(out, size, spec, value);
+    }
+
+    if (type == 'f') {
+        float f;
+        memcpy(&f, &word, sizeof(f));
+        word = (uint32_t)(int32_t)f;
+    }
 
-    Serial.println(buffer);
+    if (conversion == 'd' || conversion == 'i') {
+        return snprintf(out, size, spec, (int)(int32_t)word);
+    }
+    return snprintf(out, size, spec, (unsigned int)word);
 }
 
-void Logger::info(const char* tag, const char* format, ...) {
-    if (!enabled || LogLevel::INFO > minLevel) return;
+/**
+ * @brief Pop the oldest record and format it into line
+ * @return false if nothing is pending
+ */
+bool Logger::formatNext() {
+    uint8_t size;
+    if (!ring.peek(size)) return false;
+
+    uint8_t record[LOG_RECORD_MAX];
+    record[0] = size;
+    for (uint8_t i = 1; i < size; i++) {
+        ring.peekAt(i, record[i]);
+    }
+    ring.discard(size);
+
+    uint32_t timestamp;
+    const char* tag;
+    const char* format;
+    memcpy(&timestamp, record + 2, sizeof(timestamp));
+    memcpy(&tag, record + 2 + sizeof(timestamp), sizeof(tag));
+    memcpy(&format, record + 2 + sizeof(timestamp) + sizeof(tag), sizeof(format));
+
+    size_t pos = 0;
+    const size_t room = sizeof(line) - 2;    // Keep space for "\r\n"
+
+    auto append = [&](int n) {
+        if (n > 0) pos += ((size_t)n < room - pos) ? (size_t)n : room - pos - 1;
+    };
+
+    append(snprintf(line, room, "[%lu] %s[%s] ", (unsigned long)(timestamp / 1000),
+                    levelName(record[1]), tag));
+
+    LogArgs args(record, size);
+    const char* p = format;
+    while (*p && pos < room - 1) {
+        if (*p != '%') {
+            line[pos++] = *p++;
+            continue;
+        }
 
-    printTimestamp();
-    printLevel(LogLevel::INFO);
-    Serial.printf("[%s] ", tag);
+        if (p[1] == '%') {
+            line[pos++] = '%';
+            p += 2;
+            continue;
+        }
 
-    va_list args;
-    va_start(args, format);
-    char buffer[256];
-    vsnprintf(buffer, sizeof(buffer), format, args);
-    va_end(args);
+        // Collect flags/width/precision, expanding '*' from the arguments;
+        // length modifiers are dropped (all integer args are 32-bit)
+        char spec[24];
+        size_t specLen = 0;
+        spec[specLen++] = *p++;
 
-    Serial.println(buffer);
+        char type = 0;
+        uint32_t word = 0;
+        const char* str = nullptr;
+        uint8_t strLength = 0;
+
+        while (*p && strchr("-+ #0123456789.*lhzjt", *p)) {
+            if (*p == '*') {
+                int value = 0;
+                if (args.next(type, word, str, strLength) && type != 's') value = (int32_t)word;
+                specLen += snprintf(spec + specLen, sizeof(spec) - specLen - 2, "%d", value);
+            } else if (!strchr("lhzjt", *p) && specLen < sizeof(spec) - 2) {
+                spec[specLen++] = *p;
+            }
+            p++;
+        }
+
+        char conversion = *p;
+        if (!conversion) break;
+        p++;
+
+        if (conversion == 'p') conversion = 'x';
+        spec[specLen++] = conversion;
+        spec[specLen] = '\0';
+
+        if (!args.next(type, word, str, strLength)) {
+            append(snprintf(line + pos, room - pos, "?"));
+            continue;
+        }
+
+        append(formatArg(line + pos, room - pos, spec, conversion, type, word, str, strLength));
+    }
+
+    line[pos++] = '\r';
+    line[pos++] = '\n';
+    lineLength = pos;
+    linePos = 0;
+    return true;
 }
 
-void Logger::debug(const char* tag, const char* format, ...) {
-    if (!enabled || LogLevel::DEBUG > minLevel) return;
+bool Logger::flush(uint8_t maxLines) {
+    uint8_t lines = 0;
 
-    printTimestamp();
-    printLevel(LogLevel::DEBUG);
-    Serial.printf("[%s] ", tag);
+    while (true) {
+        // Finish the current line first, as far as the output accepts
+        if (linePos < lineLength) {
+            size_t remaining = lineLength - linePos;
+            if (paced) {
+                int space = output->availableForWrite();
+                if (space <= 0) break;
+                if ((size_t)space < remaining) remaining = space;
+            }
+            linePos += output->write((const uint8_t*)line + linePos, remaining);
+            if (linePos < lineLength) break;
+        }
 
-    va_list args;
-    va_start(args, format);
-    char buffer[256];
-    vsnprintf(buffer, sizeof(buffer), format, args);
-    va_end(args);
+        if (lines >= maxLines) break;
+
+        if (dropped != droppedReported) {
+            int n = snprintf(line, sizeof(line), "[LOG] %u records dropped\r\n",
+                             (unsigned)(dropped - droppedReported));
+            droppedReported = dropped;
+            lineLength = (n < (int)sizeof(line)) ? n : sizeof(line) - 1;
+            linePos = 0;
+        } else if (!formatNext()) {
+            break;
+        }
+        lines++;
+    }
 
-    Serial.println(buffer);
+    return !ring.isEmpty() || linePos < lineLength;
 }
@@ -0,0 +1,59 @@
+/**
+ * @file loop_profiler.cpp
+ * @brief Loop latency profiler implementation
+ */
+
+#include "utils/loop_profiler.h"
+#include "utils/logger.h"
+
+LoopProfiler::LoopProfiler() {
+    reset();
+}
+
+void LoopProfiler::reset() {
+    memset(stages, 0, sizeof(stages));
+    for (StageStats& stats : stages) {
+        stats.minUs = UINT32_MAX;
+    }
+
+    cyclesPerUs = ESP.getCpuFreqMHz();
+    if (cyclesPerUs == 0) cyclesPerUs = 80;
+}
+
+void LoopProfiler::addSample(ProfileStage stage, uint32_t us) {
+    if (stage >= ProfileStage::COUNT) return;
+    StageStats& stats = stages[(uint8_t)stage];
+
+    stats.count++;
+    stats.totalUs += us;
+    if (us < stats.minUs) stats.minUs = us;
+    if (us > stats.maxUs) stats.maxUs = us;
+
+    // Bucket = floor(log2(us)), last bucket open-ended
+    uint8_t bucket = 0;
+    for (uint32_t v = us; v > 1 && bucket < LOOP_PROFILE_BUCKETS - 1; v >>= 1) {
+        bucket++;
+    }
+    if (stats.histogram[bucket] < UINT16_MAX) {
+        stats.histogram[bucket]++;
+    }
+
+    if (us > LOOP_STALL_US) {
+        stats.stalls++;
+        LOG_WARN("Perf", "Stall in %s: %u ms", stageName(stage), (unsigned)(us / 1000));
+    }
+}
+
+const char* LoopProfiler::stageName(ProfileStage stage) {
+    switch (stage) {
+        case ProfileStage::LOOP:      return "loop";
+        case ProfileStage::STM32:     return "stm32";
+        case ProfileStage::WIFI:      return "wifi";
+        case ProfileStage::MQTT:      return "mqtt";
+        case ProfileStage::NTP:       return "ntp";
+        case ProfileStage::HEARTBEAT: return "heartbeat";
+        case ProfileStage::METER:     return "meter";
+        case ProfileStage::SLEEP:     return "sleep";
+        default:                      return "?";
+    }
+}
@@ -0,0 +1,138 @@
+/**
+ * @file memory_pool.cpp
+ * @brief Fixed block pools and heap watermarks
+ */
+
+#include "utils/memory_pool.h"
+#include "utils/json_writer.h"
+#include "utils/logger.h"
+
+MemoryPool* MemoryPool::head = nullptr;
+
+MemoryPool::MemoryPool(const char* poolName, uint8_t* storage, uint16_t size, uint8_t count)
+    : name(poolName),
+      blocks(storage),
+      blockSize(size),
+      blockCount(count),
+      used(0),
+      highWater(0),
+      failures(0),
+      freeMask(count >= 32 ? 0xFFFFFFFFUL : (1UL << count) - 1),
+      next(head) {
+    // Pools are file-scope statics: registered before setup() runs
+    head = this;
+}
+
+MemoryPool::~MemoryPool() {
+    for (MemoryPool** link = &head; *link; link = &(*link)->next) {
+        if (*link == this) {
+            *link = next;
+            break;
+        }
+    }
+}
+
+void* MemoryPool::acquire() {
+    if (freeMask == 0) {
+        failures++;
+        return nullptr;
+    }
+
+    uint8_t index = 0;
+    while (!(freeMask & (1UL << index))) {
+        index++;
+    }
+
+    freeMask &= ~(1UL << index);
+    used++;
+    if (used > highWater) {
+        highWater = used;
+    }
+    return blocks + (size_t)index * blockSize;
+}
+
+void MemoryPool::release(void* block) {
+    if (!block) return;
+
+    size_t offset = (uint8_t*)block - blocks;
+    uint8_t index = (uint8_t)(offset / blockSize);
+    if ((uint8_t*)block < blocks || index >= blockCount || offset % blockSize != 0 ||
+        (freeMask & (1UL << index))) {
+        LOG_ERROR("Memory", "Bad release to pool %s", name);
+        return;
+    }
+
+    freeMask |= 1UL << index;
+    used--;
+}
+
+/* ============================================================================
+ * Heap watermarks
+ * ============================================================================ */
+
+namespace MemoryStats {
+
+static HeapStats stats = {0, 0xFFFFFFFFUL, 0, 0xFFFFFFFFUL, 0, 0, 0};
+
+void sample() {
+    stats.freeNow = ESP.getFreeHeap();
+    stats.blockNow = ESP.getMaxFreeBlockSize();
+    stats.fragNow = (uint8_t)ESP.getHeapFragmentation();
+
+    if (stats.freeNow < stats.freeMin) stats.freeMin = stats.freeNow;
+    if (stats.blockNow < stats.blockMin) stats.blockMin = stats.blockNow;
+    if (stats.fragNow > stats.fragMax) stats.fragMax = stats.fragNow;
+}
+
+void markSteadyState() {
+    sample();
+    stats.steadyFree = stats.freeNow;
+}
+
+int32_t drift() {
+    if (stats.steadyFree == 0) return 0;
+    return (int32_t)stats.freeNow - (int32_t)stats.steadyFree;
+}
+
+const HeapStats& heap() {
+    return stats;
+}
+
+void writeJson(JsonWriter& w) {
+    w.beginObject("heap");
+    w.field("free", stats.freeNow);
+    w.field("freeMin", stats.freeMin);
+    w.field("maxBlock", stats.blockNow);
+    w.field("maxBlockMin", stats.blockMin);
+    w.field("frag", stats.fragNow);
+    w.field("fragMax", stats.fragMax);
+    w.field("drift", drift());
+    w.endObject();
+
+    w.beginArray("pools");
+    for (const MemoryPool* pool = MemoryPool::first(); pool; pool = pool->getNext()) {
+        w.beginObject();
+        w.field("name", pool->getName());
+        w.field("blockSize", pool->getBlockSize());
+        w.field("blocks", pool->getBlockCount());
+        w.field("used", pool->getUsed());
+        w.field("highWater", pool->getHighWater());
+        w.field("failures", pool->getFailures());
+        w.endObject();
+    }
+    w.endArray();
+}
+
+void log() {
+    LOG_INFO("Memory", "Heap free %u (min %u), block %u (min %u), frag %u%% (max %u%%), drift %d",
+             stats.freeNow, stats.freeMin, stats.blockNow, stats.blockMin,
+             stats.fragNow, stats.fragMax, drift());
+
+    for (const MemoryPool* pool = MemoryPool::first(); pool; pool = pool->getNext()) {
+        LOG_INFO("Memory", "Pool %s: %u/%u x %u B, high %u, refused %u",
+                 pool->getName(), pool->getUsed(), pool->getBlockCount(),
+                 pool->getBlockSize(), pool->getHighWater(), pool->getFailures());
+    }
+}
+
+} // namespace MemoryStats
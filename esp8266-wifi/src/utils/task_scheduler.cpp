@@ -0,0 +1,78 @@
+/**
+ * @file task_scheduler.cpp
+ * @brief Cooperative task scheduler implementation
+ */
+
+#include "utils/task_scheduler.h"
+
+int8_t TaskScheduler::add(const char* name, TaskFunction run, uint32_t periodMs) {
+    if (count >= SCHEDULER_MAX_TASKS || !run) return -1;
+
+    ScheduledTask& task = tasks[count];
+    task.name = name;
+    task.run = run;
+    task.periodMs = periodMs;
+    task.nextRun = millis() + periodMs;
+    task.runs = 0;
+    task.missed = 0;
+    task.enabled = true;
+    return (int8_t)count++;
+}
+
+void TaskScheduler::setPeriod(int8_t id, uint32_t periodMs) {
+    if (id < 0 || id >= count) return;
+    tasks[id].periodMs = periodMs;
+    tasks[id].nextRun = millis() + periodMs;
+}
+
+void TaskScheduler::setEnabled(int8_t id, bool enabled) {
+    if (id < 0 || id >= count) return;
+    if (enabled && !tasks[id].enabled) {
+        tasks[id].nextRun = millis() + tasks[id].periodMs;
+    }
+    tasks[id].enabled = enabled;
+}
+
+void TaskScheduler::trigger(int8_t id) {
+    if (id < 0 || id >= count) return;
+    tasks[id].nextRun = millis();
+}
+
+void TaskScheduler::run(uint32_t now) {
+    for (uint8_t i = 0; i < count; i++) {
+        ScheduledTask& task = tasks[i];
+        if (!task.enabled) continue;
+
+        if (task.periodMs > 0) {
+            // Signed difference: correct across the millis() wrap
+            int32_t late = (int32_t)(now - task.nextRun);
+            if (late < 0) continue;
+
+            if ((uint32_t)late >= task.periodMs) {
+                // Skip the missed slots instead of running back to back
+                task.missed++;
+                task.nextRun = now + task.periodMs;
+            } else {
+                task.nextRun += task.periodMs;
+            }
+        }
+
+        task.runs++;
+        task.run();
+    }
+}
+
+uint32_t TaskScheduler::idleTime(uint32_t now, uint32_t maxMs) const {
+    uint32_t idle = maxMs;
+
+    for (uint8_t i = 0; i < count; i++) {
+        const ScheduledTask& task = tasks[i];
+        if (!task.enabled || task.periodMs == 0) continue;
+
+        int32_t remaining = (int32_t)(task.nextRun - now);
+        if (remaining <= 0) return 0;
+        if ((uint32_t)remaining < idle) idle = (uint32_t)remaining;
+    }
+
+    return idle;
+}
@@ -5,6 +5,59 @@
  */
 
 #include "uart_protocol.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <pgmspace.h>
+#endif
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#ifndef pgm_read_word
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#endif
+
+/**
+ * @brief CRC-16/CCITT-FALSE lookup table (poly 0x1021), kept in flash
+ */
+static const uint16_t UART_CRC16_TABLE[256] PROGMEM = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+};
+
+static inline uint16_t uart_crc16_byte(uint16_t crc, uint8_t byte) {
+    return (uint16_t)(crc << 8) ^ pgm_read_word(&UART_CRC16_TABLE[((crc >> 8) ^ byte) & 0xFF]);
+}
 
 /**
  * @brief Calculate checksum for UART packet
@@ -25,6 +78,111 @@ uint8_t uart_calculate_checksum(const uart_packet_t* packet) {
     return checksum;
 }
 
+/**
+ * @brief Update CRC-16/CCITT-FALSE over a block (start with 0xFFFF)
+ */
+uint16_t uart_crc16_update(uint16_t crc, const uint8_t* data, uint16_t length) {
+    if (data == nullptr) return crc;
+
+    for (uint16_t i = 0; i < length; i++) {
+        crc = uart_crc16_byte(crc, data[i]);
+    }
+
+    return crc;
+}
+
+/**
+ * @brief Update CRC-32 (IEEE 802.3, as zlib crc32()) over a block
+ *
+ * Start with 0; the result of one call continues the next. Nibble table:
+ * bulk blocks are checksummed once, speed matters less than 1 KB of RAM.
+ */
+uint32_t uart_crc32_update(uint32_t crc, const uint8_t* data, uint16_t length) {
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+        0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+        0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+
+    if (data == nullptr) return crc;
+
+    crc = ~crc;
+    for (uint16_t i = 0; i < length; i++) {
+        crc = (crc >> 4) ^ table[(crc ^ data[i]) & 0x0F];
+        crc = (crc >> 4) ^ table[(crc ^ (data[i] >> 4)) & 0x0F];
+    }
+    return ~crc;
+}
+
+/**
+ * @brief Calculate v2 CRC-16 for UART packet (same fields as the XOR checksum)
+ */
+uint16_t uart_calculate_crc16(const uart_packet_t* packet) {
+    if (packet == nullptr) return 0;
+
+    uint8_t header[4] = {
+        packet->cmd_type,
+        (uint8_t)(packet->length & 0xFF),
+        (uint8_t)((packet->length >> 8) & 0xFF),
+        packet->sequence
+    };
+
+    uint16_t crc = uart_crc16_update(0xFFFF, header, sizeof(header));
+    return uart_crc16_update(crc, packet->payload, packet->length);
+}
+
+/**
+ * @brief Total bytes on the wire for a frame of the given version
+ */
+uint16_t uart_frame_size(uint8_t version, uint16_t payload_length) {
+    return UART_HEADER_SIZE + payload_length +
+           (version == UART_PROTOCOL_V2 ? UART_FOOTER_SIZE_V2 : UART_FOOTER_SIZE);
+}
+
+/**
+ * @brief Check if a baud rate may be negotiated
+ */
+bool uart_baud_supported(uint32_t baud_rate) {
+    switch (baud_rate) {
+        case 115200:
+        case 230400:
+        case 460800:
+        case 921600:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Fill baud test pattern
+ *
+ * 0x55/0xAA/0x00/0xFF stress bit edges and long runs; the index term
+ * catches dropped or duplicated bytes.
+ */
+void uart_fill_baud_test(uint8_t* buffer, uint16_t length) {
+    static const uint8_t base[4] = {0x55, 0xAA, 0x00, 0xFF};
+
+    if (buffer == nullptr) return;
+
+    for (uint16_t i = 0; i < length; i++) {
+        buffer[i] = base[i & 3] ^ (uint8_t)(i >> 2);
+    }
+}
+
+/**
+ * @brief Verify baud test pattern (must be exactly UART_BAUD_TEST_LENGTH)
+ */
+bool uart_check_baud_test(const uint8_t* buffer, uint16_t length) {
+    uint8_t expected[UART_BAUD_TEST_LENGTH];
+
+    if (buffer == nullptr || length != UART_BAUD_TEST_LENGTH) return false;
+
+    uart_fill_baud_test(expected, sizeof(expected));
+    return memcmp(buffer, expected, sizeof(expected)) == 0;
+}
+
 /**
  * @brief Initialize UART packet
  */
@@ -38,3 +196,246 @@ void uart_init_packet(uart_packet_t* packet, uint8_t cmd_type, uint8_t sequence)
     packet->checksum = 0;
     packet->end_byte = UART_END_BYTE;
 }
+
+/**
+ * @brief Initialize streaming parser
+ *
+ * @param payload_buf Optional buffer (UART_MAX_PAYLOAD bytes) to store the
+ *                    payload into, or nullptr to only checksum it
+ */
+void uart_parser_init(uart_parser_t* parser, uint8_t* payload_buf) {
+    if (parser == nullptr) return;
+
+    parser->payload_buf = payload_buf;
+    uart_parser_reset(parser);
+}
+
+/**
+ * @brief Drop any partial frame and go back to hunting for a start byte
+ */
+void uart_parser_reset(uart_parser_t* parser) {
+    if (parser == nullptr) return;
+
+    parser->state = UART_PARSE_HUNT_START;
+    parser->version = UART_PROTOCOL_V1;
+    parser->cmd_type = 0;
+    parser->length = 0;
+    parser->sequence = 0;
+    parser->checksum = 0;
+    parser->crc = 0xFFFF;
+    parser->rx_crc = 0;
+    parser->header_pos = 0;
+    parser->footer_pos = 0;
+    parser->payload_pos = 0;
+    parser->frame_bytes = 0;
+}
+
+/**
+ * @brief Feed received bytes into the streaming parser
+ *
+ * Consumes input until a frame completes, an error is detected or the
+ * input runs out. Stops right after the byte that finished (or broke)
+ * a frame so the caller can act on it; *consumed tells how far it got.
+ * After a result other than UART_PARSE_INCOMPLETE the parser is back in
+ * UART_PARSE_HUNT_START, but frame_bytes still covers the finished frame.
+ */
+uart_parse_result_t uart_parser_feed(uart_parser_t* parser, const uint8_t* data,
+                                     uint16_t length, uint16_t* consumed) {
+    uint16_t i = 0;
+    uart_parse_result_t result = UART_PARSE_INCOMPLETE;
+
+    if (parser == nullptr || data == nullptr) {
+        if (consumed) *consumed = 0;
+        return UART_PARSE_INCOMPLETE;
+    }
+
+    while (i < length && result == UART_PARSE_INCOMPLETE) {
+        switch (parser->state) {
+            case UART_PARSE_HUNT_START: {
+                uint8_t byte = data[i++];
+                if (byte == UART_START_BYTE || byte == UART_START_BYTE_V2) {
+                    uart_parser_reset(parser);
+                    parser->version = (byte == UART_START_BYTE_V2) ? UART_PROTOCOL_V2
+                                                                   : UART_PROTOCOL_V1;
+                    parser->state = UART_PARSE_HEADER;
+                    parser->frame_bytes = 1;
+                }
+                break;
+            }
+
+            case UART_PARSE_HEADER: {
+                uint8_t byte = data[i++];
+                if (parser->version == UART_PROTOCOL_V2) {
+                    parser->crc = uart_crc16_byte(parser->crc, byte);
+                } else {
+                    parser->checksum ^= byte;
+                }
+                parser->frame_bytes++;
+
+                switch (parser->header_pos++) {
+                    case 0: parser->cmd_type = byte; break;
+                    case 1: parser->length = byte; break;
+                    case 2: parser->length |= (uint16_t)byte << 8; break;
+                    default: parser->sequence = byte; break;
+                }
+
+                if (parser->header_pos == UART_HEADER_SIZE - 1) {
+                    if (parser->length > UART_MAX_PAYLOAD) {
+                        parser->state = UART_PARSE_HUNT_START;
+                        result = UART_PARSE_ERR_LENGTH;
+                    } else {
+                        parser->state = (parser->length > 0) ? UART_PARSE_PAYLOAD
+                                                             : UART_PARSE_CHECKSUM;
+                    }
+                }
+                break;
+            }
+
+            case UART_PARSE_PAYLOAD: {
+                // Bulk path: take as much of the payload as this chunk holds
+                uint16_t chunk = parser->length - parser->payload_pos;
+                if (chunk > length - i) chunk = length - i;
+
+                if (parser->version == UART_PROTOCOL_V2) {
+                    parser->crc = uart_crc16_update(parser->crc, data + i, chunk);
+                } else {
+                    for (uint16_t j = 0; j < chunk; j++) {
+                        parser->checksum ^= data[i + j];
+                    }
+                }
+                if (parser->payload_buf != nullptr) {
+                    memcpy(parser->payload_buf + parser->payload_pos, data + i, chunk);
+                }
+
+                i += chunk;
+                parser->payload_pos += chunk;
+                parser->frame_bytes += chunk;
+
+                if (parser->payload_pos == parser->length) {
+                    parser->state = UART_PARSE_CHECKSUM;
+                }
+                break;
+            }
+
+            case UART_PARSE_CHECKSUM: {
+                uint8_t byte = data[i++];
+                parser->frame_bytes++;
+
+                if (parser->version == UART_PROTOCOL_V2) {
+                    // CRC-16, little-endian
+                    parser->rx_crc |= (uint16_t)byte << (8 * parser->footer_pos);
+                    if (++parser->footer_pos < 2) break;
+
+                    if (parser->rx_crc != parser->crc) {
+                        parser->state = UART_PARSE_HUNT_START;
+                        result = UART_PARSE_ERR_CHECKSUM;
+                        break;
+                    }
+                } else if (byte != parser->checksum) {
+                    parser->state = UART_PARSE_HUNT_START;
+                    result = UART_PARSE_ERR_CHECKSUM;
+                    break;
+                }
+
+                parser->state = UART_PARSE_END;
+                break;
+            }
+
+            case UART_PARSE_END:
+            default:
+                parser->frame_bytes++;
+                parser->state = UART_PARSE_HUNT_START;
+                result = (data[i++] == UART_END_BYTE) ? UART_PARSE_FRAME
+                                                      : UART_PARSE_ERR_END_BYTE;
+                break;
+        }
+    }
+
+    if (consumed) *consumed = i;
+    return result;
+}
+
+/**
+ * @brief Number of fragments needed for a message
+ */
+uint8_t uart_fragment_count(uint16_t total_length) {
+    if (total_length == 0) return 1;
+    return (uint8_t)((total_length + UART_FRAGMENT_CHUNK - 1) / UART_FRAGMENT_CHUNK);
+}
+
+/**
+ * @brief Initialize reassembly context over a caller buffer
+ */
+void uart_reassembly_init(uart_reassembly_t* reassembly, uint8_t* buffer, uint16_t capacity) {
+    if (reassembly == nullptr) return;
+
+    memset(reassembly, 0, sizeof(uart_reassembly_t));
+    reassembly->buffer = buffer;
+    reassembly->capacity = capacity;
+}
+
+/**
+ * @brief Store one fragment at its offset
+ *
+ * Fragments of the current message may come in any order; a repeated
+ * index is reported as a duplicate and not copied again. The last
+ * completed message is remembered, so a late retransmit of one of its
+ * fragments is a duplicate too rather than the start of a new message.
+ */
+uart_reassembly_result_t uart_reassembly_feed(uart_reassembly_t* reassembly,
+                                              const uart_fragment_header_t* header,
+                                              const uint8_t* chunk, uint16_t chunk_length) {
+    if (reassembly == nullptr || header == nullptr) return UART_REASSEMBLY_ERR_HEADER;
+
+    uint16_t total = header->total_length;
+    if (header->count == 0 || header->count > UART_FRAGMENT_MAX_COUNT ||
+        header->index >= header->count || header->count != uart_fragment_count(total)) {
+        return UART_REASSEMBLY_ERR_HEADER;
+    }
+
+    uint16_t offset = (uint16_t)header->index * UART_FRAGMENT_CHUNK;
+    uint16_t expected = (header->index + 1 < header->count) ? UART_FRAGMENT_CHUNK
+                                                             : (uint16_t)(total - offset);
+    if (chunk_length != expected || (chunk_length > 0 && chunk == nullptr)) {
+        return UART_REASSEMBLY_ERR_HEADER;
+    }
+
+    if (total > reassembly->capacity || reassembly->buffer == nullptr) {
+        reassembly->active = 0;
+        reassembly->received = 0;
+        return UART_REASSEMBLY_ERR_OVERFLOW;
+    }
+
+    // New message (or a different one): drop whatever was partial
+    bool sameMessage = reassembly->message_id == header->message_id &&
+                       reassembly->cmd_type == header->cmd_type &&
+                       reassembly->total_length == total &&
+                       reassembly->received > 0;
+    if (!sameMessage) {
+        reassembly->active = 1;
+        reassembly->message_id = header->message_id;
+        reassembly->cmd_type = header->cmd_type;
+        reassembly->count = header->count;
+        reassembly->total_length = total;
+        reassembly->received = 0;
+        reassembly->received_mask = 0;
+    }
+
+    uint32_t bit = (uint32_t)1 << header->index;
+    if (reassembly->received_mask & bit) {
+        return UART_REASSEMBLY_DUPLICATE;
+    }
+
+    if (chunk_length > 0) {
+        memcpy(reassembly->buffer + offset, chunk, chunk_length);
+    }
+    reassembly->received_mask |= bit;
+    reassembly->received++;
+
+    if (reassembly->received < reassembly->count) {
+        return UART_REASSEMBLY_INCOMPLETE;
+    }
+
+    reassembly->active = 0;
+    return UART_REASSEMBLY_COMPLETE;
+}
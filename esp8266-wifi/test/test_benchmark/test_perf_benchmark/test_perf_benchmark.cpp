@@ -0,0 +1,275 @@
+/**
+ * @file test_perf_benchmark.cpp
+ * @brief Hot-path micro-benchmarks in ns/op for regression tracking
+ *
+ * Each case repeats one operation PERF_ITERATIONS times and prints
+ *   perf <name> <ns> ns/op
+ * which ../tools/perf_track.py collects per commit. Cases only assert
+ * that the work was done correctly; timing thresholds live in the
+ * tracker so a slow CI host does not fail the suite.
+ * Run on host: pio test -e native -f test_benchmark/test_perf_benchmark
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "../../../shared/uart_protocol.h"
+#include "utils/ring_buffer.h"
+#include "handlers/ocpp_json.h"
+#include "drivers/mqtt/mqtt_topic_builder.h"
+#include "../../test_mocks/uart_stream_builder.h"
+
+#ifndef PERF_ITERATIONS
+#define PERF_ITERATIONS     20000
+#endif
+
+#define PERF_STREAM_SIZE    8192
+
+static uint8_t stream[PERF_STREAM_SIZE];
+static uint8_t payload[UART_MAX_PAYLOAD];
+static char output[512];
+
+// Keeps results observable so the optimizer cannot drop the loops
+static volatile uint32_t sink;
+
+/**
+ * @brief Print one result in the tracker format
+ */
+static void report(const char* name, uint32_t elapsedUs, uint32_t ops) {
+    char line[96];
+    uint64_t ns = (uint64_t)elapsedUs * 1000u / (ops ? ops : 1);
+    snprintf(line, sizeof(line), "perf %s %lu ns/op", name, (unsigned long)ns);
+    TEST_MESSAGE(line);
+}
+
+static void fillPayload(uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        payload[i] = (uint8_t)(i * 13 + 1);
+    }
+}
+
+/**
+ * @brief Parse a whole stream once per op
+ * @return Frames seen in the last pass
+ */
+static uint16_t benchParse(const char* name, const UartStreamBuilder& builder, uint32_t passes) {
+    uart_parser_t parser;
+    uint16_t frames = 0;
+
+    uint32_t start = benchMicros();
+    for (uint32_t pass = 0; pass < passes; pass++) {
+        uart_parser_init(&parser, nullptr);
+        frames = 0;
+        size_t pos = 0;
+        while (pos < builder.size()) {
+            uint16_t consumed = 0;
+            uart_parse_result_t result = uart_parser_feed(&parser, builder.data() + pos,
+                                                          (uint16_t)(builder.size() - pos),
+                                                          &consumed);
+            pos += consumed;
+            if (result == UART_PARSE_FRAME) {
+                frames++;
+            } else if (result != UART_PARSE_INCOMPLETE) {
+                uart_parser_reset(&parser);
+            }
+        }
+    }
+    uint32_t elapsed = benchMicros() - start;
+
+    // ns per frame, the unit the link budget is written in
+    report(name, elapsed, passes * (frames ? frames : 1));
+    return frames;
+}
+
+static void fillMeter(meter_values_t& meter, uint32_t i) {
+    memset(&meter, 0, sizeof(meter));
+    strcpy(meter.msg_id, "a1b2c3d4-0001");
+    strcpy(meter.timestamp, "2026-01-01T00:00:00Z");
+    meter.connector_id = 1;
+    meter.transaction_id = 42;
+    meter.sample.energy_wh = 123456 + i;
+    meter.sample.power_w = 7200;
+    meter.sample.voltage_v = 230;
+    meter.sample.current_a = 32;
+    meter.sample.frequency_hz = 50;
+    meter.sample.temperature_c = 35;
+    meter.sample.power_factor_pct = 98;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_perf_parse_small_v2(void) {
+    // Arrange: meter-sized frames
+    UartStreamBuilder builder(stream, sizeof(stream));
+    fillPayload(32);
+    for (uint16_t i = 0; i < 150; i++) {
+        builder.addFrame(UART_PROTOCOL_V2, CMD_PUBLISH_METER_VALUES, (uint8_t)i, payload, 32);
+    }
+
+    // Act
+    uint16_t frames = benchParse("parse_small_v2", builder, PERF_ITERATIONS / 100);
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT16(builder.frameCount(), frames);
+}
+
+void test_perf_parse_max_v2(void) {
+    // Arrange
+    UartStreamBuilder builder(stream, sizeof(stream));
+    fillPayload(UART_MAX_PAYLOAD);
+    for (uint8_t seq = 0; seq < 15; seq++) {
+        builder.addFrame(UART_PROTOCOL_V2, CMD_MQTT_PUBLISH, seq, payload, UART_MAX_PAYLOAD);
+    }
+
+    // Act
+    uint16_t frames = benchParse("parse_max_v2", builder, PERF_ITERATIONS / 100);
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT16(builder.frameCount(), frames);
+}
+
+void test_perf_crc16_max_payload(void) {
+    // Arrange
+    fillPayload(UART_MAX_PAYLOAD);
+    uint16_t expected = uart_crc16_update(0xFFFF, payload, UART_MAX_PAYLOAD);
+
+    // Act
+    uint32_t start = benchMicros();
+    for (uint32_t i = 0; i < PERF_ITERATIONS; i++) {
+        sink = uart_crc16_update(0xFFFF, payload, UART_MAX_PAYLOAD);
+    }
+    report("crc16_max_payload", benchMicros() - start, PERF_ITERATIONS);
+
+    // Assert
+    TEST_ASSERT_EQUAL_HEX16(expected, (uint16_t)sink);
+}
+
+void test_perf_ring_buffer_frame(void) {
+    // Arrange: one meter frame in and out of the RX ring
+    static RingBuffer<1024> ring;
+    uint8_t out[64];
+    fillPayload(sizeof(out));
+
+    // Act
+    uint32_t start = benchMicros();
+    for (uint32_t i = 0; i < PERF_ITERATIONS; i++) {
+        ring.pushMultiple(payload, sizeof(out));
+        sink = ring.popMultiple(out, sizeof(out));
+    }
+    report("ring_buffer_64b", benchMicros() - start, PERF_ITERATIONS);
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT32(sizeof(out), sink);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(payload, out, sizeof(out));
+    TEST_ASSERT_TRUE(ring.isEmpty());
+}
+
+void test_perf_meter_json(void) {
+    // Arrange
+    meter_values_t meter;
+    fillMeter(meter, 0);
+    size_t length = 0;
+
+    // Act
+    uint32_t start = benchMicros();
+    for (uint32_t i = 0; i < PERF_ITERATIONS; i++) {
+        meter.sample.energy_wh = 123456 + i;
+        length = OcppJson::write<JsonWriter>(output, sizeof(output), meter);
+        sink = output[length / 2];
+    }
+    report("meter_json", benchMicros() - start, PERF_ITERATIONS);
+
+    // Assert
+    TEST_ASSERT_GREATER_THAN(0, length);
+    TEST_ASSERT_NOT_NULL(strstr(output, "\"power_w\":7200"));
+}
+
+void test_perf_meter_msgpack(void) {
+    // Arrange
+    meter_values_t meter;
+    fillMeter(meter, 0);
+    size_t length = 0;
+
+    // Act
+    uint32_t start = benchMicros();
+    for (uint32_t i = 0; i < PERF_ITERATIONS; i++) {
+        meter.sample.energy_wh = 123456 + i;
+        length = OcppJson::write<MsgPackWriter>(output, sizeof(output), meter);
+        sink = output[length / 2];
+    }
+    report("meter_msgpack", benchMicros() - start, PERF_ITERATIONS);
+
+    // Assert
+    TEST_ASSERT_GREATER_THAN(0, length);
+}
+
+void test_perf_status_json(void) {
+    // Arrange
+    status_notification_t status;
+    memset(&status, 0, sizeof(status));
+    strcpy(status.msg_id, "a1b2c3d4-0002");
+    strcpy(status.timestamp, "2026-01-01T00:00:00Z");
+    status.connector_id = 1;
+    size_t length = 0;
+
+    // Act
+    uint32_t start = benchMicros();
+    for (uint32_t i = 0; i < PERF_ITERATIONS; i++) {
+        status.connector_id = (uint8_t)(1 + (i & 1));
+        length = OcppJson::write<JsonWriter>(output, sizeof(output), status);
+        sink = output[length / 2];
+    }
+    report("status_json", benchMicros() - start, PERF_ITERATIONS);
+
+    // Assert
+    TEST_ASSERT_GREATER_THAN(0, length);
+}
+
+void test_perf_meter_topic(void) {
+    // Arrange
+    static DeviceConfig config;
+    memset(&config, 0, sizeof(config));
+    strcpy(config.deviceId, "CP-0001");
+    strcpy(config.stationId, "STATION-01");
+    char topic[128];
+
+    // Act
+    uint32_t start = benchMicros();
+    for (uint32_t i = 0; i < PERF_ITERATIONS; i++) {
+        MQTTTopicBuilder::buildMeter(topic, sizeof(topic), config, (uint8_t)(1 + (i & 1)));
+        sink = topic[0];
+    }
+    report("meter_topic", benchMicros() - start, PERF_ITERATIONS);
+
+    // Assert
+    TEST_ASSERT_NOT_NULL(strstr(topic, "STATION-01/CP-0001/"));
+}
+
+void process(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_perf_parse_small_v2);
+    RUN_TEST(test_perf_parse_max_v2);
+    RUN_TEST(test_perf_crc16_max_payload);
+    RUN_TEST(test_perf_ring_buffer_frame);
+    RUN_TEST(test_perf_meter_json);
+    RUN_TEST(test_perf_meter_msgpack);
+    RUN_TEST(test_perf_status_json);
+    RUN_TEST(test_perf_meter_topic);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
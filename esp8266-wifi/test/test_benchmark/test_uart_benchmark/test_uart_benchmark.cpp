@@ -0,0 +1,279 @@
+/**
+ * @file test_uart_benchmark.cpp
+ * @brief STM32 link benchmark: replays byte streams through STM32Communicator
+ *
+ * Each case reports frames/s, us per frame, peak RX RingBuffer usage and
+ * lost frames, and fails if the link did not recover the expected frames.
+ * Run on target: pio test -e test_esp -f test_benchmark/test_uart_benchmark
+ */
+
+#include <unity.h>
+#include <new>
+#include <stdio.h>
+#include "drivers/communication/stm32_comm.h"
+#include "../../test_mocks/mock_uart_stream.h"
+#include "../../test_mocks/uart_stream_builder.h"
+
+#ifdef ARDUINO
+#include <LittleFS.h>
+#define BENCH_CAPTURE_FILE  "/bench/uart_capture.bin"
+#endif
+
+#define BENCH_STREAM_SIZE   8192
+
+// Communicator is ~6.5 KB: keep it off the stack, rebuild it per case
+alignas(STM32Communicator) static uint8_t commStorage[sizeof(STM32Communicator)];
+static STM32Communicator* comm;
+
+static uint8_t stream[BENCH_STREAM_SIZE];
+static uint8_t payload[UART_MAX_PAYLOAD];
+static uint16_t delivered;
+
+struct BenchResult {
+    uint16_t frames;
+    uint32_t elapsedUs;
+    size_t peakRx;
+    uint32_t checksumErrors;
+    uint32_t errors;
+    uint32_t timeouts;
+    uint32_t dropped;
+    uint32_t flowPauses;
+};
+
+static void onFrame(const UartFrameView& frame) {
+    (void)frame;
+    delivered++;
+}
+
+/**
+ * @brief Replay one stream and print the numbers
+ */
+static BenchResult runBench(const char* name, const uint8_t* data, size_t length,
+                            uint16_t expected, size_t chunk = 128) {
+    comm = new (commStorage) STM32Communicator();
+    MockUARTStream link(data, length, chunk);
+    comm->init();
+    comm->setLink(link);
+    comm->setCallback(onFrame);
+    delivered = 0;
+
+    uint32_t start = benchMicros();
+    while (link.refill()) {
+        comm->handle();
+    }
+    comm->handle();
+    uint32_t elapsed = benchMicros() - start;
+
+    const STM32Status& status = comm->getStatus();
+    BenchResult result = {
+        delivered, elapsed, comm->getBufferPeak(),
+        status.checksumErrors, status.errorCount, status.timeoutErrors,
+        status.rxFramesDropped, status.flowPauses
+    };
+
+    char line[160];
+    uint32_t us = elapsed > 0 ? elapsed : 1;
+    snprintf(line, sizeof(line),
+             "%s: %u/%u frames, %u bytes, %lu us, %lu frames/s, %lu us/frame, "
+             "peak RX %u, checksum %lu, errors %lu, timeouts %lu",
+             name, (unsigned)delivered, (unsigned)expected, (unsigned)length,
+             (unsigned long)elapsed,
+             (unsigned long)((uint64_t)delivered * 1000000u / us),
+             (unsigned long)(delivered ? elapsed / delivered : 0),
+             (unsigned)result.peakRx, (unsigned long)result.checksumErrors,
+             (unsigned long)result.errors, (unsigned long)result.timeouts);
+    TEST_MESSAGE(line);
+
+    comm->~STM32Communicator();
+    return result;
+}
+
+static void fillPayload(uint16_t length, uint8_t salt) {
+    for (uint16_t i = 0; i < length; i++) {
+        payload[i] = (uint8_t)(i * 31 + salt);
+    }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_back_to_back_max_size_v1(void) {
+    // Arrange
+    UartStreamBuilder builder(stream, sizeof(stream));
+    fillPayload(UART_MAX_PAYLOAD, 1);
+    for (uint8_t seq = 0; seq < 15; seq++) {
+        builder.addFrame(UART_PROTOCOL_V1, CMD_MQTT_PUBLISH, seq, payload, UART_MAX_PAYLOAD);
+    }
+
+    // Act
+    BenchResult result = runBench("max-size v1", builder.data(), builder.size(),
+                                  builder.frameCount());
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT16(builder.frameCount(), result.frames);
+    TEST_ASSERT_EQUAL_UINT32(0, result.errors);
+}
+
+void test_back_to_back_max_size_v2(void) {
+    // Arrange
+    UartStreamBuilder builder(stream, sizeof(stream));
+    fillPayload(UART_MAX_PAYLOAD, 2);
+    for (uint8_t seq = 0; seq < 15; seq++) {
+        builder.addFrame(UART_PROTOCOL_V2, CMD_MQTT_PUBLISH, seq, payload, UART_MAX_PAYLOAD);
+    }
+
+    // Act
+    BenchResult result = runBench("max-size v2", builder.data(), builder.size(),
+                                  builder.frameCount());
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT16(builder.frameCount(), result.frames);
+    TEST_ASSERT_EQUAL_UINT32(0, result.errors);
+}
+
+void test_small_frames_v2(void) {
+    // Arrange: meter-sized frames, many per UART chunk
+    UartStreamBuilder builder(stream, sizeof(stream));
+    fillPayload(32, 3);
+    for (uint16_t i = 0; i < 200; i++) {
+        builder.addFrame(UART_PROTOCOL_V2, CMD_PUBLISH_METER_VALUES, (uint8_t)i, payload, 32);
+    }
+
+    // Act
+    BenchResult result = runBench("small v2", builder.data(), builder.size(),
+                                  builder.frameCount());
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT16(builder.frameCount(), result.frames);
+    TEST_ASSERT_EQUAL_UINT32(0, result.errors);
+}
+
+void test_noise_between_frames(void) {
+    // Arrange: garbage (incl. start bytes) before every frame
+    UartStreamBuilder builder(stream, sizeof(stream));
+    fillPayload(128, 4);
+    for (uint8_t seq = 0; seq < 40; seq++) {
+        builder.addNoise(16 + (seq % 4) * 16);
+        builder.addFrame(UART_PROTOCOL_V2, CMD_MQTT_PUBLISH, seq, payload, 128);
+    }
+
+    // Act
+    BenchResult result = runBench("noise", builder.data(), builder.size(),
+                                  builder.frameCount());
+
+    // Assert: every real frame is found again after resync
+    TEST_ASSERT_EQUAL_UINT16(builder.frameCount(), result.frames);
+}
+
+void test_truncated_frames(void) {
+    // Arrange: every fourth frame is cut off mid-payload
+    UartStreamBuilder builder(stream, sizeof(stream));
+    fillPayload(256, 5);
+    for (uint8_t seq = 0; seq < 24; seq++) {
+        uint16_t keep = (seq % 4 == 3) ? 100 : 0;
+        builder.addFrame(UART_PROTOCOL_V2, CMD_MQTT_PUBLISH, seq, payload, 256, keep);
+    }
+
+    // Act
+    BenchResult result = runBench("truncated", builder.data(), builder.size(),
+                                  builder.frameCount());
+
+    // Assert: only the truncated frames are lost
+    TEST_ASSERT_EQUAL_UINT16(builder.frameCount(), result.frames);
+    TEST_ASSERT_TRUE(result.errors > 0);
+}
+
+void test_corrupted_frames(void) {
+    // Arrange: one bit error in every fifth frame
+    UartStreamBuilder builder(stream, sizeof(stream));
+    fillPayload(200, 6);
+    uint16_t corrupted = 0;
+    for (uint8_t seq = 0; seq < 30; seq++) {
+        size_t offset = builder.size();
+        builder.addFrame(UART_PROTOCOL_V2, CMD_MQTT_PUBLISH, seq, payload, 200);
+        if (seq % 5 == 0) {
+            builder.corrupt(offset + UART_HEADER_SIZE + 50);
+            corrupted++;
+        }
+    }
+    uint16_t expected = builder.frameCount() - corrupted;
+
+    // Act
+    BenchResult result = runBench("corrupted", builder.data(), builder.size(), expected);
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT16(expected, result.frames);
+    TEST_ASSERT_EQUAL_UINT32(corrupted, result.checksumErrors);
+}
+
+void test_stall_burst_keeps_frames_whole(void) {
+    // Arrange: v2 handshake, then far more than the RX ring arrives at once
+    // (loop() stalled behind a TLS handshake or flash write)
+    UartStreamBuilder builder(stream, sizeof(stream));
+    hello_payload_t hello = {UART_PROTOCOL_V2, 0};
+    builder.addFrame(UART_PROTOCOL_V1, CMD_HELLO, 0, (const uint8_t*)&hello, sizeof(hello));
+    fillPayload(UART_MAX_PAYLOAD, 7);
+    for (uint8_t seq = 1; seq <= 14; seq++) {
+        builder.addFrame(UART_PROTOCOL_V2, CMD_MQTT_PUBLISH, seq, payload, UART_MAX_PAYLOAD);
+    }
+    uint16_t expected = builder.frameCount() - 1;  // CMD_HELLO stays internal
+
+    // Act: hello first, then the whole burst in one handle()
+    BenchResult result = runBench("stall burst", builder.data(), builder.size(), expected,
+                                  builder.size());
+
+    // Assert: frames are released as the ring fills, none cut or dropped
+    TEST_ASSERT_TRUE(builder.size() > STM32_RX_BUFFER_SIZE);
+    TEST_ASSERT_EQUAL_UINT16(expected, result.frames);
+    TEST_ASSERT_EQUAL_UINT32(0, result.errors);
+    TEST_ASSERT_EQUAL_UINT32(0, result.dropped);
+}
+
+#ifdef ARDUINO
+void test_recorded_capture(void) {
+    // Arrange: raw STM32 TX capture uploaded to LittleFS (uploadfs)
+    if (!LittleFS.begin() || !LittleFS.exists(BENCH_CAPTURE_FILE)) {
+        TEST_IGNORE_MESSAGE("No " BENCH_CAPTURE_FILE " on LittleFS");
+    }
+    File file = LittleFS.open(BENCH_CAPTURE_FILE, "r");
+    size_t length = file.read(stream, sizeof(stream));
+    file.close();
+
+    // Act
+    BenchResult result = runBench("capture", stream, length, 0);
+
+    // Assert: a capture is recorded from a working link
+    TEST_ASSERT_TRUE(result.frames > 0);
+    TEST_ASSERT_EQUAL_UINT32(0, result.checksumErrors);
+}
+#endif
+
+void process(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_back_to_back_max_size_v1);
+    RUN_TEST(test_back_to_back_max_size_v2);
+    RUN_TEST(test_small_frames_v2);
+    RUN_TEST(test_noise_between_frames);
+    RUN_TEST(test_truncated_frames);
+    RUN_TEST(test_corrupted_frames);
+    RUN_TEST(test_stall_burst_keeps_frames_whole);
+#ifdef ARDUINO
+    RUN_TEST(test_recorded_capture);
+#endif
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
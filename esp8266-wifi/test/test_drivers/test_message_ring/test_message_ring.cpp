@@ -0,0 +1,124 @@
+/**
+ * @file test_message_ring.cpp
+ * @brief Unit tests for MessageRing (MQTT RAM queue)
+ */
+
+#include <unity.h>
+#include "drivers/mqtt/mqtt_client.h"
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static size_t readPayload(MessageRing<64>& queue, const MQTTQueueRecord& record, uint8_t* out) {
+    size_t offset = 0;
+    while (offset < record.payloadLength) {
+        size_t n;
+        const uint8_t* data = queue.span(record, offset, n);
+        if (!data || n == 0) break;
+        memcpy(out + offset, data, n);
+        offset += n;
+    }
+    return offset;
+}
+
+void test_records_are_packed(void) {
+    // Arrange
+    MessageRing<64> queue;
+
+    // Act
+    queue.push("a/b", (const uint8_t*)"hello", 5, 1, 0);
+
+    // Assert
+    TEST_ASSERT_EQUAL(1, queue.size());
+    TEST_ASSERT_EQUAL(sizeof(MQTTQueueRecord) + 3 + 5, queue.bytesUsed());
+}
+
+void test_peek_returns_topic_and_payload(void) {
+    // Arrange
+    MessageRing<64> queue;
+    queue.push("a/b", (const uint8_t*)"hello", 5, 1, 0);
+    MQTTQueueRecord record;
+    char topic[16];
+    uint8_t payload[8];
+
+    // Act
+    bool ok = queue.peek(record, topic, sizeof(topic));
+    size_t length = readPayload(queue, record, payload);
+
+    // Assert
+    TEST_ASSERT_TRUE(ok);
+    TEST_ASSERT_EQUAL_STRING("a/b", topic);
+    TEST_ASSERT_EQUAL(1, record.qos);
+    TEST_ASSERT_EQUAL(5, length);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY("hello", payload, 5);
+}
+
+void test_payload_wrapping_ring_end(void) {
+    // Arrange: advance the ring so the next payload wraps
+    MessageRing<64> queue;
+    uint8_t filler[30] = {0};
+    queue.push("x", filler, sizeof(filler), 0, 0);
+    queue.pop();
+    uint8_t data[40];
+    for (uint8_t i = 0; i < sizeof(data); i++) data[i] = i;
+    queue.push("t", data, sizeof(data), 0, 0);
+    MQTTQueueRecord record;
+    char topic[4];
+    uint8_t out[40];
+
+    // Act
+    queue.peek(record, topic, sizeof(topic));
+    size_t length = readPayload(queue, record, out);
+
+    // Assert
+    TEST_ASSERT_EQUAL(sizeof(data), length);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, out, sizeof(data));
+}
+
+void test_push_fails_without_room(void) {
+    // Arrange
+    MessageRing<64> queue;
+    uint8_t data[40] = {0};
+    queue.push("t", data, sizeof(data), 0, 0);
+
+    // Act
+    bool pushed = queue.push("t", data, sizeof(data), 0, 0);
+
+    // Assert
+    TEST_ASSERT_FALSE(pushed);
+    TEST_ASSERT_FALSE(queue.hasRoom(1, sizeof(data)));
+    TEST_ASSERT_EQUAL(1, queue.size());
+}
+
+void test_oversize_record_never_fits(void) {
+    // Act / Assert
+    TEST_ASSERT_TRUE(MessageRing<64>::fits(4, 64 - sizeof(MQTTQueueRecord) - 4));
+    TEST_ASSERT_FALSE(MessageRing<64>::fits(4, 64));
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_records_are_packed);
+    RUN_TEST(test_peek_returns_topic_and_payload);
+    RUN_TEST(test_payload_wrapping_ring_end);
+    RUN_TEST(test_push_fails_without_room);
+    RUN_TEST(test_oversize_record_never_fits);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
@@ -0,0 +1,179 @@
+/**
+ * @file test_mqtt_tap_client.cpp
+ * @brief Unit tests for MQTTTapClient (PUBACK detection on the inbound stream)
+ */
+
+#include <unity.h>
+#include "drivers/mqtt/mqtt_tap_client.h"
+#include <string.h>
+
+/**
+ * @brief Inner client replaying a fixed inbound byte stream
+ */
+class ScriptedClient : public Client {
+public:
+    const uint8_t* data = nullptr;
+    size_t length = 0;
+    size_t pos = 0;
+
+    void script(const uint8_t* bytes, size_t size) {
+        data = bytes;
+        length = size;
+        pos = 0;
+    }
+
+    int connect(IPAddress, uint16_t) override { return 1; }
+    int connect(const char*, uint16_t) override { return 1; }
+    size_t write(uint8_t) override { return 1; }
+    size_t write(const uint8_t*, size_t size) override { return size; }
+    int available() override { return (int)(length - pos); }
+    int read() override { return pos < length ? data[pos++] : -1; }
+    int read(uint8_t* buf, size_t size) override {
+        size_t n = length - pos < size ? length - pos : size;
+        memcpy(buf, data + pos, n);
+        pos += n;
+        return (int)n;
+    }
+    int peek() override { return pos < length ? data[pos] : -1; }
+    bool flush(unsigned int) override { return true; }
+    bool stop(unsigned int) override { return true; }
+    uint8_t connected() override { return 1; }
+    operator bool() override { return true; }
+};
+
+static ScriptedClient inner;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void drainByteWise(MQTTTapClient& tap) {
+    while (tap.available() > 0) {
+        tap.read();
+    }
+}
+
+void test_puback_is_reported(void) {
+    // Arrange
+    const uint8_t stream[] = { 0x40, 0x02, 0x12, 0x34 };
+    inner.script(stream, sizeof(stream));
+    MQTTTapClient tap(inner);
+
+    // Act
+    drainByteWise(tap);
+
+    // Assert
+    uint16_t id = 0;
+    TEST_ASSERT_TRUE(tap.popPubAck(id));
+    TEST_ASSERT_EQUAL_HEX16(0x1234, id);
+    TEST_ASSERT_FALSE(tap.popPubAck(id));
+}
+
+void test_other_packets_are_skipped(void) {
+    // Arrange: CONNACK, PUBLISH (QoS0, "a/b" -> "hi"), PINGRESP, PUBACK
+    const uint8_t stream[] = {
+        0x20, 0x02, 0x00, 0x00,
+        0x30, 0x07, 0x00, 0x03, 'a', '/', 'b', 'h', 'i',
+        0xD0, 0x00,
+        0x40, 0x02, 0x00, 0x07
+    };
+    inner.script(stream, sizeof(stream));
+    MQTTTapClient tap(inner);
+
+    // Act
+    drainByteWise(tap);
+
+    // Assert
+    uint16_t id = 0;
+    TEST_ASSERT_TRUE(tap.popPubAck(id));
+    TEST_ASSERT_EQUAL(7, id);
+    TEST_ASSERT_FALSE(tap.popPubAck(id));
+}
+
+void test_multibyte_length_keeps_framing(void) {
+    // Arrange: PUBLISH with a 200-byte body whose payload looks like a PUBACK
+    static uint8_t stream[3 + 200 + 4];
+    memset(stream, 0x40, sizeof(stream));
+    stream[0] = 0x30;
+    stream[1] = 0xC8;   // 200 = 0x48 | continuation, 0x01
+    stream[2] = 0x01;
+    stream[3] = 0x00;
+    stream[4] = 0x01;
+    stream[5] = 't';
+    const uint8_t puback[] = { 0x40, 0x02, 0xAB, 0xCD };
+    memcpy(stream + 3 + 200, puback, sizeof(puback));
+    inner.script(stream, sizeof(stream));
+    MQTTTapClient tap(inner);
+
+    // Act
+    drainByteWise(tap);
+
+    // Assert
+    uint16_t id = 0;
+    TEST_ASSERT_TRUE(tap.popPubAck(id));
+    TEST_ASSERT_EQUAL_HEX16(0xABCD, id);
+    TEST_ASSERT_FALSE(tap.popPubAck(id));
+}
+
+void test_bulk_read_is_parsed(void) {
+    // Arrange
+    const uint8_t stream[] = { 0x40, 0x02, 0x00, 0x01, 0x40, 0x02, 0x00, 0x02 };
+    inner.script(stream, sizeof(stream));
+    MQTTTapClient tap(inner);
+    uint8_t buf[16];
+
+    // Act
+    int n = tap.read(buf, sizeof(buf));
+
+    // Assert
+    uint16_t first = 0, second = 0;
+    TEST_ASSERT_EQUAL(sizeof(stream), n);
+    TEST_ASSERT_TRUE(tap.popPubAck(first));
+    TEST_ASSERT_TRUE(tap.popPubAck(second));
+    TEST_ASSERT_EQUAL(1, first);
+    TEST_ASSERT_EQUAL(2, second);
+}
+
+void test_uncollected_pubacks_are_counted(void) {
+    // Arrange: one more PUBACK than the tap holds
+    static uint8_t stream[(MQTT_TAP_PUBACK_SLOTS + 1) * 4];
+    for (uint8_t i = 0; i <= MQTT_TAP_PUBACK_SLOTS; i++) {
+        stream[i * 4] = 0x40;
+        stream[i * 4 + 1] = 0x02;
+        stream[i * 4 + 2] = 0x00;
+        stream[i * 4 + 3] = i + 1;
+    }
+    inner.script(stream, sizeof(stream));
+    MQTTTapClient tap(inner);
+
+    // Act
+    drainByteWise(tap);
+
+    // Assert
+    TEST_ASSERT_EQUAL(1, tap.getDroppedPubAcks());
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_puback_is_reported);
+    RUN_TEST(test_other_packets_are_skipped);
+    RUN_TEST(test_multibyte_length_keeps_framing);
+    RUN_TEST(test_bulk_read_is_parsed);
+    RUN_TEST(test_uncollected_pubacks_are_counted);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
@@ -59,6 +59,46 @@ void test_ntp_formatted_time_default(void) {
     TEST_ASSERT_EQUAL(':', formatted.charAt(5));
 }
 
+void test_ntp_init_does_not_block(void) {
+    // Act
+    uint32_t start = millis();
+    ntpTime->init();
+    ntpTime->update();
+
+    // Assert
+    TEST_ASSERT_LESS_THAN(100, millis() - start);
+    TEST_ASSERT_FALSE(ntpTime->isSynced());
+}
+
+void test_ntp_server_table_limit(void) {
+    // Arrange
+    ntpTime->init("pool.ntp.org");
+
+    // Act / Assert
+    TEST_ASSERT_TRUE(ntpTime->addServer("time.nist.gov"));
+    TEST_ASSERT_TRUE(ntpTime->addServer("time.cloudflare.com"));
+    TEST_ASSERT_FALSE(ntpTime->addServer("one.too.many"));
+}
+
+void test_ntp_force_sync_needs_server(void) {
+    // Act / Assert
+    TEST_ASSERT_FALSE(ntpTime->forceSync());
+}
+
+void test_ntp_unix_time_us_is_monotonic(void) {
+    // Arrange
+    ntpTime->init();
+
+    // Act
+    uint64_t t1 = ntpTime->getUnixTimeUs();
+    delay(5);
+    uint64_t t2 = ntpTime->getUnixTimeUs();
+
+    // Assert
+    TEST_ASSERT_TRUE(t2 >= t1 + 5000);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(t2 / 1000000), ntpTime->getUnixTime());
+}
+
 void process(void) {
     UNITY_BEGIN();
 
@@ -66,6 +106,10 @@ void process(void) {
     RUN_TEST(test_ntp_init_sets_timezone);
     RUN_TEST(test_ntp_unix_time_fallback_when_not_synced);
     RUN_TEST(test_ntp_formatted_time_default);
+    RUN_TEST(test_ntp_init_does_not_block);
+    RUN_TEST(test_ntp_server_table_limit);
+    RUN_TEST(test_ntp_force_sync_needs_server);
+    RUN_TEST(test_ntp_unix_time_us_is_monotonic);
 
     UNITY_END();
 }
@@ -0,0 +1,272 @@
+/**
+ * @file test_offline_journal.cpp
+ * @brief Unit tests for OfflineJournal (runs against LittleFS)
+ */
+
+#include <unity.h>
+#include "drivers/mqtt/offline_journal.h"
+#include <string.h>
+
+static char topic[128];
+static uint16_t length;
+static uint8_t qos;
+
+static bool readPayload(OfflineJournal& journal, char* out, size_t size) {
+    if (length >= size) return false;
+    size_t n = journal.payload().read((uint8_t*)out, length);
+    out[n] = '\0';
+    return n == length;
+}
+
+#define SEGMENT_0 "/mq/t/00000000.seg"
+
+static size_t readFile(const char* path, uint8_t* out, size_t size) {
+    File f = LittleFS.open(path, "r");
+    size_t n = f ? f.read(out, size) : 0;
+    if (f) f.close();
+    return n;
+}
+
+static void writeFile(const char* path, const uint8_t* data, size_t size) {
+    File f = LittleFS.open(path, "w");
+    f.write(data, size);
+    f.close();
+}
+
+void setUp(void) {
+    LittleFS.begin();
+    LittleFS.format();
+}
+
+void tearDown(void) {}
+
+void test_empty_journal_has_nothing_to_peek(void) {
+    // Arrange
+    OfflineJournal journal("/mq/t", 4);
+    journal.init();
+
+    // Act / Assert
+    TEST_ASSERT_TRUE(journal.isEmpty());
+    TEST_ASSERT_FALSE(journal.peek(topic, sizeof(topic), length, qos));
+}
+
+void test_records_replay_in_order(void) {
+    // Arrange
+    OfflineJournal journal("/mq/t", 4);
+    journal.init();
+    journal.append("a/1", (const uint8_t*)"one", 3, 1);
+    journal.append("a/2", (const uint8_t*)"two", 3, 0);
+    char payload[16];
+
+    // Act / Assert
+    TEST_ASSERT_TRUE(journal.peek(topic, sizeof(topic), length, qos));
+    TEST_ASSERT_EQUAL_STRING("a/1", topic);
+    TEST_ASSERT_EQUAL(1, qos);
+    TEST_ASSERT_TRUE(readPayload(journal, payload, sizeof(payload)));
+    TEST_ASSERT_EQUAL_STRING("one", payload);
+    journal.pop();
+
+    TEST_ASSERT_TRUE(journal.peek(topic, sizeof(topic), length, qos));
+    TEST_ASSERT_EQUAL_STRING("a/2", topic);
+    journal.pop();
+
+    TEST_ASSERT_TRUE(journal.isEmpty());
+}
+
+void test_peek_without_pop_returns_same_record(void) {
+    // Arrange
+    OfflineJournal journal("/mq/t", 4);
+    journal.init();
+    journal.append("t", (const uint8_t*)"x", 1, 0);
+
+    // Act
+    journal.peek(topic, sizeof(topic), length, qos);
+    bool again = journal.peek(topic, sizeof(topic), length, qos);
+
+    // Assert
+    TEST_ASSERT_TRUE(again);
+    TEST_ASSERT_EQUAL_STRING("t", topic);
+}
+
+void test_records_survive_reinit(void) {
+    // Arrange: simulate reboot with one record replayed
+    {
+        OfflineJournal journal("/mq/t", 4);
+        journal.init();
+        journal.append("tx/start", (const uint8_t*)"s", 1, 1);
+        journal.append("tx/stop", (const uint8_t*)"e", 1, 1);
+    }
+    OfflineJournal journal("/mq/t", 4);
+
+    // Act
+    journal.init();
+
+    // Assert
+    TEST_ASSERT_FALSE(journal.isEmpty());
+    TEST_ASSERT_TRUE(journal.peek(topic, sizeof(topic), length, qos));
+    TEST_ASSERT_EQUAL_STRING("tx/start", topic);
+}
+
+void test_rolls_over_segments(void) {
+    // Arrange: records large enough to need several segments
+    OfflineJournal journal("/mq/t", 4);
+    journal.init();
+    static uint8_t data[3000];
+    memset(data, 'd', sizeof(data));
+    for (uint8_t i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(journal.append("big", data, sizeof(data), 0));
+    }
+
+    // Act
+    uint8_t replayed = 0;
+    while (journal.peek(topic, sizeof(topic), length, qos)) {
+        TEST_ASSERT_EQUAL(sizeof(data), length);
+        journal.pop();
+        replayed++;
+    }
+
+    // Assert
+    TEST_ASSERT_EQUAL(5, replayed);
+    TEST_ASSERT_TRUE(journal.isEmpty());
+}
+
+void test_full_journal_refuses_without_touching_other_journal(void) {
+    // Arrange: one record per segment until the small journal is full
+    OfflineJournal small("/mq/t", 2);
+    OfflineJournal other("/mq/u", 2);
+    small.init();
+    other.init();
+    static uint8_t data[JOURNAL_SEGMENT_SIZE - 64];
+    uint8_t accepted = 0;
+    while (small.append("meter", data, sizeof(data), 0)) {
+        accepted++;
+    }
+
+    // Act
+    bool otherAccepted = other.append("tx/stop", data, sizeof(data), 1);
+
+    // Assert
+    TEST_ASSERT_EQUAL(2, accepted);
+    TEST_ASSERT_TRUE(otherAccepted);
+    TEST_ASSERT_EQUAL(1, small.getStats().refused);
+    TEST_ASSERT_EQUAL(0, other.getStats().refused);
+}
+
+void test_torn_append_is_cut_at_init(void) {
+    // Arrange: crash after the first bytes of a third record
+    {
+        OfflineJournal journal("/mq/t", 4);
+        journal.init();
+        journal.append("tx/start", (const uint8_t*)"s", 1, 1);
+        journal.append("tx/stop", (const uint8_t*)"e", 1, 1);
+    }
+    File f = LittleFS.open(SEGMENT_0, "a");
+    const uint8_t torn[] = {JOURNAL_RECORD_MAGIC, JOURNAL_FLAG_QOS1, 8, 0, 200, 0};
+    f.write(torn, sizeof(torn));
+    f.close();
+
+    // Act: reboot, then keep journaling
+    OfflineJournal journal("/mq/t", 4);
+    journal.init();
+    journal.append("tx/meter", (const uint8_t*)"m", 1, 1);
+
+    // Assert: all whole records replay, the torn bytes are gone
+    const char* expected[] = {"tx/start", "tx/stop", "tx/meter"};
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(journal.peek(topic, sizeof(topic), length, qos));
+        TEST_ASSERT_EQUAL_STRING(expected[i], topic);
+        journal.pop();
+    }
+    TEST_ASSERT_TRUE(journal.isEmpty());
+    TEST_ASSERT_EQUAL(1, journal.getStats().corrupt);
+}
+
+void test_torn_record_keeps_records_after_it(void) {
+    // Arrange: start | torn stop | meter, as left by an append that failed
+    // without the torn bytes being cut
+    {
+        OfflineJournal journal("/mq/t", 4);
+        journal.init();
+        journal.append("tx/start", (const uint8_t*)"s", 1, 1);
+        journal.append("tx/meter", (const uint8_t*)"meter-values", 12, 1);
+    }
+    static uint8_t image[256];
+    size_t size = readFile(SEGMENT_0, image, sizeof(image));
+    size_t first = sizeof(journal_record_header_t) + 8 + 1;
+    static uint8_t spliced[256];
+    const uint8_t torn[] = {JOURNAL_RECORD_MAGIC, JOURNAL_FLAG_QOS1, 7, 0, 40, 0, 0x12, 0x34, 't', 'x'};
+    memcpy(spliced, image, first);
+    memcpy(spliced + first, torn, sizeof(torn));
+    memcpy(spliced + first + sizeof(torn), image + first, size - first);
+    writeFile(SEGMENT_0, spliced, size + sizeof(torn));
+
+    OfflineJournal journal("/mq/t", 4);
+    journal.init();
+    char payload[16];
+
+    // Act / Assert
+    TEST_ASSERT_TRUE(journal.peek(topic, sizeof(topic), length, qos));
+    TEST_ASSERT_EQUAL_STRING("tx/start", topic);
+    journal.pop();
+
+    TEST_ASSERT_TRUE(journal.peek(topic, sizeof(topic), length, qos));
+    TEST_ASSERT_EQUAL_STRING("tx/meter", topic);
+    TEST_ASSERT_TRUE(readPayload(journal, payload, sizeof(payload)));
+    TEST_ASSERT_EQUAL_STRING("meter-values", payload);
+    journal.pop();
+
+    TEST_ASSERT_TRUE(journal.isEmpty());
+    TEST_ASSERT_EQUAL(1, journal.getStats().corrupt);
+}
+
+void test_corrupt_payload_is_not_replayed(void) {
+    // Arrange: flip one payload byte of the middle record
+    OfflineJournal journal("/mq/t", 4);
+    journal.init();
+    journal.append("a/1", (const uint8_t*)"one", 3, 1);
+    journal.append("a/2", (const uint8_t*)"two", 3, 1);
+    journal.append("a/3", (const uint8_t*)"six", 3, 1);
+    static uint8_t image[128];
+    size_t size = readFile(SEGMENT_0, image, sizeof(image));
+    image[2 * (sizeof(journal_record_header_t) + 3) + 3 + 1] ^= 0x20;
+    writeFile(SEGMENT_0, image, size);
+
+    // Act / Assert
+    TEST_ASSERT_TRUE(journal.peek(topic, sizeof(topic), length, qos));
+    TEST_ASSERT_EQUAL_STRING("a/1", topic);
+    journal.pop();
+    TEST_ASSERT_TRUE(journal.peek(topic, sizeof(topic), length, qos));
+    TEST_ASSERT_EQUAL_STRING("a/3", topic);
+    journal.pop();
+    TEST_ASSERT_TRUE(journal.isEmpty());
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_empty_journal_has_nothing_to_peek);
+    RUN_TEST(test_records_replay_in_order);
+    RUN_TEST(test_peek_without_pop_returns_same_record);
+    RUN_TEST(test_records_survive_reinit);
+    RUN_TEST(test_rolls_over_segments);
+    RUN_TEST(test_full_journal_refuses_without_touching_other_journal);
+    RUN_TEST(test_torn_append_is_cut_at_init);
+    RUN_TEST(test_torn_record_keeps_records_after_it);
+    RUN_TEST(test_corrupt_payload_is_not_replayed);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
@@ -0,0 +1,239 @@
+/**
+ * @file test_unified_config.cpp
+ * @brief Unit tests for UnifiedConfigManager persistence and JSON patches
+ */
+
+#include <unity.h>
+#include <LittleFS.h>
+#include "drivers/config/unified_config.h"
+
+static const char* SNAPSHOT_FILE = "/unified_config.bin";
+static const char* CONFIG_FILE = "/unified_config.json";
+
+void setUp(void) {
+    LittleFS.begin();
+    LittleFS.format();
+}
+
+void tearDown(void) {}
+
+static void saveTestConfig() {
+    UnifiedConfigManager writer;
+    DeviceConfig& config = writer.getMutable();
+    strncpy(config.stationId, "station-42", sizeof(config.stationId));
+    strncpy(config.mqtt.broker, "broker.example.com", sizeof(config.mqtt.broker));
+    config.mqtt.port = 8883;
+    config.meter.batchWindowMs = 2500;
+    TEST_ASSERT_TRUE(writer.save());
+}
+
+void test_save_writes_snapshot_and_json(void) {
+    // Act
+    saveTestConfig();
+
+    // Assert
+    TEST_ASSERT_TRUE(LittleFS.exists(SNAPSHOT_FILE));
+    TEST_ASSERT_TRUE(LittleFS.exists(CONFIG_FILE));
+
+    File file = LittleFS.open(SNAPSHOT_FILE, "r");
+    TEST_ASSERT_EQUAL(sizeof(config_snapshot_header_t) + sizeof(DeviceConfig), file.size());
+    file.close();
+}
+
+void test_snapshot_round_trip(void) {
+    // Arrange
+    saveTestConfig();
+    LittleFS.remove(CONFIG_FILE);   // Prove the JSON copy is not needed
+
+    // Act
+    UnifiedConfigManager reader;
+    bool loaded = reader.load();
+
+    // Assert
+    TEST_ASSERT_TRUE(loaded);
+    TEST_ASSERT_EQUAL_STRING("station-42", reader.get().stationId);
+    TEST_ASSERT_EQUAL_STRING("broker.example.com", reader.get().mqtt.broker);
+    TEST_ASSERT_EQUAL(8883, reader.get().mqtt.port);
+    TEST_ASSERT_EQUAL(2500, reader.get().meter.batchWindowMs);
+}
+
+void test_corrupt_snapshot_is_rejected(void) {
+    // Arrange: flip one byte of the image
+    saveTestConfig();
+    LittleFS.remove(CONFIG_FILE);
+
+    File file = LittleFS.open(SNAPSHOT_FILE, "r+");
+    file.seek(sizeof(config_snapshot_header_t) + 4);
+    file.write((uint8_t)'X');
+    file.close();
+
+    // Act
+    UnifiedConfigManager reader;
+    bool loaded = reader.load();
+
+    // Assert: no JSON to fall back to, defaults stay
+    TEST_ASSERT_FALSE(loaded);
+    TEST_ASSERT_EQUAL_STRING("station001", reader.get().stationId);
+}
+
+void test_snapshot_from_other_layout_is_rejected(void) {
+    // Arrange: patch the layout byte
+    saveTestConfig();
+    LittleFS.remove(CONFIG_FILE);
+
+    File file = LittleFS.open(SNAPSHOT_FILE, "r+");
+    file.seek(4);
+    file.write((uint8_t)(CONFIG_SNAPSHOT_LAYOUT + 1));
+    file.close();
+
+    // Act
+    UnifiedConfigManager reader;
+
+    // Assert
+    TEST_ASSERT_FALSE(reader.load());
+}
+
+void test_reset_snapshots_defaults(void) {
+    // Arrange
+    saveTestConfig();
+
+    // Act
+    UnifiedConfigManager manager;
+    manager.resetToDefaults();
+
+    // Assert: the new snapshot holds the defaults
+    UnifiedConfigManager reader;
+    TEST_ASSERT_TRUE(reader.load());
+    TEST_ASSERT_EQUAL_STRING("station001", reader.get().stationId);
+}
+
+void test_patch_marks_only_changed_section(void) {
+    // Arrange
+    UnifiedConfigManager manager;
+
+    // Act
+    bool ok = manager.updateFromJson("{\"meter\":{\"batchWindowMs\":2500}}");
+
+    // Assert: applied in memory, nothing written yet
+    TEST_ASSERT_TRUE(ok);
+    TEST_ASSERT_EQUAL(2500, manager.get().meter.batchWindowMs);
+    TEST_ASSERT_EQUAL_UINT8(CONFIG_SECTION_METER, manager.getDirtySections());
+    TEST_ASSERT_FALSE(LittleFS.exists(SNAPSHOT_FILE));
+}
+
+void test_patch_without_changes_stays_clean(void) {
+    // Arrange
+    UnifiedConfigManager manager;
+    uint16_t port = manager.get().mqtt.port;
+    char json[48];
+    snprintf(json, sizeof(json), "{\"mqtt\":{\"port\":%u}}", port);
+
+    // Act / Assert
+    TEST_ASSERT_TRUE(manager.updateFromJson(json));
+    TEST_ASSERT_EQUAL_UINT8(0, manager.getDirtySections());
+}
+
+void test_invalid_patch_is_rolled_back(void) {
+    // Arrange
+    UnifiedConfigManager manager;
+
+    // Act
+    bool ok = manager.updateFromJson("{\"mqtt\":{\"broker\":\"\"},\"wifi\":{\"ssid\":\"x\"}}");
+
+    // Assert
+    TEST_ASSERT_FALSE(ok);
+    TEST_ASSERT_EQUAL_STRING("localhost", manager.get().mqtt.broker);
+    TEST_ASSERT_EQUAL_STRING("", manager.get().wifi.ssid);
+    TEST_ASSERT_EQUAL_UINT8(0, manager.getDirtySections());
+}
+
+void test_burst_of_patches_is_written_once(void) {
+    // Arrange
+    UnifiedConfigManager manager;
+    manager.updateFromJson("{\"meter\":{\"batchWindowMs\":1500}}");
+    manager.updateFromJson("{\"system\":{\"heartbeatInterval\":60000}}");
+    manager.updateFromJson("{\"meter\":{\"batchWindowMs\":2500}}");
+
+    // Act: not due yet
+    manager.handle();
+    TEST_ASSERT_FALSE(LittleFS.exists(SNAPSHOT_FILE));
+
+    delay(CONFIG_SAVE_DEBOUNCE_MS);
+    manager.handle();
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT8(0, manager.getDirtySections());
+    UnifiedConfigManager reader;
+    TEST_ASSERT_TRUE(reader.load());
+    TEST_ASSERT_EQUAL(2500, reader.get().meter.batchWindowMs);
+    TEST_ASSERT_EQUAL(60000, reader.get().system.heartbeatInterval);
+}
+
+static void writeJsonFile(const char* json) {
+    File file = LittleFS.open(CONFIG_FILE, "w");
+    file.write((const uint8_t*)json, strlen(json));
+    file.close();
+}
+
+void test_unversioned_file_is_migrated(void) {
+    // Arrange: pre-version layout, identity at the top level
+    writeJsonFile("{\"stationId\":\"legacy-7\",\"binaryPayload\":true,"
+                  "\"mqtt\":{\"broker\":\"old.example.com\",\"password\":\"secret\"}}");
+
+    // Act
+    UnifiedConfigManager manager;
+    bool loaded = manager.load();
+
+    // Assert: credentials survive, migrated form is persisted
+    TEST_ASSERT_TRUE(loaded);
+    TEST_ASSERT_EQUAL_STRING("legacy-7", manager.get().stationId);
+    TEST_ASSERT_EQUAL_STRING("old.example.com", manager.get().mqtt.broker);
+    TEST_ASSERT_EQUAL_STRING("secret", manager.get().mqtt.password);
+    TEST_ASSERT_TRUE(manager.get().mqtt.binaryPayload);
+    TEST_ASSERT_TRUE(LittleFS.exists(SNAPSHOT_FILE));
+}
+
+void test_newer_file_loads_known_keys(void) {
+    // Arrange: written by a later firmware (rollback after OTA)
+    writeJsonFile("{\"version\":99,\"device\":{\"stationId\":\"next-1\"},"
+                  "\"mqtt\":{\"broker\":\"new.example.com\"},\"futureSection\":{\"x\":1}}");
+
+    // Act
+    UnifiedConfigManager manager;
+
+    // Assert
+    TEST_ASSERT_TRUE(manager.load());
+    TEST_ASSERT_EQUAL_STRING("next-1", manager.get().stationId);
+    TEST_ASSERT_EQUAL_STRING("new.example.com", manager.get().mqtt.broker);
+}
+
+void process(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_save_writes_snapshot_and_json);
+    RUN_TEST(test_snapshot_round_trip);
+    RUN_TEST(test_corrupt_snapshot_is_rejected);
+    RUN_TEST(test_snapshot_from_other_layout_is_rejected);
+    RUN_TEST(test_reset_snapshots_defaults);
+    RUN_TEST(test_patch_marks_only_changed_section);
+    RUN_TEST(test_patch_without_changes_stays_clean);
+    RUN_TEST(test_invalid_patch_is_rolled_back);
+    RUN_TEST(test_burst_of_patches_is_written_once);
+    RUN_TEST(test_unversioned_file_is_migrated);
+    RUN_TEST(test_newer_file_loads_known_keys);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
@@ -0,0 +1,232 @@
+/**
+ * @file test_auth_cache.cpp
+ * @brief Unit tests for AuthCache (local authorization list / cache)
+ */
+
+#include <unity.h>
+#include "handlers/auth_cache.h"
+#include <LittleFS.h>
+#include <string.h>
+
+static AuthCache cache;
+
+void setUp(void) {
+    cache.clear(0);
+    LittleFS.remove(AUTH_CACHE_PATH);
+}
+
+void tearDown(void) {}
+
+void test_unknown_tag_is_a_miss(void) {
+    // Arrange
+    uint32_t misses = cache.getMisses();
+
+    // Act
+    AuthResult result = cache.lookup("DEADBEEF", AUTH_ID_TAG_MAX, 0);
+
+    // Assert
+    TEST_ASSERT_EQUAL(AUTH_UNKNOWN, result.status);
+    TEST_ASSERT_EQUAL(AUTH_SOURCE_NONE, result.source);
+    TEST_ASSERT_EQUAL(misses + 1, cache.getMisses());
+}
+
+void test_remembered_answer_is_served(void) {
+    // Arrange
+    cache.remember("TAG-1", AUTH_ID_TAG_MAX, AUTH_ACCEPTED, 0, 0);
+    cache.remember("TAG-2", AUTH_ID_TAG_MAX, AUTH_BLOCKED, 0, 0);
+
+    // Act / Assert
+    TEST_ASSERT_EQUAL(AUTH_ACCEPTED, cache.lookup("TAG-1", AUTH_ID_TAG_MAX, 0).status);
+    AuthResult blocked = cache.lookup("TAG-2", AUTH_ID_TAG_MAX, 0);
+    TEST_ASSERT_EQUAL(AUTH_BLOCKED, blocked.status);
+    TEST_ASSERT_EQUAL(AUTH_SOURCE_CACHE, blocked.source);
+}
+
+void test_expired_entry_reports_expired(void) {
+    // Arrange
+    cache.remember("TAG-1", AUTH_ID_TAG_MAX, AUTH_ACCEPTED, 1000, 0);
+
+    // Act / Assert: clock unknown -> stored status, past expiry -> expired
+    TEST_ASSERT_EQUAL(AUTH_ACCEPTED, cache.lookup("TAG-1", AUTH_ID_TAG_MAX, 0).status);
+    TEST_ASSERT_EQUAL(AUTH_ACCEPTED, cache.lookup("TAG-1", AUTH_ID_TAG_MAX, 999).status);
+    TEST_ASSERT_EQUAL(AUTH_EXPIRED, cache.lookup("TAG-1", AUTH_ID_TAG_MAX, 1000).status);
+}
+
+void test_list_entry_wins_over_cache(void) {
+    // Arrange
+    cache.beginListUpdate(true, 1, 0);
+    cache.setListEntry("TAG-1", AUTH_ID_TAG_MAX, AUTH_BLOCKED, 0, 0);
+
+    // Act: a stale backend answer must not override the list
+    cache.remember("TAG-1", AUTH_ID_TAG_MAX, AUTH_ACCEPTED, 0, 0);
+
+    // Assert
+    AuthResult result = cache.lookup("TAG-1", AUTH_ID_TAG_MAX, 0);
+    TEST_ASSERT_EQUAL(AUTH_BLOCKED, result.status);
+    TEST_ASSERT_EQUAL(AUTH_SOURCE_LIST, result.source);
+}
+
+void test_full_update_replaces_list_and_keeps_cache(void) {
+    // Arrange
+    cache.remember("CACHED", AUTH_ID_TAG_MAX, AUTH_ACCEPTED, 0, 0);
+    cache.beginListUpdate(true, 1, 0);
+    cache.setListEntry("OLD", AUTH_ID_TAG_MAX, AUTH_ACCEPTED, 0, 0);
+
+    // Act
+    cache.beginListUpdate(true, 2, 0);
+    cache.setListEntry("NEW", AUTH_ID_TAG_MAX, AUTH_ACCEPTED, 0, 0);
+
+    // Assert
+    TEST_ASSERT_EQUAL(AUTH_UNKNOWN, cache.lookup("OLD", AUTH_ID_TAG_MAX, 0).status);
+    TEST_ASSERT_EQUAL(AUTH_ACCEPTED, cache.lookup("NEW", AUTH_ID_TAG_MAX, 0).status);
+    TEST_ASSERT_EQUAL(AUTH_ACCEPTED, cache.lookup("CACHED", AUTH_ID_TAG_MAX, 0).status);
+    TEST_ASSERT_EQUAL(2, cache.getListVersion());
+}
+
+void test_differential_removes_entry(void) {
+    // Arrange
+    cache.beginListUpdate(true, 1, 0);
+    cache.setListEntry("TAG-1", AUTH_ID_TAG_MAX, AUTH_ACCEPTED, 0, 0);
+
+    // Act
+    cache.beginListUpdate(false, 2, 0);
+    cache.removeListEntry("TAG-1", AUTH_ID_TAG_MAX, 0);
+
+    // Assert
+    TEST_ASSERT_EQUAL(AUTH_UNKNOWN, cache.lookup("TAG-1", AUTH_ID_TAG_MAX, 0).status);
+    TEST_ASSERT_EQUAL(0, cache.size());
+}
+
+void test_full_table_evicts_cache_entry_expiring_first(void) {
+    // Arrange: one list entry, the rest cached answers
+    char tag[AUTH_ID_TAG_MAX];
+    cache.setListEntry("LIST", AUTH_ID_TAG_MAX, AUTH_ACCEPTED, 0, 0);
+    for (uint16_t i = 1; i < AUTH_CACHE_MAX_ENTRIES; i++) {
+        snprintf(tag, sizeof(tag), "TAG-%u", i);
+        cache.remember(tag, AUTH_ID_TAG_MAX, AUTH_ACCEPTED, 5000 + i, 0);
+    }
+
+    // Act
+    bool stored = cache.remember("EXTRA", AUTH_ID_TAG_MAX, AUTH_ACCEPTED, 0, 0);
+
+    // Assert: TAG-1 expired first and made room
+    TEST_ASSERT_TRUE(stored);
+    TEST_ASSERT_EQUAL(AUTH_CACHE_MAX_ENTRIES, cache.size());
+    TEST_ASSERT_EQUAL(AUTH_UNKNOWN, cache.lookup("TAG-1", AUTH_ID_TAG_MAX, 0).status);
+    TEST_ASSERT_EQUAL(AUTH_ACCEPTED, cache.lookup("TAG-2", AUTH_ID_TAG_MAX, 0).status);
+    TEST_ASSERT_EQUAL(AUTH_ACCEPTED, cache.lookup("LIST", AUTH_ID_TAG_MAX, 0).status);
+}
+
+void test_table_survives_save_and_load(void) {
+    // Arrange
+    cache.beginListUpdate(true, 7, 0);
+    cache.setListEntry("TAG-1", AUTH_ID_TAG_MAX, AUTH_ACCEPTED, 0, 0);
+    cache.remember("TAG-2", AUTH_ID_TAG_MAX, AUTH_BLOCKED, 0, 0);
+
+    // Act: debounced write, then a fresh instance reads it back
+    cache.handle(AUTH_CACHE_SAVE_DELAY_MS - 1);
+    TEST_ASSERT_TRUE(cache.isDirty());
+    cache.handle(AUTH_CACHE_SAVE_DELAY_MS);
+    TEST_ASSERT_FALSE(cache.isDirty());
+
+    AuthCache reloaded;
+    bool loaded = reloaded.load();
+
+    // Assert
+    TEST_ASSERT_TRUE(loaded);
+    TEST_ASSERT_EQUAL(2, reloaded.size());
+    TEST_ASSERT_EQUAL(7, reloaded.getListVersion());
+    TEST_ASSERT_EQUAL(AUTH_BLOCKED, reloaded.lookup("TAG-2", AUTH_ID_TAG_MAX, 0).status);
+}
+
+void test_tag_hash_stops_at_terminator(void) {
+    // Arrange: UART payloads are NUL-padded to 20 bytes
+    char padded[AUTH_ID_TAG_MAX] = "TAG-1";
+
+    // Act / Assert
+    TEST_ASSERT_EQUAL(AuthCache::hashTag("TAG-1", AUTH_ID_TAG_MAX),
+                      AuthCache::hashTag(padded, sizeof(padded)));
+}
+
+void test_colliding_tag_is_not_accepted(void) {
+    // Arrange: two tags with the same FNV-1a hash
+    TEST_ASSERT_EQUAL(AuthCache::hashTag("TAG-000688F", AUTH_ID_TAG_MAX),
+                      AuthCache::hashTag("TAG-00419B0", AUTH_ID_TAG_MAX));
+    cache.setListEntry("TAG-000688F", AUTH_ID_TAG_MAX, AUTH_ACCEPTED, 0, 0);
+
+    // Act
+    AuthResult other = cache.lookup("TAG-00419B0", AUTH_ID_TAG_MAX, 0);
+    cache.remember("TAG-00419B0", AUTH_ID_TAG_MAX, AUTH_BLOCKED, 0, 0);
+
+    // Assert: separate entries, each with its own status
+    TEST_ASSERT_EQUAL(AUTH_UNKNOWN, other.status);
+    TEST_ASSERT_EQUAL(2, cache.size());
+    TEST_ASSERT_EQUAL(AUTH_ACCEPTED, cache.lookup("TAG-000688F", AUTH_ID_TAG_MAX, 0).status);
+    TEST_ASSERT_EQUAL(AUTH_BLOCKED, cache.lookup("TAG-00419B0", AUTH_ID_TAG_MAX, 0).status);
+}
+
+void test_save_waits_for_last_change(void) {
+    // Arrange: clear() in setUp left the table dirty at 0
+    cache.handle(AUTH_CACHE_SAVE_DELAY_MS);
+    cache.remember("TAG-1", AUTH_ID_TAG_MAX, AUTH_ACCEPTED, 0, 100000);
+
+    // Act / Assert: a second change restarts the delay
+    cache.remember("TAG-2", AUTH_ID_TAG_MAX, AUTH_ACCEPTED, 0, 104000);
+    cache.handle(100000 + AUTH_CACHE_SAVE_DELAY_MS);
+    TEST_ASSERT_TRUE(cache.isDirty());
+    cache.handle(104000 + AUTH_CACHE_SAVE_DELAY_MS);
+    TEST_ASSERT_FALSE(cache.isDirty());
+}
+
+void test_steady_changes_are_saved_after_max_delay(void) {
+    // Arrange
+    char tag[AUTH_ID_TAG_MAX];
+    cache.handle(AUTH_CACHE_SAVE_DELAY_MS);
+    uint32_t start = 100000;
+
+    // Act: one change per second never leaves a quiet gap
+    uint32_t now = start;
+    for (uint16_t i = 0; now - start < AUTH_CACHE_SAVE_MAX_DELAY_MS; i++, now += 1000) {
+        snprintf(tag, sizeof(tag), "TAG-%u", i);
+        cache.remember(tag, AUTH_ID_TAG_MAX, AUTH_ACCEPTED, 0, now);
+        cache.handle(now);
+    }
+    cache.handle(now);
+
+    // Assert
+    TEST_ASSERT_FALSE(cache.isDirty());
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_unknown_tag_is_a_miss);
+    RUN_TEST(test_remembered_answer_is_served);
+    RUN_TEST(test_expired_entry_reports_expired);
+    RUN_TEST(test_list_entry_wins_over_cache);
+    RUN_TEST(test_full_update_replaces_list_and_keeps_cache);
+    RUN_TEST(test_differential_removes_entry);
+    RUN_TEST(test_full_table_evicts_cache_entry_expiring_first);
+    RUN_TEST(test_table_survives_save_and_load);
+    RUN_TEST(test_tag_hash_stops_at_terminator);
+    RUN_TEST(test_colliding_tag_is_not_accepted);
+    RUN_TEST(test_save_waits_for_last_change);
+    RUN_TEST(test_steady_changes_are_saved_after_max_delay);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    LittleFS.begin();
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
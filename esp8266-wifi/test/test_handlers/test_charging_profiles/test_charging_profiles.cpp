@@ -0,0 +1,243 @@
+/**
+ * @file test_charging_profiles.cpp
+ * @brief Unit tests for ChargingProfileEngine (composite limits, timeline)
+ */
+
+#include <unity.h>
+#include "handlers/charging_profiles.h"
+#include <LittleFS.h>
+#include <string.h>
+
+#define NOW 1700000000UL
+
+static ChargingProfileEngine engine;
+static ConnectorStateTable states;
+
+static charging_profile_t makeProfile(int32_t id, uint8_t connectorId, uint8_t purpose,
+                                      uint8_t stackLevel, uint16_t limit) {
+    charging_profile_t profile;
+    memset(&profile, 0, sizeof(profile));
+    profile.id = id;
+    profile.connectorId = connectorId;
+    profile.purpose = purpose;
+    profile.stackLevel = stackLevel;
+    profile.kind = CHARGING_KIND_ABSOLUTE;
+    profile.startSchedule = NOW - 60;
+    profile.periodCount = 1;
+    profile.periods[0].startPeriod = 0;
+    profile.periods[0].limit = limit;
+    return profile;
+}
+
+void setUp(void) {
+    engine.clear(-1, -1, -1, -1);
+    states.reset();
+    LittleFS.remove(CHARGING_PROFILE_PATH);
+}
+
+void tearDown(void) {}
+
+void test_tx_default_limit_applies(void) {
+    // Arrange
+    states.update(1, CONNECTOR_AVAILABLE, ERROR_NO_ERROR, 0);
+    engine.install(makeProfile(1, 0, CHARGING_PURPOSE_TX_DEFAULT, 0, 160));
+
+    // Act
+    engine.tick(NOW, states);
+
+    // Assert
+    TEST_ASSERT_EQUAL(160, engine.currentLimit(1));
+    TEST_ASSERT_EQUAL(CHARGING_NO_LIMIT, engine.currentLimit(2));   // Not reported
+}
+
+void test_higher_stack_level_wins(void) {
+    // Arrange
+    states.update(1, CONNECTOR_AVAILABLE, ERROR_NO_ERROR, 0);
+    engine.install(makeProfile(1, 1, CHARGING_PURPOSE_TX_DEFAULT, 0, 320));
+    engine.install(makeProfile(2, 1, CHARGING_PURPOSE_TX_DEFAULT, 3, 100));
+
+    // Act
+    engine.tick(NOW, states);
+
+    // Assert
+    TEST_ASSERT_EQUAL(100, engine.currentLimit(1));
+}
+
+void test_site_limit_is_water_filled(void) {
+    // Arrange: 32 A site, connector 1 limited to 6 A by its own profile
+    states.update(1, CONNECTOR_CHARGING, ERROR_NO_ERROR, 0);
+    states.update(2, CONNECTOR_CHARGING, ERROR_NO_ERROR, 0);
+    states.update(3, CONNECTOR_CHARGING, ERROR_NO_ERROR, 0);
+    engine.install(makeProfile(1, 0, CHARGING_PURPOSE_CP_MAX, 0, 320));
+    engine.install(makeProfile(2, 1, CHARGING_PURPOSE_TX_DEFAULT, 0, 60));
+
+    // Act
+    engine.tick(NOW, states);
+
+    // Assert: the 10 A connector 1 leaves unused goes to the others
+    TEST_ASSERT_EQUAL(60, engine.currentLimit(1));
+    TEST_ASSERT_EQUAL(130, engine.currentLimit(2));
+    TEST_ASSERT_EQUAL(130, engine.currentLimit(3));
+}
+
+void test_connector_start_reshares_site_limit(void) {
+    // Arrange
+    states.update(1, CONNECTOR_CHARGING, ERROR_NO_ERROR, 0);
+    states.update(2, CONNECTOR_AVAILABLE, ERROR_NO_ERROR, 0);
+    engine.install(makeProfile(1, 0, CHARGING_PURPOSE_CP_MAX, 0, 320));
+    engine.tick(NOW, states);
+    TEST_ASSERT_EQUAL(320, engine.currentLimit(1));
+
+    // Act
+    states.update(2, CONNECTOR_CHARGING, ERROR_NO_ERROR, 0);
+    engine.tick(NOW + 1, states);
+
+    // Assert
+    TEST_ASSERT_EQUAL(160, engine.currentLimit(1));
+    TEST_ASSERT_EQUAL(160, engine.currentLimit(2));
+}
+
+void test_recurring_daily_period_boundary(void) {
+    // Arrange: 32 A from the cycle start, 10 A after one hour
+    states.update(1, CONNECTOR_AVAILABLE, ERROR_NO_ERROR, 0);
+    charging_profile_t profile = makeProfile(1, 1, CHARGING_PURPOSE_TX_DEFAULT, 0, 320);
+    profile.kind = CHARGING_KIND_RECURRING;
+    profile.recurrency = CHARGING_RECUR_DAILY;
+    profile.startSchedule = NOW - 86400UL * 3;
+    profile.periodCount = 2;
+    profile.periods[1].startPeriod = 3600;
+    profile.periods[1].limit = 100;
+    engine.install(profile);
+
+    // Act / Assert: each day repeats without a new evaluation
+    engine.tick(NOW + 3599, states);
+    TEST_ASSERT_EQUAL(320, engine.currentLimit(1));
+    uint32_t evaluations = engine.getEvaluations();
+
+    engine.tick(NOW + 3600, states);
+    TEST_ASSERT_EQUAL(100, engine.currentLimit(1));
+    TEST_ASSERT_EQUAL(evaluations, engine.getEvaluations());
+
+    engine.tick(NOW + 86400, states);
+    TEST_ASSERT_EQUAL(320, engine.currentLimit(1));
+}
+
+void test_only_changes_are_sent(void) {
+    // Arrange
+    states.update(1, CONNECTOR_AVAILABLE, ERROR_NO_ERROR, 0);
+    charging_profile_t profile = makeProfile(1, 1, CHARGING_PURPOSE_TX_DEFAULT, 0, 160);
+    profile.periodCount = 2;
+    profile.periods[1].startPeriod = 660;
+    profile.periods[1].limit = 80;
+    engine.install(profile);
+    engine.tick(NOW, states);
+
+    // Act
+    ChargingLimitChange change;
+    TEST_ASSERT_TRUE(engine.nextChange(change));
+    engine.markSent(change);
+
+    // Assert: valid until the next period, then silent until it starts
+    TEST_ASSERT_EQUAL(1, change.connectorId);
+    TEST_ASSERT_EQUAL(160, change.limit);
+    TEST_ASSERT_EQUAL(600, change.validFor);
+    engine.tick(NOW + 1, states);
+    TEST_ASSERT_FALSE(engine.nextChange(change));
+
+    engine.tick(NOW + 600, states);
+    TEST_ASSERT_TRUE(engine.nextChange(change));
+    TEST_ASSERT_EQUAL(80, change.limit);
+}
+
+void test_resend_all_after_stm32_restart(void) {
+    // Arrange
+    states.update(1, CONNECTOR_AVAILABLE, ERROR_NO_ERROR, 0);
+    engine.install(makeProfile(1, 1, CHARGING_PURPOSE_TX_DEFAULT, 0, 160));
+    engine.tick(NOW, states);
+    ChargingLimitChange change;
+    while (engine.nextChange(change)) engine.markSent(change);
+
+    // Act
+    engine.resendAll();
+
+    // Assert
+    TEST_ASSERT_TRUE(engine.nextChange(change));
+    TEST_ASSERT_EQUAL(160, change.limit);
+}
+
+void test_tx_profile_ends_with_charging(void) {
+    // Arrange
+    states.update(1, CONNECTOR_CHARGING, ERROR_NO_ERROR, 0);
+    engine.install(makeProfile(1, 0, CHARGING_PURPOSE_TX_DEFAULT, 0, 320));
+    engine.install(makeProfile(2, 1, CHARGING_PURPOSE_TX, 0, 60));
+    engine.tick(NOW, states);
+    TEST_ASSERT_EQUAL(60, engine.currentLimit(1));
+
+    // Act
+    states.update(1, CONNECTOR_FINISHING, ERROR_NO_ERROR, 0);
+    engine.tick(NOW + 1, states);
+
+    // Assert
+    TEST_ASSERT_EQUAL(1, engine.size());
+    TEST_ASSERT_EQUAL(320, engine.currentLimit(1));
+}
+
+void test_same_stack_level_replaces(void) {
+    // Arrange
+    engine.install(makeProfile(1, 1, CHARGING_PURPOSE_TX_DEFAULT, 2, 160));
+
+    // Act
+    engine.install(makeProfile(9, 1, CHARGING_PURPOSE_TX_DEFAULT, 2, 100));
+
+    // Assert
+    TEST_ASSERT_EQUAL(1, engine.size());
+    TEST_ASSERT_EQUAL(9, engine.get(0)->id);
+}
+
+void test_profiles_survive_save_and_load(void) {
+    // Arrange
+    engine.install(makeProfile(1, 0, CHARGING_PURPOSE_CP_MAX, 0, 320));
+    engine.install(makeProfile(2, 1, CHARGING_PURPOSE_TX_DEFAULT, 1, 100));
+
+    // Act
+    engine.handle();
+    ChargingProfileEngine reloaded;
+    bool loaded = reloaded.load();
+
+    // Assert
+    TEST_ASSERT_TRUE(loaded);
+    TEST_ASSERT_EQUAL(2, reloaded.size());
+    TEST_ASSERT_EQUAL(100, reloaded.get(1)->periods[0].limit);
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_tx_default_limit_applies);
+    RUN_TEST(test_higher_stack_level_wins);
+    RUN_TEST(test_site_limit_is_water_filled);
+    RUN_TEST(test_connector_start_reshares_site_limit);
+    RUN_TEST(test_recurring_daily_period_boundary);
+    RUN_TEST(test_only_changes_are_sent);
+    RUN_TEST(test_resend_all_after_stm32_restart);
+    RUN_TEST(test_tx_profile_ends_with_charging);
+    RUN_TEST(test_same_stack_level_replaces);
+    RUN_TEST(test_profiles_survive_save_and_load);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    LittleFS.begin();
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
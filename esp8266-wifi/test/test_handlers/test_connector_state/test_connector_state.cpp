@@ -0,0 +1,143 @@
+/**
+ * @file test_connector_state.cpp
+ * @brief Unit tests for ConnectorStateTable
+ */
+
+#include <unity.h>
+#include "handlers/connector_state.h"
+#include "utils/json_writer.h"
+#include <string.h>
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_first_report_is_published(void) {
+    // Arrange
+    ConnectorStateTable states;
+
+    // Act
+    bool publish = states.update(1, CONNECTOR_AVAILABLE, ERROR_NO_ERROR, 100);
+
+    // Assert
+    TEST_ASSERT_TRUE(publish);
+    const ConnectorState* state = states.get(1);
+    TEST_ASSERT_NOT_NULL(state);
+    TEST_ASSERT_EQUAL(CONNECTOR_AVAILABLE, state->status);
+    TEST_ASSERT_EQUAL(100, state->changedAt);
+}
+
+void test_repeat_is_suppressed(void) {
+    // Arrange
+    ConnectorStateTable states;
+    states.update(1, CONNECTOR_CHARGING, ERROR_NO_ERROR, 100);
+
+    // Act
+    bool publish = states.update(1, CONNECTOR_CHARGING, ERROR_NO_ERROR, 200);
+
+    // Assert
+    TEST_ASSERT_FALSE(publish);
+    TEST_ASSERT_EQUAL(1, states.getSuppressedCount());
+    TEST_ASSERT_EQUAL(100, states.get(1)->changedAt);
+}
+
+void test_error_code_change_is_published(void) {
+    // Arrange
+    ConnectorStateTable states;
+    states.update(2, CONNECTOR_FAULTED, ERROR_GROUND_FAILURE, 100);
+
+    // Act / Assert
+    TEST_ASSERT_TRUE(states.update(2, CONNECTOR_FAULTED, ERROR_OVER_VOLTAGE, 200));
+    TEST_ASSERT_EQUAL(ERROR_OVER_VOLTAGE, states.get(2)->errorCode);
+}
+
+void test_failed_publish_is_retried(void) {
+    // Arrange
+    ConnectorStateTable states;
+    states.update(1, CONNECTOR_PREPARING, ERROR_NO_ERROR, 100);
+    states.markUnpublished(1);
+
+    // Act: same state again
+    bool publish = states.update(1, CONNECTOR_PREPARING, ERROR_NO_ERROR, 200);
+
+    // Assert: sent, then suppressed again
+    TEST_ASSERT_TRUE(publish);
+    TEST_ASSERT_EQUAL(100, states.get(1)->changedAt);
+    TEST_ASSERT_FALSE(states.update(1, CONNECTOR_PREPARING, ERROR_NO_ERROR, 300));
+}
+
+void test_out_of_range_connector_passes_through(void) {
+    // Arrange
+    ConnectorStateTable states;
+
+    // Act / Assert: never cached, never suppressed
+    TEST_ASSERT_TRUE(states.update(CONNECTOR_STATE_SLOTS, CONNECTOR_AVAILABLE, ERROR_NO_ERROR, 0));
+    TEST_ASSERT_TRUE(states.update(CONNECTOR_STATE_SLOTS, CONNECTOR_AVAILABLE, ERROR_NO_ERROR, 0));
+    TEST_ASSERT_NULL(states.get(CONNECTOR_STATE_SLOTS));
+    TEST_ASSERT_EQUAL(-1, states.highestKnown());
+}
+
+void test_snapshot_lists_known_connectors(void) {
+    // Arrange
+    ConnectorStateTable states;
+    states.update(0, CONNECTOR_AVAILABLE, ERROR_NO_ERROR, 0);
+    states.update(2, CONNECTOR_CHARGING, ERROR_NO_ERROR, 0);
+
+    char buffer[128];
+    JsonWriter w(buffer, sizeof(buffer));
+
+    // Act
+    w.beginObject();
+    states.writeArray(w, "connectors");
+    w.endObject();
+    size_t length = w.length();
+
+    // Assert
+    TEST_ASSERT_EQUAL(2, states.highestKnown());
+    TEST_ASSERT_EQUAL(strlen(buffer), length);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"connectors\":[{\"id\":0,\"status\":0,\"errorCode\":0},"
+        "{\"id\":2,\"status\":2,\"errorCode\":0}]}", buffer);
+}
+
+void test_session_active_tracks_connector_status(void) {
+    // Arrange: connector 0 is the charge point, not a session
+    ConnectorStateTable states;
+    states.update(0, CONNECTOR_CHARGING, ERROR_NO_ERROR, 0);
+    states.update(1, CONNECTOR_AVAILABLE, ERROR_NO_ERROR, 0);
+    TEST_ASSERT_FALSE(states.sessionActive());
+
+    // Act / Assert
+    states.update(1, CONNECTOR_SUSPENDED_EV, ERROR_NO_ERROR, 0);
+    TEST_ASSERT_TRUE(states.sessionActive());
+    states.update(1, CONNECTOR_FAULTED, ERROR_NO_ERROR, 0);
+    TEST_ASSERT_FALSE(states.sessionActive());
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_first_report_is_published);
+    RUN_TEST(test_repeat_is_suppressed);
+    RUN_TEST(test_error_code_change_is_published);
+    RUN_TEST(test_failed_publish_is_retried);
+    RUN_TEST(test_out_of_range_connector_passes_through);
+    RUN_TEST(test_snapshot_lists_known_connectors);
+    RUN_TEST(test_session_active_tracks_connector_status);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
@@ -7,6 +7,7 @@
 #include "handlers/heartbeat_handler.h"
 #include "test_mocks/mock_mqtt_client.h"
 #include "test_mocks/mock_wifi_manager.h"
+#include <string.h>
 
 void setUp(void) {
     // Called before each test
@@ -64,12 +65,65 @@ void test_heartbeat_fails_when_mqtt_disconnected(void) {
     TEST_ASSERT_FALSE(result);
 }
 
+static DeviceConfig coalesceConfig(bool coalesce) {
+    DeviceConfig config;
+    memset(&config, 0, sizeof(config));
+    config.system.heartbeatInterval = 30000;
+    config.system.heartbeatCoalesce = coalesce;
+    return config;
+}
+
+void test_heartbeat_waits_for_interval(void) {
+    // Arrange
+    DeviceConfig config = coalesceConfig(false);
+
+    // Act / Assert
+    TEST_ASSERT_EQUAL(HeartbeatAction::WAIT, HeartbeatHandler::decide(config, 40000, 10000, 0, 10000));
+    TEST_ASSERT_EQUAL(HeartbeatAction::SEND, HeartbeatHandler::decide(config, 40001, 10000, 0, 10000));
+}
+
+void test_heartbeat_sent_despite_traffic_without_coalesce(void) {
+    // Arrange
+    DeviceConfig config = coalesceConfig(false);
+
+    // Act
+    HeartbeatAction action = HeartbeatHandler::decide(config, 40001, 10000, 39000, 10000);
+
+    // Assert
+    TEST_ASSERT_EQUAL(HeartbeatAction::SEND, action);
+}
+
+void test_heartbeat_coalesced_after_recent_publish(void) {
+    // Arrange
+    DeviceConfig config = coalesceConfig(true);
+
+    // Act / Assert: meter publish 1 s ago proves liveness, 31 s ago does not
+    TEST_ASSERT_EQUAL(HeartbeatAction::COALESCE, HeartbeatHandler::decide(config, 40001, 10000, 39001, 10000));
+    TEST_ASSERT_EQUAL(HeartbeatAction::SEND, HeartbeatHandler::decide(config, 40001, 10000, 9000, 10000));
+}
+
+void test_coalesced_heartbeat_sent_when_fields_stale(void) {
+    // Arrange: fields last reported more than HEARTBEAT_COALESCE_MAX intervals ago
+    DeviceConfig config = coalesceConfig(true);
+    uint32_t now = 30000UL * HEARTBEAT_COALESCE_MAX + 50001;
+
+    // Act
+    HeartbeatAction action = HeartbeatHandler::decide(config, now, now - 30001, now - 1000, 50000);
+
+    // Assert
+    TEST_ASSERT_EQUAL(HeartbeatAction::SEND, action);
+}
+
 void process(void) {
     UNITY_BEGIN();
 
     RUN_TEST(test_heartbeat_publishes_correct_format);
     RUN_TEST(test_heartbeat_includes_uptime);
     RUN_TEST(test_heartbeat_fails_when_mqtt_disconnected);
+    RUN_TEST(test_heartbeat_waits_for_interval);
+    RUN_TEST(test_heartbeat_sent_despite_traffic_without_coalesce);
+    RUN_TEST(test_heartbeat_coalesced_after_recent_publish);
+    RUN_TEST(test_coalesced_heartbeat_sent_when_fields_stale);
 
     UNITY_END();
 }
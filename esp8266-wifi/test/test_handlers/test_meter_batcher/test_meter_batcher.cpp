@@ -0,0 +1,170 @@
+/**
+ * @file test_meter_batcher.cpp
+ * @brief Unit tests for MeterBatcher
+ */
+
+#include <unity.h>
+#include "handlers/meter_batcher.h"
+#include <string.h>
+
+static DeviceConfig config;
+
+static meter_values_t makeMeter(uint8_t connectorId, uint32_t energy) {
+    meter_values_t meter;
+    memset(&meter, 0, sizeof(meter));
+    snprintf(meter.msg_id, sizeof(meter.msg_id), "M%u", connectorId);
+    strcpy(meter.timestamp, "1700000000");
+    meter.connector_id = connectorId;
+    meter.transaction_id = 7;
+    meter.sample.energy_wh = energy;
+    return meter;
+}
+
+void setUp(void) {
+    memset(&config, 0, sizeof(config));
+    config.meter.batchEnabled = true;
+    config.meter.batchWindowMs = 1000;
+    config.meter.batchMaxSamples = 3;
+}
+
+void tearDown(void) {}
+
+void test_empty_batch_is_not_due(void) {
+    // Arrange
+    MeterBatcher batcher;
+
+    // Act / Assert
+    TEST_ASSERT_FALSE(batcher.isDue(config, 5000));
+    TEST_ASSERT_EQUAL(0, batcher.serialize(nullptr, 0));
+}
+
+void test_due_after_window(void) {
+    // Arrange
+    MeterBatcher batcher;
+    meter_values_t meter = makeMeter(1, 100);
+    batcher.add(meter, 1000);
+
+    // Act / Assert
+    TEST_ASSERT_FALSE(batcher.isDue(config, 1999));
+    TEST_ASSERT_TRUE(batcher.isDue(config, 2000));
+}
+
+void test_due_at_max_samples(void) {
+    // Arrange
+    MeterBatcher batcher;
+    for (uint8_t i = 1; i <= 3; i++) {
+        meter_values_t meter = makeMeter(i, 100);
+        batcher.add(meter, 1000);
+    }
+
+    // Act / Assert
+    TEST_ASSERT_EQUAL(3, batcher.pending());
+    TEST_ASSERT_TRUE(batcher.isDue(config, 1000));
+}
+
+void test_add_rejects_when_full(void) {
+    // Arrange
+    MeterBatcher batcher;
+    meter_values_t meter = makeMeter(1, 100);
+    for (uint8_t i = 0; i < METER_BATCH_MAX_SAMPLES; i++) {
+        batcher.add(meter, 0);
+    }
+
+    // Act
+    bool added = batcher.add(meter, 0);
+
+    // Assert
+    TEST_ASSERT_FALSE(added);
+    TEST_ASSERT_EQUAL(METER_BATCH_MAX_SAMPLES, batcher.pending());
+}
+
+void test_serialize_shares_timestamp_base(void) {
+    // Arrange
+    MeterBatcher batcher;
+    meter_values_t first = makeMeter(1, 100);
+    meter_values_t second = makeMeter(2, 200);
+    batcher.add(first, 1000);
+    batcher.add(second, 1250);
+    char payload[METER_BATCH_PAYLOAD_SIZE];
+
+    // Act
+    size_t length = batcher.serialize(payload, sizeof(payload));
+
+    // Assert
+    TEST_ASSERT_EQUAL(strlen(payload), length);
+    TEST_ASSERT_EQUAL(0, strncmp(payload, "{\"msgId\":\"M1\",\"timestamp\":\"1700000000\",\"samples\":[{\"connectorId\":1,", 67));
+    TEST_ASSERT_NOT_NULL(strstr(payload, "{\"connectorId\":2,\"transactionId\":7,\"offsetMs\":250,\"energy_wh\":200,"));
+}
+
+void test_full_batch_fits_payload_buffer(void) {
+    // Arrange: worst-case values in every field
+    MeterBatcher batcher;
+    meter_values_t meter = makeMeter(255, 0xFFFFFFFF);
+    memset(meter.msg_id, 'x', sizeof(meter.msg_id) - 1);
+    memset(meter.timestamp, '9', sizeof(meter.timestamp) - 1);
+    meter.transaction_id = 0xFFFFFFFF;
+    meter.sample.power_w = 0xFFFF;
+    meter.sample.voltage_v = 0xFFFF;
+    meter.sample.current_a = 0xFFFF;
+    meter.sample.frequency_hz = 0xFFFF;
+    meter.sample.temperature_c = -32768;
+    meter.sample.power_factor_pct = 255;
+    for (uint8_t i = 0; i < METER_BATCH_MAX_SAMPLES; i++) {
+        batcher.add(meter, i == 0 ? 0 : 0xFFFFFFFF);
+    }
+    char payload[METER_BATCH_PAYLOAD_SIZE];
+
+    // Act
+    size_t length = batcher.serialize(payload, sizeof(payload));
+
+    // Assert
+    TEST_ASSERT_TRUE(length > 0);
+}
+
+void test_serialize_appends_device_fields(void) {
+    // Arrange: worst-case batch plus heartbeat fields (heartbeatPiggyback)
+    MeterBatcher batcher;
+    meter_values_t meter = makeMeter(1, 0xFFFFFFFF);
+    memset(meter.msg_id, 'x', sizeof(meter.msg_id) - 1);
+    meter.transaction_id = 0xFFFFFFFF;
+    for (uint8_t i = 0; i < METER_BATCH_MAX_SAMPLES; i++) {
+        batcher.add(meter, i == 0 ? 0 : 0xFFFFFFFF);
+    }
+    HeartbeatFields device = {0xFFFFFFFF, -128, 0xFFFFFFFF, 100, true, 0xFFFFFFFF, 0xFFFFFFFF};
+    char payload[METER_BATCH_PAYLOAD_SIZE];
+
+    // Act
+    size_t length = batcher.serialize(payload, sizeof(payload), &device);
+
+    // Assert
+    TEST_ASSERT_TRUE(length > 0);
+    TEST_ASSERT_NOT_NULL(strstr(payload, "],\"device\":{\"uptime\":4294967295,\"rssi\":-128,"));
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_empty_batch_is_not_due);
+    RUN_TEST(test_due_after_window);
+    RUN_TEST(test_due_at_max_samples);
+    RUN_TEST(test_add_rejects_when_full);
+    RUN_TEST(test_serialize_shares_timestamp_base);
+    RUN_TEST(test_full_batch_fits_payload_buffer);
+    RUN_TEST(test_serialize_appends_device_fields);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
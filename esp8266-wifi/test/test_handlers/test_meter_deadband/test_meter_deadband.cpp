@@ -0,0 +1,143 @@
+/**
+ * @file test_meter_deadband.cpp
+ * @brief Unit tests for MeterDeadband
+ */
+
+#include <unity.h>
+#include "handlers/meter_deadband.h"
+#include <string.h>
+
+static DeviceConfig config;
+static meter_values_t meter;
+
+void setUp(void) {
+    memset(&config, 0, sizeof(config));
+    config.meter.deadbandEnabled = true;
+    config.meter.keyframeIntervalMs = 60000;
+    config.meter.deadband.energyWh = 10;
+    config.meter.deadband.powerW = 50;
+    config.meter.deadband.voltageV = 2;
+
+    memset(&meter, 0, sizeof(meter));
+    meter.connector_id = 1;
+    meter.transaction_id = 5;
+    meter.sample.energy_wh = 1000;
+    meter.sample.power_w = 3000;
+    meter.sample.voltage_v = 230;
+}
+
+void tearDown(void) {}
+
+void test_first_sample_is_reported(void) {
+    // Arrange
+    MeterDeadband deadband;
+
+    // Act / Assert
+    TEST_ASSERT_TRUE(deadband.shouldReport(meter, config, 0));
+}
+
+void test_small_change_is_suppressed(void) {
+    // Arrange
+    MeterDeadband deadband;
+    deadband.shouldReport(meter, config, 0);
+    meter.sample.voltage_v = 231;
+    meter.sample.energy_wh = 1005;
+
+    // Act
+    bool report = deadband.shouldReport(meter, config, 1000);
+
+    // Assert
+    TEST_ASSERT_FALSE(report);
+    TEST_ASSERT_EQUAL(1, deadband.getSuppressedCount());
+}
+
+void test_change_past_deadband_is_reported(void) {
+    // Arrange
+    MeterDeadband deadband;
+    deadband.shouldReport(meter, config, 0);
+    meter.sample.voltage_v = 228;
+
+    // Act / Assert
+    TEST_ASSERT_TRUE(deadband.shouldReport(meter, config, 1000));
+}
+
+void test_drift_is_measured_from_last_reported(void) {
+    // Arrange: two sub-deadband steps add up past it
+    MeterDeadband deadband;
+    deadband.shouldReport(meter, config, 0);
+    meter.sample.power_w = 3030;
+    TEST_ASSERT_FALSE(deadband.shouldReport(meter, config, 1000));
+    meter.sample.power_w = 3060;
+
+    // Act / Assert
+    TEST_ASSERT_TRUE(deadband.shouldReport(meter, config, 2000));
+}
+
+void test_keyframe_after_interval(void) {
+    // Arrange
+    MeterDeadband deadband;
+    deadband.shouldReport(meter, config, 0);
+
+    // Act / Assert
+    TEST_ASSERT_FALSE(deadband.shouldReport(meter, config, 59999));
+    TEST_ASSERT_TRUE(deadband.shouldReport(meter, config, 60000));
+}
+
+void test_new_transaction_is_reported(void) {
+    // Arrange
+    MeterDeadband deadband;
+    deadband.shouldReport(meter, config, 0);
+    meter.transaction_id = 6;
+
+    // Act / Assert
+    TEST_ASSERT_TRUE(deadband.shouldReport(meter, config, 1000));
+}
+
+void test_invalidate_forces_report(void) {
+    // Arrange
+    MeterDeadband deadband;
+    deadband.shouldReport(meter, config, 0);
+    deadband.invalidate(1);
+
+    // Act / Assert
+    TEST_ASSERT_TRUE(deadband.shouldReport(meter, config, 1000));
+}
+
+void test_connectors_are_independent(void) {
+    // Arrange
+    MeterDeadband deadband;
+    deadband.shouldReport(meter, config, 0);
+    meter.connector_id = 2;
+
+    // Act / Assert
+    TEST_ASSERT_TRUE(deadband.shouldReport(meter, config, 1000));
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_first_sample_is_reported);
+    RUN_TEST(test_small_change_is_suppressed);
+    RUN_TEST(test_change_past_deadband_is_reported);
+    RUN_TEST(test_drift_is_measured_from_last_reported);
+    RUN_TEST(test_keyframe_after_interval);
+    RUN_TEST(test_new_transaction_is_reported);
+    RUN_TEST(test_invalidate_forces_report);
+    RUN_TEST(test_connectors_are_independent);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
@@ -0,0 +1,127 @@
+/**
+ * @file test_power_policy.cpp
+ * @brief Unit tests for PowerPolicy (traffic-aware modem sleep)
+ */
+
+#include <unity.h>
+#include "handlers/power_policy.h"
+#include <string.h>
+
+#define NOW 100000UL
+
+static PowerInputs idleInputs() {
+    PowerInputs inputs;
+    memset(&inputs, 0, sizeof(inputs));
+    inputs.enabled = true;
+    inputs.connected = true;
+    inputs.batching = true;
+    inputs.lastUartRx = NOW - POWER_UART_HOLD_MS;
+    inputs.keepAliveBase = NOW - 10000;
+    inputs.keepAliveMs = 60000;
+    return inputs;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_idle_charger_sleeps_deeper(void) {
+    // Arrange
+    PowerInputs inputs = idleInputs();
+
+    // Act / Assert
+    TEST_ASSERT_EQUAL(RadioPowerMode::IDLE, PowerPolicy::decide(inputs, NOW));
+}
+
+void test_session_batching_or_option_keep_radio_active(void) {
+    // Arrange
+    PowerInputs session = idleInputs();
+    session.sessionActive = true;
+    PowerInputs unbatched = idleInputs();
+    unbatched.batching = false;
+    PowerInputs disabled = idleInputs();
+    disabled.enabled = false;
+    PowerInputs busy = idleInputs();
+    busy.busy = true;
+
+    // Act / Assert
+    TEST_ASSERT_EQUAL(RadioPowerMode::ACTIVE, PowerPolicy::decide(session, NOW));
+    TEST_ASSERT_EQUAL(RadioPowerMode::ACTIVE, PowerPolicy::decide(unbatched, NOW));
+    TEST_ASSERT_EQUAL(RadioPowerMode::ACTIVE, PowerPolicy::decide(disabled, NOW));
+    TEST_ASSERT_EQUAL(RadioPowerMode::ACTIVE, PowerPolicy::decide(busy, NOW));
+}
+
+void test_uart_frame_wakes_radio(void) {
+    // Arrange
+    PowerInputs inputs = idleInputs();
+
+    // Act
+    inputs.lastUartRx = NOW;
+
+    // Assert: awake for the hold time, then idle again
+    TEST_ASSERT_EQUAL(RadioPowerMode::ACTIVE, PowerPolicy::decide(inputs, NOW));
+    TEST_ASSERT_EQUAL(RadioPowerMode::ACTIVE, PowerPolicy::decide(inputs, NOW + POWER_UART_HOLD_MS - 1));
+    TEST_ASSERT_EQUAL(RadioPowerMode::IDLE, PowerPolicy::decide(inputs, NOW + POWER_UART_HOLD_MS));
+}
+
+void test_awake_around_every_keepalive(void) {
+    // Arrange: keepalive pings expected at base + 60 s, + 120 s, ...
+    PowerInputs inputs = idleInputs();
+    inputs.lastUartRx = 0;
+    uint32_t base = inputs.keepAliveBase;
+
+    // Act / Assert
+    TEST_ASSERT_EQUAL(RadioPowerMode::IDLE,
+                      PowerPolicy::decide(inputs, base + 60000 - POWER_KEEPALIVE_LEAD_MS - 1));
+    TEST_ASSERT_EQUAL(RadioPowerMode::ACTIVE,
+                      PowerPolicy::decide(inputs, base + 60000 - POWER_KEEPALIVE_LEAD_MS));
+    TEST_ASSERT_EQUAL(RadioPowerMode::ACTIVE,
+                      PowerPolicy::decide(inputs, base + 60000 + POWER_KEEPALIVE_HOLD_MS - 1));
+    TEST_ASSERT_EQUAL(RadioPowerMode::IDLE,
+                      PowerPolicy::decide(inputs, base + 60000 + POWER_KEEPALIVE_HOLD_MS));
+    TEST_ASSERT_EQUAL(RadioPowerMode::ACTIVE, PowerPolicy::decide(inputs, base + 120000));
+}
+
+void test_update_reports_changes_and_residency(void) {
+    // Arrange
+    PowerPolicy policy;
+
+    // Act
+    bool changed = policy.update(RadioPowerMode::IDLE, 1000);
+    bool repeated = policy.update(RadioPowerMode::IDLE, 1500);
+    policy.update(RadioPowerMode::ACTIVE, 4000);
+
+    // Assert
+    TEST_ASSERT_TRUE(changed);
+    TEST_ASSERT_FALSE(repeated);
+    TEST_ASSERT_EQUAL(RadioPowerMode::ACTIVE, policy.getMode());
+    TEST_ASSERT_EQUAL(1, policy.getWakeups());
+    TEST_ASSERT_EQUAL(3000, policy.getTimeIn(RadioPowerMode::IDLE, 5000));
+    TEST_ASSERT_EQUAL(2000, policy.getTimeIn(RadioPowerMode::ACTIVE, 5000));
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_idle_charger_sleeps_deeper);
+    RUN_TEST(test_session_batching_or_option_keep_radio_active);
+    RUN_TEST(test_uart_frame_wakes_radio);
+    RUN_TEST(test_awake_around_every_keepalive);
+    RUN_TEST(test_update_reports_changes_and_residency);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
@@ -37,6 +37,13 @@ public:
         memcpy(&lastPacket, &packet, sizeof(uart_packet_t));
     }
 
+    void sendResponse(uint8_t cmdType, uint8_t sequence, const void* payload, uint16_t length) {
+        packetSent = true;
+        uart_init_packet(&lastPacket, cmdType, sequence);
+        lastPacket.length = length;
+        memcpy(lastPacket.payload, payload, length);
+    }
+
     bool wasAckSent() const { return ackSent; }
     uint8_t getLastSequence() const { return lastSequence; }
     uint8_t getLastStatus() const { return lastStatus; }
@@ -0,0 +1,83 @@
+/**
+ * @file mock_uart_stream.h
+ * @brief Replays a recorded byte stream as the STM32 UART link
+ */
+
+#ifndef MOCK_UART_STREAM_H
+#define MOCK_UART_STREAM_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Stream that hands out a fixed RX buffer and swallows TX
+ *
+ * At most chunkSize bytes become available per refill(), like the UART
+ * FIFO filling between two loop() iterations.
+ */
+class MockUARTStream : public Stream {
+private:
+    const uint8_t* rxData;
+    size_t rxLength;
+    size_t rxPos;
+    size_t rxLimit;     // End of the bytes made available so far
+    size_t chunkSize;
+    size_t txBytes;
+
+public:
+    MockUARTStream(const uint8_t* data, size_t length, size_t chunk = 128)
+        : rxData(data), rxLength(length), rxPos(0), rxLimit(0),
+          chunkSize(chunk), txBytes(0) {}
+
+    /**
+     * @brief Make the next chunk available
+     * @return false once the whole stream has been read
+     */
+    bool refill() {
+        if (rxPos >= rxLength) return false;
+        rxLimit = rxPos + chunkSize;
+        if (rxLimit > rxLength) rxLimit = rxLength;
+        return true;
+    }
+
+    bool finished() const { return rxPos >= rxLength; }
+    size_t getTxBytes() const { return txBytes; }
+
+    int available() override { return (int)(rxLimit - rxPos); }
+
+    int read() override {
+        return (rxPos < rxLimit) ? rxData[rxPos++] : -1;
+    }
+
+    int peek() override {
+        return (rxPos < rxLimit) ? rxData[rxPos] : -1;
+    }
+
+    size_t readBytes(char* buffer, size_t length) override {
+        size_t n = rxLimit - rxPos;
+        if (n > length) n = length;
+        memcpy(buffer, rxData + rxPos, n);
+        rxPos += n;
+        return n;
+    }
+
+    size_t readBytes(uint8_t* buffer, size_t length) override {
+        return readBytes((char*)buffer, length);
+    }
+
+    size_t write(uint8_t) override {
+        txBytes++;
+        return 1;
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override {
+        (void)buffer;
+        txBytes += size;
+        return size;
+    }
+
+    int availableForWrite() override { return 128; }
+
+    void flush() override {}
+};
+
+#endif // MOCK_UART_STREAM_H
@@ -0,0 +1,134 @@
+/**
+ * @file uart_stream_builder.h
+ * @brief Builds STM32 -> ESP8266 byte streams for protocol benchmarks
+ *
+ * Writes wire-format frames (v1 XOR or v2 CRC-16), line noise and
+ * truncated frames into a caller-owned buffer, the same bytes a logic
+ * analyzer capture of the link would contain.
+ */
+
+#ifndef UART_STREAM_BUILDER_H
+#define UART_STREAM_BUILDER_H
+
+#include "../../shared/uart_protocol.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+/**
+ * @brief Microsecond clock for benchmarks (micros() on target)
+ */
+inline uint32_t benchMicros() {
+#ifdef ARDUINO
+    return micros();
+#else
+    static const auto start = std::chrono::steady_clock::now();
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+#endif
+}
+
+/**
+ * @brief Appends frames and faults to a byte buffer
+ */
+class UartStreamBuilder {
+private:
+    uint8_t* buffer;
+    size_t capacity;
+    size_t length;
+    uint16_t frames;    // Complete, valid frames written
+    uint32_t seed;
+
+    bool put(uint8_t byte) {
+        if (length >= capacity) return false;
+        buffer[length++] = byte;
+        return true;
+    }
+
+public:
+    UartStreamBuilder(uint8_t* buf, size_t size)
+        : buffer(buf), capacity(size), length(0), frames(0), seed(0x1234ABCDu) {}
+
+    /**
+     * @brief Append a complete frame
+     * @param keep Bytes of the frame to write (0 = all); a shorter frame
+     *             models a transfer cut off by an STM32 reset
+     * @return false if the buffer is full
+     */
+    bool addFrame(uint8_t version, uint8_t cmdType, uint8_t sequence,
+                  const uint8_t* payload, uint16_t payloadLength, uint16_t keep = 0) {
+        uint8_t header[UART_HEADER_SIZE] = {
+            (uint8_t)(version == UART_PROTOCOL_V2 ? UART_START_BYTE_V2 : UART_START_BYTE),
+            cmdType,
+            (uint8_t)(payloadLength & 0xFF),
+            (uint8_t)(payloadLength >> 8),
+            sequence
+        };
+
+        uint8_t footer[UART_FOOTER_SIZE_V2];
+        uint8_t footerLength;
+        if (version == UART_PROTOCOL_V2) {
+            uint16_t crc = uart_crc16_update(0xFFFF, header + 1, UART_HEADER_SIZE - 1);
+            crc = uart_crc16_update(crc, payload, payloadLength);
+            footer[0] = (uint8_t)(crc & 0xFF);
+            footer[1] = (uint8_t)(crc >> 8);
+            footer[2] = UART_END_BYTE;
+            footerLength = UART_FOOTER_SIZE_V2;
+        } else {
+            uint8_t checksum = header[1] ^ header[2] ^ header[3] ^ header[4];
+            for (uint16_t i = 0; i < payloadLength; i++) {
+                checksum ^= payload[i];
+            }
+            footer[0] = checksum;
+            footer[1] = UART_END_BYTE;
+            footerLength = UART_FOOTER_SIZE;
+        }
+
+        uint16_t total = UART_HEADER_SIZE + payloadLength + footerLength;
+        uint16_t count = (keep > 0 && keep < total) ? keep : total;
+        if (length + count > capacity) return false;
+
+        for (uint16_t i = 0; i < count; i++) {
+            if (i < UART_HEADER_SIZE) {
+                put(header[i]);
+            } else if (i < UART_HEADER_SIZE + payloadLength) {
+                put(payload[i - UART_HEADER_SIZE]);
+            } else {
+                put(footer[i - UART_HEADER_SIZE - payloadLength]);
+            }
+        }
+
+        if (count == total) frames++;
+        return true;
+    }
+
+    /**
+     * @brief Append pseudo-random bytes (may contain start bytes)
+     */
+    bool addNoise(size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            seed = seed * 1664525u + 1013904223u;
+            if (!put((uint8_t)(seed >> 24))) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Flip one bit of an already written byte (line error)
+     */
+    void corrupt(size_t offset) {
+        if (offset < length) buffer[offset] ^= 0x10;
+    }
+
+    const uint8_t* data() const { return buffer; }
+    size_t size() const { return length; }
+    uint16_t frameCount() const { return frames; }
+};
+
+#endif // UART_STREAM_BUILDER_H
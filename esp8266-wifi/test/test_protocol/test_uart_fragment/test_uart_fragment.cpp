@@ -0,0 +1,151 @@
+/**
+ * @file test_uart_fragment.cpp
+ * @brief Unit tests for UART fragment reassembly
+ */
+
+#include <unity.h>
+#include "../../../shared/uart_protocol.h"
+#include <string.h>
+
+static uint8_t message[1200];
+static uint8_t storage[UART_REASSEMBLY_SIZE];
+static uart_reassembly_t reassembly;
+
+static uart_reassembly_result_t feedFragment(uint8_t messageId, uint8_t index, uint16_t total) {
+    uart_fragment_header_t header;
+    header.message_id = messageId;
+    header.index = index;
+    header.count = uart_fragment_count(total);
+    header.cmd_type = CMD_CONFIG_UPDATE;
+    header.total_length = total;
+
+    uint16_t offset = index * UART_FRAGMENT_CHUNK;
+    uint16_t chunk = total - offset;
+    if (chunk > UART_FRAGMENT_CHUNK) chunk = UART_FRAGMENT_CHUNK;
+
+    return uart_reassembly_feed(&reassembly, &header, message + offset, chunk);
+}
+
+void setUp(void) {
+    for (uint16_t i = 0; i < sizeof(message); i++) {
+        message[i] = (uint8_t)(i * 7);
+    }
+    memset(storage, 0, sizeof(storage));
+    uart_reassembly_init(&reassembly, storage, sizeof(storage));
+}
+
+void tearDown(void) {}
+
+void test_fragment_count(void) {
+    // Act / Assert
+    TEST_ASSERT_EQUAL(1, uart_fragment_count(1));
+    TEST_ASSERT_EQUAL(1, uart_fragment_count(UART_FRAGMENT_CHUNK));
+    TEST_ASSERT_EQUAL(2, uart_fragment_count(UART_FRAGMENT_CHUNK + 1));
+    TEST_ASSERT_EQUAL(3, uart_fragment_count(sizeof(message)));
+}
+
+void test_in_order_fragments_reassemble(void) {
+    // Act
+    uart_reassembly_result_t first = feedFragment(1, 0, sizeof(message));
+    uart_reassembly_result_t second = feedFragment(1, 1, sizeof(message));
+    uart_reassembly_result_t last = feedFragment(1, 2, sizeof(message));
+
+    // Assert
+    TEST_ASSERT_EQUAL(UART_REASSEMBLY_INCOMPLETE, first);
+    TEST_ASSERT_EQUAL(UART_REASSEMBLY_INCOMPLETE, second);
+    TEST_ASSERT_EQUAL(UART_REASSEMBLY_COMPLETE, last);
+    TEST_ASSERT_EQUAL(CMD_CONFIG_UPDATE, reassembly.cmd_type);
+    TEST_ASSERT_EQUAL(sizeof(message), reassembly.total_length);
+    TEST_ASSERT_EQUAL_MEMORY(message, storage, sizeof(message));
+}
+
+void test_out_of_order_and_duplicate_fragments(void) {
+    // Act
+    feedFragment(2, 2, sizeof(message));
+    feedFragment(2, 0, sizeof(message));
+    uart_reassembly_result_t again = feedFragment(2, 0, sizeof(message));
+    uart_reassembly_result_t last = feedFragment(2, 1, sizeof(message));
+
+    // Assert
+    TEST_ASSERT_EQUAL(UART_REASSEMBLY_DUPLICATE, again);
+    TEST_ASSERT_EQUAL(UART_REASSEMBLY_COMPLETE, last);
+    TEST_ASSERT_EQUAL_MEMORY(message, storage, sizeof(message));
+}
+
+void test_late_retransmit_after_complete_is_duplicate(void) {
+    // Arrange
+    feedFragment(3, 0, sizeof(message));
+    feedFragment(3, 1, sizeof(message));
+    feedFragment(3, 2, sizeof(message));
+
+    // Act
+    uart_reassembly_result_t result = feedFragment(3, 2, sizeof(message));
+
+    // Assert
+    TEST_ASSERT_EQUAL(UART_REASSEMBLY_DUPLICATE, result);
+}
+
+void test_new_message_drops_partial_one(void) {
+    // Arrange
+    feedFragment(4, 0, sizeof(message));
+
+    // Act: message 5 starts before 4 is complete
+    feedFragment(5, 0, sizeof(message));
+    feedFragment(5, 1, sizeof(message));
+    uart_reassembly_result_t stale = feedFragment(4, 1, sizeof(message));
+
+    // Assert
+    TEST_ASSERT_EQUAL(UART_REASSEMBLY_INCOMPLETE, stale);
+    TEST_ASSERT_EQUAL(4, reassembly.message_id);
+    TEST_ASSERT_EQUAL(1, reassembly.received);
+}
+
+void test_inconsistent_header_is_rejected(void) {
+    // Arrange
+    uart_fragment_header_t header = { 6, 0, 1, CMD_CONFIG_UPDATE, sizeof(message) };
+
+    // Act
+    uart_reassembly_result_t result = uart_reassembly_feed(&reassembly, &header, message, 100);
+
+    // Assert
+    TEST_ASSERT_EQUAL(UART_REASSEMBLY_ERR_HEADER, result);
+}
+
+void test_message_over_capacity_is_rejected(void) {
+    // Arrange
+    uart_reassembly_init(&reassembly, storage, 1000);
+
+    // Act
+    uart_reassembly_result_t result = feedFragment(7, 0, sizeof(message));
+
+    // Assert
+    TEST_ASSERT_EQUAL(UART_REASSEMBLY_ERR_OVERFLOW, result);
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_fragment_count);
+    RUN_TEST(test_in_order_fragments_reassemble);
+    RUN_TEST(test_out_of_order_and_duplicate_fragments);
+    RUN_TEST(test_late_retransmit_after_complete_is_duplicate);
+    RUN_TEST(test_new_message_drops_partial_one);
+    RUN_TEST(test_inconsistent_header_is_rejected);
+    RUN_TEST(test_message_over_capacity_is_rejected);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
@@ -0,0 +1,146 @@
+/**
+ * @file test_uart_parser_benchmark.cpp
+ * @brief Streaming parser throughput (native and on target)
+ *
+ * Feeds generated STM32 streams through uart_parser_feed() in UART-sized
+ * chunks and reports KB/s and ns per KB. The full STM32Communicator
+ * pipeline is measured by test_benchmark on the ESP8266.
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include "../../../shared/uart_protocol.h"
+#include "../../test_mocks/uart_stream_builder.h"
+
+#define BENCH_STREAM_SIZE   8192
+#define BENCH_CHUNK         128
+#define BENCH_PASSES        20
+
+static uint8_t stream[BENCH_STREAM_SIZE];
+static uint8_t payload[UART_MAX_PAYLOAD];
+
+/**
+ * @brief Parse the stream BENCH_PASSES times
+ * @return Valid frames seen in one pass
+ */
+static uint16_t runBench(const char* name, const UartStreamBuilder& builder) {
+    uint16_t frames = 0;
+    uart_parser_t parser;
+
+    uint32_t start = benchMicros();
+    for (uint8_t pass = 0; pass < BENCH_PASSES; pass++) {
+        uart_parser_init(&parser, nullptr);
+        frames = 0;
+
+        size_t pos = 0;
+        while (pos < builder.size()) {
+            size_t end = pos + BENCH_CHUNK;
+            if (end > builder.size()) end = builder.size();
+
+            while (pos < end) {
+                uint16_t consumed = 0;
+                uart_parse_result_t result = uart_parser_feed(&parser, builder.data() + pos,
+                                                              (uint16_t)(end - pos), &consumed);
+                pos += consumed;
+                if (result == UART_PARSE_FRAME) {
+                    frames++;
+                } else if (result != UART_PARSE_INCOMPLETE) {
+                    uart_parser_reset(&parser);
+                }
+            }
+        }
+    }
+    uint32_t elapsed = benchMicros() - start;
+
+    char line[128];
+    uint32_t us = elapsed > 0 ? elapsed : 1;
+    uint64_t bytes = (uint64_t)builder.size() * BENCH_PASSES;
+    snprintf(line, sizeof(line), "%s: %u frames/pass, %lu KB/s, %lu ns/KB",
+             name, (unsigned)frames,
+             (unsigned long)(bytes * 1000000u / us / 1024),
+             (unsigned long)((uint64_t)us * 1000u * 1024u / bytes));
+    TEST_MESSAGE(line);
+
+    return frames;
+}
+
+static void fillPayload(uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        payload[i] = (uint8_t)(i * 7);
+    }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_parser_max_size_v1(void) {
+    // Arrange
+    UartStreamBuilder builder(stream, sizeof(stream));
+    fillPayload(UART_MAX_PAYLOAD);
+    for (uint8_t seq = 0; seq < 15; seq++) {
+        builder.addFrame(UART_PROTOCOL_V1, CMD_MQTT_PUBLISH, seq, payload, UART_MAX_PAYLOAD);
+    }
+
+    // Act / Assert
+    TEST_ASSERT_EQUAL_UINT16(builder.frameCount(), runBench("parser max-size v1", builder));
+}
+
+void test_parser_max_size_v2(void) {
+    // Arrange
+    UartStreamBuilder builder(stream, sizeof(stream));
+    fillPayload(UART_MAX_PAYLOAD);
+    for (uint8_t seq = 0; seq < 15; seq++) {
+        builder.addFrame(UART_PROTOCOL_V2, CMD_MQTT_PUBLISH, seq, payload, UART_MAX_PAYLOAD);
+    }
+
+    // Act / Assert
+    TEST_ASSERT_EQUAL_UINT16(builder.frameCount(), runBench("parser max-size v2", builder));
+}
+
+void test_parser_small_frames_v2(void) {
+    // Arrange
+    UartStreamBuilder builder(stream, sizeof(stream));
+    fillPayload(32);
+    for (uint16_t i = 0; i < 200; i++) {
+        builder.addFrame(UART_PROTOCOL_V2, CMD_PUBLISH_METER_VALUES, (uint8_t)i, payload, 32);
+    }
+
+    // Act / Assert
+    TEST_ASSERT_EQUAL_UINT16(builder.frameCount(), runBench("parser small v2", builder));
+}
+
+void test_parser_noise_only(void) {
+    // Arrange: hunting for start bytes is the worst case per byte
+    UartStreamBuilder builder(stream, sizeof(stream));
+    builder.addNoise(sizeof(stream));
+
+    // Act
+    uint16_t frames = runBench("parser noise", builder);
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT16(0, frames);
+}
+
+void process(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_parser_max_size_v1);
+    RUN_TEST(test_parser_max_size_v2);
+    RUN_TEST(test_parser_small_frames_v2);
+    RUN_TEST(test_parser_noise_only);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
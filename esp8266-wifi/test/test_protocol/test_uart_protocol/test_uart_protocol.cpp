@@ -0,0 +1,339 @@
+/**
+ * @file test_uart_protocol.cpp
+ * @brief Unit tests for UART protocol functions
+ */
+
+#include <unity.h>
+#include "../../../shared/uart_protocol.h"
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// The receive path compares the stored checksum with a fresh calculation
+static bool checksum_matches(const uart_packet_t* packet) {
+    return uart_calculate_checksum(packet) == packet->checksum;
+}
+
+void test_uart_init_packet(void) {
+    // Arrange
+    uart_packet_t packet;
+
+    // Act
+    uart_init_packet(&packet, CMD_MQTT_PUBLISH, 42);
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT8(UART_START_BYTE, packet.start_byte);
+    TEST_ASSERT_EQUAL_UINT8(CMD_MQTT_PUBLISH, packet.cmd_type);
+    TEST_ASSERT_EQUAL_UINT8(42, packet.sequence);
+    TEST_ASSERT_EQUAL_UINT16(0, packet.length);
+}
+
+void test_uart_calculate_checksum(void) {
+    // Arrange
+    uart_packet_t packet;
+    uart_init_packet(&packet, CMD_GET_TIME, 1);
+    packet.length = 0;
+
+    // Act
+    uint8_t checksum = uart_calculate_checksum(&packet);
+
+    // Assert
+    // Checksum = cmd_type XOR sequence XOR length_low XOR length_high
+    uint8_t expected = CMD_GET_TIME ^ 1 ^ 0 ^ 0;
+    TEST_ASSERT_EQUAL_UINT8(expected, checksum);
+}
+
+void test_uart_calculate_checksum_with_payload(void) {
+    // Arrange
+    uart_packet_t packet;
+    uart_init_packet(&packet, CMD_MQTT_PUBLISH, 5);
+
+    const char* testData = "Hello";
+    memcpy(packet.payload, testData, 5);
+    packet.length = 5;
+
+    // Act
+    uint8_t checksum = uart_calculate_checksum(&packet);
+
+    // Assert
+    uint8_t expected = CMD_MQTT_PUBLISH ^ 5 ^ 5 ^ 0;  // cmd ^ seq ^ len_low ^ len_high
+    for (int i = 0; i < 5; i++) {
+        expected ^= testData[i];
+    }
+    TEST_ASSERT_EQUAL_UINT8(expected, checksum);
+}
+
+void test_uart_verify_checksum_valid(void) {
+    // Arrange
+    uart_packet_t packet;
+    uart_init_packet(&packet, CMD_WIFI_STATUS, 10);
+    packet.length = 0;
+    packet.checksum = uart_calculate_checksum(&packet);
+
+    // Act
+    bool valid = checksum_matches(&packet);
+
+    // Assert
+    TEST_ASSERT_TRUE(valid);
+}
+
+void test_uart_verify_checksum_invalid(void) {
+    // Arrange
+    uart_packet_t packet;
+    uart_init_packet(&packet, CMD_WIFI_STATUS, 10);
+    packet.length = 0;
+    packet.checksum = 0xFF;  // Wrong checksum
+
+    // Act
+    bool valid = checksum_matches(&packet);
+
+    // Assert
+    TEST_ASSERT_FALSE(valid);
+}
+
+void test_uart_packet_max_payload(void) {
+    // Arrange
+    uart_packet_t packet;
+    uart_init_packet(&packet, CMD_MQTT_PUBLISH, 1);
+
+    // Act
+    packet.length = UART_MAX_PAYLOAD;
+    memset(packet.payload, 0xAA, UART_MAX_PAYLOAD);
+    packet.checksum = uart_calculate_checksum(&packet);
+
+    // Assert
+    TEST_ASSERT_TRUE(checksum_matches(&packet));
+    TEST_ASSERT_EQUAL_UINT16(UART_MAX_PAYLOAD, packet.length);
+}
+
+// Build a wire frame: AA cmd lenL lenH seq payload xor 55
+static uint16_t build_frame(uint8_t* out, uint8_t cmd, uint8_t seq,
+                            const uint8_t* payload, uint16_t len) {
+    uart_packet_t packet;
+    uart_init_packet(&packet, cmd, seq);
+    memcpy(packet.payload, payload, len);
+    packet.length = len;
+
+    out[0] = UART_START_BYTE;
+    out[1] = cmd;
+    out[2] = len & 0xFF;
+    out[3] = len >> 8;
+    out[4] = seq;
+    memcpy(out + 5, payload, len);
+    out[5 + len] = uart_calculate_checksum(&packet);
+    out[6 + len] = UART_END_BYTE;
+    return len + 7;
+}
+
+void test_uart_parser_whole_frame(void) {
+    // Arrange
+    uint8_t wire[32];
+    uint8_t payload[UART_MAX_PAYLOAD];
+    uint16_t n = build_frame(wire, CMD_MQTT_PUBLISH, 7, (const uint8_t*)"Hello", 5);
+    uart_parser_t parser;
+    uart_parser_init(&parser, payload);
+    uint16_t consumed = 0;
+
+    // Act
+    uart_parse_result_t result = uart_parser_feed(&parser, wire, n, &consumed);
+
+    // Assert
+    TEST_ASSERT_EQUAL(UART_PARSE_FRAME, result);
+    TEST_ASSERT_EQUAL_UINT16(n, consumed);
+    TEST_ASSERT_EQUAL_UINT8(CMD_MQTT_PUBLISH, parser.cmd_type);
+    TEST_ASSERT_EQUAL_UINT8(7, parser.sequence);
+    TEST_ASSERT_EQUAL_UINT16(5, parser.length);
+    TEST_ASSERT_EQUAL_UINT16(n, parser.frame_bytes);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY("Hello", payload, 5);
+}
+
+void test_uart_parser_resumes_byte_by_byte(void) {
+    // Arrange
+    uint8_t wire[32];
+    uint16_t n = build_frame(wire, CMD_GET_TIME, 3, (const uint8_t*)"abc", 3);
+    uart_parser_t parser;
+    uart_parser_init(&parser, nullptr);
+    uart_parse_result_t result = UART_PARSE_INCOMPLETE;
+
+    // Act
+    for (uint16_t i = 0; i < n; i++) {
+        uint16_t consumed = 0;
+        result = uart_parser_feed(&parser, &wire[i], 1, &consumed);
+        TEST_ASSERT_EQUAL_UINT16(1, consumed);
+        if (i < n - 1) TEST_ASSERT_EQUAL(UART_PARSE_INCOMPLETE, result);
+    }
+
+    // Assert
+    TEST_ASSERT_EQUAL(UART_PARSE_FRAME, result);
+    TEST_ASSERT_EQUAL_UINT8(CMD_GET_TIME, parser.cmd_type);
+}
+
+void test_uart_parser_skips_leading_garbage(void) {
+    // Arrange
+    uint8_t wire[32] = {0x00, 0x13, 0x55};
+    uint16_t n = 3 + build_frame(wire + 3, CMD_WIFI_STATUS, 9, nullptr, 0);
+    uart_parser_t parser;
+    uart_parser_init(&parser, nullptr);
+    uint16_t consumed = 0;
+
+    // Act
+    uart_parse_result_t result = uart_parser_feed(&parser, wire, n, &consumed);
+
+    // Assert
+    TEST_ASSERT_EQUAL(UART_PARSE_FRAME, result);
+    TEST_ASSERT_EQUAL_UINT16(n, consumed);
+    TEST_ASSERT_EQUAL_UINT16(7, parser.frame_bytes);
+}
+
+void test_uart_parser_checksum_error(void) {
+    // Arrange
+    uint8_t wire[32];
+    uint16_t n = build_frame(wire, CMD_MQTT_PUBLISH, 1, (const uint8_t*)"xy", 2);
+    wire[5] ^= 0x01;  // Corrupt payload
+    uart_parser_t parser;
+    uart_parser_init(&parser, nullptr);
+    uint16_t consumed = 0;
+
+    // Act
+    uart_parse_result_t result = uart_parser_feed(&parser, wire, n, &consumed);
+
+    // Assert: stops on the checksum byte, before the end byte
+    TEST_ASSERT_EQUAL(UART_PARSE_ERR_CHECKSUM, result);
+    TEST_ASSERT_EQUAL_UINT16(n - 1, consumed);
+    TEST_ASSERT_EQUAL_UINT8(UART_PARSE_HUNT_START, parser.state);
+}
+
+void test_uart_parser_rejects_oversized_length(void) {
+    // Arrange
+    uint8_t wire[5] = {UART_START_BYTE, CMD_MQTT_PUBLISH, 0xFF, 0xFF, 0x01};
+    uart_parser_t parser;
+    uart_parser_init(&parser, nullptr);
+    uint16_t consumed = 0;
+
+    // Act
+    uart_parse_result_t result = uart_parser_feed(&parser, wire, sizeof(wire), &consumed);
+
+    // Assert
+    TEST_ASSERT_EQUAL(UART_PARSE_ERR_LENGTH, result);
+    TEST_ASSERT_EQUAL_UINT16(5, consumed);
+}
+
+void test_uart_crc16_check_value(void) {
+    // Arrange: CRC-16/CCITT-FALSE check value for "123456789" is 0x29B1
+    const uint8_t data[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+    // Act
+    uint16_t crc = uart_crc16_update(0xFFFF, data, sizeof(data));
+
+    // Assert
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, crc);
+}
+
+void test_uart_crc32_check_value(void) {
+    // Arrange: CRC-32 check value for "123456789" is 0xCBF43926
+    const uint8_t data[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+    // Act: in two calls, as a block arrives
+    uint32_t crc = uart_crc32_update(0, data, 4);
+    crc = uart_crc32_update(crc, data + 4, sizeof(data) - 4);
+
+    // Assert
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, crc);
+}
+
+void test_uart_parser_v2_frame(void) {
+    // Arrange
+    uart_packet_t packet;
+    uart_init_packet(&packet, CMD_MQTT_PUBLISH, 4);
+    memcpy(packet.payload, "Hi", 2);
+    packet.length = 2;
+    uint16_t crc = uart_calculate_crc16(&packet);
+    uint8_t wire[10] = {UART_START_BYTE_V2, CMD_MQTT_PUBLISH, 2, 0, 4, 'H', 'i',
+                        (uint8_t)(crc & 0xFF), (uint8_t)(crc >> 8), UART_END_BYTE};
+    uart_parser_t parser;
+    uart_parser_init(&parser, nullptr);
+    uint16_t consumed = 0;
+
+    // Act
+    uart_parse_result_t result = uart_parser_feed(&parser, wire, sizeof(wire), &consumed);
+
+    // Assert
+    TEST_ASSERT_EQUAL(UART_PARSE_FRAME, result);
+    TEST_ASSERT_EQUAL_UINT8(UART_PROTOCOL_V2, parser.version);
+    TEST_ASSERT_EQUAL_UINT16(uart_frame_size(UART_PROTOCOL_V2, 2), consumed);
+}
+
+void test_uart_parser_v2_detects_swapped_bytes(void) {
+    // Arrange: XOR cannot see a swap, CRC-16 must
+    uart_packet_t packet;
+    uart_init_packet(&packet, CMD_MQTT_PUBLISH, 4);
+    memcpy(packet.payload, "Hi", 2);
+    packet.length = 2;
+    uint16_t crc = uart_calculate_crc16(&packet);
+    uint8_t wire[10] = {UART_START_BYTE_V2, CMD_MQTT_PUBLISH, 2, 0, 4, 'i', 'H',
+                        (uint8_t)(crc & 0xFF), (uint8_t)(crc >> 8), UART_END_BYTE};
+    uart_parser_t parser;
+    uart_parser_init(&parser, nullptr);
+    uint16_t consumed = 0;
+
+    // Act
+    uart_parse_result_t result = uart_parser_feed(&parser, wire, sizeof(wire), &consumed);
+
+    // Assert
+    TEST_ASSERT_EQUAL(UART_PARSE_ERR_CHECKSUM, result);
+}
+
+void test_uart_baud_test_pattern(void) {
+    // Arrange
+    uint8_t pattern[UART_BAUD_TEST_LENGTH];
+    uart_fill_baud_test(pattern, sizeof(pattern));
+
+    // Act
+    bool valid = uart_check_baud_test(pattern, sizeof(pattern));
+    pattern[10] ^= 0x80;
+    bool corrupted = uart_check_baud_test(pattern, sizeof(pattern));
+
+    // Assert
+    TEST_ASSERT_TRUE(valid);
+    TEST_ASSERT_FALSE(corrupted);
+    TEST_ASSERT_TRUE(uart_baud_supported(921600));
+    TEST_ASSERT_FALSE(uart_baud_supported(12345));
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_uart_init_packet);
+    RUN_TEST(test_uart_calculate_checksum);
+    RUN_TEST(test_uart_calculate_checksum_with_payload);
+    RUN_TEST(test_uart_verify_checksum_valid);
+    RUN_TEST(test_uart_verify_checksum_invalid);
+    RUN_TEST(test_uart_packet_max_payload);
+    RUN_TEST(test_uart_parser_whole_frame);
+    RUN_TEST(test_uart_parser_resumes_byte_by_byte);
+    RUN_TEST(test_uart_parser_skips_leading_garbage);
+    RUN_TEST(test_uart_parser_checksum_error);
+    RUN_TEST(test_uart_parser_rejects_oversized_length);
+    RUN_TEST(test_uart_crc16_check_value);
+    RUN_TEST(test_uart_crc32_check_value);
+    RUN_TEST(test_uart_parser_v2_frame);
+    RUN_TEST(test_uart_parser_v2_detects_swapped_bytes);
+    RUN_TEST(test_uart_baud_test_pattern);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
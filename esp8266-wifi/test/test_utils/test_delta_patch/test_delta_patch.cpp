@@ -0,0 +1,192 @@
+/**
+ * @file test_delta_patch.cpp
+ * @brief Unit tests for the streaming delta patch decoder
+ */
+
+#include <unity.h>
+#include "utils/delta_patch.h"
+
+static uint8_t source[64];
+static uint8_t target[128];
+static size_t targetLength;
+
+static bool readSource(uint32_t offset, uint8_t* data, size_t length, void*) {
+    if (offset + length > sizeof(source)) return false;
+    memcpy(data, source + offset, length);
+    return true;
+}
+
+static bool writeTarget(const uint8_t* data, size_t length, void*) {
+    if (targetLength + length > sizeof(target)) return false;
+    memcpy(target + targetLength, data, length);
+    targetLength += length;
+    return true;
+}
+
+static size_t putHeader(uint8_t* patch, uint32_t sourceSize, uint32_t targetSize) {
+    memcpy(patch, DELTA_MAGIC, 4);
+    memcpy(patch + 4, &sourceSize, 4);      // Host is little-endian like the ESP8266
+    memcpy(patch + 8, &targetSize, 4);
+    return DELTA_HEADER_SIZE;
+}
+
+void setUp(void) {
+    for (size_t i = 0; i < sizeof(source); i++) source[i] = (uint8_t)i;
+    targetLength = 0;
+}
+
+void tearDown(void) {}
+
+// COPY 8 | ADD 4 (+1 each) | INSERT "xy" | SEEK -12 | COPY 4 -> 18 bytes
+static size_t buildPatch(uint8_t* patch) {
+    size_t n = putHeader(patch, sizeof(source), 18);
+    const uint8_t records[] = {
+        DELTA_OP_COPY, 8,
+        DELTA_OP_ADD, 4, 1, 1, 1, 1,
+        DELTA_OP_INSERT, 2, 'x', 'y',
+        DELTA_OP_SEEK, 23,                  // zigzag(-12)
+        DELTA_OP_COPY, 4
+    };
+    memcpy(patch + n, records, sizeof(records));
+    return n + sizeof(records);
+}
+
+static void drain(DeltaPatch& patch, const uint8_t* data, size_t length, size_t step) {
+    size_t used = 0;
+    while (used < length && !patch.hasError()) {
+        size_t n = length - used < step ? length - used : step;
+        used += patch.feed(data + used, n);
+        while (patch.hasPendingCopy()) patch.pump(3);
+    }
+}
+
+void test_records_rebuild_target(void) {
+    // Arrange
+    uint8_t data[64];
+    size_t length = buildPatch(data);
+    DeltaPatch patch;
+    patch.begin(sizeof(source), readSource, writeTarget, nullptr);
+
+    // Act
+    drain(patch, data, length, length);
+
+    // Assert
+    const uint8_t expected[] = { 0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 'x', 'y', 0, 1, 2, 3 };
+    TEST_ASSERT_TRUE(patch.isComplete());
+    TEST_ASSERT_EQUAL(sizeof(expected), targetLength);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, target, sizeof(expected));
+}
+
+void test_byte_at_a_time_matches_whole_feed(void) {
+    // Arrange
+    uint8_t data[64];
+    size_t length = buildPatch(data);
+    DeltaPatch patch;
+    patch.begin(sizeof(source), readSource, writeTarget, nullptr);
+
+    // Act: network chunks can split any record
+    drain(patch, data, length, 1);
+
+    // Assert
+    TEST_ASSERT_TRUE(patch.isComplete());
+    TEST_ASSERT_EQUAL(18, patch.getProduced());
+    TEST_ASSERT_EQUAL_UINT8('y', target[13]);
+}
+
+void test_copy_waits_for_pump(void) {
+    // Arrange
+    uint8_t data[32];
+    size_t length = putHeader(data, sizeof(source), 40);
+    data[length++] = DELTA_OP_COPY;
+    data[length++] = 40;
+    DeltaPatch patch;
+    patch.begin(sizeof(source), readSource, writeTarget, nullptr);
+
+    // Act
+    size_t used = patch.feed(data, length);
+
+    // Assert: nothing produced until pumped, budget respected
+    TEST_ASSERT_EQUAL(length, used);
+    TEST_ASSERT_TRUE(patch.hasPendingCopy());
+    TEST_ASSERT_EQUAL(0, targetLength);
+    patch.pump(10);
+    TEST_ASSERT_LESS_THAN(40, targetLength);
+    while (patch.hasPendingCopy()) patch.pump(10);
+    TEST_ASSERT_TRUE(patch.isComplete());
+}
+
+void test_other_source_is_rejected(void) {
+    // Arrange: patch built for a 100-byte image
+    uint8_t data[32];
+    size_t length = buildPatch(data);
+    DeltaPatch patch;
+    patch.begin(100, readSource, writeTarget, nullptr);
+
+    // Act
+    patch.feed(data, length);
+
+    // Assert
+    TEST_ASSERT_EQUAL(DeltaError::BAD_HEADER, patch.getError());
+    TEST_ASSERT_EQUAL(0, targetLength);
+}
+
+void test_copy_past_source_is_rejected(void) {
+    // Arrange
+    uint8_t data[32];
+    size_t length = putHeader(data, sizeof(source), 100);
+    data[length++] = DELTA_OP_SEEK;
+    data[length++] = 120;                   // +60
+    data[length++] = DELTA_OP_COPY;
+    data[length++] = 8;
+    DeltaPatch patch;
+    patch.begin(sizeof(source), readSource, writeTarget, nullptr);
+
+    // Act
+    patch.feed(data, length);
+
+    // Assert
+    TEST_ASSERT_EQUAL(DeltaError::OUT_OF_RANGE, patch.getError());
+}
+
+void test_output_past_target_is_rejected(void) {
+    // Arrange
+    uint8_t data[32];
+    size_t length = putHeader(data, sizeof(source), 2);
+    data[length++] = DELTA_OP_INSERT;
+    data[length++] = 3;
+    DeltaPatch patch;
+    patch.begin(sizeof(source), readSource, writeTarget, nullptr);
+
+    // Act
+    patch.feed(data, length);
+
+    // Assert
+    TEST_ASSERT_EQUAL(DeltaError::TOO_LONG, patch.getError());
+    TEST_ASSERT_FALSE(patch.isComplete());
+}
+
+void process(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_records_rebuild_target);
+    RUN_TEST(test_byte_at_a_time_matches_whole_feed);
+    RUN_TEST(test_copy_waits_for_pump);
+    RUN_TEST(test_other_source_is_rejected);
+    RUN_TEST(test_copy_past_source_is_rejected);
+    RUN_TEST(test_output_past_target_is_rejected);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
@@ -0,0 +1,155 @@
+/**
+ * @file test_json_writer.cpp
+ * @brief Unit tests for JsonWriter and OCPP JSON serializers
+ */
+
+#include <unity.h>
+#include "utils/json_writer.h"
+#include "handlers/ocpp_json.h"
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_writes_compact_object(void) {
+    // Arrange
+    char buffer[64];
+    JsonWriter w(buffer, sizeof(buffer));
+
+    // Act
+    w.beginObject();
+    w.field("a", (uint32_t)1);
+    w.field("b", "x");
+    w.field("c", (int32_t)-42);
+    w.field("d", true);
+    w.endObject();
+    size_t length = w.length();
+
+    // Assert
+    TEST_ASSERT_EQUAL_STRING("{\"a\":1,\"b\":\"x\",\"c\":-42,\"d\":true}", buffer);
+    TEST_ASSERT_EQUAL(strlen(buffer), length);
+}
+
+void test_escapes_strings(void) {
+    // Arrange
+    char buffer[64];
+    JsonWriter w(buffer, sizeof(buffer));
+
+    // Act
+    w.beginObject();
+    w.field("s", "q\"b\\n\n\x01");
+    w.endObject();
+    w.length();
+
+    // Assert
+    TEST_ASSERT_EQUAL_STRING("{\"s\":\"q\\\"b\\\\n\\n\\u0001\"}", buffer);
+}
+
+void test_nested_object_and_array(void) {
+    // Arrange
+    char buffer[64];
+    JsonWriter w(buffer, sizeof(buffer));
+
+    // Act
+    w.beginObject();
+    w.beginObject("o");
+    w.field("k", (uint8_t)7);
+    w.endObject();
+    w.beginArray("v");
+    w.element(1);
+    w.element(2);
+    w.endArray();
+    w.endObject();
+    w.length();
+
+    // Assert
+    TEST_ASSERT_EQUAL_STRING("{\"o\":{\"k\":7},\"v\":[1,2]}", buffer);
+}
+
+void test_overflow_returns_zero_length(void) {
+    // Arrange
+    char buffer[8];
+    JsonWriter w(buffer, sizeof(buffer));
+
+    // Act
+    w.beginObject();
+    w.field("key", "too long for buffer");
+    w.endObject();
+
+    // Assert
+    TEST_ASSERT_FALSE(w.ok());
+    TEST_ASSERT_EQUAL(0, w.length());
+}
+
+void test_fixed_array_field_is_bounded(void) {
+    // Arrange: char array without NUL terminator
+    char buffer[32];
+    char tag[4] = {'A', 'B', 'C', 'D'};
+    JsonWriter w(buffer, sizeof(buffer));
+
+    // Act
+    w.beginObject();
+    w.field("t", tag);
+    w.endObject();
+    w.length();
+
+    // Assert
+    TEST_ASSERT_EQUAL_STRING("{\"t\":\"ABCD\"}", buffer);
+}
+
+void test_meter_values_layout(void) {
+    // Arrange
+    meter_values_t meter;
+    memset(&meter, 0, sizeof(meter));
+    strcpy(meter.msg_id, "m1");
+    strcpy(meter.timestamp, "2024-01-01T00:00:00Z");
+    meter.connector_id = 1;
+    meter.transaction_id = 99;
+    meter.sample.energy_wh = 1234;
+    meter.sample.power_w = 7000;
+    meter.sample.voltage_v = 230;
+    meter.sample.current_a = 32;
+    meter.sample.frequency_hz = 50;
+    meter.sample.temperature_c = -5;
+    meter.sample.power_factor_pct = 98;
+    char buffer[512];
+
+    // Act
+    size_t length = OcppJson::write<JsonWriter>(buffer, sizeof(buffer), meter);
+
+    // Assert
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"msgId\":\"m1\",\"timestamp\":\"2024-01-01T00:00:00Z\",\"connectorId\":1,"
+        "\"transactionId\":99,\"sample\":{\"energy_wh\":1234,\"power_w\":7000,"
+        "\"voltage_v\":230,\"current_a\":32,\"frequency_hz\":50,"
+        "\"temperature_c\":-5,\"power_factor_pct\":98}}",
+        buffer);
+    TEST_ASSERT_EQUAL(strlen(buffer), length);
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_writes_compact_object);
+    RUN_TEST(test_escapes_strings);
+    RUN_TEST(test_nested_object_and_array);
+    RUN_TEST(test_overflow_returns_zero_length);
+    RUN_TEST(test_fixed_array_field_is_bounded);
+    RUN_TEST(test_meter_values_layout);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
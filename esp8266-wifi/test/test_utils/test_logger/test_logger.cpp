@@ -0,0 +1,162 @@
+/**
+ * @file test_logger.cpp
+ * @brief Unit tests for Logger (deferred formatting)
+ */
+
+#include <unity.h>
+#include "utils/logger.h"
+#include <string.h>
+
+/**
+ * @brief Output capturing everything written, with optional FIFO limit
+ */
+class CaptureOutput : public Print {
+public:
+    char text[1024];
+    size_t length = 0;
+    int room = 1024;
+
+    size_t write(uint8_t byte) override { return write(&byte, 1); }
+    size_t write(const uint8_t* buf, size_t size) override {
+        if (length + size >= sizeof(text)) size = sizeof(text) - 1 - length;
+        memcpy(text + length, buf, size);
+        length += size;
+        text[length] = '\0';
+        return size;
+    }
+    int availableForWrite() override { return room; }
+
+    void clear() { length = 0; text[0] = '\0'; }
+};
+
+static CaptureOutput capture;
+static Logger& logger = Logger::getInstance();
+
+void setUp(void) {
+    // Drain anything left from a previous test
+    capture.room = 1024;
+    logger.setOutput(capture);
+    logger.setLevel(LogLevel::DEBUG);
+    logger.setTrace(false);
+    while (logger.flush()) {}
+    capture.clear();
+}
+
+void tearDown(void) {}
+
+void test_nothing_is_written_before_flush(void) {
+    // Act
+    LOG_INFO("Test", "value=%d", 42);
+
+    // Assert
+    TEST_ASSERT_EQUAL(0, capture.length);
+    logger.flush();
+    TEST_ASSERT_NOT_NULL(strstr(capture.text, "[INFO]  [Test] value=42\r\n"));
+}
+
+void test_string_argument_is_copied(void) {
+    // Arrange
+    char topic[16];
+    strcpy(topic, "a/b");
+
+    // Act: caller buffer changes before flush
+    LOG_DEBUG("Test", "topic=%s len=%u", topic, 3u);
+    strcpy(topic, "xxx");
+    logger.flush();
+
+    // Assert
+    TEST_ASSERT_NOT_NULL(strstr(capture.text, "topic=a/b len=3"));
+}
+
+void test_flags_width_and_precision(void) {
+    // Act
+    LOG_INFO("Test", "%02X %08X %-3d| %.*s %5.1f %c %%", 0xA, 0xBEEFu, -1, 2, "abcdef", 2.25, 'z');
+    logger.flush();
+
+    // Assert
+    TEST_ASSERT_NOT_NULL(strstr(capture.text, "0A 0000BEEF -1 | ab   2.2 z %"));
+}
+
+void test_level_filter(void) {
+    // Arrange
+    logger.setLevel(LogLevel::WARN);
+
+    // Act
+    LOG_INFO("Test", "hidden");
+    LOG_WARN("Test", "shown");
+    logger.flush();
+
+    // Assert
+    TEST_ASSERT_NULL(strstr(capture.text, "hidden"));
+    TEST_ASSERT_NOT_NULL(strstr(capture.text, "shown"));
+}
+
+void test_trace_needs_runtime_enable(void) {
+    // Act
+    LOG_TRACE("Test", "frame 1");
+    logger.setTrace(true);
+    LOG_TRACE("Test", "frame 2");
+    logger.flush();
+
+    // Assert
+    TEST_ASSERT_NULL(strstr(capture.text, "frame 1"));
+    TEST_ASSERT_NOT_NULL(strstr(capture.text, "frame 2"));
+}
+
+void test_paced_output_writes_only_free_space(void) {
+    // Arrange
+    capture.room = 10;
+    LOG_INFO("Test", "a line longer than ten bytes");
+
+    // Act
+    bool pending = logger.flush();
+
+    // Assert: one FIFO's worth written, rest kept for the next call
+    TEST_ASSERT_TRUE(pending);
+    TEST_ASSERT_EQUAL(10, capture.length);
+    capture.room = 1024;
+    logger.flush();
+    TEST_ASSERT_NOT_NULL(strstr(capture.text, "a line longer than ten bytes\r\n"));
+}
+
+void test_full_ring_counts_dropped(void) {
+    // Arrange
+    uint32_t before = logger.getDropped();
+
+    // Act
+    for (int i = 0; i < LOG_RING_SIZE; i++) {
+        LOG_INFO("Test", "fill %d", i);
+    }
+    while (logger.flush()) { capture.clear(); }
+
+    // Assert
+    TEST_ASSERT_TRUE(logger.getDropped() > before);
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_nothing_is_written_before_flush);
+    RUN_TEST(test_string_argument_is_copied);
+    RUN_TEST(test_flags_width_and_precision);
+    RUN_TEST(test_level_filter);
+    RUN_TEST(test_trace_needs_runtime_enable);
+    RUN_TEST(test_paced_output_writes_only_free_space);
+    RUN_TEST(test_full_ring_counts_dropped);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
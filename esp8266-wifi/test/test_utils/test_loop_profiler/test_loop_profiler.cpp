@@ -0,0 +1,115 @@
+/**
+ * @file test_loop_profiler.cpp
+ * @brief Unit tests for LoopProfiler
+ */
+
+#include <unity.h>
+#include "utils/loop_profiler.h"
+
+static LoopProfiler profiler;
+
+void setUp(void) {
+    profiler.reset();
+}
+
+void tearDown(void) {}
+
+void test_empty_stage_has_no_samples(void) {
+    // Act
+    const StageStats& stats = profiler.get(ProfileStage::STM32);
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT32(0, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.avgUs());
+    TEST_ASSERT_EQUAL_UINT32(0, stats.maxUs);
+}
+
+void test_min_avg_max(void) {
+    // Act
+    profiler.addSample(ProfileStage::MQTT, 100);
+    profiler.addSample(ProfileStage::MQTT, 300);
+    profiler.addSample(ProfileStage::MQTT, 200);
+
+    // Assert
+    const StageStats& stats = profiler.get(ProfileStage::MQTT);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(100, stats.minUs);
+    TEST_ASSERT_EQUAL_UINT32(200, stats.avgUs());
+    TEST_ASSERT_EQUAL_UINT32(300, stats.maxUs);
+}
+
+void test_histogram_uses_log2_buckets(void) {
+    // Act
+    profiler.addSample(ProfileStage::NTP, 0);        // [0,2)
+    profiler.addSample(ProfileStage::NTP, 1);        // [0,2)
+    profiler.addSample(ProfileStage::NTP, 3);        // [2,4)
+    profiler.addSample(ProfileStage::NTP, 1024);     // [1024,2048)
+    profiler.addSample(ProfileStage::NTP, 2047);     // [1024,2048)
+    profiler.addSample(ProfileStage::NTP, 5000000);  // last, open-ended
+
+    // Assert
+    const StageStats& stats = profiler.get(ProfileStage::NTP);
+    TEST_ASSERT_EQUAL_UINT16(2, stats.histogram[0]);
+    TEST_ASSERT_EQUAL_UINT16(1, stats.histogram[1]);
+    TEST_ASSERT_EQUAL_UINT16(2, stats.histogram[10]);
+    TEST_ASSERT_EQUAL_UINT16(1, stats.histogram[LOOP_PROFILE_BUCKETS - 1]);
+    TEST_ASSERT_EQUAL_UINT32(1024, LoopProfiler::bucketFloor(10));
+}
+
+void test_stalls_are_counted_per_stage(void) {
+    // Act
+    profiler.addSample(ProfileStage::WIFI, LOOP_STALL_US);
+    profiler.addSample(ProfileStage::WIFI, LOOP_STALL_US + 1);
+    profiler.addSample(ProfileStage::LOOP, 120000);
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT32(1, profiler.get(ProfileStage::WIFI).stalls);
+    TEST_ASSERT_EQUAL_UINT32(1, profiler.get(ProfileStage::LOOP).stalls);
+    TEST_ASSERT_EQUAL_UINT32(0, profiler.get(ProfileStage::STM32).stalls);
+}
+
+void test_reset_clears_statistics(void) {
+    // Arrange
+    profiler.addSample(ProfileStage::METER, 70000);
+
+    // Act
+    profiler.reset();
+
+    // Assert
+    const StageStats& stats = profiler.get(ProfileStage::METER);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.stalls);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.histogram[LOOP_PROFILE_BUCKETS - 1]);
+}
+
+void test_stage_names(void) {
+    TEST_ASSERT_EQUAL_STRING("loop", LoopProfiler::stageName(ProfileStage::LOOP));
+    TEST_ASSERT_EQUAL_STRING("stm32", LoopProfiler::stageName(ProfileStage::STM32));
+    TEST_ASSERT_EQUAL_STRING("meter", LoopProfiler::stageName(ProfileStage::METER));
+}
+
+void process(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_stage_has_no_samples);
+    RUN_TEST(test_min_avg_max);
+    RUN_TEST(test_histogram_uses_log2_buckets);
+    RUN_TEST(test_stalls_are_counted_per_stage);
+    RUN_TEST(test_reset_clears_statistics);
+    RUN_TEST(test_stage_names);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
@@ -0,0 +1,168 @@
+/**
+ * @file test_memory_pool.cpp
+ * @brief Unit tests for static slots and block pools
+ */
+
+#include <unity.h>
+#include "utils/memory_pool.h"
+
+struct Tracked {
+    static int alive;
+    uint32_t value;
+
+    explicit Tracked(uint32_t v) : value(v) { alive++; }
+    ~Tracked() { alive--; }
+};
+
+int Tracked::alive = 0;
+
+void setUp(void) {
+    Tracked::alive = 0;
+}
+
+void tearDown(void) {}
+
+void test_pool_hands_out_distinct_blocks(void) {
+    // Arrange
+    BlockPool<24, 3> pool("test");
+
+    // Act
+    void* a = pool.acquire();
+    void* b = pool.acquire();
+    void* c = pool.acquire();
+
+    // Assert
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_NOT_NULL(c);
+    TEST_ASSERT_TRUE(a != b && b != c && a != c);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)a % 8);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)b % 8);
+    TEST_ASSERT_EQUAL(3, pool.getUsed());
+}
+
+void test_exhausted_pool_refuses_and_counts(void) {
+    // Arrange
+    BlockPool<16, 1> pool("test");
+    void* block = pool.acquire();
+
+    // Act
+    void* refused = pool.acquire();
+
+    // Assert
+    TEST_ASSERT_NULL(refused);
+    TEST_ASSERT_EQUAL(1, pool.getFailures());
+
+    // Released block is handed out again
+    pool.release(block);
+    TEST_ASSERT_EQUAL_PTR(block, pool.acquire());
+}
+
+void test_high_water_survives_release(void) {
+    // Arrange
+    BlockPool<16, 4> pool("test");
+    void* a = pool.acquire();
+    void* b = pool.acquire();
+
+    // Act
+    pool.release(a);
+    pool.release(b);
+
+    // Assert
+    TEST_ASSERT_EQUAL(0, pool.getUsed());
+    TEST_ASSERT_EQUAL(2, pool.getHighWater());
+}
+
+void test_double_release_is_ignored(void) {
+    // Arrange
+    BlockPool<16, 2> pool("test");
+    void* a = pool.acquire();
+    pool.acquire();
+    pool.release(a);
+
+    // Act
+    pool.release(a);
+    uint8_t stray;
+    pool.release(&stray);
+
+    // Assert
+    TEST_ASSERT_EQUAL(1, pool.getUsed());
+}
+
+void test_create_constructs_and_destroy_destructs(void) {
+    // Arrange
+    BlockPool<sizeof(Tracked), 2> pool("test");
+
+    // Act
+    Tracked* object = pool.create<Tracked>(42u);
+
+    // Assert
+    TEST_ASSERT_NOT_NULL(object);
+    TEST_ASSERT_EQUAL(42, object->value);
+    TEST_ASSERT_EQUAL(1, Tracked::alive);
+
+    pool.destroy(object);
+    TEST_ASSERT_EQUAL(0, Tracked::alive);
+    TEST_ASSERT_EQUAL(0, pool.getUsed());
+}
+
+void test_pools_are_registered(void) {
+    // Arrange
+    BlockPool<16, 1> pool("registered");
+
+    // Act
+    bool found = false;
+    for (MemoryPool* p = MemoryPool::first(); p; p = p->getNext()) {
+        if (p == &pool) found = true;
+    }
+
+    // Assert
+    TEST_ASSERT_TRUE(found);
+}
+
+void test_static_slot_replaces_object(void) {
+    // Arrange
+    StaticSlot<Tracked> slot;
+    TEST_ASSERT_NULL(slot.get());
+
+    // Act
+    slot.emplace(1u);
+    Tracked* second = slot.emplace(2u);
+
+    // Assert: the first one was destroyed
+    TEST_ASSERT_EQUAL(1, Tracked::alive);
+    TEST_ASSERT_EQUAL_PTR(second, slot.get());
+    TEST_ASSERT_EQUAL(2, second->value);
+
+    slot.reset();
+    TEST_ASSERT_EQUAL(0, Tracked::alive);
+    TEST_ASSERT_FALSE(slot.isConstructed());
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pool_hands_out_distinct_blocks);
+    RUN_TEST(test_exhausted_pool_refuses_and_counts);
+    RUN_TEST(test_high_water_survives_release);
+    RUN_TEST(test_double_release_is_ignored);
+    RUN_TEST(test_create_constructs_and_destroy_destructs);
+    RUN_TEST(test_pools_are_registered);
+    RUN_TEST(test_static_slot_replaces_object);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
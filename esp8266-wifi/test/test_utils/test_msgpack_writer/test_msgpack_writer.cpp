@@ -0,0 +1,165 @@
+/**
+ * @file test_msgpack_writer.cpp
+ * @brief Unit tests for MsgPackWriter
+ */
+
+#include <unity.h>
+#include "utils/msgpack_writer.h"
+#include "handlers/ocpp_json.h"
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_small_map_uses_fixmap(void) {
+    // Arrange
+    char buffer[32];
+    MsgPackWriter w(buffer, sizeof(buffer));
+
+    // Act
+    w.beginObject();
+    w.field("a", (uint32_t)1);
+    w.field("b", "xy");
+    w.endObject();
+
+    // Assert
+    const uint8_t expected[] = {0x82, 0xA1, 'a', 0x01, 0xA1, 'b', 0xA2, 'x', 'y'};
+    TEST_ASSERT_EQUAL(sizeof(expected), w.length());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buffer, sizeof(expected));
+}
+
+void test_integer_encodings(void) {
+    // Arrange
+    char buffer[64];
+    MsgPackWriter w(buffer, sizeof(buffer));
+
+    // Act
+    w.beginObject();
+    w.field("u8", (uint32_t)200);
+    w.field("u16", (uint32_t)1000);
+    w.field("u32", (uint32_t)70000);
+    w.field("n", (int32_t)-5);
+    w.field("i16", (int32_t)-300);
+    w.endObject();
+
+    // Assert
+    const uint8_t expected[] = {
+        0x85,
+        0xA2, 'u', '8', 0xCC, 200,
+        0xA3, 'u', '1', '6', 0xCD, 0x03, 0xE8,
+        0xA3, 'u', '3', '2', 0xCE, 0x00, 0x01, 0x11, 0x70,
+        0xA1, 'n', 0xFB,
+        0xA3, 'i', '1', '6', 0xD1, 0xFE, 0xD4,
+    };
+    TEST_ASSERT_EQUAL(sizeof(expected), w.length());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buffer, sizeof(expected));
+}
+
+void test_nested_containers(void) {
+    // Arrange
+    char buffer[32];
+    MsgPackWriter w(buffer, sizeof(buffer));
+
+    // Act
+    w.beginObject();
+    w.beginObject("o");
+    w.field("k", true);
+    w.endObject();
+    w.beginArray("v");
+    w.element(1);
+    w.element(2);
+    w.endArray();
+    w.endObject();
+
+    // Assert
+    const uint8_t expected[] = {0x82, 0xA1, 'o', 0x81, 0xA1, 'k', 0xC3,
+                                0xA1, 'v', 0x92, 0x01, 0x02};
+    TEST_ASSERT_EQUAL(sizeof(expected), w.length());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buffer, sizeof(expected));
+}
+
+void test_large_map_keeps_map16_header(void) {
+    // Arrange
+    char buffer[128];
+    MsgPackWriter w(buffer, sizeof(buffer));
+    const char* keys[] = {"a","b","c","d","e","f","g","h","i","j","k","l","m","n","o","p"};
+
+    // Act
+    w.beginObject();
+    for (uint8_t i = 0; i < 16; i++) {
+        w.field(keys[i], (uint32_t)i);
+    }
+    w.endObject();
+
+    // Assert
+    TEST_ASSERT_EQUAL(3 + 16 * 3, w.length());
+    TEST_ASSERT_EQUAL_UINT8(0xDE, (uint8_t)buffer[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, (uint8_t)buffer[1]);
+    TEST_ASSERT_EQUAL_UINT8(16, (uint8_t)buffer[2]);
+}
+
+void test_overflow_and_unbalanced_return_zero(void) {
+    // Arrange
+    char small[4];
+    char buffer[16];
+    MsgPackWriter overflow(small, sizeof(small));
+    MsgPackWriter open(buffer, sizeof(buffer));
+
+    // Act
+    overflow.beginObject();
+    overflow.field("key", "value");
+    overflow.endObject();
+    open.beginObject();
+
+    // Assert
+    TEST_ASSERT_EQUAL(0, overflow.length());
+    TEST_ASSERT_EQUAL(0, open.length());
+}
+
+void test_meter_values_smaller_than_json(void) {
+    // Arrange
+    meter_values_t meter;
+    memset(&meter, 0, sizeof(meter));
+    strcpy(meter.msg_id, "m1");
+    strcpy(meter.timestamp, "2024-01-01T00:00:00Z");
+    meter.connector_id = 1;
+    meter.sample.energy_wh = 1234;
+    char json[512];
+    char packed[512];
+
+    // Act
+    size_t jsonLength = OcppJson::write<JsonWriter>(json, sizeof(json), meter);
+    size_t packedLength = OcppJson::write<MsgPackWriter>(packed, sizeof(packed), meter);
+
+    // Assert
+    TEST_ASSERT_TRUE(packedLength > 0);
+    TEST_ASSERT_TRUE(packedLength < jsonLength);
+    TEST_ASSERT_EQUAL_UINT8(0x85, (uint8_t)packed[0]);
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_small_map_uses_fixmap);
+    RUN_TEST(test_integer_encodings);
+    RUN_TEST(test_nested_containers);
+    RUN_TEST(test_large_map_keeps_map16_header);
+    RUN_TEST(test_overflow_and_unbalanced_return_zero);
+    RUN_TEST(test_meter_values_smaller_than_json);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
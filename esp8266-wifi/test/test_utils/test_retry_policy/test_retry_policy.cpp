@@ -0,0 +1,106 @@
+/**
+ * @file test_retry_policy.cpp
+ * @brief Unit tests for retry policies
+ */
+
+#include <unity.h>
+#include "utils/retry_policy.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_exponential_backoff_doubles_until_max(void) {
+    // Arrange
+    ExponentialBackoff policy(1000, 5000, 3);
+
+    // Act & Assert
+    TEST_ASSERT_EQUAL(1000, policy.getNextDelay(0));
+    TEST_ASSERT_EQUAL(4000, policy.getNextDelay(2));
+    TEST_ASSERT_EQUAL(5000, policy.getNextDelay(3));
+    TEST_ASSERT_TRUE(policy.shouldRetry(2));
+    TEST_ASSERT_FALSE(policy.shouldRetry(3));
+}
+
+void test_jitter_stays_within_bounds(void) {
+    // Arrange
+    DecorrelatedJitter policy(1000, 30000, 0x1234);
+    uint32_t previous = 1000;
+
+    // Act & Assert: each delay in [base, min(max, previous * 3)]
+    for (uint8_t attempt = 0; attempt < 50; attempt++) {
+        uint32_t delay = policy.getNextDelay(attempt);
+        TEST_ASSERT_GREATER_OR_EQUAL(1000, delay);
+        TEST_ASSERT_LESS_OR_EQUAL(30000, delay);
+        TEST_ASSERT_LESS_OR_EQUAL(previous * 3, delay);
+        previous = delay;
+    }
+}
+
+void test_jitter_differs_between_seeds(void) {
+    // Arrange: two chargers failing at the same moment
+    DecorrelatedJitter first(1000, 60000, 0x00A1B2C3);
+    DecorrelatedJitter second(1000, 60000, 0x00A1B2C4);
+
+    // Act
+    uint8_t same = 0;
+    for (uint8_t attempt = 0; attempt < 10; attempt++) {
+        if (first.getNextDelay(attempt) == second.getNextDelay(attempt)) {
+            same++;
+        }
+    }
+
+    // Assert
+    TEST_ASSERT_LESS_THAN(2, same);
+}
+
+void test_jitter_reset_restarts_from_base(void) {
+    // Arrange: grow the delay towards the cap
+    DecorrelatedJitter policy(1000, 60000, 42);
+    for (uint8_t attempt = 0; attempt < 20; attempt++) {
+        policy.getNextDelay(attempt);
+    }
+
+    // Act
+    policy.reset();
+    uint32_t delay = policy.getNextDelay(0);
+
+    // Assert
+    TEST_ASSERT_LESS_OR_EQUAL(3000, delay);
+}
+
+void test_jitter_unlimited_attempts(void) {
+    // Arrange
+    DecorrelatedJitter forever(1000, 60000, 1);
+    DecorrelatedJitter bounded(1000, 60000, 1, 3);
+
+    // Act & Assert
+    TEST_ASSERT_TRUE(forever.shouldRetry(250));
+    TEST_ASSERT_TRUE(bounded.shouldRetry(2));
+    TEST_ASSERT_FALSE(bounded.shouldRetry(3));
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_exponential_backoff_doubles_until_max);
+    RUN_TEST(test_jitter_stays_within_bounds);
+    RUN_TEST(test_jitter_differs_between_seeds);
+    RUN_TEST(test_jitter_reset_restarts_from_base);
+    RUN_TEST(test_jitter_unlimited_attempts);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
@@ -0,0 +1,142 @@
+/**
+ * @file test_ring_buffer.cpp
+ * @brief Unit tests for RingBuffer bulk (span) API
+ */
+
+#include <unity.h>
+#include "utils/ring_buffer.h"
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_write_span_empty_buffer_is_full_capacity(void) {
+    // Arrange
+    RingBuffer<16> buffer;
+    size_t len = 0;
+
+    // Act
+    buffer.writeSpan(len);
+
+    // Assert
+    TEST_ASSERT_EQUAL(16, len);
+}
+
+void test_commit_makes_bytes_available(void) {
+    // Arrange
+    RingBuffer<16> buffer;
+    size_t len;
+    uint8_t* dst = buffer.writeSpan(len);
+    memcpy(dst, "abcd", 4);
+
+    // Act
+    size_t committed = buffer.commit(4);
+
+    // Assert
+    uint8_t byte;
+    TEST_ASSERT_EQUAL(4, committed);
+    TEST_ASSERT_EQUAL(4, buffer.available());
+    TEST_ASSERT_TRUE(buffer.peekAt(3, byte));
+    TEST_ASSERT_EQUAL_UINT8('d', byte);
+    TEST_ASSERT_EQUAL(4, buffer.getTotalPushed());
+}
+
+void test_write_span_stops_at_wrap_point(void) {
+    // Arrange: head at 12, tail at 8 -> 4 bytes to the end, 8 after wrap
+    RingBuffer<16> buffer;
+    uint8_t data[12] = {0};
+    buffer.pushMultiple(data, 12);
+    buffer.discard(8);
+    size_t len;
+
+    // Act
+    buffer.writeSpan(len);
+    buffer.commit(len);
+    buffer.writeSpan(len);
+
+    // Assert
+    TEST_ASSERT_EQUAL(8, len);
+    TEST_ASSERT_EQUAL(8, buffer.available());
+}
+
+void test_write_span_full_buffer_counts_overflow(void) {
+    // Arrange
+    RingBuffer<8> buffer;
+    uint8_t data[8] = {0};
+    buffer.pushMultiple(data, 8);
+    size_t len = 99;
+
+    // Act
+    buffer.writeSpan(len);
+
+    // Assert
+    TEST_ASSERT_EQUAL(0, len);
+    TEST_ASSERT_EQUAL(1, buffer.getOverflowCount());
+}
+
+void test_push_multiple_across_wrap(void) {
+    // Arrange
+    RingBuffer<8> buffer;
+    uint8_t skip[6] = {0};
+    buffer.pushMultiple(skip, 6);
+    buffer.discard(6);
+    const uint8_t data[5] = {1, 2, 3, 4, 5};
+
+    // Act
+    size_t pushed = buffer.pushMultiple(data, 5);
+
+    // Assert
+    uint8_t out[5];
+    TEST_ASSERT_EQUAL(5, pushed);
+    TEST_ASSERT_EQUAL(5, buffer.popMultiple(out, 5));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, out, 5);
+}
+
+void test_read_span_splits_at_wrap_point(void) {
+    // Arrange: 6 readable bytes, 2 before the physical end, 4 after wrap
+    RingBuffer<8> buffer;
+    uint8_t skip[6] = {0};
+    buffer.pushMultiple(skip, 6);
+    buffer.discard(6);
+    const uint8_t data[6] = {1, 2, 3, 4, 5, 6};
+    buffer.pushMultiple(data, 6);
+    size_t first, second;
+
+    // Act
+    uint8_t* a = buffer.readSpan(0, first);
+    uint8_t* b = buffer.readSpan(first, second);
+
+    // Assert
+    TEST_ASSERT_EQUAL(2, first);
+    TEST_ASSERT_EQUAL(4, second);
+    TEST_ASSERT_EQUAL_UINT8(1, a[0]);
+    TEST_ASSERT_EQUAL_UINT8(3, b[0]);
+    TEST_ASSERT_EQUAL(6, buffer.available());
+}
+
+void process(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_write_span_empty_buffer_is_full_capacity);
+    RUN_TEST(test_commit_makes_bytes_available);
+    RUN_TEST(test_write_span_stops_at_wrap_point);
+    RUN_TEST(test_write_span_full_buffer_counts_overflow);
+    RUN_TEST(test_push_multiple_across_wrap);
+    RUN_TEST(test_read_span_splits_at_wrap_point);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
@@ -0,0 +1,153 @@
+/**
+ * @file test_task_scheduler.cpp
+ * @brief Unit tests for TaskScheduler
+ */
+
+#include <unity.h>
+#include "utils/task_scheduler.h"
+
+static uint32_t fastRuns;
+static uint32_t slowRuns;
+
+static void fastTask() { fastRuns++; }
+static void slowTask() { slowRuns++; }
+
+void setUp(void) {
+    fastRuns = 0;
+    slowRuns = 0;
+}
+
+void tearDown(void) {}
+
+void test_poll_task_runs_every_pass(void) {
+    // Arrange
+    TaskScheduler scheduler;
+    uint32_t t0 = millis();
+    scheduler.add("poll", fastTask, 0);
+
+    // Act
+    scheduler.run(t0);
+    scheduler.run(t0);
+    scheduler.run(t0 + 1);
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT32(3, fastRuns);
+}
+
+void test_periodic_task_waits_for_its_period(void) {
+    // Arrange
+    TaskScheduler scheduler;
+    uint32_t t0 = millis();
+    scheduler.add("slow", slowTask, 100);
+
+    // Act / Assert
+    scheduler.run(t0 + 99);
+    TEST_ASSERT_EQUAL_UINT32(0, slowRuns);
+
+    scheduler.run(t0 + 100);
+    TEST_ASSERT_EQUAL_UINT32(1, slowRuns);
+
+    scheduler.run(t0 + 150);
+    TEST_ASSERT_EQUAL_UINT32(1, slowRuns);
+
+    scheduler.run(t0 + 205);
+    TEST_ASSERT_EQUAL_UINT32(2, slowRuns);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.get(0).missed);
+}
+
+void test_late_task_counts_missed_deadline(void) {
+    // Arrange
+    TaskScheduler scheduler;
+    uint32_t t0 = millis();
+    scheduler.add("slow", slowTask, 100);
+
+    // Act: loop blocked for three periods
+    scheduler.run(t0 + 350);
+    scheduler.run(t0 + 351);
+
+    // Assert: runs once, next slot one period later
+    TEST_ASSERT_EQUAL_UINT32(1, slowRuns);
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.get(0).missed);
+    TEST_ASSERT_EQUAL_UINT32(99, scheduler.idleTime(t0 + 351, 1000));
+}
+
+void test_idle_time_is_time_to_next_task(void) {
+    // Arrange
+    TaskScheduler scheduler;
+    uint32_t t0 = millis();
+    scheduler.add("poll", fastTask, 0);
+    scheduler.add("a", slowTask, 100);
+    scheduler.add("b", slowTask, 30);
+
+    // Act / Assert: poll tasks do not keep the loop awake
+    TEST_ASSERT_EQUAL_UINT32(20, scheduler.idleTime(t0 + 10, 1000));
+    TEST_ASSERT_EQUAL_UINT32(5, scheduler.idleTime(t0 + 10, 5));
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.idleTime(t0 + 30, 1000));
+}
+
+void test_disabled_task_does_not_run(void) {
+    // Arrange
+    TaskScheduler scheduler;
+    uint32_t t0 = millis();
+    int8_t id = scheduler.add("slow", slowTask, 10);
+    scheduler.setEnabled(id, false);
+
+    // Act
+    scheduler.run(t0 + 50);
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT32(0, slowRuns);
+    TEST_ASSERT_EQUAL_UINT32(1000, scheduler.idleTime(t0 + 50, 1000));
+}
+
+void test_trigger_makes_task_due(void) {
+    // Arrange
+    TaskScheduler scheduler;
+    int8_t id = scheduler.add("slow", slowTask, 60000);
+
+    // Act
+    scheduler.trigger(id);
+    scheduler.run(millis());
+
+    // Assert
+    TEST_ASSERT_EQUAL_UINT32(1, slowRuns);
+}
+
+void test_table_full_returns_error(void) {
+    // Arrange
+    TaskScheduler scheduler;
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        scheduler.add("t", fastTask, 10);
+    }
+
+    // Act / Assert
+    TEST_ASSERT_EQUAL_INT(-1, scheduler.add("extra", fastTask, 10));
+    TEST_ASSERT_EQUAL_UINT8(SCHEDULER_MAX_TASKS, scheduler.size());
+}
+
+void process(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_poll_task_runs_every_pass);
+    RUN_TEST(test_periodic_task_waits_for_its_period);
+    RUN_TEST(test_late_task_counts_missed_deadline);
+    RUN_TEST(test_idle_time_is_time_to_next_task);
+    RUN_TEST(test_disabled_task_does_not_run);
+    RUN_TEST(test_trigger_makes_task_due);
+    RUN_TEST(test_table_full_returns_error);
+
+    UNITY_END();
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+void setup() {
+    delay(2000);
+    process();
+}
+void loop() {}
+#else
+int main(int argc, char **argv) {
+    process();
+    return 0;
+}
+#endif
@@ -2,6 +2,12 @@ import { useState, useEffect } from 'preact/hooks';
 import type { WiFiNetwork, WiFiStatus } from '../types/wifi';
 import { api } from '../services/api';
 
+const POLL_MS = 1000;
+const SCAN_POLLS = 15;
+const CONNECT_POLLS = 20;
+
+const sleep = (ms: number) => new Promise((resolve) => setTimeout(resolve, ms));
+
 export function useWiFi() {
   const [networks, setNetworks] = useState<WiFiNetwork[]>([]);
   const [status, setStatus] = useState<WiFiStatus>({ connected: false });
@@ -13,8 +19,13 @@ export function useWiFi() {
     setScanning(true);
     setError(null);
     try {
-      const data = await api.scanWiFi();
-      setNetworks(data.sort((a, b) => b.rssi - a.rssi));
+      let data = await api.scanWiFi(true);
+      for (let i = 0; data.status === 'scanning' && i < SCAN_POLLS; i++) {
+        if (data.networks.length) setNetworks(data.networks);
+        await sleep(POLL_MS);
+        data = await api.scanWiFi();
+      }
+      setNetworks(data.networks);
     } catch (err) {
       setError((err as Error).message);
     } finally {
@@ -27,7 +38,14 @@ export function useWiFi() {
     setError(null);
     try {
       await api.connectWiFi(ssid, password);
-      await checkStatus();
+      for (let i = 0; i < CONNECT_POLLS; i++) {
+        await sleep(POLL_MS);
+        const data = await api.getWiFiStatus();
+        setStatus(data);
+        if (data.connect?.state === 'connected') return;
+        if (data.connect?.state === 'failed') throw new Error('Connection failed');
+      }
+      throw new Error('Connection timed out');
     } catch (err) {
       setError((err as Error).message);
     } finally {
@@ -1,15 +1,17 @@
-import type { WiFiNetwork, WiFiStatus, ProvisioningStatus } from '../types/wifi';
+import type { WiFiScanResult, WiFiStatus, ProvisioningStatus } from '../types/wifi';
 
 const API_BASE = '/api';
 
 export const api = {
-  async scanWiFi(): Promise<WiFiNetwork[]> {
-    const res = await fetch(`${API_BASE}/wifi/scan`);
+  // 202 while the device is still scanning; poll until status is "done"
+  async scanWiFi(refresh = false): Promise<WiFiScanResult> {
+    const res = await fetch(`${API_BASE}/wifi/scan${refresh ? '?refresh=1' : ''}`);
     if (!res.ok) throw new Error('Scan failed');
     return res.json();
   },
 
-  async connectWiFi(ssid: string, password: string): Promise<{ success: boolean }> {
+  // 202 once queued; progress is reported in getWiFiStatus().connect
+  async connectWiFi(ssid: string, password: string): Promise<{ status: string; ssid: string }> {
     const res = await fetch(`${API_BASE}/wifi/connect`, {
       method: 'POST',
       headers: { 'Content-Type': 'application/json' },
@@ -3,6 +3,18 @@ export interface WiFiNetwork {
   rssi: number;
   encryption: number;
   bssid?: string;
+  channel?: number;
+}
+
+export interface WiFiScanResult {
+  status: 'scanning' | 'done';
+  ageMs?: number;
+  networks: WiFiNetwork[];
+}
+
+export interface WiFiConnectJob {
+  state: 'pending' | 'connecting' | 'connected' | 'failed';
+  ssid: string;
 }
 
 export interface WiFiStatus {
@@ -10,6 +22,7 @@ export interface WiFiStatus {
   ssid?: string;
   ip?: string;
   rssi?: number;
+  connect?: WiFiConnectJob;
 }
 
 export interface ProvisioningStatus {
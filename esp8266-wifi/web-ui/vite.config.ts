@@ -5,6 +5,9 @@ export default defineConfig({
   plugins: [preact(), tailwindcss()],
   build: {
     target: 'es2015',
+    // .vite/manifest.json: tools/generate_web_header.py marks the hashed
+    // names listed there as immutable
+    manifest: true,
     minify: 'terser',
     cssMinify: true,
     terserOptions: {
@@ -26,7 +26,9 @@ extern "C" {
 #define MAX_RS485_SLAVES        8
 
 /* Communication Settings */
-#define UART_BAUD_RATE          115200
+#ifndef UART_BAUD_RATE
+#define UART_BAUD_RATE          115200   // Boot rate, higher rates negotiated via CMD_SET_BAUD
+#endif
 #define RS485_BAUD_RATE         9600
 #define SPI_CLOCK_SPEED         1000000  // 1MHz
 
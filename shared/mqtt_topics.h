@@ -0,0 +1,34 @@
+/**
+ * @file mqtt_topics.h
+ * @brief MQTT topic IDs shared between STM32F103 and ESP8266
+ * @version 1.0.0
+ *
+ * The STM32 sends a 1-byte topic ID (+ connector) instead of the full
+ * "ocpp/{stationId}/{deviceId}/..." string; the ESP8266 expands it.
+ * IDs are part of the UART protocol: never renumber, only append.
+ */
+
+#ifndef __MQTT_TOPICS_H
+#define __MQTT_TOPICS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Topic IDs (suffix after ocpp/{station}/{device}/) */
+#define TOPIC_ID_HEARTBEAT          0x01    // heartbeat
+#define TOPIC_ID_STATUS             0x02    // status/{connector}/status_notification
+#define TOPIC_ID_METER              0x03    // meter/{connector}/meter_values
+#define TOPIC_ID_TRANSACTION_START  0x04    // transaction/start
+#define TOPIC_ID_TRANSACTION_STOP   0x05    // transaction/stop
+#define TOPIC_ID_BOOT               0x06    // event/0/boot_notification
+
+#define TOPIC_ID_MAX                TOPIC_ID_BOOT
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MQTT_TOPICS_H */
@@ -23,6 +23,9 @@ extern "C" {
 #define OCPP_METER_VALUES           "meter_values"
 #define OCPP_REMOTE_START           "remote_start"
 #define OCPP_REMOTE_STOP            "remote_stop"
+#define OCPP_SEND_LOCAL_LIST        "send_local_list"
+#define OCPP_SET_CHARGING_PROFILE   "set_charging_profile"
+#define OCPP_CLEAR_CHARGING_PROFILE "clear_charging_profile"
 
 /* Connector Status */
 typedef enum {
@@ -57,6 +60,16 @@ typedef enum {
     ERROR_WEAK_SIGNAL
 } error_code_t;
 
+/* Id Tag Authorization Status (OCPP IdTagInfo.status) */
+typedef enum {
+    AUTH_ACCEPTED = 0,
+    AUTH_BLOCKED,
+    AUTH_EXPIRED,
+    AUTH_INVALID,
+    AUTH_CONCURRENT_TX,
+    AUTH_UNKNOWN = 0xFF             // Not in the local list or cache: ask the backend
+} id_tag_status_t;
+
 /* Transaction Status */
 typedef enum {
     TX_STATUS_IDLE = 0,
@@ -136,16 +149,16 @@ typedef struct {
     char reason[32];
 } stop_transaction_t;
 
-/* Remote Start Command */
-typedef struct {
+/* Remote Start Command (sent packed over UART) */
+typedef struct __attribute__((packed)) {
     char msg_id[32];
     uint8_t connector_id;
     char id_tag[20];
     uint32_t charging_profile_id;
 } remote_start_cmd_t;
 
-/* Remote Stop Command */
-typedef struct {
+/* Remote Stop Command (sent packed over UART) */
+typedef struct __attribute__((packed)) {
     char msg_id[32];
     uint32_t transaction_id;
 } remote_stop_cmd_t;
@@ -16,11 +16,51 @@ extern "C" {
 
 /* Protocol Constants */
 #define UART_START_BYTE     0xAA
+#define UART_START_BYTE_V2  0xAB    // v2 frame: CRC-16 footer instead of XOR
 #define UART_END_BYTE       0x55
 #define UART_MAX_PAYLOAD    512
+#define UART_HEADER_SIZE    5       // start + cmd + length(2) + sequence
+#define UART_FOOTER_SIZE    2       // checksum + end
+#define UART_FOOTER_SIZE_V2 3       // crc16 (little-endian) + end
 #define UART_TIMEOUT_MS     1000
 #define UART_MAX_RETRIES    3
 
+/* Baud Rate Negotiation
+ * Both sides boot at UART_BAUD_BOOT (= UART_BAUD_RATE in device_config.h)
+ * and return to it when the link goes bad at a negotiated rate. */
+#define UART_BAUD_BOOT              115200
+#define UART_BAUD_TEST_LENGTH       64      // CMD_BAUD_TEST pattern bytes
+#define UART_BAUD_TRIAL_TIMEOUT_MS  1000    // New rate must pass the test within this
+#define UART_BAUD_ERROR_WINDOW_MS   5000
+#define UART_BAUD_ERROR_THRESHOLD   5       // Checksum errors per window before fallback
+#define UART_BAUD_SILENCE_MS        35000   // No valid frame for this long -> fallback (> heartbeat)
+
+/* Fragmentation (v2 only)
+ * A message over UART_MAX_PAYLOAD goes out as count CMD_FRAGMENT /
+ * RSP_FRAGMENT frames, each uart_fragment_header_t + one chunk. Every
+ * chunk but the last is UART_FRAGMENT_CHUNK bytes, so a fragment's
+ * offset is index * UART_FRAGMENT_CHUNK and fragments may arrive in any
+ * order (retransmits). Each fragment is an ordinary command with its own
+ * sequence and ACK; the reassembled message carries the last one's. */
+#define UART_FRAGMENT_HEADER_SIZE   6
+#define UART_FRAGMENT_CHUNK         (UART_MAX_PAYLOAD - UART_FRAGMENT_HEADER_SIZE)
+#define UART_FRAGMENT_MAX_COUNT     32      // received_mask bits
+#define UART_REASSEMBLY_SIZE        2048    // Default reassembly buffer
+
+/* Bulk Transfer (v2 only, STM32 firmware pass-through)
+ * The ESP8266 pushes a staged image in UART_BULK_BLOCK_SIZE blocks. A
+ * block is a run of RSP_BULK_DATA frames (not ACKed one by one) closed
+ * by RSP_BULK_BLOCK with its CRC-32; the STM32 answers each block with
+ * CMD_BULK_ACK. Up to UART_BULK_WINDOW blocks may be unacknowledged, so
+ * the STM32 programs one page while the next arrives. Every ACK carries
+ * the first offset the STM32 still needs: resume and go-back-N rewind. */
+#define UART_BULK_BLOCK_SIZE        2048    // STM32F103 flash page (high density)
+#define UART_BULK_DATA_HEADER_SIZE  4
+#define UART_BULK_CHUNK             (UART_MAX_PAYLOAD - UART_BULK_DATA_HEADER_SIZE)
+#define UART_BULK_WINDOW            2       // Blocks in flight
+#define UART_BULK_ACK_TIMEOUT_MS    2000    // No ACK progress: rewind to the last ACK
+#define UART_BULK_MAX_RETRIES       5       // Rewinds in a row before giving up
+
 /* Command Types - STM32 to ESP8266 */
 #define CMD_MQTT_PUBLISH    0x01
 #define CMD_GET_TIME        0x02
@@ -28,6 +68,16 @@ extern "C" {
 #define CMD_CONFIG_UPDATE   0x04
 #define CMD_OTA_REQUEST     0x05
 #define CMD_PUBLISH_METER_VALUES 0x06
+#define CMD_HELLO           0x07    // Protocol version handshake (always sent as v1)
+#define CMD_SET_BAUD        0x08    // Propose new baud rate (baud_payload_t)
+#define CMD_BAUD_TEST       0x09    // Test pattern at the new rate
+#define CMD_ACK             0x0A    // ACK of an ESP8266 command (v2 only), payload: status
+#define CMD_MQTT_PUBLISH_ID 0x0B    // Publish by topic ID (mqtt_publish_id_payload_t)
+#define CMD_FRAGMENT        0x0C    // Part of a large command (uart_fragment_header_t + chunk)
+#define CMD_BULK_ACK        0x0D    // Bulk transfer progress (bulk_ack_payload_t)
+#define CMD_CONNECTOR_STATUS 0x0E   // Connector state (connector_status_payload_t)
+#define CMD_AUTH_QUERY      0x0F    // Look up an id tag locally (auth_query_payload_t)
+#define CMD_AUTH_UPDATE     0x10    // Backend answer for an id tag (auth_update_payload_t)
 
 /* Response Types - ESP8266 to STM32 */
 #define RSP_MQTT_ACK        0x81
@@ -36,12 +86,55 @@ extern "C" {
 #define RSP_CONFIG_ACK      0x84
 #define RSP_MQTT_RECEIVED   0x85
 #define RSP_OTA_STATUS      0x86
+#define RSP_HELLO           0x87    // Agreed protocol version (always sent as v1)
+#define RSP_BAUD_ACK        0x88    // baud_payload_t, sent at the OLD rate
+#define RSP_BAUD_TEST       0x89    // Test pattern echo at the new rate
+#define RSP_REMOTE_COMMAND  0x8A    // Decoded cloud command (remote_command_payload_t)
+#define RSP_FRAGMENT        0x8B    // Part of a large message (uart_fragment_header_t + chunk)
+#define RSP_BULK_BEGIN      0x8C    // STM32 image follows (bulk_begin_payload_t)
+#define RSP_BULK_DATA       0x8D    // bulk_data_header_t + up to UART_BULK_CHUNK bytes
+#define RSP_BULK_BLOCK      0x8E    // End of a block (bulk_block_payload_t)
+#define RSP_BULK_END        0x8F    // Whole image sent, STM32 verifies it (no payload)
+#define RSP_AUTH_RESULT     0x90    // Local authorization (auth_result_payload_t, sequence of the query)
+#define RSP_CHARGING_LIMIT  0x91    // Connector current limit changed (charging_limit_payload_t)
+#define RSP_FLOW_CONTROL    0x92    // ESP8266 RX backpressure (flow_control_payload_t, v2 only)
+
+/* Remote Command IDs (remote_command_payload_t.command_id) */
+#define REMOTE_CMD_START    0x01    // data: remote_start_cmd_t
+#define REMOTE_CMD_STOP     0x02    // data: remote_stop_cmd_t
+
+/* Protocol Versions
+ * v1: 0xAA | cmd | len | seq | payload | xor8 | 0x55
+ * v2: 0xAB | cmd | len | seq | payload | crc16 | 0x55
+ *     CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) over cmd..payload
+ * Receivers accept both; a sender switches to v2 only after RSP_HELLO. */
+#define UART_PROTOCOL_V1    1
+#define UART_PROTOCOL_V2    2
+#define UART_PROTOCOL_MAX   UART_PROTOCOL_V2
 
 /* Status Codes */
 #define STATUS_SUCCESS      0x00
 #define STATUS_ERROR        0x01
 #define STATUS_TIMEOUT      0x02
 #define STATUS_INVALID      0x03
+#define STATUS_BUSY         0x04    // Not now, resend after UART_TIMEOUT_MS
+#define STATUS_PENDING      0x06    // Accepted, final status (same sequence) follows
+
+/* OTA Status Codes (ota_status_payload_t.status)
+ * 0x00-0x0F are final, 0x10+ are progress reports for the same request */
+#define OTA_STATUS_SUCCESS          0x00    // Verified, rebooting into the new image
+#define OTA_STATUS_FAILED_HTTP      0x01
+#define OTA_STATUS_FAILED_NO_SPACE  0x02
+#define OTA_STATUS_FAILED_FLASH     0x03
+#define OTA_STATUS_FAILED_VERIFY    0x04    // SHA-256 or signature mismatch
+#define OTA_STATUS_FAILED_URL       0x05
+#define OTA_STATUS_FAILED_MANIFEST  0x06
+#define OTA_STATUS_BUSY             0x07    // Another update is running
+#define OTA_STATUS_UP_TO_DATE       0x08    // Manifest version is the running one
+#define OTA_STATUS_STAGED           0x09    // STM32 image verified, RSP_BULK_BEGIN follows
+#define OTA_STATUS_STARTED          0x10
+#define OTA_STATUS_PROGRESS         0x11
+#define OTA_STATUS_VERIFYING        0x12
 
 /* Packet Structure */
 typedef struct __attribute__((packed)) {
@@ -62,6 +155,72 @@ typedef struct __attribute__((packed)) {
     char data[];               // JSON payload (variable length)
 } mqtt_publish_payload_t;
 
+/* MQTT Publish by Topic ID Payload (topic IDs in mqtt_topics.h) */
+typedef struct __attribute__((packed)) {
+    uint8_t topic_id;           // TOPIC_ID_*
+    uint8_t connector_id;       // Used by per-connector topics, else 0
+    uint8_t qos;               // QoS level (0, 1)
+    uint16_t data_length;      // Data length
+    char data[];               // Payload bytes (variable length)
+} mqtt_publish_id_payload_t;
+
+/* Connector Status Payload (CMD_CONNECTOR_STATUS)
+ * Published as a status notification only when status or error_code changed */
+typedef struct __attribute__((packed)) {
+    uint8_t connector_id;       // 0 = charge point, 1..MAX_CONNECTORS
+    uint8_t status;             // connector_status_t
+    uint8_t error_code;         // error_code_t
+    char info[];                // Optional free text, not NUL-terminated
+} connector_status_payload_t;
+
+/* Authorization Sources (auth_result_payload_t.source) */
+#define AUTH_SOURCE_NONE    0x00    // Unknown tag, status AUTH_UNKNOWN
+#define AUTH_SOURCE_LIST    0x01    // Local authorization list (backend managed)
+#define AUTH_SOURCE_CACHE   0x02    // Earlier backend answer (CMD_AUTH_UPDATE)
+
+/* Authorization Query Payload (CMD_AUTH_QUERY) */
+typedef struct __attribute__((packed)) {
+    char id_tag[20];            // NUL-padded, no terminator needed at 20 chars
+} auth_query_payload_t;
+
+/* Authorization Result Payload (RSP_AUTH_RESULT) */
+typedef struct __attribute__((packed)) {
+    uint8_t status;             // id_tag_status_t
+    uint8_t source;             // AUTH_SOURCE_*
+    uint32_t expiry;            // Unix time, 0 = none
+} auth_result_payload_t;
+
+/* Authorization Update Payload (CMD_AUTH_UPDATE) */
+typedef struct __attribute__((packed)) {
+    char id_tag[20];            // NUL-padded
+    uint8_t status;             // id_tag_status_t from the backend
+    uint32_t expiry;            // Unix time, 0 = none
+} auth_update_payload_t;
+
+/* Charging Limit Payload (RSP_CHARGING_LIMIT) */
+typedef struct __attribute__((packed)) {
+    uint8_t connector_id;
+    uint16_t limit;             // 0.1 A, 0xFFFF = no limit
+    uint32_t valid_for;         // Seconds until the next known change, 0 = open
+} charging_limit_payload_t;
+
+/* Flow Control Payload (RSP_FLOW_CONTROL)
+ * paused = 1: hold everything but CMD_ACK and CMD_AUTH_QUERY until
+ * paused = 0, or UART_FLOW_PAUSE_MAX_MS after the last pause (the
+ * ESP8266 repeats the pause while it is still behind). */
+#define UART_FLOW_PAUSE_MAX_MS      1000
+
+typedef struct __attribute__((packed)) {
+    uint8_t paused;
+    uint16_t rx_free;           // Free bytes in the ESP8266 UART RX buffer
+} flow_control_payload_t;
+
+/* Remote Command Payload (structs in ocpp_messages.h) */
+typedef struct __attribute__((packed)) {
+    uint8_t command_id;         // REMOTE_CMD_*
+    uint8_t data[];             // Packed command struct
+} remote_command_payload_t;
+
 /* WiFi Status Response Payload */
 typedef struct __attribute__((packed)) {
     uint8_t wifi_connected;     // 0=disconnected, 1=connected
@@ -71,19 +230,163 @@ typedef struct __attribute__((packed)) {
     uint32_t uptime;           // Uptime in seconds
 } wifi_status_payload_t;
 
+/* Hello Command / Response Payload */
+typedef struct __attribute__((packed)) {
+    uint8_t version;            // CMD_HELLO: highest supported, RSP_HELLO: agreed
+    uint8_t reserved;
+} hello_payload_t;
+
+/* Baud Rate Command / Response Payload */
+typedef struct __attribute__((packed)) {
+    uint32_t baud_rate;         // Proposed (CMD) or accepted (RSP) rate
+    uint8_t status;             // RSP only: STATUS_SUCCESS or STATUS_INVALID
+} baud_payload_t;
+
 /* Time Data Response Payload */
 typedef struct __attribute__((packed)) {
     uint32_t unix_timestamp;    // Unix timestamp
     int16_t timezone_offset;    // Timezone offset in minutes
     uint8_t ntp_synced;        // 0=not synced, 1=synced
+    uint32_t microseconds;      // Sub-second part of unix_timestamp (0-999999)
 } time_data_payload_t;
 
+/* OTA Status Response Payload (RSP_OTA_STATUS, sequence of the CMD_OTA_REQUEST)
+ * CMD_OTA_REQUEST payload: manifest URL (http://), not NUL-terminated */
+typedef struct __attribute__((packed)) {
+    uint8_t status;             // OTA_STATUS_*
+    uint8_t percent;            // Download progress 0-100
+    uint32_t bytes_done;        // Firmware bytes written (rebuilt, for a delta)
+    uint32_t bytes_total;       // Firmware size from the manifest (0 = unknown yet)
+    char message[64];           // NUL-terminated
+} ota_status_payload_t;
+
+/* Bulk Transfer Status Codes (bulk_ack_payload_t.status) */
+#define BULK_STATUS_OK              0x00    // Ready / block stored
+#define BULK_STATUS_RESEND          0x01    // CRC mismatch or gap, resend from next_offset
+#define BULK_STATUS_COMPLETE        0x02    // RSP_BULK_END: image verified, STM32 installs it
+#define BULK_STATUS_FAILED          0x03    // Flash error or SHA-256 mismatch, transfer aborted
+#define BULK_STATUS_BUSY            0x04    // Cannot take an image now
+
+/* Bulk Begin Payload (RSP_BULK_BEGIN) */
+typedef struct __attribute__((packed)) {
+    uint32_t image_size;
+    uint8_t sha256[32];         // Of the whole image, checked after RSP_BULK_END
+    char version[16];           // NUL-terminated
+    uint16_t block_size;        // UART_BULK_BLOCK_SIZE
+} bulk_begin_payload_t;
+
+/* Bulk Data Header (RSP_BULK_DATA, followed by the data) */
+typedef struct __attribute__((packed)) {
+    uint32_t offset;            // Image offset of the first data byte
+} bulk_data_header_t;
+
+/* Bulk Block Payload (RSP_BULK_BLOCK) */
+typedef struct __attribute__((packed)) {
+    uint32_t offset;            // Block start (multiple of block_size)
+    uint16_t length;            // block_size, less for the last block
+    uint32_t crc32;             // uart_crc32_update(0, block, length)
+} bulk_block_payload_t;
+
+/* Bulk ACK Payload (CMD_BULK_ACK) */
+typedef struct __attribute__((packed)) {
+    uint8_t status;             // BULK_STATUS_*
+    uint32_t next_offset;       // First byte still needed (block aligned)
+} bulk_ack_payload_t;
+
+/* Fragment Header (CMD_FRAGMENT / RSP_FRAGMENT) */
+typedef struct __attribute__((packed)) {
+    uint8_t message_id;         // Same for all fragments of one message
+    uint8_t index;              // 0..count-1
+    uint8_t count;              // 1..UART_FRAGMENT_MAX_COUNT
+    uint8_t cmd_type;           // Command/response type of the whole message
+    uint16_t total_length;      // Reassembled payload length
+} uart_fragment_header_t;
+
+/* Reassembly Results */
+typedef enum {
+    UART_REASSEMBLY_INCOMPLETE = 0, // Fragment stored, more to come
+    UART_REASSEMBLY_COMPLETE,       // buffer holds total_length bytes of cmd_type
+    UART_REASSEMBLY_DUPLICATE,      // Fragment already stored (retransmit)
+    UART_REASSEMBLY_ERR_HEADER,     // Inconsistent index/count/length
+    UART_REASSEMBLY_ERR_OVERFLOW    // total_length > capacity
+} uart_reassembly_result_t;
+
+/* Reassembly Context
+ * One message at a time; a fragment of a different message_id drops
+ * the partial one. */
+typedef struct {
+    uint8_t* buffer;            // capacity bytes, caller owned
+    uint16_t capacity;
+    uint8_t active;             // Partial message in progress
+    uint8_t message_id;
+    uint8_t cmd_type;
+    uint8_t count;
+    uint8_t received;
+    uint16_t total_length;
+    uint32_t received_mask;     // Bit per fragment index
+} uart_reassembly_t;
+
+/* Streaming Parser States */
+typedef enum {
+    UART_PARSE_HUNT_START = 0,  // Skipping bytes until UART_START_BYTE
+    UART_PARSE_HEADER,          // cmd + length(2) + sequence
+    UART_PARSE_PAYLOAD,         // length bytes
+    UART_PARSE_CHECKSUM,
+    UART_PARSE_END
+} uart_parse_state_t;
+
+/* Streaming Parser Results */
+typedef enum {
+    UART_PARSE_INCOMPLETE = 0,  // All input consumed, frame not finished
+    UART_PARSE_FRAME,           // Complete, valid frame (parser fields hold it)
+    UART_PARSE_ERR_LENGTH,      // Length field > UART_MAX_PAYLOAD
+    UART_PARSE_ERR_CHECKSUM,    // XOR (v1) or CRC-16 (v2) mismatch
+    UART_PARSE_ERR_END_BYTE
+} uart_parse_result_t;
+
+/* Streaming Parser Context
+ * Resumable across calls: feed bytes as they arrive, each byte is
+ * examined once and the checksum is accumulated on the fly. When
+ * payload_buf is NULL the payload is only checksummed, not stored
+ * (the caller keeps the bytes, e.g. in its RX ring). */
+typedef struct {
+    uint8_t state;              // uart_parse_state_t
+    uint8_t version;            // UART_PROTOCOL_V1/V2, from the start byte
+    uint8_t cmd_type;
+    uint16_t length;
+    uint8_t sequence;
+    uint8_t checksum;           // v1: running XOR over header + payload
+    uint16_t crc;               // v2: running CRC-16 over header + payload
+    uint16_t rx_crc;            // v2: received CRC-16
+    uint8_t header_pos;         // Header bytes received (after start byte)
+    uint8_t footer_pos;         // CRC bytes received
+    uint16_t payload_pos;       // Payload bytes received
+    uint16_t frame_bytes;       // Bytes of current frame consumed, incl. start byte
+    uint8_t* payload_buf;       // Optional, UART_MAX_PAYLOAD bytes
+} uart_parser_t;
+
 /* Function Prototypes */
 uint8_t uart_calculate_checksum(const uart_packet_t* packet);
 bool uart_validate_packet(const uart_packet_t* packet);
 bool uart_send_packet(const uart_packet_t* packet);
 bool uart_receive_packet(uart_packet_t* packet, uint32_t timeout_ms);
 void uart_init_packet(uart_packet_t* packet, uint8_t cmd_type, uint8_t sequence);
+uint16_t uart_crc16_update(uint16_t crc, const uint8_t* data, uint16_t length);
+uint16_t uart_calculate_crc16(const uart_packet_t* packet);
+uint32_t uart_crc32_update(uint32_t crc, const uint8_t* data, uint16_t length);
+uint16_t uart_frame_size(uint8_t version, uint16_t payload_length);
+bool uart_baud_supported(uint32_t baud_rate);
+void uart_fill_baud_test(uint8_t* buffer, uint16_t length);
+bool uart_check_baud_test(const uint8_t* buffer, uint16_t length);
+void uart_parser_init(uart_parser_t* parser, uint8_t* payload_buf);
+void uart_parser_reset(uart_parser_t* parser);
+uart_parse_result_t uart_parser_feed(uart_parser_t* parser, const uint8_t* data,
+                                     uint16_t length, uint16_t* consumed);
+uint8_t uart_fragment_count(uint16_t total_length);
+void uart_reassembly_init(uart_reassembly_t* reassembly, uint8_t* buffer, uint16_t capacity);
+uart_reassembly_result_t uart_reassembly_feed(uart_reassembly_t* reassembly,
+                                              const uart_fragment_header_t* header,
+                                              const uint8_t* chunk, uint16_t chunk_length);
 
 #ifdef __cplusplus
 }
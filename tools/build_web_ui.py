@@ -68,4 +68,4 @@ def build_and_copy_web_ui(source, target, env):
     print("=" * 50)
 
 # Register the callback (runs before web_build.py compression)
-env.AddPreAction("$BUILD_DIR/src/main.cpp.o", build_and_copy_web_ui)
+env.AddPreAction("$BUILD_DIR/src/drivers/network/embedded_assets.cpp.o", build_and_copy_web_ui)
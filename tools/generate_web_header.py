@@ -2,24 +2,92 @@
 """
 Generate C++ header file from web assets (gzipped)
 Embeds web files into firmware as PROGMEM arrays
+
+Each file gets an ETag (hash of its uncompressed content) and an
+immutable flag for content-hashed names, which the firmware serves with
+a one-year Cache-Control. Hashed names are read from the Vite build
+manifest (.vite/manifest.json in the www dir, not embedded); without one,
+only names that look like Vite's name.HASH8.ext are taken as hashed.
+
+Standalone: python3 generate_web_header.py <www dir> <header file>
 """
 
-Import("env")
+try:
+    Import("env")
+except NameError:
+    env = None
 
 import os
+import re
+import sys
+import json
 import gzip
-import binascii
+import hashlib
 from os.path import join
 
+VITE_MANIFEST = join('.vite', 'manifest.json')
+
+# Fallback without a manifest: app.C441XP1K.css, app.Bf3xT9aQ.js. The hash
+# must hold a digit and an upper-case letter, so app.settings.js is not
+# cached for a year (a missed hash only costs an ETag revalidation)
+HASHED_NAME = re.compile(r'\.(?=[A-Za-z0-9_-]*[0-9])(?=[A-Za-z0-9_-]*[A-Z])'
+                         r'[A-Za-z0-9_-]{8}\.(js|css)$')
+
+CONTENT_TYPES = {
+    '.html': 'text/html',
+    '.css': 'text/css',
+    '.js': 'application/javascript',
+    '.json': 'application/json',
+    '.svg': 'image/svg+xml',
+    '.ico': 'image/x-icon',
+    '.png': 'image/png',
+    '.woff2': 'font/woff2',
+}
+
+def list_web_files(web_src_dir):
+    """Relative paths of all files, sorted so the header is reproducible"""
+    paths = []
+    for root, dirs, files in os.walk(web_src_dir):
+        # Build metadata (.vite/) is not served
+        dirs[:] = [d for d in dirs if not d.startswith('.')]
+        for filename in files:
+            paths.append(os.path.relpath(join(root, filename), web_src_dir).replace(os.sep, '/'))
+    return sorted(paths)
+
+def read_hashed_names(web_src_dir):
+    """Output files Vite named by content hash, None without a manifest"""
+    manifest_path = join(web_src_dir, VITE_MANIFEST)
+    if not os.path.exists(manifest_path):
+        return None
+
+    with open(manifest_path) as f:
+        manifest = json.load(f)
+
+    # Chunks, their CSS and imported assets; public/ files are not listed
+    names = set()
+    for chunk in manifest.values():
+        names.add(chunk['file'])
+        names.update(chunk.get('css', []))
+        names.update(chunk.get('assets', []))
+    return names
+
+def is_hashed(filename, hashed_names):
+    if hashed_names is not None:
+        return filename in hashed_names
+    return bool(HASHED_NAME.search(filename))
+
 def generate_web_header(source, target, env):
+    """PlatformIO pre-action"""
+    web_src_dir = join(env.subst("$PROJECT_DIR"), "data", "www")
+    header_file = join(env.subst("$PROJECT_DIR"), "include", "web_assets.h")
+    write_web_header(web_src_dir, header_file)
+
+def write_web_header(web_src_dir, header_file):
     """Convert web files to C++ header with PROGMEM"""
     print("=" * 50)
     print("Generating web assets header...")
     print("=" * 50)
 
-    web_src_dir = join(env.subst("$PROJECT_DIR"), "data", "www")
-    header_file = join(env.subst("$PROJECT_DIR"), "include", "web_assets.h")
-
     if not os.path.exists(web_src_dir):
         print(f"No web source directory found at {web_src_dir}")
         return
@@ -40,21 +108,22 @@ def generate_web_header(source, target, env):
 """
 
     files_data = []
+    hashed_names = read_hashed_names(web_src_dir)
+    if hashed_names is None:
+        print(f"  No {VITE_MANIFEST}, guessing hashed names from the file name")
 
     # Process each file
-    for filename in os.listdir(web_src_dir):
+    for filename in list_web_files(web_src_dir):
         filepath = join(web_src_dir, filename)
-        if not os.path.isfile(filepath):
-            continue
 
-        # Read and gzip file
+        # Read and gzip file (mtime=0: same input, same bytes)
         with open(filepath, 'rb') as f:
             original_data = f.read()
 
-        gzipped_data = gzip.compress(original_data, compresslevel=9)
+        gzipped_data = gzip.compress(original_data, compresslevel=9, mtime=0)
 
         # Convert to C array
-        var_name = filename.replace('.', '_').replace('-', '_')
+        var_name = re.sub(r'[^A-Za-z0-9]', '_', filename)
         array_name = f"web_{var_name}_gz"
 
         print(f"  {filename}: {len(original_data)} → {len(gzipped_data)} bytes (gzip)")
@@ -77,7 +146,9 @@ def generate_web_header(source, target, env):
         files_data.append({
             'filename': filename,
             'array': array_name,
-            'size': len(gzipped_data)
+            'size': len(gzipped_data),
+            'etag': hashlib.sha1(original_data).hexdigest()[:16],
+            'immutable': is_hashed(filename, hashed_names)
         })
 
     # Add lookup struct
@@ -89,6 +160,8 @@ struct WebFile {
     size_t size;
     const char* contentType;
     bool gzipped;
+    const char* etag;           // Quoted hash of the uncompressed content
+    bool immutable;             // Content-hashed name: cache for a year
 };
 
 // Web files array
@@ -101,24 +174,17 @@ const WebFile WEB_FILES[] PROGMEM = {
         array = file_info['array']
 
         # Determine content type
-        if filename.endswith('.html'):
-            content_type = 'text/html'
-        elif filename.endswith('.css'):
-            content_type = 'text/css'
-        elif filename.endswith('.js'):
-            content_type = 'application/javascript'
-        elif filename.endswith('.svg'):
-            content_type = 'image/svg+xml'
-        else:
-            content_type = 'application/octet-stream'
+        content_type = CONTENT_TYPES.get(os.path.splitext(filename)[1], 'application/octet-stream')
+        fields = f'{array}, {array}_len, "{content_type}", true, "\\"{file_info["etag"]}\\"", ' \
+                 f'{"true" if file_info["immutable"] else "false"}'
 
         # Map filename to URL path
         path = '/' + filename
         if filename == 'index.html':
             # Also add root path
-            header_content += f'    {{"/", {array}, {array}_len, "{content_type}", true}},\n'
+            header_content += f'    {{"/", {fields}}},\n'
 
-        header_content += f'    {{"{path}", {array}, {array}_len, "{content_type}", true}},\n'
+        header_content += f'    {{"{path}", {fields}}},\n'
 
     header_content += """};
 
@@ -137,5 +203,11 @@ const size_t WEB_FILES_COUNT = sizeof(WEB_FILES) / sizeof(WebFile);
     print(f"  Total size: {total_size} bytes ({total_size/1024:.1f} KB)")
     print("=" * 50)
 
-# Register callback
-env.AddPreAction("$BUILD_DIR/src/main.cpp.o", generate_web_header)
+if env is not None:
+    # Only embedded_assets.cpp includes web_assets.h
+    env.AddPreAction("$BUILD_DIR/src/drivers/network/embedded_assets.cpp.o", generate_web_header)
+elif __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print(f"usage: {sys.argv[0]} <www dir> <header file>")
+        sys.exit(1)
+    write_web_header(sys.argv[1], sys.argv[2])
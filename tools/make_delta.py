@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+"""
+Build a delta OTA patch (SDP1 format, see include/utils/delta_patch.h)
+
+    python3 tools/make_delta.py old.bin new.bin new.sdp
+
+old.bin must be the exact image running on the chargers: the device only
+uses the patch if ESP.getSketchMD5() equals the "base" printed here. The
+printed "delta" object goes into the OTA manifest next to the full image
+entry, which stays the fallback.
+"""
+
+import hashlib
+import json
+import struct
+import sys
+
+MAGIC = b"SDP1"
+OP_COPY, OP_ADD, OP_INSERT, OP_SEEK = 1, 2, 3, 4
+
+BLOCK = 16          # Match seed length
+MIN_ZERO_RUN = 8    # Zero differences worth a COPY record inside an ADD
+MIN_SIMILAR = 0.5   # Gap bytes equal to the source for ADD instead of INSERT
+
+
+def varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def zigzag(value):
+    return (value << 1) if value >= 0 else ((-value << 1) - 1)
+
+
+class Writer:
+    def __init__(self, old_size, new_size):
+        self.out = bytearray(MAGIC + struct.pack("<II", old_size, new_size))
+
+    def record(self, op, arg, data=b""):
+        self.out += bytes([op]) + varint(arg) + data
+
+    def copy(self, length):
+        if length:
+            self.record(OP_COPY, length)
+
+    def insert(self, data):
+        if data:
+            self.record(OP_INSERT, len(data), data)
+
+    def seek(self, offset):
+        if offset:
+            self.record(OP_SEEK, zigzag(offset))
+
+    def add(self, old, new):
+        """Difference bytes, with long zero runs as COPY"""
+        diff = bytes((n - o) & 0xFF for o, n in zip(old, new))
+        start = i = 0
+        while i < len(diff):
+            if diff[i] == 0:
+                run = i
+                while run < len(diff) and diff[run] == 0:
+                    run += 1
+                if run - i >= MIN_ZERO_RUN:
+                    if i > start:
+                        self.record(OP_ADD, i - start, diff[start:i])
+                    self.copy(run - i)
+                    start = run
+                i = run
+            else:
+                i += 1
+        if start < len(diff):
+            self.record(OP_ADD, len(diff) - start, diff[start:])
+
+
+def build_index(old):
+    index = {}
+    for i in range(len(old) - BLOCK + 1):
+        index.setdefault(old[i:i + BLOCK], i)
+    return index
+
+
+def make_delta(old, new):
+    index = build_index(old)
+    writer = Writer(len(old), len(new))
+
+    pos = 0         # Source cursor, mirrors the decoder
+    gap = 0         # Start of unmatched target bytes
+    i = 0
+    while i < len(new):
+        seed = new[i:i + BLOCK]
+        match = None
+        if len(seed) == BLOCK:
+            # Prefer continuing where the last match ended
+            match = pos if old[pos:pos + BLOCK] == seed else index.get(seed)
+
+        if match is None:
+            i += 1
+            continue
+
+        # Flush the unmatched gap against the source cursor
+        gap_bytes = new[gap:i]
+        aligned = old[pos:pos + len(gap_bytes)]
+        same = sum(1 for a, b in zip(aligned, gap_bytes) if a == b)
+        if gap_bytes and len(aligned) == len(gap_bytes) and same >= MIN_SIMILAR * len(gap_bytes):
+            writer.add(aligned, gap_bytes)
+            pos += len(gap_bytes)
+        else:
+            writer.insert(gap_bytes)
+
+        if match != pos:
+            # The gap shifted the cursor: re-seed at the continuation if it still matches
+            if old[pos:pos + BLOCK] == seed:
+                match = pos
+        writer.seek(match - pos)
+
+        length = BLOCK
+        while i + length < len(new) and match + length < len(old) and new[i + length] == old[match + length]:
+            length += 1
+
+        writer.copy(length)
+        pos = match + length
+        i += length
+        gap = i
+
+    writer.insert(new[gap:])
+    return bytes(writer.out)
+
+
+def apply_delta(old, patch):
+    """Reference decoder, used to check every patch before it ships"""
+    assert patch[:4] == MAGIC
+    old_size, new_size = struct.unpack("<II", patch[4:12])
+    assert old_size == len(old)
+    out = bytearray()
+    pos = 0
+    p = 12
+
+    def read_varint():
+        nonlocal p
+        value = shift = 0
+        while True:
+            byte = patch[p]
+            p += 1
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value
+
+    while len(out) < new_size:
+        op = patch[p]
+        p += 1
+        arg = read_varint()
+        if op == OP_COPY:
+            out += old[pos:pos + arg]
+            pos += arg
+        elif op == OP_ADD:
+            out += bytes((old[pos + k] + patch[p + k]) & 0xFF for k in range(arg))
+            pos += arg
+            p += arg
+        elif op == OP_INSERT:
+            out += patch[p:p + arg]
+            p += arg
+        elif op == OP_SEEK:
+            pos += (arg >> 1) ^ -(arg & 1)
+        else:
+            raise ValueError(f"bad op {op} at {p - 1}")
+    return bytes(out)
+
+
+def main():
+    if len(sys.argv) != 4:
+        print(__doc__.strip())
+        sys.exit(1)
+
+    with open(sys.argv[1], "rb") as f:
+        old = f.read()
+    with open(sys.argv[2], "rb") as f:
+        new = f.read()
+
+    patch = make_delta(old, new)
+    if apply_delta(old, patch) != new:
+        print("Error: patch does not reproduce the new image", file=sys.stderr)
+        sys.exit(1)
+
+    with open(sys.argv[3], "wb") as f:
+        f.write(patch)
+
+    print(f"Patch: {len(patch):,} bytes ({len(patch) * 100 / len(new):.1f}% of {len(new):,})")
+    print(json.dumps({"delta": {"url": "http://.../" + sys.argv[3].split("/")[-1],
+                                "base": hashlib.md5(old).hexdigest(),
+                                "size": len(patch)}}, indent=2))
+
+
+if __name__ == "__main__":
+    main()
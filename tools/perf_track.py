@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""
+Track host benchmark results (ns/op) per commit and flag regressions
+
+    python3 tools/perf_track.py                 # run pio test -e native, record, compare
+    python3 tools/perf_track.py --log out.txt   # parse a saved test log instead
+
+Reads the "perf <name> <ns> ns/op" lines printed by
+esp8266-wifi/test/test_benchmark/test_perf_benchmark/, appends them to
+the CSV history (commit, name, ns_per_op) and compares each benchmark with
+the last earlier commit in the history. Exits 1 when any benchmark got
+slower than --threshold percent, so CI can gate on it. Host numbers are
+only comparable on the same machine; keep one history per CI runner.
+"""
+
+import argparse
+import csv
+import os
+import re
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+FIRMWARE = os.path.join(ROOT, "esp8266-wifi")
+DEFAULT_HISTORY = os.path.join(FIRMWARE, ".pio", "perf_history.csv")
+
+PERF_LINE = re.compile(r"perf (\S+) (\d+) ns/op")
+
+
+def git_commit():
+    try:
+        out = subprocess.check_output(["git", "rev-parse", "--short", "HEAD"], cwd=ROOT)
+        commit = out.decode().strip()
+        dirty = subprocess.call(["git", "diff", "--quiet", "HEAD"], cwd=ROOT)
+        return commit + ("-dirty" if dirty else "")
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def run_benchmarks():
+    cmd = ["pio", "test", "-e", "native",
+           "-f", "test_benchmark/test_perf_benchmark", "-v"]
+    proc = subprocess.run(cmd, cwd=FIRMWARE, stdout=subprocess.PIPE,
+                          stderr=subprocess.STDOUT)
+    output = proc.stdout.decode(errors="replace")
+    if proc.returncode != 0:
+        sys.stdout.write(output)
+        sys.exit("benchmark run failed")
+    return output
+
+
+def parse(text):
+    results = {}
+    for match in PERF_LINE.finditer(text):
+        results[match.group(1)] = int(match.group(2))
+    return results
+
+
+def load_history(path):
+    if not os.path.exists(path):
+        return []
+    with open(path, newline="") as f:
+        return [(row["commit"], row["name"], int(row["ns_per_op"]))
+                for row in csv.DictReader(f)]
+
+
+def append_history(path, commit, results):
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    new_file = not os.path.exists(path)
+    with open(path, "a", newline="") as f:
+        writer = csv.writer(f)
+        if new_file:
+            writer.writerow(["commit", "name", "ns_per_op"])
+        for name in sorted(results):
+            writer.writerow([commit, name, results[name]])
+
+
+def baseline(history, commit):
+    """Results of the most recent other commit in the history."""
+    previous = None
+    for row_commit, _, _ in history:
+        if row_commit != commit:
+            previous = row_commit
+    if previous is None:
+        return None, {}
+    return previous, {name: ns for c, name, ns in history if c == previous}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--log", help="parse this test log instead of running pio")
+    parser.add_argument("--history", default=DEFAULT_HISTORY, help="CSV history file")
+    parser.add_argument("--threshold", type=float, default=20.0,
+                        help="allowed slowdown in percent (default 20)")
+    parser.add_argument("--no-record", action="store_true",
+                        help="compare only, do not append to the history")
+    args = parser.parse_args()
+
+    if args.log:
+        with open(args.log, errors="replace") as f:
+            text = f.read()
+    else:
+        text = run_benchmarks()
+
+    results = parse(text)
+    if not results:
+        sys.exit("no perf lines found")
+
+    commit = git_commit()
+    history = load_history(args.history)
+    base_commit, base = baseline(history, commit)
+
+    regressions = 0
+    print("%-24s %10s %10s %8s" % ("benchmark", "ns/op", "base", "change"))
+    for name in sorted(results):
+        ns = results[name]
+        if name in base and base[name] > 0:
+            change = (ns - base[name]) * 100.0 / base[name]
+            flag = ""
+            if change > args.threshold:
+                flag = "  REGRESSION"
+                regressions += 1
+            print("%-24s %10d %10d %+7.1f%%%s" % (name, ns, base[name], change, flag))
+        else:
+            print("%-24s %10d %10s %8s" % (name, ns, "-", "new"))
+
+    print("commit %s, baseline %s" % (commit, base_commit or "none"))
+
+    if not args.no_record:
+        append_history(args.history, commit, results)
+
+    if regressions:
+        print("%d benchmark(s) slower than %.0f%%" % (regressions, args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""
+Sign an OTA manifest with the release key (openssl must be installed)
+
+    python3 tools/sign_manifest.py manifest.json release_key.pem [image.bin]
+
+With an image, "size" and "sha256" are taken from it first. "signature"
+is then replaced by the signature over the message the device checks
+(OTAHandler::verifyManifest): one line each for target, version, size,
+sha256 and delta.base. The public half of the key goes into
+include/ota_signing_key.h (OTA_SIGNING_KEY_PEM).
+"""
+
+import hashlib
+import json
+import subprocess
+import sys
+
+
+def signed_message(manifest):
+    delta = manifest.get("delta") or {}
+    lines = [
+        manifest.get("target", "esp8266"),
+        manifest["version"],
+        str(int(manifest["size"])),
+        manifest["sha256"].lower(),
+        delta.get("base", "").lower(),
+    ]
+    return "".join(line + "\n" for line in lines).encode()
+
+
+def sign(message, key_path):
+    # RSA: PKCS#1 v1.5, EC: ASN.1 ECDSA, both over SHA-256 (BearSSL verifier)
+    proc = subprocess.run(["openssl", "dgst", "-sha256", "-sign", key_path],
+                          input=message, stdout=subprocess.PIPE, check=True)
+    return proc.stdout.hex()
+
+
+def main():
+    if len(sys.argv) not in (3, 4):
+        print(__doc__.strip())
+        sys.exit(1)
+
+    with open(sys.argv[1]) as f:
+        manifest = json.load(f)
+
+    if len(sys.argv) == 4:
+        with open(sys.argv[3], "rb") as f:
+            image = f.read()
+        manifest["size"] = len(image)
+        manifest["sha256"] = hashlib.sha256(image).hexdigest()
+
+    for field in ("version", "url", "size", "sha256"):
+        if field not in manifest:
+            print(f"Error: manifest has no \"{field}\"", file=sys.stderr)
+            sys.exit(1)
+
+    manifest["signature"] = sign(signed_message(manifest), sys.argv[2])
+
+    with open(sys.argv[1], "w") as f:
+        json.dump(manifest, f, separators=(",", ":"))
+        f.write("\n")
+
+    print(f"Signed {sys.argv[1]} ({len(manifest['signature']) // 2} byte signature)")
+
+
+if __name__ == "__main__":
+    main()
@@ -61,6 +61,8 @@ def build_and_prepare_web_ui(source, target, env):
     compressed_files = []
 
     for root, dirs, files in os.walk(data_www_dir):
+        # .vite/manifest.json is for generate_web_header.py, not LittleFS
+        dirs[:] = [d for d in dirs if not d.startswith('.')]
         for filename in files:
             if filename.endswith(('.html', '.css', '.js', '.json')):
                 src_path = join(root, filename)
@@ -97,5 +99,6 @@ def build_and_prepare_web_ui(source, target, env):
     print("\n✓ Web UI ready for upload!")
     print("  Run: pio run --target uploadfs")
     print("=" * 60)
-# Register the callback
-env.AddPreAction("$BUILD_DIR/src/main.cpp.o", build_and_prepare_web_ui)
+# Register the callback on the object that embeds the UI, so the bundle
+# exists before generate_web_header.py runs on the same target
+env.AddPreAction("$BUILD_DIR/src/drivers/network/embedded_assets.cpp.o", build_and_prepare_web_ui)